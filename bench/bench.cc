@@ -0,0 +1,160 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include <stdio.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+
+#include "common/types/data_chunk.hpp"
+#include "execution/expression_executor.hpp"
+#include "execution/expression_kernels.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/operator_expression.hpp"
+
+namespace {
+
+using zoomdb::ExpressionType;
+using zoomdb::TypeId;
+
+constexpr size_t kChunks = 2000;
+
+enum Column : size_t {
+  kExtendedPrice = 0,
+  kDiscount      = 1,
+  kTax           = 2,
+  kShipDate      = 3,
+};
+
+std::unique_ptr<zoomdb::Expression> Ref(Column column, TypeId type) {
+  auto ref = std::make_unique<zoomdb::ColumnRefExpression>(
+      type, zoomdb::ColumnBinding(0, column));
+  ref->index = column;
+  return ref;
+}
+
+std::unique_ptr<zoomdb::Expression> Decimal(double value) {
+  return std::make_unique<zoomdb::ConstantExpression>(
+      zoomdb::Value::Decimal(value));
+}
+
+std::unique_ptr<zoomdb::Expression> Arithmetic(
+    ExpressionType op, std::unique_ptr<zoomdb::Expression> left,
+    std::unique_ptr<zoomdb::Expression> right) {
+  return std::make_unique<zoomdb::OperatorExpression>(
+      op, TypeId::kDecimal, std::move(left), std::move(right));
+}
+
+/**
+ * Select the kernels of the expression and its children, or remove them
+ * so that the expression is interpreted.
+ */
+void SetKernels(zoomdb::Expression& expr, bool kernels) {
+  expr.EnumerateChildren(
+      [&](zoomdb::Expression& child) { SetKernels(child, kernels); });
+  expr.kernel = nullptr;
+  if (kernels && expr.children.size() == 2) {
+    expr.kernel = zoomdb::ExpressionKernels::Get(
+        expr.type, expr.children[0]->return_type,
+        expr.children[1]->return_type, expr.return_type);
+  }
+}
+
+/**
+ * Returns the time per row of evaluating the expression over the chunk
+ * kChunks times, in nanoseconds. The result of the last evaluation is left
+ * in result.
+ */
+double Measure(zoomdb::Expression& expr, zoomdb::DataChunk& chunk,
+               zoomdb::Vector& result) {
+  zoomdb::ExpressionExecutor executor(&chunk);
+  result.Initialize(expr.return_type);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kChunks; i++) {
+    executor.ExecuteExpression(expr, result);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(kChunks * chunk.GetCount());
+}
+
+}  // namespace
+
+/**
+ * Compares the interpreted evaluation of the TPC-H Q1 expressions with the
+ * evaluation by the kernels of ExpressionKernels, over chunks of lineitem
+ * columns.
+ */
+int main() {
+  zoomdb::DataChunk chunk;
+  chunk.Initialize(
+      {TypeId::kDecimal, TypeId::kDecimal, TypeId::kDecimal, TypeId::kDate});
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> cents(90000, 10494950);
+  std::uniform_int_distribution<int> percent(0, 10);
+  std::uniform_int_distribution<int> day(8035, 10591);
+  auto prices    = chunk.GetVector(kExtendedPrice).GetData<double>();
+  auto discounts = chunk.GetVector(kDiscount).GetData<double>();
+  auto taxes     = chunk.GetVector(kTax).GetData<double>();
+  auto dates     = chunk.GetVector(kShipDate).GetData<int32_t>();
+  for (size_t i = 0; i < zoomdb::kStandardVectorSize; i++) {
+    prices[i]    = cents(random) / 100.0;
+    discounts[i] = percent(random) / 100.0;
+    taxes[i]     = percent(random) / 100.0;
+    dates[i]     = day(random);
+  }
+  for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+    chunk.GetVector(i).SetCount(zoomdb::kStandardVectorSize);
+  }
+
+  struct Benchmark {
+    const char* name;
+    std::unique_ptr<zoomdb::Expression> expr;
+  };
+  Benchmark benchmarks[] = {
+      {"l_extendedprice * (1 - l_discount) * (1 + l_tax)",
+       Arithmetic(
+           ExpressionType::kOperatorMultiply,
+           Arithmetic(ExpressionType::kOperatorMultiply,
+                      Ref(kExtendedPrice, TypeId::kDecimal),
+                      Arithmetic(ExpressionType::kOperatorMinus,
+                                 Decimal(1), Ref(kDiscount, TypeId::kDecimal))),
+           Arithmetic(ExpressionType::kOperatorPlus, Decimal(1),
+                      Ref(kTax, TypeId::kDecimal)))},
+      // DATE '1998-12-01' - INTERVAL '90' DAY
+      {"l_shipdate <= DATE '1998-09-02'",
+       std::make_unique<zoomdb::ComparisonExpression>(
+           ExpressionType::kCompareLessThanOrEqualTo,
+           Ref(kShipDate, TypeId::kDate),
+           std::make_unique<zoomdb::ConstantExpression>(
+               zoomdb::Value::Date(10471)))},
+  };
+
+  printf("%-50s %12s %12s\n", "expression (ns/row)", "interpreted", "kernels");
+  int failures = 0;
+  for (auto& benchmark : benchmarks) {
+    zoomdb::Vector expected;
+    zoomdb::Vector result;
+    SetKernels(*benchmark.expr, false);
+    auto interpreted = Measure(*benchmark.expr, chunk, expected);
+    SetKernels(*benchmark.expr, true);
+    auto kernels = Measure(*benchmark.expr, chunk, result);
+    printf("%-50s %12.1f %12.1f\n", benchmark.name, interpreted, kernels);
+    for (size_t i = 0; i < expected.GetCount(); i++) {
+      if (!(expected.GetValue(i) == result.GetValue(i))) {
+        fprintf(stderr, "Kernel result differs in row %zu\n", i);
+        failures++;
+        break;
+      }
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/exception.hpp"
+#include "main/pg_protocol.hpp"
+#include "main/wire_protocol.hpp"
+
+namespace {
+
+zoomdb::Server* running_server = nullptr;
+
+void HandleSignal(int) {
+  if (running_server) {
+    running_server->Stop();
+  }
+}
+
+void Usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--port PORT] [--threads COUNT] [--read-only] "
+          "[--postgres] [DATABASE]\n",
+          program);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  unsigned long port    = 0;
+  unsigned long threads = 0;
+  const char* path      = nullptr;
+  auto access_mode      = zoomdb::AccessMode::kReadWrite;
+  bool postgres         = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+      port = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--read-only") == 0) {
+      access_mode = zoomdb::AccessMode::kReadOnly;
+    } else if (strcmp(argv[i], "--postgres") == 0) {
+      postgres = true;
+    } else if (argv[i][0] != '-' && !path) {
+      path = argv[i];
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (port > 65535) {
+    fprintf(stderr, "Invalid port %lu\n", port);
+    return 1;
+  }
+
+  try {
+    zoomdb::Database database(path, access_mode);
+    zoomdb::Server server(
+        database, static_cast<uint16_t>(port), threads,
+        [postgres](zoomdb::Database& db)
+            -> std::unique_ptr<zoomdb::ServerSession> {
+          if (postgres) {
+            return std::make_unique<zoomdb::PgSession>(db);
+          }
+          return std::make_unique<zoomdb::WireSession>(db);
+        });
+    running_server = &server;
+    signal(SIGINT, HandleSignal);
+    signal(SIGTERM, HandleSignal);
+    printf("Listening on port %u\n", static_cast<unsigned>(server.GetPort()));
+    fflush(stdout);
+    server.Run();
+    running_server = nullptr;
+  } catch (zoomdb::Exception& e) {
+    fprintf(stderr, "%s\n", e.GetMessage().c_str());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,278 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog.hpp"
+
+#include "common/exception.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+Catalog::Catalog() : timestamp_(0), vacuum_pending_(false) {
+  auto schema = std::make_unique<SchemaCatalogEntry>(kDefaultSchema);
+  struct {
+    const char* name;
+    ExpressionType type;
+  } aggregates[] = {
+      {"count", ExpressionType::kAggregateCount},
+      {"sum", ExpressionType::kAggregateSum},
+      {"min", ExpressionType::kAggregateMin},
+      {"max", ExpressionType::kAggregateMax},
+      {"avg", ExpressionType::kAggregateAvg},
+      {"approx_count_distinct", ExpressionType::kAggregateApproxCountDistinct},
+      {"approx_quantile", ExpressionType::kAggregateApproxQuantile},
+  };
+  for (auto& aggregate : aggregates) {
+    schema->functions.CreateEntry(
+        std::make_unique<FunctionCatalogEntry>(
+            aggregate.name, FunctionType::kAggregate, aggregate.type),
+        0);
+  }
+  schema->functions.CreateEntry(
+      std::make_unique<FunctionCatalogEntry>(
+          "read_parquet", FunctionType::kTable, ExpressionType::kFunction),
+      0);
+  schemas_.CreateEntry(std::move(schema), 0);
+}
+
+void Catalog::CreateSchema(const std::string& name, bool if_not_exists) {
+  std::lock_guard<std::mutex> guard(ddl_lock_);
+  auto timestamp = NextTimestamp();
+  if (!schemas_.CreateEntry(std::make_unique<SchemaCatalogEntry>(name),
+                            timestamp)) {
+    if (if_not_exists) {
+      return;
+    }
+    throw CatalogException("Schema %s already exists", name.c_str());
+  }
+  Commit(timestamp);
+  Vacuum();
+}
+
+void Catalog::DropSchema(const std::string& name, bool if_exists) {
+  std::lock_guard<std::mutex> guard(ddl_lock_);
+  auto timestamp = NextTimestamp();
+  auto schema    = static_cast<SchemaCatalogEntry*>(
+      schemas_.GetEntry(name, timestamp));
+  if (!schema) {
+    if (if_exists) {
+      return;
+    }
+    throw CatalogException("Schema %s does not exist", name.c_str());
+  }
+  if (name == kDefaultSchema) {
+    throw CatalogException("Cannot drop the default schema %s",
+                           name.c_str());
+  }
+  bool empty = true;
+  schema->tables.Scan(timestamp, [&](CatalogEntry&) { empty = false; });
+  if (!empty) {
+    throw CatalogException("Cannot drop schema %s, it contains tables",
+                           name.c_str());
+  }
+  schemas_.DropEntry(name, timestamp);
+  Commit(timestamp);
+  Vacuum();
+}
+
+TableCatalogEntry* Catalog::CreateTable(const std::string& schema,
+                                        const std::string& name,
+                                        std::vector<ColumnDefinition> columns,
+                                        bool if_not_exists) {
+  std::lock_guard<std::mutex> guard(ddl_lock_);
+  auto timestamp = NextTimestamp();
+  auto parent    = GetSchema(schema, timestamp);
+  auto entry =
+      std::make_unique<TableCatalogEntry>(parent, name, std::move(columns));
+  auto result = entry.get();
+  if (!parent->tables.CreateEntry(std::move(entry), timestamp)) {
+    if (if_not_exists) {
+      return static_cast<TableCatalogEntry*>(
+          parent->tables.GetEntry(name, timestamp));
+    }
+    throw CatalogException("Table %s already exists", name.c_str());
+  }
+  Commit(timestamp);
+  Vacuum();
+  return result;
+}
+
+void Catalog::DropTable(const std::string& schema, const std::string& name,
+                        bool if_exists) {
+  std::lock_guard<std::mutex> guard(ddl_lock_);
+  auto timestamp = NextTimestamp();
+  auto parent    = GetSchema(schema, timestamp);
+  auto table = static_cast<TableCatalogEntry*>(
+      parent->tables.GetEntry(name, timestamp));
+  if (!table) {
+    if (if_exists) {
+      return;
+    }
+    throw CatalogException("Table %s does not exist", name.c_str());
+  }
+  std::vector<std::string> indexes;
+  parent->indexes.Scan(timestamp, [&](CatalogEntry& entry) {
+    if (static_cast<IndexCatalogEntry&>(entry).table == table) {
+      indexes.push_back(entry.name);
+    }
+  });
+  for (auto& index : indexes) {
+    parent->indexes.DropEntry(index, timestamp);
+  }
+  parent->tables.DropEntry(name, timestamp);
+  Commit(timestamp);
+  Vacuum();
+}
+
+IndexCatalogEntry* Catalog::CreateIndex(
+    const std::string& schema, const std::string& name,
+    const std::string& table, const std::vector<std::string>& columns,
+    bool unique, bool if_not_exists) {
+  std::lock_guard<std::mutex> guard(ddl_lock_);
+  auto timestamp = NextTimestamp();
+  auto parent    = GetSchema(schema, timestamp);
+  if (auto existing = parent->indexes.GetEntry(name, timestamp)) {
+    if (if_not_exists) {
+      return static_cast<IndexCatalogEntry*>(existing);
+    }
+    throw CatalogException("Index %s already exists", name.c_str());
+  }
+  auto table_entry = GetTable(schema, table, timestamp);
+  std::vector<size_t> column_ids;
+  for (auto& column : columns) {
+    column_ids.push_back(table_entry->GetColumnIndex(column));
+  }
+  // building the index fails on duplicates of a unique index, before the
+  // catalog is modified
+  auto& index =
+      table_entry->storage->CreateIndex(name, std::move(column_ids), unique);
+  auto entry = std::make_unique<IndexCatalogEntry>(name, table_entry, &index);
+  auto result = entry.get();
+  parent->indexes.CreateEntry(std::move(entry), timestamp);
+  Commit(timestamp);
+  Vacuum();
+  return result;
+}
+
+void Catalog::DropIndex(const std::string& schema, const std::string& name,
+                        bool if_exists) {
+  std::lock_guard<std::mutex> guard(ddl_lock_);
+  auto timestamp = NextTimestamp();
+  auto parent    = GetSchema(schema, timestamp);
+  auto index     = static_cast<IndexCatalogEntry*>(
+      parent->indexes.GetEntry(name, timestamp));
+  if (!index) {
+    if (if_exists) {
+      return;
+    }
+    throw CatalogException("Index %s does not exist", name.c_str());
+  }
+  index->dropped = index->table->storage->DropIndex(name);
+  parent->indexes.DropEntry(name, timestamp);
+  Commit(timestamp);
+  Vacuum();
+}
+
+SchemaCatalogEntry* Catalog::GetSchema(const std::string& name,
+                                       uint64_t timestamp) const {
+  auto entry = schemas_.GetEntry(name, timestamp);
+  if (!entry) {
+    throw CatalogException("Schema %s does not exist", name.c_str());
+  }
+  return static_cast<SchemaCatalogEntry*>(entry);
+}
+
+TableCatalogEntry* Catalog::GetTable(const std::string& schema,
+                                     const std::string& name,
+                                     uint64_t timestamp) const {
+  auto entry = GetSchema(schema, timestamp)->tables.GetEntry(name, timestamp);
+  if (!entry) {
+    throw CatalogException("Table %s does not exist", name.c_str());
+  }
+  return static_cast<TableCatalogEntry*>(entry);
+}
+
+IndexCatalogEntry* Catalog::GetIndex(const std::string& schema,
+                                     const std::string& name,
+                                     uint64_t timestamp) const {
+  auto entry =
+      GetSchema(schema, timestamp)->indexes.GetEntry(name, timestamp);
+  if (!entry) {
+    throw CatalogException("Index %s does not exist", name.c_str());
+  }
+  return static_cast<IndexCatalogEntry*>(entry);
+}
+
+FunctionCatalogEntry* Catalog::GetFunction(const std::string& schema,
+                                           const std::string& name,
+                                           uint64_t timestamp) const {
+  auto entry =
+      GetSchema(schema, timestamp)->functions.GetEntry(name, timestamp);
+  if (!entry && schema != kDefaultSchema) {
+    entry = GetSchema(kDefaultSchema, timestamp)
+                ->functions.GetEntry(name, timestamp);
+  }
+  if (!entry) {
+    throw CatalogException("Function %s does not exist", name.c_str());
+  }
+  return static_cast<FunctionCatalogEntry*>(entry);
+}
+
+void Catalog::ScanTables(
+    uint64_t timestamp,
+    const std::function<void(TableCatalogEntry& table)>& callback) const {
+  schemas_.Scan(timestamp, [&](CatalogEntry& schema) {
+    static_cast<SchemaCatalogEntry&>(schema).tables.Scan(
+        timestamp, [&](CatalogEntry& table) {
+          callback(static_cast<TableCatalogEntry&>(table));
+        });
+  });
+}
+
+uint64_t Catalog::Pin() {
+  std::lock_guard<std::mutex> guard(snapshot_lock_);
+  auto timestamp = GetTimestamp();
+  snapshots_.insert(timestamp);
+  return timestamp;
+}
+
+void Catalog::Unpin(uint64_t timestamp) {
+  {
+    std::lock_guard<std::mutex> guard(snapshot_lock_);
+    snapshots_.erase(snapshots_.find(timestamp));
+  }
+  if (vacuum_pending_.load(std::memory_order_relaxed)) {
+    // a running DDL statement vacuums when it is done
+    std::unique_lock<std::mutex> guard(ddl_lock_, std::try_to_lock);
+    if (guard) {
+      Vacuum();
+    }
+  }
+}
+
+void Catalog::Vacuum() {
+  auto timestamp = GetTimestamp();
+  uint64_t oldest;
+  {
+    std::lock_guard<std::mutex> guard(snapshot_lock_);
+    oldest = snapshots_.empty() ? timestamp : *snapshots_.begin();
+  }
+  bool pending = false;
+  pending |= schemas_.Vacuum(
+      oldest, timestamp, [&](CatalogEntry& entry) {
+        if (entry.deleted) {
+          return;
+        }
+        auto& schema = static_cast<SchemaCatalogEntry&>(entry);
+        pending |= schema.tables.Vacuum(oldest, timestamp, nullptr);
+        pending |= schema.indexes.Vacuum(oldest, timestamp, nullptr);
+        pending |= schema.functions.Vacuum(oldest, timestamp, nullptr);
+      });
+  vacuum_pending_.store(pending, std::memory_order_relaxed);
+}
+
+}  // namespace zoomdb
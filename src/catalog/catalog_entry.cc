@@ -0,0 +1,34 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog_entry.hpp"
+
+namespace zoomdb {
+
+std::string CatalogTypeToString(CatalogType type) {
+  switch (type) {
+    case CatalogType::kSchema:
+      return "Schema";
+    case CatalogType::kTable:
+      return "Table";
+    case CatalogType::kIndex:
+      return "Index";
+    case CatalogType::kFunction:
+      return "Function";
+    default:
+      return "Invalid";
+  }
+}
+
+CatalogEntry::CatalogEntry(CatalogType entry_type, std::string entry_name)
+    : type(entry_type),
+      name(std::move(entry_name)),
+      timestamp(0),
+      deleted(false),
+      older(nullptr) {}
+
+}  // namespace zoomdb
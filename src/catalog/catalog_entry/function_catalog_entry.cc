@@ -0,0 +1,19 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog_entry/function_catalog_entry.hpp"
+
+namespace zoomdb {
+
+FunctionCatalogEntry::FunctionCatalogEntry(std::string function_name,
+                                           FunctionType kind,
+                                           ExpressionType expression)
+    : CatalogEntry(CatalogType::kFunction, std::move(function_name)),
+      function_type(kind),
+      expression_type(expression) {}
+
+}  // namespace zoomdb
@@ -0,0 +1,23 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog_entry/index_catalog_entry.hpp"
+
+#include "storage/index.hpp"
+
+namespace zoomdb {
+
+IndexCatalogEntry::IndexCatalogEntry(std::string index_name,
+                                     TableCatalogEntry* indexed_table,
+                                     Index* table_index)
+    : CatalogEntry(CatalogType::kIndex, std::move(index_name)),
+      table(indexed_table),
+      index(table_index) {}
+
+IndexCatalogEntry::~IndexCatalogEntry() = default;
+
+}  // namespace zoomdb
@@ -0,0 +1,15 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog_entry/schema_catalog_entry.hpp"
+
+namespace zoomdb {
+
+SchemaCatalogEntry::SchemaCatalogEntry(std::string schema_name)
+    : CatalogEntry(CatalogType::kSchema, std::move(schema_name)) {}
+
+}  // namespace zoomdb
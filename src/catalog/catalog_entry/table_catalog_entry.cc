@@ -0,0 +1,57 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+
+#include "common/exception.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+TableCatalogEntry::TableCatalogEntry(
+    SchemaCatalogEntry* parent, std::string table_name,
+    std::vector<ColumnDefinition> table_columns)
+    : CatalogEntry(CatalogType::kTable, std::move(table_name)),
+      schema(parent),
+      columns(std::move(table_columns)) {
+  if (columns.empty()) {
+    throw CatalogException("Table %s must have at least one column",
+                           name.c_str());
+  }
+  for (size_t i = 0; i < columns.size(); i++) {
+    if (!name_map_.emplace(columns[i].name, i).second) {
+      throw CatalogException("Column %s appears twice in table %s",
+                             columns[i].name.c_str(), name.c_str());
+    }
+  }
+  storage = std::make_unique<DataTable>(GetTypes());
+}
+
+TableCatalogEntry::~TableCatalogEntry() = default;
+
+bool TableCatalogEntry::ColumnExists(const std::string& column) const {
+  return name_map_.find(column) != name_map_.end();
+}
+
+size_t TableCatalogEntry::GetColumnIndex(const std::string& column) const {
+  auto entry = name_map_.find(column);
+  if (entry == name_map_.end()) {
+    throw CatalogException("Table %s does not have a column named %s",
+                           name.c_str(), column.c_str());
+  }
+  return entry->second;
+}
+
+std::vector<TypeId> TableCatalogEntry::GetTypes() const {
+  std::vector<TypeId> result;
+  for (auto& column : columns) {
+    result.push_back(column.type);
+  }
+  return result;
+}
+
+}  // namespace zoomdb
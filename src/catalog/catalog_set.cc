@@ -0,0 +1,283 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "catalog/catalog_set.hpp"
+
+#include <algorithm>
+
+namespace zoomdb {
+
+/**
+ * The versions of one name, newest first.
+ */
+struct CatalogSet::Chain {
+  explicit Chain(std::string chain_name)
+      : name(std::move(chain_name)), head(nullptr) {}
+
+  const std::string name;
+  std::atomic<CatalogEntry*> head;
+};
+
+struct CatalogSet::Bucket {
+  std::vector<Chain*> chains;
+};
+
+struct CatalogSet::HashTable {
+  explicit HashTable(size_t size)
+      : mask(size - 1),
+        buckets(std::make_unique<std::atomic<const Bucket*>[]>(size)) {}
+
+  const Bucket* GetBucket(size_t hash) const {
+    return buckets[hash & mask].load(std::memory_order_acquire);
+  }
+
+  const size_t mask;
+  std::unique_ptr<std::atomic<const Bucket*>[]> buckets;
+};
+
+CatalogSet::Garbage::Garbage(uint64_t garbage_timestamp,
+                             CatalogEntry* newer_entry)
+    : timestamp(garbage_timestamp), newer(newer_entry) {}
+
+namespace {
+
+constexpr size_t kInitialBucketCount = 16;
+
+CatalogEntry* GetVisible(CatalogEntry* entry, uint64_t timestamp) {
+  while (entry && entry->timestamp > timestamp) {
+    entry = entry->older;
+  }
+  return entry && !entry->deleted ? entry : nullptr;
+}
+
+}  // namespace
+
+CatalogSet::CatalogSet() : table_(new HashTable(kInitialBucketCount)) {}
+
+CatalogSet::~CatalogSet() {
+  FreeGarbage(UINT64_MAX);
+  for (auto& chain : chains_) {
+    auto entry = chain->head.load(std::memory_order_relaxed);
+    while (entry) {
+      auto older = entry->older;
+      delete entry;
+      entry = older;
+    }
+  }
+  auto table = table_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i <= table->mask; i++) {
+    delete table->GetBucket(i);
+  }
+  delete table;
+}
+
+CatalogSet::Chain* CatalogSet::FindChain(const std::string& name) const {
+  auto bucket = table_.load(std::memory_order_acquire)
+                    ->GetBucket(std::hash<std::string>()(name));
+  if (bucket) {
+    for (auto chain : bucket->chains) {
+      if (chain->name == name) {
+        return chain;
+      }
+    }
+  }
+  return nullptr;
+}
+
+CatalogSet::Chain* CatalogSet::AddChain(const std::string& name,
+                                        uint64_t timestamp) {
+  chains_.push_back(std::make_unique<Chain>(name));
+  auto chain = chains_.back().get();
+  auto table = table_.load(std::memory_order_relaxed);
+
+  if (chains_.size() > 2 * (table->mask + 1)) {
+    // rehash into a new array of buckets, published as a whole
+    auto new_table = std::make_unique<HashTable>(4 * (table->mask + 1));
+    std::vector<std::unique_ptr<Bucket>> new_buckets(new_table->mask + 1);
+    for (auto& existing : chains_) {
+      auto index = std::hash<std::string>()(existing->name) & new_table->mask;
+      if (!new_buckets[index]) {
+        new_buckets[index] = std::make_unique<Bucket>();
+      }
+      new_buckets[index]->chains.push_back(existing.get());
+    }
+    for (size_t i = 0; i < new_buckets.size(); i++) {
+      new_table->buckets[i].store(new_buckets[i].release(),
+                                  std::memory_order_relaxed);
+    }
+    table_.store(new_table.release(), std::memory_order_release);
+    for (size_t i = 0; i <= table->mask; i++) {
+      if (auto bucket = table->GetBucket(i)) {
+        garbage_.emplace_back(timestamp);
+        garbage_.back().bucket.reset(bucket);
+      }
+    }
+    garbage_.emplace_back(timestamp);
+    garbage_.back().table.reset(table);
+    return chain;
+  }
+
+  // copy the bucket, add the chain and publish the copy
+  auto hash       = std::hash<std::string>()(name);
+  auto bucket     = std::make_unique<Bucket>();
+  auto old_bucket = table->GetBucket(hash);
+  if (old_bucket) {
+    bucket->chains = old_bucket->chains;
+  }
+  bucket->chains.push_back(chain);
+  table->buckets[hash & table->mask].store(bucket.release(),
+                                           std::memory_order_release);
+  if (old_bucket) {
+    garbage_.emplace_back(timestamp);
+    garbage_.back().bucket.reset(old_bucket);
+  }
+  return chain;
+}
+
+void CatalogSet::RemoveChain(Chain* chain, uint64_t timestamp) {
+  auto table      = table_.load(std::memory_order_relaxed);
+  auto hash       = std::hash<std::string>()(chain->name);
+  auto old_bucket = table->GetBucket(hash);
+  std::unique_ptr<Bucket> bucket;
+  for (auto other : old_bucket->chains) {
+    if (other != chain) {
+      if (!bucket) {
+        bucket = std::make_unique<Bucket>();
+      }
+      bucket->chains.push_back(other);
+    }
+  }
+  table->buckets[hash & table->mask].store(bucket.release(),
+                                           std::memory_order_release);
+
+  auto position = std::find_if(chains_.begin(), chains_.end(),
+                               [&](const std::unique_ptr<Chain>& other) {
+                                 return other.get() == chain;
+                               });
+  garbage_.emplace_back(timestamp);
+  auto& garbage = garbage_.back();
+  garbage.bucket.reset(old_bucket);
+  garbage.chain = std::move(*position);
+  garbage.entry.reset(chain->head.load(std::memory_order_relaxed));
+  // a reader that still finds the chain finds no entry
+  chain->head.store(nullptr, std::memory_order_release);
+  *position = std::move(chains_.back());
+  chains_.pop_back();
+}
+
+void CatalogSet::PushVersion(Chain* chain, std::unique_ptr<CatalogEntry> entry,
+                             uint64_t timestamp) {
+  auto current     = chain->head.load(std::memory_order_relaxed);
+  entry->timestamp = timestamp;
+  entry->older     = current;
+  chain->head.store(entry.get(), std::memory_order_release);
+  if (current) {
+    // readers that started before the timestamp may still need it
+    garbage_.emplace_back(timestamp, entry.get());
+    garbage_.back().entry.reset(current);
+  }
+  entry.release();
+}
+
+bool CatalogSet::CreateEntry(std::unique_ptr<CatalogEntry> entry,
+                             uint64_t timestamp) {
+  std::lock_guard<std::mutex> guard(write_lock_);
+  auto chain = FindChain(entry->name);
+  if (chain) {
+    if (GetVisible(chain->head.load(std::memory_order_relaxed), timestamp)) {
+      return false;
+    }
+  } else {
+    chain = AddChain(entry->name, timestamp);
+  }
+  PushVersion(chain, std::move(entry), timestamp);
+  return true;
+}
+
+bool CatalogSet::DropEntry(const std::string& name, uint64_t timestamp) {
+  std::lock_guard<std::mutex> guard(write_lock_);
+  auto chain = FindChain(name);
+  if (!chain) {
+    return false;
+  }
+  auto current = GetVisible(chain->head.load(std::memory_order_relaxed),
+                            timestamp);
+  if (!current) {
+    return false;
+  }
+  auto tombstone     = std::make_unique<CatalogEntry>(current->type, name);
+  tombstone->deleted = true;
+  PushVersion(chain, std::move(tombstone), timestamp);
+  dropped_.emplace_back(timestamp, chain);
+  return true;
+}
+
+CatalogEntry* CatalogSet::GetEntry(const std::string& name,
+                                   uint64_t timestamp) const {
+  auto chain = FindChain(name);
+  if (!chain) {
+    return nullptr;
+  }
+  return GetVisible(chain->head.load(std::memory_order_acquire), timestamp);
+}
+
+void CatalogSet::Scan(
+    uint64_t timestamp,
+    const std::function<void(CatalogEntry& entry)>& callback) const {
+  auto table = table_.load(std::memory_order_acquire);
+  for (size_t i = 0; i <= table->mask; i++) {
+    auto bucket = table->GetBucket(i);
+    if (!bucket) {
+      continue;
+    }
+    for (auto chain : bucket->chains) {
+      auto entry =
+          GetVisible(chain->head.load(std::memory_order_acquire), timestamp);
+      if (entry) {
+        callback(*entry);
+      }
+    }
+  }
+}
+
+void CatalogSet::FreeGarbage(uint64_t timestamp) {
+  while (!garbage_.empty() && garbage_.front().timestamp <= timestamp) {
+    // whatever the entry points to has been freed before
+    if (auto newer = garbage_.front().newer) {
+      newer->older = nullptr;
+    }
+    garbage_.pop_front();
+  }
+}
+
+bool CatalogSet::Vacuum(
+    uint64_t oldest, uint64_t timestamp,
+    const std::function<void(CatalogEntry& entry)>& callback) {
+  std::lock_guard<std::mutex> guard(write_lock_);
+  FreeGarbage(oldest);
+  while (!dropped_.empty() && dropped_.front().first <= oldest) {
+    auto chain = dropped_.front().second;
+    dropped_.pop_front();
+    auto head = chain->head.load(std::memory_order_relaxed);
+    if (head && head->deleted && head->timestamp <= oldest) {
+      // readers that looked up the chain before it is removed have not
+      // started after the current timestamp
+      RemoveChain(chain, timestamp + 1);
+    }
+  }
+  if (callback) {
+    for (auto& chain : chains_) {
+      auto entry = chain->head.load(std::memory_order_relaxed);
+      for (; entry; entry = entry->older) {
+        callback(*entry);
+      }
+    }
+  }
+  return !garbage_.empty() || !dropped_.empty();
+}
+
+}  // namespace zoomdb
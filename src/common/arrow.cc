@@ -0,0 +1,362 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/arrow.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+bool GetBit(const uint8_t* bitmap, size_t index) {
+  return (bitmap[index / 8] >> (index % 8)) & 1;
+}
+
+void SetBit(uint8_t* bitmap, size_t index) {
+  bitmap[index / 8] =
+      static_cast<uint8_t>(bitmap[index / 8] | 1 << (index % 8));
+}
+
+template <class T>
+void ReadStrings(const ArrowArray& array, size_t start, size_t count,
+                 Vector& result) {
+  auto offsets = static_cast<const T*>(array.buffers[1]);
+  auto data    = static_cast<const char*>(array.buffers[2]);
+  auto strings = result.GetData<const char*>();
+  for (size_t i = 0; i < count; i++) {
+    if (result.IsNull(i)) {
+      strings[i] = nullptr;
+      continue;
+    }
+    auto begin = offsets[start + i];
+    auto end   = offsets[start + i + 1];
+    strings[i] =
+        result.AddString(data + begin, static_cast<size_t>(end - begin));
+  }
+}
+
+/**
+ * The buffers and children of an exported array, freed by its release
+ * callback. The children are released with it.
+ */
+struct ArrowArrayData {
+  ~ArrowArrayData() {
+    for (auto& child : children) {
+      if (child.release) {
+        child.release(&child);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<uint8_t[]>> buffers;
+  std::vector<const void*> buffer_pointers;
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_pointers;
+};
+
+struct ArrowSchemaData {
+  ~ArrowSchemaData() {
+    for (auto& child : children) {
+      if (child.release) {
+        child.release(&child);
+      }
+    }
+  }
+
+  std::string name;
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema*> child_pointers;
+};
+
+void ReleaseArray(ArrowArray* array) {
+  delete static_cast<ArrowArrayData*>(array->private_data);
+  array->release = nullptr;
+}
+
+void ReleaseSchema(ArrowSchema* schema) {
+  delete static_cast<ArrowSchemaData*>(schema->private_data);
+  schema->release = nullptr;
+}
+
+/**
+ * Point the array at the buffers and children of data, which it owns from
+ * then on.
+ */
+void PublishArray(std::unique_ptr<ArrowArrayData> data, size_t length,
+                  size_t null_count, ArrowArray* array) {
+  for (auto& buffer : data->buffers) {
+    data->buffer_pointers.push_back(buffer.get());
+  }
+  for (auto& child : data->children) {
+    data->child_pointers.push_back(&child);
+  }
+  array->length       = static_cast<int64_t>(length);
+  array->null_count   = static_cast<int64_t>(null_count);
+  array->offset       = 0;
+  array->n_buffers    = static_cast<int64_t>(data->buffer_pointers.size());
+  array->n_children   = static_cast<int64_t>(data->child_pointers.size());
+  array->buffers      = data->buffer_pointers.data();
+  array->children     = data->child_pointers.data();
+  array->dictionary   = nullptr;
+  array->release      = ReleaseArray;
+  array->private_data = data.release();
+}
+
+void PublishSchema(std::unique_ptr<ArrowSchemaData> data, const char* format,
+                   ArrowSchema* schema) {
+  for (auto& child : data->children) {
+    data->child_pointers.push_back(&child);
+  }
+  schema->format       = format;
+  schema->name         = data->name.c_str();
+  schema->metadata     = nullptr;
+  schema->flags        = ARROW_FLAG_NULLABLE;
+  schema->n_children   = static_cast<int64_t>(data->child_pointers.size());
+  schema->children     = data->child_pointers.data();
+  schema->dictionary   = nullptr;
+  schema->release      = ReleaseSchema;
+  schema->private_data = data.release();
+}
+
+const char* TypeToArrowFormat(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+      return "b";
+    case TypeId::kTinyInt:
+      return "c";
+    case TypeId::kSmallInt:
+      return "s";
+    case TypeId::kInteger:
+      return "i";
+    case TypeId::kBigInt:
+      return "l";
+    case TypeId::kDecimal:
+      return "g";
+    case TypeId::kDate:
+      return "tdD";
+    case TypeId::kTimestamp:
+      return "tsu:";
+    case TypeId::kVarChar:
+      return "u";
+    default:
+      throw NotImplementationException("Cannot export type %s to Arrow",
+                                       TypeIdToString(type).c_str());
+  }
+}
+
+void ExportStrings(const ChunkCollection& collection, size_t column,
+                   size_t length, ArrowArrayData& data) {
+  auto rows       = collection.GetCount();
+  auto offsets    = std::make_unique<uint8_t[]>((rows + 1) * sizeof(int32_t));
+  auto strings    = std::make_unique<uint8_t[]>(std::max<size_t>(length, 1));
+  auto offset     = reinterpret_cast<int32_t*>(offsets.get());
+  size_t row      = 0;
+  size_t position = 0;
+  for (size_t i = 0; i < collection.ChunkCount(); i++) {
+    auto& vector = collection.GetChunk(i).GetVector(column);
+    auto input   = vector.GetData<const char*>();
+    for (size_t j = 0; j < vector.GetCount(); j++) {
+      offset[row++] = static_cast<int32_t>(position);
+      if (!vector.IsNull(j)) {
+        auto size = std::strlen(input[j]);
+        std::memcpy(strings.get() + position, input[j], size);
+        position += size;
+      }
+    }
+  }
+  offset[row] = static_cast<int32_t>(position);
+  data.buffers.push_back(std::move(offsets));
+  data.buffers.push_back(std::move(strings));
+}
+
+void ExportColumn(const ChunkCollection& collection, size_t column,
+                  ArrowArray* array) {
+  auto type  = collection.GetTypes()[column];
+  auto rows  = collection.GetCount();
+  auto data  = std::make_unique<ArrowArrayData>();
+  auto bytes = (rows + 7) / 8;
+
+  // validity bitmap, omitted if there are no NULLs
+  size_t null_count = 0;
+  auto validity     = std::make_unique<uint8_t[]>(bytes);
+  size_t row        = 0;
+  for (size_t i = 0; i < collection.ChunkCount(); i++) {
+    auto& vector = collection.GetChunk(i).GetVector(column);
+    for (size_t j = 0; j < vector.GetCount(); j++, row++) {
+      if (vector.IsNull(j)) {
+        null_count++;
+      } else {
+        SetBit(validity.get(), row);
+      }
+    }
+  }
+  data->buffers.push_back(null_count > 0 ? std::move(validity) : nullptr);
+
+  switch (type) {
+    case TypeId::kBoolean: {
+      auto values = std::make_unique<uint8_t[]>(bytes);
+      row         = 0;
+      for (size_t i = 0; i < collection.ChunkCount(); i++) {
+        auto& vector = collection.GetChunk(i).GetVector(column);
+        auto input   = vector.GetData<int8_t>();
+        for (size_t j = 0; j < vector.GetCount(); j++, row++) {
+          if (input[j]) {
+            SetBit(values.get(), row);
+          }
+        }
+      }
+      data->buffers.push_back(std::move(values));
+      break;
+    }
+    case TypeId::kVarChar: {
+      size_t length = 0;
+      for (size_t i = 0; i < collection.ChunkCount(); i++) {
+        auto& vector = collection.GetChunk(i).GetVector(column);
+        auto input   = vector.GetData<const char*>();
+        for (size_t j = 0; j < vector.GetCount(); j++) {
+          length += vector.IsNull(j) ? 0 : std::strlen(input[j]);
+        }
+      }
+      if (length > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw ObjectSizeException("Column " + std::to_string(column) +
+                                  " is too large to be exported to Arrow");
+      }
+      ExportStrings(collection, column, length, *data);
+      break;
+    }
+    default: {
+      auto width  = GetTypeIdSize(type);
+      auto values = std::make_unique<uint8_t[]>(std::max<size_t>(rows, 1) *
+                                                width);
+      size_t position = 0;
+      for (size_t i = 0; i < collection.ChunkCount(); i++) {
+        auto& vector = collection.GetChunk(i).GetVector(column);
+        std::memcpy(values.get() + position, vector.GetData(),
+                    vector.GetCount() * width);
+        position += vector.GetCount() * width;
+      }
+      data->buffers.push_back(std::move(values));
+      break;
+    }
+  }
+  PublishArray(std::move(data), rows, null_count, array);
+}
+
+}  // namespace
+
+TypeId ArrowFormatToType(const char* format) {
+  std::string_view view(format);
+  if (view == "b") {
+    return TypeId::kBoolean;
+  } else if (view == "c") {
+    return TypeId::kTinyInt;
+  } else if (view == "s") {
+    return TypeId::kSmallInt;
+  } else if (view == "i") {
+    return TypeId::kInteger;
+  } else if (view == "l") {
+    return TypeId::kBigInt;
+  } else if (view == "g") {
+    return TypeId::kDecimal;
+  } else if (view == "tdD") {
+    return TypeId::kDate;
+  } else if (view.substr(0, 4) == "tsu:") {
+    // timestamps with a time zone are normalized to UTC
+    return TypeId::kTimestamp;
+  } else if (view == "u" || view == "U") {
+    return TypeId::kVarChar;
+  }
+  throw NotImplementationException("Unsupported Arrow format \"%s\"", format);
+}
+
+void ArrowToVector(const ArrowSchema& schema, const ArrowArray& array,
+                   size_t offset, size_t count, Vector& result) {
+  auto type = ArrowFormatToType(schema.format);
+  if (offset + count > static_cast<size_t>(array.length)) {
+    throw Exception(ExceptionType::kOutOfRange,
+                    "Arrow array index out of range");
+  }
+  if (type != result.GetType()) {
+    // read the array into a vector of its own type, then convert
+    Vector converted(type);
+    ArrowToVector(schema, array, offset, count, converted);
+    for (size_t i = 0; i < count; i++) {
+      result.SetValue(i, converted.GetValue(i));
+    }
+    result.SetCount(count);
+    return;
+  }
+
+  auto start = static_cast<size_t>(array.offset) + offset;
+  if (type == TypeId::kBoolean || type == TypeId::kVarChar) {
+    result.SetCount(count);
+  } else {
+    // the layouts match, no copy is needed
+    auto values = static_cast<const char*>(array.buffers[1]);
+    result.Reference(type,
+                     const_cast<char*>(values) + start * GetTypeIdSize(type),
+                     count);
+  }
+  auto validity = array.null_count != 0
+                      ? static_cast<const uint8_t*>(array.buffers[0])
+                      : nullptr;
+  for (size_t i = 0; i < count; i++) {
+    result.SetNull(i, validity && !GetBit(validity, start + i));
+  }
+
+  if (type == TypeId::kBoolean) {
+    auto values = static_cast<const uint8_t*>(array.buffers[1]);
+    auto output = result.GetData<int8_t>();
+    for (size_t i = 0; i < count; i++) {
+      output[i] = GetBit(values, start + i);
+    }
+  } else if (type == TypeId::kVarChar) {
+    if (schema.format[0] == 'U') {
+      ReadStrings<int64_t>(array, start, count, result);
+    } else {
+      ReadStrings<int32_t>(array, start, count, result);
+    }
+  }
+}
+
+void ChunkCollectionToArrow(const ChunkCollection& collection,
+                            const std::vector<std::string>& names,
+                            ArrowSchema* schema, ArrowArray* array) {
+  auto& types      = collection.GetTypes();
+  auto schema_data = std::make_unique<ArrowSchemaData>();
+  auto array_data  = std::make_unique<ArrowArrayData>();
+  schema_data->children.resize(types.size());
+  array_data->children.resize(types.size());
+  for (auto& child : schema_data->children) {
+    child.release = nullptr;
+  }
+  for (auto& child : array_data->children) {
+    child.release = nullptr;
+  }
+  // on an error the children exported so far are released with the data
+  // of their parent
+  for (size_t i = 0; i < types.size(); i++) {
+    auto child_data  = std::make_unique<ArrowSchemaData>();
+    child_data->name = i < names.size() ? names[i] : "";
+    PublishSchema(std::move(child_data), TypeToArrowFormat(types[i]),
+                  &schema_data->children[i]);
+    ExportColumn(collection, i, &array_data->children[i]);
+  }
+  // a struct array has a single (validity) buffer
+  array_data->buffers.push_back(nullptr);
+  PublishSchema(std::move(schema_data), "+s", schema);
+  PublishArray(std::move(array_data), collection.GetCount(), 0, array);
+}
+
+}  // namespace zoomdb
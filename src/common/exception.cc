@@ -84,13 +84,15 @@ std::string Exception::ExceptionTypeToString(ExceptionType type) const {
     case ExceptionType::kSettings:
       return "Settings";
     case ExceptionType::kBinder:
-      return "Optimizer";
+      return "Binder";
     case ExceptionType::kNetwork:
       return "Network";
     case ExceptionType::kOptimizer:
       return "Optimizer";
     case ExceptionType::kNullPointer:
       return "Null Pointer";
+    case ExceptionType::kIO:
+      return "IO";
     default:
       return "Unknown";
   }
@@ -445,4 +447,13 @@ NullPointerException::NullPointerException(std::string msg, ...)
   FormatConstruct(msg);
 }
 
+/**
+ * Class IOException
+ */
+
+IOException::IOException(std::string msg, ...)
+    : Exception(ExceptionType::kIO, msg) {
+  FormatConstruct(msg);
+}
+
 }  // namespace zoomdb
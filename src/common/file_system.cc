@@ -0,0 +1,73 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/file_system.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+MappedFile::MappedFile(const std::string& path)
+    : path_(path), data_(nullptr), size_(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw IOException("Could not open file \"%s\": %s", path.c_str(),
+                      std::strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    auto error = errno;
+    close(fd);
+    throw IOException("Could not stat file \"%s\": %s", path.c_str(),
+                      std::strerror(error));
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0) {
+    auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      auto error = errno;
+      close(fd);
+      throw IOException("Could not map file \"%s\": %s", path.c_str(),
+                        std::strerror(error));
+    }
+    // the file is read front to back, let the kernel read ahead aggressively
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+  }
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+}
+
+void MappedFile::Prefetch(size_t offset, size_t length) const {
+  if (!data_ || offset >= size_) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+  // madvise() requires a page aligned address
+  auto page  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto start = offset / page * page;
+  // only a hint, a failure just means the data is read on access
+  madvise(const_cast<char*>(data_) + start, offset + length - start,
+          MADV_WILLNEED);
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+}  // namespace zoomdb
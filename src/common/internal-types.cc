@@ -7,6 +7,7 @@
 
 #include "common/internal-types.hpp"
 
+#include "common/exception.hpp"
 #include "common/string_util.hpp"
 
 namespace zoomdb {
@@ -90,6 +91,12 @@ ExpressionType StringToExpressionType(const std::string& str) {
     return ExpressionType::kAggregateMax;
   } else if (upper_str == "AGGREGATE_AVG") {
     return ExpressionType::kAggregateAvg;
+  } else if (upper_str == "AGGREGATE_APPROX_COUNT_DISTINCT") {
+    return ExpressionType::kAggregateApproxCountDistinct;
+  } else if (upper_str == "AGGREGATE_APPROX_QUANTILE") {
+    return ExpressionType::kAggregateApproxQuantile;
+  } else if (upper_str == "WINDOW_AGGREGATE") {
+    return ExpressionType::kWindowAggregate;
   } else if (upper_str == "FUNCTION") {
     return ExpressionType::kFunction;
   } else if (upper_str == "HASH_RANGE") {
@@ -119,6 +126,120 @@ ExpressionType StringToExpressionType(const std::string& str) {
   return ExpressionType::kInvalid;
 }
 
+std::string ExpressionTypeToString(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kInvalid:
+      return "INVALID";
+    case ExpressionType::kOperatorPlus:
+      return "OPERATOR_PLUS";
+    case ExpressionType::kOperatorMinus:
+      return "OPERATOR_MINUS";
+    case ExpressionType::kOperatorMultiply:
+      return "OPERATOR_MULTIPLY";
+    case ExpressionType::kOperatorDivide:
+      return "OPERATOR_DIVIDE";
+    case ExpressionType::kOperatorConcat:
+      return "OPERATOR_CONCAT";
+    case ExpressionType::kOperatorMod:
+      return "OPERATOR_MOD";
+    case ExpressionType::kOperatorCast:
+      return "OPERATOR_CAST";
+    case ExpressionType::kOperatorNot:
+      return "OPERATOR_NOT";
+    case ExpressionType::kOperatorIsNull:
+      return "OPERATOR_IS_NULL";
+    case ExpressionType::kOperatorIsNotNull:
+      return "OPERATOR_IS_NOT_NULL";
+    case ExpressionType::kOperatorExists:
+      return "OPERATOR_EXISTS";
+    case ExpressionType::kOperatorUnaryMinus:
+      return "OPERATOR_UNARY_MINUS";
+    case ExpressionType::kCompareEqual:
+      return "COMPARE_EQUAL";
+    case ExpressionType::kCompareNotEqual:
+      return "COMPARE_NOTEQUAL";
+    case ExpressionType::kCompareLessThan:
+      return "COMPARE_LESSTHAN";
+    case ExpressionType::kCompareGreaterThan:
+      return "COMPARE_GREATERTHAN";
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      return "COMPARE_LESSTHANOREQUALTO";
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      return "COMPARE_GREATERTHANOREQUALTO";
+    case ExpressionType::kCompareLike:
+      return "COMPARE_LIKE";
+    case ExpressionType::kCompareNotLike:
+      return "COMPARE_NOTLIKE";
+    case ExpressionType::kCompareIn:
+      return "COMPARE_IN";
+    case ExpressionType::kCompareDistinctFrom:
+      return "COMPARE_DISTINCT_FROM";
+    case ExpressionType::kConjunctionAnd:
+      return "CONJUNCTION_AND";
+    case ExpressionType::kConjunctionOr:
+      return "CONJUNCTION_OR";
+    case ExpressionType::kValueConstant:
+      return "VALUE_CONSTANT";
+    case ExpressionType::kValueParameter:
+      return "VALUE_PARAMETER";
+    case ExpressionType::kValueTuple:
+      return "VALUE_TUPLE";
+    case ExpressionType::kValueTupleAddress:
+      return "VALUE_TUPLE_ADDRESS";
+    case ExpressionType::kValueNull:
+      return "VALUE_NULL";
+    case ExpressionType::kValueVector:
+      return "VALUE_VECTOR";
+    case ExpressionType::kValueScalar:
+      return "VALUE_SCALAR";
+    case ExpressionType::kAggregateCount:
+      return "AGGREGATE_COUNT";
+    case ExpressionType::kAggregateCountStar:
+      return "AGGREGATE_COUNT_STAR";
+    case ExpressionType::kAggregateSum:
+      return "AGGREGATE_SUM";
+    case ExpressionType::kAggregateMin:
+      return "AGGREGATE_MIN";
+    case ExpressionType::kAggregateMax:
+      return "AGGREGATE_MAX";
+    case ExpressionType::kAggregateAvg:
+      return "AGGREGATE_AVG";
+    case ExpressionType::kAggregateApproxCountDistinct:
+      return "AGGREGATE_APPROX_COUNT_DISTINCT";
+    case ExpressionType::kAggregateApproxQuantile:
+      return "AGGREGATE_APPROX_QUANTILE";
+    case ExpressionType::kWindowAggregate:
+      return "WINDOW_AGGREGATE";
+    case ExpressionType::kFunction:
+      return "FUNCTION";
+    case ExpressionType::kHashRange:
+      return "HASH_RANGE";
+    case ExpressionType::kOperatorCaseExpr:
+      return "OPERATOR_CASE_EXPR";
+    case ExpressionType::kOperatorNullIf:
+      return "OPERATOR_NULLIF";
+    case ExpressionType::kOperatorCoalesce:
+      return "OPERATOR_COALESCE";
+    case ExpressionType::kRowSubQuery:
+      return "ROW_SUBQUERY";
+    case ExpressionType::kSelectSubQuery:
+      return "SELECT_SUBQUERY";
+    case ExpressionType::kStar:
+      return "STAR";
+    case ExpressionType::kPlaceholder:
+      return "PLACEHOLDER";
+    case ExpressionType::kColumnRef:
+      return "COLUMN_REF";
+    case ExpressionType::kFunctionRef:
+      return "FUNCTION_REF";
+    case ExpressionType::kCast:
+      return "CAST";
+    case ExpressionType::kTableRef:
+      return "TABLE_REF";
+  }
+  return "INVALID";
+}
+
 std::string TypeIdToString(TypeId type) {
   switch (type) {
     case TypeId::kInvalid:
@@ -153,6 +274,23 @@ std::string TypeIdToString(TypeId type) {
   return "INVALID";
 }
 
+std::string JoinTypeToString(JoinType type) {
+  switch (type) {
+    case JoinType::kInner:
+      return "INNER";
+    case JoinType::kLeft:
+      return "LEFT";
+    case JoinType::kSemi:
+      return "SEMI";
+    case JoinType::kAnti:
+      return "ANTI";
+    case JoinType::kMark:
+      return "MARK";
+    default:
+      return "INVALID";
+  }
+}
+
 TypeId StringToTypeId(const std::string& str) {
   auto upper_str = StringUtil::Upper(str);
   if (upper_str == "INVALID") {
@@ -185,4 +323,36 @@ TypeId StringToTypeId(const std::string& str) {
   return TypeId::kInvalid;
 }
 
+size_t GetTypeIdSize(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+    case TypeId::kTinyInt:
+      return sizeof(int8_t);
+    case TypeId::kSmallInt:
+      return sizeof(int16_t);
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      return sizeof(int32_t);
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      return sizeof(int64_t);
+    case TypeId::kDecimal:
+      return sizeof(double);
+    case TypeId::kVarChar:
+      return sizeof(const char*);
+    default:
+      throw NotImplementationException("Unimplemented type %s for GetTypeIdSize",
+                                       TypeIdToString(type).c_str());
+  }
+}
+
+bool TypeIsIntegral(TypeId type) {
+  return type == TypeId::kTinyInt || type == TypeId::kSmallInt ||
+         type == TypeId::kInteger || type == TypeId::kBigInt;
+}
+
+bool TypeIsNumeric(TypeId type) {
+  return TypeIsIntegral(type) || type == TypeId::kDecimal;
+}
+
 }  // namespace zoomdb
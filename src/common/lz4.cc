@@ -0,0 +1,162 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/lz4.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+constexpr size_t kMinMatch     = 4;
+// the last match starts at least kMatchLimit bytes before the end, and the
+// last kLastLiterals bytes are literals
+constexpr size_t kMatchLimit   = 12;
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMaxOffset    = 65535;
+constexpr uint32_t kHashBits   = 12;
+
+uint32_t Read32(const uint8_t* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashBits);
+}
+
+/**
+ * Append a length in the continuation bytes following a token nibble.
+ */
+void WriteLength(size_t length, std::vector<uint8_t>& output) {
+  for (; length >= 255; length -= 255) {
+    output.push_back(255);
+  }
+  output.push_back(static_cast<uint8_t>(length));
+}
+
+void WriteSequence(const uint8_t* literals, size_t literal_length,
+                   size_t offset, size_t match_length,
+                   std::vector<uint8_t>& output) {
+  auto token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+  if (offset > 0) {
+    token = static_cast<uint8_t>(
+        token | std::min<size_t>(match_length - kMinMatch, 15));
+  }
+  output.push_back(token);
+  if (literal_length >= 15) {
+    WriteLength(literal_length - 15, output);
+  }
+  output.insert(output.end(), literals, literals + literal_length);
+  if (offset == 0) {
+    return;
+  }
+  output.push_back(static_cast<uint8_t>(offset));
+  output.push_back(static_cast<uint8_t>(offset >> 8));
+  if (match_length - kMinMatch >= 15) {
+    WriteLength(match_length - kMinMatch - 15, output);
+  }
+}
+
+size_t ReadLength(const uint8_t*& input, const uint8_t* end) {
+  size_t length = 0;
+  uint8_t byte;
+  do {
+    if (input >= end) {
+      throw SerializationException("Truncated LZ4 block");
+    }
+    byte = *input++;
+    length += byte;
+  } while (byte == 255);
+  return length;
+}
+
+}  // namespace
+
+void LZ4Compress(const uint8_t* data, size_t size,
+                 std::vector<uint8_t>& output) {
+  // the positions of the last sequences with every hash, 0 for none (the
+  // first position never starts a match)
+  std::vector<uint32_t> table(size_t{1} << kHashBits, 0);
+  size_t anchor = 0;
+  if (size > kMatchLimit) {
+    auto match_end = size - kLastLiterals;
+    for (size_t position = 1; position + kMatchLimit <= size;) {
+      auto sequence = Read32(data + position);
+      auto& entry   = table[HashSequence(sequence)];
+      size_t match  = entry;
+      entry         = static_cast<uint32_t>(position);
+      if (match == 0 || position - match > kMaxOffset ||
+          Read32(data + match) != sequence) {
+        position++;
+        continue;
+      }
+      auto length = kMinMatch;
+      while (position + length < match_end &&
+             data[match + length] == data[position + length]) {
+        length++;
+      }
+      WriteSequence(data + anchor, position - anchor, position - match,
+                    length, output);
+      position += length;
+      anchor = position;
+    }
+  }
+  WriteSequence(data + anchor, size - anchor, 0, 0, output);
+}
+
+void LZ4Decompress(const uint8_t* data, size_t size, uint8_t* output,
+                   size_t size_decompressed) {
+  auto input      = data;
+  auto end        = data + size;
+  size_t position = 0;
+  while (input < end) {
+    auto token      = *input++;
+    size_t literals = token >> 4;
+    if (literals == 15) {
+      literals += ReadLength(input, end);
+    }
+    if (literals > static_cast<size_t>(end - input) ||
+        literals > size_decompressed - position) {
+      throw SerializationException("Malformed LZ4 block");
+    }
+    std::memcpy(output + position, input, literals);
+    input += literals;
+    position += literals;
+    if (input == end) {
+      // the last sequence has no match
+      break;
+    }
+    if (end - input < 2) {
+      throw SerializationException("Truncated LZ4 block");
+    }
+    size_t offset = input[0] | static_cast<size_t>(input[1]) << 8;
+    input += 2;
+    size_t length = (token & 15) + kMinMatch;
+    if ((token & 15) == 15) {
+      length += ReadLength(input, end);
+    }
+    if (offset == 0 || offset > position ||
+        length > size_decompressed - position) {
+      throw SerializationException("Malformed LZ4 block");
+    }
+    // the match may overlap the output it produces, copy byte by byte
+    for (size_t i = 0; i < length; i++, position++) {
+      output[position] = output[position - offset];
+    }
+  }
+  if (position != size_decompressed) {
+    throw SerializationException("LZ4 block has the wrong decompressed size");
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,97 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace zoomdb {
+
+void ParallelFor(size_t count, size_t thread_count,
+                 const std::function<void(size_t)>& task) {
+  if (thread_count == 0) {
+    thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (auto i = next++; i < count; i = next++) {
+      task(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(thread_count, count); i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void ParallelDistinct(size_t count,
+                      const std::function<uint64_t(size_t)>& hash,
+                      const std::function<bool(size_t, size_t)>& equals,
+                      const std::function<void(size_t, size_t)>& task) {
+  constexpr size_t kRangeSize = 16384;
+  auto range_count            = (count + kRangeSize - 1) / kRangeSize;
+  std::vector<uint64_t> hashes(count);
+  // the entries of every range by partition
+  std::vector<std::vector<std::vector<size_t>>> ranges(range_count);
+  std::vector<std::exception_ptr> errors(
+      std::max(range_count, kDistinctPartitions));
+  ParallelFor(range_count, 0, [&](size_t r) {
+    try {
+      auto& partitions = ranges[r];
+      partitions.resize(kDistinctPartitions);
+      auto end = std::min(count, (r + 1) * kRangeSize);
+      for (auto entry = r * kRangeSize; entry < end; entry++) {
+        hashes[entry] = hash(entry);
+        partitions[hashes[entry] >> (64 - kDistinctRadixBits)].push_back(
+            entry);
+      }
+    } catch (...) {
+      errors[r] = std::current_exception();
+    }
+  });
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  auto entry_hash   = [&](size_t entry) { return hashes[entry]; };
+  auto entry_equals = [&](size_t left, size_t right) {
+    return equals(left, right);
+  };
+  ParallelFor(kDistinctPartitions, 0, [&](size_t p) {
+    try {
+      std::unordered_set<size_t, decltype(entry_hash), decltype(entry_equals)>
+          seen(0, entry_hash, entry_equals);
+      for (auto& partitions : ranges) {
+        for (auto entry : partitions[p]) {
+          if (seen.insert(entry).second) {
+            task(p, entry);
+          }
+        }
+      }
+    } catch (...) {
+      errors[p] = std::current_exception();
+    }
+  });
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace zoomdb
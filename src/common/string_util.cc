@@ -173,7 +173,12 @@ std::string StringUtil::VFormat(const std::string fmt_str, va_list ap) {
     // Wrap the plain char array int the unique_ptr
     formatted.reset(new char[n]);
     std::strcpy(&formatted[0], fmt_str.c_str());
-    final_n = vsnprintf(&formatted[0], n, fmt_str.c_str(), ap);
+    // the arguments are consumed by vsnprintf, format from a copy so they
+    // can be formatted again if the buffer is too small
+    va_list args;
+    va_copy(args, ap);
+    final_n = vsnprintf(&formatted[0], n, fmt_str.c_str(), args);
+    va_end(args);
     if (final_n < 0 || static_cast<decltype(n)>(final_n) >= n) {
       n = static_cast<decltype(n)>(std::abs(final_n + 1));
     } else {
@@ -0,0 +1,66 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/chunk_collection.hpp"
+
+#include <algorithm>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+ChunkCollection::ChunkCollection() : count_(0) {}
+
+void ChunkCollection::Append(const DataChunk& chunk) {
+  if (chunk.GetCount() == 0) {
+    return;
+  }
+  if (types_.empty()) {
+    types_ = chunk.GetTypes();
+  } else if (types_ != chunk.GetTypes()) {
+    throw TypeMismatchException("Appending a chunk of different types",
+                                types_[0], chunk.GetTypes()[0]);
+  }
+  size_t offset    = 0;
+  size_t remaining = chunk.GetCount();
+  while (remaining > 0) {
+    if (chunks_.empty() ||
+        chunks_.back()->GetCount() == kStandardVectorSize) {
+      chunks_.push_back(std::make_unique<DataChunk>());
+      chunks_.back()->Initialize(types_);
+    }
+    auto& last     = *chunks_.back();
+    size_t to_copy = std::min(remaining, kStandardVectorSize - last.GetCount());
+    last.Append(chunk, offset, to_copy);
+    offset    += to_copy;
+    remaining -= to_copy;
+  }
+  count_ += chunk.GetCount();
+}
+
+Value ChunkCollection::GetValue(size_t column, size_t row) const {
+  return chunks_[row / kStandardVectorSize]->GetValue(
+      column, row % kStandardVectorSize);
+}
+
+size_t ChunkCollection::GetAllocationSize() const {
+  size_t result = 0;
+  for (auto& chunk : chunks_) {
+    result += chunk->GetAllocationSize();
+  }
+  return result;
+}
+
+std::string ChunkCollection::ToString() const {
+  std::string result;
+  for (auto& chunk : chunks_) {
+    result += chunk->ToString();
+  }
+  return result;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,94 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/data_chunk.hpp"
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+void DataChunk::Initialize(const std::vector<TypeId>& types) {
+  data_.clear();
+  data_.reserve(types.size());
+  for (auto type : types) {
+    data_.emplace_back(type);
+  }
+}
+
+void DataChunk::Reset() {
+  for (auto& vector : data_) {
+    vector.Reset();
+  }
+  selection_      = nullptr;
+  selected_count_ = 0;
+}
+
+void DataChunk::Destroy() {
+  data_.clear();
+  selection_      = nullptr;
+  selected_count_ = 0;
+}
+
+std::vector<TypeId> DataChunk::GetTypes() const {
+  std::vector<TypeId> types;
+  types.reserve(data_.size());
+  for (auto& vector : data_) {
+    types.push_back(vector.GetType());
+  }
+  return types;
+}
+
+void DataChunk::SetSelection(const sel_t* selection, size_t count) {
+  selection_      = selection;
+  selected_count_ = count;
+}
+
+Value DataChunk::GetValue(size_t column, size_t row) const {
+  return data_[column].GetValue(selection_ ? selection_[row] : row);
+}
+
+void DataChunk::SetValue(size_t column, size_t row, const Value& value) {
+  data_[column].SetValue(row, value);
+}
+
+void DataChunk::Append(const DataChunk& other) {
+  Append(other, 0, other.GetCount());
+}
+
+void DataChunk::Append(const DataChunk& other, size_t start, size_t count) {
+  if (other.ColumnCount() != ColumnCount()) {
+    throw Exception(ExceptionType::kMismatchType,
+                    "Column counts of appended chunk do not match");
+  }
+  for (size_t i = 0; i < data_.size(); i++) {
+    if (other.selection_) {
+      data_[i].AppendSelection(other.data_[i], other.selection_ + start,
+                               count);
+    } else {
+      data_[i].Append(other.data_[i], start, count);
+    }
+  }
+}
+
+size_t DataChunk::GetAllocationSize() const {
+  size_t size = 0;
+  for (auto& vector : data_) {
+    size += vector.GetAllocationSize();
+  }
+  return size;
+}
+
+std::string DataChunk::ToString() const {
+  std::string result = "DataChunk - [" + std::to_string(ColumnCount()) +
+                       " Columns, " + std::to_string(GetCount()) + " Rows]\n";
+  for (auto& vector : data_) {
+    result += "- " + vector.ToString() + "\n";
+  }
+  return result;
+}
+
+}  // namespace zoomdb
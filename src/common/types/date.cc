@@ -0,0 +1,120 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/date.hpp"
+
+#include <cctype>
+#include <cstdio>
+
+#include "common/exception.hpp"
+#include "common/string_util.hpp"
+
+namespace zoomdb {
+
+static bool IsLeapYear(int32_t year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+bool Date::IsValidDay(int32_t year, int32_t month, int32_t day) {
+  static const int32_t kDaysPerMonth[] = {31, 28, 31, 30, 31, 30,
+                                          31, 31, 30, 31, 30, 31};
+  if (month < 1 || month > 12 || day < 1) {
+    return false;
+  }
+  if (month == 2 && IsLeapYear(year)) {
+    return day <= 29;
+  }
+  return day <= kDaysPerMonth[month - 1];
+}
+
+int32_t Date::FromDate(int32_t year, int32_t month, int32_t day) {
+  // Based on: http://howardhinnant.github.io/date_algorithms.html
+  year -= month <= 2;
+  const int32_t era = (year >= 0 ? year : year - 399) / 400;
+  const int32_t yoe = year - era * 400;
+  const int32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+void Date::Convert(int32_t date, int32_t& year, int32_t& month,
+                   int32_t& day) {
+  date += 719468;
+  const int32_t era = (date >= 0 ? date : date - 146096) / 146097;
+  const int32_t doe = date - era * 146097;
+  const int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int32_t mp  = (5 * doy + 2) / 153;
+  day               = doy - (153 * mp + 2) / 5 + 1;
+  month             = mp < 10 ? mp + 3 : mp - 9;
+  year              = yoe + era * 400 + (month <= 2);
+}
+
+int32_t Date::FromString(const std::string& str) {
+  int32_t year, month, day;
+  int consumed = 0;
+  if (sscanf(str.c_str(), "%d-%d-%d%n", &year, &month, &day, &consumed) != 3 ||
+      static_cast<size_t>(consumed) != str.size() ||
+      !IsValidDay(year, month, day)) {
+    throw ConversionException("date/time field value out of range: \"%s\"",
+                              str.c_str());
+  }
+  return FromDate(year, month, day);
+}
+
+std::string Date::ToString(int32_t date) {
+  int32_t year, month, day;
+  Convert(date, year, month, day);
+  return StringUtil::Format("%04d-%02d-%02d", year, month, day);
+}
+
+int64_t Timestamp::FromString(const std::string& str) {
+  int32_t year, month, day, hour = 0, minute = 0, second = 0;
+  int64_t micros = 0;
+  int consumed   = 0;
+  auto n = sscanf(str.c_str(), "%d-%d-%d%n %d:%d:%d%n", &year, &month, &day,
+                  &consumed, &hour, &minute, &second, &consumed);
+  auto pos = static_cast<size_t>(consumed);
+  if (n == 6 && pos < str.size() && str[pos] == '.') {
+    // fractional seconds, up to microsecond precision
+    int64_t scale = Timestamp::kMicrosPerSecond;
+    for (pos++; pos < str.size() && isdigit(str[pos]); pos++) {
+      scale /= 10;
+      micros += (str[pos] - '0') * scale;
+    }
+  }
+  if ((n != 3 && n != 6) || pos != str.size() ||
+      !Date::IsValidDay(year, month, day) || hour < 0 || hour > 23 ||
+      minute < 0 || minute > 59 || second < 0 || second > 59) {
+    throw ConversionException("date/time field value out of range: \"%s\"",
+                              str.c_str());
+  }
+  int64_t time = ((hour * 60 + minute) * 60 + second) * kMicrosPerSecond;
+  return FromDate(Date::FromDate(year, month, day)) + time + micros;
+}
+
+std::string Timestamp::ToString(int64_t timestamp) {
+  auto date   = GetDate(timestamp);
+  auto time   = timestamp - FromDate(date);
+  auto second = time / kMicrosPerSecond;
+  return Date::ToString(date) +
+         StringUtil::Format(" %02d:%02d:%02d", static_cast<int>(second / 3600),
+                            static_cast<int>(second / 60 % 60),
+                            static_cast<int>(second % 60));
+}
+
+int32_t Timestamp::GetDate(int64_t timestamp) {
+  auto days = timestamp / kMicrosPerDay;
+  if (timestamp < 0 && timestamp % kMicrosPerDay != 0) {
+    days--;
+  }
+  return static_cast<int32_t>(days);
+}
+
+int64_t Timestamp::FromDate(int32_t date) { return date * kMicrosPerDay; }
+
+}  // namespace zoomdb
@@ -0,0 +1,43 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/hyperloglog.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace zoomdb {
+
+HyperLogLog::HyperLogLog() { Clear(); }
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+  for (uint32_t i = 0; i < kRegisterCount; i++) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+uint64_t HyperLogLog::Count() const {
+  const auto m       = static_cast<double>(kRegisterCount);
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+  double sum         = 0;
+  uint32_t zeros     = 0;
+  for (auto reg : registers_) {
+    sum += std::ldexp(1.0, -reg);
+    zeros += reg == 0;
+  }
+  double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    // small range correction: linear counting
+    estimate = m * std::log(m / zeros);
+  }
+  return static_cast<uint64_t>(std::llround(estimate));
+}
+
+void HyperLogLog::Clear() { registers_.fill(0); }
+
+}  // namespace zoomdb
@@ -0,0 +1,121 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/quantile_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * The scale function k1 of the t-digest, which maps a quantile to the index
+ * of a centroid. A centroid spans at most one unit of k, which limits the
+ * centroids near q = 0 and q = 1 to few values.
+ */
+double ScaleIndex(double q) {
+  return QuantileSketch::kCompression / (2 * std::numbers::pi) *
+         std::asin(2 * q - 1);
+}
+
+double ScaleQuantile(double k) {
+  auto angle = k * 2 * std::numbers::pi / QuantileSketch::kCompression;
+  if (angle >= std::numbers::pi / 2) {
+    return 1;
+  }
+  return (std::sin(angle) + 1) / 2;
+}
+
+}  // namespace
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+  other.Compress();
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  buffer_.insert(buffer_.end(), other.centroids_.begin(),
+                 other.centroids_.end());
+  Compress();
+}
+
+double QuantileSketch::Quantile(double q) const {
+  Compress();
+  auto& c    = centroids_;
+  auto total = Count();
+  auto index = std::clamp(q, 0.0, 1.0) * total;
+  // the mean of a centroid is placed at the middle of its weight, the
+  // quantiles in between are interpolated linearly
+  auto position = c[0].weight / 2;
+  if (index <= position) {
+    return min_ + (c[0].mean - min_) * index / position;
+  }
+  for (size_t i = 0; i + 1 < c.size(); i++) {
+    auto step = (c[i].weight + c[i + 1].weight) / 2;
+    if (index <= position + step) {
+      auto fraction = (index - position) / step;
+      return c[i].mean + fraction * (c[i + 1].mean - c[i].mean);
+    }
+    position += step;
+  }
+  auto rest = c.back().weight / 2;
+  return c.back().mean + (max_ - c.back().mean) * (index - position) / rest;
+}
+
+double QuantileSketch::Count() const {
+  double count = 0;
+  for (auto& centroid : centroids_) {
+    count += centroid.weight;
+  }
+  return count + static_cast<double>(buffer_.size());
+}
+
+void QuantileSketch::Clear() {
+  centroids_.clear();
+  buffer_.clear();
+  min_ = std::numeric_limits<double>::infinity();
+  max_ = -std::numeric_limits<double>::infinity();
+}
+
+void QuantileSketch::Compress() const {
+  if (buffer_.empty()) {
+    return;
+  }
+  buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+  std::sort(buffer_.begin(), buffer_.end(),
+            [](const Centroid& a, const Centroid& b) {
+              return a.mean < b.mean;
+            });
+  double total = 0;
+  for (auto& centroid : buffer_) {
+    total += centroid.weight;
+  }
+
+  centroids_.clear();
+  auto current = buffer_[0];
+  double seen  = 0;
+  auto limit   = ScaleQuantile(ScaleIndex(0) + 1) * total;
+  for (size_t i = 1; i < buffer_.size(); i++) {
+    auto& next = buffer_[i];
+    if (seen + current.weight + next.weight <= limit) {
+      current.weight += next.weight;
+      current.mean += (next.mean - current.mean) * next.weight /
+                      current.weight;
+    } else {
+      seen += current.weight;
+      centroids_.push_back(current);
+      limit   = ScaleQuantile(ScaleIndex(seen / total) + 1) * total;
+      current = next;
+    }
+  }
+  centroids_.push_back(current);
+  buffer_.clear();
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,45 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/string_dictionary.hpp"
+
+namespace zoomdb {
+
+StringDictionary::StringDictionary() : size_(0) {}
+
+uint32_t StringDictionary::Add(const char* str) {
+  std::string_view key(str);
+  auto entry = codes_.find(key);
+  if (entry != codes_.end()) {
+    return entry->second;
+  }
+  auto size = size_.load(std::memory_order_relaxed);
+  if (size == kMaxSize) {
+    return kInvalidCode;
+  }
+  auto& block = blocks_[size / kStandardVectorSize];
+  if (!block) {
+    block.reset(new const char*[kStandardVectorSize]);
+  }
+  auto copy = heap_.AddString(key.data(), key.size());
+  auto code = static_cast<uint32_t>(size);
+  block[size % kStandardVectorSize] = copy;
+  codes_.emplace(std::string_view(copy, key.size()), code);
+  // publish the entry only once it is complete
+  size_.store(size + 1, std::memory_order_release);
+  return code;
+}
+
+size_t StringDictionary::GetAllocationSize() const {
+  auto size   = GetSize();
+  auto blocks = (size + kStandardVectorSize - 1) / kStandardVectorSize;
+  return heap_.GetAllocationSize() +
+         blocks * kStandardVectorSize * sizeof(const char*) +
+         size * (sizeof(std::string_view) + sizeof(uint32_t));
+}
+
+}  // namespace zoomdb
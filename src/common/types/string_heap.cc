@@ -0,0 +1,41 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/string_heap.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace zoomdb {
+
+const char* StringHeap::AddString(const char* data, size_t len) {
+  auto required = len + 1;
+  if (blocks_.empty() || offset_ + required > capacity_) {
+    capacity_ = std::max(kMinimumBlockSize, required);
+    blocks_.emplace_back(new char[capacity_]);
+    offset_ = 0;
+    allocated_ += capacity_;
+  }
+  char* result = blocks_.back().get() + offset_;
+  std::memcpy(result, data, len);
+  result[len] = '\0';
+  offset_ += required;
+  return result;
+}
+
+const char* StringHeap::AddString(const char* str) {
+  return AddString(str, std::strlen(str));
+}
+
+void StringHeap::Destroy() {
+  blocks_.clear();
+  offset_    = 0;
+  capacity_  = 0;
+  allocated_ = 0;
+}
+
+}  // namespace zoomdb
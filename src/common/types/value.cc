@@ -0,0 +1,453 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/value.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "common/exception.hpp"
+#include "common/string_util.hpp"
+#include "common/types/date.hpp"
+#include "common/types/hash.hpp"
+
+namespace zoomdb {
+
+Value::Value() : Value(TypeId::kInteger) {}
+
+Value::Value(TypeId type) : type_(type), is_null_(true) { value_.bigint = 0; }
+
+Value::Value(int32_t value) : type_(TypeId::kInteger), is_null_(false) {
+  value_.integer = value;
+}
+
+Value::Value(int64_t value) : type_(TypeId::kBigInt), is_null_(false) {
+  value_.bigint = value;
+}
+
+Value::Value(double value) : type_(TypeId::kDecimal), is_null_(false) {
+  value_.decimal = value;
+}
+
+Value::Value(std::string value)
+    : type_(TypeId::kVarChar), is_null_(false), str_value_(std::move(value)) {
+  value_.bigint = 0;
+}
+
+Value::Value(const char* value) : Value(std::string(value)) {}
+
+Value Value::Boolean(bool value) {
+  Value result(TypeId::kBoolean);
+  result.value_.boolean = value ? 1 : 0;
+  result.is_null_       = false;
+  return result;
+}
+
+Value Value::TinyInt(int8_t value) {
+  Value result(TypeId::kTinyInt);
+  result.value_.tinyint = value;
+  result.is_null_       = false;
+  return result;
+}
+
+Value Value::SmallInt(int16_t value) {
+  Value result(TypeId::kSmallInt);
+  result.value_.smallint = value;
+  result.is_null_        = false;
+  return result;
+}
+
+Value Value::Integer(int32_t value) { return Value(value); }
+
+Value Value::BigInt(int64_t value) { return Value(value); }
+
+Value Value::Decimal(double value) { return Value(value); }
+
+Value Value::Date(int32_t value) {
+  Value result(TypeId::kDate);
+  result.value_.date = value;
+  result.is_null_    = false;
+  return result;
+}
+
+Value Value::Timestamp(int64_t value) {
+  Value result(TypeId::kTimestamp);
+  result.value_.timestamp = value;
+  result.is_null_         = false;
+  return result;
+}
+
+Value Value::VarChar(std::string value) { return Value(std::move(value)); }
+
+Value Value::Numeric(TypeId type, int64_t value) {
+  switch (type) {
+    case TypeId::kBoolean:
+      return Value::Boolean(value != 0);
+    case TypeId::kTinyInt:
+      return Value::TinyInt(static_cast<int8_t>(value));
+    case TypeId::kSmallInt:
+      return Value::SmallInt(static_cast<int16_t>(value));
+    case TypeId::kInteger:
+      return Value::Integer(static_cast<int32_t>(value));
+    case TypeId::kBigInt:
+      return Value::BigInt(value);
+    case TypeId::kDate:
+      return Value::Date(static_cast<int32_t>(value));
+    case TypeId::kTimestamp:
+      return Value::Timestamp(value);
+    case TypeId::kDecimal:
+      return Value::Decimal(static_cast<double>(value));
+    default:
+      throw IncompatibleTypeException(static_cast<int>(type),
+                                    "Numeric requires numeric type");
+  }
+}
+
+Value Value::MinimumValue(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+      return Value::Boolean(false);
+    case TypeId::kTinyInt:
+      return Value::TinyInt(std::numeric_limits<int8_t>::min());
+    case TypeId::kSmallInt:
+      return Value::SmallInt(std::numeric_limits<int16_t>::min());
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      return Numeric(type, std::numeric_limits<int32_t>::min());
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      return Numeric(type, std::numeric_limits<int64_t>::min());
+    case TypeId::kDecimal:
+      return Value::Decimal(std::numeric_limits<double>::lowest());
+    default:
+      throw IncompatibleTypeException(static_cast<int>(type),
+                                    "MinimumValue requires numeric type");
+  }
+}
+
+Value Value::MaximumValue(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+      return Value::Boolean(true);
+    case TypeId::kTinyInt:
+      return Value::TinyInt(std::numeric_limits<int8_t>::max());
+    case TypeId::kSmallInt:
+      return Value::SmallInt(std::numeric_limits<int16_t>::max());
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      return Numeric(type, std::numeric_limits<int32_t>::max());
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      return Numeric(type, std::numeric_limits<int64_t>::max());
+    case TypeId::kDecimal:
+      return Value::Decimal(std::numeric_limits<double>::max());
+    default:
+      throw IncompatibleTypeException(static_cast<int>(type),
+                                    "MaximumValue requires numeric type");
+  }
+}
+
+int64_t Value::GetNumericValue() const {
+  switch (type_) {
+    case TypeId::kBoolean:
+      return value_.boolean;
+    case TypeId::kTinyInt:
+      return value_.tinyint;
+    case TypeId::kSmallInt:
+      return value_.smallint;
+    case TypeId::kInteger:
+      return value_.integer;
+    case TypeId::kBigInt:
+      return value_.bigint;
+    case TypeId::kDate:
+      return value_.date;
+    case TypeId::kTimestamp:
+      return value_.timestamp;
+    default:
+      throw IncompatibleTypeException(static_cast<int>(type_),
+                                    "GetNumericValue requires numeric type");
+  }
+}
+
+template <>
+int64_t Value::GetValue() const {
+  if (is_null_) {
+    throw ConversionException("Cannot get the value of NULL");
+  }
+  if (type_ == TypeId::kDecimal) {
+    return static_cast<int64_t>(value_.decimal);
+  }
+  if (type_ == TypeId::kVarChar) {
+    return CastAs(TypeId::kBigInt).GetValue<int64_t>();
+  }
+  return GetNumericValue();
+}
+
+template <>
+double Value::GetValue() const {
+  if (is_null_) {
+    throw ConversionException("Cannot get the value of NULL");
+  }
+  if (type_ == TypeId::kDecimal) {
+    return value_.decimal;
+  }
+  if (type_ == TypeId::kVarChar) {
+    return CastAs(TypeId::kDecimal).GetValue<double>();
+  }
+  return static_cast<double>(GetNumericValue());
+}
+
+template <>
+bool Value::GetValue() const {
+  return GetValue<int64_t>() != 0;
+}
+
+template <>
+int8_t Value::GetValue() const {
+  return static_cast<int8_t>(GetValue<int64_t>());
+}
+
+template <>
+int16_t Value::GetValue() const {
+  return static_cast<int16_t>(GetValue<int64_t>());
+}
+
+template <>
+int32_t Value::GetValue() const {
+  return static_cast<int32_t>(GetValue<int64_t>());
+}
+
+template <>
+std::string Value::GetValue() const {
+  return ToString();
+}
+
+static bool IsIntegerLike(TypeId type) {
+  return TypeIsIntegral(type) || type == TypeId::kBoolean ||
+         type == TypeId::kDate || type == TypeId::kTimestamp;
+}
+
+static Value CastIntegral(int64_t value, TypeId orig_type, TypeId new_type) {
+  int64_t min, max;
+  switch (new_type) {
+    case TypeId::kTinyInt:
+      min = std::numeric_limits<int8_t>::min();
+      max = std::numeric_limits<int8_t>::max();
+      break;
+    case TypeId::kSmallInt:
+      min = std::numeric_limits<int16_t>::min();
+      max = std::numeric_limits<int16_t>::max();
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      min = std::numeric_limits<int32_t>::min();
+      max = std::numeric_limits<int32_t>::max();
+      break;
+    default:
+      min = std::numeric_limits<int64_t>::min();
+      max = std::numeric_limits<int64_t>::max();
+      break;
+  }
+  if (value < min || value > max) {
+    throw ValueOutOfRangeException(value, orig_type, new_type);
+  }
+  return Value::Numeric(new_type, value);
+}
+
+static Value CastFromString(const std::string& str, TypeId new_type) {
+  switch (new_type) {
+    case TypeId::kBoolean: {
+      auto lower = StringUtil::Lower(str);
+      if (lower == "true" || lower == "t" || lower == "1") {
+        return Value::Boolean(true);
+      } else if (lower == "false" || lower == "f" || lower == "0") {
+        return Value::Boolean(false);
+      }
+      break;
+    }
+    case TypeId::kTinyInt:
+    case TypeId::kSmallInt:
+    case TypeId::kInteger:
+    case TypeId::kBigInt: {
+      int64_t result;
+      auto end = str.data() + str.size();
+      auto res = std::from_chars(str.data(), end, result);
+      if (res.ec == std::errc::result_out_of_range) {
+        throw ValueOutOfRangeException(TypeId::kVarChar, str.size());
+      }
+      if (res.ec == std::errc() && res.ptr == end && !str.empty()) {
+        return CastIntegral(result, TypeId::kVarChar, new_type);
+      }
+      break;
+    }
+    case TypeId::kDecimal: {
+      char* end;
+      errno      = 0;
+      double res = std::strtod(str.c_str(), &end);
+      if (!str.empty() && *end == '\0' && errno == 0) {
+        return Value::Decimal(res);
+      }
+      break;
+    }
+    case TypeId::kDate:
+      return Value::Date(Date::FromString(str));
+    case TypeId::kTimestamp:
+      return Value::Timestamp(Timestamp::FromString(str));
+    default:
+      throw CastException(TypeId::kVarChar, new_type);
+  }
+  throw ConversionException("Could not convert string '%s' to %s",
+                            str.c_str(), TypeIdToString(new_type).c_str());
+}
+
+Value Value::CastAs(TypeId new_type) const {
+  if (type_ == new_type) {
+    return *this;
+  }
+  if (is_null_) {
+    return Value(new_type);
+  }
+  if (new_type == TypeId::kVarChar) {
+    return Value(ToString());
+  }
+  if (type_ == TypeId::kVarChar) {
+    return CastFromString(str_value_, new_type);
+  }
+  if (type_ == TypeId::kDate && new_type == TypeId::kTimestamp) {
+    return Value::Timestamp(Timestamp::FromDate(value_.date));
+  }
+  if (type_ == TypeId::kTimestamp && new_type == TypeId::kDate) {
+    return Value::Date(Timestamp::GetDate(value_.timestamp));
+  }
+  if ((type_ == TypeId::kDate || type_ == TypeId::kTimestamp ||
+       new_type == TypeId::kDate || new_type == TypeId::kTimestamp) &&
+      !(IsIntegerLike(type_) && IsIntegerLike(new_type))) {
+    throw CastException(type_, new_type);
+  }
+  if (type_ == TypeId::kDecimal) {
+    if (new_type == TypeId::kBoolean) {
+      return Value::Boolean(value_.decimal != 0);
+    }
+    if (!IsIntegerLike(new_type)) {
+      throw CastException(type_, new_type);
+    }
+    auto rounded = std::nearbyint(value_.decimal);
+    if (!(rounded >= -9223372036854775808.0 &&
+          rounded < 9223372036854775808.0)) {
+      throw ValueOutOfRangeException(value_.decimal, type_, new_type);
+    }
+    return CastIntegral(static_cast<int64_t>(rounded), type_, new_type);
+  }
+  if (!IsIntegerLike(type_)) {
+    throw CastException(type_, new_type);
+  }
+  if (new_type == TypeId::kDecimal) {
+    return Value::Decimal(static_cast<double>(GetNumericValue()));
+  }
+  if (new_type == TypeId::kBoolean) {
+    return Value::Boolean(GetNumericValue() != 0);
+  }
+  if (!IsIntegerLike(new_type)) {
+    throw CastException(type_, new_type);
+  }
+  return CastIntegral(GetNumericValue(), type_, new_type);
+}
+
+uint64_t Value::Hash() const {
+  if (is_null_) {
+    return 0;
+  }
+  switch (type_) {
+    case TypeId::kVarChar:
+      return HashBytes(str_value_.data(), str_value_.size());
+    case TypeId::kDecimal:
+      return zoomdb::Hash(value_.decimal);
+    default:
+      return zoomdb::Hash(GetNumericValue());
+  }
+}
+
+std::string Value::ToString() const {
+  if (is_null_) {
+    return "NULL";
+  }
+  switch (type_) {
+    case TypeId::kBoolean:
+      return value_.boolean ? "true" : "false";
+    case TypeId::kTinyInt:
+    case TypeId::kSmallInt:
+    case TypeId::kInteger:
+    case TypeId::kBigInt:
+      return std::to_string(GetNumericValue());
+    case TypeId::kDecimal: {
+      char buffer[32];
+      auto res = std::to_chars(buffer, buffer + sizeof(buffer), value_.decimal);
+      return std::string(buffer, res.ptr);
+    }
+    case TypeId::kDate:
+      return Date::ToString(value_.date);
+    case TypeId::kTimestamp:
+      return Timestamp::ToString(value_.timestamp);
+    case TypeId::kVarChar:
+      return str_value_;
+    default:
+      throw NotImplementationException("Unimplemented type %s for ToString",
+                                       TypeIdToString(type_).c_str());
+  }
+}
+
+int Value::Compare(const Value& left, const Value& right) {
+  if (left.is_null_ || right.is_null_) {
+    return static_cast<int>(right.is_null_) - static_cast<int>(left.is_null_);
+  }
+  if (left.type_ == TypeId::kVarChar && right.type_ == TypeId::kVarChar) {
+    return left.str_value_.compare(right.str_value_);
+  }
+  if (left.type_ == TypeId::kVarChar) {
+    return Compare(left.CastAs(right.type_), right);
+  }
+  if (right.type_ == TypeId::kVarChar) {
+    return Compare(left, right.CastAs(left.type_));
+  }
+  if (left.type_ == TypeId::kDecimal || right.type_ == TypeId::kDecimal) {
+    auto l = left.GetValue<double>();
+    auto r = right.GetValue<double>();
+    return l < r ? -1 : (l > r ? 1 : 0);
+  }
+  if (!IsIntegerLike(left.type_) || !IsIntegerLike(right.type_)) {
+    throw TypeMismatchException("in comparison", left.type_, right.type_);
+  }
+  auto l = left.GetNumericValue();
+  auto r = right.GetNumericValue();
+  return l < r ? -1 : (l > r ? 1 : 0);
+}
+
+size_t ValueListHash::operator()(const std::vector<Value>& values) const {
+  uint64_t result = 0;
+  for (auto& value : values) {
+    result = CombineHash(result, value.Hash());
+  }
+  return result;
+}
+
+bool ValueListEquals::operator()(const std::vector<Value>& left,
+                                 const std::vector<Value>& right) const {
+  if (left.size() != right.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < left.size(); i++) {
+    if (Value::Compare(left[i], right[i]) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,378 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/types/vector.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exception.hpp"
+#include "common/types/string_dictionary.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+template <class T>
+void Gather(const T* source, const sel_t* selection, size_t count,
+            T* target) {
+  for (size_t i = 0; i < count; i++) {
+    target[i] = source[selection[i]];
+  }
+}
+
+}  // namespace
+
+Vector::Vector()
+    : type_(TypeId::kInvalid), count_(0), data_(nullptr), codes_(nullptr) {}
+
+Vector::Vector(TypeId type, bool create_data) : Vector() {
+  type_ = type;
+  if (create_data) {
+    Initialize(type);
+  }
+}
+
+Vector::Vector(const Value& value) : Vector(value.GetType()) {
+  count_ = 1;
+  SetValue(0, value);
+}
+
+Vector::Vector(Vector&& other) noexcept
+    : type_(other.type_),
+      count_(other.count_),
+      data_(other.data_),
+      owned_data_(std::move(other.owned_data_)),
+      nullmask_(other.nullmask_),
+      string_heap_(std::move(other.string_heap_)),
+      dictionary_(std::move(other.dictionary_)),
+      codes_(other.codes_),
+      owned_codes_(std::move(other.owned_codes_)) {
+  other.data_  = nullptr;
+  other.count_ = 0;
+  other.codes_ = nullptr;
+}
+
+Vector& Vector::operator=(Vector&& other) noexcept {
+  type_        = other.type_;
+  count_       = other.count_;
+  data_        = other.data_;
+  owned_data_  = std::move(other.owned_data_);
+  nullmask_    = other.nullmask_;
+  string_heap_ = std::move(other.string_heap_);
+  dictionary_  = std::move(other.dictionary_);
+  codes_       = other.codes_;
+  owned_codes_ = std::move(other.owned_codes_);
+  other.data_  = nullptr;
+  other.count_ = 0;
+  other.codes_ = nullptr;
+  return *this;
+}
+
+void Vector::Initialize(TypeId type) {
+  type_ = type;
+  owned_data_.reset(new char[kStandardVectorSize * GetTypeIdSize(type)]);
+  data_  = owned_data_.get();
+  count_ = 0;
+  nullmask_.reset();
+  string_heap_.Destroy();
+  dictionary_.reset();
+  codes_ = nullptr;
+}
+
+void Vector::Reset() {
+  if (!owned_data_) {
+    Initialize(type_);
+    return;
+  }
+  data_  = owned_data_.get();
+  count_ = 0;
+  nullmask_.reset();
+  string_heap_.Destroy();
+  dictionary_.reset();
+  codes_ = nullptr;
+}
+
+void Vector::Destroy() {
+  owned_data_.reset();
+  string_heap_.Destroy();
+  dictionary_.reset();
+  owned_codes_.reset();
+  data_  = nullptr;
+  codes_ = nullptr;
+  count_ = 0;
+  nullmask_.reset();
+}
+
+void Vector::SetCount(size_t count) {
+  if (count > kStandardVectorSize) {
+    throw ObjectSizeException("Vector count exceeds kStandardVectorSize");
+  }
+  count_ = count;
+}
+
+uint32_t* Vector::SetDictionary(
+    std::shared_ptr<const StringDictionary> dictionary) {
+  if (type_ != TypeId::kVarChar) {
+    throw TypeMismatchException("in Vector::SetDictionary", TypeId::kVarChar,
+                                type_);
+  }
+  if (!owned_codes_) {
+    owned_codes_.reset(new uint32_t[kStandardVectorSize]);
+  }
+  dictionary_ = std::move(dictionary);
+  codes_      = owned_codes_.get();
+  return codes_;
+}
+
+Value Vector::GetValue(size_t index) const {
+  if (index >= count_) {
+    throw Exception(ExceptionType::kOutOfRange, "Vector index out of range");
+  }
+  if (nullmask_[index]) {
+    return Value(type_);
+  }
+  switch (type_) {
+    case TypeId::kBoolean:
+      return Value::Boolean(GetData<int8_t>()[index] != 0);
+    case TypeId::kTinyInt:
+      return Value::TinyInt(GetData<int8_t>()[index]);
+    case TypeId::kSmallInt:
+      return Value::SmallInt(GetData<int16_t>()[index]);
+    case TypeId::kInteger:
+      return Value::Integer(GetData<int32_t>()[index]);
+    case TypeId::kBigInt:
+      return Value::BigInt(GetData<int64_t>()[index]);
+    case TypeId::kDecimal:
+      return Value::Decimal(GetData<double>()[index]);
+    case TypeId::kDate:
+      return Value::Date(GetData<int32_t>()[index]);
+    case TypeId::kTimestamp:
+      return Value::Timestamp(GetData<int64_t>()[index]);
+    case TypeId::kVarChar:
+      return Value(GetData<const char*>()[index]);
+    default:
+      throw NotImplementationException("Unimplemented type %s for GetValue",
+                                       TypeIdToString(type_).c_str());
+  }
+}
+
+void Vector::SetValue(size_t index, const Value& value) {
+  if (index >= kStandardVectorSize) {
+    throw Exception(ExceptionType::kOutOfRange, "Vector index out of range");
+  }
+  if (value.GetType() != type_) {
+    SetValue(index, value.CastAs(type_));
+    return;
+  }
+  nullmask_[index] = value.IsNull();
+  if (value.IsNull()) {
+    return;
+  }
+  switch (type_) {
+    case TypeId::kBoolean:
+    case TypeId::kTinyInt:
+      GetData<int8_t>()[index] = value.GetValue<int8_t>();
+      break;
+    case TypeId::kSmallInt:
+      GetData<int16_t>()[index] = value.GetValue<int16_t>();
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      GetData<int32_t>()[index] = value.GetValue<int32_t>();
+      break;
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      GetData<int64_t>()[index] = value.GetValue<int64_t>();
+      break;
+    case TypeId::kDecimal:
+      GetData<double>()[index] = value.GetValue<double>();
+      break;
+    case TypeId::kVarChar: {
+      auto& str                     = value.GetString();
+      GetData<const char*>()[index] = AddString(str.data(), str.size());
+      codes_                        = nullptr;
+      break;
+    }
+    default:
+      throw NotImplementationException("Unimplemented type %s for SetValue",
+                                       TypeIdToString(type_).c_str());
+  }
+}
+
+void Vector::Append(const Vector& other) { Append(other, 0, other.count_); }
+
+void Vector::Append(const Vector& other, size_t start, size_t count) {
+  if (other.type_ != type_) {
+    throw TypeMismatchException("in Vector::Append", type_, other.type_);
+  }
+  if (start + count > other.count_ || count_ + count > kStandardVectorSize) {
+    throw ObjectSizeException("Vector::Append exceeds kStandardVectorSize");
+  }
+  CopyRange(other, start, count, count_);
+  count_ += count;
+}
+
+void Vector::AppendSelection(const Vector& other, const sel_t* selection,
+                             size_t count) {
+  if (other.type_ != type_) {
+    throw TypeMismatchException("in Vector::AppendSelection", type_,
+                                other.type_);
+  }
+  if (count_ + count > kStandardVectorSize) {
+    throw ObjectSizeException(
+        "Vector::AppendSelection exceeds kStandardVectorSize");
+  }
+  for (size_t i = 0; i < count; i++) {
+    nullmask_[count_ + i] = other.nullmask_[selection[i]];
+  }
+  if (type_ == TypeId::kVarChar) {
+    auto src  = other.GetData<const char*>();
+    auto dest = GetData<const char*>() + count_;
+    if (ShareDictionary(other, count_)) {
+      Gather(src, selection, count, dest);
+      if (codes_) {
+        Gather<uint32_t>(other.codes_, selection, count, codes_ + count_);
+      }
+    } else {
+      codes_ = nullptr;
+      for (size_t i = 0; i < count; i++) {
+        dest[i] = nullmask_[count_ + i]
+                      ? nullptr
+                      : AddString(src[selection[i]],
+                                  std::strlen(src[selection[i]]));
+      }
+    }
+  } else {
+    switch (GetTypeIdSize(type_)) {
+      case 1:
+        Gather(other.GetData<int8_t>(), selection, count,
+               GetData<int8_t>() + count_);
+        break;
+      case 2:
+        Gather(other.GetData<int16_t>(), selection, count,
+               GetData<int16_t>() + count_);
+        break;
+      case 4:
+        Gather(other.GetData<int32_t>(), selection, count,
+               GetData<int32_t>() + count_);
+        break;
+      case 8:
+        Gather(other.GetData<int64_t>(), selection, count,
+               GetData<int64_t>() + count_);
+        break;
+      default:
+        throw NotImplementationException(
+            "Unimplemented type %s for AppendSelection",
+            TypeIdToString(type_).c_str());
+    }
+  }
+  count_ += count;
+}
+
+void Vector::Copy(Vector& target, size_t offset) const {
+  if (target.type_ != type_) {
+    throw TypeMismatchException("in Vector::Copy", type_, target.type_);
+  }
+  if (offset + count_ > kStandardVectorSize) {
+    throw ObjectSizeException("Vector::Copy exceeds kStandardVectorSize");
+  }
+  target.CopyRange(*this, 0, count_, offset);
+  target.count_ = std::max(target.count_, offset + count_);
+}
+
+void Vector::CopyRange(const Vector& source, size_t start, size_t count,
+                       size_t offset) {
+  for (size_t i = 0; i < count; i++) {
+    nullmask_[offset + i] = source.nullmask_[start + i];
+  }
+  if (type_ == TypeId::kVarChar) {
+    auto src  = source.GetData<const char*>() + start;
+    auto dest = GetData<const char*>() + offset;
+    if (ShareDictionary(source, offset)) {
+      std::memcpy(dest, src, count * sizeof(const char*));
+      if (codes_) {
+        std::memcpy(codes_ + offset, source.codes_ + start,
+                    count * sizeof(uint32_t));
+      }
+      return;
+    }
+    codes_ = nullptr;
+    for (size_t i = 0; i < count; i++) {
+      dest[i] = source.nullmask_[start + i]
+                    ? nullptr
+                    : AddString(src[i], std::strlen(src[i]));
+    }
+  } else {
+    auto width = GetTypeIdSize(type_);
+    std::memcpy(data_ + offset * width, source.data_ + start * width,
+                count * width);
+  }
+}
+
+bool Vector::ShareDictionary(const Vector& source, size_t offset) {
+  auto dictionary = source.GetDictionary();
+  if (dictionary && !dictionary_ && count_ == 0 && offset == 0) {
+    SetDictionary(source.dictionary_);
+  }
+  // the strings are owned by the shared dictionary
+  return dictionary && dictionary == dictionary_.get();
+}
+
+void Vector::Reference(Vector& other) {
+  type_     = other.type_;
+  count_    = other.count_;
+  data_     = other.data_;
+  nullmask_ = other.nullmask_;
+  owned_data_.reset();
+  string_heap_.Destroy();
+  dictionary_ = other.dictionary_;
+  codes_      = other.codes_;
+  owned_codes_.reset();
+}
+
+void Vector::Reference(TypeId type, char* data, size_t count) {
+  if (count > kStandardVectorSize) {
+    throw ObjectSizeException("Vector count exceeds kStandardVectorSize");
+  }
+  type_  = type;
+  count_ = count;
+  data_  = data;
+  nullmask_.reset();
+  owned_data_.reset();
+  string_heap_.Destroy();
+  dictionary_.reset();
+  codes_ = nullptr;
+  owned_codes_.reset();
+}
+
+const char* Vector::AddString(const char* data, size_t len) {
+  return string_heap_.AddString(data, len);
+}
+
+size_t Vector::GetAllocationSize() const {
+  size_t size = string_heap_.GetAllocationSize();
+  if (owned_data_) {
+    size += kStandardVectorSize * GetTypeIdSize(type_);
+  }
+  if (owned_codes_) {
+    size += kStandardVectorSize * sizeof(uint32_t);
+  }
+  return size;
+}
+
+std::string Vector::ToString() const {
+  std::string result = TypeIdToString(type_) + ": " +
+                       std::to_string(count_) + " = [ ";
+  for (size_t i = 0; i < count_; i++) {
+    result += GetValue(i).ToString() + (i + 1 == count_ ? "" : ", ");
+  }
+  result += " ]";
+  return result;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,478 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/csv_reader.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <thread>
+
+#include "common/exception.hpp"
+#include "common/file_system.hpp"
+#include "common/parallel.hpp"
+#include "common/types/data_chunk.hpp"
+#include "common/types/date.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+// the size the file is split into for parsing, large enough to amortize the
+// setup of a block and small enough to balance the load between threads
+constexpr size_t kBlockSize = 8 * 1024 * 1024;
+
+#if !defined(__SSE2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+constexpr uint64_t kLowBits  = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+/**
+ * Returns a word with the high bit set in every byte of word equal to c.
+ */
+inline uint64_t MatchByte(uint64_t word, char c) {
+  auto x = word ^ (kLowBits * static_cast<uint8_t>(c));
+  auto t = ((x & ~kHighBits) + ~kHighBits) | x;
+  return ~t & kHighBits;
+}
+#endif
+
+/**
+ * Searches for the first occurrence of any of three bytes. The bytes may
+ * repeat if fewer are needed.
+ */
+class ByteSearcher {
+ public:
+  ByteSearcher(char a, char b, char c) : a_(a), b_(b), c_(c) {}
+
+  /**
+   * Returns the first position in [pos, end) holding one of the bytes, or
+   * end if there is none.
+   */
+  const char* Find(const char* pos, const char* end) const {
+#if defined(__SSE2__)
+    auto a = _mm_set1_epi8(a_);
+    auto b = _mm_set1_epi8(b_);
+    auto c = _mm_set1_epi8(c_);
+    for (; end - pos >= 16; pos += 16) {
+      auto data  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+      auto match = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(data, a), _mm_cmpeq_epi8(data, b)),
+          _mm_cmpeq_epi8(data, c));
+      auto mask = static_cast<unsigned>(_mm_movemask_epi8(match));
+      if (mask != 0) {
+        return pos + __builtin_ctz(mask);
+      }
+    }
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; end - pos >= 8; pos += 8) {
+      uint64_t word;
+      std::memcpy(&word, pos, sizeof(word));
+      auto match = MatchByte(word, a_) | MatchByte(word, b_) |
+                   MatchByte(word, c_);
+      if (match != 0) {
+        return pos + __builtin_ctzll(match) / 8;
+      }
+    }
+#endif
+    for (; pos < end; pos++) {
+      if (*pos == a_ || *pos == b_ || *pos == c_) {
+        return pos;
+      }
+    }
+    return end;
+  }
+
+ private:
+  char a_;
+  char b_;
+  char c_;
+};
+
+/**
+ * Count the occurrences of c in [pos, end).
+ */
+size_t CountByte(const char* pos, const char* end, char c) {
+  size_t count = 0;
+#if defined(__SSE2__)
+  auto needle = _mm_set1_epi8(c);
+  for (; end - pos >= 16; pos += 16) {
+    auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+    auto mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(data, needle)));
+    count += static_cast<size_t>(__builtin_popcount(mask));
+  }
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; end - pos >= 8; pos += 8) {
+    uint64_t word;
+    std::memcpy(&word, pos, sizeof(word));
+    count += static_cast<size_t>(__builtin_popcountll(MatchByte(word, c)));
+  }
+#endif
+  for (; pos < end; pos++) {
+    count += *pos == c;
+  }
+  return count;
+}
+
+/**
+ * Returns the position after the first line break in [pos, end) that is
+ * not inside a quoted field, or end. in_quote tells whether pos lies inside
+ * a quoted field.
+ */
+const char* NextLine(const char* pos, const char* end, char quote,
+                     bool in_quote) {
+  ByteSearcher searcher(quote, '\n', '\n');
+  while ((pos = searcher.Find(pos, end)) != end) {
+    if (*pos++ == quote) {
+      in_quote = !in_quote;
+    } else if (!in_quote) {
+      break;
+    }
+  }
+  return pos;
+}
+
+struct CSVBlock {
+  const char* begin;
+  const char* end;
+  std::vector<std::unique_ptr<DataChunk>> chunks;
+  std::exception_ptr error;
+};
+
+/**
+ * Parses the lines of a block into chunks.
+ */
+class CSVBlockParser {
+ public:
+  CSVBlockParser(const CopyInfo& info, const std::vector<TypeId>& types,
+                 const MappedFile& file)
+      : info_(info),
+        types_(types),
+        file_(file),
+        field_end_(info.delimiter, '\n', '\r'),
+        quoted_field_end_(info.quote, info.escape, info.quote) {}
+
+  void Parse(CSVBlock& block);
+
+ private:
+  /**
+   * Parse the field at pos into row of vector. Returns the position after
+   * the field, which is a delimiter, a line break or the end of the block.
+   */
+  const char* ParseField(const char* pos, const char* end, Vector& vector,
+                         size_t row, const char* line);
+  void StoreField(const char* data, size_t len, bool quoted, Vector& vector,
+                  size_t row, const char* line);
+
+  size_t LineNumber(const char* line) const {
+    return 1 + CountByte(file_.GetData(), line, '\n');
+  }
+
+  const CopyInfo& info_;
+  const std::vector<TypeId>& types_;
+  const MappedFile& file_;
+  ByteSearcher field_end_;
+  ByteSearcher quoted_field_end_;
+  /**
+   * Holds a quoted field after removing its escape characters.
+   */
+  std::string buffer_;
+};
+
+void CSVBlockParser::Parse(CSVBlock& block) {
+  auto pos          = block.begin;
+  auto end          = block.end;
+  DataChunk* chunk  = nullptr;
+  size_t row        = 0;
+  auto finish_chunk = [&]() {
+    for (size_t i = 0; i < types_.size(); i++) {
+      chunk->GetVector(i).SetCount(row);
+    }
+  };
+  while (pos < end) {
+    if (*pos == '\n' || *pos == '\r') {
+      // empty lines are skipped
+      pos++;
+      continue;
+    }
+    if (!chunk || row == kStandardVectorSize) {
+      if (chunk) {
+        finish_chunk();
+      }
+      block.chunks.push_back(std::make_unique<DataChunk>());
+      chunk = block.chunks.back().get();
+      chunk->Initialize(types_);
+      row = 0;
+    }
+    auto line = pos;
+    for (size_t i = 0; i < types_.size(); i++) {
+      pos       = ParseField(pos, end, chunk->GetVector(i), row, line);
+      bool last = i + 1 == types_.size();
+      if (pos < end && *pos == info_.delimiter) {
+        if (last) {
+          throw ConversionException(
+              "Expected %zu columns but found more at line %zu of \"%s\"",
+              types_.size(), LineNumber(line), info_.file_path.c_str());
+        }
+        pos++;
+      } else if (!last) {
+        throw ConversionException(
+            "Expected %zu columns but found %zu at line %zu of \"%s\"",
+            types_.size(), i + 1, LineNumber(line), info_.file_path.c_str());
+      }
+    }
+    if (pos < end && *pos == '\r') {
+      pos++;
+    }
+    if (pos < end && *pos == '\n') {
+      pos++;
+    }
+    row++;
+  }
+  if (chunk) {
+    finish_chunk();
+  }
+}
+
+const char* CSVBlockParser::ParseField(const char* pos, const char* end,
+                                       Vector& vector, size_t row,
+                                       const char* line) {
+  if (pos == end || *pos != info_.quote) {
+    auto start = pos;
+    pos        = field_end_.Find(pos, end);
+    StoreField(start, static_cast<size_t>(pos - start), false, vector, row,
+               line);
+    return pos;
+  }
+
+  auto start   = ++pos;
+  bool escaped = false;
+  while (true) {
+    pos = quoted_field_end_.Find(pos, end);
+    if (pos == end) {
+      throw ConversionException(
+          "Unterminated quoted field at line %zu of \"%s\"", LineNumber(line),
+          info_.file_path.c_str());
+    }
+    if (info_.escape == info_.quote) {
+      // a doubled quote is a quote inside the field
+      if (pos + 1 < end && pos[1] == info_.quote) {
+        escaped = true;
+        pos += 2;
+        continue;
+      }
+    } else if (*pos == info_.escape) {
+      if (pos + 1 == end) {
+        throw ConversionException(
+            "Unterminated quoted field at line %zu of \"%s\"",
+            LineNumber(line), info_.file_path.c_str());
+      }
+      escaped = true;
+      pos += 2;
+      continue;
+    }
+    break;
+  }
+  auto field_end = pos++;
+  if (pos < end && *pos != info_.delimiter && *pos != '\n' && *pos != '\r') {
+    throw ConversionException(
+        "Unexpected character after quoted field at line %zu of \"%s\"",
+        LineNumber(line), info_.file_path.c_str());
+  }
+
+  if (!escaped) {
+    StoreField(start, static_cast<size_t>(field_end - start), true, vector,
+               row, line);
+    return pos;
+  }
+  buffer_.clear();
+  for (auto c = start; c < field_end; c++) {
+    if (*c == info_.escape) {
+      c++;
+    }
+    buffer_ += *c;
+  }
+  StoreField(buffer_.data(), buffer_.size(), true, vector, row, line);
+  return pos;
+}
+
+template <class T>
+bool ParseInteger(const char* data, size_t len, T& result) {
+  auto end = data + len;
+  auto res = std::from_chars(data, end, result);
+  return res.ec == std::errc() && res.ptr == end;
+}
+
+bool ParseBoolean(const char* data, size_t len, int8_t& result) {
+  auto equals = [&](const char* str) {
+    return std::strlen(str) == len && strncasecmp(data, str, len) == 0;
+  };
+  if (equals("true") || equals("t") || equals("1")) {
+    result = 1;
+    return true;
+  }
+  if (equals("false") || equals("f") || equals("0")) {
+    result = 0;
+    return true;
+  }
+  return false;
+}
+
+bool ParseDecimal(const char* data, size_t len, double& result) {
+  auto end = data + len;
+  auto res = std::from_chars(data, end, result);
+  return res.ec == std::errc() && res.ptr == end;
+}
+
+void CSVBlockParser::StoreField(const char* data, size_t len, bool quoted,
+                                Vector& vector, size_t row,
+                                const char* line) {
+  auto type = vector.GetType();
+  if (len == 0 && !(quoted && type == TypeId::kVarChar)) {
+    // an empty field is NULL, except for an empty quoted string
+    vector.SetNull(row, true);
+    if (type == TypeId::kVarChar) {
+      vector.GetData<const char*>()[row] = nullptr;
+    }
+    return;
+  }
+  vector.SetNull(row, false);
+  bool success = true;
+  switch (type) {
+    case TypeId::kBoolean:
+      success = ParseBoolean(data, len, vector.GetData<int8_t>()[row]);
+      break;
+    case TypeId::kTinyInt:
+      success = ParseInteger(data, len, vector.GetData<int8_t>()[row]);
+      break;
+    case TypeId::kSmallInt:
+      success = ParseInteger(data, len, vector.GetData<int16_t>()[row]);
+      break;
+    case TypeId::kInteger:
+      success = ParseInteger(data, len, vector.GetData<int32_t>()[row]);
+      break;
+    case TypeId::kBigInt:
+      success = ParseInteger(data, len, vector.GetData<int64_t>()[row]);
+      break;
+    case TypeId::kDecimal:
+      success = ParseDecimal(data, len, vector.GetData<double>()[row]);
+      break;
+    case TypeId::kDate:
+      try {
+        vector.GetData<int32_t>()[row] =
+            Date::FromString(std::string(data, len));
+      } catch (ConversionException&) {
+        success = false;
+      }
+      break;
+    case TypeId::kTimestamp:
+      try {
+        vector.GetData<int64_t>()[row] =
+            Timestamp::FromString(std::string(data, len));
+      } catch (ConversionException&) {
+        success = false;
+      }
+      break;
+    case TypeId::kVarChar:
+      vector.GetData<const char*>()[row] = vector.AddString(data, len);
+      break;
+    default:
+      throw NotImplementationException("Unimplemented type %s for CSV files",
+                                       TypeIdToString(type).c_str());
+  }
+  if (!success) {
+    throw ConversionException(
+        "Could not convert string '%s' to %s at line %zu of \"%s\"",
+        std::string(data, len).c_str(), TypeIdToString(type).c_str(),
+        LineNumber(line), info_.file_path.c_str());
+  }
+}
+
+}  // namespace
+
+ParallelCSVReader::ParallelCSVReader(CopyInfo copy_info,
+                                     std::vector<TypeId> types)
+    : info_(std::move(copy_info)), types_(std::move(types)) {}
+
+size_t ParallelCSVReader::ReadInto(DataTable& table, size_t thread_count) {
+  if (types_.empty()) {
+    throw ConversionException("Cannot read a CSV file without columns");
+  }
+  if (thread_count == 0) {
+    thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  MappedFile file(info_.file_path);
+  auto begin = file.GetData();
+  auto end   = begin + file.GetSize();
+  if (info_.header) {
+    begin = NextLine(begin, end, info_.quote, false);
+  }
+  auto size = static_cast<size_t>(end - begin);
+
+  // split the file into blocks of roughly kBlockSize bytes
+  size_t block_count =
+      std::max<size_t>((size + kBlockSize - 1) / kBlockSize, 1);
+  if (info_.escape != info_.quote) {
+    block_count = 1;
+  }
+  std::vector<CSVBlock> blocks(block_count);
+  for (size_t i = 0; i < block_count; i++) {
+    blocks[i].begin = begin + size * i / block_count;
+    blocks[i].end   = begin + size * (i + 1) / block_count;
+  }
+
+  // move every boundary after the next line break outside of quotes, a
+  // boundary lies inside quotes if an odd number of quotes precedes it
+  std::vector<size_t> quotes(block_count);
+  ParallelFor(block_count, thread_count, [&](size_t i) {
+    quotes[i] = CountByte(blocks[i].begin, blocks[i].end, info_.quote);
+  });
+  bool in_quote = false;
+  for (size_t i = 1; i < block_count; i++) {
+    in_quote = in_quote != (quotes[i - 1] % 2 == 1);
+    auto boundary     = NextLine(blocks[i].begin, end, info_.quote, in_quote);
+    boundary          = std::max(boundary, blocks[i - 1].begin);
+    blocks[i - 1].end = boundary;
+    blocks[i].begin   = boundary;
+  }
+
+  // parse a round of blocks in parallel and append them in file order, so
+  // only a bounded part of the file is held in memory at the same time
+  size_t row_count  = 0;
+  size_t round_size = 2 * thread_count;
+  for (size_t start = 0; start < block_count; start += round_size) {
+    auto count = std::min(round_size, block_count - start);
+    ParallelFor(count, thread_count, [&](size_t i) {
+      auto& block = blocks[start + i];
+      try {
+        CSVBlockParser(info_, types_, file).Parse(block);
+      } catch (...) {
+        block.error = std::current_exception();
+      }
+    });
+    for (size_t i = start; i < start + count; i++) {
+      if (blocks[i].error) {
+        std::rethrow_exception(blocks[i].error);
+      }
+      for (auto& chunk : blocks[i].chunks) {
+        table.Append(*chunk);
+        row_count += chunk->GetCount();
+      }
+      blocks[i].chunks.clear();
+    }
+  }
+  return row_count;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,35 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/executor.hpp"
+
+namespace zoomdb {
+
+void Executor::Execute(PhysicalOperator& plan, ChunkCollection& result,
+                       QueryProfiler* profiler) {
+  if (profiler) {
+    profiler->StartQuery(plan);
+  }
+  {
+    // the state flushes the metrics when it is destroyed
+    auto state = plan.GetOperatorState(profiler);
+    DataChunk chunk;
+    chunk.Initialize(plan.types);
+    while (true) {
+      plan.GetChunk(chunk, state.get());
+      if (chunk.GetCount() == 0) {
+        break;
+      }
+      result.Append(chunk);
+    }
+  }
+  if (profiler) {
+    profiler->EndQuery();
+  }
+}
+
+}  // namespace zoomdb
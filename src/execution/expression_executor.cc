@@ -0,0 +1,490 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/expression_executor.hpp"
+
+#include <cmath>
+
+#include "common/exception.hpp"
+#include "common/types/chunk_collection.hpp"
+#include "execution/executor.hpp"
+#include "execution/physical_operator.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * SQL LIKE: % matches any sequence of characters, _ any single character.
+ */
+bool LikeMatch(const char* str, const char* pattern) {
+  for (; *pattern; pattern++) {
+    if (*pattern == '%') {
+      while (*(pattern + 1) == '%') {
+        pattern++;
+      }
+      if (!*(pattern + 1)) {
+        return true;
+      }
+      for (; *str; str++) {
+        if (LikeMatch(str, pattern + 1)) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (!*str || (*pattern != '_' && *pattern != *str)) {
+      return false;
+    }
+    str++;
+  }
+  return !*str;
+}
+
+Value Arithmetic(ExpressionType op, const Value& left, const Value& right,
+                 TypeId result_type) {
+  if (left.IsNull() || right.IsNull()) {
+    return Value(result_type);
+  }
+  if (op == ExpressionType::kOperatorConcat) {
+    return Value::VarChar(left.CastAs(TypeId::kVarChar).GetString() +
+                          right.CastAs(TypeId::kVarChar).GetString());
+  }
+  if (result_type == TypeId::kDecimal) {
+    auto l = left.CastAs(TypeId::kDecimal).GetValue<double>();
+    auto r = right.CastAs(TypeId::kDecimal).GetValue<double>();
+    switch (op) {
+      case ExpressionType::kOperatorPlus:
+        return Value::Decimal(l + r);
+      case ExpressionType::kOperatorMinus:
+        return Value::Decimal(l - r);
+      case ExpressionType::kOperatorMultiply:
+        return Value::Decimal(l * r);
+      case ExpressionType::kOperatorDivide:
+        if (r == 0) {
+          throw DivideByZeroException("Division by zero");
+        }
+        return Value::Decimal(l / r);
+      case ExpressionType::kOperatorMod:
+        if (r == 0) {
+          throw DivideByZeroException("Division by zero");
+        }
+        return Value::Decimal(std::fmod(l, r));
+      default:
+        break;
+    }
+  } else {
+    auto l = left.CastAs(TypeId::kBigInt).GetNumericValue();
+    auto r = right.CastAs(TypeId::kBigInt).GetNumericValue();
+    int64_t result;
+    bool overflow = false;
+    switch (op) {
+      case ExpressionType::kOperatorPlus:
+        overflow = __builtin_add_overflow(l, r, &result);
+        break;
+      case ExpressionType::kOperatorMinus:
+        overflow = __builtin_sub_overflow(l, r, &result);
+        break;
+      case ExpressionType::kOperatorMultiply:
+        overflow = __builtin_mul_overflow(l, r, &result);
+        break;
+      case ExpressionType::kOperatorDivide:
+      case ExpressionType::kOperatorMod:
+        if (r == 0) {
+          throw DivideByZeroException("Division by zero");
+        }
+        overflow = l == INT64_MIN && r == -1;
+        result   = overflow ? 0
+                   : op == ExpressionType::kOperatorDivide ? l / r
+                                                           : l % r;
+        break;
+      default:
+        throw NotImplementationException(
+            "Unsupported operator %s", ExpressionTypeToString(op).c_str());
+    }
+    if (overflow) {
+      throw NumericValueOutOfRangeException(
+          "Overflow in " + ExpressionTypeToString(op),
+          NumericValueOutOfRangeException::kOverflow);
+    }
+    return Value::BigInt(result).CastAs(result_type);
+  }
+  throw NotImplementationException("Unsupported operator %s",
+                                   ExpressionTypeToString(op).c_str());
+}
+
+/**
+ * Returns the result of the comparison as a BOOLEAN value, NULL if one of
+ * the operands is NULL.
+ */
+Value Compare(ExpressionType op, const Value& left, const Value& right) {
+  if (op == ExpressionType::kCompareDistinctFrom) {
+    if (left.IsNull() || right.IsNull()) {
+      return Value::Boolean(left.IsNull() != right.IsNull());
+    }
+    return Value::Boolean(Value::Compare(left, right) != 0);
+  }
+  if (left.IsNull() || right.IsNull()) {
+    return Value(TypeId::kBoolean);
+  }
+  switch (op) {
+    case ExpressionType::kCompareEqual:
+      return Value::Boolean(left == right);
+    case ExpressionType::kCompareNotEqual:
+      return Value::Boolean(left != right);
+    case ExpressionType::kCompareLessThan:
+      return Value::Boolean(left < right);
+    case ExpressionType::kCompareGreaterThan:
+      return Value::Boolean(left > right);
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      return Value::Boolean(left <= right);
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      return Value::Boolean(left >= right);
+    case ExpressionType::kCompareLike:
+    case ExpressionType::kCompareNotLike: {
+      bool match = LikeMatch(left.CastAs(TypeId::kVarChar).GetString().c_str(),
+                             right.CastAs(TypeId::kVarChar).GetString().c_str());
+      return Value::Boolean(op == ExpressionType::kCompareLike ? match : !match);
+    }
+    default:
+      throw NotImplementationException("Unsupported comparison %s",
+                                       ExpressionTypeToString(op).c_str());
+  }
+}
+
+/**
+ * Three-valued AND and OR.
+ */
+Value Conjunction(ExpressionType op, const Value& left, const Value& right) {
+  bool is_and = op == ExpressionType::kConjunctionAnd;
+  // false AND x is false, true OR x is true, even if x is NULL
+  if ((!left.IsNull() && left.GetValue<bool>() != is_and) ||
+      (!right.IsNull() && right.GetValue<bool>() != is_and)) {
+    return Value::Boolean(!is_and);
+  }
+  if (left.IsNull() || right.IsNull()) {
+    return Value(TypeId::kBoolean);
+  }
+  return Value::Boolean(is_and);
+}
+
+/**
+ * Returns the value of the subquery for the given row, from the result of
+ * its plan and the values of its operands.
+ */
+Value SubqueryValue(const SubqueryExpression& subquery,
+                    ChunkCollection& collection, std::vector<Vector>& children,
+                    size_t row) {
+  Value value;
+  switch (subquery.subquery_type) {
+    case SubqueryType::kExists:
+      value = Value::Boolean(collection.GetCount() > 0);
+      break;
+    case SubqueryType::kScalar:
+      if (collection.GetCount() > 1) {
+        throw ExecutorException(
+            "More than one row returned by a subquery used as an "
+            "expression");
+      }
+      value = collection.GetCount() == 0 ? Value(subquery.return_type)
+                                         : collection.GetValue(0, 0);
+      break;
+    case SubqueryType::kAny: {
+      value = Value::Boolean(false);
+      for (size_t i = 0; i < collection.GetCount(); i++) {
+        // a row matches if all its columns compare true
+        auto match = Value::Boolean(true);
+        for (size_t col = 0; col < children.size(); col++) {
+          match = Conjunction(ExpressionType::kConjunctionAnd, match,
+                              Compare(subquery.comparison,
+                                      children[col].GetValue(row),
+                                      collection.GetValue(col, i)));
+        }
+        if (match.IsNull()) {
+          value = match;
+        } else if (match.GetValue<bool>()) {
+          value = match;
+          break;
+        }
+      }
+      break;
+    }
+  }
+  return value;
+}
+
+}  // namespace
+
+ExpressionExecutor::ExpressionExecutor(DataChunk* chunk) : chunk_(chunk) {}
+
+size_t ExpressionExecutor::Count() const {
+  return chunk_ ? chunk_->GetCount() : 1;
+}
+
+void ExpressionExecutor::Execute(
+    std::vector<std::unique_ptr<Expression>>& expressions, DataChunk& result) {
+  for (size_t i = 0; i < expressions.size(); i++) {
+    ExecuteExpression(*expressions[i], result.GetVector(i));
+  }
+}
+
+void ExpressionExecutor::ExecuteExpression(Expression& expr, Vector& result) {
+  Vector intermediate;
+  Execute(expr, intermediate);
+  if (intermediate.GetType() == result.GetType()) {
+    result.Reset();
+    result.Append(intermediate);
+    return;
+  }
+  result.Reset();
+  for (size_t i = 0; i < intermediate.GetCount(); i++) {
+    result.SetValue(i, intermediate.GetValue(i));
+  }
+  result.SetCount(intermediate.GetCount());
+}
+
+size_t ExpressionExecutor::Select(
+    std::vector<std::unique_ptr<Expression>>& expressions, Vector& result) {
+  auto count = Count();
+  result.Initialize(TypeId::kBoolean);
+  auto data = result.GetData<int8_t>();
+  for (size_t i = 0; i < count; i++) {
+    data[i] = 1;
+  }
+  result.SetCount(count);
+  for (auto& expr : expressions) {
+    Select(*expr, result);
+  }
+  size_t selected = 0;
+  for (size_t i = 0; i < count; i++) {
+    selected += data[i] ? 1 : 0;
+  }
+  return selected;
+}
+
+void ExpressionExecutor::Select(Expression& expr, Vector& result) {
+  auto count = Count();
+  auto data  = result.GetData<int8_t>();
+  Vector vector;
+  Execute(expr, vector);
+  if (vector.GetType() == TypeId::kBoolean) {
+    auto values = vector.GetData<int8_t>();
+    for (size_t i = 0; i < count; i++) {
+      data[i] = data[i] && !vector.IsNull(i) && values[i];
+    }
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (data[i]) {
+      auto value = vector.GetValue(i);
+      data[i] = !value.IsNull() && value.CastAs(TypeId::kBoolean)
+                                       .GetValue<bool>();
+    }
+  }
+}
+
+void ExpressionExecutor::Execute(Expression& expr, Vector& result) {
+  auto count = Count();
+  if (expr.type == ExpressionType::kColumnRef) {
+    auto& ref = static_cast<ColumnRefExpression&>(expr);
+    if (ref.outer_values) {
+      // a column of the enclosing query, constant while the subquery runs
+      result.Initialize(ref.return_type);
+      for (size_t row = 0; row < count; row++) {
+        result.SetValue(row, (*ref.outer_values)[ref.index]);
+      }
+      result.SetCount(count);
+      return;
+    }
+    if (!chunk_ || ref.index >= chunk_->ColumnCount()) {
+      throw ExecutorException("Unresolved column reference %s",
+                              ref.ToString().c_str());
+    }
+    auto& vector = chunk_->GetVector(ref.index);
+    if (chunk_->GetSelection()) {
+      // only the selected rows of the column are materialized
+      result.Initialize(vector.GetType());
+      result.AppendSelection(vector, chunk_->GetSelection(), count);
+      return;
+    }
+    result.Reference(vector);
+    return;
+  }
+  if (dynamic_cast<SubqueryExpression*>(&expr)) {
+    ExecuteSubquery(expr, result);
+    return;
+  }
+  if (expr.kernel) {
+    Vector left;
+    Vector right;
+    ExecuteOperand(*expr.children[0], left);
+    ExecuteOperand(*expr.children[1], right);
+    // the kernel reads the data as the types it was selected for
+    if (left.GetType() == expr.children[0]->return_type &&
+        right.GetType() == expr.children[1]->return_type) {
+      result.Initialize(expr.return_type);
+      expr.kernel(left, right, result, count);
+      return;
+    }
+  }
+
+  // evaluate the children, then combine them row by row
+  std::vector<Vector> children(expr.children.size());
+  for (size_t i = 0; i < expr.children.size(); i++) {
+    Execute(*expr.children[i], children[i]);
+  }
+  result.Initialize(expr.return_type);
+  for (size_t row = 0; row < count; row++) {
+    Value value;
+    switch (expr.type) {
+      case ExpressionType::kValueConstant:
+        value = static_cast<ConstantExpression&>(expr).value;
+        break;
+      case ExpressionType::kOperatorPlus:
+      case ExpressionType::kOperatorMinus:
+      case ExpressionType::kOperatorMultiply:
+      case ExpressionType::kOperatorDivide:
+      case ExpressionType::kOperatorMod:
+      case ExpressionType::kOperatorConcat:
+        value = Arithmetic(expr.type, children[0].GetValue(row),
+                           children[1].GetValue(row), expr.return_type);
+        break;
+      case ExpressionType::kOperatorUnaryMinus:
+        value = Arithmetic(ExpressionType::kOperatorMinus,
+                           Value::Numeric(expr.return_type, 0),
+                           children[0].GetValue(row), expr.return_type);
+        break;
+      case ExpressionType::kCompareEqual:
+      case ExpressionType::kCompareNotEqual:
+      case ExpressionType::kCompareLessThan:
+      case ExpressionType::kCompareGreaterThan:
+      case ExpressionType::kCompareLessThanOrEqualTo:
+      case ExpressionType::kCompareGreaterThanOrEqualTo:
+      case ExpressionType::kCompareLike:
+      case ExpressionType::kCompareNotLike:
+      case ExpressionType::kCompareDistinctFrom:
+        value = Compare(expr.type, children[0].GetValue(row),
+                        children[1].GetValue(row));
+        break;
+      case ExpressionType::kConjunctionAnd:
+      case ExpressionType::kConjunctionOr:
+        value = Conjunction(expr.type, children[0].GetValue(row),
+                            children[1].GetValue(row));
+        break;
+      case ExpressionType::kOperatorNot: {
+        auto child = children[0].GetValue(row);
+        value      = child.IsNull() ? Value(TypeId::kBoolean)
+                                    : Value::Boolean(!child.GetValue<bool>());
+        break;
+      }
+      case ExpressionType::kOperatorIsNull:
+        value = Value::Boolean(children[0].IsNull(row));
+        break;
+      case ExpressionType::kOperatorIsNotNull:
+        value = Value::Boolean(!children[0].IsNull(row));
+        break;
+      case ExpressionType::kOperatorCast:
+        value = children[0].GetValue(row).CastAs(expr.return_type);
+        break;
+      case ExpressionType::kOperatorCoalesce:
+        value = Value(expr.return_type);
+        for (auto& child : children) {
+          if (!child.IsNull(row)) {
+            value = child.GetValue(row);
+            break;
+          }
+        }
+        break;
+      case ExpressionType::kOperatorCaseExpr: {
+        // CASE WHEN children[0] THEN children[1] ELSE children[2] END
+        auto check = children[0].GetValue(row);
+        bool taken = !check.IsNull() && check.GetValue<bool>();
+        value      = children[taken ? 1 : 2].GetValue(row);
+        break;
+      }
+      case ExpressionType::kCompareIn: {
+        // x IN (a, b, ...): true if x equals one of the values, NULL if it
+        // does not but x or one of the values is NULL
+        auto left = children[0].GetValue(row);
+        value     = Value::Boolean(false);
+        for (size_t i = 1; i < children.size(); i++) {
+          auto cmp = Compare(ExpressionType::kCompareEqual, left,
+                             children[i].GetValue(row));
+          if (cmp.IsNull()) {
+            value = cmp;
+          } else if (cmp.GetValue<bool>()) {
+            value = cmp;
+            break;
+          }
+        }
+        break;
+      }
+      default:
+        throw NotImplementationException(
+            "Unsupported expression %s in execution",
+            ExpressionTypeToString(expr.type).c_str());
+    }
+    result.SetValue(row, value);
+  }
+  result.SetCount(count);
+}
+
+void ExpressionExecutor::ExecuteOperand(Expression& expr, Vector& result) {
+  if (expr.type != ExpressionType::kValueConstant) {
+    Execute(expr, result);
+    return;
+  }
+  // a kernel uses the single entry of a constant for every row
+  result.Initialize(expr.return_type);
+  result.SetValue(0, static_cast<ConstantExpression&>(expr).value);
+  result.SetCount(1);
+}
+
+void ExpressionExecutor::ExecuteSubquery(Expression& expr, Vector& result) {
+  auto& subquery = static_cast<SubqueryExpression&>(expr);
+  if (!subquery.plan) {
+    throw ExecutorException("Subquery without a physical plan");
+  }
+  std::vector<Vector> children(subquery.children.size());
+  for (size_t i = 0; i < subquery.children.size(); i++) {
+    Execute(*subquery.children[i], children[i]);
+  }
+  auto count = Count();
+  result.Initialize(expr.return_type);
+
+  if (subquery.correlated.empty()) {
+    // the subquery is uncorrelated, its result is the same for every row
+    ChunkCollection collection;
+    Executor::Execute(*subquery.plan, collection);
+    for (size_t row = 0; row < count; row++) {
+      result.SetValue(row, SubqueryValue(subquery, collection, children, row));
+    }
+    result.SetCount(count);
+    return;
+  }
+
+  // the subquery is run for every row, with the values of the row
+  std::vector<Vector> correlated(subquery.correlated.size());
+  for (size_t i = 0; i < subquery.correlated.size(); i++) {
+    Execute(*subquery.correlated[i], correlated[i]);
+  }
+  subquery.correlated_values.resize(correlated.size());
+  for (size_t row = 0; row < count; row++) {
+    for (size_t i = 0; i < correlated.size(); i++) {
+      subquery.correlated_values[i] = correlated[i].GetValue(row);
+    }
+    ChunkCollection collection;
+    Executor::Execute(*subquery.plan, collection);
+    result.SetValue(row, SubqueryValue(subquery, collection, children, row));
+  }
+  result.SetCount(count);
+}
+
+}  // namespace zoomdb
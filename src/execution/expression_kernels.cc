@@ -0,0 +1,374 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/expression_kernels.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+
+#include "common/exception.hpp"
+#include "common/types/vector.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+[[noreturn]] void ThrowOverflow(ExpressionType op) {
+  throw NumericValueOutOfRangeException(
+      "Overflow in " + ExpressionTypeToString(op),
+      NumericValueOutOfRangeException::kOverflow);
+}
+
+/**
+ * The operators. Integer arithmetic fails on overflow and division by zero
+ * like the interpreted one does.
+ */
+
+struct Add {
+  template <class T>
+  static T Apply(T left, T right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return left + right;
+    } else {
+      T result;
+      if (__builtin_add_overflow(left, right, &result)) {
+        ThrowOverflow(ExpressionType::kOperatorPlus);
+      }
+      return result;
+    }
+  }
+};
+
+struct Subtract {
+  template <class T>
+  static T Apply(T left, T right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return left - right;
+    } else {
+      T result;
+      if (__builtin_sub_overflow(left, right, &result)) {
+        ThrowOverflow(ExpressionType::kOperatorMinus);
+      }
+      return result;
+    }
+  }
+};
+
+struct Multiply {
+  template <class T>
+  static T Apply(T left, T right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return left * right;
+    } else {
+      T result;
+      if (__builtin_mul_overflow(left, right, &result)) {
+        ThrowOverflow(ExpressionType::kOperatorMultiply);
+      }
+      return result;
+    }
+  }
+};
+
+struct Divide {
+  template <class T>
+  static T Apply(T left, T right) {
+    if (right == 0) {
+      throw DivideByZeroException("Division by zero");
+    }
+    if constexpr (std::is_integral_v<T>) {
+      if (left == std::numeric_limits<T>::min() && right == -1) {
+        ThrowOverflow(ExpressionType::kOperatorDivide);
+      }
+    }
+    return static_cast<T>(left / right);
+  }
+};
+
+struct Modulo {
+  template <class T>
+  static T Apply(T left, T right) {
+    if (right == 0) {
+      throw DivideByZeroException("Division by zero");
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+      return std::fmod(left, right);
+    } else {
+      // min % -1 is 0, but traps on x86
+      return right == -1 ? 0 : static_cast<T>(left % right);
+    }
+  }
+};
+
+struct Equal {
+  template <class T>
+  static bool Apply(T left, T right) {
+    return left == right;
+  }
+  static bool Apply(const char* left, const char* right) {
+    return strcmp(left, right) == 0;
+  }
+};
+
+struct NotEqual {
+  template <class T>
+  static bool Apply(T left, T right) {
+    return left != right;
+  }
+  static bool Apply(const char* left, const char* right) {
+    return strcmp(left, right) != 0;
+  }
+};
+
+struct LessThan {
+  template <class T>
+  static bool Apply(T left, T right) {
+    return left < right;
+  }
+  static bool Apply(const char* left, const char* right) {
+    return strcmp(left, right) < 0;
+  }
+};
+
+struct GreaterThan {
+  template <class T>
+  static bool Apply(T left, T right) {
+    return left > right;
+  }
+  static bool Apply(const char* left, const char* right) {
+    return strcmp(left, right) > 0;
+  }
+};
+
+struct LessThanOrEqual {
+  template <class T>
+  static bool Apply(T left, T right) {
+    return left <= right;
+  }
+  static bool Apply(const char* left, const char* right) {
+    return strcmp(left, right) <= 0;
+  }
+};
+
+struct GreaterThanOrEqual {
+  template <class T>
+  static bool Apply(T left, T right) {
+    return left >= right;
+  }
+  static bool Apply(const char* left, const char* right) {
+    return strcmp(left, right) >= 0;
+  }
+};
+
+/**
+ * The result of a row is NULL if one of its operands is NULL, a constant
+ * operand counts for all rows.
+ */
+void MergeNulls(const Vector& operand, bool constant, nullmask_t& nullmask) {
+  if (!constant) {
+    nullmask |= operand.GetNullMask();
+  } else if (operand.IsNull(0)) {
+    nullmask.set();
+  }
+}
+
+template <class T, class RES, class OP, bool LEFT_CONSTANT,
+          bool RIGHT_CONSTANT, bool HAS_NULLS>
+void BinaryLoop(const T* left, const T* right, RES* result,
+                const nullmask_t& nullmask, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    // NULL rows are skipped, their data is undefined and may e.g. be zero
+    if (HAS_NULLS && nullmask[i]) {
+      continue;
+    }
+    result[i] = OP::Apply(left[LEFT_CONSTANT ? 0 : i],
+                          right[RIGHT_CONSTANT ? 0 : i]);
+  }
+}
+
+template <class T, class RES, class OP, bool LEFT_CONSTANT,
+          bool RIGHT_CONSTANT>
+void BinaryLoop(const T* left, const T* right, RES* result,
+                const nullmask_t& nullmask, size_t count) {
+  if (nullmask.any()) {
+    BinaryLoop<T, RES, OP, LEFT_CONSTANT, RIGHT_CONSTANT, true>(
+        left, right, result, nullmask, count);
+  } else {
+    BinaryLoop<T, RES, OP, LEFT_CONSTANT, RIGHT_CONSTANT, false>(
+        left, right, result, nullmask, count);
+  }
+}
+
+/**
+ * Evaluates OP over operands of C++ type T into results of type RES.
+ */
+template <class T, class RES, class OP>
+void BinaryKernel(const Vector& left, const Vector& right, Vector& result,
+                  size_t count) {
+  bool left_constant  = left.GetCount() == 1;
+  bool right_constant = right.GetCount() == 1;
+  auto& nullmask      = result.GetNullMask();
+  nullmask.reset();
+  MergeNulls(left, left_constant, nullmask);
+  MergeNulls(right, right_constant, nullmask);
+
+  auto l    = left.GetData<T>();
+  auto r    = right.GetData<T>();
+  auto data = result.GetData<RES>();
+  if (left_constant && right_constant) {
+    BinaryLoop<T, RES, OP, true, true>(l, r, data, nullmask, count);
+  } else if (left_constant) {
+    BinaryLoop<T, RES, OP, true, false>(l, r, data, nullmask, count);
+  } else if (right_constant) {
+    BinaryLoop<T, RES, OP, false, true>(l, r, data, nullmask, count);
+  } else {
+    BinaryLoop<T, RES, OP, false, false>(l, r, data, nullmask, count);
+  }
+  result.SetCount(count);
+}
+
+template <bool IS_AND, bool LEFT_CONSTANT, bool RIGHT_CONSTANT>
+void ConjunctionLoop(const Vector& left, const Vector& right, Vector& result,
+                     size_t count) {
+  auto l         = left.GetData<int8_t>();
+  auto r         = right.GetData<int8_t>();
+  auto data      = result.GetData<int8_t>();
+  auto& nullmask = result.GetNullMask();
+  for (size_t i = 0; i < count; i++) {
+    auto li         = LEFT_CONSTANT ? 0 : i;
+    auto ri         = RIGHT_CONSTANT ? 0 : i;
+    bool left_null  = left.IsNull(li);
+    bool right_null = right.IsNull(ri);
+    // false AND x is false, true OR x is true, even if x is NULL
+    if ((!left_null && (l[li] != 0) != IS_AND) ||
+        (!right_null && (r[ri] != 0) != IS_AND)) {
+      data[i]     = !IS_AND;
+      nullmask[i] = false;
+    } else {
+      data[i]     = IS_AND;
+      nullmask[i] = left_null || right_null;
+    }
+  }
+}
+
+/**
+ * Three-valued AND and OR of BOOLEAN operands.
+ */
+template <bool IS_AND>
+void ConjunctionKernel(const Vector& left, const Vector& right,
+                       Vector& result, size_t count) {
+  bool left_constant  = left.GetCount() == 1;
+  bool right_constant = right.GetCount() == 1;
+  if (left_constant && right_constant) {
+    ConjunctionLoop<IS_AND, true, true>(left, right, result, count);
+  } else if (left_constant) {
+    ConjunctionLoop<IS_AND, true, false>(left, right, result, count);
+  } else if (right_constant) {
+    ConjunctionLoop<IS_AND, false, true>(left, right, result, count);
+  } else {
+    ConjunctionLoop<IS_AND, false, false>(left, right, result, count);
+  }
+  result.SetCount(count);
+}
+
+class Registry {
+ public:
+  Registry() {
+    RegisterArithmetic<int8_t>(TypeId::kTinyInt);
+    RegisterArithmetic<int16_t>(TypeId::kSmallInt);
+    RegisterArithmetic<int32_t>(TypeId::kInteger);
+    RegisterArithmetic<int64_t>(TypeId::kBigInt);
+    RegisterArithmetic<double>(TypeId::kDecimal);
+
+    RegisterComparisons<int8_t>(TypeId::kBoolean);
+    RegisterComparisons<int8_t>(TypeId::kTinyInt);
+    RegisterComparisons<int16_t>(TypeId::kSmallInt);
+    RegisterComparisons<int32_t>(TypeId::kInteger);
+    RegisterComparisons<int64_t>(TypeId::kBigInt);
+    RegisterComparisons<double>(TypeId::kDecimal);
+    RegisterComparisons<int32_t>(TypeId::kDate);
+    RegisterComparisons<int64_t>(TypeId::kTimestamp);
+    RegisterComparisons<const char*>(TypeId::kVarChar);
+
+    Register(ExpressionType::kConjunctionAnd, TypeId::kBoolean,
+             &ConjunctionKernel<true>);
+    Register(ExpressionType::kConjunctionOr, TypeId::kBoolean,
+             &ConjunctionKernel<false>);
+  }
+
+  ExpressionKernel Get(ExpressionType op, TypeId left, TypeId right,
+                       TypeId result) const {
+    auto entry = kernels_.find(Key(op, left, right, result));
+    return entry == kernels_.end() ? nullptr : entry->second;
+  }
+
+ private:
+  static uint64_t Key(ExpressionType op, TypeId left, TypeId right,
+                      TypeId result) {
+    return static_cast<uint64_t>(op) << 24 | static_cast<uint64_t>(left) << 16 |
+           static_cast<uint64_t>(right) << 8 | static_cast<uint64_t>(result);
+  }
+
+  /**
+   * Register a kernel for two operands of the given type. The binder
+   * converts the operands of arithmetic and comparisons to a common type,
+   * so no other combination occurs.
+   */
+  void Register(ExpressionType op, TypeId operands, ExpressionKernel kernel,
+                TypeId result = TypeId::kInvalid) {
+    if (result == TypeId::kInvalid) {
+      result = operands;
+    }
+    kernels_[Key(op, operands, operands, result)] = kernel;
+  }
+
+  template <class T>
+  void RegisterArithmetic(TypeId type) {
+    Register(ExpressionType::kOperatorPlus, type, &BinaryKernel<T, T, Add>);
+    Register(ExpressionType::kOperatorMinus, type,
+             &BinaryKernel<T, T, Subtract>);
+    Register(ExpressionType::kOperatorMultiply, type,
+             &BinaryKernel<T, T, Multiply>);
+    Register(ExpressionType::kOperatorDivide, type,
+             &BinaryKernel<T, T, Divide>);
+    Register(ExpressionType::kOperatorMod, type, &BinaryKernel<T, T, Modulo>);
+  }
+
+  /**
+   * A BOOLEAN is stored as an int8_t.
+   */
+  template <class T>
+  void RegisterComparisons(TypeId type) {
+    auto boolean = TypeId::kBoolean;
+    Register(ExpressionType::kCompareEqual, type,
+             &BinaryKernel<T, int8_t, Equal>, boolean);
+    Register(ExpressionType::kCompareNotEqual, type,
+             &BinaryKernel<T, int8_t, NotEqual>, boolean);
+    Register(ExpressionType::kCompareLessThan, type,
+             &BinaryKernel<T, int8_t, LessThan>, boolean);
+    Register(ExpressionType::kCompareGreaterThan, type,
+             &BinaryKernel<T, int8_t, GreaterThan>, boolean);
+    Register(ExpressionType::kCompareLessThanOrEqualTo, type,
+             &BinaryKernel<T, int8_t, LessThanOrEqual>, boolean);
+    Register(ExpressionType::kCompareGreaterThanOrEqualTo, type,
+             &BinaryKernel<T, int8_t, GreaterThanOrEqual>, boolean);
+  }
+
+  std::unordered_map<uint64_t, ExpressionKernel> kernels_;
+};
+
+}  // namespace
+
+ExpressionKernel ExpressionKernels::Get(ExpressionType op, TypeId left,
+                                        TypeId right, TypeId result) {
+  static const Registry registry;
+  return registry.Get(op, left, right, result);
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,57 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_copy_from_file.hpp"
+
+#include "common/exception.hpp"
+#include "execution/csv_reader.hpp"
+#include "storage/data_table.hpp"
+#include "storage/parquet/parquet_reader.hpp"
+
+namespace zoomdb {
+
+PhysicalCopyFromFile::PhysicalCopyFromFile(DataTable& data_table,
+                                           CopyInfo copy_info)
+    : PhysicalOperator(PhysicalOperatorType::kCopyFromFile, {TypeId::kBigInt}),
+      table(data_table),
+      info(std::move(copy_info)) {}
+
+std::string PhysicalCopyFromFile::ParamsToString() const {
+  return info.file_path;
+}
+
+void PhysicalCopyFromFile::GetChunkInternal(DataChunk& chunk,
+                                            PhysicalOperatorState* state) {
+  size_t count = 0;
+  if (info.format == CopyFormat::kParquet) {
+    ParquetReader reader(info.file_path);
+    if (reader.GetTypes() != table.GetTypes()) {
+      throw ConversionException(
+          "The columns of \"%s\" do not match the columns of the table",
+          info.file_path.c_str());
+    }
+    std::vector<size_t> column_ids;
+    for (size_t i = 0; i < table.GetTypes().size(); i++) {
+      column_ids.push_back(i);
+    }
+    std::vector<std::unique_ptr<DataChunk>> chunks;
+    for (size_t i = 0; i < reader.GetRowGroupCount(); i++) {
+      reader.ReadRowGroup(i, column_ids, chunks);
+      for (auto& source : chunks) {
+        table.Append(*source);
+        count += source->GetCount();
+      }
+    }
+  } else {
+    count = ParallelCSVReader(info, table.GetTypes()).ReadInto(table);
+  }
+  chunk.GetVector(0).SetCount(1);
+  chunk.SetValue(0, 0, Value::BigInt(static_cast<int64_t>(count)));
+  state->finished = true;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,61 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_copy_to_file.hpp"
+
+#include <thread>
+
+#include "common/exception.hpp"
+#include "common/types/chunk_collection.hpp"
+#include "storage/parquet/parquet_writer.hpp"
+
+namespace zoomdb {
+
+PhysicalCopyToFile::PhysicalCopyToFile(CopyInfo copy_info,
+                                       std::vector<std::string> column_names,
+                                       std::unique_ptr<PhysicalOperator> child)
+    : PhysicalOperator(PhysicalOperatorType::kCopyToFile, {TypeId::kBigInt}),
+      info(std::move(copy_info)),
+      names(std::move(column_names)) {
+  children.push_back(std::move(child));
+}
+
+std::string PhysicalCopyToFile::ParamsToString() const {
+  return info.file_path;
+}
+
+void PhysicalCopyToFile::GetChunkInternal(DataChunk& chunk,
+                                          PhysicalOperatorState* state) {
+  if (info.format != CopyFormat::kParquet) {
+    throw NotImplementationException("COPY TO only supports Parquet files");
+  }
+  auto thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  ParquetWriter writer(info.file_path, children[0]->types, names);
+  auto collection = std::make_unique<ChunkCollection>();
+  size_t count    = 0;
+  while (true) {
+    children[0]->GetChunk(state->child_chunk, state->child_state.get());
+    if (state->child_chunk.GetCount() == 0) {
+      break;
+    }
+    collection->Append(state->child_chunk);
+    if (collection->GetCount() >= thread_count * ParquetWriter::kRowGroupSize) {
+      writer.Write(*collection, thread_count);
+      count += collection->GetCount();
+      collection = std::make_unique<ChunkCollection>();
+    }
+  }
+  writer.Write(*collection, thread_count);
+  count += collection->GetCount();
+  writer.Finalize();
+
+  chunk.GetVector(0).SetCount(1);
+  chunk.SetValue(0, 0, Value::BigInt(static_cast<int64_t>(count)));
+  state->finished = true;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,94 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_cross_product.hpp"
+
+#include "common/types/chunk_collection.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+class PhysicalCrossProductState : public PhysicalOperatorState {
+ public:
+  PhysicalCrossProductState(const PhysicalOperator& op, PhysicalOperator* left,
+                            QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, left, query_profiler),
+        built(false),
+        right_position(0) {}
+
+  bool built;
+  ChunkCollection right;
+  /**
+   * The right row combined with the current left chunk.
+   */
+  size_t right_position;
+};
+
+}  // namespace
+
+PhysicalCrossProduct::PhysicalCrossProduct(
+    std::vector<TypeId> result_types, std::unique_ptr<PhysicalOperator> left,
+    std::unique_ptr<PhysicalOperator> right)
+    : PhysicalOperator(PhysicalOperatorType::kCrossProduct,
+                       std::move(result_types)) {
+  children.push_back(std::move(left));
+  children.push_back(std::move(right));
+}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalCrossProduct::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalCrossProductState>(*this, children[0].get(),
+                                                     profiler);
+}
+
+void PhysicalCrossProduct::GetChunkInternal(DataChunk& chunk,
+                                            PhysicalOperatorState* state) {
+  auto cross_state = static_cast<PhysicalCrossProductState*>(state);
+  auto& right      = cross_state->right;
+  if (!cross_state->built) {
+    auto right_state = children[1]->GetOperatorState(state->profiler);
+    DataChunk right_chunk;
+    right_chunk.Initialize(children[1]->types);
+    while (true) {
+      children[1]->GetChunk(right_chunk, right_state.get());
+      if (right_chunk.GetCount() == 0) {
+        break;
+      }
+      right.Append(right_chunk);
+    }
+    state->metrics.bytes_allocated += right.GetAllocationSize();
+    cross_state->built = true;
+  }
+  if (right.GetCount() == 0) {
+    return;
+  }
+
+  // combine the current left chunk with one right row at a time
+  auto& left = state->child_chunk;
+  if (left.GetCount() == 0 || cross_state->right_position >= right.GetCount()) {
+    children[0]->GetChunk(left, state->child_state.get());
+    if (left.GetCount() == 0) {
+      return;
+    }
+    cross_state->right_position = 0;
+  }
+  auto left_count = left.ColumnCount();
+  for (size_t i = 0; i < left_count; i++) {
+    chunk.GetVector(i).Append(left.GetVector(i));
+  }
+  for (size_t i = left_count; i < chunk.ColumnCount(); i++) {
+    auto value = right.GetValue(i - left_count, cross_state->right_position);
+    for (size_t row = 0; row < left.GetCount(); row++) {
+      chunk.SetValue(i, row, value);
+    }
+    chunk.GetVector(i).SetCount(left.GetCount());
+  }
+  cross_state->right_position++;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_delete.hpp"
+
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+PhysicalDelete::PhysicalDelete(DataTable& data_table)
+    : PhysicalOperator(PhysicalOperatorType::kDelete, {TypeId::kBigInt}),
+      table(data_table) {}
+
+void PhysicalDelete::GetChunkInternal(DataChunk& chunk,
+                                      PhysicalOperatorState* state) {
+  int64_t count = 0;
+  auto& input   = state->child_chunk;
+  while (true) {
+    children[0]->GetChunk(input, state->child_state.get());
+    if (input.GetCount() == 0) {
+      break;
+    }
+    auto row_ids = input.GetVector(0).GetData<uint64_t>();
+    count += static_cast<int64_t>(table.Delete(row_ids, input.GetCount()));
+  }
+
+  chunk.GetVector(0).SetCount(1);
+  chunk.SetValue(0, 0, Value::BigInt(count));
+  state->finished = true;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,243 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_filter.hpp"
+
+#include "common/types/string_dictionary.hpp"
+#include "execution/expression_executor.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * The result of a filter expression for the strings of a dictionary.
+ */
+struct DictionaryFilter {
+  /**
+   * The column the expression references, and a copy of the expression that
+   * reads it from the first column instead.
+   */
+  size_t column = 0;
+  std::unique_ptr<Expression> expression;
+  const StringDictionary* dictionary = nullptr;
+  /**
+   * Whether a row passes, for every code evaluated so far and for NULL.
+   */
+  std::vector<int8_t> passed;
+  int8_t null_passed = 0;
+};
+
+class PhysicalFilterState : public PhysicalOperatorState {
+ public:
+  PhysicalFilterState(const PhysicalOperator& op, PhysicalOperator* child,
+                      QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, child, query_profiler) {}
+
+  /**
+   * One entry per expression, without a copy if the expression cannot be
+   * evaluated on a dictionary.
+   */
+  std::vector<DictionaryFilter> dictionary_filters;
+  /**
+   * The selection of the produced chunk, if its consumer allows one.
+   */
+  sel_t selection[kStandardVectorSize];
+};
+
+/**
+ * Collect the positions of the columns the expression references.
+ */
+void GetColumns(Expression& expr, std::vector<ColumnRefExpression*>& columns) {
+  if (expr.type == ExpressionType::kColumnRef) {
+    columns.push_back(static_cast<ColumnRefExpression*>(&expr));
+  }
+  expr.EnumerateChildren(
+      [&](Expression& child) { GetColumns(child, columns); });
+}
+
+void SelectAll(Vector& selection, size_t count) {
+  selection.Initialize(TypeId::kBoolean);
+  auto data = selection.GetData<int8_t>();
+  for (size_t i = 0; i < count; i++) {
+    data[i] = 1;
+  }
+  selection.SetCount(count);
+}
+
+/**
+ * Evaluate the expression for the strings of the dictionary that were added
+ * since it was last evaluated.
+ */
+void Evaluate(DictionaryFilter& filter, const StringDictionary& dictionary) {
+  DataChunk entries;
+  entries.Initialize({TypeId::kVarChar});
+  auto& strings = entries.GetVector(0);
+  Vector selection;
+  if (filter.dictionary != &dictionary) {
+    filter.dictionary = &dictionary;
+    filter.passed.clear();
+    strings.SetNull(0, true);
+    strings.SetCount(1);
+    SelectAll(selection, 1);
+    ExpressionExecutor(&entries).Select(*filter.expression, selection);
+    filter.null_passed = selection.GetData<int8_t>()[0];
+  }
+  auto size = dictionary.GetSize();
+  while (filter.passed.size() < size) {
+    auto start = filter.passed.size();
+    auto count = std::min(size - start, kStandardVectorSize);
+    strings.Reset();
+    auto data = strings.GetData<const char*>();
+    for (size_t i = 0; i < count; i++) {
+      data[i] = dictionary.GetString(static_cast<uint32_t>(start + i));
+    }
+    strings.SetCount(count);
+    SelectAll(selection, count);
+    ExpressionExecutor(&entries).Select(*filter.expression, selection);
+    auto passed = selection.GetData<int8_t>();
+    filter.passed.insert(filter.passed.end(), passed, passed + count);
+  }
+}
+
+/**
+ * Deselect the rows of the dictionary encoded vector, which are given by
+ * rows (all entries if nullptr), that do not pass.
+ */
+void SelectByCode(DictionaryFilter& filter, const Vector& vector,
+                  const sel_t* rows, Vector& selection) {
+  auto& dictionary = *vector.GetDictionary();
+  if (filter.dictionary != &dictionary ||
+      filter.passed.size() < dictionary.GetSize()) {
+    Evaluate(filter, dictionary);
+  }
+  auto codes = vector.GetDictionaryCodes();
+  auto data  = selection.GetData<int8_t>();
+  for (size_t i = 0; i < selection.GetCount(); i++) {
+    auto row = rows ? rows[i] : i;
+    if (data[i]) {
+      data[i] = vector.IsNull(row) ? filter.null_passed
+                                   : filter.passed[codes[row]];
+    }
+  }
+}
+
+}  // namespace
+
+PhysicalFilter::PhysicalFilter(std::vector<TypeId> result_types,
+                               std::vector<std::unique_ptr<Expression>> filters)
+    : PhysicalOperator(PhysicalOperatorType::kFilter, std::move(result_types)),
+      expressions(std::move(filters)) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalFilter::GetOperatorState(
+    QueryProfiler* profiler) {
+  auto state = std::make_unique<PhysicalFilterState>(*this, children[0].get(),
+                                                     profiler);
+  state->child_chunk.AllowSelection();
+  for (auto& expr : expressions) {
+    DictionaryFilter filter;
+    std::vector<ColumnRefExpression*> columns;
+    GetColumns(*expr, columns);
+    auto single_column = !columns.empty() && !expr->HasSubquery() &&
+                         columns[0]->return_type == TypeId::kVarChar;
+    for (auto column : columns) {
+      single_column = single_column && !column->outer_values &&
+                      column->index == columns[0]->index;
+    }
+    if (single_column) {
+      filter.column     = columns[0]->index;
+      filter.expression = expr->Copy();
+      columns.clear();
+      GetColumns(*filter.expression, columns);
+      for (auto column : columns) {
+        column->index = 0;
+      }
+    }
+    state->dictionary_filters.push_back(std::move(filter));
+  }
+  return state;
+}
+
+std::string PhysicalFilter::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result += (i == 0 ? "" : " AND ") + expressions[i]->ToString();
+  }
+  return result;
+}
+
+void PhysicalFilter::GetChunkInternal(DataChunk& chunk,
+                                      PhysicalOperatorState* state) {
+  auto filter_state = static_cast<PhysicalFilterState*>(state);
+  // fetch chunks until at least one row passes the filter
+  while (chunk.GetCount() == 0) {
+    children[0]->GetChunk(state->child_chunk, state->child_state.get());
+    auto& input = state->child_chunk;
+    if (input.GetCount() == 0) {
+      return;
+    }
+    ExpressionExecutor executor(&input);
+    Vector selection;
+    SelectAll(selection, input.GetCount());
+    for (size_t i = 0; i < expressions.size(); i++) {
+      auto& filter = filter_state->dictionary_filters[i];
+      if (filter.expression &&
+          input.GetVector(filter.column).GetDictionary()) {
+        SelectByCode(filter, input.GetVector(filter.column),
+                     input.GetSelection(), selection);
+      } else {
+        executor.Select(*expressions[i], selection);
+      }
+    }
+    auto passed     = selection.GetData<int8_t>();
+    size_t selected = 0;
+    for (size_t i = 0; i < input.GetCount(); i++) {
+      selected += passed[i] ? 1 : 0;
+    }
+    if (selected == 0) {
+      continue;
+    }
+    if (chunk.AllowsSelection()) {
+      // pass the rows on by reference, the consumer reads only the selected
+      // rows of the columns it needs
+      auto rows  = input.GetSelection();
+      size_t row = 0;
+      for (size_t i = 0; i < input.GetCount(); i++) {
+        if (passed[i]) {
+          filter_state->selection[row++] =
+              static_cast<sel_t>(rows ? rows[i] : i);
+        }
+      }
+      for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+        chunk.GetVector(i).Reference(input.GetVector(i));
+      }
+      if (rows || selected < input.GetCount()) {
+        chunk.SetSelection(filter_state->selection, selected);
+      }
+      return;
+    }
+    if (selected == input.GetCount()) {
+      chunk.Append(input);
+      continue;
+    }
+    for (size_t start = 0; start < input.GetCount();) {
+      if (!passed[start]) {
+        start++;
+        continue;
+      }
+      size_t end = start;
+      while (end < input.GetCount() && passed[end]) {
+        end++;
+      }
+      chunk.Append(input, start, end - start);
+      start = end;
+    }
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,406 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_hash_aggregate.hpp"
+
+#include <limits>
+#include <unordered_map>
+
+#include "common/exception.hpp"
+#include "common/parallel.hpp"
+#include "common/types/hash.hpp"
+#include "common/types/hyperloglog.hpp"
+#include "common/types/quantile_sketch.hpp"
+#include "common/types/string_dictionary.hpp"
+#include "execution/expression_executor.hpp"
+#include "parser/expression/aggregate_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * The intermediate state of one aggregate of one group.
+ */
+struct AggregateState {
+  int64_t count      = 0;
+  int64_t sum        = 0;
+  double sum_decimal = 0;
+  Value value;
+  /**
+   * The sketches of the approximate aggregates, which keep their memory
+   * fixed however many values are aggregated.
+   */
+  std::unique_ptr<HyperLogLog> hyperloglog;
+  std::unique_ptr<QuantileSketch> quantiles;
+};
+
+class PhysicalHashAggregateState : public PhysicalOperatorState {
+ public:
+  PhysicalHashAggregateState(const PhysicalOperator& op,
+                             PhysicalOperator* child,
+                             QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, child, query_profiler),
+        built(false),
+        position(0) {}
+
+  std::unordered_map<std::vector<Value>, size_t, ValueListHash,
+                     ValueListEquals>
+      table;
+  std::vector<std::vector<Value>> group_values;
+  /**
+   * For a single dictionary encoded group: the group of every code that was
+   * seen so far (kNoGroup if not), so that the strings are looked up in the
+   * table once per code instead of once per row.
+   */
+  const StringDictionary* dictionary = nullptr;
+  std::vector<size_t> dictionary_groups;
+  /**
+   * The states of the aggregates, aggregates.size() entries per group.
+   */
+  std::vector<AggregateState> states;
+  /**
+   * The non-NULL inputs of every DISTINCT aggregate and their groups, by
+   * aggregate.
+   */
+  std::vector<std::vector<std::pair<size_t, Value>>> distinct_inputs;
+  bool built;
+  size_t position;
+};
+
+constexpr size_t kNoGroup = std::numeric_limits<size_t>::max();
+
+AggregateState CreateState(const Expression& aggregate) {
+  AggregateState state;
+  if (aggregate.type == ExpressionType::kAggregateApproxCountDistinct) {
+    state.hyperloglog = std::make_unique<HyperLogLog>();
+  } else if (aggregate.type == ExpressionType::kAggregateApproxQuantile) {
+    state.quantiles = std::make_unique<QuantileSketch>();
+  }
+  return state;
+}
+
+void Update(const Expression& aggregate, AggregateState& state,
+            const Value& input) {
+  if (aggregate.type == ExpressionType::kAggregateCountStar) {
+    state.count++;
+    return;
+  }
+  if (input.IsNull()) {
+    return;
+  }
+  state.count++;
+  switch (aggregate.type) {
+    case ExpressionType::kAggregateSum:
+      if (aggregate.return_type == TypeId::kDecimal) {
+        state.sum_decimal += input.CastAs(TypeId::kDecimal).GetValue<double>();
+      } else if (__builtin_add_overflow(state.sum, input.GetNumericValue(),
+                                        &state.sum)) {
+        throw NumericValueOutOfRangeException(
+            "Overflow in SUM", NumericValueOutOfRangeException::kOverflow);
+      }
+      break;
+    case ExpressionType::kAggregateAvg:
+      state.sum_decimal += input.CastAs(TypeId::kDecimal).GetValue<double>();
+      break;
+    case ExpressionType::kAggregateMin:
+      if (state.value.IsNull() || input < state.value) {
+        state.value = input;
+      }
+      break;
+    case ExpressionType::kAggregateMax:
+      if (state.value.IsNull() || input > state.value) {
+        state.value = input;
+      }
+      break;
+    case ExpressionType::kAggregateApproxCountDistinct:
+      state.hyperloglog->Add(input.Hash());
+      break;
+    case ExpressionType::kAggregateApproxQuantile:
+      state.quantiles->Add(input.CastAs(TypeId::kDecimal).GetValue<double>());
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * Combine the state of other, aggregated from different inputs of the same
+ * group, into state.
+ */
+void Combine(const Expression& aggregate, AggregateState& state,
+             const AggregateState& other) {
+  if (other.count == 0) {
+    return;
+  }
+  state.count += other.count;
+  state.sum_decimal += other.sum_decimal;
+  if (__builtin_add_overflow(state.sum, other.sum, &state.sum)) {
+    throw NumericValueOutOfRangeException(
+        "Overflow in SUM", NumericValueOutOfRangeException::kOverflow);
+  }
+  if (aggregate.type == ExpressionType::kAggregateMin ||
+      aggregate.type == ExpressionType::kAggregateMax) {
+    auto is_max = aggregate.type == ExpressionType::kAggregateMax;
+    if (state.value.IsNull() ||
+        (is_max ? other.value > state.value : other.value < state.value)) {
+      state.value = other.value;
+    }
+  }
+  if (state.hyperloglog) {
+    state.hyperloglog->Merge(*other.hyperloglog);
+  }
+  if (state.quantiles) {
+    state.quantiles->Merge(*other.quantiles);
+  }
+}
+
+Value Finalize(const Expression& aggregate, const AggregateState& state) {
+  switch (aggregate.type) {
+    case ExpressionType::kAggregateCount:
+    case ExpressionType::kAggregateCountStar:
+      return Value::BigInt(state.count);
+    case ExpressionType::kAggregateSum:
+      if (state.count == 0) {
+        return Value(aggregate.return_type);
+      }
+      return aggregate.return_type == TypeId::kDecimal
+                 ? Value::Decimal(state.sum_decimal)
+                 : Value::BigInt(state.sum);
+    case ExpressionType::kAggregateAvg:
+      if (state.count == 0) {
+        return Value(TypeId::kDecimal);
+      }
+      return Value::Decimal(state.sum_decimal /
+                            static_cast<double>(state.count));
+    case ExpressionType::kAggregateMin:
+    case ExpressionType::kAggregateMax:
+      return state.value.IsNull() ? Value(aggregate.return_type) : state.value;
+    case ExpressionType::kAggregateApproxCountDistinct:
+      return Value::BigInt(
+          static_cast<int64_t>(state.hyperloglog->Count()));
+    case ExpressionType::kAggregateApproxQuantile: {
+      if (state.count == 0) {
+        return Value(aggregate.return_type);
+      }
+      auto quantile = static_cast<const AggregateExpression&>(aggregate)
+                          .quantile;
+      return Value::Decimal(state.quantiles->Quantile(quantile))
+          .CastAs(aggregate.return_type);
+    }
+    default:
+      throw NotImplementationException(
+          "Unsupported aggregate %s",
+          ExpressionTypeToString(aggregate.type).c_str());
+  }
+}
+
+}  // namespace
+
+PhysicalHashAggregate::PhysicalHashAggregate(
+    std::vector<TypeId> result_types,
+    std::vector<std::unique_ptr<Expression>> aggregates,
+    std::vector<std::unique_ptr<Expression>> group_list)
+    : PhysicalOperator(PhysicalOperatorType::kHashAggregate,
+                       std::move(result_types)),
+      expressions(std::move(aggregates)),
+      groups(std::move(group_list)) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalHashAggregate::GetOperatorState(
+    QueryProfiler* profiler) {
+  auto state = std::make_unique<PhysicalHashAggregateState>(
+      *this, children[0].get(), profiler);
+  // the groups and aggregates are evaluated for the selected rows only
+  state->child_chunk.AllowSelection();
+  return state;
+}
+
+std::string PhysicalHashAggregate::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result += (i == 0 ? "" : ", ") + expressions[i]->ToString();
+  }
+  if (!groups.empty()) {
+    result += " GROUP BY ";
+    for (size_t i = 0; i < groups.size(); i++) {
+      result += (i == 0 ? "" : ", ") + groups[i]->ToString();
+    }
+  }
+  return result;
+}
+
+void PhysicalHashAggregate::GetChunkInternal(DataChunk& chunk,
+                                             PhysicalOperatorState* state) {
+  auto aggr_state = static_cast<PhysicalHashAggregateState*>(state);
+  if (!aggr_state->built) {
+    Build(*aggr_state);
+    aggr_state->built = true;
+  }
+
+  // produce the next chunk of groups
+  auto& values = aggr_state->group_values;
+  auto& states = aggr_state->states;
+  size_t count = 0;
+  for (; aggr_state->position < values.size() && count < kStandardVectorSize;
+       aggr_state->position++, count++) {
+    size_t group = aggr_state->position;
+    for (size_t g = 0; g < groups.size(); g++) {
+      chunk.SetValue(g, count, values[group][g]);
+    }
+    for (size_t i = 0; i < expressions.size(); i++) {
+      chunk.SetValue(groups.size() + i, count,
+                     Finalize(*expressions[i],
+                              states[group * expressions.size() + i]));
+    }
+  }
+  for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+    chunk.GetVector(i).SetCount(count);
+  }
+}
+
+size_t PhysicalHashAggregate::AddGroup(PhysicalOperatorState& state,
+                                       std::vector<Value> key) {
+  auto& aggr_state = static_cast<PhysicalHashAggregateState&>(state);
+  size_t group     = aggr_state.group_values.size();
+  aggr_state.table.emplace(key, group);
+  aggr_state.group_values.push_back(std::move(key));
+  for (auto& expr : expressions) {
+    aggr_state.states.push_back(CreateState(*expr));
+  }
+  state.metrics.bytes_allocated += sizeof(Value) * groups.size() +
+                                   sizeof(AggregateState) * expressions.size();
+  return group;
+}
+
+size_t PhysicalHashAggregate::FindGroup(PhysicalOperatorState& state,
+                                        DataChunk& group_chunk, size_t row) {
+  auto& aggr_state = static_cast<PhysicalHashAggregateState&>(state);
+  std::vector<Value> key;
+  for (size_t g = 0; g < groups.size(); g++) {
+    key.push_back(group_chunk.GetValue(g, row));
+  }
+  auto entry = aggr_state.table.find(key);
+  return entry == aggr_state.table.end() ? AddGroup(state, std::move(key))
+                                         : entry->second;
+}
+
+void PhysicalHashAggregate::Build(PhysicalOperatorState& state) {
+  auto& aggr_state = static_cast<PhysicalHashAggregateState&>(state);
+  DataChunk group_chunk;
+  std::vector<TypeId> group_types;
+  for (auto& group : groups) {
+    group_types.push_back(group->return_type);
+  }
+  group_chunk.Initialize(group_types);
+  aggr_state.distinct_inputs.resize(expressions.size());
+  std::vector<Vector> payload;
+  std::vector<bool> distinct;
+  for (auto& expr : expressions) {
+    distinct.push_back(static_cast<AggregateExpression&>(*expr).distinct);
+    payload.emplace_back(expr->children.empty()
+                             ? TypeId::kBoolean
+                             : expr->children[0]->return_type);
+  }
+
+  while (true) {
+    children[0]->GetChunk(state.child_chunk, state.child_state.get());
+    auto& input = state.child_chunk;
+    if (input.GetCount() == 0) {
+      break;
+    }
+    ExpressionExecutor executor(&input);
+    executor.Execute(groups, group_chunk);
+    for (size_t i = 0; i < expressions.size(); i++) {
+      if (!expressions[i]->children.empty()) {
+        executor.ExecuteExpression(*expressions[i]->children[0], payload[i]);
+      }
+    }
+    auto dictionary = groups.size() == 1
+                          ? group_chunk.GetVector(0).GetDictionary()
+                          : nullptr;
+    if (dictionary && dictionary != aggr_state.dictionary) {
+      aggr_state.dictionary = dictionary;
+      aggr_state.dictionary_groups.clear();
+    }
+    auto codes = dictionary ? group_chunk.GetVector(0).GetDictionaryCodes()
+                            : nullptr;
+    for (size_t row = 0; row < input.GetCount(); row++) {
+      size_t group;
+      if (dictionary && !group_chunk.GetVector(0).IsNull(row)) {
+        auto code         = codes[row];
+        auto& code_groups = aggr_state.dictionary_groups;
+        if (code >= code_groups.size()) {
+          code_groups.resize(dictionary->GetSize(), kNoGroup);
+        }
+        if (code_groups[code] == kNoGroup) {
+          code_groups[code] = FindGroup(state, group_chunk, row);
+        }
+        group = code_groups[code];
+      } else {
+        group = FindGroup(state, group_chunk, row);
+      }
+      for (size_t i = 0; i < expressions.size(); i++) {
+        auto value = expressions[i]->children.empty()
+                         ? Value()
+                         : payload[i].GetValue(row);
+        if (!distinct[i]) {
+          Update(*expressions[i],
+                 aggr_state.states[group * expressions.size() + i], value);
+        } else if (!value.IsNull()) {
+          aggr_state.distinct_inputs[i].emplace_back(group, std::move(value));
+        }
+      }
+    }
+  }
+  if (groups.empty() && aggr_state.group_values.empty()) {
+    // an aggregate without groups produces a row for an empty input
+    AddGroup(state, {});
+  }
+  for (size_t i = 0; i < expressions.size(); i++) {
+    if (distinct[i]) {
+      AggregateDistinct(state, i);
+    }
+  }
+}
+
+void PhysicalHashAggregate::AggregateDistinct(PhysicalOperatorState& state,
+                                              size_t index) {
+  auto& aggr_state = static_cast<PhysicalHashAggregateState&>(state);
+  auto& aggregate  = *expressions[index];
+  auto& inputs     = aggr_state.distinct_inputs[index];
+  std::vector<std::unordered_map<size_t, AggregateState>> partitions(
+      kDistinctPartitions);
+  ParallelDistinct(
+      inputs.size(),
+      [&](size_t entry) {
+        return CombineHash(Hash(inputs[entry].first),
+                           inputs[entry].second.Hash());
+      },
+      [&](size_t left, size_t right) {
+        return inputs[left].first == inputs[right].first &&
+               inputs[left].second == inputs[right].second;
+      },
+      [&](size_t partition, size_t entry) {
+        auto& states = partitions[partition];
+        auto group   = states.find(inputs[entry].first);
+        if (group == states.end()) {
+          group = states.emplace(inputs[entry].first, CreateState(aggregate))
+                      .first;
+        }
+        Update(aggregate, group->second, inputs[entry].second);
+      });
+  for (auto& states : partitions) {
+    for (auto& [group, partial] : states) {
+      Combine(aggregate,
+              aggr_state.states[group * expressions.size() + index], partial);
+    }
+  }
+  inputs.clear();
+  inputs.shrink_to_fit();
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,177 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_hash_distinct.hpp"
+
+#include <exception>
+#include <string_view>
+#include <vector>
+
+#include "common/parallel.hpp"
+#include "common/types/chunk_collection.hpp"
+#include "common/types/hash.hpp"
+#include "storage/index.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * The keys of the rows of one chunk, the key of row i is the bytes from
+ * offsets[i] to offsets[i + 1].
+ */
+struct ChunkKeys {
+  std::string_view Key(size_t row) const {
+    return std::string_view(reinterpret_cast<const char*>(data.data()) +
+                                offsets[row],
+                            offsets[row + 1] - offsets[row]);
+  }
+
+  std::vector<uint8_t> data;
+  std::vector<size_t> offsets;
+};
+
+/**
+ * Encode the rows of the chunk: a NULL flag per column, followed by the
+ * value if it is not NULL.
+ */
+void EncodeKeys(const DataChunk& chunk, ChunkKeys& keys) {
+  // 0.0 and -0.0 are equal, but encode differently: both are encoded as 0.0
+  const Vector zero(Value::Decimal(0));
+  keys.offsets.assign(1, 0);
+  for (size_t row = 0; row < chunk.GetCount(); row++) {
+    for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+      auto& vector = chunk.GetVector(i);
+      keys.data.push_back(vector.IsNull(row) ? 1 : 0);
+      if (vector.IsNull(row)) {
+        continue;
+      }
+      if (vector.GetType() == TypeId::kDecimal &&
+          vector.GetData<double>()[row] == 0) {
+        Index::EncodeValue(zero, 0, keys.data);
+        continue;
+      }
+      Index::EncodeValue(vector, row, keys.data);
+    }
+    keys.offsets.push_back(keys.data.size());
+  }
+}
+
+class PhysicalHashDistinctState : public PhysicalOperatorState {
+ public:
+  PhysicalHashDistinctState(const PhysicalOperator& op,
+                            PhysicalOperator* child,
+                            QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, child, query_profiler),
+        built(false),
+        position(0) {}
+
+  ChunkCollection rows;
+  /**
+   * Whether a row is the first occurrence of its value, a byte per row so
+   * that the partitions can mark their rows from different threads.
+   */
+  std::vector<uint8_t> first;
+  sel_t selection[kStandardVectorSize];
+  bool built;
+  size_t position;
+};
+
+}  // namespace
+
+PhysicalHashDistinct::PhysicalHashDistinct(std::vector<TypeId> result_types)
+    : PhysicalOperator(PhysicalOperatorType::kHashDistinct,
+                       std::move(result_types)) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalHashDistinct::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalHashDistinctState>(*this, children[0].get(),
+                                                     profiler);
+}
+
+void PhysicalHashDistinct::GetChunkInternal(DataChunk& chunk,
+                                            PhysicalOperatorState* state) {
+  auto distinct_state = static_cast<PhysicalHashDistinctState*>(state);
+  if (!distinct_state->built) {
+    Build(*distinct_state);
+    distinct_state->built = true;
+  }
+  auto& rows = distinct_state->rows;
+  // skip the chunks without a distinct row
+  while (distinct_state->position < rows.ChunkCount()) {
+    auto index  = distinct_state->position++;
+    auto& input = rows.GetChunk(index);
+    auto first  = distinct_state->first.data() + index * kStandardVectorSize;
+    size_t selected = 0;
+    for (size_t i = 0; i < input.GetCount(); i++) {
+      if (first[i]) {
+        distinct_state->selection[selected++] = static_cast<sel_t>(i);
+      }
+    }
+    if (selected == 0) {
+      continue;
+    }
+    if (chunk.AllowsSelection()) {
+      for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+        chunk.GetVector(i).Reference(input.GetVector(i));
+      }
+      if (selected < input.GetCount()) {
+        chunk.SetSelection(distinct_state->selection, selected);
+      }
+    } else {
+      for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+        chunk.GetVector(i).AppendSelection(
+            input.GetVector(i), distinct_state->selection, selected);
+      }
+    }
+    return;
+  }
+}
+
+void PhysicalHashDistinct::Build(PhysicalOperatorState& state) {
+  auto& distinct_state = static_cast<PhysicalHashDistinctState&>(state);
+  auto& rows           = distinct_state.rows;
+  while (true) {
+    children[0]->GetChunk(state.child_chunk, state.child_state.get());
+    if (state.child_chunk.GetCount() == 0) {
+      break;
+    }
+    rows.Append(state.child_chunk);
+  }
+
+  // the collection packs its chunks, row r is row r % kStandardVectorSize
+  // of chunk r / kStandardVectorSize
+  std::vector<ChunkKeys> keys(rows.ChunkCount());
+  std::vector<std::exception_ptr> errors(rows.ChunkCount());
+  ParallelFor(rows.ChunkCount(), 0, [&](size_t i) {
+    try {
+      EncodeKeys(rows.GetChunk(i), keys[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  });
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  auto key = [&](size_t row) {
+    return keys[row / kStandardVectorSize].Key(row % kStandardVectorSize);
+  };
+  distinct_state.first.assign(rows.GetCount(), 0);
+  ParallelDistinct(
+      rows.GetCount(),
+      [&](size_t row) {
+        auto bytes = key(row);
+        return HashBytes(bytes.data(), bytes.size());
+      },
+      [&](size_t left, size_t right) { return key(left) == key(right); },
+      [&](size_t, size_t row) { distinct_state.first[row] = 1; });
+  state.metrics.bytes_allocated += rows.GetCount();
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,393 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_hash_join.hpp"
+
+#include <unordered_map>
+
+#include "common/exception.hpp"
+#include "common/types/chunk_collection.hpp"
+#include "common/types/string_dictionary.hpp"
+#include "execution/expression_executor.hpp"
+#include "parser/expression/comparison_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+class PhysicalHashJoinState : public PhysicalOperatorState {
+ public:
+  PhysicalHashJoinState(const PhysicalOperator& op, PhysicalOperator* left,
+                        QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, left, query_profiler),
+        built(false),
+        row(0),
+        probed(false),
+        match_position(0) {}
+
+  bool built;
+  /**
+   * The materialized right side, and the right sides of the conditions
+   * evaluated for every right row.
+   */
+  ChunkCollection right;
+  ChunkCollection right_keys;
+  /**
+   * Maps the values of the equality conditions to the matching right rows.
+   */
+  std::unordered_map<std::vector<Value>, std::vector<size_t>, ValueListHash,
+                     ValueListEquals>
+      table;
+  /**
+   * Whether a right side of a null-aware condition is NULL.
+   */
+  bool right_has_null = false;
+  /**
+   * For a single equality condition with a dictionary encoded left side:
+   * the matching right rows of every code that was probed so far (nullptr
+   * if not), so that the table is probed once per code instead of per row.
+   */
+  const StringDictionary* dictionary = nullptr;
+  std::vector<const std::vector<size_t>*> dictionary_matches;
+
+  /**
+   * The left sides of the conditions for the current left chunk.
+   */
+  DataChunk left_keys;
+  size_t row;
+  bool probed;
+  std::vector<size_t> matches;
+  size_t match_position;
+};
+
+const std::vector<size_t> kNoMatches;
+
+bool IsTrue(const Value& value) {
+  return !value.IsNull() && value.GetValue<bool>();
+}
+
+Value Compare(ExpressionType comparison, const Value& left,
+              const Value& right) {
+  if (left.IsNull() || right.IsNull()) {
+    return Value(TypeId::kBoolean);
+  }
+  int cmp = Value::Compare(left, right);
+  switch (comparison) {
+    case ExpressionType::kCompareEqual:
+      return Value::Boolean(cmp == 0);
+    case ExpressionType::kCompareNotEqual:
+      return Value::Boolean(cmp != 0);
+    case ExpressionType::kCompareLessThan:
+      return Value::Boolean(cmp < 0);
+    case ExpressionType::kCompareGreaterThan:
+      return Value::Boolean(cmp > 0);
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      return Value::Boolean(cmp <= 0);
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      return Value::Boolean(cmp >= 0);
+    default:
+      throw NotImplementationException(
+          "Unsupported join comparison %s",
+          ExpressionTypeToString(comparison).c_str());
+  }
+}
+
+}  // namespace
+
+PhysicalHashJoin::PhysicalHashJoin(std::vector<TypeId> result_types,
+                                   JoinType type,
+                                   std::vector<JoinCondition> join_conditions,
+                                   std::unique_ptr<PhysicalOperator> left,
+                                   std::unique_ptr<PhysicalOperator> right)
+    : PhysicalOperator(PhysicalOperatorType::kHashJoin,
+                       std::move(result_types)),
+      join_type(type),
+      conditions(std::move(join_conditions)) {
+  for (auto& cond : conditions) {
+    left_expressions.push_back(std::move(cond.left));
+    right_expressions.push_back(std::move(cond.right));
+  }
+  children.push_back(std::move(left));
+  children.push_back(std::move(right));
+}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalHashJoin::GetOperatorState(
+    QueryProfiler* profiler) {
+  auto state = std::make_unique<PhysicalHashJoinState>(
+      *this, children[0].get(), profiler);
+  std::vector<TypeId> key_types;
+  for (auto& expr : left_expressions) {
+    key_types.push_back(expr->return_type);
+  }
+  state->left_keys.Initialize(key_types);
+  return state;
+}
+
+std::string PhysicalHashJoin::ParamsToString() const {
+  std::string result = JoinTypeToString(join_type);
+  for (size_t i = 0; i < conditions.size(); i++) {
+    result += (i == 0 ? " " : " AND ") + left_expressions[i]->ToString() +
+              " " +
+              ComparisonExpression::ComparisonToString(
+                  conditions[i].comparison) +
+              " " + right_expressions[i]->ToString();
+  }
+  return result;
+}
+
+void PhysicalHashJoin::Build(PhysicalOperatorState& state) {
+  auto& join_state = static_cast<PhysicalHashJoinState&>(state);
+  auto right_state = children[1]->GetOperatorState(state.profiler);
+  DataChunk right_chunk;
+  right_chunk.Initialize(children[1]->types);
+
+  std::vector<TypeId> key_types;
+  for (auto& expr : right_expressions) {
+    key_types.push_back(expr->return_type);
+  }
+  DataChunk key_chunk;
+  key_chunk.Initialize(key_types);
+  while (true) {
+    children[1]->GetChunk(right_chunk, right_state.get());
+    if (right_chunk.GetCount() == 0) {
+      break;
+    }
+    ExpressionExecutor executor(&right_chunk);
+    executor.Execute(right_expressions, key_chunk);
+    join_state.right.Append(right_chunk);
+    join_state.right_keys.Append(key_chunk);
+  }
+
+  size_t count = join_state.right.GetCount();
+  for (size_t row = 0; row < count; row++) {
+    std::vector<Value> key;
+    bool has_null = false;
+    for (size_t i = 0; i < conditions.size(); i++) {
+      auto value = join_state.right_keys.GetValue(i, row);
+      if (conditions[i].null_aware && value.IsNull()) {
+        join_state.right_has_null = true;
+      }
+      if (conditions[i].comparison == ExpressionType::kCompareEqual) {
+        has_null = has_null || value.IsNull();
+        key.push_back(std::move(value));
+      }
+    }
+    if (!has_null) {
+      // NULL never compares equal, such rows can never be found
+      join_state.table[std::move(key)].push_back(row);
+    }
+  }
+  state.metrics.bytes_allocated +=
+      join_state.right.GetAllocationSize() +
+      join_state.right_keys.GetAllocationSize() +
+      join_state.table.size() * sizeof(std::vector<Value>) +
+      count * sizeof(size_t);
+}
+
+void PhysicalHashJoin::Probe(PhysicalOperatorState& state) {
+  auto& join_state = static_cast<PhysicalHashJoinState&>(state);
+  auto row         = join_state.row;
+  join_state.matches.clear();
+  join_state.match_position = 0;
+
+  std::vector<size_t> equalities;
+  for (size_t i = 0; i < conditions.size(); i++) {
+    if (conditions[i].comparison == ExpressionType::kCompareEqual) {
+      if (join_state.left_keys.GetVector(i).IsNull(row)) {
+        return;
+      }
+      equalities.push_back(i);
+    }
+  }
+
+  auto check = [&](size_t right_row) {
+    for (size_t i = 0; i < conditions.size(); i++) {
+      if (conditions[i].comparison != ExpressionType::kCompareEqual &&
+          !IsTrue(Compare(conditions[i].comparison,
+                          join_state.left_keys.GetValue(i, row),
+                          join_state.right_keys.GetValue(i, right_row)))) {
+        return;
+      }
+    }
+    join_state.matches.push_back(right_row);
+  };
+  if (!equalities.empty()) {
+    for (auto right_row : FindMatches(state, equalities)) {
+      check(right_row);
+    }
+  } else {
+    for (size_t right_row = 0; right_row < join_state.right.GetCount();
+         right_row++) {
+      check(right_row);
+    }
+  }
+}
+
+const std::vector<size_t>& PhysicalHashJoin::FindMatches(
+    PhysicalOperatorState& state, const std::vector<size_t>& equalities) {
+  auto& join_state = static_cast<PhysicalHashJoinState&>(state);
+  auto row         = join_state.row;
+  auto find        = [&]() -> const std::vector<size_t>* {
+    std::vector<Value> key;
+    for (auto i : equalities) {
+      key.push_back(join_state.left_keys.GetValue(i, row));
+    }
+    auto entry = join_state.table.find(key);
+    return entry == join_state.table.end() ? &kNoMatches : &entry->second;
+  };
+
+  auto& left_key  = join_state.left_keys.GetVector(equalities[0]);
+  auto dictionary = left_key.GetDictionary();
+  if (equalities.size() > 1 || !dictionary) {
+    return *find();
+  }
+  if (dictionary != join_state.dictionary) {
+    join_state.dictionary = dictionary;
+    join_state.dictionary_matches.clear();
+  }
+  auto code     = left_key.GetDictionaryCodes()[row];
+  auto& matches = join_state.dictionary_matches;
+  if (code >= matches.size()) {
+    matches.resize(dictionary->GetSize(), nullptr);
+  }
+  if (!matches[code]) {
+    matches[code] = find();
+  }
+  return *matches[code];
+}
+
+Value PhysicalHashJoin::GetMarkWithoutMatch(PhysicalOperatorState& state) {
+  auto& join_state = static_cast<PhysicalHashJoinState&>(state);
+  auto row         = join_state.row;
+  bool left_has_null = false;
+  bool null_aware    = false;
+  for (size_t i = 0; i < conditions.size(); i++) {
+    if (conditions[i].null_aware) {
+      null_aware    = true;
+      left_has_null = left_has_null ||
+                      join_state.left_keys.GetVector(i).IsNull(row);
+    }
+  }
+  if (!null_aware || (!left_has_null && !join_state.right_has_null)) {
+    return Value::Boolean(false);
+  }
+  // the mark is NULL if the conditions are NULL (rather than false) for one
+  // of the right rows
+  for (size_t right_row = 0; right_row < join_state.right.GetCount();
+       right_row++) {
+    bool is_null = false;
+    bool is_false = false;
+    for (size_t i = 0; i < conditions.size() && !is_false; i++) {
+      auto result = Compare(conditions[i].comparison,
+                            join_state.left_keys.GetValue(i, row),
+                            join_state.right_keys.GetValue(i, right_row));
+      if (result.IsNull()) {
+        is_null = true;
+      } else if (!result.GetValue<bool>()) {
+        is_false = true;
+      }
+    }
+    if (is_null && !is_false) {
+      return Value(TypeId::kBoolean);
+    }
+  }
+  return Value::Boolean(false);
+}
+
+void PhysicalHashJoin::GetChunkInternal(DataChunk& chunk,
+                                        PhysicalOperatorState* state) {
+  auto join_state = static_cast<PhysicalHashJoinState*>(state);
+  if (!join_state->built) {
+    Build(*state);
+    join_state->built = true;
+  }
+  auto& left       = state->child_chunk;
+  auto left_count  = children[0]->types.size();
+  size_t count     = 0;
+  auto emit_left   = [&]() {
+    for (size_t i = 0; i < left_count; i++) {
+      chunk.SetValue(i, count, left.GetValue(i, join_state->row));
+    }
+  };
+  auto finish_row  = [&]() {
+    join_state->row++;
+    join_state->probed = false;
+  };
+
+  while (count < kStandardVectorSize) {
+    if (join_state->row >= left.GetCount()) {
+      children[0]->GetChunk(left, state->child_state.get());
+      if (left.GetCount() == 0) {
+        break;
+      }
+      ExpressionExecutor executor(&left);
+      executor.Execute(left_expressions, join_state->left_keys);
+      join_state->row    = 0;
+      join_state->probed = false;
+    }
+    if (!join_state->probed) {
+      Probe(*state);
+      join_state->probed = true;
+    }
+    auto& matches = join_state->matches;
+    switch (join_type) {
+      case JoinType::kInner:
+      case JoinType::kLeft: {
+        if (matches.empty()) {
+          if (join_type == JoinType::kLeft) {
+            emit_left();
+            for (size_t i = left_count; i < types.size(); i++) {
+              chunk.SetValue(i, count, Value(types[i]));
+            }
+            count++;
+          }
+          finish_row();
+          break;
+        }
+        for (; join_state->match_position < matches.size() &&
+               count < kStandardVectorSize;
+             join_state->match_position++, count++) {
+          emit_left();
+          auto right_row = matches[join_state->match_position];
+          for (size_t i = left_count; i < types.size(); i++) {
+            chunk.SetValue(i, count,
+                           join_state->right.GetValue(i - left_count,
+                                                      right_row));
+          }
+        }
+        if (join_state->match_position == matches.size()) {
+          finish_row();
+        }
+        break;
+      }
+      case JoinType::kSemi:
+      case JoinType::kAnti:
+        if (matches.empty() == (join_type == JoinType::kAnti)) {
+          emit_left();
+          count++;
+        }
+        finish_row();
+        break;
+      case JoinType::kMark:
+        emit_left();
+        chunk.SetValue(left_count, count,
+                       matches.empty() ? GetMarkWithoutMatch(*state)
+                                       : Value::Boolean(true));
+        count++;
+        finish_row();
+        break;
+      default:
+        throw NotImplementationException(
+            "Unsupported join type %s", JoinTypeToString(join_type).c_str());
+    }
+  }
+  for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+    chunk.GetVector(i).SetCount(count);
+  }
+}
+
+}  // namespace zoomdb
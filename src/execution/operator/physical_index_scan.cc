@@ -0,0 +1,94 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_index_scan.hpp"
+
+#include <algorithm>
+
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+class PhysicalIndexScanState : public PhysicalOperatorState {
+ public:
+  PhysicalIndexScanState(const PhysicalOperator& op,
+                         QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, nullptr, query_profiler),
+        initialized(false),
+        offset(0) {}
+
+  bool initialized;
+  std::vector<uint64_t> row_ids;
+  size_t offset;
+};
+
+std::vector<TypeId> GetScanTypes(DataTable& table,
+                                 const std::vector<size_t>& column_ids) {
+  std::vector<TypeId> result;
+  for (auto column : column_ids) {
+    result.push_back(table.GetColumnType(column));
+  }
+  return result;
+}
+
+}  // namespace
+
+PhysicalIndexScan::PhysicalIndexScan(DataTable& data_table, std::string name,
+                                     std::vector<size_t> columns,
+                                     Index& scan_index, Value lower_bound,
+                                     bool lower_is_inclusive,
+                                     Value upper_bound,
+                                     bool upper_is_inclusive)
+    : PhysicalOperator(PhysicalOperatorType::kIndexScan,
+                       GetScanTypes(data_table, columns)),
+      table(data_table),
+      table_name(std::move(name)),
+      column_ids(std::move(columns)),
+      index(scan_index),
+      lower(std::move(lower_bound)),
+      lower_inclusive(lower_is_inclusive),
+      upper(std::move(upper_bound)),
+      upper_inclusive(upper_is_inclusive) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalIndexScan::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalIndexScanState>(*this, profiler);
+}
+
+std::string PhysicalIndexScan::ParamsToString() const {
+  std::string result = table_name + " " + index.GetName() + " ";
+  result += lower.IsNull() ? "(-inf"
+                           : (lower_inclusive ? "[" : "(") + lower.ToString();
+  result += ", ";
+  result += upper.IsNull() ? "+inf)"
+                           : upper.ToString() + (upper_inclusive ? "]" : ")");
+  return result;
+}
+
+void PhysicalIndexScan::GetChunkInternal(DataChunk& chunk,
+                                         PhysicalOperatorState* state) {
+  auto scan_state = static_cast<PhysicalIndexScanState*>(state);
+  if (!scan_state->initialized) {
+    index.Scan(lower, lower_inclusive, upper, upper_inclusive,
+               scan_state->row_ids);
+    // fetch the rows in table order, for locality
+    std::sort(scan_state->row_ids.begin(), scan_state->row_ids.end());
+    scan_state->initialized = true;
+  }
+  auto& row_ids = scan_state->row_ids;
+  if (scan_state->offset >= row_ids.size()) {
+    return;
+  }
+  auto count =
+      std::min(row_ids.size() - scan_state->offset, kStandardVectorSize);
+  table.Fetch(row_ids.data() + scan_state->offset, count, column_ids, chunk);
+  scan_state->offset += count;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,102 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_insert.hpp"
+
+#include <functional>
+
+#include "execution/expression_executor.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+PhysicalInsert::PhysicalInsert(
+    DataTable& data_table, std::vector<size_t> columns,
+    std::vector<std::vector<std::unique_ptr<Expression>>> values)
+    : PhysicalOperator(PhysicalOperatorType::kInsert, {TypeId::kBigInt}),
+      table(data_table),
+      column_ids(std::move(columns)),
+      insert_values(std::move(values)) {}
+
+std::string PhysicalInsert::ParamsToString() const {
+  return std::to_string(insert_values.size()) + " rows";
+}
+
+void PhysicalInsert::Flush(DataChunk& insert_chunk, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  for (size_t i = 0; i < insert_chunk.ColumnCount(); i++) {
+    insert_chunk.GetVector(i).SetCount(count);
+  }
+  table.Append(insert_chunk);
+  insert_chunk.Reset();
+}
+
+void PhysicalInsert::GetChunkInternal(DataChunk& chunk,
+                                      PhysicalOperatorState* state) {
+  auto& table_types = table.GetTypes();
+  // the child produces the columns of the table in order, its chunks can
+  // be appended as they are
+  bool all_columns = column_ids.size() == table_types.size();
+  for (size_t i = 0; i < column_ids.size() && all_columns; i++) {
+    all_columns = column_ids[i] == i;
+  }
+
+  DataChunk insert_chunk;
+  insert_chunk.Initialize(table_types);
+  size_t buffered = 0;
+  int64_t count   = 0;
+  auto add_row    = [&](const std::function<Value(size_t)>& get_value) {
+    for (size_t column = 0; column < table_types.size(); column++) {
+      insert_chunk.SetValue(column, buffered, Value(table_types[column]));
+    }
+    for (size_t i = 0; i < column_ids.size(); i++) {
+      insert_chunk.SetValue(column_ids[i], buffered, get_value(i));
+    }
+    count++;
+    if (++buffered == kStandardVectorSize) {
+      Flush(insert_chunk, buffered);
+      buffered = 0;
+    }
+  };
+
+  if (children.empty()) {
+    ExpressionExecutor executor;
+    for (auto& row : insert_values) {
+      add_row([&](size_t i) {
+        Vector result;
+        result.Initialize(table_types[column_ids[i]]);
+        executor.ExecuteExpression(*row[i], result);
+        return result.GetValue(0);
+      });
+    }
+  } else {
+    auto& input = state->child_chunk;
+    while (true) {
+      children[0]->GetChunk(input, state->child_state.get());
+      if (input.GetCount() == 0) {
+        break;
+      }
+      if (all_columns) {
+        table.Append(input);
+        count += static_cast<int64_t>(input.GetCount());
+        continue;
+      }
+      for (size_t row = 0; row < input.GetCount(); row++) {
+        add_row([&](size_t i) { return input.GetValue(i, row); });
+      }
+    }
+  }
+  Flush(insert_chunk, buffered);
+
+  chunk.GetVector(0).SetCount(1);
+  chunk.SetValue(0, 0, Value::BigInt(count));
+  state->finished = true;
+}
+
+}  // namespace zoomdb
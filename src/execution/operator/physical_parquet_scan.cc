@@ -0,0 +1,150 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_parquet_scan.hpp"
+
+#include <algorithm>
+#include <deque>
+
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+class PhysicalParquetScanState : public PhysicalOperatorState {
+ public:
+  PhysicalParquetScanState(const PhysicalOperator& op,
+                           QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, nullptr, query_profiler),
+        row_group(0),
+        chunk_index(0),
+        prefetch_next(0) {}
+
+  size_t row_group;
+  /**
+   * The chunks of the last row group read.
+   */
+  std::vector<std::unique_ptr<DataChunk>> chunks;
+  size_t chunk_index;
+  /**
+   * The row groups prefetched but not read yet, in ascending order, and the
+   * row group to consider for prefetching next.
+   */
+  std::deque<size_t> prefetched;
+  size_t prefetch_next;
+};
+
+std::vector<TypeId> GetScanTypes(const ParquetReader& reader,
+                                 const std::vector<size_t>& column_ids) {
+  std::vector<TypeId> result;
+  for (auto column : column_ids) {
+    result.push_back(reader.GetTypes()[column]);
+  }
+  return result;
+}
+
+}  // namespace
+
+PhysicalParquetScan::PhysicalParquetScan(
+    std::shared_ptr<const ParquetReader> parquet_reader,
+    std::vector<size_t> columns,
+    std::vector<std::unique_ptr<Expression>> table_filters, size_t prefetch)
+    : PhysicalOperator(PhysicalOperatorType::kParquetScan,
+                       GetScanTypes(*parquet_reader, columns)),
+      reader(std::move(parquet_reader)),
+      column_ids(std::move(columns)),
+      filters(std::move(table_filters)),
+      prefetch_depth(prefetch) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalParquetScan::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalParquetScanState>(*this, profiler);
+}
+
+std::string PhysicalParquetScan::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    result += (i == 0 ? "" : ", ") + reader->GetNames()[column_ids[i]];
+  }
+  for (auto& filter : filters) {
+    result += " " + filter->ToString();
+  }
+  return result;
+}
+
+bool PhysicalParquetScan::RowGroupMayMatch(size_t row_group) const {
+  for (auto& filter : filters) {
+    if (!ComparisonExpression::IsComparison(filter->type) ||
+        filter->children.size() != 2) {
+      continue;
+    }
+    auto comparison = filter->type;
+    auto left       = filter->children[0].get();
+    auto right      = filter->children[1].get();
+    if (left->type == ExpressionType::kValueConstant) {
+      std::swap(left, right);
+      comparison = ComparisonExpression::FlipComparison(comparison);
+    }
+    if (left->type != ExpressionType::kColumnRef ||
+        right->type != ExpressionType::kValueConstant) {
+      continue;
+    }
+    auto index  = static_cast<ColumnRefExpression*>(left)->index;
+    auto& value = static_cast<ConstantExpression*>(right)->value;
+    if (index < column_ids.size() &&
+        !reader->RowGroupMayMatch(row_group, column_ids[index], comparison,
+                                  value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PhysicalParquetScan::Prefetch(PhysicalOperatorState* state) const {
+  auto scan_state = static_cast<PhysicalParquetScanState*>(state);
+  auto& prefetched = scan_state->prefetched;
+  while (!prefetched.empty() && prefetched.front() <= scan_state->row_group) {
+    prefetched.pop_front();
+  }
+  auto& next = scan_state->prefetch_next;
+  next       = std::max(next, scan_state->row_group + 1);
+  while (prefetched.size() < prefetch_depth &&
+         next < reader->GetRowGroupCount()) {
+    if (RowGroupMayMatch(next)) {
+      reader->Prefetch(next, column_ids);
+      prefetched.push_back(next);
+    }
+    next++;
+  }
+}
+
+void PhysicalParquetScan::GetChunkInternal(DataChunk& chunk,
+                                           PhysicalOperatorState* state) {
+  auto scan_state = static_cast<PhysicalParquetScanState*>(state);
+  while (scan_state->chunk_index >= scan_state->chunks.size()) {
+    auto& row_group = scan_state->row_group;
+    while (row_group < reader->GetRowGroupCount() &&
+           !RowGroupMayMatch(row_group)) {
+      row_group++;
+    }
+    if (row_group >= reader->GetRowGroupCount()) {
+      return;
+    }
+    Prefetch(scan_state);
+    reader->ReadRowGroup(row_group++, column_ids, scan_state->chunks);
+    scan_state->chunk_index = 0;
+  }
+  auto& source = *scan_state->chunks[scan_state->chunk_index++];
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    chunk.GetVector(i).Reference(source.GetVector(i));
+  }
+}
+
+}  // namespace zoomdb
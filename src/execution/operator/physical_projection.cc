@@ -0,0 +1,54 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_projection.hpp"
+
+#include "execution/expression_executor.hpp"
+
+namespace zoomdb {
+
+PhysicalProjection::PhysicalProjection(
+    std::vector<TypeId> result_types,
+    std::vector<std::unique_ptr<Expression>> select_list)
+    : PhysicalOperator(PhysicalOperatorType::kProjection,
+                       std::move(result_types)),
+      expressions(std::move(select_list)) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalProjection::GetOperatorState(
+    QueryProfiler* profiler) {
+  auto state = PhysicalOperator::GetOperatorState(profiler);
+  // the expressions are evaluated for the selected rows only
+  state->child_chunk.AllowSelection();
+  return state;
+}
+
+std::string PhysicalProjection::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result += (i == 0 ? "" : ", ") + expressions[i]->ToString();
+  }
+  return result;
+}
+
+void PhysicalProjection::GetChunkInternal(DataChunk& chunk,
+                                          PhysicalOperatorState* state) {
+  if (children.empty()) {
+    // a projection without FROM clause produces a single row
+    ExpressionExecutor executor;
+    executor.Execute(expressions, chunk);
+    state->finished = true;
+    return;
+  }
+  children[0]->GetChunk(state->child_chunk, state->child_state.get());
+  if (state->child_chunk.GetCount() == 0) {
+    return;
+  }
+  ExpressionExecutor executor(&state->child_chunk);
+  executor.Execute(expressions, chunk);
+}
+
+}  // namespace zoomdb
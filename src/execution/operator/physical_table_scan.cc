@@ -0,0 +1,128 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_table_scan.hpp"
+
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+class PhysicalTableScanState : public PhysicalOperatorState {
+ public:
+  PhysicalTableScanState(const PhysicalOperator& op,
+                         QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, nullptr, query_profiler), chunk_index(0) {}
+
+  size_t chunk_index;
+  /**
+   * The current chunk, held so that it does not change while the output
+   * references it.
+   */
+  std::shared_ptr<DataChunk> chunk;
+  /**
+   * The row ids of the current chunk, if the row id column is scanned.
+   */
+  uint64_t row_ids[kStandardVectorSize];
+  /**
+   * The rows of the current chunk that are not deleted.
+   */
+  sel_t selection[kStandardVectorSize];
+};
+
+std::vector<TypeId> GetScanTypes(DataTable& table,
+                                 const std::vector<size_t>& column_ids) {
+  std::vector<TypeId> result;
+  for (auto column : column_ids) {
+    result.push_back(table.GetColumnType(column));
+  }
+  return result;
+}
+
+}  // namespace
+
+PhysicalTableScan::PhysicalTableScan(DataTable& data_table, std::string name,
+                                     std::vector<size_t> columns)
+    : PhysicalOperator(PhysicalOperatorType::kTableScan,
+                       GetScanTypes(data_table, columns)),
+      table(data_table),
+      table_name(std::move(name)),
+      column_ids(std::move(columns)) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalTableScan::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalTableScanState>(*this, profiler);
+}
+
+std::string PhysicalTableScan::ParamsToString() const {
+  std::string result = table_name;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    result += i == 0 ? " " : ", ";
+    result += column_ids[i] == DataTable::kRowIdColumn
+                  ? "rowid"
+                  : std::to_string(column_ids[i]);
+  }
+  return result;
+}
+
+void PhysicalTableScan::GetChunkInternal(DataChunk& chunk,
+                                         PhysicalOperatorState* state) {
+  auto scan_state = static_cast<PhysicalTableScanState*>(state);
+  // skip the chunks all of whose rows are deleted
+  size_t live_count = 0;
+  bool has_deletes  = true;
+  while (has_deletes && live_count == 0) {
+    if (scan_state->chunk_index >= table.GetChunkCount()) {
+      scan_state->chunk.reset();
+      return;
+    }
+    scan_state->chunk = table.GetChunk(scan_state->chunk_index);
+    has_deletes       = table.GetLiveRows(scan_state->chunk_index,
+                                          *scan_state->chunk,
+                                          scan_state->selection, live_count);
+    scan_state->chunk_index++;
+  }
+  auto chunk_index = scan_state->chunk_index - 1;
+  auto& source     = *scan_state->chunk;
+  auto row_start   = chunk_index * kStandardVectorSize;
+  auto row_ids     = scan_state->row_ids;
+  auto selection   = scan_state->selection;
+  // the vectors reference the table, unless rows are deleted and the
+  // consumer does not allow a selection: the rows are copied then
+  bool copy = has_deletes && !chunk.AllowsSelection();
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    auto& vector = chunk.GetVector(i);
+    if (column_ids[i] != DataTable::kRowIdColumn) {
+      if (copy) {
+        vector.AppendSelection(source.GetVector(column_ids[i]), selection,
+                               live_count);
+      } else {
+        vector.Reference(source.GetVector(column_ids[i]));
+      }
+      continue;
+    }
+    if (copy) {
+      auto data = vector.GetData<int64_t>();
+      for (size_t row = 0; row < live_count; row++) {
+        data[row] = static_cast<int64_t>(row_start + selection[row]);
+      }
+      vector.SetCount(live_count);
+      continue;
+    }
+    for (size_t row = 0; row < source.GetCount(); row++) {
+      row_ids[row] = row_start + row;
+    }
+    vector.Reference(TypeId::kBigInt, reinterpret_cast<char*>(row_ids),
+                     source.GetCount());
+  }
+  if (has_deletes && !copy) {
+    chunk.SetSelection(selection, live_count);
+  }
+}
+
+}  // namespace zoomdb
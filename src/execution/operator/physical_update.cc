@@ -0,0 +1,57 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_update.hpp"
+
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+PhysicalUpdate::PhysicalUpdate(DataTable& data_table,
+                               std::vector<size_t> columns)
+    : PhysicalOperator(PhysicalOperatorType::kUpdate, {TypeId::kBigInt}),
+      table(data_table),
+      column_ids(std::move(columns)) {}
+
+std::string PhysicalUpdate::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    result += (i == 0 ? "" : ", ") + std::to_string(column_ids[i]);
+  }
+  return result;
+}
+
+void PhysicalUpdate::GetChunkInternal(DataChunk& chunk,
+                                      PhysicalOperatorState* state) {
+  auto& child_types = children[0]->types;
+  DataChunk values;
+  values.Initialize(
+      std::vector<TypeId>(child_types.begin() + 1, child_types.end()));
+  int64_t count = 0;
+  auto& input   = state->child_chunk;
+  while (true) {
+    children[0]->GetChunk(input, state->child_state.get());
+    if (input.GetCount() == 0) {
+      break;
+    }
+    // the new values may reference the table, e.g. SET a = b, b = a: they
+    // are copied before any of them is written
+    values.Reset();
+    for (size_t i = 0; i < column_ids.size(); i++) {
+      values.GetVector(i).Append(input.GetVector(i + 1));
+    }
+    auto row_ids = input.GetVector(0).GetData<uint64_t>();
+    table.Update(row_ids, column_ids, values);
+    count += static_cast<int64_t>(input.GetCount());
+  }
+
+  chunk.GetVector(0).SetCount(1);
+  chunk.SetValue(0, 0, Value::BigInt(count));
+  state->finished = true;
+}
+
+}  // namespace zoomdb
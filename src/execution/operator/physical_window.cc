@@ -0,0 +1,761 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/operator/physical_window.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <thread>
+
+#include "common/exception.hpp"
+#include "common/parallel.hpp"
+#include "common/types/chunk_collection.hpp"
+#include "execution/expression_executor.hpp"
+#include "parser/expression/window_expression.hpp"
+#include "storage/index.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+constexpr size_t kNoColumn = std::numeric_limits<size_t>::max();
+
+/**
+ * The entries of a column for all rows of the input, in input order. Only
+ * the array of the type of the column is used: integers for the integral
+ * types, decimals for DECIMAL and strings for VARCHAR.
+ */
+struct WindowColumn {
+  void Initialize(TypeId column_type, size_t count) {
+    type = column_type;
+    valid.assign(count, 0);
+    if (type == TypeId::kDecimal) {
+      decimals.resize(count);
+    } else if (type == TypeId::kVarChar) {
+      strings.resize(count);
+    } else {
+      integers.resize(count);
+    }
+  }
+
+  TypeId type = TypeId::kInvalid;
+  std::vector<int64_t> integers;
+  std::vector<double> decimals;
+  std::vector<const char*> strings;
+  /**
+   * Whether an entry is not NULL, a byte per row so that rows can be
+   * written by different threads.
+   */
+  std::vector<uint8_t> valid;
+};
+
+void ReadColumn(const ChunkCollection& collection, size_t column,
+                WindowColumn& result) {
+  result.Initialize(collection.GetTypes()[column], collection.GetCount());
+  size_t row = 0;
+  for (size_t i = 0; i < collection.ChunkCount(); i++) {
+    auto& vector = collection.GetChunk(i).GetVector(column);
+    for (size_t j = 0; j < vector.GetCount(); j++, row++) {
+      if (vector.IsNull(j)) {
+        continue;
+      }
+      result.valid[row] = 1;
+      switch (result.type) {
+        case TypeId::kBoolean:
+        case TypeId::kTinyInt:
+          result.integers[row] = vector.GetData<int8_t>()[j];
+          break;
+        case TypeId::kSmallInt:
+          result.integers[row] = vector.GetData<int16_t>()[j];
+          break;
+        case TypeId::kInteger:
+        case TypeId::kDate:
+          result.integers[row] = vector.GetData<int32_t>()[j];
+          break;
+        case TypeId::kBigInt:
+        case TypeId::kTimestamp:
+          result.integers[row] = vector.GetData<int64_t>()[j];
+          break;
+        case TypeId::kDecimal:
+          result.decimals[row] = vector.GetData<double>()[j];
+          break;
+        case TypeId::kVarChar:
+          result.strings[row] = vector.GetData<const char*>()[j];
+          break;
+        default:
+          throw NotImplementationException(
+              "Unsupported type %s in a window function",
+              TypeIdToString(result.type).c_str());
+      }
+    }
+  }
+}
+
+/**
+ * Write count entries of the column, starting at row offset, into result.
+ */
+void WriteColumn(const WindowColumn& column, size_t offset, size_t count,
+                 Vector& result) {
+  for (size_t i = 0; i < count; i++) {
+    auto row = offset + i;
+    result.SetNull(i, !column.valid[row]);
+    if (!column.valid[row]) {
+      continue;
+    }
+    switch (result.GetType()) {
+      case TypeId::kBoolean:
+      case TypeId::kTinyInt:
+        result.GetData<int8_t>()[i] =
+            static_cast<int8_t>(column.integers[row]);
+        break;
+      case TypeId::kSmallInt:
+        result.GetData<int16_t>()[i] =
+            static_cast<int16_t>(column.integers[row]);
+        break;
+      case TypeId::kInteger:
+      case TypeId::kDate:
+        result.GetData<int32_t>()[i] =
+            static_cast<int32_t>(column.integers[row]);
+        break;
+      case TypeId::kDecimal:
+        result.GetData<double>()[i] = column.decimals[row];
+        break;
+      case TypeId::kVarChar:
+        result.GetData<const char*>()[i] = column.strings[row];
+        break;
+      default:
+        result.GetData<int64_t>()[i] = column.integers[row];
+        break;
+    }
+  }
+  result.SetCount(count);
+}
+
+/**
+ * The aggregates as associative operations on a State: Combine merges the
+ * states of two ranges of rows, Identity is the state of no rows.
+ */
+struct CountOp {
+  using State = int64_t;
+  static State Identity() { return 0; }
+  static State Combine(State left, State right) { return left + right; }
+};
+
+template <class T>
+struct SumState {
+  T sum;
+  int64_t count;
+};
+
+template <class T>
+struct SumOp {
+  using State = SumState<T>;
+  static State Identity() { return {0, 0}; }
+  static State Combine(const State& left, const State& right) {
+    return {left.sum + right.sum, left.count + right.count};
+  }
+};
+
+template <class T>
+struct MinMaxState {
+  T value;
+  bool valid;
+};
+
+template <class T>
+bool Less(T left, T right) {
+  return left < right;
+}
+
+bool Less(const char* left, const char* right) {
+  return std::strcmp(left, right) < 0;
+}
+
+template <class T, bool kMax>
+struct MinMaxOp {
+  using State = MinMaxState<T>;
+  static State Identity() { return {T(), false}; }
+  static State Combine(const State& left, const State& right) {
+    if (!left.valid) {
+      return right;
+    }
+    if (!right.valid) {
+      return left;
+    }
+    return Less(left.value, right.value) != kMax ? left : right;
+  }
+};
+
+/**
+ * An iterative segment tree over the rows of a partition: node i combines
+ * nodes 2i and 2i + 1, the leaves are nodes count ... 2 count - 1.
+ */
+template <class Op>
+class SegmentTree {
+ public:
+  using State = typename Op::State;
+
+  explicit SegmentTree(std::vector<State>& nodes) : nodes_(nodes), count_(0) {}
+
+  /**
+   * Build the tree over count rows, leaf(i) returns the state of row i.
+   */
+  template <class Leaf>
+  void Build(size_t count, Leaf leaf) {
+    count_ = count;
+    nodes_.resize(2 * count);
+    for (size_t i = 0; i < count; i++) {
+      nodes_[count + i] = leaf(i);
+    }
+    for (size_t i = count - 1; i > 0; i--) {
+      nodes_[i] = Op::Combine(nodes_[2 * i], nodes_[2 * i + 1]);
+    }
+  }
+
+  /**
+   * Returns the state of the rows begin ... end - 1.
+   */
+  State Query(size_t begin, size_t end) const {
+    auto left  = Op::Identity();
+    auto right = Op::Identity();
+    for (begin += count_, end += count_; begin < end; begin /= 2, end /= 2) {
+      if (begin % 2 == 1) {
+        left = Op::Combine(left, nodes_[begin++]);
+      }
+      if (end % 2 == 1) {
+        right = Op::Combine(nodes_[--end], right);
+      }
+    }
+    return Op::Combine(left, right);
+  }
+
+ private:
+  std::vector<State>& nodes_;
+  size_t count_;
+};
+
+/**
+ * The nodes of the segment trees, reused for the partitions of a bucket.
+ */
+struct WindowScratch {
+  std::vector<int64_t> counts;
+  std::vector<SumState<__int128>> integer_sums;
+  std::vector<SumState<double>> decimal_sums;
+  std::vector<MinMaxState<int64_t>> integer_bounds;
+  std::vector<MinMaxState<double>> decimal_bounds;
+  std::vector<MinMaxState<const char*>> string_bounds;
+};
+
+/**
+ * The rows of a partition in sort order, as positions in the input. Rows
+ * with equal orders are peers; peer_begin and peer_end hold the range of
+ * the peers of every row, if a RANGE frame needs them.
+ */
+struct WindowPartition {
+  const size_t* rows;
+  size_t count;
+  const size_t* peer_begin;
+  const size_t* peer_end;
+};
+
+size_t Preceding(size_t row, int64_t offset) {
+  auto rows = static_cast<uint64_t>(offset);
+  return row > rows ? row - rows : 0;
+}
+
+size_t Following(size_t row, int64_t offset, size_t count) {
+  auto rows = static_cast<uint64_t>(offset);
+  return count - row > rows ? row + rows : count;
+}
+
+/**
+ * Compute the frame begin ... end - 1 of row i of the partition, the frame
+ * is empty if end <= begin.
+ */
+void GetFrame(const WindowExpression& window,
+              const WindowPartition& partition, size_t i, size_t& begin,
+              size_t& end) {
+  auto count = partition.count;
+  switch (window.start) {
+    case WindowBoundary::kUnboundedPreceding:
+      begin = 0;
+      break;
+    case WindowBoundary::kOffsetPreceding:
+      begin = Preceding(i, window.start_offset);
+      break;
+    case WindowBoundary::kCurrentRow:
+      begin = window.rows ? i : partition.peer_begin[i];
+      break;
+    case WindowBoundary::kOffsetFollowing:
+      begin = Following(i, window.start_offset, count);
+      break;
+    case WindowBoundary::kUnboundedFollowing:
+      begin = count;
+      break;
+  }
+  switch (window.end) {
+    case WindowBoundary::kUnboundedPreceding:
+      end = 0;
+      break;
+    case WindowBoundary::kOffsetPreceding:
+      end = i >= static_cast<uint64_t>(window.end_offset)
+                ? Preceding(i, window.end_offset) + 1
+                : 0;
+      break;
+    case WindowBoundary::kCurrentRow:
+      end = window.rows ? i + 1 : partition.peer_end[i];
+      break;
+    case WindowBoundary::kOffsetFollowing:
+      end = Following(i, window.end_offset, count - 1) + 1;
+      break;
+    case WindowBoundary::kUnboundedFollowing:
+      end = count;
+      break;
+  }
+}
+
+/**
+ * Aggregate the frame of every row of the partition with a segment tree:
+ * leaf(row) returns the state of an input row, store(row, state) receives
+ * the state of its frame.
+ */
+template <class Op, class Leaf, class Store>
+void AggregateFrames(const WindowExpression& window,
+                     const WindowPartition& partition,
+                     std::vector<typename Op::State>& nodes, Leaf leaf,
+                     Store store) {
+  SegmentTree<Op> tree(nodes);
+  tree.Build(partition.count,
+             [&](size_t i) { return leaf(partition.rows[i]); });
+  for (size_t i = 0; i < partition.count; i++) {
+    size_t begin;
+    size_t end;
+    GetFrame(window, partition, i, begin, end);
+    store(partition.rows[i],
+          begin < end ? tree.Query(begin, end) : Op::Identity());
+  }
+}
+
+template <class T>
+void ComputeMinMax(const WindowExpression& window,
+                   const WindowPartition& partition, bool is_max,
+                   const std::vector<T>& values,
+                   const std::vector<uint8_t>& valid,
+                   std::vector<MinMaxState<T>>& nodes,
+                   std::vector<T>& result, std::vector<uint8_t>& result_valid) {
+  auto leaf = [&](size_t row) {
+    return MinMaxState<T>{valid[row] ? values[row] : T(), valid[row] != 0};
+  };
+  auto store = [&](size_t row, const MinMaxState<T>& state) {
+    result[row]       = state.value;
+    result_valid[row] = state.valid;
+  };
+  if (is_max) {
+    AggregateFrames<MinMaxOp<T, true>>(window, partition, nodes, leaf, store);
+  } else {
+    AggregateFrames<MinMaxOp<T, false>>(window, partition, nodes, leaf, store);
+  }
+}
+
+/**
+ * Compute the window function for the rows of a partition into result.
+ */
+void ComputePartition(const WindowExpression& window,
+                      const WindowColumn* argument,
+                      const WindowPartition& partition, WindowScratch& scratch,
+                      WindowColumn& result) {
+  auto& function = window.GetFunction();
+  switch (function.type) {
+    case ExpressionType::kAggregateCountStar:
+      for (size_t i = 0; i < partition.count; i++) {
+        size_t begin;
+        size_t end;
+        GetFrame(window, partition, i, begin, end);
+        auto row             = partition.rows[i];
+        result.integers[row] = begin < end ? static_cast<int64_t>(end - begin)
+                                           : 0;
+        result.valid[row]    = 1;
+      }
+      break;
+    case ExpressionType::kAggregateCount:
+      AggregateFrames<CountOp>(
+          window, partition, scratch.counts,
+          [&](size_t row) {
+            return static_cast<int64_t>(argument->valid[row]);
+          },
+          [&](size_t row, int64_t count) {
+            result.integers[row] = count;
+            result.valid[row]    = 1;
+          });
+      break;
+    case ExpressionType::kAggregateSum:
+      if (result.type == TypeId::kDecimal) {
+        AggregateFrames<SumOp<double>>(
+            window, partition, scratch.decimal_sums,
+            [&](size_t row) {
+              return SumState<double>{
+                  argument->valid[row] ? argument->decimals[row] : 0,
+                  argument->valid[row]};
+            },
+            [&](size_t row, const SumState<double>& state) {
+              result.decimals[row] = state.sum;
+              result.valid[row]    = state.count > 0;
+            });
+        break;
+      }
+      // the sums of the nodes may exceed BIGINT even if no frame does
+      AggregateFrames<SumOp<__int128>>(
+          window, partition, scratch.integer_sums,
+          [&](size_t row) {
+            return SumState<__int128>{
+                argument->valid[row] ? argument->integers[row] : 0,
+                argument->valid[row]};
+          },
+          [&](size_t row, const SumState<__int128>& state) {
+            if (state.sum > std::numeric_limits<int64_t>::max() ||
+                state.sum < std::numeric_limits<int64_t>::min()) {
+              throw NumericValueOutOfRangeException(
+                  "Overflow in SUM",
+                  NumericValueOutOfRangeException::kOverflow);
+            }
+            result.integers[row] = static_cast<int64_t>(state.sum);
+            result.valid[row]    = state.count > 0;
+          });
+      break;
+    case ExpressionType::kAggregateAvg:
+      AggregateFrames<SumOp<double>>(
+          window, partition, scratch.decimal_sums,
+          [&](size_t row) {
+            if (!argument->valid[row]) {
+              return SumState<double>{0, 0};
+            }
+            return SumState<double>{
+                argument->type == TypeId::kDecimal
+                    ? argument->decimals[row]
+                    : static_cast<double>(argument->integers[row]),
+                1};
+          },
+          [&](size_t row, const SumState<double>& state) {
+            result.decimals[row] =
+                state.count > 0 ? state.sum / static_cast<double>(state.count)
+                                : 0;
+            result.valid[row] = state.count > 0;
+          });
+      break;
+    case ExpressionType::kAggregateMin:
+    case ExpressionType::kAggregateMax: {
+      auto is_max = function.type == ExpressionType::kAggregateMax;
+      if (argument->type == TypeId::kDecimal) {
+        ComputeMinMax(window, partition, is_max, argument->decimals,
+                      argument->valid, scratch.decimal_bounds,
+                      result.decimals, result.valid);
+      } else if (argument->type == TypeId::kVarChar) {
+        ComputeMinMax(window, partition, is_max, argument->strings,
+                      argument->valid, scratch.string_bounds, result.strings,
+                      result.valid);
+      } else {
+        ComputeMinMax(window, partition, is_max, argument->integers,
+                      argument->valid, scratch.integer_bounds,
+                      result.integers, result.valid);
+      }
+      break;
+    }
+    default:
+      throw NotImplementationException(
+          "Unsupported window function %s",
+          ExpressionTypeToString(function.type).c_str());
+  }
+}
+
+/**
+ * The sort keys of the rows: the encoded partitions followed by the
+ * encoded orders, concatenated in one buffer.
+ */
+struct SortKeys {
+  std::string_view Key(size_t row) const {
+    return std::string_view(
+        reinterpret_cast<const char*>(data.data()) + offsets[row],
+        offsets[row + 1] - offsets[row]);
+  }
+  std::string_view PartitionKey(size_t row) const {
+    return Key(row).substr(0, partition_ends[row] - offsets[row]);
+  }
+
+  std::vector<uint8_t> data;
+  std::vector<size_t> offsets;
+  std::vector<size_t> partition_ends;
+};
+
+/**
+ * Append the sort key of an entry: a byte that orders NULL before or after
+ * the other entries, followed by the encoding of the value, with all bits
+ * inverted for a descending order.
+ */
+void EncodeSortKey(const Vector& vector, size_t index, const WindowOrder& order,
+                   std::vector<uint8_t>& key) {
+  auto is_null = vector.IsNull(index);
+  key.push_back(is_null != order.nulls_first ? 1 : 0);
+  if (is_null) {
+    return;
+  }
+  auto start = key.size();
+  Index::EncodeValue(vector, index, key);
+  if (order.descending) {
+    for (auto i = start; i < key.size(); i++) {
+      key[i] = static_cast<uint8_t>(~key[i]);
+    }
+  }
+}
+
+/**
+ * Encode the sort keys of the count rows of the input, whose partitions
+ * and orders are stored in the columns starting at first_column.
+ */
+void EncodeSortKeys(const ChunkCollection& inputs, size_t count,
+                    size_t first_column, const WindowExpression& window,
+                    SortKeys& keys) {
+  keys.offsets.assign(1, 0);
+  keys.partition_ends.clear();
+  if (window.children.size() == 1) {
+    // all rows form one partition of peers
+    keys.offsets.resize(count + 1, 0);
+    keys.partition_ends.resize(count, 0);
+    return;
+  }
+  static const WindowOrder kPartitionOrder = {false, false};
+  for (size_t i = 0; i < inputs.ChunkCount(); i++) {
+    auto& chunk = inputs.GetChunk(i);
+    for (size_t row = 0; row < chunk.GetCount(); row++) {
+      for (size_t j = 0; j < window.partition_count; j++) {
+        EncodeSortKey(chunk.GetVector(first_column + j), row,
+                      kPartitionOrder, keys.data);
+      }
+      keys.partition_ends.push_back(keys.data.size());
+      for (size_t j = 0; j < window.orders.size(); j++) {
+        EncodeSortKey(
+            chunk.GetVector(first_column + window.partition_count + j), row,
+            window.orders[j], keys.data);
+      }
+      keys.offsets.push_back(keys.data.size());
+    }
+  }
+}
+
+class PhysicalWindowState : public PhysicalOperatorState {
+ public:
+  PhysicalWindowState(const PhysicalOperator& op, PhysicalOperator* child,
+                      QueryProfiler* query_profiler)
+      : PhysicalOperatorState(op, child, query_profiler),
+        computed(false),
+        position(0) {}
+
+  /**
+   * The rows of the child, and the partitions, orders and arguments of the
+   * window functions evaluated for them.
+   */
+  ChunkCollection rows;
+  ChunkCollection inputs;
+  /**
+   * The result of every window function.
+   */
+  std::vector<WindowColumn> results;
+  bool computed;
+  size_t position;
+};
+
+}  // namespace
+
+PhysicalWindow::PhysicalWindow(std::vector<TypeId> result_types,
+                               std::vector<std::unique_ptr<Expression>> windows)
+    : PhysicalOperator(PhysicalOperatorType::kWindow, std::move(result_types)),
+      expressions(std::move(windows)) {}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalWindow::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalWindowState>(*this, children[0].get(),
+                                               profiler);
+}
+
+std::string PhysicalWindow::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result += (i == 0 ? "" : ", ") + expressions[i]->ToString();
+  }
+  return result;
+}
+
+void PhysicalWindow::GetChunkInternal(DataChunk& chunk,
+                                      PhysicalOperatorState* state) {
+  auto window_state = static_cast<PhysicalWindowState*>(state);
+  if (!window_state->computed) {
+    Compute(*window_state);
+    window_state->computed = true;
+  }
+  auto& rows = window_state->rows;
+  if (window_state->position >= rows.ChunkCount()) {
+    return;
+  }
+  auto index  = window_state->position++;
+  auto& input = rows.GetChunk(index);
+  auto count  = input.GetCount();
+  for (size_t i = 0; i < input.ColumnCount(); i++) {
+    chunk.GetVector(i).Reference(input.GetVector(i));
+  }
+  for (size_t i = 0; i < expressions.size(); i++) {
+    WriteColumn(window_state->results[i], index * kStandardVectorSize, count,
+                chunk.GetVector(input.ColumnCount() + i));
+  }
+}
+
+void PhysicalWindow::Compute(PhysicalOperatorState& state) {
+  auto& window_state = static_cast<PhysicalWindowState&>(state);
+
+  // the inputs of every window: its argument (if any), its partitions and
+  // its orders
+  std::vector<Expression*> inputs;
+  std::vector<size_t> argument_columns;
+  std::vector<size_t> sort_columns;
+  for (auto& expr : expressions) {
+    auto& function = static_cast<WindowExpression&>(*expr).GetFunction();
+    argument_columns.push_back(function.children.empty() ? kNoColumn
+                                                         : inputs.size());
+    if (!function.children.empty()) {
+      inputs.push_back(function.children[0].get());
+    }
+    sort_columns.push_back(inputs.size());
+    for (size_t i = 1; i < expr->children.size(); i++) {
+      inputs.push_back(expr->children[i].get());
+    }
+  }
+  std::vector<TypeId> input_types;
+  for (auto input : inputs) {
+    input_types.push_back(input->return_type);
+  }
+  DataChunk evaluated;
+  evaluated.Initialize(input_types);
+  while (true) {
+    children[0]->GetChunk(state.child_chunk, state.child_state.get());
+    auto& chunk = state.child_chunk;
+    if (chunk.GetCount() == 0) {
+      break;
+    }
+    window_state.rows.Append(chunk);
+    if (!inputs.empty()) {
+      evaluated.Reset();
+      ExpressionExecutor executor(&chunk);
+      for (size_t i = 0; i < inputs.size(); i++) {
+        executor.ExecuteExpression(*inputs[i], evaluated.GetVector(i));
+      }
+      window_state.inputs.Append(evaluated);
+    }
+  }
+
+  auto count = window_state.rows.GetCount();
+  window_state.results.resize(expressions.size());
+  std::vector<WindowColumn> arguments(expressions.size());
+  for (size_t i = 0; i < expressions.size(); i++) {
+    window_state.results[i].Initialize(expressions[i]->return_type, count);
+    if (count > 0 && argument_columns[i] != kNoColumn) {
+      ReadColumn(window_state.inputs, argument_columns[i], arguments[i]);
+    }
+  }
+  if (count == 0) {
+    return;
+  }
+
+  // the windows that partition and order alike share a sort
+  auto thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  std::vector<bool> computed(expressions.size(), false);
+  for (size_t first = 0; first < expressions.size(); first++) {
+    if (computed[first]) {
+      continue;
+    }
+    auto& window = static_cast<WindowExpression&>(*expressions[first]);
+    std::vector<size_t> group;
+    bool need_peers = false;
+    for (size_t i = first; i < expressions.size(); i++) {
+      auto& other = static_cast<WindowExpression&>(*expressions[i]);
+      if (!computed[i] && window.SameOrdering(other)) {
+        computed[i] = true;
+        group.push_back(i);
+        need_peers  = need_peers || !other.rows;
+      }
+    }
+
+    SortKeys keys;
+    EncodeSortKeys(window_state.inputs, count, sort_columns[first], window,
+                   keys);
+    auto bucket_count =
+        window.partition_count == 0 ? 1 : std::min(4 * thread_count, count);
+    std::vector<std::vector<size_t>> buckets(bucket_count);
+    std::hash<std::string_view> hash;
+    for (size_t row = 0; row < count; row++) {
+      buckets[hash(keys.PartitionKey(row)) % bucket_count].push_back(row);
+    }
+
+    std::vector<std::exception_ptr> errors(bucket_count);
+    ParallelFor(bucket_count, thread_count, [&](size_t b) {
+      try {
+        auto& rows = buckets[b];
+        std::sort(rows.begin(), rows.end(), [&](size_t left, size_t right) {
+          auto compare = keys.Key(left).compare(keys.Key(right));
+          return compare < 0 || (compare == 0 && left < right);
+        });
+        WindowScratch scratch;
+        std::vector<size_t> peer_begin;
+        std::vector<size_t> peer_end;
+        for (size_t start = 0; start < rows.size();) {
+          auto partition_key = keys.PartitionKey(rows[start]);
+          auto end           = start + 1;
+          while (end < rows.size() &&
+                 keys.PartitionKey(rows[end]) == partition_key) {
+            end++;
+          }
+          WindowPartition partition{rows.data() + start, end - start, nullptr,
+                                    nullptr};
+          if (need_peers) {
+            auto size = partition.count;
+            peer_begin.resize(size);
+            peer_end.resize(size);
+            for (size_t i = 0; i < size; i++) {
+              auto peer = i > 0 && keys.Key(partition.rows[i]) ==
+                                       keys.Key(partition.rows[i - 1]);
+              peer_begin[i] = peer ? peer_begin[i - 1] : i;
+            }
+            for (size_t i = size; i > 0; i--) {
+              auto peer = i < size && keys.Key(partition.rows[i - 1]) ==
+                                          keys.Key(partition.rows[i]);
+              peer_end[i - 1] = peer ? peer_end[i] : i;
+            }
+            partition.peer_begin = peer_begin.data();
+            partition.peer_end   = peer_end.data();
+          }
+          for (auto i : group) {
+            ComputePartition(
+                static_cast<WindowExpression&>(*expressions[i]),
+                argument_columns[i] == kNoColumn ? nullptr : &arguments[i],
+                partition, scratch, window_state.results[i]);
+          }
+          start = end;
+        }
+      } catch (...) {
+        errors[b] = std::current_exception();
+      }
+    });
+    for (auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+}
+
+}  // namespace zoomdb
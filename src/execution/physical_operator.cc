@@ -0,0 +1,123 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/physical_operator.hpp"
+
+#include "common/string_util.hpp"
+
+namespace zoomdb {
+
+std::string PhysicalOperatorTypeToString(PhysicalOperatorType type) {
+  switch (type) {
+    case PhysicalOperatorType::kTableScan:
+      return "TABLE_SCAN";
+    case PhysicalOperatorType::kFilter:
+      return "FILTER";
+    case PhysicalOperatorType::kProjection:
+      return "PROJECTION";
+    case PhysicalOperatorType::kHashAggregate:
+      return "HASH_AGGREGATE";
+    case PhysicalOperatorType::kHashJoin:
+      return "HASH_JOIN";
+    case PhysicalOperatorType::kCrossProduct:
+      return "CROSS_PRODUCT";
+    case PhysicalOperatorType::kCopyFromFile:
+      return "COPY_FROM_FILE";
+    case PhysicalOperatorType::kCopyToFile:
+      return "COPY_TO_FILE";
+    case PhysicalOperatorType::kParquetScan:
+      return "PARQUET_SCAN";
+    case PhysicalOperatorType::kIndexScan:
+      return "INDEX_SCAN";
+    case PhysicalOperatorType::kInsert:
+      return "INSERT";
+    case PhysicalOperatorType::kUpdate:
+      return "UPDATE";
+    case PhysicalOperatorType::kDelete:
+      return "DELETE";
+    case PhysicalOperatorType::kWindow:
+      return "WINDOW";
+    case PhysicalOperatorType::kHashDistinct:
+      return "HASH_DISTINCT";
+    default:
+      return "INVALID";
+  }
+}
+
+PhysicalOperatorState::PhysicalOperatorState(const PhysicalOperator& op,
+                                             PhysicalOperator* child,
+                                             QueryProfiler* query_profiler)
+    : finished(false), profiler(query_profiler), op_(op) {
+  if (child) {
+    child_chunk.Initialize(child->types);
+    child_state = child->GetOperatorState(profiler);
+    metrics.bytes_allocated += child_chunk.GetAllocationSize();
+  }
+}
+
+PhysicalOperatorState::~PhysicalOperatorState() {
+  if (profiler) {
+    profiler->Flush(op_, metrics);
+  }
+}
+
+PhysicalOperator::PhysicalOperator(PhysicalOperatorType operator_type,
+                                   std::vector<TypeId> result_types)
+    : types(std::move(result_types)), type_(operator_type) {}
+
+void PhysicalOperator::GetChunk(DataChunk& chunk,
+                                PhysicalOperatorState* state) {
+  chunk.Reset();
+  if (state->finished) {
+    return;
+  }
+  if (state->profiler) {
+    auto start  = std::chrono::steady_clock::now();
+    auto cycles = QueryProfiler::ReadCycleCounter();
+    GetChunkInternal(chunk, state);
+    state->metrics.cycles += QueryProfiler::ReadCycleCounter() - cycles;
+    state->metrics.time_ns += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  } else {
+    GetChunkInternal(chunk, state);
+  }
+  state->metrics.rows_out += chunk.GetCount();
+  if (chunk.GetCount() == 0) {
+    state->finished = true;
+  }
+}
+
+std::unique_ptr<PhysicalOperatorState> PhysicalOperator::GetOperatorState(
+    QueryProfiler* profiler) {
+  return std::make_unique<PhysicalOperatorState>(
+      *this, children.empty() ? nullptr : children[0].get(), profiler);
+}
+
+std::string PhysicalOperator::ParamsToString() const {
+  return "";
+}
+
+std::string PhysicalOperator::GetName() const {
+  std::string result = PhysicalOperatorTypeToString(type_);
+  auto params        = ParamsToString();
+  if (!params.empty()) {
+    result += "[" + params + "]";
+  }
+  return result;
+}
+
+std::string PhysicalOperator::ToString() const {
+  std::string result = GetName();
+  for (auto& child : children) {
+    result += "\n" + StringUtil::Prefix(child->ToString(), "  ");
+  }
+  return result;
+}
+
+}  // namespace zoomdb
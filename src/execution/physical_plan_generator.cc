@@ -0,0 +1,221 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "execution/physical_plan_generator.hpp"
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+#include "common/exception.hpp"
+#include "execution/expression_kernels.hpp"
+#include "execution/operator/physical_copy_from_file.hpp"
+#include "execution/operator/physical_copy_to_file.hpp"
+#include "execution/operator/physical_cross_product.hpp"
+#include "execution/operator/physical_delete.hpp"
+#include "execution/operator/physical_filter.hpp"
+#include "execution/operator/physical_hash_aggregate.hpp"
+#include "execution/operator/physical_hash_distinct.hpp"
+#include "execution/operator/physical_hash_join.hpp"
+#include "execution/operator/physical_index_scan.hpp"
+#include "execution/operator/physical_insert.hpp"
+#include "execution/operator/physical_parquet_scan.hpp"
+#include "execution/operator/physical_projection.hpp"
+#include "execution/operator/physical_table_scan.hpp"
+#include "execution/operator/physical_update.hpp"
+#include "execution/operator/physical_window.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+#include "planner/operator/logical_aggregate.hpp"
+#include "planner/operator/logical_copy_from_file.hpp"
+#include "planner/operator/logical_copy_to_file.hpp"
+#include "planner/operator/logical_delete.hpp"
+#include "planner/operator/logical_get.hpp"
+#include "planner/operator/logical_index_scan.hpp"
+#include "planner/operator/logical_insert.hpp"
+#include "planner/operator/logical_join.hpp"
+#include "planner/operator/logical_parquet_scan.hpp"
+#include "planner/operator/logical_update.hpp"
+#include "planner/operator/logical_window.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+std::unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(
+    std::unique_ptr<LogicalOperator> op) {
+  op->ResolveOperatorTypes();
+  return CreateOperator(*op);
+}
+
+void PhysicalPlanGenerator::ResolveExpression(
+    Expression& expr, const std::vector<ColumnBinding>& bindings) {
+  if (expr.type == ExpressionType::kColumnRef) {
+    auto& ref = static_cast<ColumnRefExpression&>(expr);
+    for (size_t i = 0; i < bindings.size(); i++) {
+      if (bindings[i] == ref.binding) {
+        ref.index = i;
+        return;
+      }
+    }
+    if (ref.depth > 0 && ref.depth <= outer_.size()) {
+      ResolveOuterReference(ref);
+      return;
+    }
+    throw PlannerException("Column %s is not produced by the input",
+                           ref.ToString().c_str());
+  }
+  auto subquery = dynamic_cast<SubqueryExpression*>(&expr);
+  if (subquery && subquery->subquery) {
+    PhysicalPlanGenerator generator;
+    generator.outer_ = outer_;
+    generator.outer_.push_back({&bindings, subquery});
+    subquery->plan = generator.CreatePlan(std::move(subquery->subquery));
+  }
+  expr.EnumerateChildren(
+      [&](Expression& child) { ResolveExpression(child, bindings); });
+  if (!subquery && expr.children.size() == 2) {
+    expr.kernel = ExpressionKernels::Get(expr.type,
+                                         expr.children[0]->return_type,
+                                         expr.children[1]->return_type,
+                                         expr.return_type);
+  }
+}
+
+void PhysicalPlanGenerator::ResolveOuterReference(ColumnRefExpression& ref) {
+  auto& outer      = outer_[outer_.size() - ref.depth];
+  auto& correlated = outer.subquery->correlated;
+  size_t slot      = 0;
+  while (slot < correlated.size() &&
+         !(static_cast<ColumnRefExpression&>(*correlated[slot]).binding ==
+           ref.binding)) {
+    slot++;
+  }
+  if (slot == correlated.size()) {
+    // evaluated by the operator of the enclosing query
+    auto column = std::make_unique<ColumnRefExpression>(ref.return_type,
+                                                        ref.binding);
+    PhysicalPlanGenerator().ResolveExpression(*column, *outer.bindings);
+    correlated.push_back(std::move(column));
+  }
+  ref.index        = slot;
+  ref.outer_values = &outer.subquery->correlated_values;
+}
+
+void PhysicalPlanGenerator::ResolveExpressions(
+    std::vector<std::unique_ptr<Expression>>& list,
+    const std::vector<ColumnBinding>& bindings) {
+  for (auto& expr : list) {
+    ResolveExpression(*expr, bindings);
+  }
+}
+
+std::unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreateOperator(
+    LogicalOperator& op) {
+  std::vector<ColumnBinding> bindings;
+  if (!op.children.empty()) {
+    bindings = op.children[0]->GetColumnBindings();
+  }
+  std::unique_ptr<PhysicalOperator> result;
+  switch (op.GetType()) {
+    case LogicalOperatorType::kGet: {
+      auto& get = static_cast<LogicalGet&>(op);
+      return std::make_unique<PhysicalTableScan>(*get.table, get.table_name,
+                                                 get.column_ids);
+    }
+    case LogicalOperatorType::kIndexScan: {
+      auto& scan = static_cast<LogicalIndexScan&>(op);
+      return std::make_unique<PhysicalIndexScan>(
+          *scan.table, scan.table_name, scan.column_ids, scan.index,
+          scan.lower, scan.lower_inclusive, scan.upper, scan.upper_inclusive);
+    }
+    case LogicalOperatorType::kParquetScan: {
+      auto& scan = static_cast<LogicalParquetScan&>(op);
+      ResolveExpressions(scan.expressions, scan.GetColumnBindings());
+      return std::make_unique<PhysicalParquetScan>(
+          std::move(scan.reader), scan.column_ids, std::move(scan.expressions),
+          scan.prefetch_depth);
+    }
+    case LogicalOperatorType::kFilter:
+      ResolveExpressions(op.expressions, bindings);
+      result = std::make_unique<PhysicalFilter>(op.types,
+                                                std::move(op.expressions));
+      break;
+    case LogicalOperatorType::kProjection:
+      ResolveExpressions(op.expressions, bindings);
+      result = std::make_unique<PhysicalProjection>(op.types,
+                                                    std::move(op.expressions));
+      break;
+    case LogicalOperatorType::kAggregateAndGroupBy: {
+      auto& aggr = static_cast<LogicalAggregate&>(op);
+      ResolveExpressions(aggr.groups, bindings);
+      ResolveExpressions(aggr.expressions, bindings);
+      result = std::make_unique<PhysicalHashAggregate>(
+          op.types, std::move(aggr.expressions), std::move(aggr.groups));
+      break;
+    }
+    case LogicalOperatorType::kWindow:
+      ResolveExpressions(op.expressions, bindings);
+      result = std::make_unique<PhysicalWindow>(op.types,
+                                                std::move(op.expressions));
+      break;
+    case LogicalOperatorType::kDistinct:
+      result = std::make_unique<PhysicalHashDistinct>(op.types);
+      break;
+    case LogicalOperatorType::kJoin: {
+      auto& join          = static_cast<LogicalJoin&>(op);
+      auto right_bindings = op.children[1]->GetColumnBindings();
+      for (auto& cond : join.conditions) {
+        ResolveExpression(*cond.left, bindings);
+        ResolveExpression(*cond.right, right_bindings);
+      }
+      return std::make_unique<PhysicalHashJoin>(
+          op.types, join.join_type, std::move(join.conditions),
+          CreateOperator(*op.children[0]), CreateOperator(*op.children[1]));
+    }
+    case LogicalOperatorType::kCrossProduct:
+      return std::make_unique<PhysicalCrossProduct>(
+          op.types, CreateOperator(*op.children[0]),
+          CreateOperator(*op.children[1]));
+    case LogicalOperatorType::kInsert: {
+      auto& insert = static_cast<LogicalInsert&>(op);
+      for (auto& row : insert.insert_values) {
+        ResolveExpressions(row, bindings);
+      }
+      result = std::make_unique<PhysicalInsert>(
+          *insert.table->storage, insert.column_ids,
+          std::move(insert.insert_values));
+      break;
+    }
+    case LogicalOperatorType::kUpdate: {
+      auto& update = static_cast<LogicalUpdate&>(op);
+      result = std::make_unique<PhysicalUpdate>(*update.table->storage,
+                                                update.column_ids);
+      break;
+    }
+    case LogicalOperatorType::kDelete:
+      result = std::make_unique<PhysicalDelete>(
+          *static_cast<LogicalDelete&>(op).table->storage);
+      break;
+    case LogicalOperatorType::kCopyFromFile: {
+      auto& copy = static_cast<LogicalCopyFromFile&>(op);
+      return std::make_unique<PhysicalCopyFromFile>(*copy.table->storage,
+                                                    copy.info);
+    }
+    case LogicalOperatorType::kCopyToFile: {
+      auto& copy = static_cast<LogicalCopyToFile&>(op);
+      return std::make_unique<PhysicalCopyToFile>(
+          copy.info, copy.names, CreateOperator(*op.children[0]));
+    }
+    default:
+      throw NotImplementationException(
+          "Unsupported logical operator %s",
+          LogicalOperatorTypeToString(op.GetType()).c_str());
+  }
+  for (auto& child : op.children) {
+    result->children.push_back(CreateOperator(*child));
+  }
+  return result;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,175 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_entry/function_catalog_entry.hpp"
+#include "catalog/catalog_entry/index_catalog_entry.hpp"
+#include "catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+#include "catalog/catalog_set.hpp"
+
+namespace zoomdb {
+
+/**
+ * The Catalog holds the schemas of a database and the tables, indexes and
+ * functions in them.
+ *
+ * Every DDL statement commits at a new timestamp, all entries it creates
+ * or drops become visible at once. Queries look up entries as of the
+ * timestamp at which they started, held by a CatalogSnapshot, so concurrent
+ * DDL never changes the objects a running query has bound. Lookups take no
+ * locks; DDL statements are serialized.
+ *
+ * The versions of an entry that no snapshot can see anymore are freed,
+ * along with the table data they own, by the DDL statement that follows or
+ * by the oldest snapshot when it ends.
+ */
+class Catalog {
+ public:
+  static constexpr const char* kDefaultSchema = "main";
+
+  /**
+   * Create a catalog with the default schema and the built-in functions.
+   */
+  Catalog();
+
+  /**
+   * Returns the timestamp of the last committed DDL statement.
+   */
+  uint64_t GetTimestamp() const {
+    return timestamp_.load(std::memory_order_acquire);
+  }
+
+  void CreateSchema(const std::string& name, bool if_not_exists = false);
+  /**
+   * Drop an empty schema.
+   */
+  void DropSchema(const std::string& name, bool if_exists = false);
+
+  /**
+   * Create a table, returns the existing table if it exists and
+   * if_not_exists is set.
+   */
+  TableCatalogEntry* CreateTable(const std::string& schema,
+                                 const std::string& name,
+                                 std::vector<ColumnDefinition> columns,
+                                 bool if_not_exists = false);
+  /**
+   * Drop a table and its indexes.
+   */
+  void DropTable(const std::string& schema, const std::string& name,
+                 bool if_exists = false);
+
+  /**
+   * Create an index over the columns of a table and fill it with the rows
+   * of the table.
+   */
+  IndexCatalogEntry* CreateIndex(const std::string& schema,
+                                 const std::string& name,
+                                 const std::string& table,
+                                 const std::vector<std::string>& columns,
+                                 bool unique, bool if_not_exists = false);
+  void DropIndex(const std::string& schema, const std::string& name,
+                 bool if_exists = false);
+
+  /**
+   * The lookups return the entry visible at the timestamp, and throw a
+   * CatalogException if there is none.
+   */
+  SchemaCatalogEntry* GetSchema(const std::string& name,
+                                uint64_t timestamp) const;
+  TableCatalogEntry* GetTable(const std::string& schema,
+                              const std::string& name,
+                              uint64_t timestamp) const;
+  IndexCatalogEntry* GetIndex(const std::string& schema,
+                              const std::string& name,
+                              uint64_t timestamp) const;
+  /**
+   * Look up a function in the schema, falling back to the built-in
+   * functions of the default schema.
+   */
+  FunctionCatalogEntry* GetFunction(const std::string& schema,
+                                    const std::string& name,
+                                    uint64_t timestamp) const;
+  /**
+   * Call the callback for every table of every schema visible at the
+   * timestamp.
+   */
+  void ScanTables(
+      uint64_t timestamp,
+      const std::function<void(TableCatalogEntry& table)>& callback) const;
+
+ private:
+  friend class CatalogSnapshot;
+
+  /**
+   * Register a snapshot at the current timestamp and return it.
+   */
+  uint64_t Pin();
+  void Unpin(uint64_t timestamp);
+  /**
+   * Free the versions older than the oldest snapshot, with ddl_lock_ held.
+   */
+  void Vacuum();
+
+  /**
+   * Returns the timestamp of a new DDL statement, with ddl_lock_ held.
+   */
+  uint64_t NextTimestamp() const {
+    return timestamp_.load(std::memory_order_relaxed) + 1;
+  }
+  /**
+   * Make the changes of the DDL statement visible.
+   */
+  void Commit(uint64_t timestamp) {
+    timestamp_.store(timestamp, std::memory_order_release);
+  }
+
+  CatalogSet schemas_;
+  std::atomic<uint64_t> timestamp_;
+  std::mutex ddl_lock_;
+  std::mutex snapshot_lock_;
+  /**
+   * The timestamps of the snapshots that exist.
+   */
+  std::multiset<uint64_t> snapshots_;
+  /**
+   * Set if the last Vacuum() left garbage behind.
+   */
+  std::atomic<bool> vacuum_pending_;
+};
+
+/**
+ * A CatalogSnapshot pins the catalog as of the timestamp at which it is
+ * created: the entries visible at the timestamp stay allocated as long as
+ * the snapshot exists. Every statement looks up the catalog through one.
+ */
+class CatalogSnapshot {
+ public:
+  explicit CatalogSnapshot(Catalog& catalog)
+      : catalog_(catalog), timestamp_(catalog.Pin()) {}
+  ~CatalogSnapshot() { catalog_.Unpin(timestamp_); }
+
+  CatalogSnapshot(const CatalogSnapshot&)            = delete;
+  CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+  uint64_t GetTimestamp() const { return timestamp_; }
+
+ private:
+  Catalog& catalog_;
+  uint64_t timestamp_;
+};
+
+}  // namespace zoomdb
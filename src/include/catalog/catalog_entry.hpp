@@ -0,0 +1,55 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace zoomdb {
+
+enum class CatalogType {
+  kInvalid  = 0,
+  kSchema   = 1,
+  kTable    = 2,
+  kIndex    = 3,
+  kFunction = 4,
+};
+
+std::string CatalogTypeToString(CatalogType type);
+
+/**
+ * A version of a named object of the catalog. Entries are immutable once
+ * they are added to a CatalogSet: creating, replacing or dropping an object
+ * adds a new version, which points to the previous one.
+ */
+class CatalogEntry {
+ public:
+  CatalogEntry(CatalogType entry_type, std::string entry_name);
+  virtual ~CatalogEntry() = default;
+
+  CatalogEntry(const CatalogEntry&)            = delete;
+  CatalogEntry& operator=(const CatalogEntry&) = delete;
+
+  CatalogType type;
+  std::string name;
+  /**
+   * The commit timestamp of the DDL statement that created this version.
+   * The version is visible to transactions that started at or after it.
+   */
+  uint64_t timestamp;
+  /**
+   * True if this version marks the object as dropped.
+   */
+  bool deleted;
+  /**
+   * The previous version of the object, nullptr for the first one.
+   */
+  CatalogEntry* older;
+};
+
+}  // namespace zoomdb
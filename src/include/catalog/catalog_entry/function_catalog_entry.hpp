@@ -0,0 +1,34 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "catalog/catalog_entry.hpp"
+#include "common/internal-types.hpp"
+
+namespace zoomdb {
+
+enum class FunctionType {
+  kScalar    = 0,
+  kAggregate = 1,
+  kTable     = 2,
+};
+
+/**
+ * A function that can be called by name. Built-in functions are evaluated
+ * by the expression of the given type.
+ */
+class FunctionCatalogEntry : public CatalogEntry {
+ public:
+  FunctionCatalogEntry(std::string function_name, FunctionType kind,
+                       ExpressionType expression);
+
+  FunctionType function_type;
+  ExpressionType expression_type;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,38 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "catalog/catalog_entry.hpp"
+
+namespace zoomdb {
+
+class Index;
+class TableCatalogEntry;
+
+/**
+ * An index of a table. The index itself belongs to the storage of the
+ * table until it is dropped. Then it belongs to the dropped entry, which is
+ * freed once no running statement can scan the index anymore.
+ */
+class IndexCatalogEntry : public CatalogEntry {
+ public:
+  IndexCatalogEntry(std::string index_name, TableCatalogEntry* indexed_table,
+                    Index* table_index);
+  ~IndexCatalogEntry() override;
+
+  TableCatalogEntry* table;
+  Index* index;
+  /**
+   * The index once it has been dropped from the table.
+   */
+  std::unique_ptr<Index> dropped;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,26 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "catalog/catalog_set.hpp"
+
+namespace zoomdb {
+
+/**
+ * A schema, the namespace of the tables, indexes and functions in it.
+ */
+class SchemaCatalogEntry : public CatalogEntry {
+ public:
+  explicit SchemaCatalogEntry(std::string schema_name);
+
+  CatalogSet tables;
+  CatalogSet indexes;
+  CatalogSet functions;
+};
+
+}  // namespace zoomdb
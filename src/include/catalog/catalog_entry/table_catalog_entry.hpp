@@ -0,0 +1,55 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_entry.hpp"
+#include "common/internal-types.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+class SchemaCatalogEntry;
+
+struct ColumnDefinition {
+  ColumnDefinition(std::string column_name, TypeId column_type)
+      : name(std::move(column_name)), type(column_type) {}
+
+  std::string name;
+  TypeId type;
+};
+
+/**
+ * A table, its columns and its storage.
+ */
+class TableCatalogEntry : public CatalogEntry {
+ public:
+  TableCatalogEntry(SchemaCatalogEntry* parent, std::string table_name,
+                    std::vector<ColumnDefinition> table_columns);
+  ~TableCatalogEntry() override;
+
+  bool ColumnExists(const std::string& column) const;
+  /**
+   * Returns the position of the column in the table, throws a
+   * CatalogException if the table has no such column.
+   */
+  size_t GetColumnIndex(const std::string& column) const;
+  std::vector<TypeId> GetTypes() const;
+
+  SchemaCatalogEntry* schema;
+  std::vector<ColumnDefinition> columns;
+  std::shared_ptr<DataTable> storage;
+
+ private:
+  std::unordered_map<std::string, size_t> name_map_;
+};
+
+}  // namespace zoomdb
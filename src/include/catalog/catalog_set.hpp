@@ -0,0 +1,138 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_entry.hpp"
+
+namespace zoomdb {
+
+/**
+ * A CatalogSet is a set of catalog entries with unique names, e.g. the
+ * tables of a schema.
+ *
+ * Every name maps to a chain of versions, newest first. A lookup returns
+ * the newest version whose timestamp is not after the timestamp of the
+ * reader, so a transaction sees the catalog as it was when it started.
+ *
+ * Lookups are lock free in the style of RCU: the buckets of the hash table
+ * are immutable, a writer copies the bucket it changes (and the bucket
+ * array when it grows) and publishes the copy with a single atomic store.
+ * Writers are serialized by a mutex. A version, bucket or bucket array that
+ * is replaced at a timestamp may still be read by readers that started
+ * before it, so it is kept as garbage until Vacuum() is told that no such
+ * reader is left.
+ */
+class CatalogSet {
+ public:
+  CatalogSet();
+  ~CatalogSet();
+
+  CatalogSet(const CatalogSet&)            = delete;
+  CatalogSet& operator=(const CatalogSet&) = delete;
+
+  /**
+   * Add the entry as the newest version of its name, visible from the
+   * timestamp on. Returns false, and adds nothing, if an entry with the
+   * name is visible at the timestamp.
+   */
+  bool CreateEntry(std::unique_ptr<CatalogEntry> entry, uint64_t timestamp);
+  /**
+   * Drop the entry with the name from the timestamp on. Returns false if no
+   * entry with the name is visible at the timestamp.
+   */
+  bool DropEntry(const std::string& name, uint64_t timestamp);
+
+  /**
+   * Returns the version of the entry visible at the timestamp, nullptr if
+   * there is none.
+   */
+  CatalogEntry* GetEntry(const std::string& name, uint64_t timestamp) const;
+  /**
+   * Call the callback for every entry visible at the timestamp.
+   */
+  void Scan(uint64_t timestamp,
+            const std::function<void(CatalogEntry& entry)>& callback) const;
+
+  /**
+   * Free the garbage that no reader can reach: oldest is the timestamp of
+   * the oldest reader, and timestamp the current timestamp of the catalog.
+   * The names whose entries were dropped before oldest are removed. If
+   * given, the callback is called for every version that remains. Returns
+   * true if garbage is left.
+   */
+  bool Vacuum(uint64_t oldest, uint64_t timestamp,
+              const std::function<void(CatalogEntry& entry)>& callback);
+
+ private:
+  struct Chain;
+  struct Bucket;
+  struct HashTable;
+  /**
+   * An object replaced at a timestamp, freed once every reader started at
+   * or after it.
+   */
+  struct Garbage {
+    explicit Garbage(uint64_t garbage_timestamp,
+                     CatalogEntry* newer_entry = nullptr);
+
+    uint64_t timestamp;
+    /**
+     * The version whose older pointer refers to entry, nullptr if none.
+     */
+    CatalogEntry* newer;
+    std::unique_ptr<CatalogEntry> entry;
+    std::unique_ptr<Chain> chain;
+    std::unique_ptr<const Bucket> bucket;
+    std::unique_ptr<HashTable> table;
+  };
+
+  Chain* FindChain(const std::string& name) const;
+  /**
+   * Insert a new chain, with write_lock_ held.
+   */
+  Chain* AddChain(const std::string& name, uint64_t timestamp);
+  /**
+   * Make entry the newest version of the chain, with write_lock_ held.
+   */
+  void PushVersion(Chain* chain, std::unique_ptr<CatalogEntry> entry,
+                   uint64_t timestamp);
+  /**
+   * Remove a chain whose entry is dropped, with write_lock_ held.
+   */
+  void RemoveChain(Chain* chain, uint64_t timestamp);
+  /**
+   * Free the garbage up to the timestamp, with write_lock_ held.
+   */
+  void FreeGarbage(uint64_t timestamp);
+
+  std::atomic<HashTable*> table_;
+  std::mutex write_lock_;
+  /**
+   * The chains in the hash table, which own their versions.
+   */
+  std::vector<std::unique_ptr<Chain>> chains_;
+  /**
+   * Ordered by timestamp.
+   */
+  std::deque<Garbage> garbage_;
+  /**
+   * The chains whose entry was dropped at the timestamp, removed once no
+   * reader can see the entry anymore unless it is created again.
+   */
+  std::deque<std::pair<uint64_t, Chain*>> dropped_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,52 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/types/chunk_collection.hpp"
+#include "common/types/vector.hpp"
+#include "zoomdb.h"
+
+namespace zoomdb {
+
+/**
+ * Conversion between vectors and the arrays of the Arrow C data interface.
+ *
+ * The Arrow types map to the types of ZoomDB as follows: boolean "b",
+ * int8 "c", int16 "s", int32 "i", int64 "l", float64 "g", date32 "tdD",
+ * timestamp[us] "tsu:..." and utf8 "u" / large utf8 "U". Other formats
+ * raise a NotImplementationException.
+ */
+
+/**
+ * Returns the type of the values of an Arrow array with the given format.
+ */
+TypeId ArrowFormatToType(const char* format);
+
+/**
+ * Fill result with count entries of the array, starting at entry offset.
+ * If the Arrow type is stored like the type of result, result references
+ * the buffers of the array instead of copying them; the array must then
+ * outlive the use of result. Otherwise the entries are converted into the
+ * memory of result, which must have been initialized with its type.
+ */
+void ArrowToVector(const ArrowSchema& schema, const ArrowArray& array,
+                   size_t offset, size_t count, Vector& result);
+
+/**
+ * Export the rows of the collection as a struct array with one child per
+ * column. The exported structures own copies of the data and are released
+ * with their release callbacks.
+ */
+void ChunkCollectionToArrow(const ChunkCollection& collection,
+                            const std::vector<std::string>& names,
+                            ArrowSchema* schema, ArrowArray* array);
+
+}  // namespace zoomdb
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstdarg>
 #include <cstdio>
 #include <stdexcept>
 #include <string>
@@ -47,6 +48,7 @@ enum class ExceptionType {
   kNetwork          = 25,  // network related
   kOptimizer        = 26,  // optimizer related
   kNullPointer      = 27,  // nullptr exception
+  kIO               = 28,  // file system and io errors
 };
 
 class Exception : public std::runtime_error {
@@ -228,4 +230,9 @@ class NullPointerException : public Exception {
   NullPointerException(std::string msg, ...);
 };
 
+class IOException : public Exception {
+ public:
+  IOException(std::string msg, ...);
+};
+
 }  // namespace zoomdb
@@ -0,0 +1,44 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace zoomdb {
+
+/**
+ * A read-only memory mapping of a complete file. The mapping is released
+ * when the object is destroyed.
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&)            = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* GetData() const { return data_; }
+  size_t GetSize() const { return size_; }
+  const std::string& GetPath() const { return path_; }
+
+  /**
+   * Ask the kernel to read the given range of the file into the page cache
+   * in the background. Returns without waiting for the reads, so a later
+   * access to the range does not block on I/O.
+   */
+  void Prefetch(size_t offset, size_t length) const;
+
+ private:
+  std::string path_;
+  const char* data_;
+  size_t size_;
+};
+
+}  // namespace zoomdb
@@ -7,10 +7,29 @@
 
 #pragma once
 
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace zoomdb {
 
+/**
+ * The number of tuples processed by an operator at a time. Every Vector is
+ * allocated with room for this many entries.
+ */
+constexpr size_t kStandardVectorSize = 1024;
+
+/**
+ * Bit set that marks the NULL entries of a Vector.
+ */
+using nullmask_t = std::bitset<kStandardVectorSize>;
+
+/**
+ * The position of an entry in a Vector, as stored in a selection vector.
+ */
+using sel_t = uint16_t;
+
 /**
  * SQL Value Types.
  */
@@ -136,12 +155,19 @@ enum class ExpressionType {
   /**
    * Aggregates
    */
-  kAggregateCount              = 50,
-  kAggregateCountStar          = 51,
-  kAggregateSum                = 52,
-  kAggregateMin                = 53,
-  kAggregateMax                = 54,
-  kAggregateAvg                = 55,
+  kAggregateCount               = 50,
+  kAggregateCountStar           = 51,
+  kAggregateSum                 = 52,
+  kAggregateMin                 = 53,
+  kAggregateMax                 = 54,
+  kAggregateAvg                 = 55,
+  kAggregateApproxCountDistinct = 56,
+  kAggregateApproxQuantile      = 57,
+
+  /**
+   * Window functions
+   */
+  kWindowAggregate             = 70,
 
   /**
    * Functions
@@ -182,8 +208,38 @@ enum class ExpressionType {
 
 };
 
+/**
+ * Join Types.
+ */
+enum class JoinType {
+  kInvalid = 0,  // invalid join type
+  kInner   = 1,  // inner join
+  kLeft    = 2,  // left outer join
+  kSemi    = 3,  // semi join: left rows that have a match
+  kAnti    = 4,  // anti join: left rows that have no match
+  kMark    = 5,  // mark join: every left row plus a BOOLEAN match column
+};
+
 ExpressionType StringToExpressionType(const std::string& str);
+std::string ExpressionTypeToString(ExpressionType type);
 std::string TypeIdToString(TypeId type);
+std::string JoinTypeToString(JoinType type);
 TypeId StringToTypeId(const std::string& str);
 
+/**
+ * Returns the size in bytes of a single value of the given type as it is
+ * stored inside a Vector. VARCHAR values are stored as pointers.
+ */
+size_t GetTypeIdSize(TypeId type);
+
+/**
+ * Returns true if the type is one of the integral types.
+ */
+bool TypeIsIntegral(TypeId type);
+
+/**
+ * Returns true if the type is integral or DECIMAL.
+ */
+bool TypeIsNumeric(TypeId type);
+
 }  // namespace zoomdb
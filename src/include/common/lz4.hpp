@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zoomdb {
+
+/**
+ * Compression in the LZ4 block format, readable by any LZ4 implementation
+ * (LZ4_decompress_safe). The block does not store the size of the input,
+ * the caller has to pass it on.
+ */
+
+/**
+ * Append the compressed size bytes at data to output.
+ */
+void LZ4Compress(const uint8_t* data, size_t size,
+                 std::vector<uint8_t>& output);
+
+/**
+ * Decompress the block of size bytes at data into the size_decompressed
+ * bytes at output. Throws a SerializationException if the block is
+ * malformed or does not decompress to exactly size_decompressed bytes.
+ */
+void LZ4Decompress(const uint8_t* data, size_t size, uint8_t* output,
+                   size_t size_decompressed);
+
+}  // namespace zoomdb
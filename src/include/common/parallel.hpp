@@ -0,0 +1,48 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace zoomdb {
+
+/**
+ * Run task(0) ... task(count - 1) on up to thread_count threads (0 means
+ * one per hardware thread), the calling thread included. The tasks are
+ * handed out in order, the task must not throw.
+ */
+void ParallelFor(size_t count, size_t thread_count,
+                 const std::function<void(size_t)>& task);
+
+/**
+ * The number of partitions of ParallelDistinct(), the entries are radix
+ * partitioned by the high kDistinctRadixBits bits of their hashes.
+ */
+constexpr size_t kDistinctRadixBits  = 6;
+constexpr size_t kDistinctPartitions = size_t{1} << kDistinctRadixBits;
+
+/**
+ * Call task(partition, entry) for the first occurrence of every distinct
+ * entry among the entries 0 ... count - 1. Equal entries (by equals) must
+ * have equal hashes.
+ *
+ * The hashes are computed and the entries partitioned by ranges of entries
+ * in parallel, then every partition is deduplicated with a hash set of its
+ * own, also in parallel, so no set is shared between threads. The task is
+ * called by the thread of the partition, for the entries of a partition in
+ * increasing order. The first exception thrown by hash, equals or task is
+ * rethrown once all threads are done.
+ */
+void ParallelDistinct(size_t count,
+                      const std::function<uint64_t(size_t)>& hash,
+                      const std::function<bool(size_t, size_t)>& equals,
+                      const std::function<void(size_t, size_t)>& task);
+
+}  // namespace zoomdb
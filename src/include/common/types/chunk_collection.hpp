@@ -0,0 +1,50 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/printable.hpp"
+#include "common/types/data_chunk.hpp"
+
+namespace zoomdb {
+
+/**
+ * A ChunkCollection is a list of DataChunks of the same types, used to
+ * materialize (intermediate) results of arbitrary size. All chunks but the
+ * last one are full.
+ */
+class ChunkCollection : public Printable {
+ public:
+  ChunkCollection();
+
+  /**
+   * Append the rows of the chunk to the collection.
+   */
+  void Append(const DataChunk& chunk);
+
+  const std::vector<TypeId>& GetTypes() const { return types_; }
+  size_t GetCount() const { return count_; }
+  size_t ChunkCount() const { return chunks_.size(); }
+  DataChunk& GetChunk(size_t index) { return *chunks_[index]; }
+  const DataChunk& GetChunk(size_t index) const { return *chunks_[index]; }
+
+  Value GetValue(size_t column, size_t row) const;
+
+  size_t GetAllocationSize() const;
+
+  std::string ToString() const override;
+
+ private:
+  std::vector<TypeId> types_;
+  std::vector<std::unique_ptr<DataChunk>> chunks_;
+  size_t count_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,102 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+#include "common/types/vector.hpp"
+
+namespace zoomdb {
+
+/**
+ * A DataChunk is a set of Vectors of equal length, one per column. It is a
+ * horizontal slice of a table or of an intermediate result.
+ *
+ * A chunk may hold only some rows of its vectors, given by a selection
+ * vector, so that a filter passes on its rows without copying them. The
+ * count, GetValue() and Append() of the chunk respect the selection; code
+ * that accesses the vectors of the chunk directly must handle it, so only
+ * chunks of consumers that allow it get one (see AllowSelection()).
+ */
+class DataChunk : public Printable {
+ public:
+  DataChunk() = default;
+
+  DataChunk(const DataChunk&)            = delete;
+  DataChunk& operator=(const DataChunk&) = delete;
+  DataChunk(DataChunk&&)                 = default;
+  DataChunk& operator=(DataChunk&&)      = default;
+
+  /**
+   * Allocate one vector per type, each with room for kStandardVectorSize
+   * entries.
+   */
+  void Initialize(const std::vector<TypeId>& types);
+  /**
+   * Set the count of every vector to zero, keeping the allocated memory,
+   * and drop the selection.
+   */
+  void Reset();
+  void Destroy();
+
+  size_t GetCount() const {
+    if (selection_) {
+      return selected_count_;
+    }
+    return data_.empty() ? 0 : data_[0].GetCount();
+  }
+  size_t ColumnCount() const { return data_.size(); }
+  std::vector<TypeId> GetTypes() const;
+
+  Vector& GetVector(size_t index) { return data_[index]; }
+  const Vector& GetVector(size_t index) const { return data_[index]; }
+
+  /**
+   * The positions of the rows of the chunk in its vectors, or nullptr if
+   * the chunk holds all entries of its vectors.
+   */
+  const sel_t* GetSelection() const { return selection_; }
+  /**
+   * Restrict the chunk to count entries of its vectors. The selection is
+   * not copied and must stay valid until the chunk is reset.
+   */
+  void SetSelection(const sel_t* selection, size_t count);
+  /**
+   * Whether the producer of the chunk may give it a selection instead of
+   * copying the selected rows. Set by consumers that handle a selection,
+   * it is kept when the chunk is reset.
+   */
+  bool AllowsSelection() const { return allows_selection_; }
+  void AllowSelection() { allows_selection_ = true; }
+
+  Value GetValue(size_t column, size_t row) const;
+  void SetValue(size_t column, size_t row, const Value& value);
+
+  /**
+   * Append the rows of other to this chunk, the types must match.
+   */
+  void Append(const DataChunk& other);
+  /**
+   * Append count rows of other, starting at row start.
+   */
+  void Append(const DataChunk& other, size_t start, size_t count);
+
+  size_t GetAllocationSize() const;
+
+  std::string ToString() const override;
+
+ private:
+  std::vector<Vector> data_;
+  const sel_t* selection_ = nullptr;
+  size_t selected_count_  = 0;
+  bool allows_selection_  = false;
+};
+
+}  // namespace zoomdb
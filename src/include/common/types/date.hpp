@@ -0,0 +1,71 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace zoomdb {
+
+/**
+ * A DATE is stored as the number of days since 1970-01-01.
+ */
+class Date {
+ public:
+  /**
+   * Convert a string in the format "YYYY-MM-DD" to a date.
+   */
+  static int32_t FromString(const std::string& str);
+
+  /**
+   * Convert a date to a string in the format "YYYY-MM-DD".
+   */
+  static std::string ToString(int32_t date);
+
+  /**
+   * Create a date from the specified year, month and day.
+   */
+  static int32_t FromDate(int32_t year, int32_t month, int32_t day);
+
+  /**
+   * Extract the year, month and day from a date.
+   */
+  static void Convert(int32_t date, int32_t& year, int32_t& month,
+                      int32_t& day);
+
+  /**
+   * Returns true if the specified (year, month, day) combination is valid.
+   */
+  static bool IsValidDay(int32_t year, int32_t month, int32_t day);
+};
+
+/**
+ * A TIMESTAMP is stored as the number of microseconds since
+ * 1970-01-01 00:00:00.
+ */
+class Timestamp {
+ public:
+  static constexpr int64_t kMicrosPerSecond = 1000000;
+  static constexpr int64_t kMicrosPerDay    = 86400 * kMicrosPerSecond;
+
+  /**
+   * Convert a string in the format "YYYY-MM-DD hh:mm:ss[.ffffff]" to a
+   * timestamp. The time part is optional.
+   */
+  static int64_t FromString(const std::string& str);
+
+  /**
+   * Convert a timestamp to a string in the format "YYYY-MM-DD hh:mm:ss".
+   */
+  static std::string ToString(int64_t timestamp);
+
+  static int32_t GetDate(int64_t timestamp);
+  static int64_t FromDate(int32_t date);
+};
+
+}  // namespace zoomdb
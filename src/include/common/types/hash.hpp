@@ -0,0 +1,113 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace zoomdb {
+
+/**
+ * Finalizer of MurmurHash3, a cheap way to spread the bits of an integer
+ * over the whole 64-bit hash.
+ */
+inline uint64_t HashInteger(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+/**
+ * Hash an arbitrary sequence of bytes (64-bit MurmurHash2).
+ */
+inline uint64_t HashBytes(const char* data, size_t len) {
+  const uint64_t m = 0xc6a4a7935bd1e995ULL;
+  const int r      = 47;
+  uint64_t h       = 0xe17a1465ULL ^ (len * m);
+
+  const char* end  = data + (len - len % 8);
+  for (const char* p = data; p != end; p += 8) {
+    uint64_t k;
+    std::memcpy(&k, p, sizeof(k));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  const auto* tail = reinterpret_cast<const unsigned char*>(end);
+  switch (len & 7) {
+    case 7:
+      h ^= static_cast<uint64_t>(tail[6]) << 48;
+      [[fallthrough]];
+    case 6:
+      h ^= static_cast<uint64_t>(tail[5]) << 40;
+      [[fallthrough]];
+    case 5:
+      h ^= static_cast<uint64_t>(tail[4]) << 32;
+      [[fallthrough]];
+    case 4:
+      h ^= static_cast<uint64_t>(tail[3]) << 24;
+      [[fallthrough]];
+    case 3:
+      h ^= static_cast<uint64_t>(tail[2]) << 16;
+      [[fallthrough]];
+    case 2:
+      h ^= static_cast<uint64_t>(tail[1]) << 8;
+      [[fallthrough]];
+    case 1:
+      h ^= static_cast<uint64_t>(tail[0]);
+      h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+inline uint64_t HashString(const char* str) {
+  return HashBytes(str, std::strlen(str));
+}
+
+/**
+ * Hash a value as it is stored inside a Vector. Hashing a value through
+ * Value::Hash() gives the same result.
+ */
+template <class T>
+inline uint64_t Hash(T value) {
+  return HashInteger(static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+template <>
+inline uint64_t Hash(double value) {
+  // make sure 0.0 and -0.0 hash to the same value
+  value = value == 0 ? 0 : value;
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return HashInteger(bits);
+}
+
+template <>
+inline uint64_t Hash(const char* value) {
+  return HashString(value);
+}
+
+/**
+ * Combine two hashes, used for hashing multiple columns.
+ */
+inline uint64_t CombineHash(uint64_t left, uint64_t right) {
+  return left ^ (right + 0x9e3779b97f4a7c15ULL + (left << 6) + (left >> 2));
+}
+
+}  // namespace zoomdb
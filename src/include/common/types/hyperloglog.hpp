@@ -0,0 +1,59 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace zoomdb {
+
+/**
+ * HyperLogLog sketch that estimates the number of distinct hashes added to
+ * it in a fixed amount of memory (2^kPrecision one-byte registers). The
+ * standard error of the estimate is 1.04 / sqrt(2^kPrecision), about 1.6%.
+ *
+ * Sketches built on disjoint parts of the data can be merged, which makes
+ * them suitable for parallel and incremental computation.
+ */
+class HyperLogLog {
+ public:
+  static constexpr uint32_t kPrecision     = 12;
+  static constexpr uint32_t kRegisterCount = 1U << kPrecision;
+
+  HyperLogLog();
+
+  /**
+   * Add a 64-bit hash to the sketch.
+   */
+  void Add(uint64_t hash) {
+    auto index = static_cast<uint32_t>(hash >> (64 - kPrecision));
+    // the remaining bits, with a sentinel bit so the rank is bounded
+    auto rest  = (hash << kPrecision) | (1ULL << (kPrecision - 1));
+    auto rank  = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    if (rank > registers_[index]) {
+      registers_[index] = rank;
+    }
+  }
+
+  /**
+   * Merge the registers of other into this sketch.
+   */
+  void Merge(const HyperLogLog& other);
+
+  /**
+   * Estimate the number of distinct hashes added to the sketch.
+   */
+  uint64_t Count() const;
+
+  void Clear();
+
+ private:
+  std::array<uint8_t, kRegisterCount> registers_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,85 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace zoomdb {
+
+/**
+ * Merging t-digest that estimates the quantiles of the values added to it.
+ * The values are summarized by at most about kCompression weighted
+ * centroids, which are kept small near the extremes, so the error of a
+ * quantile q is proportional to q * (1 - q): the tails are the most
+ * accurate.
+ *
+ * Like HyperLogLog, sketches built on disjoint parts of the data can be
+ * merged.
+ */
+class QuantileSketch {
+ public:
+  static constexpr double kCompression = 100;
+
+  /**
+   * Add a value to the sketch. The values are buffered and merged into the
+   * centroids once the buffer is full.
+   */
+  void Add(double value) {
+    buffer_.push_back({value, 1});
+    min_ = value < min_ ? value : min_;
+    max_ = value > max_ ? value : max_;
+    if (buffer_.size() >= kBufferSize) {
+      Compress();
+    }
+  }
+
+  /**
+   * Merge the centroids of other into this sketch.
+   */
+  void Merge(const QuantileSketch& other);
+
+  /**
+   * Estimate the q-quantile (0 <= q <= 1) of the values added to the sketch,
+   * interpolating between the centroids. The sketch must not be empty.
+   */
+  double Quantile(double q) const;
+
+  /**
+   * The number of values added to the sketch.
+   */
+  double Count() const;
+
+  void Clear();
+
+ private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  static constexpr size_t kBufferSize = 5 * static_cast<size_t>(kCompression);
+
+  /**
+   * Merge the buffered values into the centroids.
+   */
+  void Compress() const;
+
+  // compressed lazily, also when a const sketch is queried
+  mutable std::vector<Centroid> centroids_;
+  mutable std::vector<Centroid> buffer_;
+  /**
+   * The extremes are kept exactly, the quantiles near 0 and 1 are
+   * interpolated between them and the outermost centroids.
+   */
+  double min_ = std::numeric_limits<double>::infinity();
+  double max_ = -std::numeric_limits<double>::infinity();
+};
+
+}  // namespace zoomdb
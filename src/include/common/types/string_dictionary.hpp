@@ -0,0 +1,71 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+#include "common/internal-types.hpp"
+#include "common/types/string_heap.hpp"
+
+namespace zoomdb {
+
+/**
+ * StringDictionary assigns consecutive codes to distinct strings. The
+ * strings of a VARCHAR column with few distinct values are stored once in a
+ * dictionary, and the vectors of the column carry the code of every entry
+ * (see Vector::GetDictionary()), so that operators can evaluate predicates,
+ * group and join on the codes instead of comparing and hashing strings.
+ *
+ * Strings are added by a single writer, but may be read concurrently: the
+ * entries below GetSize() never change or move.
+ */
+class StringDictionary {
+ public:
+  static constexpr uint32_t kMaxSize     = 1U << 16;
+  static constexpr uint32_t kInvalidCode = std::numeric_limits<uint32_t>::max();
+
+  StringDictionary();
+
+  StringDictionary(const StringDictionary&)            = delete;
+  StringDictionary& operator=(const StringDictionary&) = delete;
+
+  /**
+   * Returns the code of the string, adding it if it is new. Returns
+   * kInvalidCode if the string is new but the dictionary is full.
+   */
+  uint32_t Add(const char* str);
+
+  size_t GetSize() const { return size_.load(std::memory_order_acquire); }
+  const char* GetString(uint32_t code) const {
+    return blocks_[code / kStandardVectorSize][code % kStandardVectorSize];
+  }
+
+  /**
+   * Bytes allocated by the dictionary for its strings and codes.
+   */
+  size_t GetAllocationSize() const;
+
+ private:
+  static constexpr size_t kBlockCount = kMaxSize / kStandardVectorSize;
+
+  /**
+   * The strings, in blocks of kStandardVectorSize entries that are never
+   * reallocated.
+   */
+  std::unique_ptr<const char*[]> blocks_[kBlockCount];
+  std::atomic<size_t> size_;
+  std::unordered_map<std::string_view, uint32_t> codes_;
+  StringHeap heap_;
+};
+
+}  // namespace zoomdb
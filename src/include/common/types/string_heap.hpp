@@ -0,0 +1,48 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace zoomdb {
+
+/**
+ * An arena that owns the null-terminated strings referenced by a VARCHAR
+ * Vector. Strings are never freed individually, only the heap as a whole.
+ */
+class StringHeap {
+ public:
+  StringHeap() = default;
+  StringHeap(StringHeap&&) noexcept            = default;
+  StringHeap& operator=(StringHeap&&) noexcept = default;
+
+  /**
+   * Copy len bytes of data into the heap, appending a terminating '\0'.
+   */
+  const char* AddString(const char* data, size_t len);
+  const char* AddString(const char* str);
+
+  /**
+   * Total bytes allocated by the heap.
+   */
+  size_t GetAllocationSize() const { return allocated_; }
+
+  void Destroy();
+
+ private:
+  static constexpr size_t kMinimumBlockSize = 4096;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t offset_    = 0;
+  size_t capacity_  = 0;
+  size_t allocated_ = 0;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,151 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+
+namespace zoomdb {
+
+/**
+ * A single SQL value of a specific type, used for constants and for
+ * everything that is not processed a vector at a time.
+ */
+class Value : public Printable {
+ public:
+  /**
+   * Create a NULL value of type INTEGER.
+   */
+  Value();
+  /**
+   * Create a NULL value of the given type.
+   */
+  explicit Value(TypeId type);
+
+  explicit Value(int32_t value);
+  explicit Value(int64_t value);
+  explicit Value(double value);
+  explicit Value(std::string value);
+  explicit Value(const char* value);
+
+  static Value Boolean(bool value);
+  static Value TinyInt(int8_t value);
+  static Value SmallInt(int16_t value);
+  static Value Integer(int32_t value);
+  static Value BigInt(int64_t value);
+  static Value Decimal(double value);
+  static Value Date(int32_t value);
+  static Value Timestamp(int64_t value);
+  static Value VarChar(std::string value);
+
+  /**
+   * Create a value of an integral, DATE or TIMESTAMP type from an int64_t.
+   */
+  static Value Numeric(TypeId type, int64_t value);
+
+  /**
+   * The smallest and the largest value representable by the given type.
+   */
+  static Value MinimumValue(TypeId type);
+  static Value MaximumValue(TypeId type);
+
+  TypeId GetType() const { return type_; }
+  bool IsNull() const { return is_null_; }
+
+  /**
+   * Returns the value as the given C++ type. The value must not be NULL.
+   */
+  template <class T>
+  T GetValue() const;
+
+  /**
+   * Returns the value of a BOOLEAN, integral, DATE or TIMESTAMP value.
+   */
+  int64_t GetNumericValue() const;
+
+  const std::string& GetString() const { return str_value_; }
+
+  /**
+   * Cast the value to the given type. Throws a ConversionException if the
+   * value cannot be represented by the new type.
+   */
+  Value CastAs(TypeId new_type) const;
+
+  /**
+   * Hash of the value, NULL values all hash to the same value.
+   */
+  uint64_t Hash() const;
+
+  std::string ToString() const override;
+
+  /**
+   * Total order over values: NULL sorts before all other values, values of
+   * different types are compared after implicit numeric casting.
+   * Returns a negative number, zero or a positive number if left is smaller,
+   * equal or larger than right.
+   */
+  static int Compare(const Value& left, const Value& right);
+
+  bool operator==(const Value& rhs) const { return Compare(*this, rhs) == 0; }
+  bool operator!=(const Value& rhs) const { return Compare(*this, rhs) != 0; }
+  bool operator<(const Value& rhs) const { return Compare(*this, rhs) < 0; }
+  bool operator>(const Value& rhs) const { return Compare(*this, rhs) > 0; }
+  bool operator<=(const Value& rhs) const { return Compare(*this, rhs) <= 0; }
+  bool operator>=(const Value& rhs) const { return Compare(*this, rhs) >= 0; }
+
+ private:
+  TypeId type_;
+  bool is_null_;
+
+  union {
+    int8_t boolean;
+    int8_t tinyint;
+    int16_t smallint;
+    int32_t integer;
+    int64_t bigint;
+    double decimal;
+    int32_t date;
+    int64_t timestamp;
+  } value_;
+
+  std::string str_value_;
+};
+
+template <>
+bool Value::GetValue() const;
+template <>
+int8_t Value::GetValue() const;
+template <>
+int16_t Value::GetValue() const;
+template <>
+int32_t Value::GetValue() const;
+template <>
+int64_t Value::GetValue() const;
+template <>
+double Value::GetValue() const;
+template <>
+std::string Value::GetValue() const;
+
+/**
+ * Hash and equality of lists of values, for hash tables keyed by the values
+ * of several columns. Unlike in SQL comparisons, NULLs are equal.
+ */
+struct ValueListHash {
+  size_t operator()(const std::vector<Value>& values) const;
+};
+
+struct ValueListEquals {
+  bool operator()(const std::vector<Value>& left,
+                  const std::vector<Value>& right) const;
+};
+
+}  // namespace zoomdb
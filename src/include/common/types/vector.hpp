@@ -0,0 +1,175 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+#include "common/types/string_heap.hpp"
+#include "common/types/value.hpp"
+
+namespace zoomdb {
+
+class StringDictionary;
+
+/**
+ * A Vector holds up to kStandardVectorSize values of a single type in a
+ * contiguous array, plus a bit mask marking the NULL entries. It is the unit
+ * of data that flows between the operators of the execution engine.
+ *
+ * The data is either owned by the vector, or referenced from another vector
+ * (see Reference()), in which case the referenced vector must outlive it.
+ * The strings of a VARCHAR vector may be taken from a StringDictionary,
+ * which the vector then keeps alive.
+ */
+class Vector : public Printable {
+ public:
+  Vector();
+  /**
+   * Create a vector of the given type. If create_data is true, memory for
+   * kStandardVectorSize entries is allocated.
+   */
+  explicit Vector(TypeId type, bool create_data = true);
+  /**
+   * Create a vector of size one holding the given value.
+   */
+  explicit Vector(const Value& value);
+
+  Vector(const Vector&)            = delete;
+  Vector& operator=(const Vector&) = delete;
+  Vector(Vector&& other) noexcept;
+  Vector& operator=(Vector&& other) noexcept;
+
+  /**
+   * Allocate memory for the given type and reset the vector to be empty.
+   */
+  void Initialize(TypeId type);
+  /**
+   * Make the vector empty again, keeping the allocated memory.
+   */
+  void Reset();
+  /**
+   * Release the data of the vector.
+   */
+  void Destroy();
+
+  TypeId GetType() const { return type_; }
+  size_t GetCount() const { return count_; }
+  void SetCount(size_t count);
+
+  char* GetData() { return data_; }
+  const char* GetData() const { return data_; }
+  template <class T>
+  T* GetData() {
+    return reinterpret_cast<T*>(data_);
+  }
+  template <class T>
+  const T* GetData() const {
+    return reinterpret_cast<const T*>(data_);
+  }
+
+  nullmask_t& GetNullMask() { return nullmask_; }
+  const nullmask_t& GetNullMask() const { return nullmask_; }
+  bool IsNull(size_t index) const { return nullmask_[index]; }
+  void SetNull(size_t index, bool null) { nullmask_[index] = null; }
+
+  /**
+   * The dictionary the strings of this VARCHAR vector are taken from, or
+   * nullptr if they are not all taken from one. If set, GetDictionaryCodes()
+   * holds the code of every entry that is not NULL.
+   */
+  const StringDictionary* GetDictionary() const {
+    return codes_ ? dictionary_.get() : nullptr;
+  }
+  const uint32_t* GetDictionaryCodes() const { return codes_; }
+  /**
+   * Take the strings of this VARCHAR vector from the dictionary. Returns the
+   * array for the codes of the entries, which the caller fills in along with
+   * the strings.
+   */
+  uint32_t* SetDictionary(std::shared_ptr<const StringDictionary> dictionary);
+
+  Value GetValue(size_t index) const;
+  /**
+   * Set the entry at index to the given value, the value is cast to the type
+   * of the vector if required.
+   */
+  void SetValue(size_t index, const Value& value);
+
+  /**
+   * Append the entries of other to the end of this vector. Strings are
+   * copied into the string heap of this vector, unless they are taken from
+   * the dictionary of this vector: an empty vector shares the dictionary of
+   * other.
+   */
+  void Append(const Vector& other);
+  /**
+   * Append count entries of other, starting at entry start.
+   */
+  void Append(const Vector& other, size_t start, size_t count);
+  /**
+   * Append the count entries of other at the positions of the selection.
+   */
+  void AppendSelection(const Vector& other, const sel_t* selection,
+                       size_t count);
+  /**
+   * Copy the entries of this vector into target, starting at offset.
+   */
+  void Copy(Vector& target, size_t offset = 0) const;
+  /**
+   * Make this vector reference the data of other without copying.
+   */
+  void Reference(Vector& other);
+  /**
+   * Make this vector reference count entries of the given type stored at
+   * data, e.g. a buffer of the caller. The entries are not NULL.
+   */
+  void Reference(TypeId type, char* data, size_t count);
+
+  /**
+   * Copy a string into the string heap of this vector.
+   */
+  const char* AddString(const char* data, size_t len);
+
+  /**
+   * Bytes allocated by this vector for its data and strings.
+   */
+  size_t GetAllocationSize() const;
+
+  std::string ToString() const override;
+
+ private:
+  /**
+   * Copy count entries of source starting at start into this vector at
+   * offset, without changing the count.
+   */
+  void CopyRange(const Vector& source, size_t start, size_t count,
+                 size_t offset);
+  /**
+   * Returns true if the strings of source are taken from the dictionary of
+   * this vector, an empty vector takes over the dictionary of source first.
+   */
+  bool ShareDictionary(const Vector& source, size_t offset);
+
+  TypeId type_;
+  size_t count_;
+  char* data_;
+  std::unique_ptr<char[]> owned_data_;
+  nullmask_t nullmask_;
+  StringHeap string_heap_;
+  /**
+   * The dictionary strings were taken from. It is kept even if codes_ is
+   * dropped because other strings are added, the entries still point into it.
+   */
+  std::shared_ptr<const StringDictionary> dictionary_;
+  uint32_t* codes_;
+  std::unique_ptr<uint32_t[]> owned_codes_;
+};
+
+}  // namespace zoomdb
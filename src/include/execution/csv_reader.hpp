@@ -0,0 +1,51 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "parser/copy_info.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * ParallelCSVReader loads a CSV file into a table.
+ *
+ * The file is memory mapped and split into blocks of a few megabytes. The
+ * block boundaries are moved to the next line break outside of a quoted
+ * field; whether a boundary lies inside quotes follows from the parity of
+ * the quotes before it, which is counted for all blocks in parallel. The
+ * blocks are then parsed by a pool of threads that scan for delimiters and
+ * quotes 16 bytes at a time and convert every field directly into the
+ * column vector of its type, and the parsed blocks are appended to the
+ * table in file order.
+ *
+ * Counting quotes requires quotes to be escaped by doubling them. With
+ * another escape character the file is parsed as a single block.
+ */
+class ParallelCSVReader {
+ public:
+  ParallelCSVReader(CopyInfo copy_info, std::vector<TypeId> types);
+
+  /**
+   * Read the file and append its rows to the table, using thread_count
+   * threads (0 means one per hardware thread). Returns the number of rows
+   * read. If a line cannot be parsed, an exception is thrown, the rows of
+   * the blocks before the failing one may already have been appended.
+   */
+  size_t ReadInto(DataTable& table, size_t thread_count = 0);
+
+ private:
+  CopyInfo info_;
+  std::vector<TypeId> types_;
+};
+
+}  // namespace zoomdb
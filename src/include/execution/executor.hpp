@@ -0,0 +1,25 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "common/types/chunk_collection.hpp"
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+class Executor {
+ public:
+  /**
+   * Run the physical plan and append its result to result. If a profiler
+   * is given, it collects the metrics of every operator of the plan.
+   */
+  static void Execute(PhysicalOperator& plan, ChunkCollection& result,
+                      QueryProfiler* profiler = nullptr);
+};
+
+}  // namespace zoomdb
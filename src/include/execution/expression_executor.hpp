@@ -0,0 +1,73 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/types/data_chunk.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * ExpressionExecutor evaluates expressions a vector at a time over the
+ * rows of an input chunk. The column references of the expressions must
+ * have been resolved to positions in the chunk by the PhysicalPlanGenerator.
+ * Expressions with a kernel (see ExpressionKernels) are evaluated by it,
+ * all others are interpreted row by row. If the chunk has a selection, the
+ * expressions are evaluated for the selected rows only.
+ */
+class ExpressionExecutor {
+ public:
+  /**
+   * Create an executor for the given input, which may be nullptr if the
+   * expressions do not reference any column. Without input the expressions
+   * are evaluated for a single row.
+   */
+  explicit ExpressionExecutor(DataChunk* chunk = nullptr);
+
+  /**
+   * Evaluate the expressions into the columns of result.
+   */
+  void Execute(std::vector<std::unique_ptr<Expression>>& expressions,
+               DataChunk& result);
+  /**
+   * Evaluate a single expression into result.
+   */
+  void ExecuteExpression(Expression& expr, Vector& result);
+  /**
+   * Evaluate the AND of the expressions as a filter into the BOOLEAN vector
+   * result. NULL counts as false, so the result contains no NULLs. Returns
+   * the number of rows that passed.
+   */
+  size_t Select(std::vector<std::unique_ptr<Expression>>& expressions,
+                Vector& result);
+  /**
+   * Deselect the rows of the BOOLEAN vector result, which holds Count()
+   * entries, for which the expression is not true.
+   */
+  void Select(Expression& expr, Vector& result);
+
+ private:
+  void Execute(Expression& expr, Vector& result);
+  /**
+   * Evaluate an operand of a kernel, a constant into a single entry.
+   */
+  void ExecuteOperand(Expression& expr, Vector& result);
+  void ExecuteSubquery(Expression& expr, Vector& result);
+
+  /**
+   * The number of rows the expressions are evaluated for.
+   */
+  size_t Count() const;
+
+  DataChunk* chunk_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "common/internal-types.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * ExpressionKernels is the registry of the kernels that evaluate binary
+ * expressions (arithmetic, comparisons, AND and OR) without interpreting
+ * them row by row. Every kernel is a template instantiated for the operator
+ * and the C++ types of its operands, so its inner loop has no switch over
+ * types and no Value in it.
+ *
+ * A kernel picks one of its loops per call: an operand vector with a single
+ * entry is a constant used for every row, and the NULL checks are left out
+ * if neither operand has a NULL.
+ */
+class ExpressionKernels {
+ public:
+  /**
+   * Returns the kernel for the operator with the given operand and result
+   * types, or nullptr if there is none and the expression is interpreted.
+   */
+  static ExpressionKernel Get(ExpressionType op, TypeId left, TypeId right,
+                              TypeId result);
+};
+
+}  // namespace zoomdb
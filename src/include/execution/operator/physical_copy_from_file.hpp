@@ -0,0 +1,35 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/copy_info.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * PhysicalCopyFromFile loads a CSV or Parquet file into a table and
+ * produces a single row holding the number of rows loaded.
+ */
+class PhysicalCopyFromFile : public PhysicalOperator {
+ public:
+  PhysicalCopyFromFile(DataTable& data_table, CopyInfo copy_info);
+
+  std::string ParamsToString() const override;
+
+  DataTable& table;
+  CopyInfo info;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
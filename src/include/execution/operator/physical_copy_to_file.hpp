@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/copy_info.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalCopyToFile writes the rows of its child to a Parquet file and
+ * produces a single row holding the number of rows written. The rows are
+ * collected until there is a row group for every thread, then the row
+ * groups are encoded in parallel.
+ */
+class PhysicalCopyToFile : public PhysicalOperator {
+ public:
+  PhysicalCopyToFile(CopyInfo copy_info, std::vector<std::string> column_names,
+                     std::unique_ptr<PhysicalOperator> child);
+
+  std::string ParamsToString() const override;
+
+  CopyInfo info;
+  std::vector<std::string> names;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,32 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalCrossProduct produces every combination of a row of its left
+ * child with a row of its right child. The right child is materialized.
+ */
+class PhysicalCrossProduct : public PhysicalOperator {
+ public:
+  PhysicalCrossProduct(std::vector<TypeId> result_types,
+                       std::unique_ptr<PhysicalOperator> left,
+                       std::unique_ptr<PhysicalOperator> right);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
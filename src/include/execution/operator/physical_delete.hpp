@@ -0,0 +1,32 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * PhysicalDelete deletes the rows of a table whose row ids its child
+ * produces, one chunk at a time, and produces a single row holding the
+ * number of rows deleted.
+ */
+class PhysicalDelete : public PhysicalOperator {
+ public:
+  explicit PhysicalDelete(DataTable& data_table);
+
+  DataTable& table;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,41 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalFilter produces the rows of its child for which all of its
+ * expressions are true. An expression that only references a single
+ * dictionary encoded VARCHAR column is evaluated once per string of the
+ * dictionary instead of once per row, the rows are then selected by code.
+ *
+ * If the consumer allows it, the rows that pass are not copied: the
+ * produced chunk references the input and selects them (see
+ * DataChunk::GetSelection()).
+ */
+class PhysicalFilter : public PhysicalOperator {
+ public:
+  PhysicalFilter(std::vector<TypeId> result_types,
+                 std::vector<std::unique_ptr<Expression>> filters);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  std::vector<std::unique_ptr<Expression>> expressions;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,62 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalHashAggregate groups the rows of its child by the groups in a
+ * hash table and computes the aggregates for every group. It produces the
+ * groups followed by the aggregates. Without groups, it produces exactly
+ * one row, even if the input is empty. A single dictionary encoded group
+ * is grouped by its codes.
+ *
+ * The inputs of DISTINCT aggregates are collected with their groups while
+ * the child is consumed, and deduplicated afterwards by ParallelDistinct():
+ * every partition aggregates its distinct inputs into states of its own,
+ * which are then combined into the states of the groups.
+ */
+class PhysicalHashAggregate : public PhysicalOperator {
+ public:
+  PhysicalHashAggregate(std::vector<TypeId> result_types,
+                        std::vector<std::unique_ptr<Expression>> aggregates,
+                        std::vector<std::unique_ptr<Expression>> group_list);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  std::vector<std::unique_ptr<Expression>> expressions;
+  std::vector<std::unique_ptr<Expression>> groups;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+
+ private:
+  /**
+   * Consume the complete input and build the hash table of the groups.
+   */
+  void Build(PhysicalOperatorState& state);
+  /**
+   * Returns the group of the row of the groups, adding it if it is new.
+   */
+  size_t FindGroup(PhysicalOperatorState& state, DataChunk& group_chunk,
+                   size_t row);
+  size_t AddGroup(PhysicalOperatorState& state, std::vector<Value> key);
+  /**
+   * Aggregate the collected inputs of the DISTINCT aggregate with the given
+   * index.
+   */
+  void AggregateDistinct(PhysicalOperatorState& state, size_t index);
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,42 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalHashDistinct produces the first occurrence of every distinct row
+ * of its child, in the order of the child.
+ *
+ * The complete input is consumed first. Every row is encoded into a binary
+ * key (see Index::EncodeValue()), the chunks in parallel, and the keys are
+ * deduplicated by ParallelDistinct(): radix partitioned by their hashes,
+ * with a hash set per partition, so the partitions are processed in
+ * parallel without sharing a set.
+ */
+class PhysicalHashDistinct : public PhysicalOperator {
+ public:
+  explicit PhysicalHashDistinct(std::vector<TypeId> result_types);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+
+ private:
+  /**
+   * Consume the complete input and mark its distinct rows.
+   */
+  void Build(PhysicalOperatorState& state);
+};
+
+}  // namespace zoomdb
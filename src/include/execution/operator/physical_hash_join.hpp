@@ -0,0 +1,73 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "planner/operator/logical_join.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalHashJoin joins its children on a set of conditions. The right
+ * child is materialized into a hash table on the equality conditions, the
+ * left child is streamed through it; the other conditions are checked for
+ * every candidate pair. Without equality conditions every right row is a
+ * candidate (a nested loop join). A left row with a single equality
+ * condition on a dictionary encoded string is probed by its code.
+ *
+ * Supports INNER, LEFT, SEMI, ANTI and MARK joins, see LogicalJoin for the
+ * produced columns.
+ */
+class PhysicalHashJoin : public PhysicalOperator {
+ public:
+  PhysicalHashJoin(std::vector<TypeId> result_types, JoinType type,
+                   std::vector<JoinCondition> join_conditions,
+                   std::unique_ptr<PhysicalOperator> left,
+                   std::unique_ptr<PhysicalOperator> right);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  JoinType join_type;
+  /**
+   * The conditions of the join. Their expressions are moved into
+   * left_expressions and right_expressions, so they can be evaluated as a
+   * list.
+   */
+  std::vector<JoinCondition> conditions;
+  std::vector<std::unique_ptr<Expression>> left_expressions;
+  std::vector<std::unique_ptr<Expression>> right_expressions;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+
+ private:
+  /**
+   * Materialize the right child and build the hash table.
+   */
+  void Build(PhysicalOperatorState& state);
+  /**
+   * Find the right rows matching the current left row.
+   */
+  void Probe(PhysicalOperatorState& state);
+  /**
+   * The right rows whose equality conditions (given by their positions)
+   * match the current left row, which are not NULL.
+   */
+  const std::vector<size_t>& FindMatches(PhysicalOperatorState& state,
+                                         const std::vector<size_t>& equalities);
+  /**
+   * The MARK of a row without match: NULL if one of the null-aware
+   * conditions was NULL for a right row that passed the other conditions.
+   */
+  Value GetMarkWithoutMatch(PhysicalOperatorState& state);
+};
+
+}  // namespace zoomdb
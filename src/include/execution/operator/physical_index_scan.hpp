@@ -0,0 +1,50 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "common/types/value.hpp"
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+class Index;
+
+/**
+ * PhysicalIndexScan produces the given columns of the rows of a base table
+ * whose first indexed column lies between lower and upper (a NULL bound is
+ * unbounded). The row ids are looked up in the index first, and the rows
+ * are then fetched in the order of their position in the table.
+ */
+class PhysicalIndexScan : public PhysicalOperator {
+ public:
+  PhysicalIndexScan(DataTable& data_table, std::string name,
+                    std::vector<size_t> columns, Index& scan_index,
+                    Value lower_bound, bool lower_is_inclusive,
+                    Value upper_bound, bool upper_is_inclusive);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  DataTable& table;
+  std::string table_name;
+  std::vector<size_t> column_ids;
+  Index& index;
+
+  Value lower;
+  bool lower_inclusive;
+  Value upper;
+  bool upper_inclusive;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
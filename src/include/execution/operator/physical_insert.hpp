@@ -0,0 +1,45 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * PhysicalInsert appends the rows of the VALUES list, or the rows of its
+ * child, to a table and produces a single row holding the number of rows
+ * inserted. Columns that are not inserted are NULL.
+ */
+class PhysicalInsert : public PhysicalOperator {
+ public:
+  PhysicalInsert(
+      DataTable& data_table, std::vector<size_t> columns,
+      std::vector<std::vector<std::unique_ptr<Expression>>> values);
+
+  std::string ParamsToString() const override;
+
+  DataTable& table;
+  std::vector<size_t> column_ids;
+  std::vector<std::vector<std::unique_ptr<Expression>>> insert_values;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+
+ private:
+  /**
+   * Append the buffered rows to the table.
+   */
+  void Flush(DataChunk& insert_chunk, size_t count);
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,58 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/expression.hpp"
+#include "storage/parquet/parquet_reader.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalParquetScan produces the given columns of a Parquet file, one row
+ * group at a time. Only the pages of the scanned columns are read.
+ *
+ * The filters are comparisons of a scanned column with a constant. They
+ * are not evaluated on the rows, but a row group is skipped if its
+ * statistics show that one of the filters holds for none of its rows.
+ *
+ * Before a row group is decoded, the scanned columns of the next matching
+ * row groups (up to the prefetch depth) are prefetched.
+ */
+class PhysicalParquetScan : public PhysicalOperator {
+ public:
+  PhysicalParquetScan(std::shared_ptr<const ParquetReader> parquet_reader,
+                      std::vector<size_t> columns,
+                      std::vector<std::unique_ptr<Expression>> table_filters,
+                      size_t prefetch);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  std::shared_ptr<const ParquetReader> reader;
+  std::vector<size_t> column_ids;
+  std::vector<std::unique_ptr<Expression>> filters;
+  /**
+   * The number of row groups prefetched ahead, 0 disables prefetching.
+   */
+  size_t prefetch_depth;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+
+ private:
+  bool RowGroupMayMatch(size_t row_group) const;
+  /**
+   * Prefetch the matching row groups after the one about to be read.
+   */
+  void Prefetch(PhysicalOperatorState* state) const;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,35 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalProjection computes its expressions for every row of its child.
+ * Without a child, the expressions are computed once.
+ */
+class PhysicalProjection : public PhysicalOperator {
+ public:
+  PhysicalProjection(std::vector<TypeId> result_types,
+                     std::vector<std::unique_ptr<Expression>> select_list);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  std::vector<std::unique_ptr<Expression>> expressions;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
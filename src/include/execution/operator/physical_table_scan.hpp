@@ -0,0 +1,42 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * PhysicalTableScan produces the given columns of a base table, one chunk
+ * of the table at a time. The vectors reference the table data, nothing is
+ * copied. Deleted rows are left out with a selection; only if the consumer
+ * does not allow one, the remaining rows of the chunk are copied.
+ *
+ * The column DataTable::kRowIdColumn produces the row ids of the rows.
+ */
+class PhysicalTableScan : public PhysicalOperator {
+ public:
+  PhysicalTableScan(DataTable& data_table, std::string name,
+                    std::vector<size_t> columns);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  DataTable& table;
+  std::string table_name;
+  std::vector<size_t> column_ids;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
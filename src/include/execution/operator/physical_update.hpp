@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * PhysicalUpdate overwrites columns of rows of a table, one chunk of its
+ * child at a time: the child produces the row ids of the rows followed by
+ * the new values of the updated columns. It produces a single row holding
+ * the number of rows updated.
+ */
+class PhysicalUpdate : public PhysicalOperator {
+ public:
+  PhysicalUpdate(DataTable& data_table, std::vector<size_t> columns);
+
+  std::string ParamsToString() const override;
+
+  DataTable& table;
+  std::vector<size_t> column_ids;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+};
+
+}  // namespace zoomdb
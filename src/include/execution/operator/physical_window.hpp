@@ -0,0 +1,49 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "execution/physical_operator.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * PhysicalWindow computes window functions over the complete input of its
+ * child. It produces the rows of its child, in their order, followed by the
+ * window functions.
+ *
+ * The rows are sorted by a binary key of their partitions and orders (see
+ * Index::EncodeValue()). The partitions are hash partitioned into buckets
+ * that are sorted and computed in parallel; windows that partition and
+ * order alike share a sort. The aggregate of every frame is combined from
+ * a segment tree over the rows of its partition, in O(log n) per row for
+ * any frame.
+ */
+class PhysicalWindow : public PhysicalOperator {
+ public:
+  PhysicalWindow(std::vector<TypeId> result_types,
+                 std::vector<std::unique_ptr<Expression>> windows);
+
+  std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler) override;
+  std::string ParamsToString() const override;
+
+  std::vector<std::unique_ptr<Expression>> expressions;
+
+ protected:
+  void GetChunkInternal(DataChunk& chunk,
+                        PhysicalOperatorState* state) override;
+
+ private:
+  /**
+   * Consume the complete input and compute the window functions.
+   */
+  void Compute(PhysicalOperatorState& state);
+};
+
+}  // namespace zoomdb
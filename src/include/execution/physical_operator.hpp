@@ -0,0 +1,125 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+#include "common/types/data_chunk.hpp"
+#include "main/query_profiler.hpp"
+
+namespace zoomdb {
+
+enum class PhysicalOperatorType {
+  kInvalid       = 0,
+  kTableScan     = 1,
+  kFilter        = 2,
+  kProjection    = 3,
+  kHashAggregate = 4,
+  kHashJoin      = 5,
+  kCrossProduct  = 6,
+  kCopyFromFile  = 7,
+  kCopyToFile    = 8,
+  kParquetScan   = 9,
+  kIndexScan     = 10,
+  kInsert        = 11,
+  kUpdate        = 12,
+  kDelete        = 13,
+  kWindow        = 14,
+  kHashDistinct  = 15,
+};
+
+std::string PhysicalOperatorTypeToString(PhysicalOperatorType type);
+
+class PhysicalOperator;
+
+/**
+ * The execution state of a physical operator. Every thread executing a plan
+ * has its own tree of states, so operators themselves are never modified
+ * during execution.
+ */
+class PhysicalOperatorState {
+ public:
+  PhysicalOperatorState(const PhysicalOperator& op, PhysicalOperator* child,
+                        QueryProfiler* query_profiler);
+  /**
+   * Flushes the collected metrics into the profiler.
+   */
+  virtual ~PhysicalOperatorState();
+
+  /**
+   * Set once the operator produced its last chunk.
+   */
+  bool finished;
+  /**
+   * The chunk the (first) child writes into.
+   */
+  DataChunk child_chunk;
+  std::unique_ptr<PhysicalOperatorState> child_state;
+
+  QueryProfiler* profiler;
+  OperatorMetrics metrics;
+
+ private:
+  const PhysicalOperator& op_;
+};
+
+/**
+ * A node of the physical plan. Operators produce their result one chunk at
+ * a time: the parent pulls chunks from its children with GetChunk().
+ */
+class PhysicalOperator : public Printable {
+ public:
+  PhysicalOperator(PhysicalOperatorType operator_type,
+                   std::vector<TypeId> result_types);
+  ~PhysicalOperator() override = default;
+
+  PhysicalOperatorType GetType() const { return type_; }
+
+  /**
+   * Fetch the next chunk of the result into chunk, which must be
+   * initialized with the types of the operator. An empty chunk signals that
+   * the operator is exhausted. If the state has a profiler, the metrics of
+   * the operator are collected.
+   */
+  void GetChunk(DataChunk& chunk, PhysicalOperatorState* state);
+
+  /**
+   * Create the state to execute the operator (and its children) with.
+   */
+  virtual std::unique_ptr<PhysicalOperatorState> GetOperatorState(
+      QueryProfiler* profiler);
+
+  /**
+   * Returns the operator specific information shown by EXPLAIN.
+   */
+  virtual std::string ParamsToString() const;
+  /**
+   * Returns the name of the operator followed by its parameters.
+   */
+  std::string GetName() const;
+  std::string ToString() const override;
+
+  /**
+   * The types of the chunks produced by the operator.
+   */
+  std::vector<TypeId> types;
+  std::vector<std::unique_ptr<PhysicalOperator>> children;
+
+ protected:
+  virtual void GetChunkInternal(DataChunk& chunk,
+                                PhysicalOperatorState* state) = 0;
+
+ private:
+  PhysicalOperatorType type_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,71 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "execution/physical_operator.hpp"
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class ColumnRefExpression;
+class SubqueryExpression;
+
+/**
+ * PhysicalPlanGenerator turns a logical plan into a physical plan. The
+ * column references of the expressions are resolved from bindings into
+ * positions in the input of the operator that evaluates them.
+ *
+ * A subquery gets a plan of its own. Its references to the columns of an
+ * enclosing query, left by the SubqueryRewriter when it could not flatten
+ * the subquery, make the subquery run once per row of that query.
+ */
+class PhysicalPlanGenerator {
+ public:
+  /**
+   * Create the physical plan. The logical plan is consumed: its expressions
+   * are moved into the physical operators.
+   */
+  std::unique_ptr<PhysicalOperator> CreatePlan(
+      std::unique_ptr<LogicalOperator> op);
+
+ private:
+  std::unique_ptr<PhysicalOperator> CreateOperator(LogicalOperator& op);
+
+  /**
+   * Resolve the column references of the expression to positions in the
+   * given bindings, create the plans of its subqueries and select the
+   * kernels of its operators.
+   */
+  void ResolveExpression(Expression& expr,
+                         const std::vector<ColumnBinding>& bindings);
+  void ResolveExpressions(std::vector<std::unique_ptr<Expression>>& list,
+                          const std::vector<ColumnBinding>& bindings);
+  /**
+   * Resolve a reference to a column of an enclosing query to the value of
+   * the column that its subquery is run with.
+   */
+  void ResolveOuterReference(ColumnRefExpression& ref);
+
+  /**
+   * A query that encloses the subquery being planned: the bindings of the
+   * operator that evaluates the subquery, and the subquery expression.
+   */
+  struct OuterQuery {
+    const std::vector<ColumnBinding>* bindings;
+    SubqueryExpression* subquery;
+  };
+  /**
+   * The enclosing queries, the innermost last.
+   */
+  std::vector<OuterQuery> outer_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,100 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "common/types/data_chunk.hpp"
+#include "zoomdb.h"
+#include "zoomdb.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * Appender inserts rows into a table without an INSERT statement, so that
+ * nothing is parsed, bound or planned per row. The values of a row are
+ * given column by column, followed by EndRow():
+ *
+ *   Appender appender(connection, "events");
+ *   appender.Append(int64_t(42));
+ *   appender.Append("click");
+ *   appender.EndRow();
+ *
+ * Values are written straight into the column vectors of a buffer chunk,
+ * converting them to the column type if needed. The buffer is appended to
+ * the table whenever it holds kStandardVectorSize rows, by Flush() and on
+ * destruction; rows become visible only then.
+ *
+ * Errors throw: a CatalogException if the table does not exist or a row
+ * has the wrong number of values, and a ConversionException if a value
+ * does not fit its column. A value that fails to convert is not taken, the
+ * row continues with the same column. An Appender must only be used by one
+ * thread. It keeps the storage of the table alive, rows appended after the
+ * table was dropped are lost with it.
+ */
+class Appender {
+ public:
+  Appender(Connection& connection, const std::string& schema,
+           const std::string& table);
+  Appender(Connection& connection, const std::string& table);
+  /**
+   * Flushes the buffered rows, errors are ignored. The values of an
+   * unfinished row are dropped.
+   */
+  ~Appender();
+
+  Appender(const Appender&)            = delete;
+  Appender& operator=(const Appender&) = delete;
+
+  void Append(int32_t value);
+  void Append(int64_t value);
+  void Append(double value);
+  /**
+   * Append a string, nullptr appends NULL.
+   */
+  void Append(const char* value);
+  void Append(const Value& value);
+  void AppendNull();
+  /**
+   * Append all rows of an Arrow struct array (a record batch) whose
+   * children are the columns of the table, see ArrowToVector(). Columns
+   * whose layout matches the table are appended from the Arrow buffers
+   * without an intermediate copy. The arrays stay owned by the caller.
+   * Rows appended by Append() before are flushed first.
+   */
+  void AppendArrow(const ArrowSchema& schema, const ArrowArray& array);
+  /**
+   * Finish the current row, all columns must have been given a value.
+   */
+  void EndRow();
+
+  /**
+   * Append the buffered rows to the table. Throws a CatalogException in
+   * the middle of a row.
+   */
+  void Flush();
+
+ private:
+  /**
+   * Returns the vector of the column the next value goes to. The column
+   * only advances once the value is stored.
+   */
+  Vector& CurrentColumn();
+
+  std::string table_name_;
+  std::shared_ptr<DataTable> table_;
+  DataChunk buffer_;
+  size_t column_;
+  size_t row_count_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,106 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "main/server.hpp"
+#include "zoomdb.hpp"
+
+namespace zoomdb {
+
+/**
+ * A client connection speaking version 3 of the PostgreSQL frontend/backend
+ * protocol, so that psql and the PostgreSQL drivers can connect to the
+ * server. Both the simple and the extended query protocol are supported,
+ * with results in text or binary format. The messages of a client are
+ * answered in order as they arrive, so a driver can pipeline many
+ * Bind/Execute pairs before a Sync.
+ *
+ * Every user is accepted without authentication. The planner has no
+ * parameters, so on Bind the parameters of a prepared statement are
+ * substituted into its text as literals. A portal executes its statement
+ * when it is first described or executed, and keeps the whole result.
+ */
+class PgSession : public ServerSession {
+ public:
+  explicit PgSession(Database& database);
+
+  bool Process(std::vector<uint8_t>& input,
+               std::vector<uint8_t>& output) override;
+
+ private:
+  struct PreparedStatement {
+    std::string query;
+    /**
+     * The type OIDs of the parameters given by Parse, 0 if unspecified.
+     */
+    std::vector<uint32_t> parameter_types;
+    size_t parameter_count = 0;
+  };
+
+  struct Portal {
+    std::string query;
+    /**
+     * The format codes of the result columns (0 text, 1 binary): none for
+     * all text, one for all columns, or one per column.
+     */
+    std::vector<int16_t> formats;
+    bool executed = false;
+    Result result;
+    /**
+     * The number of rows sent by the Execute messages so far.
+     */
+    size_t position = 0;
+  };
+
+  /**
+   * Handle the first message of the connection. Returns false if the
+   * connection is to be closed.
+   */
+  bool Startup(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+  /**
+   * Handle a message after the startup. Returns false on Terminate.
+   */
+  bool Dispatch(uint8_t type, const uint8_t* data, size_t size,
+                std::vector<uint8_t>& output);
+
+  void SimpleQuery(const uint8_t* data, size_t size,
+                   std::vector<uint8_t>& output);
+  void Parse(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+  void Bind(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+  void Describe(const uint8_t* data, size_t size,
+                std::vector<uint8_t>& output);
+  void Execute(const uint8_t* data, size_t size,
+               std::vector<uint8_t>& output);
+  void Close(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+
+  /**
+   * Execute the statement of the portal unless it has been executed.
+   */
+  Result& Run(Portal& portal);
+  /**
+   * Report an error in the extended query protocol.
+   */
+  void Fail(const std::string& message, std::vector<uint8_t>& output);
+
+  Connection connection_;
+  bool started_ = false;
+  /**
+   * Set by an error in the extended query protocol, the messages up to the
+   * next Sync are skipped.
+   */
+  bool failed_  = false;
+  std::unordered_map<std::string, PreparedStatement> statements_;
+  std::unordered_map<std::string, Portal> portals_;
+};
+
+}  // namespace zoomdb
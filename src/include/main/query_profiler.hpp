@@ -0,0 +1,110 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/printable.hpp"
+
+namespace zoomdb {
+
+class PhysicalOperator;
+
+/**
+ * The metrics of a single operator, collected by a single thread. Time and
+ * cycles include the time spent in the children of the operator.
+ */
+struct OperatorMetrics {
+  uint64_t time_ns       = 0;
+  uint64_t cycles        = 0;
+  size_t rows_out        = 0;
+  size_t bytes_allocated = 0;
+  /**
+   * Bytes written to temporary storage because the operator ran out of
+   * memory.
+   */
+  size_t bytes_spilled = 0;
+
+  void Merge(const OperatorMetrics& other);
+};
+
+/**
+ * The QueryProfiler collects the metrics of every operator of a physical
+ * plan while it is executed, and renders them for EXPLAIN ANALYZE.
+ *
+ * Operators accumulate their metrics in their (per thread) operator state,
+ * which flushes them into the profiler once when it is destroyed, so the
+ * profiler is only locked once per operator and thread.
+ */
+class QueryProfiler : public Printable {
+ public:
+  QueryProfiler();
+
+  void StartQuery(const PhysicalOperator& plan);
+  void EndQuery();
+
+  /**
+   * Add the metrics collected by the calling thread for the operator.
+   */
+  void Flush(const PhysicalOperator& op, const OperatorMetrics& metrics);
+
+  /**
+   * Returns the metrics of the operator summed over all threads.
+   */
+  OperatorMetrics GetMetrics(const PhysicalOperator& op) const;
+
+  /**
+   * Returns the physical plan annotated with the metrics of every operator,
+   * the output of EXPLAIN ANALYZE.
+   */
+  std::string ToString() const override;
+
+  /**
+   * Read the CPU cycle counter, 0 if the platform does not provide one.
+   */
+  static uint64_t ReadCycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t result;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(result));
+    return result;
+#else
+    return 0;
+#endif
+  }
+
+ private:
+  using ThreadMetrics = std::map<size_t, OperatorMetrics>;
+
+  std::string RenderOperator(const PhysicalOperator& op) const;
+  OperatorMetrics GetMetrics(const PhysicalOperator& op, size_t thread) const;
+
+  const PhysicalOperator* root_;
+  std::chrono::steady_clock::time_point start_;
+  uint64_t total_time_ns_;
+  /**
+   * The metrics of every operator, per thread. Threads are numbered in the
+   * order in which they first flushed metrics.
+   */
+  std::unordered_map<const PhysicalOperator*, ThreadMetrics> metrics_;
+  std::unordered_map<std::thread::id, size_t> threads_;
+  mutable std::mutex lock_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,130 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace zoomdb {
+
+class Database;
+
+/**
+ * The protocol state of one client of a Server.
+ */
+class ServerSession {
+ public:
+  virtual ~ServerSession() = default;
+
+  /**
+   * Handle the complete messages at the start of input, removing them from
+   * input and appending the responses to output. A partial message is left
+   * in input until the rest of it arrives. Returns false if the client
+   * asked to close the connection, an exception closes it as well.
+   *
+   * Called on a worker thread of the server, but never concurrently for
+   * the same session.
+   */
+  virtual bool Process(std::vector<uint8_t>& input,
+                       std::vector<uint8_t>& output) = 0;
+};
+
+using SessionFactory =
+    std::function<std::unique_ptr<ServerSession>(Database& database)>;
+
+/**
+ * Server accepts TCP connections on localhost and serves every client with
+ * a session created by its factory, so that processes share one database
+ * instead of each embedding a copy.
+ *
+ * The sockets are multiplexed with epoll on the thread that calls Run().
+ * When a client has sent data, its session processes it on one of a fixed
+ * pool of worker threads, and the loop sends the responses once it is
+ * done. A client is not read from while its session is processing or its
+ * responses are being sent, which keeps the messages of a client in order.
+ * At most 1 MiB is read from a client before its session processes it,
+ * and a client that sends more than the largest message the sessions
+ * accept without completing a message is dropped. This bounds the memory
+ * a client can make the server buffer.
+ */
+class Server {
+ public:
+  /**
+   * Listen on the port (0 picks a free port, see GetPort()). thread_count
+   * is the number of worker threads, 0 means one per hardware thread.
+   */
+  Server(Database& database, uint16_t port, size_t thread_count,
+         SessionFactory factory);
+  ~Server();
+
+  Server(const Server&)            = delete;
+  Server& operator=(const Server&) = delete;
+
+  uint16_t GetPort() const { return port_; }
+
+  /**
+   * Serve the clients until Stop() is called.
+   */
+  void Run();
+  /**
+   * Make Run() return, closing all connections. Safe to call from any
+   * thread and from a signal handler.
+   */
+  void Stop();
+
+ private:
+  struct Client {
+    int fd;
+    std::unique_ptr<ServerSession> session;
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+    size_t written   = 0;
+    // owned by a worker thread while busy
+    bool busy        = false;
+    bool closed      = false;
+    // the peer has shut down its side, closed once the responses are sent
+    bool read_closed = false;
+  };
+
+  void Accept();
+  void Receive(Client& client);
+  void Send(Client& client);
+  void Submit(Client& client);
+  void Complete();
+  void Watch(Client& client, uint32_t events);
+  void Close(Client& client);
+  void Work();
+
+  Database& database_;
+  SessionFactory factory_;
+  size_t thread_count_;
+  uint16_t port_;
+  int listen_fd_;
+  int epoll_fd_;
+  int wake_fd_;
+  std::atomic<bool> stopped_;
+  std::unordered_map<int, std::unique_ptr<Client>> clients_;
+
+  std::mutex lock_;
+  std::condition_variable work_available_;
+  std::deque<Client*> work_;
+  /**
+   * The clients whose sessions are done, and whether they stay open.
+   */
+  std::vector<std::pair<Client*, bool>> completed_;
+  bool shutdown_ = false;
+};
+
+}  // namespace zoomdb
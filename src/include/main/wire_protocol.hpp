@@ -0,0 +1,97 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "main/server.hpp"
+#include "zoomdb.hpp"
+
+namespace zoomdb {
+
+/**
+ * The binary protocol of the ZoomDB server. Every message is a type byte
+ * followed by the size of its payload (4 bytes) and the payload. Integers
+ * are little endian.
+ *
+ * The client sends:
+ *   'Q' query      a flags byte (kWireCompressLZ4 to receive compressed
+ *                  chunks) followed by the text of a query
+ *   'X' terminate  no payload, the server closes the connection
+ *
+ * The server answers every query with an error, or with a header, the
+ * chunks of the result and a completion:
+ *   'E' error      the message
+ *   'T' header     the number of columns (4 bytes), then for every column
+ *                  its TypeId (1 byte) and the size (2 bytes) and bytes of
+ *                  its name
+ *   'D' chunk      a WireCompression byte, the size of the serialized chunk
+ *                  (4 bytes) and the chunk (see SerializeChunk()), possibly
+ *                  compressed
+ *   'C' complete   the number of rows of the result (8 bytes)
+ */
+enum class WireMessage : uint8_t {
+  kQuery     = 'Q',
+  kTerminate = 'X',
+  kError     = 'E',
+  kHeader    = 'T',
+  kChunk     = 'D',
+  kComplete  = 'C',
+};
+
+enum class WireCompression : uint8_t {
+  kNone = 0,
+  kLZ4  = 1,
+};
+
+constexpr uint8_t kWireCompressLZ4 = 1;
+/**
+ * The largest message the server accepts, a larger one closes the
+ * connection.
+ */
+constexpr uint32_t kWireMaxMessageSize = 64 << 20;
+
+/**
+ * Append the rows of the chunk to output: the number of rows (4 bytes),
+ * then for every column a bitmap of its NULLs (a bit per row, set for
+ * NULL) followed by its values. The values of fixed size types are stored
+ * as in a Vector, a VARCHAR as its size (4 bytes) and its bytes (none for
+ * NULL).
+ */
+void SerializeChunk(const DataChunk& chunk, std::vector<uint8_t>& output);
+
+/**
+ * Read a chunk serialized by SerializeChunk() into chunk, which must have
+ * been initialized with the types of its columns.
+ */
+void DeserializeChunk(const uint8_t* data, size_t size, DataChunk& chunk);
+
+/**
+ * Append the messages answering a query with the given result to output,
+ * compressing the chunks with LZ4 if compress is set.
+ */
+void WriteResult(const Result& result, bool compress,
+                 std::vector<uint8_t>& output);
+
+/**
+ * A client connection speaking the binary protocol above, with a
+ * Connection of its own.
+ */
+class WireSession : public ServerSession {
+ public:
+  explicit WireSession(Database& database);
+
+  bool Process(std::vector<uint8_t>& input,
+               std::vector<uint8_t>& output) override;
+
+ private:
+  Connection connection_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,45 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+
+namespace zoomdb {
+
+/**
+ * The file formats supported by COPY.
+ */
+enum class CopyFormat {
+  kCSV     = 0,
+  kParquet = 1,
+};
+
+/**
+ * The options of a COPY statement.
+ */
+struct CopyInfo {
+  std::string file_path;
+  CopyFormat format = CopyFormat::kCSV;
+  /**
+   * True for COPY ... FROM, false for COPY ... TO.
+   */
+  bool is_from   = true;
+  char delimiter = ',';
+  char quote     = '"';
+  /**
+   * The character escaping a quote inside a quoted field. By default a
+   * quote is escaped by doubling it, as in RFC 4180.
+   */
+  char escape = '"';
+  /**
+   * Whether the first line of the file holds the column names.
+   */
+  bool header = false;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,107 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+
+namespace zoomdb {
+
+class Vector;
+
+/**
+ * Evaluates a binary expression over count rows of its operand vectors into
+ * result, see ExpressionKernels.
+ */
+using ExpressionKernel = void (*)(const Vector& left, const Vector& right,
+                                  Vector& result, size_t count);
+
+/**
+ * Base class of all expressions. An expression is a tree, the operands of
+ * an expression are stored in its children.
+ */
+class Expression : public Printable {
+ public:
+  Expression(ExpressionType expression_type, TypeId result_type);
+  Expression(ExpressionType expression_type, TypeId result_type,
+             std::unique_ptr<Expression> left,
+             std::unique_ptr<Expression> right = nullptr);
+
+  /**
+   * Call the callback for every child of the expression.
+   */
+  void EnumerateChildren(const std::function<void(Expression& child)>& callback);
+  void EnumerateChildren(
+      const std::function<void(const Expression& child)>& callback) const;
+
+  /**
+   * Returns true if the expression (or one of its children) is an aggregate.
+   */
+  virtual bool IsAggregate() const;
+  /**
+   * Returns true if the expression (or one of its children) is a subquery.
+   */
+  virtual bool HasSubquery() const;
+  /**
+   * Returns true if the expression (or one of its children) is a window
+   * function.
+   */
+  virtual bool HasWindow() const;
+  /**
+   * Returns true if the expression does not reference any column, and can
+   * therefore be computed once.
+   */
+  virtual bool IsScalar() const;
+
+  /**
+   * Returns true if the expression and other compute the same result.
+   */
+  virtual bool Equals(const Expression* other) const;
+
+  /**
+   * Create a deep copy of the expression.
+   */
+  virtual std::unique_ptr<Expression> Copy() const = 0;
+
+  /**
+   * The name of the expression, used as the column name of results.
+   */
+  virtual std::string GetName() const;
+
+  std::string ToString() const override;
+
+  /**
+   * Compare two (possibly null) expressions for equality.
+   */
+  static bool Equals(const Expression* left, const Expression* right);
+
+  ExpressionType type;
+  TypeId return_type;
+  std::string alias;
+  std::vector<std::unique_ptr<Expression>> children;
+  /**
+   * The kernel specialized for the operand types, selected by the
+   * PhysicalPlanGenerator. If nullptr, the ExpressionExecutor interprets
+   * the expression.
+   */
+  ExpressionKernel kernel;
+
+ protected:
+  /**
+   * Copy the alias, the kernel and the children of this expression into
+   * other.
+   */
+  void CopyProperties(Expression& other) const;
+};
+
+}  // namespace zoomdb
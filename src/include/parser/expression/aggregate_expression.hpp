@@ -0,0 +1,48 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * An aggregate function: COUNT(*), COUNT(x), SUM(x), MIN(x), MAX(x), AVG(x)
+ * and the approximate APPROX_COUNT_DISTINCT(x) and APPROX_QUANTILE(x, q).
+ * The argument, if any, is the only child.
+ */
+class AggregateExpression : public Expression {
+ public:
+  AggregateExpression(ExpressionType aggregate,
+                      std::unique_ptr<Expression> child,
+                      bool is_distinct = false);
+
+  bool IsAggregate() const override { return true; }
+  bool IsScalar() const override { return false; }
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  std::string GetName() const override;
+  std::string ToString() const override;
+
+  /**
+   * Returns the result type of the aggregate for the given input type.
+   */
+  static TypeId GetReturnType(ExpressionType aggregate, TypeId input);
+  static bool IsAggregate(ExpressionType type);
+
+  /**
+   * Whether only distinct input values are aggregated, e.g. COUNT(DISTINCT x).
+   */
+  bool distinct;
+  /**
+   * The constant fraction q of APPROX_QUANTILE(x, q), between 0 and 1.
+   */
+  double quantile = 0;
+};
+
+}  // namespace zoomdb
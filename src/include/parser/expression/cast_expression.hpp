@@ -0,0 +1,25 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * CAST(child AS target), the target type is the return type.
+ */
+class CastExpression : public Expression {
+ public:
+  CastExpression(TypeId target, std::unique_ptr<Expression> child);
+
+  std::unique_ptr<Expression> Copy() const override;
+  std::string ToString() const override;
+};
+
+}  // namespace zoomdb
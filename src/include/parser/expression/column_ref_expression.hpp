@@ -0,0 +1,56 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/types/value.hpp"
+#include "parser/expression.hpp"
+#include "planner/column_binding.hpp"
+
+namespace zoomdb {
+
+/**
+ * A reference to a column. The parser only fills in the names, the binder
+ * resolves them into a binding and a type.
+ */
+class ColumnRefExpression : public Expression {
+ public:
+  explicit ColumnRefExpression(std::string column, std::string table = "");
+  ColumnRefExpression(TypeId column_type, ColumnBinding column_binding,
+                      size_t query_depth = 0);
+
+  bool IsScalar() const override { return false; }
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  std::string GetName() const override;
+  std::string ToString() const override;
+
+  std::string column_name;
+  std::string table_name;
+  ColumnBinding binding;
+  /**
+   * The number of subquery levels between the reference and the query that
+   * produces the column, 0 if the column belongs to the query itself.
+   */
+  size_t depth;
+  /**
+   * The position of the column in the input of the physical operator that
+   * evaluates the expression, set by the PhysicalPlanGenerator.
+   */
+  size_t index;
+  /**
+   * For a reference from a correlated subquery that runs once per row of
+   * the enclosing query, the values of the enclosing query's columns for
+   * the current row; index is the position in them. Set by the
+   * PhysicalPlanGenerator.
+   */
+  const std::vector<Value>* outer_values = nullptr;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,41 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * A comparison between two expressions, e.g. a = b or a < 5. The result is
+ * a BOOLEAN.
+ */
+class ComparisonExpression : public Expression {
+ public:
+  ComparisonExpression(ExpressionType comparison,
+                       std::unique_ptr<Expression> left,
+                       std::unique_ptr<Expression> right);
+
+  std::unique_ptr<Expression> Copy() const override;
+  std::string ToString() const override;
+
+  /**
+   * Returns the comparison with its operands swapped, i.e. a < b becomes
+   * b > a.
+   */
+  static ExpressionType FlipComparison(ExpressionType type);
+  /**
+   * Returns the comparison whose result is the negation, i.e. a < b becomes
+   * a >= b.
+   */
+  static ExpressionType NegateComparison(ExpressionType type);
+  static bool IsComparison(ExpressionType type);
+  static std::string ComparisonToString(ExpressionType type);
+};
+
+}  // namespace zoomdb
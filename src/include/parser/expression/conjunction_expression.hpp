@@ -0,0 +1,38 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * AND or OR of two BOOLEAN expressions.
+ */
+class ConjunctionExpression : public Expression {
+ public:
+  ConjunctionExpression(ExpressionType conjunction,
+                        std::unique_ptr<Expression> left,
+                        std::unique_ptr<Expression> right);
+
+  std::unique_ptr<Expression> Copy() const override;
+  std::string ToString() const override;
+
+  /**
+   * Split an expression into the list of its AND-ed terms.
+   */
+  static void Split(std::unique_ptr<Expression> expr,
+                    std::vector<std::unique_ptr<Expression>>& result);
+  /**
+   * Combine the expressions with AND, returns nullptr if the list is empty.
+   */
+  static std::unique_ptr<Expression> Combine(
+      std::vector<std::unique_ptr<Expression>> expressions);
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,29 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "common/types/value.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * A constant value, e.g. 57 or 'abc'.
+ */
+class ConstantExpression : public Expression {
+ public:
+  explicit ConstantExpression(Value constant);
+
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  std::string ToString() const override;
+
+  Value value;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,43 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * A call of a function by name, e.g. sum(x) or count(*). The arguments are
+ * the children. The binder looks the function up in the catalog and
+ * replaces the call by the expression that evaluates it.
+ */
+class FunctionExpression : public Expression {
+ public:
+  FunctionExpression(std::string schema, std::string name,
+                     std::vector<std::unique_ptr<Expression>> arguments,
+                     bool is_distinct = false, bool is_star = false);
+
+  bool IsScalar() const override { return false; }
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  std::string GetName() const override;
+  std::string ToString() const override;
+
+  std::string schema_name;
+  std::string function_name;
+  /**
+   * f(DISTINCT x)
+   */
+  bool distinct;
+  /**
+   * f(*), as in count(*)
+   */
+  bool star;
+};
+
+}  // namespace zoomdb
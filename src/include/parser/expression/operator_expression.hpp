@@ -0,0 +1,28 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * Arithmetic, logical and other built-in operators (+, -, NOT, IS NULL,
+ * IN (...), COALESCE, ...). The operands are stored in the children.
+ */
+class OperatorExpression : public Expression {
+ public:
+  OperatorExpression(ExpressionType op, TypeId result_type,
+                     std::unique_ptr<Expression> left  = nullptr,
+                     std::unique_ptr<Expression> right = nullptr);
+
+  std::unique_ptr<Expression> Copy() const override;
+  std::string ToString() const override;
+};
+
+}  // namespace zoomdb
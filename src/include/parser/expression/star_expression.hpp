@@ -0,0 +1,33 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * * or table.* in a select list, expanded into the columns of the FROM
+ * clause by the binder.
+ */
+class StarExpression : public Expression {
+ public:
+  explicit StarExpression(std::string relation = "");
+
+  bool IsScalar() const override { return false; }
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  std::string ToString() const override;
+
+  /**
+   * The table whose columns are selected, empty for all tables.
+   */
+  std::string relation_name;
+};
+
+}  // namespace zoomdb
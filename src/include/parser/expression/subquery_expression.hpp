@@ -0,0 +1,78 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/types/value.hpp"
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+class LogicalOperator;
+class PhysicalOperator;
+class SelectStatement;
+
+enum class SubqueryType {
+  kScalar = 0,  // (SELECT ...), produces a single value
+  kExists = 1,  // EXISTS (SELECT ...)
+  kAny    = 2,  // x IN (SELECT ...), x = ANY (SELECT ...)
+};
+
+/**
+ * A subquery used as an expression. The parser stores the subquery as a
+ * statement, which the binder replaces by its logical plan. Columns of the
+ * enclosing query that are referenced inside of it (correlated columns)
+ * have a depth larger than zero.
+ *
+ * For kAny subqueries the children hold the expressions that are compared
+ * against the columns produced by the subquery.
+ */
+class SubqueryExpression : public Expression {
+ public:
+  SubqueryExpression(SubqueryType kind, TypeId result_type,
+                     std::unique_ptr<LogicalOperator> subquery_plan);
+  SubqueryExpression(SubqueryType kind,
+                     std::unique_ptr<SelectStatement> subquery_statement);
+  ~SubqueryExpression() override;
+
+  bool HasSubquery() const override { return true; }
+  bool IsScalar() const override { return false; }
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  /**
+   * The name of a result column without alias, the plan is not part of it.
+   */
+  std::string GetName() const override;
+  std::string ToString() const override;
+
+  SubqueryType subquery_type;
+  /**
+   * The comparison used by kAny subqueries, kCompareEqual for IN.
+   */
+  ExpressionType comparison;
+  /**
+   * The subquery as parsed, until it is bound.
+   */
+  std::unique_ptr<SelectStatement> select;
+  std::unique_ptr<LogicalOperator> subquery;
+  /**
+   * The physical plan of the subquery, created by the PhysicalPlanGenerator
+   * and run by the ExpressionExecutor.
+   */
+  std::unique_ptr<PhysicalOperator> plan;
+  /**
+   * The columns of the enclosing query that a correlated subquery, which
+   * could not be flattened, references. The plan is run once per row, with
+   * their values for the row in correlated_values.
+   */
+  std::vector<std::unique_ptr<Expression>> correlated;
+  std::vector<Value> correlated_values;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,85 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * A boundary of the frame of a window function.
+ */
+enum class WindowBoundary : uint8_t {
+  kUnboundedPreceding = 0,
+  kOffsetPreceding    = 1,
+  kCurrentRow         = 2,
+  kOffsetFollowing    = 3,
+  kUnboundedFollowing = 4,
+};
+
+/**
+ * The sort order of an ORDER BY expression of a window.
+ */
+struct WindowOrder {
+  bool descending;
+  bool nulls_first;
+};
+
+/**
+ * An aggregate computed over a window of rows, e.g.
+ * SUM(x) OVER (PARTITION BY y ORDER BY z ROWS BETWEEN 2 PRECEDING AND
+ * CURRENT ROW). The first child is the aggregate (a FunctionExpression
+ * until it is bound), followed by the PARTITION BY and then the ORDER BY
+ * expressions.
+ */
+class WindowExpression : public Expression {
+ public:
+  explicit WindowExpression(std::unique_ptr<Expression> function);
+
+  /**
+   * Returns true if the arguments, partitions or orders of the window
+   * contain an aggregate; the function of the window itself does not count.
+   */
+  bool IsAggregate() const override;
+  bool HasWindow() const override { return true; }
+  bool IsScalar() const override { return false; }
+  bool Equals(const Expression* other) const override;
+  std::unique_ptr<Expression> Copy() const override;
+  std::string GetName() const override;
+  std::string ToString() const override;
+
+  Expression& GetFunction() const { return *children[0]; }
+  /**
+   * Returns true if other partitions and orders the rows like this window.
+   */
+  bool SameOrdering(const WindowExpression& other) const;
+
+  /**
+   * The number of PARTITION BY expressions, the ORDER BY expressions
+   * follow them; orders holds their sort orders.
+   */
+  size_t partition_count;
+  std::vector<WindowOrder> orders;
+  /**
+   * Whether the frame counts ROWS, otherwise the frame is a RANGE in which
+   * the current row stands for all of its peers.
+   */
+  bool rows;
+  WindowBoundary start;
+  WindowBoundary end;
+  /**
+   * The number of rows of kOffsetPreceding and kOffsetFollowing boundaries.
+   */
+  int64_t start_offset;
+  int64_t end_offset;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,73 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zoomdb {
+
+/**
+ * A JSON document, used to read the parse tree that libpg_query produces.
+ * The members of an object keep their order.
+ */
+class JSONValue {
+ public:
+  enum class Type : uint8_t {
+    kNull    = 0,
+    kBoolean = 1,
+    kNumber  = 2,
+    kString  = 3,
+    kArray   = 4,
+    kObject  = 5,
+  };
+
+  JSONValue();
+
+  /**
+   * Parse a JSON document, throws a ParserException if it is malformed.
+   */
+  static JSONValue Parse(const char* text);
+
+  Type GetType() const { return type_; }
+  bool IsObject() const { return type_ == Type::kObject; }
+  bool IsArray() const { return type_ == Type::kArray; }
+
+  /**
+   * Returns the member of an object with the given key, nullptr if there is
+   * no such member or this is not an object.
+   */
+  const JSONValue* Get(const std::string& key) const;
+
+  bool GetBoolean() const;
+  int64_t GetInteger() const;
+  /**
+   * Returns a string, or the text of a number.
+   */
+  const std::string& GetString() const;
+  /**
+   * The elements of an array, or the values of the members of an object.
+   */
+  const std::vector<JSONValue>& GetElements() const { return elements_; }
+  /**
+   * The keys of the members of an object.
+   */
+  const std::vector<std::string>& GetKeys() const { return keys_; }
+
+ private:
+  class Reader;
+
+  Type type_;
+  bool boolean_;
+  std::string string_;
+  std::vector<std::string> keys_;
+  std::vector<JSONValue> elements_;
+};
+
+}  // namespace zoomdb
@@ -7,13 +7,28 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include "parser/sql_statement.hpp"
+
 namespace zoomdb {
 
+/**
+ * Parser parses a query string with libpg_query and transforms the parse
+ * tree into statements.
+ */
 class Parser {
  public:
   Parser();
 
+  /**
+   * Parse the query into statements. Throws a ParserException on a syntax
+   * error.
+   */
   void ParseQuery(const char* query);
+
+  std::vector<std::unique_ptr<SQLStatement>> statements;
 };
 
 }  // namespace zoomdb
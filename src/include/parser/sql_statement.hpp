@@ -0,0 +1,28 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "common/internal-types.hpp"
+
+namespace zoomdb {
+
+/**
+ * Base class of the statements produced by the parser.
+ */
+class SQLStatement {
+ public:
+  explicit SQLStatement(StatementType statement_type) : type(statement_type) {}
+  virtual ~SQLStatement() = default;
+
+  SQLStatement(const SQLStatement&)            = delete;
+  SQLStatement& operator=(const SQLStatement&) = delete;
+
+  StatementType type;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,35 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "parser/sql_statement.hpp"
+
+namespace zoomdb {
+
+/**
+ * ANALYZE [table [, ...]]
+ */
+class AnalyzeStatement : public SQLStatement {
+ public:
+  struct Table {
+    std::string schema;
+    std::string name;
+  };
+
+  AnalyzeStatement() : SQLStatement(StatementType::kAnalyze) {}
+
+  /**
+   * The tables whose statistics are rebuilt, all tables if empty.
+   */
+  std::vector<Table> tables;
+};
+
+}  // namespace zoomdb
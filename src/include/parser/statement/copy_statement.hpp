@@ -0,0 +1,47 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser/copy_info.hpp"
+#include "parser/sql_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * COPY table [(columns)] FROM 'file' [(options)],
+ * COPY table [(columns)] TO 'file' [(options)] or
+ * COPY (SELECT ...) TO 'file' [(options)]
+ */
+class CopyStatement : public SQLStatement {
+ public:
+  CopyStatement() : SQLStatement(StatementType::kCopy) {}
+
+  std::string schema;
+  std::string table;
+  std::vector<std::string> columns;
+  /**
+   * The query whose result is written by COPY ... TO. The binder turns
+   * COPY table TO into a query over the table.
+   */
+  std::unique_ptr<SelectStatement> select;
+  CopyInfo info;
+
+  /**
+   * The table of COPY ... FROM, set by the binder.
+   */
+  TableCatalogEntry* table_entry = nullptr;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,45 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_entry.hpp"
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+#include "parser/sql_statement.hpp"
+
+namespace zoomdb {
+
+/**
+ * CREATE SCHEMA, CREATE TABLE and CREATE [UNIQUE] INDEX.
+ */
+class CreateStatement : public SQLStatement {
+ public:
+  explicit CreateStatement(CatalogType object_type)
+      : SQLStatement(StatementType::kCreate), object(object_type) {}
+
+  CatalogType object;
+  std::string schema;
+  std::string name;
+  bool if_not_exists = false;
+
+  /**
+   * The columns of a table.
+   */
+  std::vector<ColumnDefinition> columns;
+
+  /**
+   * The table and the columns of an index.
+   */
+  std::string table;
+  std::vector<std::string> index_columns;
+  bool unique = false;
+};
+
+}  // namespace zoomdb
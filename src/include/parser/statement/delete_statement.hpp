@@ -0,0 +1,42 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "parser/sql_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * DELETE FROM table [WHERE condition]
+ */
+class DeleteStatement : public SQLStatement {
+ public:
+  DeleteStatement() : SQLStatement(StatementType::kDelete) {}
+
+  std::string schema;
+  std::string table;
+  /**
+   * The WHERE clause, nullptr to delete all rows.
+   */
+  std::unique_ptr<Expression> condition;
+
+  /**
+   * Set by the binder: the table, and the query producing the row ids of
+   * the deleted rows, into which the condition is moved.
+   */
+  TableCatalogEntry* table_entry = nullptr;
+  std::unique_ptr<SelectStatement> select;
+};
+
+}  // namespace zoomdb
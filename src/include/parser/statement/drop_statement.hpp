@@ -0,0 +1,31 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+
+#include "catalog/catalog_entry.hpp"
+#include "parser/sql_statement.hpp"
+
+namespace zoomdb {
+
+/**
+ * DROP SCHEMA, DROP TABLE and DROP INDEX.
+ */
+class DropStatement : public SQLStatement {
+ public:
+  explicit DropStatement(CatalogType object_type)
+      : SQLStatement(StatementType::kDrop), object(object_type) {}
+
+  CatalogType object;
+  std::string schema;
+  std::string name;
+  bool if_exists = false;
+};
+
+}  // namespace zoomdb
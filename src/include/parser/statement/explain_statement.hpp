@@ -0,0 +1,33 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "parser/sql_statement.hpp"
+
+namespace zoomdb {
+
+/**
+ * EXPLAIN [ANALYZE] statement
+ */
+class ExplainStatement : public SQLStatement {
+ public:
+  ExplainStatement(std::unique_ptr<SQLStatement> explained, bool is_analyze)
+      : SQLStatement(StatementType::kExplain),
+        statement(std::move(explained)),
+        analyze(is_analyze) {}
+
+  std::unique_ptr<SQLStatement> statement;
+  /**
+   * Run the statement and show the metrics of every operator.
+   */
+  bool analyze;
+};
+
+}  // namespace zoomdb
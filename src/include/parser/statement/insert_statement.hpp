@@ -0,0 +1,46 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser/sql_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * INSERT INTO table [(columns)] VALUES (...), ... or
+ * INSERT INTO table [(columns)] SELECT ...
+ */
+class InsertStatement : public SQLStatement {
+ public:
+  InsertStatement() : SQLStatement(StatementType::kInsert) {}
+
+  std::string schema;
+  std::string table;
+  /**
+   * The inserted columns, empty for all columns of the table.
+   */
+  std::vector<std::string> columns;
+  std::vector<std::vector<std::unique_ptr<Expression>>> values;
+  std::unique_ptr<SelectStatement> select;
+
+  /**
+   * The table and the positions of the inserted columns, set by the
+   * binder.
+   */
+  TableCatalogEntry* table_entry = nullptr;
+  std::vector<size_t> column_ids;
+};
+
+}  // namespace zoomdb
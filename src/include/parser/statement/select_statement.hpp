@@ -0,0 +1,69 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser/expression.hpp"
+#include "parser/sql_statement.hpp"
+#include "parser/tableref.hpp"
+
+namespace zoomdb {
+
+/**
+ * SELECT [DISTINCT] select_list FROM from_table WHERE where_clause
+ * GROUP BY groups HAVING having
+ *
+ * The binder resolves the expressions in place and fills in the bound
+ * members below.
+ */
+class SelectStatement : public SQLStatement {
+ public:
+  SelectStatement() : SQLStatement(StatementType::kSelect) {}
+
+  std::vector<std::unique_ptr<Expression>> select_list;
+  std::unique_ptr<TableRef> from_table;
+  std::unique_ptr<Expression> where_clause;
+  std::vector<std::unique_ptr<Expression>> groups;
+  std::unique_ptr<Expression> having;
+  /**
+   * Whether the duplicate rows of the result are removed.
+   */
+  bool distinct = false;
+
+  /**
+   * Whether the query computes aggregates, set by the binder.
+   */
+  bool aggregated = false;
+  /**
+   * The table indexes of the groups, the aggregates, the window functions
+   * and the select list.
+   */
+  size_t group_index      = 0;
+  size_t aggregate_index  = 0;
+  size_t window_index     = 0;
+  size_t projection_index = 0;
+  /**
+   * The aggregates of the select list and the HAVING clause, which are
+   * replaced by references to aggregate_index.
+   */
+  std::vector<std::unique_ptr<Expression>> aggregates;
+  /**
+   * The window functions of the select list, which are computed after the
+   * aggregates and replaced by references to window_index.
+   */
+  std::vector<std::unique_ptr<Expression>> windows;
+  /**
+   * The names of the result columns.
+   */
+  std::vector<std::string> names;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,51 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser/sql_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * UPDATE table SET column = expression, ... [WHERE condition]
+ */
+class UpdateStatement : public SQLStatement {
+ public:
+  UpdateStatement() : SQLStatement(StatementType::kUpdate) {}
+
+  std::string schema;
+  std::string table;
+  /**
+   * The updated columns and their new values, expressions over the old
+   * values of the row.
+   */
+  std::vector<std::string> columns;
+  std::vector<std::unique_ptr<Expression>> expressions;
+  /**
+   * The WHERE clause, nullptr to update all rows.
+   */
+  std::unique_ptr<Expression> condition;
+
+  /**
+   * Set by the binder: the table, the positions of the updated columns,
+   * and the query producing the row id and the new values of every updated
+   * row, into which the expressions and the condition are moved.
+   */
+  TableCatalogEntry* table_entry = nullptr;
+  std::vector<size_t> column_ids;
+  std::unique_ptr<SelectStatement> select;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,41 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+
+namespace zoomdb {
+
+enum class TableReferenceType {
+  kInvalid       = 0,
+  kBaseTable     = 1,  // a table of the catalog
+  kJoin          = 2,  // left JOIN right ON condition
+  kCrossProduct  = 3,  // left, right
+  kSubquery      = 4,  // (SELECT ...) AS alias
+  kTableFunction = 5,  // a function producing a table, e.g. read_parquet()
+};
+
+/**
+ * Base class of the entries of a FROM clause.
+ */
+class TableRef {
+ public:
+  explicit TableRef(TableReferenceType ref_type) : type(ref_type) {}
+  virtual ~TableRef() = default;
+
+  TableRef(const TableRef&)            = delete;
+  TableRef& operator=(const TableRef&) = delete;
+
+  TableReferenceType type;
+  /**
+   * The name under which the columns of the reference can be addressed.
+   */
+  std::string alias;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,41 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "parser/tableref.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * A table of the catalog. The binder resolves the name into the table and
+ * collects the columns the query references.
+ */
+class BaseTableRef : public TableRef {
+ public:
+  BaseTableRef(std::string schema, std::string name)
+      : TableRef(TableReferenceType::kBaseTable),
+        schema_name(std::move(schema)),
+        table_name(std::move(name)) {}
+
+  std::string schema_name;
+  std::string table_name;
+
+  TableCatalogEntry* table = nullptr;
+  size_t table_index       = 0;
+  /**
+   * The referenced columns, as positions in the table. Column i of the
+   * binding of the table is column column_ids[i] of the table.
+   */
+  std::vector<size_t> column_ids;
+};
+
+}  // namespace zoomdb
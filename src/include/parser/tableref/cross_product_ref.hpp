@@ -0,0 +1,31 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "parser/tableref.hpp"
+
+namespace zoomdb {
+
+/**
+ * FROM left, right
+ */
+class CrossProductRef : public TableRef {
+ public:
+  CrossProductRef(std::unique_ptr<TableRef> left_ref,
+                  std::unique_ptr<TableRef> right_ref)
+      : TableRef(TableReferenceType::kCrossProduct),
+        left(std::move(left_ref)),
+        right(std::move(right_ref)) {}
+
+  std::unique_ptr<TableRef> left;
+  std::unique_ptr<TableRef> right;
+};
+
+}  // namespace zoomdb
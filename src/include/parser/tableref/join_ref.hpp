@@ -0,0 +1,31 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "common/internal-types.hpp"
+#include "parser/expression.hpp"
+#include "parser/tableref.hpp"
+
+namespace zoomdb {
+
+/**
+ * left [INNER | LEFT] JOIN right ON condition
+ */
+class JoinRef : public TableRef {
+ public:
+  JoinRef() : TableRef(TableReferenceType::kJoin) {}
+
+  std::unique_ptr<TableRef> left;
+  std::unique_ptr<TableRef> right;
+  std::unique_ptr<Expression> condition;
+  JoinType join_type = JoinType::kInner;
+};
+
+}  // namespace zoomdb
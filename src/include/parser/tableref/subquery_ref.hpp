@@ -0,0 +1,30 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "parser/statement/select_statement.hpp"
+#include "parser/tableref.hpp"
+
+namespace zoomdb {
+
+/**
+ * (SELECT ...) AS alias. The columns of the reference are the columns of
+ * the subquery, bound to its projection.
+ */
+class SubqueryRef : public TableRef {
+ public:
+  explicit SubqueryRef(std::unique_ptr<SelectStatement> statement)
+      : TableRef(TableReferenceType::kSubquery),
+        subquery(std::move(statement)) {}
+
+  std::unique_ptr<SelectStatement> subquery;
+};
+
+}  // namespace zoomdb
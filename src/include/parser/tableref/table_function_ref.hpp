@@ -0,0 +1,43 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "parser/expression.hpp"
+#include "parser/tableref.hpp"
+#include "storage/parquet/parquet_reader.hpp"
+
+namespace zoomdb {
+
+/**
+ * A call of a table function in the FROM clause, e.g.
+ * read_parquet('file.parquet'). The binder opens the file.
+ */
+class TableFunctionRef : public TableRef {
+ public:
+  explicit TableFunctionRef(std::unique_ptr<Expression> function_call)
+      : TableRef(TableReferenceType::kTableFunction),
+        function(std::move(function_call)) {}
+
+  std::unique_ptr<Expression> function;
+
+  std::shared_ptr<const ParquetReader> reader;
+  /**
+   * The number of row groups the scan prefetches, see PhysicalParquetScan.
+   */
+  size_t prefetch_depth = ParquetReader::kDefaultPrefetchDepth;
+  size_t table_index    = 0;
+  /**
+   * The referenced columns, as positions in the file.
+   */
+  std::vector<size_t> column_ids;
+};
+
+}  // namespace zoomdb
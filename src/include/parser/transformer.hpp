@@ -0,0 +1,108 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser/expression.hpp"
+#include "parser/json_value.hpp"
+#include "parser/sql_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+#include "parser/tableref.hpp"
+
+namespace zoomdb {
+
+/**
+ * Transformer turns the parse tree produced by libpg_query, a JSON document
+ * in the format of the Postgres 16 grammar, into statements. Every node of
+ * the tree is an object with a single member named after the node type,
+ * e.g. {"SelectStmt": {...}}.
+ *
+ * Constructs the rest of the system cannot handle are rejected with a
+ * NotImplementationException, so they never silently change meaning.
+ */
+class Transformer {
+ public:
+  /**
+   * Transform the statements of the parse tree into statements.
+   */
+  void TransformParseTree(const JSONValue& tree,
+                          std::vector<std::unique_ptr<SQLStatement>>& result);
+
+ private:
+  std::unique_ptr<SQLStatement> TransformStatement(const JSONValue& node);
+  std::unique_ptr<SelectStatement> TransformSelect(const JSONValue& node);
+  std::unique_ptr<SQLStatement> TransformCreateTable(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformCreateIndex(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformCreateSchema(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformDrop(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformInsert(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformUpdate(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformDelete(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformCopy(const JSONValue& stmt);
+  std::unique_ptr<SQLStatement> TransformExplain(const JSONValue& stmt);
+  /**
+   * Transform ANALYZE, which libpg_query parses as a VacuumStmt.
+   */
+  std::unique_ptr<SQLStatement> TransformAnalyze(const JSONValue& stmt);
+
+  /**
+   * Transform the list of a FROM clause, multiple entries form a cross
+   * product.
+   */
+  std::unique_ptr<TableRef> TransformFrom(const JSONValue& list);
+  std::unique_ptr<TableRef> TransformTableRef(const JSONValue& node);
+
+  std::unique_ptr<Expression> TransformExpression(const JSONValue& node);
+  void TransformExpressionList(
+      const JSONValue& list, std::vector<std::unique_ptr<Expression>>& result);
+  std::unique_ptr<Expression> TransformColumnRef(const JSONValue& node);
+  std::unique_ptr<Expression> TransformConstant(const JSONValue& node);
+  std::unique_ptr<Expression> TransformAExpr(const JSONValue& node);
+  std::unique_ptr<Expression> TransformBoolExpr(const JSONValue& node);
+  std::unique_ptr<Expression> TransformFuncCall(const JSONValue& node);
+  /**
+   * Wrap the aggregate function into the window of its OVER clause.
+   */
+  std::unique_ptr<Expression> TransformWindow(
+      const JSONValue& over, std::unique_ptr<Expression> function);
+  int64_t TransformFrameOffset(const JSONValue& over, const char* key);
+  std::unique_ptr<Expression> TransformSubLink(const JSONValue& node);
+  std::unique_ptr<Expression> TransformCase(const JSONValue& node);
+
+  static TypeId TransformTypeName(const JSONValue& type_name);
+
+  /**
+   * Returns the type of a node, e.g. "SelectStmt".
+   */
+  static const std::string& NodeType(const JSONValue& node);
+  /**
+   * Returns the fields of a node.
+   */
+  static const JSONValue& NodeFields(const JSONValue& node);
+  /**
+   * Returns the value of a String node.
+   */
+  static std::string StringNode(const JSONValue& node);
+  /**
+   * Field accessors. libpg_query leaves out fields that hold their default
+   * value (false, 0, empty), so a missing field yields the default.
+   */
+  static std::string GetString(const JSONValue& fields, const char* key);
+  static bool GetBoolean(const JSONValue& fields, const char* key);
+  static int64_t GetInteger(const JSONValue& fields, const char* key);
+  /**
+   * Returns the elements of a list field, an empty list if it is missing.
+   */
+  static const std::vector<JSONValue>& GetList(const JSONValue& fields,
+                                               const char* key);
+};
+
+}  // namespace zoomdb
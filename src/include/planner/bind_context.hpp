@@ -0,0 +1,74 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "parser/expression.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+
+namespace zoomdb {
+
+/**
+ * The columns of a table reference of the FROM clause, addressed by alias.
+ */
+struct Binding {
+  std::string alias;
+  size_t table_index;
+  std::vector<std::string> names;
+  std::vector<TypeId> types;
+  /**
+   * The columns read from a base table or a file, as positions in the
+   * source. Only referenced columns are read: column i of the binding is
+   * column (*column_ids)[i] of the source. Null if the source produces all
+   * its columns, e.g. a subquery.
+   */
+  std::vector<size_t>* column_ids;
+};
+
+/**
+ * BindContext holds the table references visible in a query and resolves
+ * column names against them.
+ */
+class BindContext {
+ public:
+  /**
+   * Add a table reference. Throws a BinderException if the alias is in use.
+   */
+  void AddBinding(std::string alias, size_t table_index,
+                  std::vector<std::string> names, std::vector<TypeId> types,
+                  std::vector<size_t>* column_ids = nullptr);
+
+  /**
+   * Returns the bound column reference for ref, or nullptr if no table
+   * reference has the column. Throws a BinderException if the column name
+   * is ambiguous.
+   */
+  std::unique_ptr<Expression> BindColumn(const ColumnRefExpression& ref,
+                                         size_t depth);
+
+  /**
+   * Append references to all columns of the given table reference (all
+   * table references if relation is empty) to result, for SELECT *.
+   */
+  void ExpandStar(const std::string& relation,
+                  std::vector<std::unique_ptr<Expression>>& result);
+
+  bool HasBindings() const { return !bindings_.empty(); }
+
+ private:
+  std::unique_ptr<Expression> BindColumn(Binding& binding, size_t column,
+                                         size_t depth);
+
+  std::vector<Binding> bindings_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,133 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/catalog.hpp"
+#include "parser/statement/copy_statement.hpp"
+#include "parser/statement/delete_statement.hpp"
+#include "parser/statement/insert_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+#include "parser/statement/update_statement.hpp"
+#include "parser/tableref.hpp"
+#include "planner/bind_context.hpp"
+#include "storage/parquet/parquet_file_cache.hpp"
+
+namespace zoomdb {
+
+/**
+ * Binder resolves the names of a statement against the catalog, as of the
+ * given catalog timestamp. Afterwards every column reference holds the
+ * binding of the column it refers to and every expression has its result
+ * type; the executor never looks at a name.
+ *
+ * Operands of different types are converted with the implicit casts of
+ * SQL-92: numbers are promoted to the wider type (TINYINT < SMALLINT <
+ * INTEGER < BIGINT < DECIMAL), a DATE compared with a TIMESTAMP becomes a
+ * TIMESTAMP, and a string literal takes the type of the other operand. Any
+ * other combination raises a TypeMismatchException. Constants are cast
+ * once during binding, other expressions are wrapped in a cast.
+ *
+ * Subqueries are bound by a child binder, whose columns shadow those of
+ * the parent, and are planned right away.
+ */
+class Binder {
+ public:
+  /**
+   * Columns of the parent that are referenced by the statement become
+   * correlated columns. A binder without access to the parent only shares
+   * its table indexes, e.g. for a subquery in the FROM clause.
+   */
+  Binder(Catalog& catalog, uint64_t timestamp, Binder* parent = nullptr,
+         bool access_parent = true);
+  /**
+   * A binder for a whole statement that opens Parquet files through the
+   * cache, if there is one. Its child binders use the same cache.
+   */
+  Binder(Catalog& catalog, uint64_t timestamp,
+         ParquetFileCache* parquet_cache);
+
+  void Bind(SelectStatement& statement);
+  void Bind(InsertStatement& statement);
+  void Bind(UpdateStatement& statement);
+  void Bind(DeleteStatement& statement);
+  void Bind(CopyStatement& statement);
+
+  /**
+   * Returns a table index that is unique within the whole query.
+   */
+  size_t GenerateTableIndex();
+  ParquetFileCache* GetParquetCache() const;
+
+  /**
+   * Convert the (bound) expression to the target type. A constant is cast
+   * in place, other expressions are wrapped in a cast.
+   */
+  static void CastTo(std::unique_ptr<Expression>& expr, TypeId target);
+
+ private:
+  void BindTableRef(TableRef& ref);
+  /**
+   * Create and bind the query over the table that produces the row ids of
+   * the rows satisfying the condition (all rows if it is nullptr), as the
+   * first entry of its select list.
+   */
+  std::unique_ptr<SelectStatement> BindRowIdQuery(
+      const std::string& schema, const std::string& table,
+      std::unique_ptr<Expression> condition);
+  void BindGroups(SelectStatement& statement);
+  /**
+   * Move the aggregates of the expression into statement.aggregates and
+   * replace them (and the expressions that match a group) by references.
+   */
+  void BindAggregates(std::unique_ptr<Expression>& expr,
+                      SelectStatement& statement);
+  /**
+   * Move the window functions of the expression into statement.windows and
+   * replace them by references.
+   */
+  void BindWindows(std::unique_ptr<Expression>& expr,
+                   SelectStatement& statement);
+
+  /**
+   * Bind the expression and its children in place. Aggregates are only
+   * bound if allowed.
+   */
+  void BindExpression(std::unique_ptr<Expression>& expr,
+                      bool allow_aggregates = false);
+  void BindColumnRef(std::unique_ptr<Expression>& expr);
+  void BindFunction(std::unique_ptr<Expression>& expr, bool allow_aggregates);
+  /**
+   * Bind a window function, which is allowed wherever aggregates are.
+   */
+  void BindWindow(std::unique_ptr<Expression>& expr, bool allow_aggregates);
+  void BindSubquery(std::unique_ptr<Expression>& expr);
+  /**
+   * Compute the result type of an operator from its (bound) children,
+   * inserting the implicit casts its operands need.
+   */
+  void ResolveType(Expression& expr);
+
+  /**
+   * Bind a condition (WHERE, HAVING, ON), which must be a BOOLEAN.
+   */
+  void BindCondition(std::unique_ptr<Expression>& expr, const char* clause,
+                     bool allow_aggregates = false);
+
+  Catalog& catalog_;
+  uint64_t timestamp_;
+  Binder* parent_;
+  bool access_parent_;
+  BindContext context_;
+  size_t next_table_index_;
+  ParquetFileCache* parquet_cache_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,39 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace zoomdb {
+
+/**
+ * Identifies a column produced somewhere in a plan. Every operator that
+ * introduces new columns (a table scan, a projection, an aggregate, ...) is
+ * assigned a table index that is unique within the query, its columns are
+ * numbered from zero.
+ */
+struct ColumnBinding {
+  static constexpr size_t kInvalidIndex = std::numeric_limits<size_t>::max();
+
+  size_t table_index  = kInvalidIndex;
+  size_t column_index = kInvalidIndex;
+
+  ColumnBinding() = default;
+  ColumnBinding(size_t table, size_t column)
+      : table_index(table), column_index(column) {}
+
+  bool IsValid() const { return table_index != kInvalidIndex; }
+
+  bool operator==(const ColumnBinding& rhs) const {
+    return table_index == rhs.table_index && column_index == rhs.column_index;
+  }
+  bool operator!=(const ColumnBinding& rhs) const { return !(*this == rhs); }
+};
+
+}  // namespace zoomdb
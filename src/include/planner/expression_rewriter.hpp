@@ -0,0 +1,61 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * ExpressionRewriter simplifies the (bound) expressions of a plan, so that
+ * the executor does not compute for every row what can be computed once:
+ *
+ *   1 - 0.0, CAST('2024-01-01' AS DATE)  -> constant (folded)
+ *   x + 0, x * 1, x / 1                  -> x
+ *   x + NULL, x < NULL                   -> NULL
+ *   x AND TRUE, x OR FALSE               -> x
+ *   x AND FALSE, x OR TRUE               -> FALSE, TRUE
+ *   NOT NOT x, NOT (a < b)               -> x, a >= b
+ *   COALESCE(x, NULL, 1, y)              -> COALESCE(x, 1)
+ *   CASE WHEN TRUE THEN x ELSE y END     -> x
+ *   5 < a                                -> a > 5
+ *
+ * NULLIF is turned into a CASE by the transformer, so it is simplified
+ * like one. Terms of a filter that are always true are removed, and so is
+ * a filter without terms. An expression whose evaluation fails (e.g.
+ * 1 / 0) is left alone: it may never be evaluated, e.g. in a CASE branch.
+ */
+class ExpressionRewriter {
+ public:
+  std::unique_ptr<LogicalOperator> Rewrite(std::unique_ptr<LogicalOperator> op);
+
+  /**
+   * Simplify the expression and its children in place.
+   */
+  void Simplify(std::unique_ptr<Expression>& expr);
+
+ private:
+  void RewriteOperator(std::unique_ptr<LogicalOperator>& op);
+  void RewriteFilter(std::unique_ptr<LogicalOperator>& op);
+
+  /**
+   * Replace the expression by its value if it does not depend on a row.
+   * Returns true if it was replaced.
+   */
+  bool Fold(std::unique_ptr<Expression>& expr);
+  void SimplifyArithmetic(std::unique_ptr<Expression>& expr);
+  void SimplifyComparison(std::unique_ptr<Expression>& expr);
+  void SimplifyConjunction(std::unique_ptr<Expression>& expr);
+  void SimplifyNot(std::unique_ptr<Expression>& expr);
+  void SimplifyCoalesce(std::unique_ptr<Expression>& expr);
+  void SimplifyCase(std::unique_ptr<Expression>& expr);
+};
+
+}  // namespace zoomdb
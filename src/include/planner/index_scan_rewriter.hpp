@@ -0,0 +1,45 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * IndexScanRewriter replaces the table scan below a filter by an index
+ * scan, if the filter compares the first column of an index of the table
+ * with constants (=, <, <=, >, >=) and the column statistics estimate that
+ * the resulting range holds few rows:
+ *
+ *   FILTER[a >= 5, a < 10, b = 1]       FILTER[b = 1]
+ *     GET[t]                       ->     INDEX_SCAN[t idx_a [5, 10)]
+ *
+ * The comparisons covered by the range are removed from the filter, the
+ * filter is removed if none remain. Equality lookups in a unique index
+ * always use the index.
+ */
+class IndexScanRewriter {
+ public:
+  /**
+   * The largest estimated fraction of the rows of the table for which an
+   * index scan is used. Above it, the random accesses of the index scan
+   * cost more than scanning the whole table sequentially.
+   */
+  static constexpr double kMaxSelectivity = 0.05;
+
+  std::unique_ptr<LogicalOperator> Rewrite(std::unique_ptr<LogicalOperator> op);
+
+ private:
+  void RewriteOperator(std::unique_ptr<LogicalOperator>& op);
+  void RewriteFilter(std::unique_ptr<LogicalOperator>& op);
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,103 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+#include "parser/expression.hpp"
+#include "planner/column_binding.hpp"
+
+namespace zoomdb {
+
+enum class LogicalOperatorType {
+  kInvalid             = 0,
+  kGet                 = 1,
+  kFilter              = 2,
+  kProjection          = 3,
+  kAggregateAndGroupBy = 4,
+  kJoin                = 5,
+  kCrossProduct        = 6,
+  kIndexScan           = 7,
+  kInsert              = 8,
+  kCopyFromFile        = 9,
+  kCopyToFile          = 10,
+  kParquetScan         = 11,
+  kUpdate              = 12,
+  kDelete              = 13,
+  kWindow              = 14,
+  kDistinct            = 15,
+};
+
+std::string LogicalOperatorTypeToString(LogicalOperatorType type);
+
+/**
+ * A node of the logical query plan. Logical operators describe what is
+ * computed, the physical plan generator decides how.
+ *
+ * The columns produced by an operator are identified by ColumnBindings, so
+ * operators can be moved around the plan without renumbering the column
+ * references of the operators above them.
+ */
+class LogicalOperator : public Printable {
+ public:
+  explicit LogicalOperator(LogicalOperatorType operator_type);
+  ~LogicalOperator() override = default;
+
+  LogicalOperatorType GetType() const { return type_; }
+
+  /**
+   * Returns the bindings of the columns produced by this operator.
+   */
+  virtual std::vector<ColumnBinding> GetColumnBindings() const = 0;
+
+  using ExpressionCallback =
+      std::function<void(std::unique_ptr<Expression>& expression)>;
+
+  /**
+   * Call the callback for every expression of this operator (not of its
+   * children). The callback may replace the expression.
+   */
+  virtual void EnumerateExpressions(const ExpressionCallback& callback);
+
+  /**
+   * Resolve the types of this operator and all its children.
+   */
+  void ResolveOperatorTypes();
+
+  /**
+   * Returns the operator specific information shown by ToString().
+   */
+  virtual std::string ParamsToString() const;
+  std::string ToString() const override;
+
+  void AddChild(std::unique_ptr<LogicalOperator> child);
+
+  /**
+   * The result types of the operator, set by ResolveOperatorTypes().
+   */
+  std::vector<TypeId> types;
+  std::vector<std::unique_ptr<LogicalOperator>> children;
+  std::vector<std::unique_ptr<Expression>> expressions;
+
+ protected:
+  /**
+   * Compute the result types of this operator from the types of its
+   * children.
+   */
+  virtual void ResolveTypes() = 0;
+
+ private:
+  LogicalOperatorType type_;
+};
+
+}  // namespace zoomdb
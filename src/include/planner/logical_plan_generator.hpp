@@ -0,0 +1,45 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "parser/statement/copy_statement.hpp"
+#include "parser/statement/delete_statement.hpp"
+#include "parser/statement/insert_statement.hpp"
+#include "parser/statement/select_statement.hpp"
+#include "parser/statement/update_statement.hpp"
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalPlanGenerator turns a bound statement into a logical plan. The
+ * statement is consumed: its expressions are moved into the plan.
+ *
+ * A SELECT becomes scan -> filter (WHERE) -> aggregate -> filter (HAVING)
+ * -> projection. The ON condition of a join is split into the comparisons
+ * between the two sides, which become the join conditions, and the
+ * remaining terms, which become a filter above an inner join.
+ *
+ * An UPDATE or DELETE becomes an operator over the query producing the row
+ * ids of the affected rows (and their new values).
+ */
+class LogicalPlanGenerator {
+ public:
+  std::unique_ptr<LogicalOperator> CreatePlan(SelectStatement& statement);
+  std::unique_ptr<LogicalOperator> CreatePlan(InsertStatement& statement);
+  std::unique_ptr<LogicalOperator> CreatePlan(UpdateStatement& statement);
+  std::unique_ptr<LogicalOperator> CreatePlan(DeleteStatement& statement);
+  std::unique_ptr<LogicalOperator> CreatePlan(CopyStatement& statement);
+
+ private:
+  std::unique_ptr<LogicalOperator> CreatePlan(TableRef& ref);
+};
+
+}  // namespace zoomdb
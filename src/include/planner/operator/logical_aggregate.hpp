@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalAggregate computes the aggregates stored in its expressions,
+ * grouped by the groups. It produces the groups (bound to group_index)
+ * followed by the aggregates (bound to aggregate_index).
+ */
+class LogicalAggregate : public LogicalOperator {
+ public:
+  LogicalAggregate(size_t group_table_index, size_t aggregate_table_index,
+                   std::vector<std::unique_ptr<Expression>> aggregates);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  void EnumerateExpressions(const ExpressionCallback& callback) override;
+  std::string ParamsToString() const override;
+
+  size_t group_index;
+  size_t aggregate_index;
+  std::vector<std::unique_ptr<Expression>> groups;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,35 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/copy_info.hpp"
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * LogicalCopyFromFile loads a file into a table and produces the number of
+ * rows loaded.
+ */
+class LogicalCopyFromFile : public LogicalOperator {
+ public:
+  LogicalCopyFromFile(TableCatalogEntry* table_entry, CopyInfo copy_info);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  TableCatalogEntry* table;
+  CopyInfo info;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
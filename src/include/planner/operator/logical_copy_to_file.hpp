@@ -0,0 +1,33 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "parser/copy_info.hpp"
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalCopyToFile writes the rows of its child to a file and produces
+ * the number of rows written.
+ */
+class LogicalCopyToFile : public LogicalOperator {
+ public:
+  LogicalCopyToFile(CopyInfo copy_info, std::vector<std::string> column_names);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  CopyInfo info;
+  std::vector<std::string> names;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
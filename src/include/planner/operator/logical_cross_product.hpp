@@ -0,0 +1,28 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalCrossProduct combines every row of the left child with every row
+ * of the right child.
+ */
+class LogicalCrossProduct : public LogicalOperator {
+ public:
+  LogicalCrossProduct();
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,33 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * LogicalDelete deletes the rows of a table whose row ids its child
+ * produces. It produces the number of rows deleted.
+ */
+class LogicalDelete : public LogicalOperator {
+ public:
+  explicit LogicalDelete(TableCatalogEntry* table_entry);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  TableCatalogEntry* table;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
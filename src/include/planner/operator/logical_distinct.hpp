@@ -0,0 +1,29 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalDistinct removes the duplicate rows of its child, as in SELECT
+ * DISTINCT. Two rows are duplicates if all of their columns are equal,
+ * NULLs included.
+ */
+class LogicalDistinct : public LogicalOperator {
+ public:
+  LogicalDistinct();
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,34 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalFilter keeps the rows of its child for which all of its
+ * expressions are true. The filter condition is stored split into its
+ * AND-ed terms.
+ */
+class LogicalFilter : public LogicalOperator {
+ public:
+  explicit LogicalFilter(std::unique_ptr<Expression> expression = nullptr);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+
+  /**
+   * Add an expression, splitting it into its AND-ed terms.
+   */
+  void AddFilter(std::unique_ptr<Expression> expression);
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,39 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+
+/**
+ * LogicalGet scans the given columns of a base table.
+ */
+class LogicalGet : public LogicalOperator {
+ public:
+  LogicalGet(DataTable* data_table, std::string name, size_t index,
+             std::vector<size_t> columns);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  DataTable* table;
+  std::string table_name;
+  size_t table_index;
+  /**
+   * The indexes of the scanned columns in the table.
+   */
+  std::vector<size_t> column_ids;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
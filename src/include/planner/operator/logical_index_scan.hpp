@@ -0,0 +1,50 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "common/types/value.hpp"
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class DataTable;
+class Index;
+
+/**
+ * LogicalIndexScan scans the given columns of the rows of a base table
+ * whose first indexed column lies between lower and upper, looking the
+ * rows up in an index. A NULL bound is unbounded.
+ */
+class LogicalIndexScan : public LogicalOperator {
+ public:
+  LogicalIndexScan(DataTable* data_table, std::string name,
+                   size_t binding_index, std::vector<size_t> columns,
+                   Index& scan_index);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  DataTable* table;
+  std::string table_name;
+  size_t table_index;
+  /**
+   * The indexes of the scanned columns in the table.
+   */
+  std::vector<size_t> column_ids;
+  Index& index;
+
+  Value lower;
+  bool lower_inclusive;
+  Value upper;
+  bool upper_inclusive;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,40 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * LogicalInsert appends rows to a table: the rows of the VALUES list, or
+ * the rows of its child. It produces the number of rows inserted.
+ */
+class LogicalInsert : public LogicalOperator {
+ public:
+  LogicalInsert(TableCatalogEntry* table_entry, std::vector<size_t> columns);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  void EnumerateExpressions(const ExpressionCallback& callback) override;
+  std::string ParamsToString() const override;
+
+  TableCatalogEntry* table;
+  /**
+   * The positions of the inserted columns in the table, the other columns
+   * are NULL.
+   */
+  std::vector<size_t> column_ids;
+  std::vector<std::vector<std::unique_ptr<Expression>>> insert_values;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
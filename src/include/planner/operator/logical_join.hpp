@@ -0,0 +1,53 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * A condition of a join: left <comparison> right, where left only
+ * references columns of the left child and right only columns of the right
+ * child.
+ *
+ * In a MARK join, a null_aware condition follows the semantics of IN: if a
+ * row has no match but the condition was NULL for one of the right rows,
+ * the mark is NULL rather than false.
+ */
+struct JoinCondition {
+  std::unique_ptr<Expression> left;
+  std::unique_ptr<Expression> right;
+  ExpressionType comparison = ExpressionType::kInvalid;
+  bool null_aware           = false;
+};
+
+/**
+ * LogicalJoin joins its two children on a set of conditions.
+ *
+ * SEMI and ANTI joins only produce the columns of the left child. A MARK
+ * join produces the columns of the left child and a BOOLEAN column (bound
+ * to mark_index) that tells whether the row has a match.
+ */
+class LogicalJoin : public LogicalOperator {
+ public:
+  explicit LogicalJoin(JoinType type);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  void EnumerateExpressions(const ExpressionCallback& callback) override;
+  std::string ParamsToString() const override;
+
+  JoinType join_type;
+  std::vector<JoinCondition> conditions;
+  size_t mark_index;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,42 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+#include "storage/parquet/parquet_reader.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalParquetScan produces the given columns of a Parquet file. Its
+ * expressions are copies of the comparisons of a column with a constant in
+ * the filter above the scan; they are only used to skip row groups, the
+ * filter still evaluates them.
+ */
+class LogicalParquetScan : public LogicalOperator {
+ public:
+  LogicalParquetScan(std::shared_ptr<const ParquetReader> parquet_reader,
+                     size_t index, std::vector<size_t> columns,
+                     size_t prefetch);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  std::shared_ptr<const ParquetReader> reader;
+  size_t table_index;
+  /**
+   * The indexes of the scanned columns in the file.
+   */
+  std::vector<size_t> column_ids;
+  size_t prefetch_depth;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
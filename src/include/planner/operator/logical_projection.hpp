@@ -0,0 +1,31 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalProjection computes its expressions for every row of its child.
+ */
+class LogicalProjection : public LogicalOperator {
+ public:
+  LogicalProjection(size_t index,
+                    std::vector<std::unique_ptr<Expression>> select_list);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  size_t table_index;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
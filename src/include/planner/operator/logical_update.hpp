@@ -0,0 +1,38 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+class TableCatalogEntry;
+
+/**
+ * LogicalUpdate overwrites columns of rows of a table. Its child produces
+ * the row id of every updated row followed by the new values. It produces
+ * the number of rows updated.
+ */
+class LogicalUpdate : public LogicalOperator {
+ public:
+  LogicalUpdate(TableCatalogEntry* table_entry, std::vector<size_t> columns);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+  std::string ParamsToString() const override;
+
+  TableCatalogEntry* table;
+  /**
+   * The positions of the updated columns in the table.
+   */
+  std::vector<size_t> column_ids;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
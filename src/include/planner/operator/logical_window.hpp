@@ -0,0 +1,32 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+/**
+ * LogicalWindow computes the window functions stored in its expressions
+ * over the rows of its child. It produces the columns of the child followed
+ * by the window functions (bound to window_index).
+ */
+class LogicalWindow : public LogicalOperator {
+ public:
+  LogicalWindow(size_t window_table_index,
+                std::vector<std::unique_ptr<Expression>> windows);
+
+  std::vector<ColumnBinding> GetColumnBindings() const override;
+
+  size_t window_index;
+
+ protected:
+  void ResolveTypes() override;
+};
+
+}  // namespace zoomdb
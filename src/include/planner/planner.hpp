@@ -0,0 +1,52 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog.hpp"
+#include "parser/sql_statement.hpp"
+#include "planner/logical_operator.hpp"
+#include "storage/parquet/parquet_file_cache.hpp"
+
+namespace zoomdb {
+
+/**
+ * Planner creates the logical plan of a SELECT, INSERT, UPDATE, DELETE or
+ * COPY statement: the statement is bound, turned into a plan, and the plan
+ * is rewritten (expressions are simplified, subqueries are flattened into
+ * joins, selective filters use indexes).
+ */
+class Planner {
+ public:
+  /**
+   * Parquet files are opened through the cache, if there is one.
+   */
+  Planner(Catalog& catalog, uint64_t timestamp,
+          ParquetFileCache* parquet_cache = nullptr);
+
+  /**
+   * Plan the statement, which is consumed.
+   */
+  void CreatePlan(SQLStatement& statement);
+
+  std::unique_ptr<LogicalOperator> plan;
+  /**
+   * The names of the result columns.
+   */
+  std::vector<std::string> names;
+
+ private:
+  Catalog& catalog_;
+  uint64_t timestamp_;
+  ParquetFileCache* parquet_cache_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,85 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "parser/expression/subquery_expression.hpp"
+#include "planner/operator/logical_join.hpp"
+
+namespace zoomdb {
+
+/**
+ * SubqueryRewriter flattens the subqueries used in filters and projections
+ * into joins, so that a correlated subquery is evaluated once instead of
+ * once for every row of the outer query:
+ *
+ *   WHERE EXISTS (SELECT ...)          -> SEMI join
+ *   WHERE NOT EXISTS (SELECT ...)      -> ANTI join
+ *   WHERE x IN (SELECT ...)            -> SEMI join on x = column
+ *   x NOT IN (SELECT ...), EXISTS or   -> MARK join, the subquery is
+ *   IN anywhere else                      replaced by the mark column
+ *   (SELECT AGG(...) ... WHERE y = o)  -> LEFT join with the aggregate
+ *                                         grouped by y, on y = o
+ *
+ * The predicates of the subquery that reference the outer query become the
+ * conditions of the join. They are pulled up through the filters,
+ * projections and (for scalar subqueries, only equalities) the aggregate
+ * of the subquery. Subqueries that do not fit these patterns, as well as
+ * uncorrelated scalar subqueries, are left unchanged; a correlated one is
+ * then run once per row of the outer query.
+ */
+class SubqueryRewriter {
+ public:
+  SubqueryRewriter();
+
+  std::unique_ptr<LogicalOperator> Rewrite(std::unique_ptr<LogicalOperator> op);
+
+ private:
+  using TableSet = std::unordered_set<size_t>;
+
+  void RewriteOperator(std::unique_ptr<LogicalOperator>& op);
+  void RewriteFilter(std::unique_ptr<LogicalOperator>& op);
+  void RewriteProjection(LogicalOperator& op);
+
+  /**
+   * Flatten a top-level AND term of a filter. Returns true if the term was
+   * turned into a SEMI or ANTI join and can be removed from the filter.
+   */
+  bool FlattenFilterTerm(std::unique_ptr<Expression>& expr,
+                         std::unique_ptr<LogicalOperator>& input);
+  /**
+   * Flatten all subqueries inside the expression into MARK and LEFT joins,
+   * replacing them by the column produced by the join.
+   */
+  void FlattenNested(std::unique_ptr<Expression>& expr,
+                     std::unique_ptr<LogicalOperator>& input);
+
+  bool FlattenExists(SubqueryExpression& expr,
+                     std::unique_ptr<LogicalOperator>& input, JoinType type);
+  bool FlattenAny(SubqueryExpression& expr,
+                  std::unique_ptr<LogicalOperator>& input, JoinType type);
+  std::unique_ptr<Expression> FlattenScalar(
+      SubqueryExpression& expr, std::unique_ptr<LogicalOperator>& input);
+
+  /**
+   * Create the join of input and subquery, using the correlated predicates
+   * as conditions, and make it the new input.
+   */
+  LogicalJoin& MakeJoin(std::unique_ptr<LogicalOperator>& input,
+                        std::unique_ptr<LogicalOperator> subquery,
+                        JoinType type,
+                        std::vector<std::unique_ptr<Expression>> predicates,
+                        const TableSet& outer);
+
+  size_t next_table_index_;
+};
+
+}  // namespace zoomdb
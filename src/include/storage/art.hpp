@@ -0,0 +1,132 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace zoomdb {
+
+struct ARTNode;
+struct ARTPathEntry;
+
+/**
+ * ART is an adaptive radix tree that maps binary keys to 64-bit values.
+ * Keys are ordered bytewise (as by memcmp), so they have to be encoded such
+ * that the byte order is the order of the encoded values. No key may be a
+ * prefix of another key.
+ *
+ * Inner nodes grow from 4 to 16, 48 and 256 children, and store the bytes
+ * shared by all keys below them as a compressed prefix. A leaf stores the
+ * complete key.
+ *
+ * Concurrency uses optimistic lock coupling: every node has a version
+ * counter that is incremented by every modification. Readers do not lock,
+ * they validate the versions of the nodes they have read and restart on a
+ * conflict. Writers lock the node they modify and its parent, and Erase
+ * also the nodes it removes: a node left without children is removed, and
+ * a node that falls well below the capacity of its type is replaced by a
+ * smaller one.
+ *
+ * Replaced and removed nodes are freed by epoch-based reclamation: every
+ * operation runs in the global epoch at which it started, and a node is
+ * freed once no operation of the epoch in which it was unlinked is left.
+ * Readers thus never follow a pointer to freed memory.
+ */
+class ART {
+ public:
+  /**
+   * A bound of a range scan. A key is compared to the bound on its first
+   * size bytes only, so a bound on the leading columns of a compound key
+   * covers all keys that start with it.
+   */
+  struct Bound {
+    const uint8_t* key;
+    size_t size;
+    bool inclusive;
+  };
+
+  using ScanCallback = std::function<void(uint64_t value)>;
+
+  ART();
+  ~ART();
+
+  ART(const ART&)            = delete;
+  ART& operator=(const ART&) = delete;
+
+  /**
+   * Insert the key, returns false if the key already exists. Throws an
+   * IndexException if the key is a prefix of an existing key or vice versa.
+   */
+  bool Insert(const uint8_t* key, size_t size, uint64_t value);
+  /**
+   * Remove the key, returns false if it does not exist.
+   */
+  bool Erase(const uint8_t* key, size_t size);
+  bool Lookup(const uint8_t* key, size_t size, uint64_t& value) const;
+
+  /**
+   * Call the callback for the value of every key between the bounds, in
+   * key order. A nullptr bound is unbounded. Keys inserted or erased while
+   * the scan runs may or may not be visited.
+   */
+  void Scan(const Bound* lower, const Bound* upper,
+            const ScanCallback& callback) const;
+
+ private:
+  struct ScanState;
+  enum class Result : uint8_t;
+
+  Result TryInsert(const uint8_t* key, size_t size, uint64_t value);
+  Result TryErase(const uint8_t* key, size_t size);
+  Result TryLookup(const uint8_t* key, size_t size, uint64_t& value) const;
+  Result ScanNode(const ARTNode* node, size_t level, int lower_order,
+                  int upper_order, ScanState& state) const;
+
+  /**
+   * Remove the leaf from the tree, path holds the nodes from the root down
+   * to its parent.
+   */
+  Result EraseLeaf(const std::vector<ARTPathEntry>& path,
+                   ARTNode* leaf);
+
+  /**
+   * Keeps the epoch in which an operation started active while it runs.
+   */
+  class EpochGuard;
+
+  /**
+   * Free the nodes retired in the previous epoch and advance the epoch if
+   * no operation of the previous epoch is left.
+   */
+  void Reclaim() const;
+  /**
+   * Free the node once no running operation can reach it anymore.
+   */
+  void Retire(ARTNode* node);
+
+  ARTNode* root_;
+  mutable std::atomic<uint64_t> epoch_;
+  /**
+   * The number of running operations per epoch parity.
+   */
+  mutable std::atomic<size_t> active_[2];
+  /**
+   * The nodes unlinked in the current and in the previous epoch, by
+   * parity.
+   */
+  mutable std::vector<ARTNode*> retired_[2];
+  mutable std::atomic<size_t> retired_count_;
+  mutable std::mutex retired_lock_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,119 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/printable.hpp"
+#include "common/types/hyperloglog.hpp"
+#include "common/types/value.hpp"
+#include "common/types/vector.hpp"
+
+namespace zoomdb {
+
+/**
+ * Equi-depth histogram: every bucket covers (roughly) the same number of
+ * rows. Bucket i covers the values in (bounds[i - 1], bounds[i]], the first
+ * bucket starts at the minimum of the column.
+ */
+struct Histogram {
+  std::vector<Value> bounds;
+  double rows_per_bucket = 0;
+};
+
+/**
+ * Statistics of a single column: row and NULL counts, minimum and maximum,
+ * a HyperLogLog sketch of the distinct values and a reservoir sample from
+ * which an equi-depth histogram is derived.
+ *
+ * All parts of the statistics can be maintained incrementally with Update()
+ * as rows are appended, and statistics collected over disjoint parts of a
+ * table can be combined with Merge(), so they never require a re-scan.
+ */
+class ColumnStatistics : public Printable {
+ public:
+  static constexpr size_t kSampleSize         = 8192;
+  static constexpr size_t kDefaultBucketCount = 64;
+
+  explicit ColumnStatistics(TypeId type);
+
+  /**
+   * Add the values of the vector to the statistics.
+   */
+  void Update(const Vector& vector);
+  /**
+   * Combine statistics collected over a disjoint set of rows.
+   */
+  void Merge(const ColumnStatistics& other);
+  /**
+   * Widen the minimum and maximum to cover the non-NULL values of the
+   * vector, without counting them. For values that overwrite others.
+   */
+  void Widen(const Vector& vector);
+  /**
+   * Widen the minimum and maximum to cover [min, max], nothing if min is
+   * NULL.
+   */
+  void Widen(const Value& min, const Value& max);
+  void Reset();
+
+  TypeId GetType() const { return type_; }
+  uint64_t GetCount() const { return count_; }
+  uint64_t GetNullCount() const { return null_count_; }
+  double GetNullFraction() const;
+  /**
+   * Estimated number of distinct non-NULL values.
+   */
+  uint64_t GetDistinctCount() const;
+  /**
+   * Minimum and maximum of the column, NULL if there are no non-NULL values.
+   */
+  const Value& GetMinimum() const { return min_; }
+  const Value& GetMaximum() const { return max_; }
+
+  Histogram GetHistogram(size_t bucket_count = kDefaultBucketCount) const;
+
+  /**
+   * Estimate the fraction of rows for which "column <comparison> constant"
+   * holds.
+   */
+  double EstimateSelectivity(ExpressionType comparison,
+                             const Value& constant) const;
+
+  std::string ToString() const override;
+
+ private:
+  template <class T>
+  void UpdateInternal(const Vector& vector);
+  void UpdateMinMax(const Value& min, const Value& max);
+  void AddToSample(const Vector& vector, size_t index);
+  void ComputeNextSample();
+  /**
+   * Fraction of the non-NULL values that are smaller than constant (or
+   * smaller than or equal, if inclusive is set), based on the sample.
+   */
+  double EstimateFractionBelow(const Value& constant, bool inclusive) const;
+
+  TypeId type_;
+  uint64_t count_;
+  uint64_t null_count_;
+  Value min_;
+  Value max_;
+  HyperLogLog distinct_;
+
+  // Reservoir sample of the non-NULL values, maintained with Algorithm L.
+  std::vector<Value> sample_;
+  uint64_t sample_seen_;
+  uint64_t next_sample_;
+  double sample_weight_;
+  std::mt19937_64 random_;
+};
+
+}  // namespace zoomdb
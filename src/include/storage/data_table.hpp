@@ -0,0 +1,209 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <bitset>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "common/types/data_chunk.hpp"
+#include "common/types/string_dictionary.hpp"
+#include "storage/column_statistics.hpp"
+#include "storage/index.hpp"
+
+namespace zoomdb {
+
+/**
+ * Columnar in-memory storage of a table. The rows are stored in chunks of
+ * kStandardVectorSize rows, and the statistics of every column are kept up
+ * to date as rows are appended. The strings of a VARCHAR column are stored
+ * in a StringDictionary of the column, until it has too many distinct
+ * strings; the column is stored plain from then on.
+ *
+ * A row is identified by its row id, its position in the table. Deleting
+ * rows only marks them in a deletion bitmap of their chunk, so row ids
+ * never change; updates overwrite the updated columns.
+ *
+ * A table is shared by all connections of its database. Modifications are
+ * serialized by the table lock, while scans read the chunks without it:
+ * a scan holds the chunk it reads (GetChunk()), and appends and updates
+ * copy a chunk that is held before they change it. A scan thus sees every
+ * chunk as of the moment it got it, and the copies are freed once their
+ * readers let go of them.
+ */
+class DataTable {
+ public:
+  /**
+   * The id of the row id pseudo column. Scanning or fetching it produces
+   * the row ids of the rows, as BIGINT.
+   */
+  static constexpr size_t kRowIdColumn = std::numeric_limits<size_t>::max();
+
+  explicit DataTable(std::vector<TypeId> types);
+
+  const std::vector<TypeId>& GetTypes() const { return types_; }
+  /**
+   * Returns the type of the column with the given id, which may be
+   * kRowIdColumn.
+   */
+  TypeId GetColumnType(size_t column) const;
+  /**
+   * Returns the number of rows that are not deleted.
+   */
+  size_t GetRowCount() const;
+  size_t GetChunkCount() const;
+  /**
+   * Returns the chunk with the given index for reading. The chunk does not
+   * change as long as the caller holds it, and must not be changed by the
+   * caller. It still holds its deleted rows, see GetLiveRows().
+   */
+  std::shared_ptr<DataChunk> GetChunk(size_t index) const;
+  /**
+   * Returns false if no row of chunk, the chunk with the given index, is
+   * deleted. Otherwise fills selection with the positions of the rows of
+   * chunk that are not deleted and sets count to their number.
+   */
+  bool GetLiveRows(size_t index, const DataChunk& chunk, sel_t* selection,
+                   size_t& count) const;
+
+  /**
+   * Append the rows of the chunk to the table and update the statistics and
+   * the indexes. Throws a ConstraintException, and appends nothing, if a
+   * row violates a unique index.
+   */
+  void Append(const DataChunk& chunk);
+
+  /**
+   * Copy the given columns of the rows with the given ids (positions in the
+   * table) into result. String values are copied into result.
+   */
+  void Fetch(const uint64_t* row_ids, size_t count,
+             const std::vector<size_t>& column_ids, DataChunk& result);
+
+  /**
+   * Delete the rows with the given ids by setting their bits in the
+   * deletion bitmaps, and remove them from the indexes. Rows that are
+   * already deleted are skipped. Returns the number of rows deleted.
+   */
+  size_t Delete(const uint64_t* row_ids, size_t count);
+  /**
+   * Overwrite the given columns of the rows with the given ids with the
+   * rows of values, whose column i holds the values of column
+   * column_ids[i]. Only the updated columns are written, and only the
+   * indexes over them are maintained. Throws a ConstraintException, and
+   * updates nothing, if a row would violate a unique index.
+   *
+   * The minimum and maximum of the updated columns are widened to cover
+   * the new values. Otherwise the statistics are not changed by updates
+   * and deletes, they are approximate until Analyze() rebuilds them.
+   */
+  void Update(const uint64_t* row_ids, const std::vector<size_t>& column_ids,
+              const DataChunk& values);
+
+  /**
+   * Create an index over the given columns and fill it with the rows of the
+   * table. Throws a CatalogException if an index with the name exists and a
+   * ConstraintException if a unique index would contain duplicates.
+   */
+  Index& CreateIndex(std::string name, std::vector<size_t> column_ids,
+                     bool unique);
+  /**
+   * Stop maintaining the index and return it, running queries may still
+   * scan it.
+   */
+  std::unique_ptr<Index> DropIndex(const std::string& name);
+  std::vector<Index*> GetIndexes() const;
+
+  /**
+   * Rebuild the statistics of every column with a single parallel scan over
+   * the table, using thread_count threads (0 means one per hardware thread).
+   *
+   * The scan does not block appends, updates, deletes or queries: it holds
+   * the full chunks and copies of their deletion bitmaps, and covers them
+   * without the table lock. Only the rows appended in the meantime, and the
+   * range of the values updated in the meantime, are added while the lock
+   * is held, right before the new statistics replace the old ones in one
+   * step.
+   */
+  void Analyze(size_t thread_count = 0);
+
+  ColumnStatistics GetStatistics(size_t column) const;
+
+  /**
+   * Estimate the fraction of rows for which "column <comparison> constant"
+   * holds.
+   */
+  double EstimateSelectivity(size_t column, ExpressionType comparison,
+                             const Value& constant) const;
+
+ private:
+  /**
+   * Returns the chunk with the given index for changing it, replacing it by
+   * a copy first if a reader holds it. The lock must be held.
+   */
+  DataChunk& GetMutableChunk(size_t index);
+  /**
+   * Append count entries of source, starting at offset, to the column
+   * vector target of the last chunk.
+   */
+  void AppendColumn(size_t column, const Vector& source, size_t offset,
+                    size_t count, Vector& target);
+  /**
+   * Overwrite entry row of the column vector target with entry index of
+   * source.
+   */
+  void UpdateEntry(size_t column, const Vector& source, size_t index,
+                   Vector& target, size_t row);
+  /**
+   * Copy the given column of the rows with the given ids into target. The
+   * lock must be held.
+   */
+  void FetchColumn(const uint64_t* row_ids, size_t count, size_t column,
+                   Vector& target);
+  /**
+   * Throws if a row id is out of range, or if a row is deleted unless
+   * allow_deleted is set. The lock must be held.
+   */
+  void CheckRows(const uint64_t* row_ids, size_t count,
+                 bool allow_deleted) const;
+  bool IsDeleted(uint64_t row_id) const;
+
+  std::vector<TypeId> types_;
+  std::vector<std::shared_ptr<DataChunk>> chunks_;
+  size_t row_count_;
+  /**
+   * The deletion bitmap of every chunk, nullptr if none of its rows was
+   * deleted. May be shorter than chunks_.
+   */
+  std::vector<std::unique_ptr<std::bitset<kStandardVectorSize>>> deleted_;
+  size_t deleted_count_;
+  std::vector<ColumnStatistics> statistics_;
+  /**
+   * While Analyze() scans the table, the minimum and maximum of the values
+   * written by updates in the meantime. Empty otherwise.
+   */
+  std::vector<ColumnStatistics> analyze_updates_;
+  /**
+   * The dictionaries of the VARCHAR columns that are dictionary encoded,
+   * nullptr for all other columns.
+   */
+  std::vector<std::shared_ptr<StringDictionary>> dictionaries_;
+  std::vector<std::unique_ptr<Index>> indexes_;
+  mutable std::mutex lock_;
+  /**
+   * Serializes the calls of Analyze(), which does most of its work without
+   * lock_.
+   */
+  std::mutex analyze_lock_;
+};
+
+}  // namespace zoomdb
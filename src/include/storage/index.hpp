@@ -0,0 +1,91 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/types/data_chunk.hpp"
+#include "common/types/value.hpp"
+#include "storage/art.hpp"
+
+namespace zoomdb {
+
+/**
+ * A secondary index over one or more columns of a table, backed by an ART
+ * that maps the key of every row to its row id.
+ *
+ * The values of the indexed columns are encoded into a binary key whose
+ * byte order is the SQL order of the values: integers are stored big endian
+ * with the sign bit flipped, decimals with the sign bit (negative numbers:
+ * all bits) flipped, and strings are terminated by a zero byte. The key of
+ * a row in a non-unique index is followed by its row id, so every key
+ * remains unique. Rows with a NULL in an indexed column are not indexed.
+ */
+class Index {
+ public:
+  Index(std::string index_name, std::vector<size_t> columns,
+        std::vector<TypeId> column_types, bool is_unique);
+
+  const std::string& GetName() const { return name_; }
+  /**
+   * The indexed columns, as positions in the table.
+   */
+  const std::vector<size_t>& GetColumnIds() const { return column_ids_; }
+  bool IsUnique() const { return unique_; }
+
+  /**
+   * Add the rows of a chunk of the table, row i gets the row id
+   * row_start + i. Throws a ConstraintException, and leaves the index
+   * unchanged, if a unique index already contains one of the keys.
+   */
+  void Append(const DataChunk& chunk, uint64_t row_start);
+  /**
+   * Add rows of the table, row i of the chunk has the id row_ids[i].
+   */
+  void Append(const DataChunk& chunk, const uint64_t* row_ids);
+  /**
+   * Remove the rows of a chunk that was appended with the given row_start.
+   */
+  void Delete(const DataChunk& chunk, uint64_t row_start);
+  /**
+   * Remove rows of the table, row i of the chunk has the id row_ids[i].
+   */
+  void Delete(const DataChunk& chunk, const uint64_t* row_ids);
+
+  /**
+   * Append the ids of the rows whose first indexed column lies between
+   * lower and upper to result, in index order. A NULL bound is unbounded.
+   */
+  void Scan(const Value& lower, bool lower_inclusive, const Value& upper,
+            bool upper_inclusive, std::vector<uint64_t>& result) const;
+
+  /**
+   * Append the key encoding of a (not NULL) entry of the vector to key.
+   * Encodings compare like the values with memcmp and none is the prefix of
+   * another, so they also serve as sort keys.
+   */
+  static void EncodeValue(const Vector& vector, size_t index,
+                          std::vector<uint8_t>& key);
+
+ private:
+  /**
+   * Encode the key of a row into key, returns false if the row has a NULL
+   * in one of the indexed columns.
+   */
+  bool EncodeRow(const DataChunk& chunk, size_t row, uint64_t row_id,
+                 std::vector<uint8_t>& key) const;
+
+  std::string name_;
+  std::vector<size_t> column_ids_;
+  std::vector<TypeId> types_;
+  bool unique_;
+  ART tree_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,39 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "storage/parquet/parquet_reader.hpp"
+
+namespace zoomdb {
+
+/**
+ * ParquetFileCache shares the readers of Parquet files between queries. A
+ * file is mapped and its footer parsed on first access only; afterwards
+ * every scan of the file uses the same mapping, so the metadata is never
+ * read twice and scans share the pages read by earlier ones.
+ *
+ * The cached files must not change, which holds for the snapshots a read
+ * only database serves. Readers are looked up under a lock and may be used
+ * by several connections at once.
+ */
+class ParquetFileCache {
+ public:
+  std::shared_ptr<const ParquetReader> GetReader(const std::string& path);
+
+ private:
+  std::mutex lock_;
+  std::unordered_map<std::string, std::shared_ptr<const ParquetReader>>
+      readers_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,162 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "storage/parquet/thrift_compact.hpp"
+
+namespace zoomdb {
+
+/**
+ * The subset of the Parquet metadata (parquet.thrift) that is used to read
+ * and write flat tables. The field ids of the Thrift structs are given in
+ * the Write() and Read() methods, fields not listed here are skipped when
+ * reading.
+ */
+
+enum class ParquetType : int32_t {
+  kBoolean           = 0,
+  kInt32             = 1,
+  kInt64             = 2,
+  kInt96             = 3,
+  kFloat             = 4,
+  kDouble            = 5,
+  kByteArray         = 6,
+  kFixedLenByteArray = 7,
+};
+
+enum class ParquetConvertedType : int32_t {
+  kNone            = -1,
+  kUTF8            = 0,
+  kDate            = 6,
+  kTimestampMillis = 9,
+  kTimestampMicros = 10,
+  kInt8            = 15,
+  kInt16           = 16,
+};
+
+enum class ParquetRepetition : int32_t {
+  kRequired = 0,
+  kOptional = 1,
+  kRepeated = 2,
+};
+
+enum class ParquetEncoding : int32_t {
+  kPlain           = 0,
+  kPlainDictionary = 2,
+  kRle             = 3,
+  kBitPacked       = 4,
+  kRleDictionary   = 8,
+};
+
+enum class ParquetCompression : int32_t {
+  kUncompressed = 0,
+};
+
+enum class ParquetPageType : int32_t {
+  kDataPage       = 0,
+  kIndexPage      = 1,
+  kDictionaryPage = 2,
+  kDataPageV2     = 3,
+};
+
+struct ParquetStatistics {
+  /**
+   * The plain encoded minimum and maximum, only valid if has_min_max.
+   */
+  bool has_min_max = false;
+  std::string min_value;
+  std::string max_value;
+  int64_t null_count = 0;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+struct ParquetSchemaElement {
+  /**
+   * The physical type, only set for leaf columns.
+   */
+  bool has_type                       = false;
+  ParquetType type                    = ParquetType::kBoolean;
+  ParquetRepetition repetition        = ParquetRepetition::kOptional;
+  std::string name;
+  int32_t num_children                = 0;
+  ParquetConvertedType converted_type = ParquetConvertedType::kNone;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+struct ParquetColumnMetaData {
+  ParquetType type = ParquetType::kBoolean;
+  std::vector<ParquetEncoding> encodings;
+  std::vector<std::string> path_in_schema;
+  ParquetCompression codec        = ParquetCompression::kUncompressed;
+  int64_t num_values              = 0;
+  int64_t total_uncompressed_size = 0;
+  int64_t total_compressed_size   = 0;
+  int64_t data_page_offset        = 0;
+  bool has_dictionary_page        = false;
+  int64_t dictionary_page_offset  = 0;
+  bool has_statistics             = false;
+  ParquetStatistics statistics;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+struct ParquetColumnChunk {
+  int64_t file_offset = 0;
+  ParquetColumnMetaData meta_data;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+struct ParquetRowGroup {
+  std::vector<ParquetColumnChunk> columns;
+  int64_t total_byte_size = 0;
+  int64_t num_rows        = 0;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+struct ParquetFileMetaData {
+  int32_t version = 1;
+  std::vector<ParquetSchemaElement> schema;
+  int64_t num_rows = 0;
+  std::vector<ParquetRowGroup> row_groups;
+  std::string created_by;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+struct ParquetPageHeader {
+  ParquetPageType type           = ParquetPageType::kDataPage;
+  int32_t uncompressed_page_size = 0;
+  int32_t compressed_page_size   = 0;
+  /**
+   * The number of values of a data or dictionary page.
+   */
+  int32_t num_values = 0;
+  /**
+   * The encoding of the values of a data or dictionary page.
+   */
+  ParquetEncoding encoding = ParquetEncoding::kPlain;
+
+  void Write(ThriftWriter& writer) const;
+  void Read(ThriftReader& reader);
+};
+
+}  // namespace zoomdb
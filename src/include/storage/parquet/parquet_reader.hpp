@@ -0,0 +1,76 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/file_system.hpp"
+#include "common/types/data_chunk.hpp"
+#include "storage/parquet/parquet_metadata.hpp"
+
+namespace zoomdb {
+
+/**
+ * ParquetReader reads flat tables from uncompressed Parquet files. The file
+ * is memory mapped, only the pages of the requested columns are decoded.
+ * PLAIN and dictionary encoded data pages (version 1) are supported.
+ *
+ * Scans read the column chunks of the next row groups ahead (see
+ * Prefetch()), so that decoding a row group rarely waits for the disk.
+ * The reader is not modified after it is opened and can be shared by
+ * concurrent scans.
+ */
+class ParquetReader {
+ public:
+  /**
+   * The number of row groups a scan prefetches ahead of the one it decodes,
+   * unless the query says otherwise.
+   */
+  static constexpr size_t kDefaultPrefetchDepth = 4;
+
+  explicit ParquetReader(const std::string& path);
+
+  const std::vector<TypeId>& GetTypes() const { return types_; }
+  const std::vector<std::string>& GetNames() const { return names_; }
+  size_t GetRowGroupCount() const { return metadata_.row_groups.size(); }
+  size_t GetRowCount() const { return static_cast<size_t>(metadata_.num_rows); }
+
+  /**
+   * Returns false if the statistics of the row group prove that
+   * "column <comparison> constant" holds for none of its rows.
+   */
+  bool RowGroupMayMatch(size_t row_group, size_t column,
+                        ExpressionType comparison,
+                        const Value& constant) const;
+
+  /**
+   * Read the given columns of a row group into chunks of
+   * kStandardVectorSize rows.
+   */
+  void ReadRowGroup(size_t row_group, const std::vector<size_t>& column_ids,
+                    std::vector<std::unique_ptr<DataChunk>>& chunks) const;
+  /**
+   * Start reading the given columns of a row group from disk in the
+   * background, without waiting for the data.
+   */
+  void Prefetch(size_t row_group, const std::vector<size_t>& column_ids) const;
+
+ private:
+  void ReadColumn(const ParquetColumnChunk& column_chunk, size_t column,
+                  size_t column_index,
+                  std::vector<std::unique_ptr<DataChunk>>& chunks) const;
+
+  MappedFile file_;
+  ParquetFileMetaData metadata_;
+  std::vector<TypeId> types_;
+  std::vector<std::string> names_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,61 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/internal-types.hpp"
+#include "storage/parquet/parquet_metadata.hpp"
+
+namespace zoomdb {
+
+class ChunkCollection;
+
+/**
+ * ParquetWriter writes a flat table to an uncompressed Parquet file.
+ *
+ * Every column is OPTIONAL, with its definition levels RLE encoded. A
+ * column chunk is dictionary encoded, with the indexes RLE / bit-packed,
+ * unless its dictionary grows beyond kMaxDictionarySize entries, then the
+ * values are PLAIN encoded. Each column chunk holds a single data page and
+ * records the minimum, maximum and NULL count of its values, which allow
+ * readers to skip row groups.
+ */
+class ParquetWriter {
+ public:
+  /**
+   * The number of rows of a row group.
+   */
+  static constexpr size_t kRowGroupSize      = 120 * kStandardVectorSize;
+  static constexpr size_t kMaxDictionarySize = 1 << 16;
+
+  ParquetWriter(const std::string& path, std::vector<TypeId> types,
+                std::vector<std::string> names);
+
+  /**
+   * Write the rows of the collection as row groups of up to kRowGroupSize
+   * rows. The row groups are encoded in parallel on thread_count threads (0
+   * means one per hardware thread) and appended to the file in order.
+   */
+  void Write(const ChunkCollection& collection, size_t thread_count = 0);
+  /**
+   * Write the metadata and close the file.
+   */
+  void Finalize();
+
+ private:
+  std::string path_;
+  std::vector<TypeId> types_;
+  std::ofstream file_;
+  int64_t offset_;
+  ParquetFileMetaData metadata_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,59 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace zoomdb {
+
+/**
+ * Encoder of the RLE / bit-packing hybrid encoding of Parquet, used for the
+ * definition levels and the dictionary indexes of a data page. Runs of at
+ * least 8 equal values are run length encoded, other values are bit-packed
+ * in groups of 8.
+ */
+class RleBpEncoder {
+ public:
+  /**
+   * Append the encoding of count values of bit_width bits to buffer.
+   */
+  static void Encode(const uint32_t* values, size_t count, uint8_t bit_width,
+                     std::string& buffer);
+};
+
+/**
+ * Decoder of the RLE / bit-packing hybrid encoding.
+ */
+class RleBpDecoder {
+ public:
+  RleBpDecoder(const char* data, size_t size, uint8_t bit_width);
+
+  /**
+   * Decode the next count values, throws an IOException if the data ends
+   * before.
+   */
+  void Decode(uint32_t* values, size_t count);
+
+ private:
+  void NextRun();
+  uint32_t NextPacked();
+
+  const uint8_t* data_;
+  const uint8_t* end_;
+  uint8_t bit_width_;
+  size_t rle_remaining_;
+  uint32_t rle_value_;
+  size_t packed_remaining_;
+  /**
+   * The position of the next bit-packed value, in bits from data_.
+   */
+  size_t packed_bit_;
+};
+
+}  // namespace zoomdb
@@ -0,0 +1,116 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zoomdb {
+
+/**
+ * The type codes of the Thrift compact protocol.
+ */
+enum class ThriftType : uint8_t {
+  kStop      = 0,
+  kBoolTrue  = 1,
+  kBoolFalse = 2,
+  kByte      = 3,
+  kI16       = 4,
+  kI32       = 5,
+  kI64       = 6,
+  kDouble    = 7,
+  kBinary    = 8,
+  kList      = 9,
+  kSet       = 10,
+  kMap       = 11,
+  kStruct    = 12,
+};
+
+/**
+ * Serializes structs with the Thrift compact protocol, which is used for
+ * the metadata of Parquet files. Fields are written in increasing order of
+ * their ids, every struct is closed with StructEnd().
+ */
+class ThriftWriter {
+ public:
+  explicit ThriftWriter(std::string& buffer);
+
+  void StructBegin();
+  void StructEnd();
+
+  void FieldBool(int16_t id, bool value);
+  void FieldI32(int16_t id, int32_t value);
+  void FieldI64(int16_t id, int64_t value);
+  void FieldBinary(int16_t id, const std::string& value);
+  /**
+   * Write the header of a struct field, the struct itself follows, enclosed
+   * in StructBegin() and StructEnd().
+   */
+  void FieldStruct(int16_t id);
+  /**
+   * Begin a list field of size elements, the elements are written with
+   * I32(), Binary() or StructBegin()/StructEnd().
+   */
+  void FieldList(int16_t id, ThriftType element_type, size_t size);
+
+  void I32(int32_t value);
+  void Binary(const std::string& value);
+
+ private:
+  void FieldHeader(int16_t id, ThriftType type);
+  void Varint(uint64_t value);
+
+  std::string& buffer_;
+  std::vector<int16_t> last_field_ids_;
+};
+
+/**
+ * Deserializes structs written with the Thrift compact protocol. Unknown
+ * fields are skipped with Skip(), reading past the end of the data throws
+ * an IOException.
+ */
+class ThriftReader {
+ public:
+  ThriftReader(const char* data, size_t size);
+
+  void StructBegin();
+  void StructEnd();
+  /**
+   * Read the header of the next field of the current struct. Returns false
+   * if the struct has no more fields.
+   */
+  bool NextField(int16_t& id, ThriftType& type);
+
+  /**
+   * Returns the value of a bool field, which is stored in its type.
+   */
+  bool Bool(ThriftType type) const { return type == ThriftType::kBoolTrue; }
+  int32_t I32();
+  int64_t I64();
+  std::string Binary();
+  size_t List(ThriftType& element_type);
+
+  /**
+   * Skip a value of the given type.
+   */
+  void Skip(ThriftType type);
+
+  size_t GetPosition() const { return position_; }
+
+ private:
+  uint8_t Byte();
+  uint64_t Varint();
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_;
+  std::vector<int16_t> last_field_ids_;
+};
+
+}  // namespace zoomdb
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -14,24 +16,84 @@ extern "C" {
 typedef void* zoomdb_database;
 typedef void* zoomdb_connection;
 typedef void* zoomdb_result;
+typedef void* zoomdb_appender;
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+/**
+ * The structures of the Arrow C data interface, as defined by the Arrow
+ * specification (https://arrow.apache.org/docs/format/CDataInterface.html).
+ */
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
 
 typedef enum zoomdb_state {
   kZoomDBSuccess = 0,
   kZoomDBError = 1,
 } zoomdb_state;
 
+typedef enum zoomdb_access_mode {
+  kZoomDBReadWrite = 0,
+  kZoomDBReadOnly = 1,
+} zoomdb_access_mode;
+
 /**
  * @param path database filename (UTF-8)
  * @param database [out] ZoomDB DB handle
  */
 zoomdb_state zoomdb_open(const char* path, zoomdb_database *database);
 
+/**
+ * Open a database in the given access mode. A read only database rejects
+ * statements that modify it and shares the files it reads between all
+ * queries, see zoomdb::Database.
+ *
+ * @param path database filename (UTF-8)
+ * @param access_mode kZoomDBReadWrite or kZoomDBReadOnly
+ * @param database [out] ZoomDB DB handle
+ */
+zoomdb_state zoomdb_open_ext(const char* path, zoomdb_access_mode access_mode,
+                             zoomdb_database *database);
+
 /**
  * @param database Database to close
  */
 zoomdb_state zoomdb_close(zoomdb_database database);
 
 /**
+ * Many connections to a database can run queries at the same time on
+ * different threads, but a connection must only be used by one thread at a
+ * time.
+ *
  * @param database Database to open connection to
  * @param connection [out] Connection handle
  */
@@ -50,6 +112,98 @@ zoomdb_state zoomdb_disconnect(zoomdb_connection connection);
 zoomdb_state zoomdb_query(zoomdb_connection connection, const char* query,
                           zoomdb_result* result);
 
+/**
+ * Execute a script of statements separated by semicolons. The script is
+ * parsed once and its statements are executed in order until one fails,
+ * every statement commits on its own.
+ *
+ * @param connection Connection to query
+ * @param query SQL script to execute
+ * @param result [out] Result of the last statement
+ * @param executed [out] Number of statements that succeeded, may be NULL
+ */
+zoomdb_state zoomdb_query_multi(zoomdb_connection connection,
+                                const char* query, zoomdb_result* result,
+                                uint64_t* executed);
+
+/**
+ * Run a query and export its result as an Arrow struct array with one child
+ * per result column. The caller owns the exported structures and must
+ * release them with their release callbacks.
+ *
+ * @param connection Connection to query
+ * @param query SQL query to execute
+ * @param schema [out] Schema of the result
+ * @param array [out] Rows of the result
+ */
+zoomdb_state zoomdb_query_arrow(zoomdb_connection connection,
+                                const char* query, struct ArrowSchema* schema,
+                                struct ArrowArray* array);
+
+/**
+ * Create an appender, which inserts rows into a table without parsing an
+ * INSERT statement per row. A row is given as one zoomdb_append_* call per
+ * column followed by zoomdb_appender_end_row. Rows are appended to the table
+ * in batches, at the latest by zoomdb_appender_flush or
+ * zoomdb_appender_destroy. See zoomdb::Appender.
+ *
+ * @param connection Connection handle
+ * @param schema Schema of the table, NULL for the default schema
+ * @param table Table to append to
+ * @param appender [out] Appender handle
+ */
+zoomdb_state zoomdb_appender_create(zoomdb_connection connection,
+                                    const char* schema, const char* table,
+                                    zoomdb_appender* appender);
+
+/**
+ * Flush the buffered rows and destroy the appender.
+ *
+ * @param appender Appender handle
+ */
+zoomdb_state zoomdb_appender_destroy(zoomdb_appender appender);
+
+/**
+ * Append the buffered rows to the table. Fails in the middle of a row.
+ *
+ * @param appender Appender handle
+ */
+zoomdb_state zoomdb_appender_flush(zoomdb_appender appender);
+
+/**
+ * Finish the current row.
+ *
+ * @param appender Appender handle
+ */
+zoomdb_state zoomdb_appender_end_row(zoomdb_appender appender);
+
+/**
+ * Append a value to the current row, converting it to the column type. If
+ * the conversion fails the row stays at the same column.
+ *
+ * @param appender Appender handle
+ * @param value Value of the next column
+ */
+zoomdb_state zoomdb_append_int32(zoomdb_appender appender, int32_t value);
+zoomdb_state zoomdb_append_int64(zoomdb_appender appender, int64_t value);
+zoomdb_state zoomdb_append_double(zoomdb_appender appender, double value);
+zoomdb_state zoomdb_append_varchar(zoomdb_appender appender,
+                                   const char* value);
+zoomdb_state zoomdb_append_null(zoomdb_appender appender);
+
+/**
+ * Append the rows of an Arrow struct array (a record batch) whose children
+ * are the columns of the table. The arrays remain owned by the caller and
+ * are not released.
+ *
+ * @param appender Appender handle
+ * @param schema Schema of the array
+ * @param array Rows to append
+ */
+zoomdb_state zoomdb_append_arrow(zoomdb_appender appender,
+                                 const struct ArrowSchema* schema,
+                                 const struct ArrowArray* array);
+
 #ifdef __cplusplus
 };
 #endif
@@ -7,25 +7,138 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/types/chunk_collection.hpp"
+
+struct ArrowArray;
+struct ArrowSchema;
+
 namespace zoomdb {
 
+class Catalog;
+class ParquetFileCache;
 class Result;
+class SQLStatement;
+
+enum class AccessMode : uint8_t {
+  kReadWrite = 0,
+  kReadOnly  = 1,
+};
 
+/**
+ * A Database is shared by its connections, which may run queries
+ * concurrently on different threads. The catalog and the tables are the
+ * shared state: a statement looks up the catalog as of its start, DDL
+ * statements are serialized, and the modifications of a table are
+ * serialized by its lock while scans read it without locking (see
+ * DataTable). Statements are not isolated beyond that; a scan sees the rows
+ * that concurrent statements append to the parts of a table it has not
+ * reached yet.
+ */
 class Database {
  public:
-  explicit Database(const char* path);
+  /**
+   * A read only database rejects the statements that change it (CREATE,
+   * DROP, INSERT and COPY ... FROM). In exchange the files it reads are
+   * taken to be immutable snapshots: each Parquet file is mapped and its
+   * metadata parsed on first access only, and then shared by all queries
+   * of all connections.
+   */
+  explicit Database(const char* path,
+                    AccessMode access_mode = AccessMode::kReadWrite);
+  ~Database();
+
+  Catalog& GetCatalog() { return *catalog_; }
+  AccessMode GetAccessMode() const { return access_mode_; }
+  /**
+   * The cache of opened Parquet files, nullptr unless the database is read
+   * only.
+   */
+  ParquetFileCache* GetParquetCache() { return parquet_cache_.get(); }
+
+ private:
+  std::unique_ptr<Catalog> catalog_;
+  AccessMode access_mode_;
+  std::unique_ptr<ParquetFileCache> parquet_cache_;
 };
 
+/**
+ * A Connection holds the state of one client of a Database. It must not be
+ * used by two threads at the same time, every thread that runs queries
+ * uses a connection of its own.
+ */
 class Connection {
  public:
   explicit Connection(Database& database);
 
-  Result Query(const char* query);
+  Database& GetDatabase() { return db_; }
+
+  /**
+   * Run the statements of a query, separated by semicolons, in order. The
+   * query is parsed once, then the statements are executed until one
+   * fails. Every statement commits on its own, those before a failed one
+   * stay in effect. Returns the result of the last statement, or the error
+   * of the failed one; errors are reported through the result, never
+   * thrown. If given, executed is set to the number of statements that
+   * succeeded.
+   */
+  Result Query(const char* query, size_t* executed = nullptr);
+  /**
+   * Run the statements of a query like Query(), and call the callback with
+   * the result of every statement that succeeds, right after it has been
+   * executed. Returns the error of the failed statement, or a result
+   * without columns if all succeeded.
+   */
+  Result Query(const char* query,
+               const std::function<void(Result& result)>& callback);
+  /**
+   * Plan a single statement without executing it. The result has the names
+   * and types of the columns the statement returns (none unless it is a
+   * SELECT or EXPLAIN) and no rows.
+   */
+  Result Describe(const char* query);
 
  private:
+  Result ExecuteStatement(SQLStatement& statement);
+
   Database& db_;
 };
 
-class Result {};
+class Result {
+ public:
+  Result();
+  explicit Result(std::string error_message);
+
+  size_t RowCount() const { return collection.GetCount(); }
+  Value GetValue(size_t column, size_t row) const {
+    return collection.GetValue(column, row);
+  }
+
+  /**
+   * Returns the column names followed by the rows, separated by tabs.
+   */
+  std::string ToString() const;
+  /**
+   * Export the rows as an Arrow struct array with one child per column,
+   * see ChunkCollectionToArrow(). The caller releases the structures.
+   */
+  void ToArrow(ArrowSchema* schema, ArrowArray* array) const;
+
+  bool success;
+  std::string error;
+  /**
+   * The type of the statement that produced the result, kInvalid if the
+   * query was empty or failed.
+   */
+  StatementType statement_type = StatementType::kInvalid;
+  std::vector<std::string> names;
+  std::vector<TypeId> types;
+  ChunkCollection collection;
+};
 
 }  // namespace zoomdb
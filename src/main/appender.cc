@@ -0,0 +1,215 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "main/appender.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "catalog/catalog.hpp"
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+#include "common/arrow.hpp"
+#include "common/exception.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * Store the value if the storage type T can represent it.
+ */
+template <class T>
+bool TryStore(Vector& vector, size_t row, int64_t value) {
+  if (value < std::numeric_limits<T>::min() ||
+      value > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  vector.GetData<T>()[row] = static_cast<T>(value);
+  return true;
+}
+
+}  // namespace
+
+Appender::Appender(Connection& connection, const std::string& schema,
+                   const std::string& table)
+    : column_(0), row_count_(0) {
+  auto& database = connection.GetDatabase();
+  if (database.GetAccessMode() == AccessMode::kReadOnly) {
+    throw ConnectionException(
+        "Cannot execute a statement that modifies a read only database");
+  }
+  auto& catalog = database.GetCatalog();
+  CatalogSnapshot snapshot(catalog);
+  auto entry  = catalog.GetTable(schema, table, snapshot.GetTimestamp());
+  table_name_ = entry->name;
+  table_      = entry->storage;
+  buffer_.Initialize(table_->GetTypes());
+}
+
+Appender::Appender(Connection& connection, const std::string& table)
+    : Appender(connection, Catalog::kDefaultSchema, table) {}
+
+Appender::~Appender() {
+  column_ = 0;
+  try {
+    Flush();
+  } catch (...) {
+    // there is no way to report the error, the rows are lost
+  }
+}
+
+Vector& Appender::CurrentColumn() {
+  if (column_ >= buffer_.ColumnCount()) {
+    throw CatalogException("Too many values for a row of table %s",
+                           table_name_.c_str());
+  }
+  auto& vector = buffer_.GetVector(column_);
+  vector.SetNull(row_count_, false);
+  return vector;
+}
+
+void Appender::Append(int32_t value) { Append(static_cast<int64_t>(value)); }
+
+void Appender::Append(int64_t value) {
+  auto& vector = CurrentColumn();
+  bool stored  = false;
+  switch (vector.GetType()) {
+    case TypeId::kTinyInt:
+      stored = TryStore<int8_t>(vector, row_count_, value);
+      break;
+    case TypeId::kSmallInt:
+      stored = TryStore<int16_t>(vector, row_count_, value);
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      stored = TryStore<int32_t>(vector, row_count_, value);
+      break;
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      stored = TryStore<int64_t>(vector, row_count_, value);
+      break;
+    case TypeId::kDecimal:
+      vector.GetData<double>()[row_count_] = static_cast<double>(value);
+      stored                               = true;
+      break;
+    default:
+      break;
+  }
+  if (!stored) {
+    // raises the conversion error, or converts e.g. to VARCHAR
+    vector.SetValue(row_count_,
+                    Value::BigInt(value).CastAs(vector.GetType()));
+  }
+  column_++;
+}
+
+void Appender::Append(double value) {
+  auto& vector = CurrentColumn();
+  if (vector.GetType() == TypeId::kDecimal) {
+    vector.GetData<double>()[row_count_] = value;
+  } else {
+    vector.SetValue(row_count_,
+                    Value::Decimal(value).CastAs(vector.GetType()));
+  }
+  column_++;
+}
+
+void Appender::Append(const char* value) {
+  if (!value) {
+    AppendNull();
+    return;
+  }
+  auto& vector = CurrentColumn();
+  if (vector.GetType() == TypeId::kVarChar) {
+    vector.GetData<const char*>()[row_count_] =
+        vector.AddString(value, std::strlen(value));
+  } else {
+    vector.SetValue(row_count_, Value(value).CastAs(vector.GetType()));
+  }
+  column_++;
+}
+
+void Appender::Append(const Value& value) {
+  auto& vector = CurrentColumn();
+  vector.SetValue(row_count_, value.GetType() == vector.GetType()
+                                  ? value
+                                  : value.CastAs(vector.GetType()));
+  column_++;
+}
+
+void Appender::AppendNull() {
+  auto& vector = CurrentColumn();
+  vector.SetValue(row_count_, Value(vector.GetType()));
+  column_++;
+}
+
+void Appender::AppendArrow(const ArrowSchema& schema,
+                           const ArrowArray& array) {
+  if (std::strcmp(schema.format, "+s") != 0 ||
+      schema.n_children != static_cast<int64_t>(buffer_.ColumnCount()) ||
+      array.n_children != schema.n_children) {
+    throw CatalogException("Arrow array does not match the columns of %s",
+                           table_name_.c_str());
+  }
+  if (column_ != 0) {
+    throw CatalogException("Cannot append Arrow rows in the middle of a row");
+  }
+  Flush();
+
+  auto types  = buffer_.GetTypes();
+  auto length = static_cast<size_t>(array.length);
+  DataChunk chunk;
+  chunk.Initialize(types);
+  for (size_t offset = 0; offset < length; offset += kStandardVectorSize) {
+    auto count = std::min(kStandardVectorSize, length - offset);
+    chunk.Reset();
+    for (size_t i = 0; i < types.size(); i++) {
+      // the rows of a struct array start at its own offset
+      ArrowToVector(*schema.children[i], *array.children[i],
+                    static_cast<size_t>(array.offset) + offset, count,
+                    chunk.GetVector(i));
+    }
+    table_->Append(chunk);
+  }
+}
+
+void Appender::EndRow() {
+  if (column_ != buffer_.ColumnCount()) {
+    throw CatalogException("Row of table %s has %zu values, expected %zu",
+                           table_name_.c_str(), column_,
+                           buffer_.ColumnCount());
+  }
+  column_ = 0;
+  if (++row_count_ == kStandardVectorSize) {
+    Flush();
+  }
+}
+
+void Appender::Flush() {
+  if (column_ != 0) {
+    throw CatalogException("Cannot flush in the middle of a row");
+  }
+  if (row_count_ == 0) {
+    return;
+  }
+  for (size_t i = 0; i < buffer_.ColumnCount(); i++) {
+    buffer_.GetVector(i).SetCount(row_count_);
+  }
+  // a failed append (e.g. a unique violation) drops the whole buffer
+  row_count_ = 0;
+  try {
+    table_->Append(buffer_);
+  } catch (...) {
+    buffer_.Reset();
+    throw;
+  }
+  buffer_.Reset();
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,971 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "main/pg_protocol.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/exception.hpp"
+#include "common/types/date.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+constexpr int32_t kProtocolVersion3 = 196608;
+constexpr int32_t kCancelRequest    = 80877102;
+constexpr int32_t kSSLRequest       = 80877103;
+constexpr int32_t kGSSENCRequest    = 80877104;
+constexpr uint32_t kMaxMessageSize  = 64 << 20;
+
+// days and microseconds between 1970-01-01 and 2000-01-01, the epoch of
+// the binary DATE and TIMESTAMP formats
+constexpr int32_t kEpochDays   = 10957;
+constexpr int64_t kEpochMicros = kEpochDays * Timestamp::kMicrosPerDay;
+
+constexpr uint32_t kBoolOid      = 16;
+constexpr uint32_t kInt8Oid      = 20;
+constexpr uint32_t kInt2Oid      = 21;
+constexpr uint32_t kInt4Oid      = 23;
+constexpr uint32_t kTextOid      = 25;
+constexpr uint32_t kFloat4Oid    = 700;
+constexpr uint32_t kFloat8Oid    = 701;
+constexpr uint32_t kVarCharOid   = 1043;
+constexpr uint32_t kDateOid      = 1082;
+constexpr uint32_t kTimestampOid = 1114;
+
+/**
+ * Reads the fields of a message, a malformed message closes the
+ * connection.
+ */
+class MessageReader {
+ public:
+  MessageReader(const uint8_t* data, size_t size)
+      : data_(data), end_(data + size) {}
+
+  const uint8_t* Bytes(size_t size) {
+    if (static_cast<size_t>(end_ - data_) < size) {
+      throw NetworkProcessException("Truncated message");
+    }
+    auto result = data_;
+    data_ += size;
+    return result;
+  }
+  uint16_t UInt16() {
+    auto bytes = Bytes(2);
+    return static_cast<uint16_t>(bytes[0] << 8 | bytes[1]);
+  }
+  uint32_t UInt32() {
+    auto bytes = Bytes(4);
+    return static_cast<uint32_t>(bytes[0]) << 24 |
+           static_cast<uint32_t>(bytes[1]) << 16 |
+           static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+  }
+  int16_t Int16() { return static_cast<int16_t>(UInt16()); }
+  int32_t Int32() { return static_cast<int32_t>(UInt32()); }
+  uint64_t UInt64() {
+    uint64_t high = UInt32();
+    return high << 32 | UInt32();
+  }
+  std::string String() {
+    auto terminator = std::memchr(data_, 0, static_cast<size_t>(end_ - data_));
+    if (!terminator) {
+      throw NetworkProcessException("Unterminated string in message");
+    }
+    auto size = static_cast<size_t>(static_cast<const uint8_t*>(terminator) -
+                                    data_);
+    std::string result(reinterpret_cast<const char*>(Bytes(size + 1)), size);
+    return result;
+  }
+
+ private:
+  const uint8_t* data_;
+  const uint8_t* end_;
+};
+
+void PutUInt16(uint16_t value, std::vector<uint8_t>& output) {
+  output.push_back(static_cast<uint8_t>(value >> 8));
+  output.push_back(static_cast<uint8_t>(value));
+}
+
+void PutUInt32(uint32_t value, std::vector<uint8_t>& output) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    output.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void PutUInt64(uint64_t value, std::vector<uint8_t>& output) {
+  PutUInt32(static_cast<uint32_t>(value >> 32), output);
+  PutUInt32(static_cast<uint32_t>(value), output);
+}
+
+void PutString(const std::string& value, std::vector<uint8_t>& output) {
+  output.insert(output.end(), value.begin(), value.end());
+  output.push_back(0);
+}
+
+/**
+ * Append the header of a message, returns its position for EndMessage().
+ */
+size_t BeginMessage(char type, std::vector<uint8_t>& output) {
+  auto start = output.size();
+  output.push_back(static_cast<uint8_t>(type));
+  PutUInt32(0, output);
+  return start;
+}
+
+void EndMessage(size_t start, std::vector<uint8_t>& output) {
+  // the length includes itself but not the type
+  auto length = static_cast<uint32_t>(output.size() - start - 1);
+  for (size_t i = 0; i < 4; i++) {
+    output[start + 1 + i] = static_cast<uint8_t>(length >> (24 - 8 * i));
+  }
+}
+
+void WriteEmptyMessage(char type, std::vector<uint8_t>& output) {
+  EndMessage(BeginMessage(type, output), output);
+}
+
+void WriteError(const std::string& message, bool fatal,
+                std::vector<uint8_t>& output) {
+  auto start = BeginMessage('E', output);
+  output.push_back('S');
+  PutString(fatal ? "FATAL" : "ERROR", output);
+  output.push_back('V');
+  PutString(fatal ? "FATAL" : "ERROR", output);
+  // internal_error, the messages do not carry an error code
+  output.push_back('C');
+  PutString("XX000", output);
+  output.push_back('M');
+  PutString(message, output);
+  output.push_back(0);
+  EndMessage(start, output);
+}
+
+void WriteParameterStatus(const char* name, const char* value,
+                          std::vector<uint8_t>& output) {
+  auto start = BeginMessage('S', output);
+  PutString(name, output);
+  PutString(value, output);
+  EndMessage(start, output);
+}
+
+void WriteReadyForQuery(std::vector<uint8_t>& output) {
+  auto start = BeginMessage('Z', output);
+  // idle, every statement commits on its own
+  output.push_back('I');
+  EndMessage(start, output);
+}
+
+uint32_t TypeOid(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+      return kBoolOid;
+    case TypeId::kTinyInt:
+    case TypeId::kSmallInt:
+      return kInt2Oid;
+    case TypeId::kInteger:
+      return kInt4Oid;
+    case TypeId::kBigInt:
+      return kInt8Oid;
+    case TypeId::kDecimal:
+      return kFloat8Oid;
+    case TypeId::kDate:
+      return kDateOid;
+    case TypeId::kTimestamp:
+      return kTimestampOid;
+    default:
+      return kVarCharOid;
+  }
+}
+
+int16_t TypeSize(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+      return 1;
+    case TypeId::kTinyInt:
+    case TypeId::kSmallInt:
+      return 2;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      return 4;
+    case TypeId::kBigInt:
+    case TypeId::kDecimal:
+    case TypeId::kTimestamp:
+      return 8;
+    default:
+      // variable length
+      return -1;
+  }
+}
+
+int16_t ColumnFormat(const std::vector<int16_t>& formats, size_t column) {
+  if (formats.empty()) {
+    return 0;
+  }
+  return formats.size() == 1 ? formats[0] : formats[column];
+}
+
+bool ReturnsRows(const Result& result) {
+  return result.statement_type == StatementType::kSelect ||
+         result.statement_type == StatementType::kExplain;
+}
+
+void CheckFormats(const std::vector<int16_t>& formats, const Result& result) {
+  if (formats.size() > 1 && formats.size() != result.types.size()) {
+    throw ConnectionException("%zu result formats given for %zu columns",
+                              formats.size(), result.types.size());
+  }
+}
+
+void WriteRowDescription(const Result& result,
+                         const std::vector<int16_t>& formats,
+                         std::vector<uint8_t>& output) {
+  auto start = BeginMessage('T', output);
+  PutUInt16(static_cast<uint16_t>(result.types.size()), output);
+  for (size_t i = 0; i < result.types.size(); i++) {
+    PutString(i < result.names.size() ? result.names[i] : "?column?", output);
+    // not a column of a table
+    PutUInt32(0, output);
+    PutUInt16(0, output);
+    PutUInt32(TypeOid(result.types[i]), output);
+    PutUInt16(static_cast<uint16_t>(TypeSize(result.types[i])), output);
+    // no type modifier
+    PutUInt32(0xFFFFFFFF, output);
+    PutUInt16(static_cast<uint16_t>(ColumnFormat(formats, i)), output);
+  }
+  EndMessage(start, output);
+}
+
+/**
+ * Append the value at index of the vector in text format.
+ */
+void PutText(const Vector& vector, size_t index, std::vector<uint8_t>& output) {
+  std::string text;
+  switch (vector.GetType()) {
+    case TypeId::kBoolean:
+      text = vector.GetData<int8_t>()[index] ? "t" : "f";
+      break;
+    case TypeId::kVarChar: {
+      auto value = vector.GetData<const char*>()[index];
+      auto size  = std::strlen(value);
+      PutUInt32(static_cast<uint32_t>(size), output);
+      output.insert(output.end(), value, value + size);
+      return;
+    }
+    default:
+      text = vector.GetValue(index).ToString();
+      break;
+  }
+  PutUInt32(static_cast<uint32_t>(text.size()), output);
+  output.insert(output.end(), text.begin(), text.end());
+}
+
+/**
+ * Append the value at index of the vector in the binary format of the type
+ * given by TypeOid().
+ */
+void PutBinary(const Vector& vector, size_t index,
+               std::vector<uint8_t>& output) {
+  auto type = vector.GetType();
+  if (type == TypeId::kVarChar) {
+    PutText(vector, index, output);
+    return;
+  }
+  PutUInt32(static_cast<uint32_t>(TypeSize(type)), output);
+  switch (type) {
+    case TypeId::kBoolean:
+      output.push_back(vector.GetData<int8_t>()[index] ? 1 : 0);
+      break;
+    case TypeId::kTinyInt:
+      PutUInt16(static_cast<uint16_t>(vector.GetData<int8_t>()[index]),
+                output);
+      break;
+    case TypeId::kSmallInt:
+      PutUInt16(static_cast<uint16_t>(vector.GetData<int16_t>()[index]),
+                output);
+      break;
+    case TypeId::kInteger:
+      PutUInt32(static_cast<uint32_t>(vector.GetData<int32_t>()[index]),
+                output);
+      break;
+    case TypeId::kDate:
+      PutUInt32(static_cast<uint32_t>(vector.GetData<int32_t>()[index] -
+                                      kEpochDays),
+                output);
+      break;
+    case TypeId::kBigInt:
+      PutUInt64(static_cast<uint64_t>(vector.GetData<int64_t>()[index]),
+                output);
+      break;
+    case TypeId::kTimestamp:
+      PutUInt64(static_cast<uint64_t>(vector.GetData<int64_t>()[index] -
+                                      kEpochMicros),
+                output);
+      break;
+    case TypeId::kDecimal:
+      PutUInt64(std::bit_cast<uint64_t>(vector.GetData<double>()[index]),
+                output);
+      break;
+    default:
+      throw NotImplementationException("Unimplemented type %s for binary "
+                                       "results",
+                                       TypeIdToString(type).c_str());
+  }
+}
+
+/**
+ * Append a DataRow message for every row of the result in [begin, end).
+ */
+void WriteRows(const Result& result, const std::vector<int16_t>& formats,
+               size_t begin, size_t end, std::vector<uint8_t>& output) {
+  size_t offset = 0;
+  for (size_t i = 0; i < result.collection.ChunkCount() && offset < end;
+       i++) {
+    auto& chunk     = result.collection.GetChunk(i);
+    auto count      = chunk.GetCount();
+    auto selection  = chunk.GetSelection();
+    auto first      = begin > offset ? begin - offset : 0;
+    auto last       = std::min(count, end - offset);
+    for (size_t row = first; row < last; row++) {
+      auto index = selection ? selection[row] : row;
+      auto start = BeginMessage('D', output);
+      PutUInt16(static_cast<uint16_t>(chunk.ColumnCount()), output);
+      for (size_t column = 0; column < chunk.ColumnCount(); column++) {
+        auto& vector = chunk.GetVector(column);
+        if (vector.IsNull(index)) {
+          PutUInt32(0xFFFFFFFF, output);
+        } else if (ColumnFormat(formats, column) == 0) {
+          PutText(vector, index, output);
+        } else {
+          PutBinary(vector, index, output);
+        }
+      }
+      EndMessage(start, output);
+    }
+    offset += count;
+  }
+}
+
+void WriteCommandComplete(const Result& result, size_t rows,
+                          std::vector<uint8_t>& output) {
+  std::string count = "0";
+  if (!ReturnsRows(result) && result.RowCount() > 0) {
+    // the number of rows changed
+    count = result.GetValue(0, 0).ToString();
+  }
+  std::string tag;
+  switch (result.statement_type) {
+    case StatementType::kSelect:
+      tag = "SELECT " + std::to_string(rows);
+      break;
+    case StatementType::kInsert:
+      tag = "INSERT 0 " + count;
+      break;
+    case StatementType::kUpdate:
+      tag = "UPDATE " + count;
+      break;
+    case StatementType::kDelete:
+      tag = "DELETE " + count;
+      break;
+    case StatementType::kCopy:
+      tag = "COPY " + count;
+      break;
+    case StatementType::kCreate:
+      tag = "CREATE";
+      break;
+    case StatementType::kDrop:
+      tag = "DROP";
+      break;
+    case StatementType::kAnalyze:
+      tag = "ANALYZE";
+      break;
+    default:
+      tag = "EXPLAIN";
+      break;
+  }
+  auto start = BeginMessage('C', output);
+  PutString(tag, output);
+  EndMessage(start, output);
+}
+
+bool IsIdentifierCharacter(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+         c == '$' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+/**
+ * A reference $n to a parameter in the text of a statement.
+ */
+struct ParameterReference {
+  size_t begin;
+  size_t end;
+  size_t index;
+};
+
+/**
+ * Find the parameter references of a statement, skipping string literals,
+ * quoted identifiers and comments.
+ */
+std::vector<ParameterReference> FindParameters(const std::string& query) {
+  std::vector<ParameterReference> result;
+  size_t i = 0;
+  auto n   = query.size();
+  while (i < n) {
+    auto c    = query[i];
+    auto next = i + 1 < n ? query[i + 1] : '\0';
+    if (c == '\'') {
+      // E'...' allows backslash escapes
+      bool escapes = i > 0 && (query[i - 1] == 'E' || query[i - 1] == 'e') &&
+                     (i < 2 || !IsIdentifierCharacter(query[i - 2]));
+      for (i++; i < n; i++) {
+        if (escapes && query[i] == '\\') {
+          i++;
+        } else if (query[i] == '\'') {
+          if (i + 1 < n && query[i + 1] == '\'') {
+            i++;
+          } else {
+            break;
+          }
+        }
+      }
+      i++;
+    } else if (c == '"') {
+      // a doubled quote starts over as the next identifier
+      auto close = query.find('"', i + 1);
+      i          = close == std::string::npos ? n : close + 1;
+    } else if (c == '-' && next == '-') {
+      auto close = query.find('\n', i);
+      i          = close == std::string::npos ? n : close + 1;
+    } else if (c == '/' && next == '*') {
+      // block comments nest
+      size_t depth = 1;
+      for (i += 2; i < n && depth > 0; i++) {
+        if (query[i] == '/' && i + 1 < n && query[i + 1] == '*') {
+          depth++;
+          i++;
+        } else if (query[i] == '*' && i + 1 < n && query[i + 1] == '/') {
+          depth--;
+          i++;
+        }
+      }
+    } else if (c == '$' && (i == 0 || !IsIdentifierCharacter(query[i - 1]))) {
+      if (std::isdigit(static_cast<unsigned char>(next))) {
+        size_t index = 0;
+        size_t end   = i + 1;
+        for (; end < n && std::isdigit(static_cast<unsigned char>(query[end]));
+             end++) {
+          index = index * 10 + static_cast<size_t>(query[end] - '0');
+          if (index > 65535) {
+            throw ConnectionException("Parameter number is too large");
+          }
+        }
+        result.push_back({i, end, index});
+        i = end;
+        continue;
+      }
+      // a dollar quoted string $tag$...$tag$
+      auto end = i + 1;
+      while (end < n && query[end] != '$' &&
+             IsIdentifierCharacter(query[end])) {
+        end++;
+      }
+      if (end < n && query[end] == '$') {
+        auto tag   = query.substr(i, end + 1 - i);
+        auto close = query.find(tag, end + 1);
+        i          = close == std::string::npos ? n : close + tag.size();
+      } else {
+        i++;
+      }
+    } else {
+      i++;
+    }
+  }
+  return result;
+}
+
+size_t ParameterCount(const std::vector<ParameterReference>& references) {
+  size_t count = 0;
+  for (auto& reference : references) {
+    count = std::max(count, reference.index);
+  }
+  return count;
+}
+
+std::string QuoteLiteral(const std::string& value) {
+  std::string result = "'";
+  for (auto c : value) {
+    result += c;
+    if (c == '\'') {
+      result += c;
+    }
+  }
+  return result + "'";
+}
+
+bool IsNumericType(uint32_t oid) {
+  return oid == kInt2Oid || oid == kInt4Oid || oid == kInt8Oid ||
+         oid == kFloat4Oid || oid == kFloat8Oid;
+}
+
+/**
+ * The literal for a text parameter of a numeric type, formatted from the
+ * parsed value so that the text cannot change the query. Returns an empty
+ * string if the text is not a finite number of the type.
+ */
+std::string NumericLiteral(uint32_t oid, const std::string& text) {
+  if (text.empty()) {
+    return std::string();
+  }
+  char* end = nullptr;
+  errno     = 0;
+  if (oid == kFloat4Oid || oid == kFloat8Oid) {
+    auto value = std::strtod(text.c_str(), &end);
+    if (*end != '\0' || errno != 0 || !std::isfinite(value)) {
+      return std::string();
+    }
+    // parenthesized, a negative number must not turn "- $1" into a comment
+    return "(" + Value::Decimal(value).ToString() + ")";
+  }
+  auto value = std::strtoll(text.c_str(), &end, 10);
+  if (*end != '\0' || errno != 0) {
+    return std::string();
+  }
+  return "(" + std::to_string(value) + ")";
+}
+
+/**
+ * The SQL literal for a parameter value of the given type OID (0 if
+ * unspecified) in the given format.
+ */
+std::string ParameterLiteral(uint32_t oid, int16_t format,
+                             const uint8_t* data, size_t size) {
+  std::string text;
+  if (format == 0) {
+    text.assign(reinterpret_cast<const char*>(data), size);
+    auto literal = IsNumericType(oid) ? NumericLiteral(oid, text) : "";
+    // anything else is cast from a string by the binder
+    return literal.empty() ? QuoteLiteral(text) : literal;
+  }
+  MessageReader reader(data, size);
+  switch (oid) {
+    case kBoolOid:
+      return reader.Bytes(1)[0] ? "true" : "false";
+    case kInt2Oid:
+      return "(" + std::to_string(reader.Int16()) + ")";
+    case kInt4Oid:
+      return "(" + std::to_string(reader.Int32()) + ")";
+    case kInt8Oid:
+      return "(" + std::to_string(static_cast<int64_t>(reader.UInt64())) +
+             ")";
+    case kFloat4Oid:
+      return "(" +
+             Value::Decimal(std::bit_cast<float>(reader.UInt32())).ToString() +
+             ")";
+    case kFloat8Oid:
+      return "(" +
+             Value::Decimal(std::bit_cast<double>(reader.UInt64())).ToString() +
+             ")";
+    case kDateOid:
+      return QuoteLiteral(Date::ToString(reader.Int32() + kEpochDays));
+    case kTimestampOid:
+      return QuoteLiteral(Timestamp::ToString(
+          static_cast<int64_t>(reader.UInt64()) + kEpochMicros));
+    case 0:
+    case kTextOid:
+    case kVarCharOid:
+      text.assign(reinterpret_cast<const char*>(data), size);
+      return QuoteLiteral(text);
+    default:
+      throw NotImplementationException(
+          "Binary parameters of type %u are not supported", oid);
+  }
+}
+
+/**
+ * Replace the parameter references of the query by the literals.
+ */
+std::string SubstituteParameters(
+    const std::string& query,
+    const std::vector<ParameterReference>& references,
+    const std::vector<std::string>& literals) {
+  std::string result;
+  size_t position = 0;
+  for (auto& reference : references) {
+    if (reference.index == 0 || reference.index > literals.size()) {
+      throw ConnectionException("There is no parameter $%zu",
+                                reference.index);
+    }
+    result.append(query, position, reference.begin - position);
+    result += literals[reference.index - 1];
+    position = reference.end;
+  }
+  result.append(query, position);
+  return result;
+}
+
+}  // namespace
+
+PgSession::PgSession(Database& database) : connection_(database) {}
+
+bool PgSession::Process(std::vector<uint8_t>& input,
+                        std::vector<uint8_t>& output) {
+  size_t position = 0;
+  bool keep_open  = true;
+  try {
+    while (keep_open) {
+      // the startup message has no type
+      size_t header = started_ ? 5 : 4;
+      if (input.size() - position < header) {
+        break;
+      }
+      MessageReader reader(input.data() + position + header - 4, 4);
+      auto length = reader.UInt32();
+      if (length < 4 || length > kMaxMessageSize) {
+        throw NetworkProcessException("Invalid message length %u", length);
+      }
+      if (input.size() - position < header + length - 4) {
+        break;
+      }
+      auto type = input[position];
+      auto data = input.data() + position + header;
+      auto size = static_cast<size_t>(length - 4);
+      position += header + size;
+      keep_open = started_ ? Dispatch(type, data, size, output)
+                           : Startup(data, size, output);
+    }
+  } catch (NetworkProcessException& e) {
+    WriteError(e.GetMessage(), true, output);
+    keep_open = false;
+  }
+  input.erase(input.begin(),
+              input.begin() + static_cast<std::ptrdiff_t>(position));
+  return keep_open;
+}
+
+bool PgSession::Startup(const uint8_t* data, size_t size,
+                        std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto version = reader.Int32();
+  switch (version) {
+    case kSSLRequest:
+    case kGSSENCRequest:
+      // not supported, the client goes on without encryption
+      output.push_back('N');
+      return true;
+    case kCancelRequest:
+      // the queries are not cancellable
+      return false;
+    case kProtocolVersion3:
+      break;
+    default:
+      WriteError("Unsupported frontend protocol " +
+                     std::to_string(version >> 16) + "." +
+                     std::to_string(version & 0xFFFF),
+                 true, output);
+      return false;
+  }
+  // the parameters (user, database, options, ...) are ignored
+  started_ = true;
+  auto start = BeginMessage('R', output);
+  // AuthenticationOk
+  PutUInt32(0, output);
+  EndMessage(start, output);
+  WriteParameterStatus("server_version", "16.0", output);
+  WriteParameterStatus("server_encoding", "UTF8", output);
+  WriteParameterStatus("client_encoding", "UTF8", output);
+  WriteParameterStatus("DateStyle", "ISO, MDY", output);
+  WriteParameterStatus("TimeZone", "UTC", output);
+  WriteParameterStatus("integer_datetimes", "on", output);
+  WriteParameterStatus("standard_conforming_strings", "on", output);
+  start = BeginMessage('K', output);
+  // BackendKeyData, there is nothing to cancel
+  PutUInt32(0, output);
+  PutUInt32(0, output);
+  EndMessage(start, output);
+  WriteReadyForQuery(output);
+  return true;
+}
+
+bool PgSession::Dispatch(uint8_t type, const uint8_t* data, size_t size,
+                         std::vector<uint8_t>& output) {
+  if (type == 'X') {
+    return false;
+  }
+  if (type == 'S') {
+    // Sync ends the implicit transaction, which closes its portals
+    failed_ = false;
+    portals_.clear();
+    WriteReadyForQuery(output);
+    return true;
+  }
+  if (failed_) {
+    return true;
+  }
+  try {
+    switch (type) {
+      case 'Q':
+        SimpleQuery(data, size, output);
+        break;
+      case 'P':
+        Parse(data, size, output);
+        break;
+      case 'B':
+        Bind(data, size, output);
+        break;
+      case 'D':
+        Describe(data, size, output);
+        break;
+      case 'E':
+        Execute(data, size, output);
+        break;
+      case 'C':
+        Close(data, size, output);
+        break;
+      case 'H':
+        // Flush, the responses are sent once the input is processed
+        break;
+      default:
+        throw ConnectionException("Unsupported message type '%c'", type);
+    }
+  } catch (NetworkProcessException&) {
+    throw;
+  } catch (Exception& e) {
+    if (type == 'Q') {
+      WriteError(e.GetMessage(), false, output);
+      WriteReadyForQuery(output);
+    } else {
+      Fail(e.GetMessage(), output);
+    }
+  }
+  return true;
+}
+
+void PgSession::SimpleQuery(const uint8_t* data, size_t size,
+                            std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto query = reader.String();
+  statements_.erase("");
+  portals_.erase("");
+  // every statement of the query is answered on its own, up to the first
+  // one that fails
+  size_t executed = 0;
+  auto result     = connection_.Query(query.c_str(), [&](Result& statement) {
+    if (ReturnsRows(statement)) {
+      WriteRowDescription(statement, {}, output);
+      WriteRows(statement, {}, 0, statement.RowCount(), output);
+    }
+    WriteCommandComplete(statement, statement.RowCount(), output);
+    executed++;
+  });
+  if (!result.success) {
+    WriteError(result.error, false, output);
+  } else if (executed == 0) {
+    WriteEmptyMessage('I', output);
+  }
+  WriteReadyForQuery(output);
+}
+
+void PgSession::Parse(const uint8_t* data, size_t size,
+                      std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto name = reader.String();
+  PreparedStatement statement;
+  statement.query = reader.String();
+  auto count      = reader.UInt16();
+  for (size_t i = 0; i < count; i++) {
+    statement.parameter_types.push_back(reader.UInt32());
+  }
+  statement.parameter_count = std::max<size_t>(
+      count, ParameterCount(FindParameters(statement.query)));
+  if (!name.empty() && statements_.count(name)) {
+    throw ConnectionException("Prepared statement \"%s\" already exists",
+                              name.c_str());
+  }
+  statements_[name] = std::move(statement);
+  WriteEmptyMessage('1', output);
+}
+
+void PgSession::Bind(const uint8_t* data, size_t size,
+                     std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto portal_name    = reader.String();
+  auto statement_name = reader.String();
+  auto entry          = statements_.find(statement_name);
+  if (entry == statements_.end()) {
+    throw ConnectionException("Prepared statement \"%s\" does not exist",
+                              statement_name.c_str());
+  }
+  auto& statement = entry->second;
+  std::vector<int16_t> parameter_formats(reader.UInt16());
+  for (auto& format : parameter_formats) {
+    format = reader.Int16();
+  }
+  size_t count = reader.UInt16();
+  if (count != statement.parameter_count ||
+      (parameter_formats.size() > 1 && parameter_formats.size() != count)) {
+    throw ConnectionException(
+        "Bind supplies %zu parameters, but prepared statement \"%s\" "
+        "requires %zu",
+        count, statement_name.c_str(), statement.parameter_count);
+  }
+  std::vector<std::string> literals;
+  for (size_t i = 0; i < count; i++) {
+    auto length = reader.Int32();
+    if (length < 0) {
+      literals.emplace_back("NULL");
+      continue;
+    }
+    auto value = reader.Bytes(static_cast<size_t>(length));
+    auto oid   = i < statement.parameter_types.size()
+                     ? statement.parameter_types[i]
+                     : 0;
+    literals.push_back(ParameterLiteral(oid,
+                                        ColumnFormat(parameter_formats, i),
+                                        value, static_cast<size_t>(length)));
+  }
+  Portal portal;
+  portal.formats.resize(reader.UInt16());
+  for (auto& format : portal.formats) {
+    format = reader.Int16();
+  }
+  portal.query = SubstituteParameters(
+      statement.query, FindParameters(statement.query), literals);
+  portals_[portal_name] = std::move(portal);
+  WriteEmptyMessage('2', output);
+}
+
+void PgSession::Describe(const uint8_t* data, size_t size,
+                         std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto kind = reader.Bytes(1)[0];
+  auto name = reader.String();
+  if (kind == 'P') {
+    auto entry = portals_.find(name);
+    if (entry == portals_.end()) {
+      throw ConnectionException("Portal \"%s\" does not exist",
+                                name.c_str());
+    }
+    // planned without running it, the statement runs on Execute
+    auto& portal = entry->second;
+    auto result  = connection_.Describe(portal.query.c_str());
+    if (!result.success) {
+      Fail(result.error, output);
+      return;
+    }
+    CheckFormats(portal.formats, result);
+    if (ReturnsRows(result)) {
+      WriteRowDescription(result, portal.formats, output);
+    } else {
+      WriteEmptyMessage('n', output);
+    }
+    return;
+  }
+  auto entry = statements_.find(name);
+  if (entry == statements_.end()) {
+    throw ConnectionException("Prepared statement \"%s\" does not exist",
+                              name.c_str());
+  }
+  auto& statement = entry->second;
+  auto start      = BeginMessage('t', output);
+  PutUInt16(static_cast<uint16_t>(statement.parameter_count), output);
+  for (size_t i = 0; i < statement.parameter_count; i++) {
+    auto oid = i < statement.parameter_types.size()
+                   ? statement.parameter_types[i]
+                   : 0;
+    // unknown types are taken as text, converted like string literals
+    PutUInt32(oid == 0 ? kTextOid : oid, output);
+  }
+  EndMessage(start, output);
+  // the columns do not depend on the values of the parameters
+  std::vector<std::string> nulls(statement.parameter_count, "NULL");
+  auto query  = SubstituteParameters(statement.query,
+                                     FindParameters(statement.query), nulls);
+  auto result = connection_.Describe(query.c_str());
+  if (!result.success) {
+    Fail(result.error, output);
+  } else if (ReturnsRows(result)) {
+    WriteRowDescription(result, {}, output);
+  } else {
+    WriteEmptyMessage('n', output);
+  }
+}
+
+void PgSession::Execute(const uint8_t* data, size_t size,
+                        std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto name     = reader.String();
+  auto max_rows = reader.UInt32();
+  auto entry    = portals_.find(name);
+  if (entry == portals_.end()) {
+    throw ConnectionException("Portal \"%s\" does not exist", name.c_str());
+  }
+  auto& portal = entry->second;
+  auto& result = Run(portal);
+  if (!result.success) {
+    Fail(result.error, output);
+    return;
+  }
+  if (result.statement_type == StatementType::kInvalid) {
+    WriteEmptyMessage('I', output);
+    return;
+  }
+  if (!ReturnsRows(result)) {
+    WriteCommandComplete(result, 0, output);
+    return;
+  }
+  auto begin = portal.position;
+  auto end   = result.RowCount();
+  if (max_rows > 0 && end - begin > max_rows) {
+    end = begin + max_rows;
+  }
+  WriteRows(result, portal.formats, begin, end, output);
+  portal.position = end;
+  if (end < result.RowCount()) {
+    WriteEmptyMessage('s', output);
+  } else {
+    WriteCommandComplete(result, end - begin, output);
+  }
+}
+
+void PgSession::Close(const uint8_t* data, size_t size,
+                      std::vector<uint8_t>& output) {
+  MessageReader reader(data, size);
+  auto kind = reader.Bytes(1)[0];
+  auto name = reader.String();
+  if (kind == 'P') {
+    portals_.erase(name);
+  } else {
+    statements_.erase(name);
+  }
+  WriteEmptyMessage('3', output);
+}
+
+Result& PgSession::Run(Portal& portal) {
+  if (!portal.executed) {
+    portal.result   = connection_.Query(portal.query.c_str());
+    portal.executed = true;
+  }
+  if (portal.result.success) {
+    CheckFormats(portal.formats, portal.result);
+  }
+  return portal.result;
+}
+
+void PgSession::Fail(const std::string& message,
+                     std::vector<uint8_t>& output) {
+  WriteError(message, false, output);
+  failed_ = true;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,138 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "main/query_profiler.hpp"
+
+#include "common/string_util.hpp"
+#include "execution/physical_operator.hpp"
+
+namespace zoomdb {
+
+void OperatorMetrics::Merge(const OperatorMetrics& other) {
+  time_ns         += other.time_ns;
+  cycles          += other.cycles;
+  rows_out        += other.rows_out;
+  bytes_allocated += other.bytes_allocated;
+  bytes_spilled   += other.bytes_spilled;
+}
+
+QueryProfiler::QueryProfiler() : root_(nullptr), total_time_ns_(0) {}
+
+void QueryProfiler::StartQuery(const PhysicalOperator& plan) {
+  std::lock_guard<std::mutex> guard(lock_);
+  root_ = &plan;
+  metrics_.clear();
+  threads_.clear();
+  total_time_ns_ = 0;
+  start_         = std::chrono::steady_clock::now();
+}
+
+void QueryProfiler::EndQuery() {
+  auto end = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> guard(lock_);
+  total_time_ns_ = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+          .count());
+}
+
+void QueryProfiler::Flush(const PhysicalOperator& op,
+                          const OperatorMetrics& metrics) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto thread = threads_.emplace(std::this_thread::get_id(), threads_.size())
+                    .first->second;
+  metrics_[&op][thread].Merge(metrics);
+}
+
+OperatorMetrics QueryProfiler::GetMetrics(const PhysicalOperator& op) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  OperatorMetrics result;
+  auto entry = metrics_.find(&op);
+  if (entry != metrics_.end()) {
+    for (auto& thread : entry->second) {
+      result.Merge(thread.second);
+    }
+  }
+  return result;
+}
+
+OperatorMetrics QueryProfiler::GetMetrics(const PhysicalOperator& op,
+                                          size_t thread) const {
+  auto entry = metrics_.find(&op);
+  if (entry == metrics_.end()) {
+    return OperatorMetrics();
+  }
+  auto metrics = entry->second.find(thread);
+  return metrics == entry->second.end() ? OperatorMetrics() : metrics->second;
+}
+
+static std::string FormatTime(uint64_t time_ns) {
+  return StringUtil::Format("%.3fms", static_cast<double>(time_ns) / 1e6);
+}
+
+static std::string FormatMetrics(const OperatorMetrics& metrics,
+                                 const OperatorMetrics& children) {
+  uint64_t self_ns = metrics.time_ns > children.time_ns
+                         ? metrics.time_ns - children.time_ns
+                         : 0;
+  uint64_t self_cycles =
+      metrics.cycles > children.cycles ? metrics.cycles - children.cycles : 0;
+  return "time: " + FormatTime(metrics.time_ns) +
+         " (self: " + FormatTime(self_ns) +
+         "), cycles: " + std::to_string(self_cycles) +
+         ", rows in: " + std::to_string(children.rows_out) +
+         ", rows out: " + std::to_string(metrics.rows_out) +
+         ", allocated: " +
+         StringUtil::FormatSize(static_cast<long>(metrics.bytes_allocated)) +
+         ", spilled: " +
+         StringUtil::FormatSize(static_cast<long>(metrics.bytes_spilled));
+}
+
+std::string QueryProfiler::RenderOperator(const PhysicalOperator& op) const {
+  std::string result = op.GetName();
+
+  // the input of the operator is the sum of the outputs of its children
+  std::vector<size_t> threads;
+  auto entry = metrics_.find(&op);
+  if (entry != metrics_.end()) {
+    for (auto& thread : entry->second) {
+      threads.push_back(thread.first);
+    }
+  }
+  OperatorMetrics total;
+  OperatorMetrics total_children;
+  std::string thread_lines;
+  for (auto thread : threads) {
+    auto metrics = GetMetrics(op, thread);
+    OperatorMetrics children;
+    for (auto& child : op.children) {
+      children.Merge(GetMetrics(*child, thread));
+    }
+    total.Merge(metrics);
+    total_children.Merge(children);
+    thread_lines += "\n| thread " + std::to_string(thread) + ": " +
+                    FormatMetrics(metrics, children);
+  }
+  result += "\n| " + FormatMetrics(total, total_children);
+  if (threads.size() > 1) {
+    result += thread_lines;
+  }
+  for (auto& child : op.children) {
+    result += "\n" + StringUtil::Prefix(RenderOperator(*child), "  ");
+  }
+  return result;
+}
+
+std::string QueryProfiler::ToString() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!root_) {
+    return "Query profiling is disabled";
+  }
+  return "Total time: " + FormatTime(total_time_ns_) + ", threads: " +
+         std::to_string(threads_.size()) + "\n" + RenderOperator(*root_);
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,317 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "main/server.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+constexpr size_t kReadSize = 64 << 10;
+// the most that is read from a client before its session processes it
+constexpr size_t kMaxReceiveSize = 1 << 20;
+// the largest message of the sessions and one read, a client with more
+// input that its session left unprocessed is dropped
+constexpr size_t kMaxInputSize = (64 << 20) + kReadSize;
+
+}  // namespace
+
+Server::Server(Database& database, uint16_t port, size_t thread_count,
+               SessionFactory factory)
+    : database_(database),
+      factory_(std::move(factory)),
+      thread_count_(thread_count),
+      port_(port),
+      listen_fd_(-1),
+      epoll_fd_(-1),
+      wake_fd_(-1),
+      stopped_(false) {
+  if (thread_count_ == 0) {
+    thread_count_ = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0) {
+    throw NetworkProcessException("Could not create a socket: %s",
+                                  std::strerror(errno));
+  }
+  int reuse = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address{};
+  address.sin_family      = AF_INET;
+  address.sin_port        = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t length        = sizeof(address);
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), length) < 0 ||
+      listen(listen_fd_, SOMAXCONN) < 0 ||
+      getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+                  &length) < 0) {
+    auto error = errno;
+    close(listen_fd_);
+    throw NetworkProcessException("Could not listen on port %u: %s",
+                                  static_cast<unsigned>(port),
+                                  std::strerror(error));
+  }
+  port_     = ntohs(address.sin_port);
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_fd_ < 0) {
+    auto error = errno;
+    close(listen_fd_);
+    throw NetworkProcessException("Could not create the event loop: %s",
+                                  std::strerror(error));
+  }
+  epoll_event event{};
+  event.events  = EPOLLIN;
+  event.data.fd = listen_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event);
+  event.data.fd = wake_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+}
+
+Server::~Server() {
+  for (auto& entry : clients_) {
+    close(entry.first);
+  }
+  close(wake_fd_);
+  close(epoll_fd_);
+  close(listen_fd_);
+}
+
+void Server::Run() {
+  shutdown_ = false;
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < thread_count_; i++) {
+    workers.emplace_back([this]() { Work(); });
+  }
+
+  epoll_event events[64];
+  while (!stopped_) {
+    auto count = epoll_wait(epoll_fd_, events, 64, -1);
+    if (count < 0 && errno != EINTR) {
+      break;
+    }
+    for (int i = 0; i < count; i++) {
+      auto fd = events[i].data.fd;
+      if (fd == listen_fd_) {
+        Accept();
+        continue;
+      }
+      if (fd == wake_fd_) {
+        uint64_t value;
+        [[maybe_unused]] auto ignored = read(wake_fd_, &value, sizeof(value));
+        Complete();
+        continue;
+      }
+      auto entry = clients_.find(fd);
+      if (entry == clients_.end()) {
+        continue;
+      }
+      auto& client = *entry->second;
+      if (client.busy) {
+        // a hang up is reported even while the client is not watched
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+        client.closed = true;
+      } else if (events[i].events & EPOLLOUT) {
+        Send(client);
+      } else {
+        Receive(client);
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    shutdown_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  completed_.clear();
+  work_.clear();
+  for (auto& entry : clients_) {
+    close(entry.first);
+  }
+  clients_.clear();
+}
+
+void Server::Stop() {
+  stopped_      = true;
+  uint64_t wake = 1;
+  [[maybe_unused]] auto ignored = write(wake_fd_, &wake, sizeof(wake));
+}
+
+void Server::Accept() {
+  while (true) {
+    int fd = accept4(listen_fd_, nullptr, nullptr,
+                     SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      return;
+    }
+    int no_delay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    auto client     = std::make_unique<Client>();
+    client->fd      = fd;
+    client->session = factory_(database_);
+    epoll_event event{};
+    event.events  = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+    clients_.emplace(fd, std::move(client));
+  }
+}
+
+void Server::Receive(Client& client) {
+  bool failed  = false;
+  size_t total = 0;
+  while (total < kMaxReceiveSize) {
+    auto size = client.input.size();
+    if (size >= kMaxInputSize) {
+      failed = true;
+      break;
+    }
+    client.input.resize(size + kReadSize);
+    auto received = read(client.fd, client.input.data() + size, kReadSize);
+    if (received > 0) {
+      client.input.resize(size + static_cast<size_t>(received));
+      total += static_cast<size_t>(received);
+      continue;
+    }
+    client.input.resize(size);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received == 0) {
+      client.read_closed = true;
+    } else {
+      failed = errno != EAGAIN && errno != EWOULDBLOCK;
+    }
+    break;
+  }
+  if (failed || (client.read_closed && client.input.empty())) {
+    Close(client);
+  } else if (!client.input.empty()) {
+    // after a half close the requests received so far are still answered
+    Submit(client);
+  }
+}
+
+void Server::Send(Client& client) {
+  while (client.written < client.output.size()) {
+    auto sent = send(client.fd, client.output.data() + client.written,
+                     client.output.size() - client.written, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        Watch(client, EPOLLOUT);
+        return;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      Close(client);
+      return;
+    }
+    client.written += static_cast<size_t>(sent);
+  }
+  client.output.clear();
+  client.written = 0;
+  if (client.read_closed) {
+    Close(client);
+    return;
+  }
+  Watch(client, EPOLLIN | EPOLLRDHUP);
+}
+
+void Server::Submit(Client& client) {
+  client.busy = true;
+  // not read from until the session is done
+  Watch(client, 0);
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    work_.push_back(&client);
+  }
+  work_available_.notify_one();
+}
+
+void Server::Complete() {
+  std::vector<std::pair<Client*, bool>> completed;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    completed.swap(completed_);
+  }
+  for (auto& [client, keep_open] : completed) {
+    client->busy = false;
+    if (client->closed || !keep_open) {
+      Close(*client);
+    } else {
+      Send(*client);
+    }
+  }
+}
+
+void Server::Watch(Client& client, uint32_t events) {
+  epoll_event event{};
+  event.events  = events;
+  event.data.fd = client.fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.fd, &event);
+}
+
+void Server::Close(Client& client) {
+  if (client.busy) {
+    // closed once the worker is done with it
+    client.closed = true;
+    return;
+  }
+  auto fd = client.fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  clients_.erase(fd);
+}
+
+void Server::Work() {
+  while (true) {
+    Client* client;
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      work_available_.wait(guard,
+                           [&]() { return shutdown_ || !work_.empty(); });
+      if (shutdown_) {
+        return;
+      }
+      client = work_.front();
+      work_.pop_front();
+    }
+    bool keep_open;
+    try {
+      keep_open = client->session->Process(client->input, client->output);
+    } catch (std::exception&) {
+      keep_open = false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      completed_.emplace_back(client, keep_open);
+    }
+    uint64_t wake = 1;
+    [[maybe_unused]] auto ignored = write(wake_fd_, &wake, sizeof(wake));
+  }
+}
+
+}  // namespace zoomdb
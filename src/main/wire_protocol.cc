@@ -0,0 +1,234 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "main/wire_protocol.hpp"
+
+#include <cstring>
+#include <string>
+
+#include "common/exception.hpp"
+#include "common/lz4.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+// chunks smaller than this are not worth compressing
+constexpr size_t kMinCompressSize = 256;
+
+template <class T>
+void Put(T value, std::vector<uint8_t>& output) {
+  for (size_t i = 0; i < sizeof(T); i++) {
+    output.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >>
+                                          (8 * i)));
+  }
+}
+
+template <class T>
+T Get(const uint8_t*& data, const uint8_t* end) {
+  if (static_cast<size_t>(end - data) < sizeof(T)) {
+    throw SerializationException("Truncated message");
+  }
+  uint64_t value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  data += sizeof(T);
+  return static_cast<T>(value);
+}
+
+/**
+ * Append the header of a message, returns its position for EndMessage().
+ */
+size_t BeginMessage(WireMessage type, std::vector<uint8_t>& output) {
+  auto start = output.size();
+  output.push_back(static_cast<uint8_t>(type));
+  Put<uint32_t>(0, output);
+  return start;
+}
+
+void EndMessage(size_t start, std::vector<uint8_t>& output) {
+  auto size = static_cast<uint32_t>(output.size() - start - 5);
+  for (size_t i = 0; i < 4; i++) {
+    output[start + 1 + i] = static_cast<uint8_t>(size >> (8 * i));
+  }
+}
+
+void WriteError(const std::string& message, std::vector<uint8_t>& output) {
+  auto start = BeginMessage(WireMessage::kError, output);
+  output.insert(output.end(), message.begin(), message.end());
+  EndMessage(start, output);
+}
+
+}  // namespace
+
+void SerializeChunk(const DataChunk& chunk, std::vector<uint8_t>& output) {
+  auto count     = chunk.GetCount();
+  auto selection = chunk.GetSelection();
+  Put(static_cast<uint32_t>(count), output);
+  for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+    auto& vector = chunk.GetVector(i);
+    auto bitmap  = output.size();
+    output.resize(bitmap + (count + 7) / 8, 0);
+    for (size_t row = 0; row < count; row++) {
+      if (vector.IsNull(selection ? selection[row] : row)) {
+        output[bitmap + row / 8] |= static_cast<uint8_t>(1 << (row % 8));
+      }
+    }
+    if (vector.GetType() == TypeId::kVarChar) {
+      auto strings = vector.GetData<const char*>();
+      for (size_t row = 0; row < count; row++) {
+        auto index = selection ? selection[row] : row;
+        auto size  = vector.IsNull(index) ? 0 : std::strlen(strings[index]);
+        Put(static_cast<uint32_t>(size), output);
+        output.insert(output.end(), strings[index], strings[index] + size);
+      }
+    } else if (selection) {
+      auto width = GetTypeIdSize(vector.GetType());
+      auto data  = reinterpret_cast<const uint8_t*>(vector.GetData());
+      for (size_t row = 0; row < count; row++) {
+        output.insert(output.end(), data + selection[row] * width,
+                      data + (selection[row] + 1) * width);
+      }
+    } else {
+      auto data = reinterpret_cast<const uint8_t*>(vector.GetData());
+      output.insert(output.end(), data,
+                    data + count * GetTypeIdSize(vector.GetType()));
+    }
+  }
+}
+
+void DeserializeChunk(const uint8_t* data, size_t size, DataChunk& chunk) {
+  auto end   = data + size;
+  auto count = Get<uint32_t>(data, end);
+  if (count > kStandardVectorSize) {
+    throw SerializationException("Chunk has too many rows");
+  }
+  chunk.Reset();
+  for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+    auto& vector = chunk.GetVector(i);
+    auto bitmap  = data;
+    if (static_cast<size_t>(end - data) < (count + 7) / 8) {
+      throw SerializationException("Truncated message");
+    }
+    data += (count + 7) / 8;
+    vector.SetCount(count);
+    for (size_t row = 0; row < count; row++) {
+      vector.SetNull(row, (bitmap[row / 8] >> (row % 8)) & 1);
+    }
+    if (vector.GetType() == TypeId::kVarChar) {
+      auto strings = vector.GetData<const char*>();
+      for (size_t row = 0; row < count; row++) {
+        auto length = Get<uint32_t>(data, end);
+        if (static_cast<size_t>(end - data) < length) {
+          throw SerializationException("Truncated message");
+        }
+        strings[row] =
+            vector.IsNull(row)
+                ? nullptr
+                : vector.AddString(reinterpret_cast<const char*>(data),
+                                   length);
+        data += length;
+      }
+    } else {
+      auto bytes = count * GetTypeIdSize(vector.GetType());
+      if (static_cast<size_t>(end - data) < bytes) {
+        throw SerializationException("Truncated message");
+      }
+      std::memcpy(vector.GetData(), data, bytes);
+      data += bytes;
+    }
+  }
+}
+
+void WriteResult(const Result& result, bool compress,
+                 std::vector<uint8_t>& output) {
+  if (!result.success) {
+    WriteError(result.error, output);
+    return;
+  }
+  auto start = BeginMessage(WireMessage::kHeader, output);
+  Put(static_cast<uint32_t>(result.types.size()), output);
+  for (size_t i = 0; i < result.types.size(); i++) {
+    auto& name = i < result.names.size() ? result.names[i] : std::string();
+    Put(static_cast<uint8_t>(result.types[i]), output);
+    Put(static_cast<uint16_t>(name.size()), output);
+    output.insert(output.end(), name.begin(), name.end());
+  }
+  EndMessage(start, output);
+
+  std::vector<uint8_t> serialized;
+  for (size_t i = 0; i < result.collection.ChunkCount(); i++) {
+    serialized.clear();
+    SerializeChunk(result.collection.GetChunk(i), serialized);
+    start = BeginMessage(WireMessage::kChunk, output);
+    auto header = output.size();
+    Put(static_cast<uint8_t>(WireCompression::kLZ4), output);
+    Put(static_cast<uint32_t>(serialized.size()), output);
+    if (compress && serialized.size() >= kMinCompressSize) {
+      LZ4Compress(serialized.data(), serialized.size(), output);
+    }
+    if (output.size() == header + 5 ||
+        output.size() - header - 5 >= serialized.size()) {
+      // not compressed, or compression did not pay off
+      output.resize(header + 5);
+      output[header] = static_cast<uint8_t>(WireCompression::kNone);
+      output.insert(output.end(), serialized.begin(), serialized.end());
+    }
+    EndMessage(start, output);
+  }
+  start = BeginMessage(WireMessage::kComplete, output);
+  Put(static_cast<uint64_t>(result.RowCount()), output);
+  EndMessage(start, output);
+}
+
+WireSession::WireSession(Database& database) : connection_(database) {}
+
+bool WireSession::Process(std::vector<uint8_t>& input,
+                          std::vector<uint8_t>& output) {
+  size_t position = 0;
+  bool keep_open  = true;
+  while (keep_open && input.size() - position >= 5) {
+    const uint8_t* header = input.data() + position;
+    auto type             = static_cast<WireMessage>(header[0]);
+    header++;
+    auto size = Get<uint32_t>(header, input.data() + input.size());
+    if (size > kWireMaxMessageSize) {
+      throw NetworkProcessException("Message of %u bytes is too large", size);
+    }
+    if (input.size() - position - 5 < size) {
+      break;
+    }
+    auto payload = input.data() + position + 5;
+    position += 5 + size;
+    switch (type) {
+      case WireMessage::kQuery: {
+        if (size == 0) {
+          WriteError("Query message without flags", output);
+          break;
+        }
+        std::string query(reinterpret_cast<const char*>(payload) + 1,
+                          size - 1);
+        auto result = connection_.Query(query.c_str());
+        WriteResult(result, payload[0] & kWireCompressLZ4, output);
+        break;
+      }
+      case WireMessage::kTerminate:
+        keep_open = false;
+        break;
+      default:
+        WriteError("Unknown message type " + std::to_string(static_cast<int>(type)),
+                   output);
+        break;
+    }
+  }
+  input.erase(input.begin(),
+              input.begin() + static_cast<std::ptrdiff_t>(position));
+  return keep_open;
+}
+
+}  // namespace zoomdb
@@ -7,6 +7,8 @@
 
 #include "zoomdb.h"
 
+#include "common/exception.hpp"
+#include "main/appender.hpp"
 #include "zoomdb.hpp"
 
 using namespace zoomdb;
@@ -17,6 +19,15 @@ zoomdb_state zoomdb_open(const char* path, zoomdb_database *database) {
   return kZoomDBSuccess;
 }
 
+zoomdb_state zoomdb_open_ext(const char* path, zoomdb_access_mode access_mode,
+                             zoomdb_database *database) {
+  auto mode = access_mode == kZoomDBReadOnly ? AccessMode::kReadOnly
+                                             : AccessMode::kReadWrite;
+  auto* db = new Database(path, mode);
+  *database = db;
+  return kZoomDBSuccess;
+}
+
 zoomdb_state zoomdb_close(zoomdb_database database) {
   if (database) {
     auto* db = static_cast<Database*>(database);
@@ -44,7 +55,120 @@ zoomdb_state zoomdb_query(zoomdb_connection connection, const char* query,
                           zoomdb_result* result) {
   auto* conn = static_cast<Connection*>(connection);
   auto res = conn->Query(query);
-  (void)res;
   *result = nullptr;
+  return res.success ? kZoomDBSuccess : kZoomDBError;
+}
+
+zoomdb_state zoomdb_query_multi(zoomdb_connection connection,
+                                const char* query, zoomdb_result* result,
+                                uint64_t* executed) {
+  auto* conn = static_cast<Connection*>(connection);
+  size_t count;
+  auto res = conn->Query(query, &count);
+  *result  = nullptr;
+  if (executed) {
+    *executed = count;
+  }
+  return res.success ? kZoomDBSuccess : kZoomDBError;
+}
+
+namespace {
+
+/**
+ * Run the appender operation, turning exceptions into an error state.
+ */
+template <class F>
+zoomdb_state AppenderCall(zoomdb_appender appender, F&& function) {
+  if (!appender) {
+    return kZoomDBError;
+  }
+  try {
+    function(*static_cast<Appender*>(appender));
+  } catch (Exception&) {
+    return kZoomDBError;
+  }
   return kZoomDBSuccess;
 }
+
+}  // namespace
+
+zoomdb_state zoomdb_query_arrow(zoomdb_connection connection,
+                                const char* query, struct ArrowSchema* schema,
+                                struct ArrowArray* array) {
+  schema->release = nullptr;
+  array->release  = nullptr;
+  auto* conn      = static_cast<Connection*>(connection);
+  auto res        = conn->Query(query);
+  if (!res.success) {
+    return kZoomDBError;
+  }
+  try {
+    res.ToArrow(schema, array);
+  } catch (Exception&) {
+    return kZoomDBError;
+  }
+  return kZoomDBSuccess;
+}
+
+zoomdb_state zoomdb_appender_create(zoomdb_connection connection,
+                                    const char* schema, const char* table,
+                                    zoomdb_appender* appender) {
+  *appender = nullptr;
+  if (!connection || !table) {
+    return kZoomDBError;
+  }
+  auto* conn = static_cast<Connection*>(connection);
+  try {
+    *appender = schema ? new Appender(*conn, schema, table)
+                       : new Appender(*conn, table);
+  } catch (Exception&) {
+    return kZoomDBError;
+  }
+  return kZoomDBSuccess;
+}
+
+zoomdb_state zoomdb_appender_destroy(zoomdb_appender appender) {
+  auto state = AppenderCall(appender, [](Appender& app) { app.Flush(); });
+  delete static_cast<Appender*>(appender);
+  return state;
+}
+
+zoomdb_state zoomdb_appender_flush(zoomdb_appender appender) {
+  return AppenderCall(appender, [](Appender& app) { app.Flush(); });
+}
+
+zoomdb_state zoomdb_appender_end_row(zoomdb_appender appender) {
+  return AppenderCall(appender, [](Appender& app) { app.EndRow(); });
+}
+
+zoomdb_state zoomdb_append_int32(zoomdb_appender appender, int32_t value) {
+  return AppenderCall(appender, [&](Appender& app) { app.Append(value); });
+}
+
+zoomdb_state zoomdb_append_int64(zoomdb_appender appender, int64_t value) {
+  return AppenderCall(appender, [&](Appender& app) { app.Append(value); });
+}
+
+zoomdb_state zoomdb_append_double(zoomdb_appender appender, double value) {
+  return AppenderCall(appender, [&](Appender& app) { app.Append(value); });
+}
+
+zoomdb_state zoomdb_append_varchar(zoomdb_appender appender,
+                                   const char* value) {
+  return AppenderCall(appender, [&](Appender& app) { app.Append(value); });
+}
+
+zoomdb_state zoomdb_append_null(zoomdb_appender appender) {
+  return AppenderCall(appender, [](Appender& app) { app.AppendNull(); });
+}
+
+zoomdb_state zoomdb_append_arrow(zoomdb_appender appender,
+                                 const struct ArrowSchema* schema,
+                                 const struct ArrowArray* array) {
+  if (!schema || !array) {
+    return kZoomDBError;
+  }
+  return AppenderCall(appender, [&](Appender& app) {
+    app.AppendArrow(*schema, *array);
+  });
+}
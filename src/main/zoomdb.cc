@@ -7,24 +7,281 @@
 
 #include "zoomdb.hpp"
 
+#include "catalog/catalog.hpp"
+#include "common/arrow.hpp"
+#include "common/exception.hpp"
+#include "execution/executor.hpp"
+#include "execution/physical_plan_generator.hpp"
+#include "main/query_profiler.hpp"
 #include "parser/parser.hpp"
+#include "parser/statement/analyze_statement.hpp"
+#include "parser/statement/copy_statement.hpp"
+#include "parser/statement/create_statement.hpp"
+#include "parser/statement/drop_statement.hpp"
+#include "parser/statement/explain_statement.hpp"
+#include "planner/planner.hpp"
+#include "storage/data_table.hpp"
+#include "storage/parquet/parquet_file_cache.hpp"
 
 namespace zoomdb {
 
-Database::Database(const char* path) {
+namespace {
+
+const std::string& SchemaOrDefault(const std::string& schema) {
+  static const std::string kDefault = Catalog::kDefaultSchema;
+  return schema.empty() ? kDefault : schema;
+}
+
+/**
+ * Returns a result with a single VARCHAR column holding the given rows.
+ */
+Result TextResult(const std::string& name,
+                  const std::vector<std::string>& rows) {
+  Result result;
+  result.names = {name};
+  result.types = {TypeId::kVarChar};
+  DataChunk chunk;
+  chunk.Initialize(result.types);
+  chunk.GetVector(0).SetCount(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    chunk.SetValue(0, i, Value::VarChar(rows[i]));
+  }
+  result.collection.Append(chunk);
+  return result;
+}
+
+/**
+ * Returns true if executing the statement changes the database.
+ */
+bool ModifiesDatabase(const SQLStatement& statement) {
+  switch (statement.type) {
+    case StatementType::kCreate:
+    case StatementType::kDrop:
+    case StatementType::kInsert:
+    case StatementType::kUpdate:
+    case StatementType::kDelete:
+      return true;
+    case StatementType::kCopy:
+      return static_cast<const CopyStatement&>(statement).info.is_from;
+    case StatementType::kExplain: {
+      auto& explain = static_cast<const ExplainStatement&>(statement);
+      return explain.analyze && ModifiesDatabase(*explain.statement);
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+Database::Database(const char* path, AccessMode access_mode)
+    : catalog_(new Catalog()), access_mode_(access_mode) {
   (void)path;
+  if (access_mode_ == AccessMode::kReadOnly) {
+    parquet_cache_ = std::make_unique<ParquetFileCache>();
+  }
 }
 
+Database::~Database() = default;
+
 Connection::Connection(Database& database)
-  : db_(database) {
-  (void)db_;
+  : db_(database) {}
+
+Result Connection::Query(const char* query, size_t* executed) {
+  if (executed) {
+    *executed = 0;
+  }
+  Result last;
+  auto result = Query(query, [&](Result& statement_result) {
+    last = std::move(statement_result);
+    if (executed) {
+      (*executed)++;
+    }
+  });
+  return result.success ? std::move(last) : std::move(result);
+}
+
+Result Connection::Query(
+    const char* query, const std::function<void(Result& result)>& callback) {
+  try {
+    Parser parser;
+    parser.ParseQuery(query);
+    if (db_.GetAccessMode() == AccessMode::kReadOnly) {
+      // reject the whole query before any of it is executed
+      for (auto& statement : parser.statements) {
+        if (ModifiesDatabase(*statement)) {
+          throw ConnectionException(
+              "Cannot execute a statement that modifies a read only "
+              "database");
+        }
+      }
+    }
+    for (auto& statement : parser.statements) {
+      auto result           = ExecuteStatement(*statement);
+      result.statement_type = statement->type;
+      callback(result);
+    }
+    return Result();
+  } catch (Exception& e) {
+    return Result(e.GetMessage());
+  }
+}
+
+Result Connection::Describe(const char* query) {
+  try {
+    Parser parser;
+    parser.ParseQuery(query);
+    if (parser.statements.empty()) {
+      return Result();
+    }
+    if (parser.statements.size() > 1) {
+      throw NotImplementationException(
+          "Only one statement per query is supported");
+    }
+    auto& statement = *parser.statements[0];
+    Result result;
+    result.statement_type = statement.type;
+    if (statement.type == StatementType::kSelect) {
+      auto& catalog = db_.GetCatalog();
+      CatalogSnapshot snapshot(catalog);
+      Planner planner(catalog, snapshot.GetTimestamp(),
+                      db_.GetParquetCache());
+      planner.CreatePlan(statement);
+      auto plan = PhysicalPlanGenerator().CreatePlan(std::move(planner.plan));
+      result.names = std::move(planner.names);
+      result.types = plan->types;
+    } else if (statement.type == StatementType::kExplain) {
+      result.names = {"explain"};
+      result.types = {TypeId::kVarChar};
+    }
+    return result;
+  } catch (Exception& e) {
+    return Result(e.GetMessage());
+  }
 }
 
-Result Connection::Query(const char* query) {
-  Parser parser;
-  parser.ParseQuery(query);
+Result Connection::ExecuteStatement(SQLStatement& statement) {
+  auto& catalog = db_.GetCatalog();
+  // the whole statement sees the catalog as of its start
+  CatalogSnapshot snapshot(catalog);
+  auto timestamp = snapshot.GetTimestamp();
+  switch (statement.type) {
+    case StatementType::kCreate: {
+      auto& create = static_cast<CreateStatement&>(statement);
+      switch (create.object) {
+        case CatalogType::kSchema:
+          catalog.CreateSchema(create.name, create.if_not_exists);
+          break;
+        case CatalogType::kTable:
+          catalog.CreateTable(SchemaOrDefault(create.schema), create.name,
+                              create.columns, create.if_not_exists);
+          break;
+        case CatalogType::kIndex:
+          catalog.CreateIndex(SchemaOrDefault(create.schema), create.name,
+                              create.table, create.index_columns,
+                              create.unique, create.if_not_exists);
+          break;
+        default:
+          throw NotImplementationException("Unsupported CREATE statement");
+      }
+      return Result();
+    }
+    case StatementType::kDrop: {
+      auto& drop = static_cast<DropStatement&>(statement);
+      switch (drop.object) {
+        case CatalogType::kSchema:
+          catalog.DropSchema(drop.name, drop.if_exists);
+          break;
+        case CatalogType::kTable:
+          catalog.DropTable(SchemaOrDefault(drop.schema), drop.name,
+                            drop.if_exists);
+          break;
+        case CatalogType::kIndex:
+          catalog.DropIndex(SchemaOrDefault(drop.schema), drop.name,
+                            drop.if_exists);
+          break;
+        default:
+          throw NotImplementationException("Unsupported DROP statement");
+      }
+      return Result();
+    }
+    case StatementType::kAnalyze: {
+      auto& analyze = static_cast<AnalyzeStatement&>(statement);
+      std::vector<DataTable*> tables;
+      if (analyze.tables.empty()) {
+        catalog.ScanTables(timestamp, [&](TableCatalogEntry& table) {
+          tables.push_back(table.storage.get());
+        });
+      }
+      for (auto& table : analyze.tables) {
+        tables.push_back(
+            catalog.GetTable(SchemaOrDefault(table.schema), table.name,
+                             timestamp)
+                ->storage.get());
+      }
+      for (auto table : tables) {
+        table->Analyze();
+      }
+      return Result();
+    }
+    case StatementType::kExplain: {
+      auto& explain = static_cast<ExplainStatement&>(statement);
+      Planner planner(catalog, timestamp, db_.GetParquetCache());
+      planner.CreatePlan(*explain.statement);
+      auto logical_plan = planner.plan->ToString();
+      auto plan = PhysicalPlanGenerator().CreatePlan(std::move(planner.plan));
+      if (!explain.analyze) {
+        return TextResult("explain", {logical_plan, plan->ToString()});
+      }
+      QueryProfiler profiler;
+      ChunkCollection collection;
+      Executor::Execute(*plan, collection, &profiler);
+      return TextResult("explain", {profiler.ToString()});
+    }
+    case StatementType::kSelect:
+    case StatementType::kInsert:
+    case StatementType::kUpdate:
+    case StatementType::kDelete:
+    case StatementType::kCopy: {
+      Planner planner(catalog, timestamp, db_.GetParquetCache());
+      planner.CreatePlan(statement);
+      auto plan = PhysicalPlanGenerator().CreatePlan(std::move(planner.plan));
+      Result result;
+      result.names = std::move(planner.names);
+      result.types = plan->types;
+      Executor::Execute(*plan, result.collection);
+      return result;
+    }
+    default:
+      throw NotImplementationException("Unsupported statement");
+  }
+}
+
+Result::Result() : success(true) {}
+
+Result::Result(std::string error_message)
+    : success(false), error(std::move(error_message)) {}
+
+void Result::ToArrow(ArrowSchema* schema, ArrowArray* array) const {
+  ChunkCollectionToArrow(collection, names, schema, array);
+}
 
-  return Result{};
+std::string Result::ToString() const {
+  if (!success) {
+    return error;
+  }
+  std::string result;
+  for (size_t i = 0; i < names.size(); i++) {
+    result += (i == 0 ? "" : "\t") + names[i];
+  }
+  result += "\n";
+  for (size_t row = 0; row < RowCount(); row++) {
+    for (size_t column = 0; column < names.size(); column++) {
+      result += (column == 0 ? "" : "\t") + GetValue(column, row).ToString();
+    }
+    result += "\n";
+  }
+  return result;
 }
 
 }  // namespace zoomdb
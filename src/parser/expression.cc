@@ -0,0 +1,121 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression.hpp"
+
+namespace zoomdb {
+
+Expression::Expression(ExpressionType expression_type, TypeId result_type)
+    : type(expression_type), return_type(result_type), kernel(nullptr) {}
+
+Expression::Expression(ExpressionType expression_type, TypeId result_type,
+                       std::unique_ptr<Expression> left,
+                       std::unique_ptr<Expression> right)
+    : Expression(expression_type, result_type) {
+  if (left) {
+    children.push_back(std::move(left));
+  }
+  if (right) {
+    children.push_back(std::move(right));
+  }
+}
+
+void Expression::EnumerateChildren(
+    const std::function<void(Expression& child)>& callback) {
+  for (auto& child : children) {
+    callback(*child);
+  }
+}
+
+void Expression::EnumerateChildren(
+    const std::function<void(const Expression& child)>& callback) const {
+  for (auto& child : children) {
+    callback(*child);
+  }
+}
+
+bool Expression::IsAggregate() const {
+  bool is_aggregate = false;
+  EnumerateChildren([&](const Expression& child) {
+    is_aggregate |= child.IsAggregate();
+  });
+  return is_aggregate;
+}
+
+bool Expression::HasSubquery() const {
+  bool has_subquery = false;
+  EnumerateChildren([&](const Expression& child) {
+    has_subquery |= child.HasSubquery();
+  });
+  return has_subquery;
+}
+
+bool Expression::HasWindow() const {
+  bool has_window = false;
+  EnumerateChildren([&](const Expression& child) {
+    has_window |= child.HasWindow();
+  });
+  return has_window;
+}
+
+bool Expression::IsScalar() const {
+  bool is_scalar = true;
+  EnumerateChildren([&](const Expression& child) {
+    is_scalar &= child.IsScalar();
+  });
+  return is_scalar;
+}
+
+bool Expression::Equals(const Expression* other) const {
+  if (!other || type != other->type || return_type != other->return_type ||
+      children.size() != other->children.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < children.size(); i++) {
+    if (!children[i]->Equals(other->children[i].get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Expression::Equals(const Expression* left, const Expression* right) {
+  if (left == right) {
+    return true;
+  }
+  if (!left || !right) {
+    return false;
+  }
+  return left->Equals(right);
+}
+
+std::string Expression::GetName() const {
+  return alias.empty() ? ToString() : alias;
+}
+
+std::string Expression::ToString() const {
+  std::string result = ExpressionTypeToString(type);
+  if (!children.empty()) {
+    result += "(";
+    for (size_t i = 0; i < children.size(); i++) {
+      result += (i == 0 ? "" : ", ") + children[i]->ToString();
+    }
+    result += ")";
+  }
+  return result;
+}
+
+void Expression::CopyProperties(Expression& other) const {
+  other.alias  = alias;
+  other.kernel = kernel;
+  other.children.clear();
+  for (auto& child : children) {
+    other.children.push_back(child->Copy());
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,114 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/aggregate_expression.hpp"
+
+#include "common/exception.hpp"
+#include "common/types/value.hpp"
+
+namespace zoomdb {
+
+AggregateExpression::AggregateExpression(ExpressionType aggregate,
+                                         std::unique_ptr<Expression> child,
+                                         bool is_distinct)
+    : Expression(aggregate, TypeId::kInvalid, std::move(child)),
+      distinct(is_distinct) {
+  auto input  = children.empty() ? TypeId::kInvalid : children[0]->return_type;
+  return_type = GetReturnType(aggregate, input);
+}
+
+bool AggregateExpression::Equals(const Expression* other) const {
+  if (!Expression::Equals(other)) {
+    return false;
+  }
+  auto aggregate = static_cast<const AggregateExpression*>(other);
+  return distinct == aggregate->distinct && quantile == aggregate->quantile;
+}
+
+std::unique_ptr<Expression> AggregateExpression::Copy() const {
+  auto copy = std::make_unique<AggregateExpression>(type, nullptr, distinct);
+  copy->return_type = return_type;
+  copy->quantile    = quantile;
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string AggregateExpression::GetName() const {
+  if (!alias.empty()) {
+    return alias;
+  }
+  switch (type) {
+    case ExpressionType::kAggregateCount:
+    case ExpressionType::kAggregateCountStar:
+      return "count";
+    case ExpressionType::kAggregateSum:
+      return "sum";
+    case ExpressionType::kAggregateMin:
+      return "min";
+    case ExpressionType::kAggregateMax:
+      return "max";
+    case ExpressionType::kAggregateAvg:
+      return "avg";
+    case ExpressionType::kAggregateApproxCountDistinct:
+      return "approx_count_distinct";
+    case ExpressionType::kAggregateApproxQuantile:
+      return "approx_quantile";
+    default:
+      return ExpressionTypeToString(type);
+  }
+}
+
+std::string AggregateExpression::ToString() const {
+  if (type == ExpressionType::kAggregateCountStar) {
+    return "COUNT(*)";
+  }
+  std::string name = ExpressionTypeToString(type).substr(sizeof("AGGREGATE"));
+  std::string arguments = children.empty() ? "" : children[0]->ToString();
+  if (type == ExpressionType::kAggregateApproxQuantile) {
+    arguments += ", " + Value::Decimal(quantile).ToString();
+  }
+  return name + "(" + (distinct ? "DISTINCT " : "") + arguments + ")";
+}
+
+TypeId AggregateExpression::GetReturnType(ExpressionType aggregate,
+                                          TypeId input) {
+  switch (aggregate) {
+    case ExpressionType::kAggregateCount:
+    case ExpressionType::kAggregateCountStar:
+    case ExpressionType::kAggregateApproxCountDistinct:
+      return TypeId::kBigInt;
+    case ExpressionType::kAggregateSum:
+      return TypeIsIntegral(input) ? TypeId::kBigInt : input;
+    case ExpressionType::kAggregateAvg:
+      return TypeId::kDecimal;
+    case ExpressionType::kAggregateMin:
+    case ExpressionType::kAggregateMax:
+    case ExpressionType::kAggregateApproxQuantile:
+      return input;
+    default:
+      throw ExpressionException("Unknown aggregate %s",
+                                ExpressionTypeToString(aggregate).c_str());
+  }
+}
+
+bool AggregateExpression::IsAggregate(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kAggregateCount:
+    case ExpressionType::kAggregateCountStar:
+    case ExpressionType::kAggregateSum:
+    case ExpressionType::kAggregateMin:
+    case ExpressionType::kAggregateMax:
+    case ExpressionType::kAggregateAvg:
+    case ExpressionType::kAggregateApproxCountDistinct:
+    case ExpressionType::kAggregateApproxQuantile:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,26 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/cast_expression.hpp"
+
+namespace zoomdb {
+
+CastExpression::CastExpression(TypeId target, std::unique_ptr<Expression> child)
+    : Expression(ExpressionType::kOperatorCast, target, std::move(child)) {}
+
+std::unique_ptr<Expression> CastExpression::Copy() const {
+  auto copy = std::make_unique<CastExpression>(return_type, nullptr);
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string CastExpression::ToString() const {
+  return "CAST(" + children[0]->ToString() + " AS " +
+         TypeIdToString(return_type) + ")";
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,65 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/column_ref_expression.hpp"
+
+namespace zoomdb {
+
+ColumnRefExpression::ColumnRefExpression(std::string column, std::string table)
+    : Expression(ExpressionType::kColumnRef, TypeId::kInvalid),
+      column_name(std::move(column)),
+      table_name(std::move(table)),
+      depth(0),
+      index(ColumnBinding::kInvalidIndex) {}
+
+ColumnRefExpression::ColumnRefExpression(TypeId column_type,
+                                         ColumnBinding column_binding,
+                                         size_t query_depth)
+    : Expression(ExpressionType::kColumnRef, column_type),
+      binding(column_binding),
+      depth(query_depth),
+      index(ColumnBinding::kInvalidIndex) {}
+
+bool ColumnRefExpression::Equals(const Expression* other) const {
+  if (!Expression::Equals(other)) {
+    return false;
+  }
+  auto& ref = static_cast<const ColumnRefExpression&>(*other);
+  if (binding.IsValid() || ref.binding.IsValid()) {
+    return binding == ref.binding && depth == ref.depth;
+  }
+  return column_name == ref.column_name && table_name == ref.table_name;
+}
+
+std::unique_ptr<Expression> ColumnRefExpression::Copy() const {
+  auto copy         = std::make_unique<ColumnRefExpression>(column_name,
+                                                            table_name);
+  copy->return_type  = return_type;
+  copy->binding      = binding;
+  copy->depth        = depth;
+  copy->index        = index;
+  copy->outer_values = outer_values;
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string ColumnRefExpression::GetName() const {
+  if (!alias.empty()) {
+    return alias;
+  }
+  return column_name.empty() ? ToString() : column_name;
+}
+
+std::string ColumnRefExpression::ToString() const {
+  if (!column_name.empty()) {
+    return table_name.empty() ? column_name : table_name + "." + column_name;
+  }
+  return "#[" + std::to_string(binding.table_index) + "." +
+         std::to_string(binding.column_index) + "]";
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,117 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/comparison_expression.hpp"
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+ComparisonExpression::ComparisonExpression(ExpressionType comparison,
+                                           std::unique_ptr<Expression> left,
+                                           std::unique_ptr<Expression> right)
+    : Expression(comparison, TypeId::kBoolean, std::move(left),
+                 std::move(right)) {}
+
+std::unique_ptr<Expression> ComparisonExpression::Copy() const {
+  auto copy = std::make_unique<ComparisonExpression>(type, nullptr, nullptr);
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string ComparisonExpression::ToString() const {
+  return "(" + children[0]->ToString() + " " + ComparisonToString(type) + " " +
+         children[1]->ToString() + ")";
+}
+
+ExpressionType ComparisonExpression::FlipComparison(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kCompareLessThan:
+      return ExpressionType::kCompareGreaterThan;
+    case ExpressionType::kCompareGreaterThan:
+      return ExpressionType::kCompareLessThan;
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      return ExpressionType::kCompareGreaterThanOrEqualTo;
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      return ExpressionType::kCompareLessThanOrEqualTo;
+    case ExpressionType::kCompareEqual:
+    case ExpressionType::kCompareNotEqual:
+    case ExpressionType::kCompareDistinctFrom:
+      return type;
+    default:
+      throw ExpressionException("Cannot flip comparison %s",
+                                ExpressionTypeToString(type).c_str());
+  }
+}
+
+ExpressionType ComparisonExpression::NegateComparison(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kCompareEqual:
+      return ExpressionType::kCompareNotEqual;
+    case ExpressionType::kCompareNotEqual:
+      return ExpressionType::kCompareEqual;
+    case ExpressionType::kCompareLessThan:
+      return ExpressionType::kCompareGreaterThanOrEqualTo;
+    case ExpressionType::kCompareGreaterThan:
+      return ExpressionType::kCompareLessThanOrEqualTo;
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      return ExpressionType::kCompareGreaterThan;
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      return ExpressionType::kCompareLessThan;
+    case ExpressionType::kCompareLike:
+      return ExpressionType::kCompareNotLike;
+    case ExpressionType::kCompareNotLike:
+      return ExpressionType::kCompareLike;
+    default:
+      throw ExpressionException("Cannot negate comparison %s",
+                                ExpressionTypeToString(type).c_str());
+  }
+}
+
+bool ComparisonExpression::IsComparison(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kCompareEqual:
+    case ExpressionType::kCompareNotEqual:
+    case ExpressionType::kCompareLessThan:
+    case ExpressionType::kCompareGreaterThan:
+    case ExpressionType::kCompareLessThanOrEqualTo:
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+    case ExpressionType::kCompareLike:
+    case ExpressionType::kCompareNotLike:
+    case ExpressionType::kCompareDistinctFrom:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::string ComparisonExpression::ComparisonToString(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kCompareEqual:
+      return "=";
+    case ExpressionType::kCompareNotEqual:
+      return "<>";
+    case ExpressionType::kCompareLessThan:
+      return "<";
+    case ExpressionType::kCompareGreaterThan:
+      return ">";
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      return "<=";
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      return ">=";
+    case ExpressionType::kCompareLike:
+      return "LIKE";
+    case ExpressionType::kCompareNotLike:
+      return "NOT LIKE";
+    case ExpressionType::kCompareDistinctFrom:
+      return "IS DISTINCT FROM";
+    default:
+      return ExpressionTypeToString(type);
+  }
+}
+
+}  // namespace zoomdb
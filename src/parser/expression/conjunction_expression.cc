@@ -0,0 +1,56 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/conjunction_expression.hpp"
+
+namespace zoomdb {
+
+ConjunctionExpression::ConjunctionExpression(ExpressionType conjunction,
+                                             std::unique_ptr<Expression> left,
+                                             std::unique_ptr<Expression> right)
+    : Expression(conjunction, TypeId::kBoolean, std::move(left),
+                 std::move(right)) {}
+
+std::unique_ptr<Expression> ConjunctionExpression::Copy() const {
+  auto copy = std::make_unique<ConjunctionExpression>(type, nullptr, nullptr);
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string ConjunctionExpression::ToString() const {
+  return "(" + children[0]->ToString() +
+         (type == ExpressionType::kConjunctionAnd ? " AND " : " OR ") +
+         children[1]->ToString() + ")";
+}
+
+void ConjunctionExpression::Split(
+    std::unique_ptr<Expression> expr,
+    std::vector<std::unique_ptr<Expression>>& result) {
+  if (expr->type == ExpressionType::kConjunctionAnd) {
+    for (auto& child : expr->children) {
+      Split(std::move(child), result);
+    }
+  } else {
+    result.push_back(std::move(expr));
+  }
+}
+
+std::unique_ptr<Expression> ConjunctionExpression::Combine(
+    std::vector<std::unique_ptr<Expression>> expressions) {
+  std::unique_ptr<Expression> result;
+  for (auto& expr : expressions) {
+    if (!result) {
+      result = std::move(expr);
+    } else {
+      result = std::make_unique<ConjunctionExpression>(
+          ExpressionType::kConjunctionAnd, std::move(result), std::move(expr));
+    }
+  }
+  return result;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,38 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/constant_expression.hpp"
+
+namespace zoomdb {
+
+ConstantExpression::ConstantExpression(Value constant)
+    : Expression(ExpressionType::kValueConstant, constant.GetType()),
+      value(std::move(constant)) {}
+
+bool ConstantExpression::Equals(const Expression* other) const {
+  if (!Expression::Equals(other)) {
+    return false;
+  }
+  auto& constant = static_cast<const ConstantExpression&>(*other);
+  return value.IsNull() == constant.value.IsNull() &&
+         (value.IsNull() || value == constant.value);
+}
+
+std::unique_ptr<Expression> ConstantExpression::Copy() const {
+  auto copy = std::make_unique<ConstantExpression>(value);
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string ConstantExpression::ToString() const {
+  if (value.GetType() == TypeId::kVarChar && !value.IsNull()) {
+    return "'" + value.ToString() + "'";
+  }
+  return value.ToString();
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,57 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/function_expression.hpp"
+
+namespace zoomdb {
+
+FunctionExpression::FunctionExpression(
+    std::string schema, std::string name,
+    std::vector<std::unique_ptr<Expression>> arguments, bool is_distinct,
+    bool is_star)
+    : Expression(ExpressionType::kFunctionRef, TypeId::kInvalid),
+      schema_name(std::move(schema)),
+      function_name(std::move(name)),
+      distinct(is_distinct),
+      star(is_star) {
+  children = std::move(arguments);
+}
+
+bool FunctionExpression::Equals(const Expression* other) const {
+  if (!Expression::Equals(other)) {
+    return false;
+  }
+  auto& function = static_cast<const FunctionExpression&>(*other);
+  return schema_name == function.schema_name &&
+         function_name == function.function_name &&
+         distinct == function.distinct && star == function.star;
+}
+
+std::unique_ptr<Expression> FunctionExpression::Copy() const {
+  auto copy = std::make_unique<FunctionExpression>(
+      schema_name, function_name,
+      std::vector<std::unique_ptr<Expression>>(), distinct, star);
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string FunctionExpression::GetName() const {
+  return alias.empty() ? function_name : alias;
+}
+
+std::string FunctionExpression::ToString() const {
+  std::string result = function_name + "(" + (distinct ? "DISTINCT " : "");
+  if (star) {
+    result += "*";
+  }
+  for (size_t i = 0; i < children.size(); i++) {
+    result += (i == 0 ? "" : ", ") + children[i]->ToString();
+  }
+  return result + ")";
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,69 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/operator_expression.hpp"
+
+namespace zoomdb {
+
+OperatorExpression::OperatorExpression(ExpressionType op, TypeId result_type,
+                                       std::unique_ptr<Expression> left,
+                                       std::unique_ptr<Expression> right)
+    : Expression(op, result_type, std::move(left), std::move(right)) {}
+
+std::unique_ptr<Expression> OperatorExpression::Copy() const {
+  auto copy = std::make_unique<OperatorExpression>(type, return_type);
+  CopyProperties(*copy);
+  return copy;
+}
+
+static const char* BinaryOperatorToString(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::kOperatorPlus:
+      return "+";
+    case ExpressionType::kOperatorMinus:
+      return "-";
+    case ExpressionType::kOperatorMultiply:
+      return "*";
+    case ExpressionType::kOperatorDivide:
+      return "/";
+    case ExpressionType::kOperatorMod:
+      return "%";
+    case ExpressionType::kOperatorConcat:
+      return "||";
+    default:
+      return nullptr;
+  }
+}
+
+std::string OperatorExpression::ToString() const {
+  auto op = BinaryOperatorToString(type);
+  if (op && children.size() == 2) {
+    return "(" + children[0]->ToString() + " " + op + " " +
+           children[1]->ToString() + ")";
+  }
+  switch (type) {
+    case ExpressionType::kOperatorNot:
+      return "(NOT " + children[0]->ToString() + ")";
+    case ExpressionType::kOperatorUnaryMinus:
+      return "(-" + children[0]->ToString() + ")";
+    case ExpressionType::kOperatorIsNull:
+      return "(" + children[0]->ToString() + " IS NULL)";
+    case ExpressionType::kOperatorIsNotNull:
+      return "(" + children[0]->ToString() + " IS NOT NULL)";
+    case ExpressionType::kCompareIn: {
+      std::string result = "(" + children[0]->ToString() + " IN (";
+      for (size_t i = 1; i < children.size(); i++) {
+        result += (i == 1 ? "" : ", ") + children[i]->ToString();
+      }
+      return result + "))";
+    }
+    default:
+      return Expression::ToString();
+  }
+}
+
+}  // namespace zoomdb
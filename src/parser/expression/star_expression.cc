@@ -0,0 +1,32 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/star_expression.hpp"
+
+namespace zoomdb {
+
+StarExpression::StarExpression(std::string relation)
+    : Expression(ExpressionType::kStar, TypeId::kInvalid),
+      relation_name(std::move(relation)) {}
+
+bool StarExpression::Equals(const Expression* other) const {
+  return Expression::Equals(other) &&
+         relation_name ==
+             static_cast<const StarExpression*>(other)->relation_name;
+}
+
+std::unique_ptr<Expression> StarExpression::Copy() const {
+  auto copy = std::make_unique<StarExpression>(relation_name);
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string StarExpression::ToString() const {
+  return relation_name.empty() ? "*" : relation_name + ".*";
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,91 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/subquery_expression.hpp"
+
+#include "common/exception.hpp"
+#include "common/string_util.hpp"
+#include "execution/physical_operator.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/statement/select_statement.hpp"
+#include "planner/logical_operator.hpp"
+
+namespace zoomdb {
+
+static ExpressionType GetSubqueryExpressionType(SubqueryType type) {
+  switch (type) {
+    case SubqueryType::kExists:
+      return ExpressionType::kOperatorExists;
+    case SubqueryType::kAny:
+      return ExpressionType::kCompareIn;
+    default:
+      return ExpressionType::kSelectSubQuery;
+  }
+}
+
+SubqueryExpression::SubqueryExpression(
+    SubqueryType kind, TypeId result_type,
+    std::unique_ptr<LogicalOperator> subquery_plan)
+    : Expression(GetSubqueryExpressionType(kind), result_type),
+      subquery_type(kind),
+      comparison(ExpressionType::kCompareEqual),
+      subquery(std::move(subquery_plan)) {}
+
+SubqueryExpression::SubqueryExpression(
+    SubqueryType kind, std::unique_ptr<SelectStatement> subquery_statement)
+    : Expression(GetSubqueryExpressionType(kind),
+                 kind == SubqueryType::kScalar ? TypeId::kInvalid
+                                               : TypeId::kBoolean),
+      subquery_type(kind),
+      comparison(ExpressionType::kCompareEqual),
+      select(std::move(subquery_statement)) {}
+
+SubqueryExpression::~SubqueryExpression() = default;
+
+bool SubqueryExpression::Equals(const Expression* other) const {
+  // two subqueries are only equal if they are the same object
+  return this == other;
+}
+
+std::unique_ptr<Expression> SubqueryExpression::Copy() const {
+  throw NotImplementationException("Copying a subquery is not supported");
+}
+
+std::string SubqueryExpression::GetName() const {
+  if (!alias.empty()) {
+    return alias;
+  }
+  return subquery_type == SubqueryType::kExists ? "exists" : "subquery";
+}
+
+std::string SubqueryExpression::ToString() const {
+  // once the physical plan is created, the logical plan is gone
+  auto text      = subquery ? subquery->ToString()
+                   : plan   ? plan->ToString()
+                            : std::string("SELECT ...");
+  auto plan_text = "\n" + StringUtil::Prefix(text, "    ") + "\n";
+  switch (subquery_type) {
+    case SubqueryType::kExists:
+      return "EXISTS(" + plan_text + ")";
+    case SubqueryType::kAny: {
+      std::string left = children.size() == 1 ? children[0]->ToString() : "(";
+      if (children.size() != 1) {
+        for (size_t i = 0; i < children.size(); i++) {
+          left += (i == 0 ? "" : ", ") + children[i]->ToString();
+        }
+        left += ")";
+      }
+      return "(" + left + " " +
+             ComparisonExpression::ComparisonToString(comparison) + " ANY(" +
+             plan_text + "))";
+    }
+    default:
+      return "SUBQUERY(" + plan_text + ")";
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,126 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/expression/window_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+std::string BoundaryToString(WindowBoundary boundary, int64_t offset) {
+  switch (boundary) {
+    case WindowBoundary::kUnboundedPreceding:
+      return "UNBOUNDED PRECEDING";
+    case WindowBoundary::kOffsetPreceding:
+      return std::to_string(offset) + " PRECEDING";
+    case WindowBoundary::kCurrentRow:
+      return "CURRENT ROW";
+    case WindowBoundary::kOffsetFollowing:
+      return std::to_string(offset) + " FOLLOWING";
+    default:
+      return "UNBOUNDED FOLLOWING";
+  }
+}
+
+}  // namespace
+
+WindowExpression::WindowExpression(std::unique_ptr<Expression> function)
+    : Expression(ExpressionType::kWindowAggregate, TypeId::kInvalid,
+                 std::move(function)),
+      partition_count(0),
+      rows(false),
+      start(WindowBoundary::kUnboundedPreceding),
+      end(WindowBoundary::kCurrentRow),
+      start_offset(0),
+      end_offset(0) {
+  return_type = GetFunction().return_type;
+}
+
+bool WindowExpression::IsAggregate() const {
+  bool is_aggregate = false;
+  GetFunction().EnumerateChildren([&](const Expression& child) {
+    is_aggregate |= child.IsAggregate();
+  });
+  for (size_t i = 1; i < children.size(); i++) {
+    is_aggregate |= children[i]->IsAggregate();
+  }
+  return is_aggregate;
+}
+
+bool WindowExpression::SameOrdering(const WindowExpression& other) const {
+  if (partition_count != other.partition_count ||
+      orders.size() != other.orders.size() ||
+      children.size() != other.children.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < orders.size(); i++) {
+    if (orders[i].descending != other.orders[i].descending ||
+        orders[i].nulls_first != other.orders[i].nulls_first) {
+      return false;
+    }
+  }
+  for (size_t i = 1; i < children.size(); i++) {
+    if (!children[i]->Equals(other.children[i].get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool WindowExpression::Equals(const Expression* other) const {
+  if (!Expression::Equals(other)) {
+    return false;
+  }
+  auto& window = static_cast<const WindowExpression&>(*other);
+  return SameOrdering(window) && rows == window.rows &&
+         start == window.start && end == window.end &&
+         start_offset == window.start_offset &&
+         end_offset == window.end_offset;
+}
+
+std::unique_ptr<Expression> WindowExpression::Copy() const {
+  auto copy = std::make_unique<WindowExpression>(GetFunction().Copy());
+  copy->return_type     = return_type;
+  copy->partition_count = partition_count;
+  copy->orders          = orders;
+  copy->rows            = rows;
+  copy->start           = start;
+  copy->end             = end;
+  copy->start_offset    = start_offset;
+  copy->end_offset      = end_offset;
+  CopyProperties(*copy);
+  return copy;
+}
+
+std::string WindowExpression::GetName() const {
+  return alias.empty() ? GetFunction().GetName() : alias;
+}
+
+std::string WindowExpression::ToString() const {
+  std::string result = GetFunction().ToString() + " OVER (";
+  if (partition_count > 0) {
+    result += "PARTITION BY ";
+    for (size_t i = 0; i < partition_count; i++) {
+      result += (i == 0 ? "" : ", ") + children[1 + i]->ToString();
+    }
+    result += " ";
+  }
+  if (!orders.empty()) {
+    result += "ORDER BY ";
+    for (size_t i = 0; i < orders.size(); i++) {
+      result += (i == 0 ? "" : ", ") +
+                children[1 + partition_count + i]->ToString() +
+                (orders[i].descending ? " DESC" : "");
+    }
+    result += " ";
+  }
+  return result + (rows ? "ROWS" : "RANGE") + " BETWEEN " +
+         BoundaryToString(start, start_offset) + " AND " +
+         BoundaryToString(end, end_offset) + ")";
+}
+
+}  // namespace zoomdb
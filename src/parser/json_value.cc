@@ -0,0 +1,279 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/json_value.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+/**
+ * A recursive descent reader of JSON text.
+ */
+class JSONValue::Reader {
+ public:
+  explicit Reader(const char* text) : start_(text), pos_(text) {}
+
+  JSONValue ReadDocument() {
+    auto result = ReadValue();
+    SkipWhitespace();
+    if (*pos_) {
+      Fail("trailing characters");
+    }
+    return result;
+  }
+
+ private:
+  [[noreturn]] void Fail(const char* message) const {
+    throw ParserException("Malformed parse tree, %s at offset %zu", message,
+                          static_cast<size_t>(pos_ - start_));
+  }
+
+  void SkipWhitespace() {
+    while (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\n' || *pos_ == '\r') {
+      pos_++;
+    }
+  }
+
+  void Expect(char c) {
+    SkipWhitespace();
+    if (*pos_ != c) {
+      Fail("unexpected character");
+    }
+    pos_++;
+  }
+
+  bool ReadLiteral(const char* literal) {
+    auto length = std::strlen(literal);
+    if (std::strncmp(pos_, literal, length) != 0) {
+      return false;
+    }
+    pos_ += length;
+    return true;
+  }
+
+  JSONValue ReadValue() {
+    SkipWhitespace();
+    JSONValue result;
+    switch (*pos_) {
+      case '{':
+        pos_++;
+        result.type_ = Type::kObject;
+        SkipWhitespace();
+        if (*pos_ == '}') {
+          pos_++;
+          break;
+        }
+        while (true) {
+          SkipWhitespace();
+          if (*pos_ != '"') {
+            Fail("expected a key");
+          }
+          result.keys_.push_back(ReadString());
+          Expect(':');
+          result.elements_.push_back(ReadValue());
+          SkipWhitespace();
+          if (*pos_ == ',') {
+            pos_++;
+            continue;
+          }
+          Expect('}');
+          break;
+        }
+        break;
+      case '[':
+        pos_++;
+        result.type_ = Type::kArray;
+        SkipWhitespace();
+        if (*pos_ == ']') {
+          pos_++;
+          break;
+        }
+        while (true) {
+          result.elements_.push_back(ReadValue());
+          SkipWhitespace();
+          if (*pos_ == ',') {
+            pos_++;
+            continue;
+          }
+          Expect(']');
+          break;
+        }
+        break;
+      case '"':
+        result.type_   = Type::kString;
+        result.string_ = ReadString();
+        break;
+      case 't':
+      case 'f':
+        result.type_    = Type::kBoolean;
+        result.boolean_ = *pos_ == 't';
+        if (!ReadLiteral(result.boolean_ ? "true" : "false")) {
+          Fail("invalid literal");
+        }
+        break;
+      case 'n':
+        if (!ReadLiteral("null")) {
+          Fail("invalid literal");
+        }
+        break;
+      default: {
+        auto begin = pos_;
+        while (*pos_ == '-' || *pos_ == '+' || *pos_ == '.' ||
+               *pos_ == 'e' || *pos_ == 'E' || (*pos_ >= '0' && *pos_ <= '9')) {
+          pos_++;
+        }
+        if (pos_ == begin) {
+          Fail("unexpected character");
+        }
+        result.type_ = Type::kNumber;
+        result.string_.assign(begin, pos_);
+        break;
+      }
+    }
+    return result;
+  }
+
+  std::string ReadString() {
+    pos_++;  // opening quote
+    std::string result;
+    while (*pos_ != '"') {
+      if (!*pos_) {
+        Fail("unterminated string");
+      }
+      if (*pos_ != '\\') {
+        result += *pos_++;
+        continue;
+      }
+      pos_++;
+      switch (*pos_++) {
+        case '"':
+          result += '"';
+          break;
+        case '\\':
+          result += '\\';
+          break;
+        case '/':
+          result += '/';
+          break;
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u':
+          AppendCodePoint(ReadCodePoint(), result);
+          break;
+        default:
+          Fail("invalid escape sequence");
+      }
+    }
+    pos_++;  // closing quote
+    return result;
+  }
+
+  uint32_t ReadHex4() {
+    uint32_t result = 0;
+    for (int i = 0; i < 4; i++, pos_++) {
+      char c = *pos_;
+      result <<= 4;
+      if (c >= '0' && c <= '9') {
+        result |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        result |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        result |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        Fail("invalid unicode escape");
+      }
+    }
+    return result;
+  }
+
+  uint32_t ReadCodePoint() {
+    auto code = ReadHex4();
+    // a surrogate pair encodes a code point outside the basic plane
+    if (code >= 0xD800 && code < 0xDC00 && pos_[0] == '\\' && pos_[1] == 'u') {
+      pos_ += 2;
+      auto low = ReadHex4();
+      code     = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return code;
+  }
+
+  static void AppendCodePoint(uint32_t code, std::string& result) {
+    if (code < 0x80) {
+      result += static_cast<char>(code);
+    } else if (code < 0x800) {
+      result += static_cast<char>(0xC0 | (code >> 6));
+      result += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+      result += static_cast<char>(0xE0 | (code >> 12));
+      result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+      result += static_cast<char>(0xF0 | (code >> 18));
+      result += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+      result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (code & 0x3F));
+    }
+  }
+
+  const char* start_;
+  const char* pos_;
+};
+
+JSONValue::JSONValue() : type_(Type::kNull), boolean_(false) {}
+
+JSONValue JSONValue::Parse(const char* text) {
+  return Reader(text).ReadDocument();
+}
+
+const JSONValue* JSONValue::Get(const std::string& key) const {
+  for (size_t i = 0; i < keys_.size(); i++) {
+    if (keys_[i] == key) {
+      return &elements_[i];
+    }
+  }
+  return nullptr;
+}
+
+bool JSONValue::GetBoolean() const {
+  if (type_ != Type::kBoolean) {
+    throw ParserException("Malformed parse tree, expected a boolean");
+  }
+  return boolean_;
+}
+
+int64_t JSONValue::GetInteger() const {
+  if (type_ != Type::kNumber) {
+    throw ParserException("Malformed parse tree, expected a number");
+  }
+  return std::strtoll(string_.c_str(), nullptr, 10);
+}
+
+const std::string& JSONValue::GetString() const {
+  if (type_ != Type::kString && type_ != Type::kNumber) {
+    throw ParserException("Malformed parse tree, expected a string");
+  }
+  return string_;
+}
+
+}  // namespace zoomdb
@@ -7,8 +7,11 @@
 
 #include "parser/parser.hpp"
 
-#include <stdio.h>
+#include <string>
 
+#include "common/exception.hpp"
+#include "parser/json_value.hpp"
+#include "parser/transformer.hpp"
 #include "pg_query.h"
 
 namespace zoomdb {
@@ -18,10 +21,17 @@ Parser::Parser() {}
 void Parser::ParseQuery(const char* query) {
   auto result = pg_query_parse(query);
   if (result.error) {
-    fprintf(stderr, "%s at %d\n", result.error->message,
-            result.error->cursorpos);
-  } else {
-    fprintf(stderr, "Successfully parsed query.\n");
+    std::string message = result.error->message;
+    auto position       = result.error->cursorpos;
+    pg_query_free_parse_result(result);
+    throw ParserException("%s at %d", message.c_str(), position);
+  }
+  try {
+    auto tree = JSONValue::Parse(result.parse_tree);
+    Transformer().TransformParseTree(tree, statements);
+  } catch (...) {
+    pg_query_free_parse_result(result);
+    throw;
   }
   pg_query_free_parse_result(result);
 }
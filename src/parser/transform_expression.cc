@@ -0,0 +1,546 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include <cstdlib>
+
+#include "common/exception.hpp"
+#include "common/types/value.hpp"
+#include "parser/expression/cast_expression.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/conjunction_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/function_expression.hpp"
+#include "parser/expression/operator_expression.hpp"
+#include "parser/expression/star_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+#include "parser/expression/window_expression.hpp"
+#include "parser/transformer.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * Returns the expression type of a binary operator, kInvalid if the
+ * operator is not supported.
+ */
+ExpressionType OperatorToExpressionType(const std::string& op) {
+  static const struct {
+    const char* name;
+    ExpressionType type;
+  } kOperators[] = {
+      {"+", ExpressionType::kOperatorPlus},
+      {"-", ExpressionType::kOperatorMinus},
+      {"*", ExpressionType::kOperatorMultiply},
+      {"/", ExpressionType::kOperatorDivide},
+      {"%", ExpressionType::kOperatorMod},
+      {"||", ExpressionType::kOperatorConcat},
+      {"=", ExpressionType::kCompareEqual},
+      {"<>", ExpressionType::kCompareNotEqual},
+      {"<", ExpressionType::kCompareLessThan},
+      {">", ExpressionType::kCompareGreaterThan},
+      {"<=", ExpressionType::kCompareLessThanOrEqualTo},
+      {">=", ExpressionType::kCompareGreaterThanOrEqualTo},
+      {"~~", ExpressionType::kCompareLike},
+      {"!~~", ExpressionType::kCompareNotLike},
+  };
+  for (auto& entry : kOperators) {
+    if (op == entry.name) {
+      return entry.type;
+    }
+  }
+  return ExpressionType::kInvalid;
+}
+
+std::unique_ptr<Expression> MakeBinary(ExpressionType type,
+                                       std::unique_ptr<Expression> left,
+                                       std::unique_ptr<Expression> right) {
+  if (ComparisonExpression::IsComparison(type)) {
+    return std::make_unique<ComparisonExpression>(type, std::move(left),
+                                                  std::move(right));
+  }
+  return std::make_unique<OperatorExpression>(type, TypeId::kInvalid,
+                                              std::move(left),
+                                              std::move(right));
+}
+
+std::unique_ptr<Expression> MakeNot(std::unique_ptr<Expression> child) {
+  return std::make_unique<OperatorExpression>(
+      ExpressionType::kOperatorNot, TypeId::kBoolean, std::move(child));
+}
+
+/**
+ * CASE WHEN check THEN result ELSE otherwise END
+ */
+std::unique_ptr<Expression> MakeCase(std::unique_ptr<Expression> check,
+                                     std::unique_ptr<Expression> result,
+                                     std::unique_ptr<Expression> otherwise) {
+  auto expr = std::make_unique<OperatorExpression>(
+      ExpressionType::kOperatorCaseExpr, TypeId::kInvalid, std::move(check),
+      std::move(result));
+  expr->children.push_back(std::move(otherwise));
+  return expr;
+}
+
+std::unique_ptr<Expression> MakeNull() {
+  // the binder gives the NULL the type its context requires
+  return std::make_unique<ConstantExpression>(Value(TypeId::kInvalid));
+}
+
+/**
+ * The bits of the frameOptions of a WindowDef, see FRAMEOPTION_* in the
+ * nodes/parsenodes.h of Postgres.
+ */
+enum FrameOption : int64_t {
+  kFrameNonDefault              = 0x1,
+  kFrameRange                   = 0x2,
+  kFrameRows                    = 0x4,
+  kFrameGroups                  = 0x8,
+  kFrameStartUnboundedPreceding = 0x20,
+  kFrameEndUnboundedPreceding   = 0x40,
+  kFrameStartUnboundedFollowing = 0x80,
+  kFrameEndUnboundedFollowing   = 0x100,
+  kFrameStartCurrentRow         = 0x200,
+  kFrameEndCurrentRow           = 0x400,
+  kFrameStartOffsetPreceding    = 0x800,
+  kFrameEndOffsetPreceding      = 0x1000,
+  kFrameStartOffsetFollowing    = 0x2000,
+  kFrameEndOffsetFollowing      = 0x4000,
+  kFrameExclusion               = 0x8000 | 0x10000 | 0x20000,
+};
+
+WindowBoundary FrameStart(int64_t options) {
+  if (options & kFrameStartOffsetPreceding) {
+    return WindowBoundary::kOffsetPreceding;
+  } else if (options & kFrameStartCurrentRow) {
+    return WindowBoundary::kCurrentRow;
+  } else if (options & kFrameStartOffsetFollowing) {
+    return WindowBoundary::kOffsetFollowing;
+  } else if (options & kFrameStartUnboundedFollowing) {
+    return WindowBoundary::kUnboundedFollowing;
+  }
+  return WindowBoundary::kUnboundedPreceding;
+}
+
+WindowBoundary FrameEnd(int64_t options) {
+  if (options & kFrameEndUnboundedPreceding) {
+    return WindowBoundary::kUnboundedPreceding;
+  } else if (options & kFrameEndOffsetPreceding) {
+    return WindowBoundary::kOffsetPreceding;
+  } else if (options & kFrameEndOffsetFollowing) {
+    return WindowBoundary::kOffsetFollowing;
+  } else if (options & kFrameEndUnboundedFollowing) {
+    return WindowBoundary::kUnboundedFollowing;
+  }
+  return WindowBoundary::kCurrentRow;
+}
+
+}  // namespace
+
+std::unique_ptr<Expression> Transformer::TransformExpression(
+    const JSONValue& node) {
+  auto& type   = NodeType(node);
+  auto& fields = NodeFields(node);
+  if (type == "ColumnRef") {
+    return TransformColumnRef(fields);
+  }
+  if (type == "A_Const") {
+    return TransformConstant(fields);
+  }
+  if (type == "A_Expr") {
+    return TransformAExpr(fields);
+  }
+  if (type == "BoolExpr") {
+    return TransformBoolExpr(fields);
+  }
+  if (type == "FuncCall") {
+    return TransformFuncCall(fields);
+  }
+  if (type == "SubLink") {
+    return TransformSubLink(fields);
+  }
+  if (type == "CaseExpr") {
+    return TransformCase(fields);
+  }
+  if (type == "NullTest") {
+    auto is_null = GetString(fields, "nulltesttype") == "IS_NULL";
+    return std::make_unique<OperatorExpression>(
+        is_null ? ExpressionType::kOperatorIsNull
+                : ExpressionType::kOperatorIsNotNull,
+        TypeId::kBoolean, TransformExpression(*fields.Get("arg")));
+  }
+  if (type == "TypeCast") {
+    return std::make_unique<CastExpression>(
+        TransformTypeName(*fields.Get("typeName")),
+        TransformExpression(*fields.Get("arg")));
+  }
+  if (type == "CoalesceExpr") {
+    auto expr = std::make_unique<OperatorExpression>(
+        ExpressionType::kOperatorCoalesce, TypeId::kInvalid);
+    TransformExpressionList(*fields.Get("args"), expr->children);
+    return expr;
+  }
+  throw NotImplementationException("Expression %s is not supported",
+                                   type.c_str());
+}
+
+void Transformer::TransformExpressionList(
+    const JSONValue& list, std::vector<std::unique_ptr<Expression>>& result) {
+  for (auto& node : list.GetElements()) {
+    result.push_back(TransformExpression(node));
+  }
+}
+
+std::unique_ptr<Expression> Transformer::TransformColumnRef(
+    const JSONValue& node) {
+  auto& fields = GetList(node, "fields");
+  if (fields.empty() || fields.size() > 2) {
+    throw NotImplementationException(
+        "Column references must have the form [table.]column");
+  }
+  std::string table = fields.size() == 2 ? StringNode(fields[0]) : "";
+  if (NodeType(fields.back()) == "A_Star") {
+    return std::make_unique<StarExpression>(table);
+  }
+  return std::make_unique<ColumnRefExpression>(StringNode(fields.back()),
+                                               table);
+}
+
+std::unique_ptr<Expression> Transformer::TransformConstant(
+    const JSONValue& node) {
+  if (GetBoolean(node, "isnull")) {
+    return MakeNull();
+  }
+  if (auto ival = node.Get("ival")) {
+    return std::make_unique<ConstantExpression>(
+        Value::Integer(static_cast<int32_t>(GetInteger(*ival, "ival"))));
+  }
+  if (auto fval = node.Get("fval")) {
+    // integers that do not fit into an INTEGER are FLOAT constants
+    auto text = GetString(*fval, "fval");
+    if (text.find_first_of(".eE") == std::string::npos) {
+      errno      = 0;
+      auto value = std::strtoll(text.c_str(), nullptr, 10);
+      if (errno == 0) {
+        return std::make_unique<ConstantExpression>(Value::BigInt(value));
+      }
+    }
+    return std::make_unique<ConstantExpression>(
+        Value::Decimal(std::strtod(text.c_str(), nullptr)));
+  }
+  if (auto sval = node.Get("sval")) {
+    return std::make_unique<ConstantExpression>(
+        Value::VarChar(GetString(*sval, "sval")));
+  }
+  if (auto boolval = node.Get("boolval")) {
+    return std::make_unique<ConstantExpression>(
+        Value::Boolean(GetBoolean(*boolval, "boolval")));
+  }
+  throw NotImplementationException("Constant type is not supported");
+}
+
+std::unique_ptr<Expression> Transformer::TransformAExpr(const JSONValue& node) {
+  auto kind  = GetString(node, "kind");
+  auto& name = GetList(node, "name");
+  auto op    = name.empty() ? std::string() : StringNode(name.back());
+  auto lexpr = node.Get("lexpr");
+  auto rexpr = node.Get("rexpr");
+  if (!rexpr) {
+    throw ParserException("Malformed parse tree, operator without operand");
+  }
+
+  if (kind == "AEXPR_OP" || kind == "AEXPR_LIKE") {
+    if (!lexpr) {
+      // prefix operator
+      auto child = TransformExpression(*rexpr);
+      if (op == "+") {
+        return child;
+      }
+      if (op == "-") {
+        return std::make_unique<OperatorExpression>(
+            ExpressionType::kOperatorUnaryMinus, TypeId::kInvalid,
+            std::move(child));
+      }
+      throw NotImplementationException("Operator %s is not supported",
+                                       op.c_str());
+    }
+    auto type = OperatorToExpressionType(op);
+    if (type == ExpressionType::kInvalid) {
+      throw NotImplementationException("Operator %s is not supported",
+                                       op.c_str());
+    }
+    return MakeBinary(type, TransformExpression(*lexpr),
+                      TransformExpression(*rexpr));
+  }
+  if (kind == "AEXPR_IN") {
+    // x IN (a, b, ...), x NOT IN (...) uses the operator <>
+    auto expr = std::make_unique<OperatorExpression>(
+        ExpressionType::kCompareIn, TypeId::kBoolean,
+        TransformExpression(*lexpr));
+    TransformExpressionList(*NodeFields(*rexpr).Get("items"), expr->children);
+    if (op == "<>") {
+      return MakeNot(std::move(expr));
+    }
+    return expr;
+  }
+  if (kind == "AEXPR_BETWEEN" || kind == "AEXPR_NOT_BETWEEN") {
+    auto& bounds = GetList(NodeFields(*rexpr), "items");
+    if (bounds.size() != 2) {
+      throw ParserException("Malformed parse tree, BETWEEN needs two bounds");
+    }
+    auto value = TransformExpression(*lexpr);
+    auto lower = TransformExpression(bounds[0]);
+    auto upper = TransformExpression(bounds[1]);
+    if (kind == "AEXPR_BETWEEN") {
+      // x BETWEEN a AND b: x >= a AND x <= b
+      return std::make_unique<ConjunctionExpression>(
+          ExpressionType::kConjunctionAnd,
+          MakeBinary(ExpressionType::kCompareGreaterThanOrEqualTo,
+                     value->Copy(), std::move(lower)),
+          MakeBinary(ExpressionType::kCompareLessThanOrEqualTo,
+                     std::move(value), std::move(upper)));
+    }
+    // x NOT BETWEEN a AND b: x < a OR x > b
+    return std::make_unique<ConjunctionExpression>(
+        ExpressionType::kConjunctionOr,
+        MakeBinary(ExpressionType::kCompareLessThan, value->Copy(),
+                   std::move(lower)),
+        MakeBinary(ExpressionType::kCompareGreaterThan, std::move(value),
+                   std::move(upper)));
+  }
+  if (kind == "AEXPR_DISTINCT" || kind == "AEXPR_NOT_DISTINCT") {
+    auto expr = MakeBinary(ExpressionType::kCompareDistinctFrom,
+                           TransformExpression(*lexpr),
+                           TransformExpression(*rexpr));
+    return kind == "AEXPR_DISTINCT" ? std::move(expr)
+                                    : MakeNot(std::move(expr));
+  }
+  if (kind == "AEXPR_NULLIF") {
+    // NULLIF(a, b): CASE WHEN a = b THEN NULL ELSE a END
+    auto left = TransformExpression(*lexpr);
+    auto check =
+        MakeBinary(ExpressionType::kCompareEqual, left->Copy(),
+                   TransformExpression(*rexpr));
+    return MakeCase(std::move(check), MakeNull(), std::move(left));
+  }
+  throw NotImplementationException("%s is not supported", kind.c_str());
+}
+
+std::unique_ptr<Expression> Transformer::TransformBoolExpr(
+    const JSONValue& node) {
+  auto boolop = GetString(node, "boolop");
+  std::vector<std::unique_ptr<Expression>> args;
+  TransformExpressionList(*node.Get("args"), args);
+  if (boolop == "NOT_EXPR") {
+    return MakeNot(std::move(args.at(0)));
+  }
+  auto type = boolop == "AND_EXPR" ? ExpressionType::kConjunctionAnd
+                                   : ExpressionType::kConjunctionOr;
+  auto result = std::move(args.at(0));
+  for (size_t i = 1; i < args.size(); i++) {
+    result = std::make_unique<ConjunctionExpression>(type, std::move(result),
+                                                     std::move(args[i]));
+  }
+  return result;
+}
+
+std::unique_ptr<Expression> Transformer::TransformFuncCall(
+    const JSONValue& node) {
+  if (node.Get("agg_order") || node.Get("agg_filter") ||
+      GetBoolean(node, "agg_within_group")) {
+    throw NotImplementationException(
+        "ORDER BY, FILTER and WITHIN GROUP in aggregates are not supported");
+  }
+  auto& name = GetList(node, "funcname");
+  if (name.empty() || name.size() > 2) {
+    throw ParserException("Malformed parse tree, invalid function name");
+  }
+  std::string schema = name.size() == 2 ? StringNode(name[0]) : "";
+  std::vector<std::unique_ptr<Expression>> args;
+  for (auto& arg : GetList(node, "args")) {
+    args.push_back(TransformExpression(arg));
+  }
+  auto function = std::make_unique<FunctionExpression>(
+      schema, StringNode(name.back()), std::move(args),
+      GetBoolean(node, "agg_distinct"), GetBoolean(node, "agg_star"));
+  if (auto over = node.Get("over")) {
+    return TransformWindow(*over, std::move(function));
+  }
+  return function;
+}
+
+std::unique_ptr<Expression> Transformer::TransformWindow(
+    const JSONValue& over, std::unique_ptr<Expression> function) {
+  if (!GetString(over, "name").empty() ||
+      !GetString(over, "refname").empty()) {
+    throw NotImplementationException("Named windows are not supported");
+  }
+  auto window = std::make_unique<WindowExpression>(std::move(function));
+  for (auto& partition : GetList(over, "partitionClause")) {
+    window->children.push_back(TransformExpression(partition));
+    window->partition_count++;
+  }
+  for (auto& order : GetList(over, "orderClause")) {
+    auto& sort = NodeFields(order);
+    if (!GetList(sort, "useOp").empty()) {
+      throw NotImplementationException("ORDER BY USING is not supported");
+    }
+    auto descending  = GetString(sort, "sortby_dir") == "SORTBY_DESC";
+    auto nulls       = GetString(sort, "sortby_nulls");
+    auto nulls_first = nulls == "SORTBY_NULLS_FIRST" ||
+                       (descending && nulls != "SORTBY_NULLS_LAST");
+    window->children.push_back(TransformExpression(*sort.Get("node")));
+    window->orders.push_back({descending, nulls_first});
+  }
+
+  auto options = GetInteger(over, "frameOptions");
+  if (!(options & kFrameNonDefault)) {
+    // RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW
+    return window;
+  }
+  if (options & (kFrameGroups | kFrameExclusion)) {
+    throw NotImplementationException(
+        "GROUPS frames and frame exclusion are not supported");
+  }
+  window->rows  = (options & kFrameRows) != 0;
+  window->start = FrameStart(options);
+  window->end   = FrameEnd(options);
+  auto offset_options = kFrameStartOffsetPreceding | kFrameEndOffsetPreceding |
+                        kFrameStartOffsetFollowing | kFrameEndOffsetFollowing;
+  if (!window->rows && (options & offset_options)) {
+    throw NotImplementationException(
+        "RANGE frames with an offset are not supported");
+  }
+  if (options & (kFrameStartOffsetPreceding | kFrameStartOffsetFollowing)) {
+    window->start_offset = TransformFrameOffset(over, "startOffset");
+  }
+  if (options & (kFrameEndOffsetPreceding | kFrameEndOffsetFollowing)) {
+    window->end_offset = TransformFrameOffset(over, "endOffset");
+  }
+  return window;
+}
+
+int64_t Transformer::TransformFrameOffset(const JSONValue& over,
+                                          const char* key) {
+  auto node = over.Get(key);
+  if (!node) {
+    throw ParserException("Malformed parse tree, frame offset missing");
+  }
+  auto offset = TransformExpression(*node);
+  if (offset->type == ExpressionType::kValueConstant) {
+    auto& value = static_cast<ConstantExpression&>(*offset).value;
+    if (!value.IsNull() && TypeIsIntegral(value.GetType()) &&
+        value.GetNumericValue() >= 0) {
+      return value.GetNumericValue();
+    }
+  }
+  throw NotImplementationException(
+      "Frame offsets must be non-negative integer constants");
+}
+
+std::unique_ptr<Expression> Transformer::TransformSubLink(
+    const JSONValue& node) {
+  auto type   = GetString(node, "subLinkType");
+  auto select = TransformSelect(*node.Get("subselect"));
+  if (type == "EXISTS_SUBLINK") {
+    return std::make_unique<SubqueryExpression>(SubqueryType::kExists,
+                                                std::move(select));
+  }
+  if (type == "EXPR_SUBLINK") {
+    return std::make_unique<SubqueryExpression>(SubqueryType::kScalar,
+                                                std::move(select));
+  }
+  if (type != "ANY_SUBLINK" && type != "ALL_SUBLINK") {
+    throw NotImplementationException("%s is not supported", type.c_str());
+  }
+  auto& name = GetList(node, "operName");
+  auto comparison =
+      name.empty() ? ExpressionType::kCompareEqual
+                   : OperatorToExpressionType(StringNode(name.back()));
+  if (!ComparisonExpression::IsComparison(comparison) ||
+      comparison == ExpressionType::kCompareLike ||
+      comparison == ExpressionType::kCompareNotLike) {
+    throw NotImplementationException("Operator %s with ANY or ALL is not "
+                                     "supported",
+                                     StringNode(name.back()).c_str());
+  }
+  auto expr = std::make_unique<SubqueryExpression>(SubqueryType::kAny,
+                                                   std::move(select));
+  // (a, b) IN (SELECT x, y ...) compares a row
+  auto& test = *node.Get("testexpr");
+  if (NodeType(test) == "RowExpr") {
+    TransformExpressionList(*NodeFields(test).Get("args"), expr->children);
+  } else {
+    expr->children.push_back(TransformExpression(test));
+  }
+  if (type == "ALL_SUBLINK") {
+    // x op ALL (...) is NOT (x negated-op ANY (...))
+    expr->comparison = ComparisonExpression::NegateComparison(comparison);
+    return MakeNot(std::move(expr));
+  }
+  expr->comparison = comparison;
+  return expr;
+}
+
+std::unique_ptr<Expression> Transformer::TransformCase(const JSONValue& node) {
+  // CASE x WHEN v THEN ... compares x with every v
+  auto arg = node.Get("arg") ? TransformExpression(*node.Get("arg")) : nullptr;
+  auto result = node.Get("defresult")
+                    ? TransformExpression(*node.Get("defresult"))
+                    : MakeNull();
+  // nest the WHEN clauses from the last one: CASE WHEN a THEN x ELSE
+  // (CASE WHEN b THEN y ELSE z END) END
+  auto& whens = GetList(node, "args");
+  for (size_t i = whens.size(); i > 0; i--) {
+    auto& when = NodeFields(whens[i - 1]);
+    auto check = TransformExpression(*when.Get("expr"));
+    if (arg) {
+      check = MakeBinary(ExpressionType::kCompareEqual, arg->Copy(),
+                         std::move(check));
+    }
+    result = MakeCase(std::move(check),
+                      TransformExpression(*when.Get("result")),
+                      std::move(result));
+  }
+  return result;
+}
+
+TypeId Transformer::TransformTypeName(const JSONValue& type_name) {
+  if (type_name.Get("arrayBounds")) {
+    throw NotImplementationException("Array types are not supported");
+  }
+  auto& names = GetList(type_name, "names");
+  if (names.empty()) {
+    throw ParserException("Malformed parse tree, type without name");
+  }
+  auto name = StringNode(names.back());
+  static const struct {
+    const char* name;
+    TypeId type;
+  } kTypes[] = {
+      {"bool", TypeId::kBoolean},        {"boolean", TypeId::kBoolean},
+      {"int1", TypeId::kTinyInt},        {"tinyint", TypeId::kTinyInt},
+      {"int2", TypeId::kSmallInt},       {"smallint", TypeId::kSmallInt},
+      {"int4", TypeId::kInteger},        {"int", TypeId::kInteger},
+      {"integer", TypeId::kInteger},     {"int8", TypeId::kBigInt},
+      {"bigint", TypeId::kBigInt},       {"float4", TypeId::kDecimal},
+      {"float8", TypeId::kDecimal},      {"numeric", TypeId::kDecimal},
+      {"decimal", TypeId::kDecimal},     {"varchar", TypeId::kVarChar},
+      {"text", TypeId::kVarChar},        {"bpchar", TypeId::kVarChar},
+      {"date", TypeId::kDate},           {"timestamp", TypeId::kTimestamp},
+      {"timestamptz", TypeId::kTimestamp},
+  };
+  for (auto& entry : kTypes) {
+    if (name == entry.name) {
+      return entry.type;
+    }
+  }
+  throw NotImplementationException("Type %s is not supported", name.c_str());
+}
+
+}  // namespace zoomdb
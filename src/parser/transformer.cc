@@ -0,0 +1,606 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "parser/transformer.hpp"
+
+#include "common/exception.hpp"
+#include "common/string_util.hpp"
+#include "parser/statement/analyze_statement.hpp"
+#include "parser/statement/copy_statement.hpp"
+#include "parser/statement/create_statement.hpp"
+#include "parser/statement/delete_statement.hpp"
+#include "parser/statement/drop_statement.hpp"
+#include "parser/statement/explain_statement.hpp"
+#include "parser/statement/insert_statement.hpp"
+#include "parser/statement/update_statement.hpp"
+#include "parser/tableref/base_table_ref.hpp"
+#include "parser/tableref/cross_product_ref.hpp"
+#include "parser/tableref/join_ref.hpp"
+#include "parser/tableref/subquery_ref.hpp"
+#include "parser/tableref/table_function_ref.hpp"
+
+namespace zoomdb {
+
+const std::string& Transformer::NodeType(const JSONValue& node) {
+  if (!node.IsObject() || node.GetKeys().size() != 1) {
+    throw ParserException("Malformed parse tree, expected a node");
+  }
+  return node.GetKeys()[0];
+}
+
+const JSONValue& Transformer::NodeFields(const JSONValue& node) {
+  NodeType(node);
+  return node.GetElements()[0];
+}
+
+std::string Transformer::StringNode(const JSONValue& node) {
+  if (NodeType(node) != "String") {
+    throw ParserException("Malformed parse tree, expected a String node");
+  }
+  return GetString(NodeFields(node), "sval");
+}
+
+std::string Transformer::GetString(const JSONValue& fields, const char* key) {
+  auto value = fields.Get(key);
+  return value ? value->GetString() : std::string();
+}
+
+bool Transformer::GetBoolean(const JSONValue& fields, const char* key) {
+  auto value = fields.Get(key);
+  return value && value->GetBoolean();
+}
+
+int64_t Transformer::GetInteger(const JSONValue& fields, const char* key) {
+  auto value = fields.Get(key);
+  return value ? value->GetInteger() : 0;
+}
+
+const std::vector<JSONValue>& Transformer::GetList(const JSONValue& fields,
+                                                   const char* key) {
+  static const std::vector<JSONValue> kEmpty;
+  auto value = fields.Get(key);
+  if (!value) {
+    return kEmpty;
+  }
+  if (!value->IsArray()) {
+    throw ParserException("Malformed parse tree, %s is not a list", key);
+  }
+  return value->GetElements();
+}
+
+void Transformer::TransformParseTree(
+    const JSONValue& tree, std::vector<std::unique_ptr<SQLStatement>>& result) {
+  for (auto& raw : GetList(tree, "stmts")) {
+    auto stmt = raw.Get("stmt");
+    if (!stmt) {
+      throw ParserException("Malformed parse tree, statement without body");
+    }
+    result.push_back(TransformStatement(*stmt));
+  }
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformStatement(
+    const JSONValue& node) {
+  auto& type   = NodeType(node);
+  auto& fields = NodeFields(node);
+  if (type == "SelectStmt") {
+    return TransformSelect(node);
+  }
+  if (type == "CreateStmt") {
+    return TransformCreateTable(fields);
+  }
+  if (type == "IndexStmt") {
+    return TransformCreateIndex(fields);
+  }
+  if (type == "CreateSchemaStmt") {
+    return TransformCreateSchema(fields);
+  }
+  if (type == "DropStmt") {
+    return TransformDrop(fields);
+  }
+  if (type == "InsertStmt") {
+    return TransformInsert(fields);
+  }
+  if (type == "UpdateStmt") {
+    return TransformUpdate(fields);
+  }
+  if (type == "DeleteStmt") {
+    return TransformDelete(fields);
+  }
+  if (type == "CopyStmt") {
+    return TransformCopy(fields);
+  }
+  if (type == "ExplainStmt") {
+    return TransformExplain(fields);
+  }
+  if (type == "VacuumStmt") {
+    return TransformAnalyze(fields);
+  }
+  throw NotImplementationException("Statement %s is not supported",
+                                   type.c_str());
+}
+
+std::unique_ptr<SelectStatement> Transformer::TransformSelect(
+    const JSONValue& node) {
+  if (NodeType(node) != "SelectStmt") {
+    throw ParserException("Malformed parse tree, expected a SelectStmt");
+  }
+  auto& stmt = NodeFields(node);
+  if (GetString(stmt, "op") != "SETOP_NONE") {
+    throw NotImplementationException(
+        "UNION, INTERSECT and EXCEPT are not supported");
+  }
+  static const char* const kUnsupported[][2] = {
+      {"withClause", "WITH"},          {"sortClause", "ORDER BY"},
+      {"limitCount", "LIMIT"},         {"limitOffset", "OFFSET"},
+      {"windowClause", "WINDOW"},      {"lockingClause", "FOR UPDATE"},
+      {"intoClause", "SELECT INTO"},   {"valuesLists", "VALUES"},
+  };
+  for (auto& clause : kUnsupported) {
+    if (stmt.Get(clause[0])) {
+      throw NotImplementationException("%s is not supported", clause[1]);
+    }
+  }
+
+  auto result = std::make_unique<SelectStatement>();
+  // SELECT DISTINCT has a list with a single empty node, DISTINCT ON a list
+  // of the expressions
+  auto& distinct = GetList(stmt, "distinctClause");
+  for (auto& expr : distinct) {
+    if (!expr.IsObject() || !expr.GetKeys().empty()) {
+      throw NotImplementationException("DISTINCT ON is not supported");
+    }
+  }
+  result->distinct = !distinct.empty();
+  for (auto& target : GetList(stmt, "targetList")) {
+    auto& fields = NodeFields(target);
+    auto val     = fields.Get("val");
+    if (!val) {
+      throw ParserException("Malformed parse tree, target without value");
+    }
+    auto expr   = TransformExpression(*val);
+    expr->alias = GetString(fields, "name");
+    result->select_list.push_back(std::move(expr));
+  }
+  if (stmt.Get("fromClause")) {
+    result->from_table = TransformFrom(*stmt.Get("fromClause"));
+  }
+  if (auto where = stmt.Get("whereClause")) {
+    result->where_clause = TransformExpression(*where);
+  }
+  for (auto& group : GetList(stmt, "groupClause")) {
+    if (NodeType(group) == "GroupingSet") {
+      throw NotImplementationException(
+          "GROUPING SETS, CUBE and ROLLUP are not supported");
+    }
+    result->groups.push_back(TransformExpression(group));
+  }
+  if (auto having = stmt.Get("havingClause")) {
+    result->having = TransformExpression(*having);
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformCreateTable(
+    const JSONValue& stmt) {
+  auto relation = stmt.Get("relation");
+  if (!relation) {
+    throw ParserException("Malformed parse tree, CREATE TABLE without name");
+  }
+  if (stmt.Get("inhRelations") || stmt.Get("partspec")) {
+    throw NotImplementationException(
+        "Inherited and partitioned tables are not supported");
+  }
+  auto result           = std::make_unique<CreateStatement>(CatalogType::kTable);
+  result->schema        = GetString(*relation, "schemaname");
+  result->name          = GetString(*relation, "relname");
+  result->if_not_exists = GetBoolean(stmt, "if_not_exists");
+  for (auto& element : GetList(stmt, "tableElts")) {
+    if (NodeType(element) != "ColumnDef") {
+      throw NotImplementationException("Table constraints are not supported");
+    }
+    auto& column = NodeFields(element);
+    for (auto& constraint : GetList(column, "constraints")) {
+      // NULL is the default, every other constraint would be ignored
+      if (GetString(NodeFields(constraint), "contype") != "CONSTR_NULL") {
+        throw NotImplementationException(
+            "Column constraints are not supported");
+      }
+    }
+    auto type_name = column.Get("typeName");
+    if (!type_name) {
+      throw ParserException("Malformed parse tree, column without type");
+    }
+    result->columns.emplace_back(GetString(column, "colname"),
+                                 TransformTypeName(*type_name));
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformCreateIndex(
+    const JSONValue& stmt) {
+  auto relation = stmt.Get("relation");
+  if (!relation) {
+    throw ParserException("Malformed parse tree, CREATE INDEX without table");
+  }
+  if (stmt.Get("whereClause")) {
+    throw NotImplementationException("Partial indexes are not supported");
+  }
+  auto result           = std::make_unique<CreateStatement>(CatalogType::kIndex);
+  result->schema        = GetString(*relation, "schemaname");
+  result->table         = GetString(*relation, "relname");
+  result->name          = GetString(stmt, "idxname");
+  result->unique        = GetBoolean(stmt, "unique");
+  result->if_not_exists = GetBoolean(stmt, "if_not_exists");
+  for (auto& param : GetList(stmt, "indexParams")) {
+    auto& elem = NodeFields(param);
+    if (!elem.Get("name")) {
+      throw NotImplementationException("Expression indexes are not supported");
+    }
+    result->index_columns.push_back(GetString(elem, "name"));
+  }
+  if (result->name.empty()) {
+    // the name Postgres generates: table_column1_column2_idx
+    result->name = result->table;
+    for (auto& column : result->index_columns) {
+      result->name += "_" + column;
+    }
+    result->name += "_idx";
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformCreateSchema(
+    const JSONValue& stmt) {
+  if (stmt.Get("schemaElts")) {
+    throw NotImplementationException(
+        "Creating objects in CREATE SCHEMA is not supported");
+  }
+  auto result           = std::make_unique<CreateStatement>(CatalogType::kSchema);
+  result->name          = GetString(stmt, "schemaname");
+  result->if_not_exists = GetBoolean(stmt, "if_not_exists");
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformDrop(
+    const JSONValue& stmt) {
+  auto remove_type = GetString(stmt, "removeType");
+  CatalogType object;
+  if (remove_type == "OBJECT_TABLE") {
+    object = CatalogType::kTable;
+  } else if (remove_type == "OBJECT_INDEX") {
+    object = CatalogType::kIndex;
+  } else if (remove_type == "OBJECT_SCHEMA") {
+    object = CatalogType::kSchema;
+  } else {
+    throw NotImplementationException("DROP %s is not supported",
+                                     remove_type.c_str());
+  }
+  if (GetString(stmt, "behavior") == "DROP_CASCADE") {
+    throw NotImplementationException("DROP ... CASCADE is not supported");
+  }
+  auto& objects = GetList(stmt, "objects");
+  if (objects.size() != 1) {
+    throw NotImplementationException("Only one object can be dropped at once");
+  }
+  auto result       = std::make_unique<DropStatement>(object);
+  result->if_exists = GetBoolean(stmt, "missing_ok");
+  if (NodeType(objects[0]) == "String") {
+    result->name = StringNode(objects[0]);
+  } else {
+    // a qualified name: [schema,] name
+    auto& names = GetList(NodeFields(objects[0]), "items");
+    if (names.empty() || names.size() > 2) {
+      throw ParserException("Malformed parse tree, invalid object name");
+    }
+    result->name = StringNode(names.back());
+    if (names.size() == 2) {
+      result->schema = StringNode(names[0]);
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformInsert(
+    const JSONValue& stmt) {
+  if (stmt.Get("onConflictClause") || stmt.Get("returningList") ||
+      stmt.Get("withClause")) {
+    throw NotImplementationException(
+        "ON CONFLICT, RETURNING and WITH are not supported in INSERT");
+  }
+  auto relation = stmt.Get("relation");
+  auto select   = stmt.Get("selectStmt");
+  if (!relation || !select) {
+    throw NotImplementationException("INSERT without values is not supported");
+  }
+  auto result    = std::make_unique<InsertStatement>();
+  result->schema = GetString(*relation, "schemaname");
+  result->table  = GetString(*relation, "relname");
+  for (auto& column : GetList(stmt, "cols")) {
+    result->columns.push_back(GetString(NodeFields(column), "name"));
+  }
+  auto& select_fields = NodeFields(*select);
+  if (!select_fields.Get("valuesLists")) {
+    result->select = TransformSelect(*select);
+    return result;
+  }
+  for (auto& row : GetList(select_fields, "valuesLists")) {
+    std::vector<std::unique_ptr<Expression>> values;
+    TransformExpressionList(*NodeFields(row).Get("items"), values);
+    result->values.push_back(std::move(values));
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformUpdate(
+    const JSONValue& stmt) {
+  if (stmt.Get("fromClause") || stmt.Get("returningList") ||
+      stmt.Get("withClause")) {
+    throw NotImplementationException(
+        "FROM, RETURNING and WITH are not supported in UPDATE");
+  }
+  auto relation = stmt.Get("relation");
+  if (!relation) {
+    throw ParserException("Malformed parse tree, UPDATE without table");
+  }
+  if (relation->Get("alias")) {
+    throw NotImplementationException(
+        "Table aliases are not supported in UPDATE");
+  }
+  auto result    = std::make_unique<UpdateStatement>();
+  result->schema = GetString(*relation, "schemaname");
+  result->table  = GetString(*relation, "relname");
+  for (auto& target : GetList(stmt, "targetList")) {
+    auto& fields = NodeFields(target);
+    auto val     = fields.Get("val");
+    if (!val) {
+      throw ParserException("Malformed parse tree, SET without value");
+    }
+    if (fields.Get("indirection") || NodeType(*val) == "MultiAssignRef") {
+      throw NotImplementationException(
+          "Only SET column = expression is supported in UPDATE");
+    }
+    result->columns.push_back(GetString(fields, "name"));
+    result->expressions.push_back(TransformExpression(*val));
+  }
+  if (auto where = stmt.Get("whereClause")) {
+    result->condition = TransformExpression(*where);
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformDelete(
+    const JSONValue& stmt) {
+  if (stmt.Get("usingClause") || stmt.Get("returningList") ||
+      stmt.Get("withClause")) {
+    throw NotImplementationException(
+        "USING, RETURNING and WITH are not supported in DELETE");
+  }
+  auto relation = stmt.Get("relation");
+  if (!relation) {
+    throw ParserException("Malformed parse tree, DELETE without table");
+  }
+  if (relation->Get("alias")) {
+    throw NotImplementationException(
+        "Table aliases are not supported in DELETE");
+  }
+  auto result    = std::make_unique<DeleteStatement>();
+  result->schema = GetString(*relation, "schemaname");
+  result->table  = GetString(*relation, "relname");
+  if (auto where = stmt.Get("whereClause")) {
+    result->condition = TransformExpression(*where);
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformCopy(
+    const JSONValue& stmt) {
+  if (GetBoolean(stmt, "is_program") || !stmt.Get("filename")) {
+    throw NotImplementationException(
+        "COPY only supports files, not STDIN, STDOUT or programs");
+  }
+  auto result            = std::make_unique<CopyStatement>();
+  result->info.file_path = GetString(stmt, "filename");
+  result->info.is_from   = GetBoolean(stmt, "is_from");
+  if (auto relation = stmt.Get("relation")) {
+    result->schema = GetString(*relation, "schemaname");
+    result->table  = GetString(*relation, "relname");
+  } else if (auto query = stmt.Get("query")) {
+    result->select = TransformSelect(*query);
+  }
+  for (auto& column : GetList(stmt, "attlist")) {
+    result->columns.push_back(StringNode(column));
+  }
+
+  // a .parquet file is read and written as Parquet unless told otherwise
+  if (StringUtil::EndsWith(StringUtil::Lower(result->info.file_path),
+                           ".parquet")) {
+    result->info.format = CopyFormat::kParquet;
+  }
+  for (auto& option : GetList(stmt, "options")) {
+    auto& elem = NodeFields(option);
+    auto name  = GetString(elem, "defname");
+    // the value of the option as text, options without value are true
+    std::string value = "true";
+    if (auto arg = elem.Get("arg")) {
+      auto& arg_type   = NodeType(*arg);
+      auto& arg_fields = NodeFields(*arg);
+      if (arg_type == "String") {
+        value = GetString(arg_fields, "sval");
+      } else if (arg_type == "Boolean") {
+        value = GetBoolean(arg_fields, "boolval") ? "true" : "false";
+      } else if (arg_type == "Integer") {
+        value = std::to_string(GetInteger(arg_fields, "ival"));
+      } else {
+        throw ParserException("Invalid value for COPY option %s",
+                              name.c_str());
+      }
+    }
+    auto raw = value;
+    value    = StringUtil::Lower(value);
+    if (name == "format") {
+      if (value == "csv") {
+        result->info.format = CopyFormat::kCSV;
+      } else if (value == "parquet") {
+        result->info.format = CopyFormat::kParquet;
+      } else {
+        throw NotImplementationException("COPY format %s is not supported",
+                                         value.c_str());
+      }
+    } else if (name == "header") {
+      result->info.header = value == "true" || value == "on" || value == "1";
+    } else if (name == "delimiter" || name == "quote" || name == "escape") {
+      if (raw.size() != 1) {
+        throw ParserException("COPY %s must be a single character",
+                              name.c_str());
+      }
+      (name == "delimiter" ? result->info.delimiter
+       : name == "quote"   ? result->info.quote
+                           : result->info.escape) = raw[0];
+    } else {
+      throw NotImplementationException("COPY option %s is not supported",
+                                       name.c_str());
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformExplain(
+    const JSONValue& stmt) {
+  bool analyze = false;
+  for (auto& option : GetList(stmt, "options")) {
+    auto& elem = NodeFields(option);
+    auto name  = GetString(elem, "defname");
+    if (name == "analyze") {
+      analyze = true;
+      if (auto arg = elem.Get("arg")) {
+        auto value = StringUtil::Lower(GetString(NodeFields(*arg), "sval"));
+        analyze    = NodeType(*arg) == "Boolean"
+                         ? GetBoolean(NodeFields(*arg), "boolval")
+                         : value != "false" && value != "off" && value != "0";
+      }
+    } else if (name != "verbose") {
+      throw NotImplementationException("EXPLAIN option %s is not supported",
+                                       name.c_str());
+    }
+  }
+  auto query = stmt.Get("query");
+  if (!query) {
+    throw ParserException("Malformed parse tree, EXPLAIN without statement");
+  }
+  return std::make_unique<ExplainStatement>(TransformStatement(*query),
+                                            analyze);
+}
+
+std::unique_ptr<SQLStatement> Transformer::TransformAnalyze(
+    const JSONValue& stmt) {
+  if (GetBoolean(stmt, "is_vacuumcmd")) {
+    throw NotImplementationException("VACUUM is not supported");
+  }
+  auto result = std::make_unique<AnalyzeStatement>();
+  for (auto& node : GetList(stmt, "rels")) {
+    if (NodeType(node) != "VacuumRelation") {
+      throw ParserException("Malformed parse tree, expected a relation");
+    }
+    // a column list is accepted, the statistics of every column of the
+    // table are rebuilt in one scan anyway
+    auto relation = NodeFields(node).Get("relation");
+    if (!relation) {
+      throw ParserException("Malformed parse tree, relation without name");
+    }
+    result->tables.push_back({GetString(*relation, "schemaname"),
+                              GetString(*relation, "relname")});
+  }
+  return result;
+}
+
+std::unique_ptr<TableRef> Transformer::TransformFrom(const JSONValue& list) {
+  std::unique_ptr<TableRef> result;
+  for (auto& node : list.GetElements()) {
+    auto ref = TransformTableRef(node);
+    result   = result ? std::make_unique<CrossProductRef>(std::move(result),
+                                                          std::move(ref))
+                      : std::move(ref);
+  }
+  return result;
+}
+
+std::unique_ptr<TableRef> Transformer::TransformTableRef(
+    const JSONValue& node) {
+  auto& type   = NodeType(node);
+  auto& fields = NodeFields(node);
+  auto alias   = fields.Get("alias");
+  std::unique_ptr<TableRef> result;
+  if (type == "RangeVar") {
+    auto ref = std::make_unique<BaseTableRef>(GetString(fields, "schemaname"),
+                                              GetString(fields, "relname"));
+    ref->alias = ref->table_name;
+    result     = std::move(ref);
+  } else if (type == "JoinExpr") {
+    auto join_type = GetString(fields, "jointype");
+    if (GetBoolean(fields, "isNatural") || fields.Get("usingClause")) {
+      throw NotImplementationException(
+          "NATURAL JOIN and JOIN ... USING are not supported");
+    }
+    auto left  = TransformTableRef(*fields.Get("larg"));
+    auto right = TransformTableRef(*fields.Get("rarg"));
+    auto quals = fields.Get("quals");
+    if (join_type == "JOIN_INNER" && !quals) {
+      return std::make_unique<CrossProductRef>(std::move(left),
+                                               std::move(right));
+    }
+    auto ref = std::make_unique<JoinRef>();
+    if (join_type == "JOIN_INNER") {
+      ref->join_type = JoinType::kInner;
+    } else if (join_type == "JOIN_LEFT") {
+      ref->join_type = JoinType::kLeft;
+    } else if (join_type == "JOIN_RIGHT") {
+      // a RIGHT JOIN b is b LEFT JOIN a
+      ref->join_type = JoinType::kLeft;
+      std::swap(left, right);
+    } else {
+      throw NotImplementationException("%s is not supported",
+                                       join_type.c_str());
+    }
+    ref->left      = std::move(left);
+    ref->right     = std::move(right);
+    ref->condition = TransformExpression(*quals);
+    result         = std::move(ref);
+  } else if (type == "RangeSubselect") {
+    if (GetBoolean(fields, "lateral")) {
+      throw NotImplementationException("LATERAL is not supported");
+    }
+    result = std::make_unique<SubqueryRef>(
+        TransformSelect(*fields.Get("subquery")));
+  } else if (type == "RangeFunction") {
+    auto& functions = GetList(fields, "functions");
+    if (GetBoolean(fields, "lateral") || GetBoolean(fields, "ordinality") ||
+        functions.size() != 1) {
+      throw NotImplementationException(
+          "Only a single table function without LATERAL or WITH ORDINALITY "
+          "is supported");
+    }
+    // every function is a list of the call and its column definitions
+    auto& items    = GetList(NodeFields(functions[0]), "items");
+    auto function  = TransformExpression(items.at(0));
+    auto ref       = std::make_unique<TableFunctionRef>(std::move(function));
+    ref->alias     = ref->function->GetName();
+    result         = std::move(ref);
+  } else {
+    throw NotImplementationException("%s in FROM is not supported",
+                                     type.c_str());
+  }
+  if (alias) {
+    if (alias->Get("colnames")) {
+      throw NotImplementationException("Column aliases are not supported");
+    }
+    result->alias = GetString(*alias, "aliasname");
+  }
+  return result;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,96 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/bind_context.hpp"
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+void BindContext::AddBinding(std::string alias, size_t table_index,
+                             std::vector<std::string> names,
+                             std::vector<TypeId> types,
+                             std::vector<size_t>* column_ids) {
+  for (auto& binding : bindings_) {
+    if (binding.alias == alias) {
+      throw BinderException("Table name \"%s\" specified more than once",
+                            alias.c_str());
+    }
+  }
+  bindings_.push_back(Binding{std::move(alias), table_index, std::move(names),
+                              std::move(types), column_ids});
+}
+
+std::unique_ptr<Expression> BindContext::BindColumn(
+    const ColumnRefExpression& ref, size_t depth) {
+  Binding* found = nullptr;
+  size_t column  = 0;
+  for (auto& binding : bindings_) {
+    if (!ref.table_name.empty() && binding.alias != ref.table_name) {
+      continue;
+    }
+    for (size_t i = 0; i < binding.names.size(); i++) {
+      if (binding.names[i] != ref.column_name) {
+        continue;
+      }
+      if (found) {
+        throw BinderException("Column reference \"%s\" is ambiguous",
+                              ref.column_name.c_str());
+      }
+      found  = &binding;
+      column = i;
+    }
+  }
+  if (!found) {
+    return nullptr;
+  }
+  auto result = BindColumn(*found, column, depth);
+  result->alias = ref.alias;
+  return result;
+}
+
+void BindContext::ExpandStar(const std::string& relation,
+                             std::vector<std::unique_ptr<Expression>>& result) {
+  bool found = false;
+  for (auto& binding : bindings_) {
+    if (!relation.empty() && binding.alias != relation) {
+      continue;
+    }
+    found = true;
+    for (size_t i = 0; i < binding.names.size(); i++) {
+      result.push_back(BindColumn(binding, i, 0));
+    }
+  }
+  if (!found) {
+    throw BinderException(relation.empty()
+                              ? "SELECT * with no tables specified"
+                              : "Missing FROM-clause entry for table \"%s\"",
+                          relation.c_str());
+  }
+}
+
+std::unique_ptr<Expression> BindContext::BindColumn(Binding& binding,
+                                                    size_t column,
+                                                    size_t depth) {
+  // columns of base tables and files are numbered in the order they are
+  // first referenced, unreferenced columns are never read
+  auto index = column;
+  if (binding.column_ids) {
+    auto& ids = *binding.column_ids;
+    for (index = 0; index < ids.size() && ids[index] != column; index++) {
+    }
+    if (index == ids.size()) {
+      ids.push_back(column);
+    }
+  }
+  auto result = std::make_unique<ColumnRefExpression>(
+      binding.types[column], ColumnBinding(binding.table_index, index), depth);
+  result->column_name = binding.names[column];
+  return result;
+}
+
+}  // namespace zoomdb
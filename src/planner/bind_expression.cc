@@ -0,0 +1,438 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "common/exception.hpp"
+#include "parser/expression/aggregate_expression.hpp"
+#include "parser/expression/cast_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/function_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+#include "parser/expression/window_expression.hpp"
+#include "planner/binder.hpp"
+#include "planner/logical_plan_generator.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * Returns the fraction of APPROX_QUANTILE(x, q), which must be a numeric
+ * constant between 0 and 1.
+ */
+double BindQuantile(const std::string& name,
+                    const std::unique_ptr<Expression>& argument) {
+  if (argument->type != ExpressionType::kValueConstant ||
+      !TypeIsNumeric(argument->return_type)) {
+    throw BinderException("The quantile of %s must be a numeric constant",
+                          name.c_str());
+  }
+  auto quantile = static_cast<ConstantExpression&>(*argument)
+                      .value.CastAs(TypeId::kDecimal)
+                      .GetValue<double>();
+  if (!(quantile >= 0 && quantile <= 1)) {
+    throw BinderException("The quantile of %s must be between 0 and 1",
+                          name.c_str());
+  }
+  return quantile;
+}
+
+bool IsStringLiteral(const Expression& expr) {
+  return expr.type == ExpressionType::kValueConstant &&
+         expr.return_type == TypeId::kVarChar;
+}
+
+/**
+ * Returns the type two (non literal) operands are converted to, kInvalid
+ * stands for a NULL literal, which takes any type.
+ */
+TypeId CombineTypes(TypeId left, TypeId right, const char* context) {
+  if (left == TypeId::kInvalid || left == right) {
+    return right;
+  }
+  if (right == TypeId::kInvalid) {
+    return left;
+  }
+  if (TypeIsNumeric(left) && TypeIsNumeric(right)) {
+    // the numeric types are declared from the narrowest to the widest
+    return left < right ? right : left;
+  }
+  if ((left == TypeId::kDate && right == TypeId::kTimestamp) ||
+      (left == TypeId::kTimestamp && right == TypeId::kDate)) {
+    return TypeId::kTimestamp;
+  }
+  throw TypeMismatchException(context, left, right);
+}
+
+/**
+ * Returns the type all operands are converted to. String literals take the
+ * type of the other operands, kInvalid if all operands are NULL.
+ */
+TypeId CommonType(const std::vector<Expression*>& operands,
+                  const char* context) {
+  auto result       = TypeId::kInvalid;
+  bool has_literals = false;
+  for (auto operand : operands) {
+    if (IsStringLiteral(*operand)) {
+      has_literals = true;
+    } else {
+      result = CombineTypes(result, operand->return_type, context);
+    }
+  }
+  if (result == TypeId::kInvalid && has_literals) {
+    return TypeId::kVarChar;
+  }
+  return result;
+}
+
+/**
+ * Convert all children of the expression, starting at begin, to a common
+ * type, if_null if all of them are NULL. Returns the common type.
+ */
+TypeId CastToCommonType(Expression& expr, size_t begin, TypeId if_null,
+                        const char* context) {
+  std::vector<Expression*> operands;
+  for (size_t i = begin; i < expr.children.size(); i++) {
+    operands.push_back(expr.children[i].get());
+  }
+  auto type = CommonType(operands, context);
+  if (type == TypeId::kInvalid) {
+    type = if_null;
+  }
+  for (size_t i = begin; i < expr.children.size(); i++) {
+    Binder::CastTo(expr.children[i], type);
+  }
+  return type;
+}
+
+/**
+ * Convert an operand that must have the given type, only NULL and string
+ * literals are converted implicitly.
+ */
+void CastOperand(std::unique_ptr<Expression>& operand, TypeId type,
+                 const char* context) {
+  if (operand->return_type != type &&
+      operand->return_type != TypeId::kInvalid && !IsStringLiteral(*operand)) {
+    throw TypeMismatchException(context, operand->return_type, type);
+  }
+  Binder::CastTo(operand, type);
+}
+
+}  // namespace
+
+void Binder::CastTo(std::unique_ptr<Expression>& expr, TypeId target) {
+  if (expr->return_type == target) {
+    return;
+  }
+  if (expr->type == ExpressionType::kValueConstant) {
+    auto& constant = static_cast<ConstantExpression&>(*expr).value;
+    constant = constant.IsNull() ? Value(target) : constant.CastAs(target);
+    expr->return_type = target;
+    return;
+  }
+  auto alias  = expr->alias;
+  expr        = std::make_unique<CastExpression>(target, std::move(expr));
+  expr->alias = alias;
+}
+
+void Binder::BindExpression(std::unique_ptr<Expression>& expr,
+                            bool allow_aggregates) {
+  if (dynamic_cast<SubqueryExpression*>(expr.get())) {
+    BindSubquery(expr);
+    return;
+  }
+  switch (expr->type) {
+    case ExpressionType::kColumnRef:
+      BindColumnRef(expr);
+      return;
+    case ExpressionType::kStar:
+      throw BinderException("* is only allowed in the select list");
+    case ExpressionType::kFunctionRef:
+      BindFunction(expr, allow_aggregates);
+      return;
+    case ExpressionType::kWindowAggregate:
+      BindWindow(expr, allow_aggregates);
+      return;
+    case ExpressionType::kValueConstant:
+      return;
+    default:
+      break;
+  }
+  if (AggregateExpression::IsAggregate(expr->type)) {
+    // bound before, e.g. a copy of a select list entry
+    return;
+  }
+  for (auto& child : expr->children) {
+    BindExpression(child, allow_aggregates);
+  }
+  ResolveType(*expr);
+}
+
+void Binder::BindCondition(std::unique_ptr<Expression>& expr,
+                           const char* clause, bool allow_aggregates) {
+  BindExpression(expr, allow_aggregates);
+  if (expr->return_type == TypeId::kInvalid || IsStringLiteral(*expr)) {
+    CastTo(expr, TypeId::kBoolean);
+  }
+  if (expr->return_type != TypeId::kBoolean) {
+    throw BinderException("Argument of %s must be type BOOLEAN, not type %s",
+                          clause, TypeIdToString(expr->return_type).c_str());
+  }
+}
+
+void Binder::BindColumnRef(std::unique_ptr<Expression>& expr) {
+  auto& ref = static_cast<ColumnRefExpression&>(*expr);
+  if (ref.binding.IsValid()) {
+    return;
+  }
+  // the innermost query that has the column wins, columns of an enclosing
+  // query are correlated
+  size_t depth = 0;
+  for (auto binder = this; binder; depth++) {
+    auto result = binder->context_.BindColumn(ref, depth);
+    if (result) {
+      expr = std::move(result);
+      return;
+    }
+    binder = binder->access_parent_ ? binder->parent_ : nullptr;
+  }
+  throw BinderException("Column \"%s\" does not exist",
+                        ref.ToString().c_str());
+}
+
+void Binder::BindFunction(std::unique_ptr<Expression>& expr,
+                          bool allow_aggregates) {
+  auto& function = static_cast<FunctionExpression&>(*expr);
+  auto& name     = function.function_name;
+  auto entry     = catalog_.GetFunction(
+      function.schema_name.empty() ? Catalog::kDefaultSchema
+                                   : function.schema_name,
+      name, timestamp_);
+  if (entry->function_type != FunctionType::kAggregate) {
+    throw BinderException("Function %s cannot be used in an expression",
+                          name.c_str());
+  }
+  if (!allow_aggregates) {
+    throw BinderException("Aggregate function %s is not allowed here",
+                          name.c_str());
+  }
+
+  std::unique_ptr<Expression> result;
+  if (function.star) {
+    if (entry->expression_type != ExpressionType::kAggregateCount) {
+      throw BinderException("%s(*) is not supported", name.c_str());
+    }
+    result = std::make_unique<AggregateExpression>(
+        ExpressionType::kAggregateCountStar, nullptr);
+  } else {
+    auto type = entry->expression_type;
+    if (type == ExpressionType::kAggregateApproxQuantile) {
+      if (function.children.size() != 2) {
+        throw BinderException("Function %s takes exactly two arguments",
+                              name.c_str());
+      }
+    } else if (function.children.size() != 1) {
+      throw BinderException("Function %s takes exactly one argument",
+                            name.c_str());
+    }
+    auto& child = function.children[0];
+    BindExpression(child);
+    if (type == ExpressionType::kAggregateSum ||
+        type == ExpressionType::kAggregateAvg ||
+        type == ExpressionType::kAggregateApproxQuantile) {
+      if (child->return_type == TypeId::kInvalid) {
+        CastTo(child, TypeId::kInteger);
+      }
+      if (!TypeIsNumeric(child->return_type)) {
+        throw BinderException("Function %s(%s) does not exist", name.c_str(),
+                              TypeIdToString(child->return_type).c_str());
+      }
+    } else if (child->return_type == TypeId::kInvalid) {
+      CastTo(child, TypeId::kVarChar);
+    }
+    auto aggregate = std::make_unique<AggregateExpression>(
+        type, std::move(child), function.distinct);
+    if (type == ExpressionType::kAggregateApproxQuantile) {
+      BindExpression(function.children[1]);
+      aggregate->quantile = BindQuantile(name, function.children[1]);
+    }
+    result = std::move(aggregate);
+  }
+  result->alias = function.alias;
+  expr          = std::move(result);
+}
+
+void Binder::BindWindow(std::unique_ptr<Expression>& expr,
+                        bool allow_aggregates) {
+  if (!allow_aggregates) {
+    throw BinderException("Window functions are not allowed here");
+  }
+  auto& window = static_cast<WindowExpression&>(*expr);
+  for (auto& child : window.children) {
+    if (child->HasWindow()) {
+      throw BinderException("Window function calls cannot be nested");
+    }
+    if (child->HasSubquery()) {
+      throw NotImplementationException(
+          "Subqueries in window functions are not supported");
+    }
+  }
+  if (window.children[0]->type == ExpressionType::kFunctionRef) {
+    // the arguments are evaluated per group of an aggregated query, so they
+    // may be aggregates themselves, as in SUM(SUM(x)) OVER ()
+    for (auto& argument : window.children[0]->children) {
+      BindExpression(argument, true);
+    }
+    BindFunction(window.children[0], true);
+  }
+  if (static_cast<AggregateExpression&>(window.GetFunction()).distinct) {
+    throw NotImplementationException(
+        "DISTINCT is not supported in window functions");
+  }
+  for (size_t i = 1; i < window.children.size(); i++) {
+    BindExpression(window.children[i], true);
+    if (window.children[i]->return_type == TypeId::kInvalid) {
+      CastTo(window.children[i], TypeId::kVarChar);
+    }
+  }
+  window.return_type = window.GetFunction().return_type;
+}
+
+void Binder::BindSubquery(std::unique_ptr<Expression>& expr) {
+  auto& subquery = static_cast<SubqueryExpression&>(*expr);
+  if (!subquery.select) {
+    return;
+  }
+  for (auto& child : subquery.children) {
+    BindExpression(child);
+  }
+  auto& select = *subquery.select;
+  Binder binder(catalog_, timestamp_, this);
+  binder.Bind(select);
+
+  auto& select_list = select.select_list;
+  switch (subquery.subquery_type) {
+    case SubqueryType::kScalar:
+      if (select_list.size() != 1) {
+        throw BinderException("Subquery must return only one column");
+      }
+      subquery.return_type = select_list[0]->return_type;
+      break;
+    case SubqueryType::kAny:
+      if (select_list.size() != subquery.children.size()) {
+        throw BinderException("Subquery has too %s columns",
+                              select_list.size() > subquery.children.size()
+                                  ? "many"
+                                  : "few");
+      }
+      // the projection of the subquery converts its columns
+      for (size_t i = 0; i < select_list.size(); i++) {
+        auto type = CommonType({subquery.children[i].get(),
+                                select_list[i].get()},
+                               "in subquery comparison");
+        if (type == TypeId::kInvalid) {
+          type = TypeId::kVarChar;
+        }
+        CastTo(subquery.children[i], type);
+        CastTo(select_list[i], type);
+      }
+      break;
+    case SubqueryType::kExists:
+      break;
+  }
+  subquery.subquery = LogicalPlanGenerator().CreatePlan(select);
+  subquery.select.reset();
+}
+
+void Binder::ResolveType(Expression& expr) {
+  auto& children = expr.children;
+  switch (expr.type) {
+    case ExpressionType::kOperatorPlus:
+    case ExpressionType::kOperatorMinus:
+    case ExpressionType::kOperatorMultiply:
+    case ExpressionType::kOperatorDivide:
+    case ExpressionType::kOperatorMod: {
+      auto type = CastToCommonType(expr, 0, TypeId::kInteger, "in arithmetic");
+      if (!TypeIsNumeric(type)) {
+        throw TypeMismatchException("in arithmetic", type, TypeId::kDecimal);
+      }
+      expr.return_type = type;
+      break;
+    }
+    case ExpressionType::kOperatorUnaryMinus: {
+      if (children[0]->return_type == TypeId::kInvalid) {
+        CastTo(children[0], TypeId::kInteger);
+      }
+      auto type = children[0]->return_type;
+      if (!TypeIsNumeric(type)) {
+        throw TypeMismatchException("in negation", type, TypeId::kDecimal);
+      }
+      expr.return_type = type;
+      break;
+    }
+    case ExpressionType::kOperatorConcat:
+      // any value can be converted to a string
+      for (auto& child : children) {
+        CastTo(child, TypeId::kVarChar);
+      }
+      expr.return_type = TypeId::kVarChar;
+      break;
+    case ExpressionType::kCompareEqual:
+    case ExpressionType::kCompareNotEqual:
+    case ExpressionType::kCompareLessThan:
+    case ExpressionType::kCompareGreaterThan:
+    case ExpressionType::kCompareLessThanOrEqualTo:
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+    case ExpressionType::kCompareDistinctFrom:
+    case ExpressionType::kCompareIn:
+      CastToCommonType(expr, 0, TypeId::kVarChar, "in comparison");
+      expr.return_type = TypeId::kBoolean;
+      break;
+    case ExpressionType::kCompareLike:
+    case ExpressionType::kCompareNotLike:
+      for (auto& child : children) {
+        CastOperand(child, TypeId::kVarChar, "in LIKE");
+      }
+      expr.return_type = TypeId::kBoolean;
+      break;
+    case ExpressionType::kConjunctionAnd:
+    case ExpressionType::kConjunctionOr:
+    case ExpressionType::kOperatorNot:
+      for (auto& child : children) {
+        CastOperand(child, TypeId::kBoolean, "in boolean expression");
+      }
+      expr.return_type = TypeId::kBoolean;
+      break;
+    case ExpressionType::kOperatorIsNull:
+    case ExpressionType::kOperatorIsNotNull:
+      if (children[0]->return_type == TypeId::kInvalid) {
+        CastTo(children[0], TypeId::kVarChar);
+      }
+      expr.return_type = TypeId::kBoolean;
+      break;
+    case ExpressionType::kOperatorCast:
+      if (children[0]->return_type == TypeId::kInvalid) {
+        CastTo(children[0], expr.return_type);
+      }
+      break;
+    case ExpressionType::kOperatorCoalesce:
+      expr.return_type =
+          CastToCommonType(expr, 0, TypeId::kVarChar, "in COALESCE");
+      break;
+    case ExpressionType::kOperatorCaseExpr:
+      // CASE WHEN children[0] THEN children[1] ELSE children[2] END
+      CastOperand(children[0], TypeId::kBoolean, "in CASE condition");
+      expr.return_type =
+          CastToCommonType(expr, 1, TypeId::kVarChar, "in CASE");
+      break;
+    default:
+      throw NotImplementationException(
+          "Unsupported expression %s in binder",
+          ExpressionTypeToString(expr.type).c_str());
+  }
+}
+
+}  // namespace zoomdb
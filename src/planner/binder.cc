@@ -0,0 +1,489 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/binder.hpp"
+
+#include "common/exception.hpp"
+#include "parser/expression/aggregate_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/function_expression.hpp"
+#include "parser/expression/star_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+#include "parser/tableref/base_table_ref.hpp"
+#include "parser/tableref/cross_product_ref.hpp"
+#include "parser/tableref/join_ref.hpp"
+#include "parser/tableref/subquery_ref.hpp"
+#include "parser/tableref/table_function_ref.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+const std::string& SchemaOrDefault(const std::string& schema) {
+  static const std::string kDefault = Catalog::kDefaultSchema;
+  return schema.empty() ? kDefault : schema;
+}
+
+}  // namespace
+
+Binder::Binder(Catalog& catalog, uint64_t timestamp, Binder* parent,
+               bool access_parent)
+    : catalog_(catalog),
+      timestamp_(timestamp),
+      parent_(parent),
+      access_parent_(access_parent),
+      next_table_index_(0),
+      parquet_cache_(nullptr) {}
+
+Binder::Binder(Catalog& catalog, uint64_t timestamp,
+               ParquetFileCache* parquet_cache)
+    : Binder(catalog, timestamp) {
+  parquet_cache_ = parquet_cache;
+}
+
+size_t Binder::GenerateTableIndex() {
+  return parent_ ? parent_->GenerateTableIndex() : next_table_index_++;
+}
+
+ParquetFileCache* Binder::GetParquetCache() const {
+  return parent_ ? parent_->GetParquetCache() : parquet_cache_;
+}
+
+void Binder::Bind(SelectStatement& statement) {
+  if (statement.from_table) {
+    BindTableRef(*statement.from_table);
+  }
+
+  // expand the stars of the select list
+  std::vector<std::unique_ptr<Expression>> select_list;
+  for (auto& expr : statement.select_list) {
+    if (expr->type == ExpressionType::kStar) {
+      context_.ExpandStar(static_cast<StarExpression&>(*expr).relation_name,
+                          select_list);
+    } else {
+      select_list.push_back(std::move(expr));
+    }
+  }
+  statement.select_list = std::move(select_list);
+  for (auto& expr : statement.select_list) {
+    statement.names.push_back(expr->GetName());
+  }
+
+  BindGroups(statement);
+  if (statement.where_clause) {
+    BindCondition(statement.where_clause, "WHERE");
+  }
+  for (auto& expr : statement.select_list) {
+    BindExpression(expr, true);
+    if (expr->return_type == TypeId::kInvalid) {
+      // SELECT NULL
+      CastTo(expr, TypeId::kVarChar);
+    }
+  }
+  if (statement.having) {
+    if (statement.having->HasWindow()) {
+      throw BinderException("Window functions are not allowed in HAVING");
+    }
+    BindCondition(statement.having, "HAVING", true);
+  }
+
+  // a query with aggregates, groups or a HAVING clause produces one row per
+  // group: it may only reference the groups and aggregates
+  statement.aggregated = !statement.groups.empty() || statement.having;
+  for (auto& expr : statement.select_list) {
+    statement.aggregated = statement.aggregated || expr->IsAggregate();
+  }
+  if (statement.aggregated) {
+    if (!statement.from_table) {
+      throw NotImplementationException(
+          "Aggregates without a FROM clause are not supported");
+    }
+    statement.group_index     = GenerateTableIndex();
+    statement.aggregate_index = GenerateTableIndex();
+    for (auto& expr : statement.select_list) {
+      BindAggregates(expr, statement);
+    }
+    if (statement.having) {
+      BindAggregates(statement.having, statement);
+    }
+  }
+  // the window functions see the rows of the aggregate
+  for (auto& expr : statement.select_list) {
+    if (expr->HasWindow()) {
+      if (!statement.from_table) {
+        throw NotImplementationException(
+            "Window functions without a FROM clause are not supported");
+      }
+      if (statement.windows.empty()) {
+        statement.window_index = GenerateTableIndex();
+      }
+      BindWindows(expr, statement);
+    }
+  }
+  statement.projection_index = GenerateTableIndex();
+}
+
+void Binder::Bind(InsertStatement& statement) {
+  auto table = catalog_.GetTable(SchemaOrDefault(statement.schema),
+                                 statement.table, timestamp_);
+  statement.table_entry = table;
+  if (statement.columns.empty()) {
+    for (size_t i = 0; i < table->columns.size(); i++) {
+      statement.column_ids.push_back(i);
+    }
+  } else {
+    for (auto& column : statement.columns) {
+      if (!table->ColumnExists(column)) {
+        throw BinderException("Column \"%s\" of table \"%s\" does not exist",
+                              column.c_str(), table->name.c_str());
+      }
+      auto index = table->GetColumnIndex(column);
+      for (auto id : statement.column_ids) {
+        if (id == index) {
+          throw BinderException("Column \"%s\" specified more than once",
+                                column.c_str());
+        }
+      }
+      statement.column_ids.push_back(index);
+    }
+  }
+
+  auto column_count = statement.column_ids.size();
+  for (auto& row : statement.values) {
+    if (row.size() != column_count) {
+      throw BinderException("INSERT has %s expressions than target columns",
+                            row.size() > column_count ? "more" : "fewer");
+    }
+    for (size_t i = 0; i < column_count; i++) {
+      BindExpression(row[i]);
+      CastTo(row[i], table->columns[statement.column_ids[i]].type);
+    }
+  }
+  if (statement.select) {
+    auto& select = *statement.select;
+    Bind(select);
+    if (select.select_list.size() != column_count) {
+      throw BinderException(
+          "INSERT has %s expressions than target columns",
+          select.select_list.size() > column_count ? "more" : "fewer");
+    }
+    for (size_t i = 0; i < column_count; i++) {
+      CastTo(select.select_list[i],
+             table->columns[statement.column_ids[i]].type);
+    }
+  }
+}
+
+void Binder::Bind(UpdateStatement& statement) {
+  statement.select = BindRowIdQuery(statement.schema, statement.table,
+                                    std::move(statement.condition));
+  auto& select = *statement.select;
+  auto table   = static_cast<BaseTableRef&>(*select.from_table).table;
+  statement.table_entry = table;
+  for (size_t i = 0; i < statement.columns.size(); i++) {
+    auto& column = statement.columns[i];
+    if (!table->ColumnExists(column)) {
+      throw BinderException("Column \"%s\" of table \"%s\" does not exist",
+                            column.c_str(), table->name.c_str());
+    }
+    auto index = table->GetColumnIndex(column);
+    for (auto id : statement.column_ids) {
+      if (id == index) {
+        throw BinderException("Multiple assignments to column \"%s\"",
+                              column.c_str());
+      }
+    }
+    statement.column_ids.push_back(index);
+    // the new values follow the row id in the select list
+    auto& expr = statement.expressions[i];
+    BindExpression(expr);
+    CastTo(expr, table->columns[index].type);
+    select.select_list.push_back(std::move(expr));
+  }
+  statement.expressions.clear();
+}
+
+void Binder::Bind(DeleteStatement& statement) {
+  statement.select = BindRowIdQuery(statement.schema, statement.table,
+                                    std::move(statement.condition));
+  statement.table_entry =
+      static_cast<BaseTableRef&>(*statement.select->from_table).table;
+}
+
+void Binder::Bind(CopyStatement& statement) {
+  if (statement.info.is_from) {
+    auto table = catalog_.GetTable(SchemaOrDefault(statement.schema),
+                                   statement.table, timestamp_);
+    for (size_t i = 0; i < statement.columns.size(); i++) {
+      if (i >= table->columns.size() ||
+          statement.columns[i] != table->columns[i].name) {
+        throw NotImplementationException(
+            "COPY FROM only supports all columns of the table in order");
+      }
+    }
+    if (!statement.columns.empty() &&
+        statement.columns.size() != table->columns.size()) {
+      throw NotImplementationException(
+          "COPY FROM only supports all columns of the table in order");
+    }
+    statement.table_entry = table;
+    return;
+  }
+
+  if (!statement.select) {
+    // COPY table [(columns)] TO file is SELECT columns FROM table
+    statement.select = std::make_unique<SelectStatement>();
+    auto& select     = *statement.select;
+    select.from_table =
+        std::make_unique<BaseTableRef>(statement.schema, statement.table);
+    if (statement.columns.empty()) {
+      select.select_list.push_back(std::make_unique<StarExpression>());
+    }
+    for (auto& column : statement.columns) {
+      select.select_list.push_back(
+          std::make_unique<ColumnRefExpression>(column));
+    }
+  }
+  Bind(*statement.select);
+}
+
+std::unique_ptr<SelectStatement> Binder::BindRowIdQuery(
+    const std::string& schema, const std::string& table,
+    std::unique_ptr<Expression> condition) {
+  auto result        = std::make_unique<SelectStatement>();
+  result->from_table = std::make_unique<BaseTableRef>(schema, table);
+  BindTableRef(*result->from_table);
+  // the row id is the first column of the scan, the columns referenced by
+  // the condition follow
+  auto& base = static_cast<BaseTableRef&>(*result->from_table);
+  base.column_ids.push_back(DataTable::kRowIdColumn);
+  auto row_id = std::make_unique<ColumnRefExpression>(
+      TypeId::kBigInt, ColumnBinding(base.table_index, 0));
+  row_id->column_name = "rowid";
+  result->select_list.push_back(std::move(row_id));
+  if (condition) {
+    result->where_clause = std::move(condition);
+    BindCondition(result->where_clause, "WHERE");
+  }
+  result->projection_index = GenerateTableIndex();
+  return result;
+}
+
+void Binder::BindTableRef(TableRef& ref) {
+  switch (ref.type) {
+    case TableReferenceType::kBaseTable: {
+      auto& base       = static_cast<BaseTableRef&>(ref);
+      base.table       = catalog_.GetTable(SchemaOrDefault(base.schema_name),
+                                           base.table_name, timestamp_);
+      base.table_index = GenerateTableIndex();
+      std::vector<std::string> names;
+      for (auto& column : base.table->columns) {
+        names.push_back(column.name);
+      }
+      context_.AddBinding(base.alias.empty() ? base.table_name : base.alias,
+                          base.table_index, std::move(names),
+                          base.table->GetTypes(), &base.column_ids);
+      break;
+    }
+    case TableReferenceType::kJoin: {
+      auto& join = static_cast<JoinRef&>(ref);
+      BindTableRef(*join.left);
+      BindTableRef(*join.right);
+      BindCondition(join.condition, "JOIN/ON");
+      break;
+    }
+    case TableReferenceType::kCrossProduct: {
+      auto& cross = static_cast<CrossProductRef&>(ref);
+      BindTableRef(*cross.left);
+      BindTableRef(*cross.right);
+      break;
+    }
+    case TableReferenceType::kSubquery: {
+      // a subquery in FROM cannot reference the columns of the query it
+      // is used in
+      auto& subquery = static_cast<SubqueryRef&>(ref);
+      Binder binder(catalog_, timestamp_, this, false);
+      binder.Bind(*subquery.subquery);
+      std::vector<TypeId> types;
+      for (auto& expr : subquery.subquery->select_list) {
+        types.push_back(expr->return_type);
+      }
+      context_.AddBinding(subquery.alias, subquery.subquery->projection_index,
+                          subquery.subquery->names, std::move(types));
+      break;
+    }
+    case TableReferenceType::kTableFunction: {
+      auto& function_ref = static_cast<TableFunctionRef&>(ref);
+      auto& call = static_cast<FunctionExpression&>(*function_ref.function);
+      auto function = catalog_.GetFunction(SchemaOrDefault(call.schema_name),
+                                           call.function_name, timestamp_);
+      if (function->function_type != FunctionType::kTable) {
+        throw BinderException("Function %s does not produce a table",
+                              call.function_name.c_str());
+      }
+      // read_parquet(path [, prefetch_depth]) is the only table function
+      if (call.children.empty() || call.children.size() > 2 ||
+          call.children[0]->type != ExpressionType::kValueConstant ||
+          call.children[0]->return_type != TypeId::kVarChar) {
+        throw BinderException("%s expects a file name",
+                              call.function_name.c_str());
+      }
+      auto& path = static_cast<ConstantExpression&>(*call.children[0]).value;
+      if (call.children.size() == 2) {
+        auto& depth = *call.children[1];
+        if (depth.type != ExpressionType::kValueConstant ||
+            !TypeIsIntegral(depth.return_type)) {
+          throw BinderException("%s expects an integer prefetch depth",
+                                call.function_name.c_str());
+        }
+        auto& value = static_cast<ConstantExpression&>(depth).value;
+        if (value.IsNull() || value.GetNumericValue() < 0) {
+          throw BinderException("%s expects a non-negative prefetch depth",
+                                call.function_name.c_str());
+        }
+        function_ref.prefetch_depth =
+            static_cast<size_t>(value.GetNumericValue());
+      }
+      auto parquet_cache = GetParquetCache();
+      if (parquet_cache) {
+        function_ref.reader = parquet_cache->GetReader(path.GetString());
+      } else {
+        function_ref.reader = std::make_shared<ParquetReader>(path.GetString());
+      }
+      function_ref.table_index = GenerateTableIndex();
+      context_.AddBinding(function_ref.alias, function_ref.table_index,
+                          function_ref.reader->GetNames(),
+                          function_ref.reader->GetTypes(),
+                          &function_ref.column_ids);
+      break;
+    }
+    default:
+      throw NotImplementationException("Unsupported table reference");
+  }
+}
+
+void Binder::BindGroups(SelectStatement& statement) {
+  for (auto& group : statement.groups) {
+    if (group->type == ExpressionType::kValueConstant) {
+      // GROUP BY 1 refers to the first column of the select list
+      auto& value = static_cast<ConstantExpression&>(*group).value;
+      if (TypeIsIntegral(value.GetType()) && !value.IsNull()) {
+        auto position = value.GetNumericValue();
+        if (position < 1 ||
+            static_cast<size_t>(position) > statement.select_list.size()) {
+          throw BinderException(
+              "GROUP BY position %lld is not in select list",
+              static_cast<long long>(position));
+        }
+        group = statement.select_list[static_cast<size_t>(position) - 1]
+                    ->Copy();
+      }
+    } else if (group->type == ExpressionType::kColumnRef) {
+      // GROUP BY alias refers to a column of the select list, unless a
+      // table has a column with the name
+      auto& ref = static_cast<ColumnRefExpression&>(*group);
+      if (ref.table_name.empty() && !ref.binding.IsValid() &&
+          !context_.BindColumn(ref, 0)) {
+        for (auto& expr : statement.select_list) {
+          if (expr->alias == ref.column_name) {
+            group = expr->Copy();
+            break;
+          }
+        }
+      }
+    }
+    BindExpression(group);
+    if (group->return_type == TypeId::kInvalid) {
+      CastTo(group, TypeId::kVarChar);
+    }
+  }
+}
+
+void Binder::BindAggregates(std::unique_ptr<Expression>& expr,
+                            SelectStatement& statement) {
+  if (AggregateExpression::IsAggregate(expr->type)) {
+    auto& aggregates = statement.aggregates;
+    size_t index     = 0;
+    while (index < aggregates.size() && !aggregates[index]->Equals(expr.get())) {
+      index++;
+    }
+    auto alias = expr->alias;
+    auto type  = expr->return_type;
+    if (index == aggregates.size()) {
+      aggregates.push_back(std::move(expr));
+    }
+    expr = std::make_unique<ColumnRefExpression>(
+        type, ColumnBinding(statement.aggregate_index, index));
+    expr->alias = alias;
+    return;
+  }
+  if (expr->type == ExpressionType::kWindowAggregate) {
+    // the function of the window is not an aggregate of the query, but its
+    // argument, the partitions and the orders are evaluated per group
+    for (auto& child : expr->children[0]->children) {
+      BindAggregates(child, statement);
+    }
+    for (size_t i = 1; i < expr->children.size(); i++) {
+      BindAggregates(expr->children[i], statement);
+    }
+    return;
+  }
+  for (size_t i = 0; i < statement.groups.size(); i++) {
+    if (statement.groups[i]->Equals(expr.get())) {
+      auto alias = expr->alias;
+      expr       = std::make_unique<ColumnRefExpression>(
+          expr->return_type, ColumnBinding(statement.group_index, i));
+      expr->alias = alias;
+      return;
+    }
+  }
+  if (expr->type == ExpressionType::kColumnRef) {
+    auto& ref = static_cast<ColumnRefExpression&>(*expr);
+    if (ref.depth == 0) {
+      throw BinderException(
+          "Column \"%s\" must appear in the GROUP BY clause or be used in an "
+          "aggregate function",
+          ref.GetName().c_str());
+    }
+    return;
+  }
+  if (dynamic_cast<SubqueryExpression*>(expr.get())) {
+    return;
+  }
+  for (auto& child : expr->children) {
+    BindAggregates(child, statement);
+  }
+}
+
+void Binder::BindWindows(std::unique_ptr<Expression>& expr,
+                         SelectStatement& statement) {
+  if (expr->type == ExpressionType::kWindowAggregate) {
+    auto& windows = statement.windows;
+    size_t index  = 0;
+    while (index < windows.size() && !windows[index]->Equals(expr.get())) {
+      index++;
+    }
+    auto alias = expr->alias;
+    auto type  = expr->return_type;
+    if (index == windows.size()) {
+      windows.push_back(std::move(expr));
+    }
+    expr = std::make_unique<ColumnRefExpression>(
+        type, ColumnBinding(statement.window_index, index));
+    expr->alias = alias;
+    return;
+  }
+  if (dynamic_cast<SubqueryExpression*>(expr.get())) {
+    return;
+  }
+  for (auto& child : expr->children) {
+    BindWindows(child, statement);
+  }
+}
+
+}  // namespace zoomdb
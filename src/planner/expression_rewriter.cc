@@ -0,0 +1,307 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/expression_rewriter.hpp"
+
+#include "common/exception.hpp"
+#include "execution/expression_executor.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/conjunction_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+bool IsConstant(const Expression& expr) {
+  return expr.type == ExpressionType::kValueConstant;
+}
+
+const Value& GetConstant(const Expression& expr) {
+  return static_cast<const ConstantExpression&>(expr).value;
+}
+
+bool IsNullConstant(const Expression& expr) {
+  return IsConstant(expr) && GetConstant(expr).IsNull();
+}
+
+/**
+ * Returns true if the expression is the non-NULL constant value.
+ */
+bool IsConstantValue(const Expression& expr, const Value& value) {
+  return IsConstant(expr) && !GetConstant(expr).IsNull() &&
+         GetConstant(expr) == value;
+}
+
+/**
+ * Replace expr by replacement, which takes over the alias of expr.
+ */
+void Replace(std::unique_ptr<Expression>& expr,
+             std::unique_ptr<Expression> replacement) {
+  replacement->alias = expr->alias;
+  expr               = std::move(replacement);
+}
+
+/**
+ * Replace expr by its child at the given position, if the child has the
+ * same type. Returns true if expr was replaced.
+ */
+bool ReplaceByChild(std::unique_ptr<Expression>& expr, size_t child) {
+  if (expr->children[child]->return_type != expr->return_type) {
+    return false;
+  }
+  Replace(expr, std::move(expr->children[child]));
+  return true;
+}
+
+void ReplaceByConstant(std::unique_ptr<Expression>& expr, Value value) {
+  auto type = expr->return_type;
+  Replace(expr, std::make_unique<ConstantExpression>(std::move(value)));
+  expr->return_type = type;
+}
+
+}  // namespace
+
+std::unique_ptr<LogicalOperator> ExpressionRewriter::Rewrite(
+    std::unique_ptr<LogicalOperator> op) {
+  RewriteOperator(op);
+  return op;
+}
+
+void ExpressionRewriter::RewriteOperator(std::unique_ptr<LogicalOperator>& op) {
+  for (auto& child : op->children) {
+    RewriteOperator(child);
+  }
+  op->EnumerateExpressions(
+      [&](std::unique_ptr<Expression>& expr) { Simplify(expr); });
+  if (op->GetType() == LogicalOperatorType::kFilter) {
+    RewriteFilter(op);
+  }
+}
+
+void ExpressionRewriter::RewriteFilter(std::unique_ptr<LogicalOperator>& op) {
+  // a simplified term may be an AND again, true terms filter nothing
+  std::vector<std::unique_ptr<Expression>> terms;
+  for (auto& expr : op->expressions) {
+    ConjunctionExpression::Split(std::move(expr), terms);
+  }
+  op->expressions.clear();
+  for (auto& term : terms) {
+    if (!IsConstantValue(*term, Value::Boolean(true))) {
+      op->expressions.push_back(std::move(term));
+    }
+  }
+  if (op->expressions.empty()) {
+    op = std::move(op->children[0]);
+  }
+}
+
+void ExpressionRewriter::Simplify(std::unique_ptr<Expression>& expr) {
+  if (auto subquery = dynamic_cast<SubqueryExpression*>(expr.get())) {
+    if (subquery->subquery) {
+      subquery->subquery = Rewrite(std::move(subquery->subquery));
+    }
+    for (auto& child : subquery->children) {
+      Simplify(child);
+    }
+    return;
+  }
+  for (auto& child : expr->children) {
+    Simplify(child);
+  }
+  if (Fold(expr)) {
+    return;
+  }
+  switch (expr->type) {
+    case ExpressionType::kOperatorPlus:
+    case ExpressionType::kOperatorMinus:
+    case ExpressionType::kOperatorMultiply:
+    case ExpressionType::kOperatorDivide:
+    case ExpressionType::kOperatorMod:
+      SimplifyArithmetic(expr);
+      break;
+    case ExpressionType::kCompareEqual:
+    case ExpressionType::kCompareNotEqual:
+    case ExpressionType::kCompareLessThan:
+    case ExpressionType::kCompareGreaterThan:
+    case ExpressionType::kCompareLessThanOrEqualTo:
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+    case ExpressionType::kCompareLike:
+    case ExpressionType::kCompareNotLike:
+      SimplifyComparison(expr);
+      break;
+    case ExpressionType::kConjunctionAnd:
+    case ExpressionType::kConjunctionOr:
+      SimplifyConjunction(expr);
+      break;
+    case ExpressionType::kOperatorNot:
+      SimplifyNot(expr);
+      break;
+    case ExpressionType::kOperatorCoalesce:
+      SimplifyCoalesce(expr);
+      break;
+    case ExpressionType::kOperatorCaseExpr:
+      SimplifyCase(expr);
+      break;
+    default:
+      break;
+  }
+}
+
+bool ExpressionRewriter::Fold(std::unique_ptr<Expression>& expr) {
+  if (IsConstant(*expr) || !expr->IsScalar() || expr->IsAggregate() ||
+      expr->HasSubquery()) {
+    return false;
+  }
+  Vector result(expr->return_type);
+  try {
+    ExpressionExecutor().ExecuteExpression(*expr, result);
+  } catch (Exception&) {
+    // raised when (and if) the expression is evaluated
+    return false;
+  }
+  ReplaceByConstant(expr, result.GetValue(0));
+  return true;
+}
+
+void ExpressionRewriter::SimplifyArithmetic(std::unique_ptr<Expression>& expr) {
+  auto& left  = *expr->children[0];
+  auto& right = *expr->children[1];
+  if (IsNullConstant(left) || IsNullConstant(right)) {
+    ReplaceByConstant(expr, Value(expr->return_type));
+    return;
+  }
+  auto zero = Value::Integer(0);
+  auto one  = Value::Integer(1);
+  // x * 0 is not 0 if x is NULL, so only the identities are removed
+  switch (expr->type) {
+    case ExpressionType::kOperatorPlus:
+      if (IsConstantValue(left, zero)) {
+        ReplaceByChild(expr, 1);
+      } else if (IsConstantValue(right, zero)) {
+        ReplaceByChild(expr, 0);
+      }
+      break;
+    case ExpressionType::kOperatorMinus:
+      if (IsConstantValue(right, zero)) {
+        ReplaceByChild(expr, 0);
+      }
+      break;
+    case ExpressionType::kOperatorMultiply:
+      if (IsConstantValue(left, one)) {
+        ReplaceByChild(expr, 1);
+      } else if (IsConstantValue(right, one)) {
+        ReplaceByChild(expr, 0);
+      }
+      break;
+    case ExpressionType::kOperatorDivide:
+      if (IsConstantValue(right, one)) {
+        ReplaceByChild(expr, 0);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void ExpressionRewriter::SimplifyComparison(std::unique_ptr<Expression>& expr) {
+  if (IsNullConstant(*expr->children[0]) ||
+      IsNullConstant(*expr->children[1])) {
+    ReplaceByConstant(expr, Value(TypeId::kBoolean));
+    return;
+  }
+  // the constant goes to the right: 5 < a becomes a > 5
+  if (IsConstant(*expr->children[0]) && !IsConstant(*expr->children[1]) &&
+      expr->type != ExpressionType::kCompareLike &&
+      expr->type != ExpressionType::kCompareNotLike) {
+    std::swap(expr->children[0], expr->children[1]);
+    expr->type = ComparisonExpression::FlipComparison(expr->type);
+  }
+}
+
+void ExpressionRewriter::SimplifyConjunction(
+    std::unique_ptr<Expression>& expr) {
+  // TRUE is neutral for AND, FALSE for OR; the other one decides the result
+  // even if the other operand is NULL
+  auto is_and   = expr->type == ExpressionType::kConjunctionAnd;
+  auto neutral  = Value::Boolean(is_and);
+  auto dominant = Value::Boolean(!is_and);
+  for (size_t i = 0; i < 2; i++) {
+    auto& child = *expr->children[i];
+    if (IsConstantValue(child, dominant)) {
+      ReplaceByConstant(expr, dominant);
+      return;
+    }
+    if (IsConstantValue(child, neutral)) {
+      ReplaceByChild(expr, 1 - i);
+      return;
+    }
+  }
+}
+
+void ExpressionRewriter::SimplifyNot(std::unique_ptr<Expression>& expr) {
+  auto& child = expr->children[0];
+  switch (child->type) {
+    case ExpressionType::kOperatorNot:
+      Replace(expr, std::move(child->children[0]));
+      break;
+    case ExpressionType::kOperatorIsNull:
+    case ExpressionType::kOperatorIsNotNull:
+      child->type = child->type == ExpressionType::kOperatorIsNull
+                        ? ExpressionType::kOperatorIsNotNull
+                        : ExpressionType::kOperatorIsNull;
+      Replace(expr, std::move(child));
+      break;
+    case ExpressionType::kCompareEqual:
+    case ExpressionType::kCompareNotEqual:
+    case ExpressionType::kCompareLessThan:
+    case ExpressionType::kCompareGreaterThan:
+    case ExpressionType::kCompareLessThanOrEqualTo:
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+    case ExpressionType::kCompareLike:
+    case ExpressionType::kCompareNotLike:
+      // NULL stays NULL, so NOT (a < b) is a >= b
+      child->type = ComparisonExpression::NegateComparison(child->type);
+      Replace(expr, std::move(child));
+      break;
+    default:
+      break;
+  }
+}
+
+void ExpressionRewriter::SimplifyCoalesce(std::unique_ptr<Expression>& expr) {
+  // NULLs are skipped, nothing after the first non-NULL constant is reached
+  std::vector<std::unique_ptr<Expression>> children;
+  for (auto& child : expr->children) {
+    if (IsNullConstant(*child)) {
+      continue;
+    }
+    auto last = IsConstant(*child);
+    children.push_back(std::move(child));
+    if (last) {
+      break;
+    }
+  }
+  expr->children = std::move(children);
+  if (expr->children.empty()) {
+    ReplaceByConstant(expr, Value(expr->return_type));
+  } else if (expr->children.size() == 1) {
+    ReplaceByChild(expr, 0);
+  }
+}
+
+void ExpressionRewriter::SimplifyCase(std::unique_ptr<Expression>& expr) {
+  // CASE WHEN children[0] THEN children[1] ELSE children[2] END
+  auto& check = *expr->children[0];
+  if (!IsConstant(check)) {
+    return;
+  }
+  ReplaceByChild(expr, IsConstantValue(check, Value::Boolean(true)) ? 1 : 2);
+}
+
+}  // namespace zoomdb
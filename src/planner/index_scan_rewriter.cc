@@ -0,0 +1,242 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/index_scan_rewriter.hpp"
+
+#include <algorithm>
+
+#include "common/exception.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/subquery_expression.hpp"
+#include "planner/operator/logical_get.hpp"
+#include "planner/operator/logical_index_scan.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+/**
+ * The range of the first column of an index implied by the comparisons of
+ * a filter, and the positions of these comparisons in the filter.
+ */
+struct IndexRange {
+  Index* index = nullptr;
+  Value lower;
+  bool lower_inclusive = false;
+  Value upper;
+  bool upper_inclusive = false;
+  std::vector<size_t> terms;
+
+  void TightenLower(const Value& value, bool inclusive) {
+    if (lower.IsNull() || value > lower || (value == lower && !inclusive)) {
+      lower           = value;
+      lower_inclusive = inclusive;
+    }
+  }
+
+  void TightenUpper(const Value& value, bool inclusive) {
+    if (upper.IsNull() || value < upper || (value == upper && !inclusive)) {
+      upper           = value;
+      upper_inclusive = inclusive;
+    }
+  }
+
+  bool IsPoint() const {
+    return !lower.IsNull() && !upper.IsNull() && lower_inclusive &&
+           upper_inclusive && lower == upper;
+  }
+};
+
+/**
+ * Cast the constant to the type of the column, returns false if the cast
+ * does not preserve the value (e.g. 2.5 compared with an INTEGER column).
+ */
+bool CastExactly(const Value& value, TypeId type, Value& result) {
+  if (value.IsNull()) {
+    return false;
+  }
+  try {
+    result = value.CastAs(type);
+  } catch (Exception&) {
+    return false;
+  }
+  return Value::Compare(result, value) == 0;
+}
+
+/**
+ * Add the comparison to the range if it compares the column with the given
+ * binding with a constant.
+ */
+void AddToRange(Expression& expr, const ColumnBinding& binding, TypeId type,
+                size_t term, IndexRange& range) {
+  auto comparison = expr.type;
+  if (!ComparisonExpression::IsComparison(comparison) ||
+      comparison == ExpressionType::kCompareNotEqual ||
+      expr.children.size() != 2) {
+    return;
+  }
+  auto left  = expr.children[0].get();
+  auto right = expr.children[1].get();
+  if (left->type == ExpressionType::kValueConstant) {
+    std::swap(left, right);
+    comparison = ComparisonExpression::FlipComparison(comparison);
+  }
+  if (left->type != ExpressionType::kColumnRef ||
+      right->type != ExpressionType::kValueConstant) {
+    return;
+  }
+  auto& ref = static_cast<ColumnRefExpression&>(*left);
+  Value value;
+  if (ref.depth != 0 || ref.binding != binding ||
+      !CastExactly(static_cast<ConstantExpression&>(*right).value, type,
+                   value)) {
+    return;
+  }
+  switch (comparison) {
+    case ExpressionType::kCompareEqual:
+      range.TightenLower(value, true);
+      range.TightenUpper(value, true);
+      break;
+    case ExpressionType::kCompareGreaterThan:
+      range.TightenLower(value, false);
+      break;
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      range.TightenLower(value, true);
+      break;
+    case ExpressionType::kCompareLessThan:
+      range.TightenUpper(value, false);
+      break;
+    case ExpressionType::kCompareLessThanOrEqualTo:
+      range.TightenUpper(value, true);
+      break;
+    default:
+      return;
+  }
+  range.terms.push_back(term);
+}
+
+/**
+ * Estimate the fraction of the rows of the table in the range.
+ */
+double EstimateSelectivity(const DataTable& table, size_t column,
+                           const IndexRange& range) {
+  if (range.IsPoint()) {
+    return table.EstimateSelectivity(column, ExpressionType::kCompareEqual,
+                                     range.lower);
+  }
+  double result = 1;
+  if (!range.lower.IsNull()) {
+    result = table.EstimateSelectivity(
+        column,
+        range.lower_inclusive ? ExpressionType::kCompareGreaterThanOrEqualTo
+                              : ExpressionType::kCompareGreaterThan,
+        range.lower);
+  }
+  if (!range.upper.IsNull()) {
+    // the rows below the upper bound, minus those also below the lower one
+    result += table.EstimateSelectivity(
+                  column,
+                  range.upper_inclusive
+                      ? ExpressionType::kCompareLessThanOrEqualTo
+                      : ExpressionType::kCompareLessThan,
+                  range.upper) -
+              1;
+  }
+  return std::max(result, 0.0);
+}
+
+void RewriteSubqueries(Expression& expr, IndexScanRewriter& rewriter) {
+  auto subquery = dynamic_cast<SubqueryExpression*>(&expr);
+  if (subquery && subquery->subquery) {
+    subquery->subquery = rewriter.Rewrite(std::move(subquery->subquery));
+  }
+  expr.EnumerateChildren(
+      [&](Expression& child) { RewriteSubqueries(child, rewriter); });
+}
+
+}  // namespace
+
+std::unique_ptr<LogicalOperator> IndexScanRewriter::Rewrite(
+    std::unique_ptr<LogicalOperator> op) {
+  RewriteOperator(op);
+  return op;
+}
+
+void IndexScanRewriter::RewriteOperator(std::unique_ptr<LogicalOperator>& op) {
+  for (auto& child : op->children) {
+    RewriteOperator(child);
+  }
+  op->EnumerateExpressions([&](std::unique_ptr<Expression>& expr) {
+    RewriteSubqueries(*expr, *this);
+  });
+  if (op->GetType() == LogicalOperatorType::kFilter &&
+      op->children[0]->GetType() == LogicalOperatorType::kGet) {
+    RewriteFilter(op);
+  }
+}
+
+void IndexScanRewriter::RewriteFilter(std::unique_ptr<LogicalOperator>& op) {
+  auto& get = static_cast<LogicalGet&>(*op->children[0]);
+  if (!get.table) {
+    return;
+  }
+
+  // find the index with the most selective range
+  IndexRange best;
+  double best_selectivity = kMaxSelectivity;
+  for (auto index : get.table->GetIndexes()) {
+    auto column   = index->GetColumnIds()[0];
+    auto position = std::find(get.column_ids.begin(), get.column_ids.end(),
+                              column) -
+                    get.column_ids.begin();
+    if (static_cast<size_t>(position) == get.column_ids.size()) {
+      continue;
+    }
+    IndexRange range;
+    range.index = index;
+    ColumnBinding binding(get.table_index, static_cast<size_t>(position));
+    auto type = get.table->GetTypes()[column];
+    for (size_t i = 0; i < op->expressions.size(); i++) {
+      AddToRange(*op->expressions[i], binding, type, i, range);
+    }
+    if (range.terms.empty()) {
+      continue;
+    }
+    auto selectivity = index->IsUnique() && index->GetColumnIds().size() == 1 &&
+                               range.IsPoint()
+                           ? 0.0
+                           : EstimateSelectivity(*get.table, column, range);
+    if (selectivity <= best_selectivity) {
+      best             = std::move(range);
+      best_selectivity = selectivity;
+    }
+  }
+  if (best.terms.empty()) {
+    return;
+  }
+
+  auto scan = std::make_unique<LogicalIndexScan>(
+      get.table, get.table_name, get.table_index, get.column_ids, *best.index);
+  scan->lower           = best.lower;
+  scan->lower_inclusive = best.lower_inclusive;
+  scan->upper           = best.upper;
+  scan->upper_inclusive = best.upper_inclusive;
+  for (auto i = best.terms.size(); i > 0; i--) {
+    op->expressions.erase(op->expressions.begin() +
+                          static_cast<std::ptrdiff_t>(best.terms[i - 1]));
+  }
+  if (op->expressions.empty()) {
+    op = std::move(scan);
+  } else {
+    op->children[0] = std::move(scan);
+  }
+}
+
+}  // namespace zoomdb
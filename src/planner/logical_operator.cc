@@ -0,0 +1,92 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/logical_operator.hpp"
+
+#include "common/string_util.hpp"
+
+namespace zoomdb {
+
+std::string LogicalOperatorTypeToString(LogicalOperatorType type) {
+  switch (type) {
+    case LogicalOperatorType::kGet:
+      return "GET";
+    case LogicalOperatorType::kFilter:
+      return "FILTER";
+    case LogicalOperatorType::kProjection:
+      return "PROJECTION";
+    case LogicalOperatorType::kAggregateAndGroupBy:
+      return "AGGREGATE_AND_GROUP_BY";
+    case LogicalOperatorType::kJoin:
+      return "JOIN";
+    case LogicalOperatorType::kCrossProduct:
+      return "CROSS_PRODUCT";
+    case LogicalOperatorType::kIndexScan:
+      return "INDEX_SCAN";
+    case LogicalOperatorType::kInsert:
+      return "INSERT";
+    case LogicalOperatorType::kCopyFromFile:
+      return "COPY_FROM_FILE";
+    case LogicalOperatorType::kCopyToFile:
+      return "COPY_TO_FILE";
+    case LogicalOperatorType::kParquetScan:
+      return "PARQUET_SCAN";
+    case LogicalOperatorType::kUpdate:
+      return "UPDATE";
+    case LogicalOperatorType::kDelete:
+      return "DELETE";
+    case LogicalOperatorType::kWindow:
+      return "WINDOW";
+    case LogicalOperatorType::kDistinct:
+      return "DISTINCT";
+    default:
+      return "INVALID";
+  }
+}
+
+LogicalOperator::LogicalOperator(LogicalOperatorType operator_type)
+    : type_(operator_type) {}
+
+void LogicalOperator::EnumerateExpressions(const ExpressionCallback& callback) {
+  for (auto& expr : expressions) {
+    callback(expr);
+  }
+}
+
+void LogicalOperator::ResolveOperatorTypes() {
+  for (auto& child : children) {
+    child->ResolveOperatorTypes();
+  }
+  types.clear();
+  ResolveTypes();
+}
+
+std::string LogicalOperator::ParamsToString() const {
+  std::string result;
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result += (i == 0 ? "" : ", ") + expressions[i]->ToString();
+  }
+  return result;
+}
+
+std::string LogicalOperator::ToString() const {
+  std::string result = LogicalOperatorTypeToString(type_);
+  auto params        = ParamsToString();
+  if (!params.empty()) {
+    result += "[" + params + "]";
+  }
+  for (auto& child : children) {
+    result += "\n" + StringUtil::Prefix(child->ToString(), "  ");
+  }
+  return result;
+}
+
+void LogicalOperator::AddChild(std::unique_ptr<LogicalOperator> child) {
+  children.push_back(std::move(child));
+}
+
+}  // namespace zoomdb
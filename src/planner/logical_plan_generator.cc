@@ -0,0 +1,301 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/logical_plan_generator.hpp"
+
+#include <functional>
+#include <unordered_set>
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+#include "common/exception.hpp"
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/conjunction_expression.hpp"
+#include "parser/tableref/base_table_ref.hpp"
+#include "parser/tableref/cross_product_ref.hpp"
+#include "parser/tableref/join_ref.hpp"
+#include "parser/tableref/subquery_ref.hpp"
+#include "parser/tableref/table_function_ref.hpp"
+#include "planner/operator/logical_aggregate.hpp"
+#include "planner/operator/logical_copy_from_file.hpp"
+#include "planner/operator/logical_copy_to_file.hpp"
+#include "planner/operator/logical_cross_product.hpp"
+#include "planner/operator/logical_delete.hpp"
+#include "planner/operator/logical_distinct.hpp"
+#include "planner/operator/logical_filter.hpp"
+#include "planner/operator/logical_get.hpp"
+#include "planner/operator/logical_insert.hpp"
+#include "planner/operator/logical_join.hpp"
+#include "planner/operator/logical_parquet_scan.hpp"
+#include "planner/operator/logical_projection.hpp"
+#include "planner/operator/logical_update.hpp"
+#include "planner/operator/logical_window.hpp"
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+using TableSet = std::unordered_set<size_t>;
+
+TableSet GetTables(const LogicalOperator& op) {
+  TableSet result;
+  for (auto& binding : op.GetColumnBindings()) {
+    result.insert(binding.table_index);
+  }
+  return result;
+}
+
+/**
+ * Collect the tables referenced by the expression into tables. Returns
+ * false if it references a column of an enclosing query or contains a
+ * subquery.
+ */
+bool CollectTables(const Expression& expr, TableSet& tables) {
+  if (expr.HasSubquery()) {
+    return false;
+  }
+  if (expr.type == ExpressionType::kColumnRef) {
+    auto& ref = static_cast<const ColumnRefExpression&>(expr);
+    tables.insert(ref.binding.table_index);
+    return ref.depth == 0;
+  }
+  bool result = true;
+  expr.EnumerateChildren([&](const Expression& child) {
+    result = CollectTables(child, tables) && result;
+  });
+  return result;
+}
+
+bool IsSubset(const TableSet& tables, const TableSet& of) {
+  for (auto table : tables) {
+    if (of.count(table) == 0) {
+      return false;
+    }
+  }
+  return !tables.empty();
+}
+
+/**
+ * Returns true if the expression compares a column with a constant.
+ */
+bool IsColumnComparison(const Expression& expr) {
+  if (!ComparisonExpression::IsComparison(expr.type) ||
+      expr.type == ExpressionType::kCompareLike ||
+      expr.type == ExpressionType::kCompareNotLike ||
+      expr.type == ExpressionType::kCompareDistinctFrom) {
+    return false;
+  }
+  auto left  = expr.children[0]->type;
+  auto right = expr.children[1]->type;
+  return (left == ExpressionType::kColumnRef &&
+          right == ExpressionType::kValueConstant) ||
+         (left == ExpressionType::kValueConstant &&
+          right == ExpressionType::kColumnRef);
+}
+
+}  // namespace
+
+std::unique_ptr<LogicalOperator> LogicalPlanGenerator::CreatePlan(
+    SelectStatement& statement) {
+  std::unique_ptr<LogicalOperator> root;
+  if (statement.from_table) {
+    root = CreatePlan(*statement.from_table);
+  }
+  if (statement.where_clause) {
+    if (!root) {
+      throw NotImplementationException(
+          "WHERE without a FROM clause is not supported");
+    }
+    auto filter = std::make_unique<LogicalFilter>(
+        std::move(statement.where_clause));
+    if (root->GetType() == LogicalOperatorType::kParquetScan) {
+      // let the scan skip the row groups none of whose rows qualify
+      for (auto& expr : filter->expressions) {
+        if (IsColumnComparison(*expr)) {
+          root->expressions.push_back(expr->Copy());
+        }
+      }
+    }
+    filter->AddChild(std::move(root));
+    root = std::move(filter);
+  }
+  if (statement.aggregated) {
+    auto aggregate = std::make_unique<LogicalAggregate>(
+        statement.group_index, statement.aggregate_index,
+        std::move(statement.aggregates));
+    aggregate->groups = std::move(statement.groups);
+    aggregate->AddChild(std::move(root));
+    root = std::move(aggregate);
+    if (statement.having) {
+      auto having = std::make_unique<LogicalFilter>(std::move(statement.having));
+      having->AddChild(std::move(root));
+      root = std::move(having);
+    }
+  }
+  if (!statement.windows.empty()) {
+    auto window = std::make_unique<LogicalWindow>(
+        statement.window_index, std::move(statement.windows));
+    window->AddChild(std::move(root));
+    root = std::move(window);
+  }
+  auto projection = std::make_unique<LogicalProjection>(
+      statement.projection_index, std::move(statement.select_list));
+  if (root) {
+    projection->AddChild(std::move(root));
+  }
+  if (statement.distinct) {
+    auto distinct = std::make_unique<LogicalDistinct>();
+    distinct->AddChild(std::move(projection));
+    return distinct;
+  }
+  return projection;
+}
+
+std::unique_ptr<LogicalOperator> LogicalPlanGenerator::CreatePlan(
+    InsertStatement& statement) {
+  auto insert = std::make_unique<LogicalInsert>(statement.table_entry,
+                                                statement.column_ids);
+  insert->insert_values = std::move(statement.values);
+  if (statement.select) {
+    insert->AddChild(CreatePlan(*statement.select));
+  }
+  return insert;
+}
+
+std::unique_ptr<LogicalOperator> LogicalPlanGenerator::CreatePlan(
+    UpdateStatement& statement) {
+  auto update = std::make_unique<LogicalUpdate>(statement.table_entry,
+                                                statement.column_ids);
+  update->AddChild(CreatePlan(*statement.select));
+  return update;
+}
+
+std::unique_ptr<LogicalOperator> LogicalPlanGenerator::CreatePlan(
+    DeleteStatement& statement) {
+  auto result = std::make_unique<LogicalDelete>(statement.table_entry);
+  result->AddChild(CreatePlan(*statement.select));
+  return result;
+}
+
+std::unique_ptr<LogicalOperator> LogicalPlanGenerator::CreatePlan(
+    CopyStatement& statement) {
+  if (statement.info.is_from) {
+    return std::make_unique<LogicalCopyFromFile>(statement.table_entry,
+                                                 statement.info);
+  }
+  auto copy = std::make_unique<LogicalCopyToFile>(statement.info,
+                                                  statement.select->names);
+  copy->AddChild(CreatePlan(*statement.select));
+  return copy;
+}
+
+std::unique_ptr<LogicalOperator> LogicalPlanGenerator::CreatePlan(
+    TableRef& ref) {
+  switch (ref.type) {
+    case TableReferenceType::kBaseTable: {
+      auto& base = static_cast<BaseTableRef&>(ref);
+      if (base.column_ids.empty()) {
+        // no column is referenced, e.g. SELECT count(*), but the scan still
+        // has to produce the rows
+        base.column_ids.push_back(0);
+      }
+      return std::make_unique<LogicalGet>(base.table->storage.get(),
+                                          base.table->name, base.table_index,
+                                          base.column_ids);
+    }
+    case TableReferenceType::kTableFunction: {
+      auto& function = static_cast<TableFunctionRef&>(ref);
+      if (function.column_ids.empty()) {
+        function.column_ids.push_back(0);
+      }
+      return std::make_unique<LogicalParquetScan>(
+          std::move(function.reader), function.table_index,
+          function.column_ids, function.prefetch_depth);
+    }
+    case TableReferenceType::kSubquery:
+      return CreatePlan(*static_cast<SubqueryRef&>(ref).subquery);
+    case TableReferenceType::kCrossProduct: {
+      auto& cross = static_cast<CrossProductRef&>(ref);
+      auto result = std::make_unique<LogicalCrossProduct>();
+      result->AddChild(CreatePlan(*cross.left));
+      result->AddChild(CreatePlan(*cross.right));
+      return result;
+    }
+    case TableReferenceType::kJoin:
+      break;
+    default:
+      throw NotImplementationException("Unsupported table reference");
+  }
+
+  auto& join  = static_cast<JoinRef&>(ref);
+  auto left   = CreatePlan(*join.left);
+  auto right  = CreatePlan(*join.right);
+  auto result = std::make_unique<LogicalJoin>(join.join_type);
+  auto left_tables  = GetTables(*left);
+  auto right_tables = GetTables(*right);
+
+  // comparisons between an expression of the left side and one of the
+  // right side are join conditions
+  std::vector<std::unique_ptr<Expression>> terms;
+  std::vector<std::unique_ptr<Expression>> remaining;
+  ConjunctionExpression::Split(std::move(join.condition), terms);
+  for (auto& term : terms) {
+    TableSet left_side;
+    TableSet right_side;
+    if (!ComparisonExpression::IsComparison(term->type) ||
+        term->type == ExpressionType::kCompareLike ||
+        term->type == ExpressionType::kCompareNotLike ||
+        term->type == ExpressionType::kCompareDistinctFrom ||
+        !CollectTables(*term->children[0], left_side) ||
+        !CollectTables(*term->children[1], right_side)) {
+      remaining.push_back(std::move(term));
+      continue;
+    }
+    auto comparison = term->type;
+    if (IsSubset(left_side, right_tables) && IsSubset(right_side, left_tables)) {
+      std::swap(term->children[0], term->children[1]);
+      std::swap(left_side, right_side);
+      comparison = ComparisonExpression::FlipComparison(comparison);
+    }
+    if (!IsSubset(left_side, left_tables) ||
+        !IsSubset(right_side, right_tables)) {
+      remaining.push_back(std::move(term));
+      continue;
+    }
+    JoinCondition condition;
+    condition.left       = std::move(term->children[0]);
+    condition.right      = std::move(term->children[1]);
+    condition.comparison = comparison;
+    result->conditions.push_back(std::move(condition));
+  }
+
+  if (!remaining.empty() && join.join_type != JoinType::kInner) {
+    throw NotImplementationException(
+        "The condition of a %s JOIN may only compare the two sides",
+        JoinTypeToString(join.join_type).c_str());
+  }
+  std::unique_ptr<LogicalOperator> plan;
+  if (result->conditions.empty() && join.join_type == JoinType::kInner) {
+    plan = std::make_unique<LogicalCrossProduct>();
+  } else {
+    plan = std::move(result);
+  }
+  plan->AddChild(std::move(left));
+  plan->AddChild(std::move(right));
+  if (!remaining.empty()) {
+    auto filter = std::make_unique<LogicalFilter>();
+    for (auto& term : remaining) {
+      filter->AddFilter(std::move(term));
+    }
+    filter->AddChild(std::move(plan));
+    plan = std::move(filter);
+  }
+  return plan;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,60 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_aggregate.hpp"
+
+namespace zoomdb {
+
+LogicalAggregate::LogicalAggregate(
+    size_t group_table_index, size_t aggregate_table_index,
+    std::vector<std::unique_ptr<Expression>> aggregates)
+    : LogicalOperator(LogicalOperatorType::kAggregateAndGroupBy),
+      group_index(group_table_index),
+      aggregate_index(aggregate_table_index) {
+  expressions = std::move(aggregates);
+}
+
+std::vector<ColumnBinding> LogicalAggregate::GetColumnBindings() const {
+  std::vector<ColumnBinding> result;
+  for (size_t i = 0; i < groups.size(); i++) {
+    result.emplace_back(group_index, i);
+  }
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result.emplace_back(aggregate_index, i);
+  }
+  return result;
+}
+
+void LogicalAggregate::EnumerateExpressions(
+    const ExpressionCallback& callback) {
+  for (auto& group : groups) {
+    callback(group);
+  }
+  LogicalOperator::EnumerateExpressions(callback);
+}
+
+std::string LogicalAggregate::ParamsToString() const {
+  std::string result = LogicalOperator::ParamsToString();
+  if (!groups.empty()) {
+    result += " GROUP BY ";
+    for (size_t i = 0; i < groups.size(); i++) {
+      result += (i == 0 ? "" : ", ") + groups[i]->ToString();
+    }
+  }
+  return result;
+}
+
+void LogicalAggregate::ResolveTypes() {
+  for (auto& group : groups) {
+    types.push_back(group->return_type);
+  }
+  for (auto& expr : expressions) {
+    types.push_back(expr->return_type);
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,30 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_copy_from_file.hpp"
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace zoomdb {
+
+LogicalCopyFromFile::LogicalCopyFromFile(TableCatalogEntry* table_entry,
+                                         CopyInfo copy_info)
+    : LogicalOperator(LogicalOperatorType::kCopyFromFile),
+      table(table_entry),
+      info(std::move(copy_info)) {}
+
+std::vector<ColumnBinding> LogicalCopyFromFile::GetColumnBindings() const {
+  return {};
+}
+
+std::string LogicalCopyFromFile::ParamsToString() const {
+  return table->name + " " + info.file_path;
+}
+
+void LogicalCopyFromFile::ResolveTypes() { types.push_back(TypeId::kBigInt); }
+
+}  // namespace zoomdb
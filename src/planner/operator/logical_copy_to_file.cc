@@ -0,0 +1,28 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_copy_to_file.hpp"
+
+namespace zoomdb {
+
+LogicalCopyToFile::LogicalCopyToFile(CopyInfo copy_info,
+                                     std::vector<std::string> column_names)
+    : LogicalOperator(LogicalOperatorType::kCopyToFile),
+      info(std::move(copy_info)),
+      names(std::move(column_names)) {}
+
+std::vector<ColumnBinding> LogicalCopyToFile::GetColumnBindings() const {
+  return {};
+}
+
+std::string LogicalCopyToFile::ParamsToString() const {
+  return info.file_path;
+}
+
+void LogicalCopyToFile::ResolveTypes() { types.push_back(TypeId::kBigInt); }
+
+}  // namespace zoomdb
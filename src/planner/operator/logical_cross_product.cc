@@ -0,0 +1,28 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_cross_product.hpp"
+
+namespace zoomdb {
+
+LogicalCrossProduct::LogicalCrossProduct()
+    : LogicalOperator(LogicalOperatorType::kCrossProduct) {}
+
+std::vector<ColumnBinding> LogicalCrossProduct::GetColumnBindings() const {
+  auto result = children[0]->GetColumnBindings();
+  auto right  = children[1]->GetColumnBindings();
+  result.insert(result.end(), right.begin(), right.end());
+  return result;
+}
+
+void LogicalCrossProduct::ResolveTypes() {
+  types = children[0]->types;
+  types.insert(types.end(), children[1]->types.begin(),
+               children[1]->types.end());
+}
+
+}  // namespace zoomdb
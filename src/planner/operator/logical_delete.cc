@@ -0,0 +1,25 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_delete.hpp"
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace zoomdb {
+
+LogicalDelete::LogicalDelete(TableCatalogEntry* table_entry)
+    : LogicalOperator(LogicalOperatorType::kDelete), table(table_entry) {}
+
+std::vector<ColumnBinding> LogicalDelete::GetColumnBindings() const {
+  return {};
+}
+
+std::string LogicalDelete::ParamsToString() const { return table->name; }
+
+void LogicalDelete::ResolveTypes() { types.push_back(TypeId::kBigInt); }
+
+}  // namespace zoomdb
@@ -0,0 +1,21 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_distinct.hpp"
+
+namespace zoomdb {
+
+LogicalDistinct::LogicalDistinct()
+    : LogicalOperator(LogicalOperatorType::kDistinct) {}
+
+std::vector<ColumnBinding> LogicalDistinct::GetColumnBindings() const {
+  return children[0]->GetColumnBindings();
+}
+
+void LogicalDistinct::ResolveTypes() { types = children[0]->types; }
+
+}  // namespace zoomdb
@@ -0,0 +1,31 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_filter.hpp"
+
+#include "parser/expression/conjunction_expression.hpp"
+
+namespace zoomdb {
+
+LogicalFilter::LogicalFilter(std::unique_ptr<Expression> expression)
+    : LogicalOperator(LogicalOperatorType::kFilter) {
+  if (expression) {
+    AddFilter(std::move(expression));
+  }
+}
+
+std::vector<ColumnBinding> LogicalFilter::GetColumnBindings() const {
+  return children[0]->GetColumnBindings();
+}
+
+void LogicalFilter::AddFilter(std::unique_ptr<Expression> expression) {
+  ConjunctionExpression::Split(std::move(expression), expressions);
+}
+
+void LogicalFilter::ResolveTypes() { types = children[0]->types; }
+
+}  // namespace zoomdb
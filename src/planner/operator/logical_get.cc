@@ -0,0 +1,40 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_get.hpp"
+
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+LogicalGet::LogicalGet(DataTable* data_table, std::string name, size_t index,
+                       std::vector<size_t> columns)
+    : LogicalOperator(LogicalOperatorType::kGet),
+      table(data_table),
+      table_name(std::move(name)),
+      table_index(index),
+      column_ids(std::move(columns)) {}
+
+std::vector<ColumnBinding> LogicalGet::GetColumnBindings() const {
+  std::vector<ColumnBinding> result;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    result.emplace_back(table_index, i);
+  }
+  return result;
+}
+
+std::string LogicalGet::ParamsToString() const {
+  return table_name + " #" + std::to_string(table_index);
+}
+
+void LogicalGet::ResolveTypes() {
+  for (auto column : column_ids) {
+    types.push_back(table->GetColumnType(column));
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,52 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_index_scan.hpp"
+
+#include "storage/data_table.hpp"
+
+namespace zoomdb {
+
+LogicalIndexScan::LogicalIndexScan(DataTable* data_table, std::string name,
+                                   size_t binding_index,
+                                   std::vector<size_t> columns,
+                                   Index& scan_index)
+    : LogicalOperator(LogicalOperatorType::kIndexScan),
+      table(data_table),
+      table_name(std::move(name)),
+      table_index(binding_index),
+      column_ids(std::move(columns)),
+      index(scan_index),
+      lower_inclusive(false),
+      upper_inclusive(false) {}
+
+std::vector<ColumnBinding> LogicalIndexScan::GetColumnBindings() const {
+  std::vector<ColumnBinding> result;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    result.emplace_back(table_index, i);
+  }
+  return result;
+}
+
+std::string LogicalIndexScan::ParamsToString() const {
+  std::string result = table_name + " #" + std::to_string(table_index) + " " +
+                       index.GetName() + " ";
+  result += lower.IsNull() ? "(-inf"
+                           : (lower_inclusive ? "[" : "(") + lower.ToString();
+  result += ", ";
+  result += upper.IsNull() ? "+inf)"
+                           : upper.ToString() + (upper_inclusive ? "]" : ")");
+  return result;
+}
+
+void LogicalIndexScan::ResolveTypes() {
+  for (auto column : column_ids) {
+    types.push_back(table->GetColumnType(column));
+  }
+}
+
+}  // namespace zoomdb
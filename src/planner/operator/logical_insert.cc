@@ -0,0 +1,36 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_insert.hpp"
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace zoomdb {
+
+LogicalInsert::LogicalInsert(TableCatalogEntry* table_entry,
+                             std::vector<size_t> columns)
+    : LogicalOperator(LogicalOperatorType::kInsert),
+      table(table_entry),
+      column_ids(std::move(columns)) {}
+
+std::vector<ColumnBinding> LogicalInsert::GetColumnBindings() const {
+  return {};
+}
+
+void LogicalInsert::EnumerateExpressions(const ExpressionCallback& callback) {
+  for (auto& row : insert_values) {
+    for (auto& expr : row) {
+      callback(expr);
+    }
+  }
+}
+
+std::string LogicalInsert::ParamsToString() const { return table->name; }
+
+void LogicalInsert::ResolveTypes() { types.push_back(TypeId::kBigInt); }
+
+}  // namespace zoomdb
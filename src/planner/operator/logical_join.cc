@@ -0,0 +1,75 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_join.hpp"
+
+#include "parser/expression/comparison_expression.hpp"
+
+namespace zoomdb {
+
+LogicalJoin::LogicalJoin(JoinType type)
+    : LogicalOperator(LogicalOperatorType::kJoin),
+      join_type(type),
+      mark_index(ColumnBinding::kInvalidIndex) {}
+
+std::vector<ColumnBinding> LogicalJoin::GetColumnBindings() const {
+  auto result = children[0]->GetColumnBindings();
+  switch (join_type) {
+    case JoinType::kSemi:
+    case JoinType::kAnti:
+      break;
+    case JoinType::kMark:
+      result.emplace_back(mark_index, 0);
+      break;
+    default: {
+      auto right = children[1]->GetColumnBindings();
+      result.insert(result.end(), right.begin(), right.end());
+      break;
+    }
+  }
+  return result;
+}
+
+void LogicalJoin::EnumerateExpressions(const ExpressionCallback& callback) {
+  LogicalOperator::EnumerateExpressions(callback);
+  for (auto& cond : conditions) {
+    callback(cond.left);
+    callback(cond.right);
+  }
+}
+
+std::string LogicalJoin::ParamsToString() const {
+  std::string result = JoinTypeToString(join_type);
+  for (size_t i = 0; i < conditions.size(); i++) {
+    auto& cond = conditions[i];
+    result += (i == 0 ? " " : " AND ") + cond.left->ToString() + " " +
+              ComparisonExpression::ComparisonToString(cond.comparison) + " " +
+              cond.right->ToString();
+  }
+  if (join_type == JoinType::kMark) {
+    result += " -> #" + std::to_string(mark_index);
+  }
+  return result;
+}
+
+void LogicalJoin::ResolveTypes() {
+  types = children[0]->types;
+  switch (join_type) {
+    case JoinType::kSemi:
+    case JoinType::kAnti:
+      break;
+    case JoinType::kMark:
+      types.push_back(TypeId::kBoolean);
+      break;
+    default:
+      types.insert(types.end(), children[1]->types.begin(),
+                   children[1]->types.end());
+      break;
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,43 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_parquet_scan.hpp"
+
+namespace zoomdb {
+
+LogicalParquetScan::LogicalParquetScan(
+    std::shared_ptr<const ParquetReader> parquet_reader, size_t index,
+    std::vector<size_t> columns, size_t prefetch)
+    : LogicalOperator(LogicalOperatorType::kParquetScan),
+      reader(std::move(parquet_reader)),
+      table_index(index),
+      column_ids(std::move(columns)),
+      prefetch_depth(prefetch) {}
+
+std::vector<ColumnBinding> LogicalParquetScan::GetColumnBindings() const {
+  std::vector<ColumnBinding> result;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    result.emplace_back(table_index, i);
+  }
+  return result;
+}
+
+std::string LogicalParquetScan::ParamsToString() const {
+  std::string result = "#" + std::to_string(table_index);
+  for (auto& expr : expressions) {
+    result += " " + expr->ToString();
+  }
+  return result;
+}
+
+void LogicalParquetScan::ResolveTypes() {
+  for (auto column : column_ids) {
+    types.push_back(reader->GetTypes()[column]);
+  }
+}
+
+}  // namespace zoomdb
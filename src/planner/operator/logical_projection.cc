@@ -0,0 +1,37 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_projection.hpp"
+
+namespace zoomdb {
+
+LogicalProjection::LogicalProjection(
+    size_t index, std::vector<std::unique_ptr<Expression>> select_list)
+    : LogicalOperator(LogicalOperatorType::kProjection), table_index(index) {
+  expressions = std::move(select_list);
+}
+
+std::vector<ColumnBinding> LogicalProjection::GetColumnBindings() const {
+  std::vector<ColumnBinding> result;
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result.emplace_back(table_index, i);
+  }
+  return result;
+}
+
+std::string LogicalProjection::ParamsToString() const {
+  return "#" + std::to_string(table_index) + ": " +
+         LogicalOperator::ParamsToString();
+}
+
+void LogicalProjection::ResolveTypes() {
+  for (auto& expr : expressions) {
+    types.push_back(expr->return_type);
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,28 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_update.hpp"
+
+#include "catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace zoomdb {
+
+LogicalUpdate::LogicalUpdate(TableCatalogEntry* table_entry,
+                             std::vector<size_t> columns)
+    : LogicalOperator(LogicalOperatorType::kUpdate),
+      table(table_entry),
+      column_ids(std::move(columns)) {}
+
+std::vector<ColumnBinding> LogicalUpdate::GetColumnBindings() const {
+  return {};
+}
+
+std::string LogicalUpdate::ParamsToString() const { return table->name; }
+
+void LogicalUpdate::ResolveTypes() { types.push_back(TypeId::kBigInt); }
+
+}  // namespace zoomdb
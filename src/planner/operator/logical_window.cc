@@ -0,0 +1,34 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/operator/logical_window.hpp"
+
+namespace zoomdb {
+
+LogicalWindow::LogicalWindow(size_t window_table_index,
+                             std::vector<std::unique_ptr<Expression>> windows)
+    : LogicalOperator(LogicalOperatorType::kWindow),
+      window_index(window_table_index) {
+  expressions = std::move(windows);
+}
+
+std::vector<ColumnBinding> LogicalWindow::GetColumnBindings() const {
+  auto result = children[0]->GetColumnBindings();
+  for (size_t i = 0; i < expressions.size(); i++) {
+    result.emplace_back(window_index, i);
+  }
+  return result;
+}
+
+void LogicalWindow::ResolveTypes() {
+  types = children[0]->types;
+  for (auto& expr : expressions) {
+    types.push_back(expr->return_type);
+  }
+}
+
+}  // namespace zoomdb
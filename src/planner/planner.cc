@@ -0,0 +1,71 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/planner.hpp"
+
+#include "common/exception.hpp"
+#include "planner/binder.hpp"
+#include "planner/expression_rewriter.hpp"
+#include "planner/index_scan_rewriter.hpp"
+#include "planner/logical_plan_generator.hpp"
+#include "planner/subquery_rewriter.hpp"
+
+namespace zoomdb {
+
+Planner::Planner(Catalog& catalog, uint64_t timestamp,
+                 ParquetFileCache* parquet_cache)
+    : catalog_(catalog), timestamp_(timestamp), parquet_cache_(parquet_cache) {}
+
+void Planner::CreatePlan(SQLStatement& statement) {
+  Binder binder(catalog_, timestamp_, parquet_cache_);
+  LogicalPlanGenerator generator;
+  switch (statement.type) {
+    case StatementType::kSelect: {
+      auto& select = static_cast<SelectStatement&>(statement);
+      binder.Bind(select);
+      names = select.names;
+      plan  = generator.CreatePlan(select);
+      break;
+    }
+    case StatementType::kInsert: {
+      auto& insert = static_cast<InsertStatement&>(statement);
+      binder.Bind(insert);
+      names = {"Count"};
+      plan  = generator.CreatePlan(insert);
+      break;
+    }
+    case StatementType::kUpdate: {
+      auto& update = static_cast<UpdateStatement&>(statement);
+      binder.Bind(update);
+      names = {"Count"};
+      plan  = generator.CreatePlan(update);
+      break;
+    }
+    case StatementType::kDelete: {
+      auto& del = static_cast<DeleteStatement&>(statement);
+      binder.Bind(del);
+      names = {"Count"};
+      plan  = generator.CreatePlan(del);
+      break;
+    }
+    case StatementType::kCopy: {
+      auto& copy = static_cast<CopyStatement&>(statement);
+      binder.Bind(copy);
+      names = {"Count"};
+      plan  = generator.CreatePlan(copy);
+      break;
+    }
+    default:
+      throw NotImplementationException("Cannot plan statement of type %d",
+                                       static_cast<int>(statement.type));
+  }
+  plan = ExpressionRewriter().Rewrite(std::move(plan));
+  plan = SubqueryRewriter().Rewrite(std::move(plan));
+  plan = IndexScanRewriter().Rewrite(std::move(plan));
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,633 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "planner/subquery_rewriter.hpp"
+
+#include <algorithm>
+
+#include "parser/expression/column_ref_expression.hpp"
+#include "parser/expression/comparison_expression.hpp"
+#include "parser/expression/constant_expression.hpp"
+#include "parser/expression/operator_expression.hpp"
+#include "planner/operator/logical_aggregate.hpp"
+#include "planner/operator/logical_get.hpp"
+#include "planner/operator/logical_index_scan.hpp"
+#include "planner/operator/logical_parquet_scan.hpp"
+#include "planner/operator/logical_projection.hpp"
+#include "planner/operator/logical_window.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+using TableSet = std::unordered_set<size_t>;
+
+void CollectTables(LogicalOperator& op, TableSet& tables);
+
+/**
+ * Call the callback for the expression and all its descendants.
+ */
+void WalkExpression(Expression& expr,
+                    const std::function<void(Expression& expr)>& callback) {
+  callback(expr);
+  expr.EnumerateChildren(
+      [&](Expression& child) { WalkExpression(child, callback); });
+}
+
+/**
+ * Collect the tables produced anywhere in the plan, including the plans of
+ * its subqueries.
+ */
+void CollectTables(Expression& expr, TableSet& tables) {
+  WalkExpression(expr, [&](Expression& e) {
+    auto subquery = dynamic_cast<SubqueryExpression*>(&e);
+    if (subquery) {
+      CollectTables(*subquery->subquery, tables);
+    }
+  });
+}
+
+void CollectTables(LogicalOperator& op, TableSet& tables) {
+  switch (op.GetType()) {
+    case LogicalOperatorType::kGet:
+      tables.insert(static_cast<LogicalGet&>(op).table_index);
+      break;
+    case LogicalOperatorType::kIndexScan:
+      tables.insert(static_cast<LogicalIndexScan&>(op).table_index);
+      break;
+    case LogicalOperatorType::kParquetScan:
+      tables.insert(static_cast<LogicalParquetScan&>(op).table_index);
+      break;
+    case LogicalOperatorType::kProjection:
+      tables.insert(static_cast<LogicalProjection&>(op).table_index);
+      break;
+    case LogicalOperatorType::kAggregateAndGroupBy: {
+      auto& aggr = static_cast<LogicalAggregate&>(op);
+      tables.insert(aggr.group_index);
+      tables.insert(aggr.aggregate_index);
+      break;
+    }
+    case LogicalOperatorType::kWindow:
+      tables.insert(static_cast<LogicalWindow&>(op).window_index);
+      break;
+    case LogicalOperatorType::kJoin: {
+      auto& join = static_cast<LogicalJoin&>(op);
+      if (join.join_type == JoinType::kMark) {
+        tables.insert(join.mark_index);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  op.EnumerateExpressions(
+      [&](std::unique_ptr<Expression>& expr) { CollectTables(*expr, tables); });
+  for (auto& child : op.children) {
+    CollectTables(*child, tables);
+  }
+}
+
+/**
+ * Collect the column references of the expression, including those inside
+ * of its subqueries.
+ */
+void CollectReferences(LogicalOperator& op,
+                       std::vector<ColumnRefExpression*>& refs);
+
+void CollectReferences(Expression& expr,
+                       std::vector<ColumnRefExpression*>& refs) {
+  WalkExpression(expr, [&](Expression& e) {
+    if (e.type == ExpressionType::kColumnRef) {
+      refs.push_back(static_cast<ColumnRefExpression*>(&e));
+    }
+    auto subquery = dynamic_cast<SubqueryExpression*>(&e);
+    if (subquery) {
+      CollectReferences(*subquery->subquery, refs);
+    }
+  });
+}
+
+void CollectReferences(LogicalOperator& op,
+                       std::vector<ColumnRefExpression*>& refs) {
+  op.EnumerateExpressions([&](std::unique_ptr<Expression>& expr) {
+    CollectReferences(*expr, refs);
+  });
+  for (auto& child : op.children) {
+    CollectReferences(*child, refs);
+  }
+}
+
+bool ReferencesAny(Expression& expr, const TableSet& tables) {
+  std::vector<ColumnRefExpression*> refs;
+  CollectReferences(expr, refs);
+  return std::any_of(refs.begin(), refs.end(), [&](ColumnRefExpression* ref) {
+    return tables.count(ref->binding.table_index) > 0;
+  });
+}
+
+bool ReferencesAny(LogicalOperator& op, const TableSet& tables) {
+  std::vector<ColumnRefExpression*> refs;
+  CollectReferences(op, refs);
+  return std::any_of(refs.begin(), refs.end(), [&](ColumnRefExpression* ref) {
+    return tables.count(ref->binding.table_index) > 0;
+  });
+}
+
+bool ReferencesOnly(Expression& expr, const TableSet& tables) {
+  std::vector<ColumnRefExpression*> refs;
+  CollectReferences(expr, refs);
+  return std::all_of(refs.begin(), refs.end(), [&](ColumnRefExpression* ref) {
+    return tables.count(ref->binding.table_index) > 0;
+  });
+}
+
+TableSet GetOutputTables(LogicalOperator& op) {
+  TableSet result;
+  for (auto& binding : op.GetColumnBindings()) {
+    result.insert(binding.table_index);
+  }
+  return result;
+}
+
+/**
+ * Whether the side of a correlated predicate is the one that references the
+ * outer query.
+ */
+bool IsOuterSide(Expression& expr, const TableSet& outer) {
+  return ReferencesAny(expr, outer);
+}
+
+/**
+ * Whether the expression can become a join condition: a comparison of an
+ * expression over outer columns with an expression over inner columns.
+ */
+bool IsCorrelatedPredicate(Expression& expr, const TableSet& outer,
+                           bool equality_only) {
+  switch (expr.type) {
+    case ExpressionType::kCompareEqual:
+      break;
+    case ExpressionType::kCompareNotEqual:
+    case ExpressionType::kCompareLessThan:
+    case ExpressionType::kCompareGreaterThan:
+    case ExpressionType::kCompareLessThanOrEqualTo:
+    case ExpressionType::kCompareGreaterThanOrEqualTo:
+      if (equality_only) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  if (expr.HasSubquery()) {
+    return false;
+  }
+  auto& left  = *expr.children[0];
+  auto& right = *expr.children[1];
+  if (IsOuterSide(left, outer)) {
+    return ReferencesOnly(left, outer) && !IsOuterSide(right, outer);
+  }
+  return ReferencesOnly(right, outer);
+}
+
+/**
+ * Whether the predicates referencing the outer query can be pulled up to
+ * the root of the subquery. Only equality predicates can be pulled through
+ * an aggregate, and only for scalar subqueries.
+ */
+bool CanPullUp(LogicalOperator& op, const TableSet& outer, bool scalar,
+               bool below_aggregate) {
+  switch (op.GetType()) {
+    case LogicalOperatorType::kProjection:
+      for (auto& expr : op.expressions) {
+        if (ReferencesAny(*expr, outer)) {
+          return false;
+        }
+      }
+      return CanPullUp(*op.children[0], outer, scalar, below_aggregate);
+    case LogicalOperatorType::kFilter:
+      for (auto& expr : op.expressions) {
+        if (ReferencesAny(*expr, outer) &&
+            !IsCorrelatedPredicate(*expr, outer, below_aggregate)) {
+          return false;
+        }
+      }
+      return CanPullUp(*op.children[0], outer, scalar, below_aggregate);
+    case LogicalOperatorType::kAggregateAndGroupBy: {
+      if (!scalar || below_aggregate) {
+        return !ReferencesAny(op, outer);
+      }
+      bool correlated = false;
+      op.EnumerateExpressions([&](std::unique_ptr<Expression>& expr) {
+        correlated = correlated || ReferencesAny(*expr, outer);
+      });
+      return !correlated && CanPullUp(*op.children[0], outer, scalar, true);
+    }
+    default:
+      return !ReferencesAny(op, outer);
+  }
+}
+
+/**
+ * Whether the subquery can be flattened into a join with the outer query
+ * producing the outer tables. Sets correlated if the subquery references
+ * the outer query.
+ */
+bool CanFlatten(LogicalOperator& subquery, const TableSet& outer, bool scalar,
+                bool& correlated) {
+  TableSet inner;
+  CollectTables(subquery, inner);
+  std::vector<ColumnRefExpression*> refs;
+  CollectReferences(subquery, refs);
+  correlated = false;
+  for (auto ref : refs) {
+    auto table = ref->binding.table_index;
+    if (inner.count(table) > 0) {
+      continue;
+    }
+    if (outer.count(table) == 0) {
+      // references a query further out, which is not available to the join
+      return false;
+    }
+    correlated = true;
+  }
+  return CanPullUp(subquery, outer, scalar, false);
+}
+
+/**
+ * Replace the inner side of the predicate by a column produced by the
+ * operator (as a projection column or a group), so the predicate can be
+ * evaluated above it.
+ */
+void ExposeInnerSide(Expression& pred, const TableSet& outer,
+                     std::vector<std::unique_ptr<Expression>>& list,
+                     size_t table_index) {
+  auto& side = IsOuterSide(*pred.children[0], outer) ? pred.children[1]
+                                                     : pred.children[0];
+  std::vector<ColumnRefExpression*> refs;
+  CollectReferences(*side, refs);
+  if (refs.empty()) {
+    // a constant does not need to be exposed
+    return;
+  }
+  size_t index = list.size();
+  for (size_t i = 0; i < list.size(); i++) {
+    if (Expression::Equals(list[i].get(), side.get())) {
+      index = i;
+      break;
+    }
+  }
+  auto return_type = side->return_type;
+  if (index == list.size()) {
+    list.push_back(std::move(side));
+  }
+  side = std::make_unique<ColumnRefExpression>(
+      return_type, ColumnBinding(table_index, index));
+}
+
+/**
+ * Move the predicates of the subquery referencing the outer query into
+ * predicates, rewriting them to reference the root of the subquery.
+ */
+void PullUp(std::unique_ptr<LogicalOperator>& op, const TableSet& outer,
+            std::vector<std::unique_ptr<Expression>>& predicates) {
+  switch (op->GetType()) {
+    case LogicalOperatorType::kProjection: {
+      PullUp(op->children[0], outer, predicates);
+      auto& proj = static_cast<LogicalProjection&>(*op);
+      for (auto& pred : predicates) {
+        ExposeInnerSide(*pred, outer, proj.expressions, proj.table_index);
+      }
+      break;
+    }
+    case LogicalOperatorType::kFilter: {
+      PullUp(op->children[0], outer, predicates);
+      std::vector<std::unique_ptr<Expression>> remaining;
+      for (auto& expr : op->expressions) {
+        if (ReferencesAny(*expr, outer)) {
+          predicates.push_back(std::move(expr));
+        } else {
+          remaining.push_back(std::move(expr));
+        }
+      }
+      if (remaining.empty()) {
+        op = std::move(op->children[0]);
+      } else {
+        op->expressions = std::move(remaining);
+      }
+      break;
+    }
+    case LogicalOperatorType::kAggregateAndGroupBy: {
+      PullUp(op->children[0], outer, predicates);
+      auto& aggr = static_cast<LogicalAggregate&>(*op);
+      for (auto& pred : predicates) {
+        ExposeInnerSide(*pred, outer, aggr.groups, aggr.group_index);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+bool IsCount(const Expression& expr) {
+  return expr.type == ExpressionType::kAggregateCount ||
+         expr.type == ExpressionType::kAggregateCountStar;
+}
+
+}  // namespace
+
+SubqueryRewriter::SubqueryRewriter() : next_table_index_(0) {}
+
+std::unique_ptr<LogicalOperator> SubqueryRewriter::Rewrite(
+    std::unique_ptr<LogicalOperator> op) {
+  TableSet tables;
+  CollectTables(*op, tables);
+  for (auto table : tables) {
+    next_table_index_ = std::max(next_table_index_, table + 1);
+  }
+  RewriteOperator(op);
+  return op;
+}
+
+void SubqueryRewriter::RewriteOperator(std::unique_ptr<LogicalOperator>& op) {
+  for (auto& child : op->children) {
+    RewriteOperator(child);
+  }
+  // flatten the subqueries of the subqueries first
+  op->EnumerateExpressions([&](std::unique_ptr<Expression>& expr) {
+    WalkExpression(*expr, [&](Expression& e) {
+      auto subquery = dynamic_cast<SubqueryExpression*>(&e);
+      if (subquery) {
+        RewriteOperator(subquery->subquery);
+      }
+    });
+  });
+  switch (op->GetType()) {
+    case LogicalOperatorType::kFilter:
+      RewriteFilter(op);
+      break;
+    case LogicalOperatorType::kProjection:
+      RewriteProjection(*op);
+      break;
+    default:
+      break;
+  }
+}
+
+void SubqueryRewriter::RewriteFilter(std::unique_ptr<LogicalOperator>& op) {
+  auto input = std::move(op->children[0]);
+  std::vector<std::unique_ptr<Expression>> remaining;
+  for (auto& expr : op->expressions) {
+    if (expr->HasSubquery()) {
+      if (FlattenFilterTerm(expr, input)) {
+        continue;
+      }
+      FlattenNested(expr, input);
+    }
+    remaining.push_back(std::move(expr));
+  }
+  if (remaining.empty()) {
+    op = std::move(input);
+  } else {
+    op->expressions = std::move(remaining);
+    op->children[0] = std::move(input);
+  }
+}
+
+void SubqueryRewriter::RewriteProjection(LogicalOperator& op) {
+  auto& input = op.children[0];
+  for (auto& expr : op.expressions) {
+    if (expr->HasSubquery()) {
+      FlattenNested(expr, input);
+    }
+  }
+}
+
+bool SubqueryRewriter::FlattenFilterTerm(
+    std::unique_ptr<Expression>& expr,
+    std::unique_ptr<LogicalOperator>& input) {
+  bool negated = false;
+  auto term    = expr.get();
+  if (term->type == ExpressionType::kOperatorNot) {
+    negated = true;
+    term    = term->children[0].get();
+  }
+  auto subquery = dynamic_cast<SubqueryExpression*>(term);
+  if (!subquery) {
+    return false;
+  }
+  switch (subquery->subquery_type) {
+    case SubqueryType::kExists:
+      return FlattenExists(*subquery, input,
+                           negated ? JoinType::kAnti : JoinType::kSemi);
+    case SubqueryType::kAny:
+      // NOT IN is NULL rather than true if the subquery produces a NULL, so
+      // it can not be an ANTI join: it becomes a MARK join instead
+      return !negated && FlattenAny(*subquery, input, JoinType::kSemi);
+    default:
+      return false;
+  }
+}
+
+void SubqueryRewriter::FlattenNested(std::unique_ptr<Expression>& expr,
+                                     std::unique_ptr<LogicalOperator>& input) {
+  auto subquery = dynamic_cast<SubqueryExpression*>(expr.get());
+  if (!subquery) {
+    for (auto& child : expr->children) {
+      FlattenNested(child, input);
+    }
+    return;
+  }
+  bool flattened = false;
+  switch (subquery->subquery_type) {
+    case SubqueryType::kExists:
+      flattened = FlattenExists(*subquery, input, JoinType::kMark);
+      break;
+    case SubqueryType::kAny:
+      flattened = FlattenAny(*subquery, input, JoinType::kMark);
+      break;
+    case SubqueryType::kScalar: {
+      auto result = FlattenScalar(*subquery, input);
+      if (result) {
+        expr = std::move(result);
+      }
+      return;
+    }
+  }
+  if (flattened) {
+    auto& join = static_cast<LogicalJoin&>(*input);
+    auto mark  = std::make_unique<ColumnRefExpression>(
+        TypeId::kBoolean, ColumnBinding(join.mark_index, 0));
+    mark->alias = expr->alias;
+    expr        = std::move(mark);
+  }
+}
+
+bool SubqueryRewriter::FlattenExists(SubqueryExpression& expr,
+                                     std::unique_ptr<LogicalOperator>& input,
+                                     JoinType type) {
+  auto outer      = GetOutputTables(*input);
+  bool correlated = false;
+  if (!CanFlatten(*expr.subquery, outer, false, correlated) || !correlated) {
+    // an uncorrelated EXISTS is cheaper to compute once
+    return false;
+  }
+  std::vector<std::unique_ptr<Expression>> predicates;
+  PullUp(expr.subquery, outer, predicates);
+  MakeJoin(input, std::move(expr.subquery), type, std::move(predicates),
+           outer);
+  return true;
+}
+
+bool SubqueryRewriter::FlattenAny(SubqueryExpression& expr,
+                                  std::unique_ptr<LogicalOperator>& input,
+                                  JoinType type) {
+  auto outer      = GetOutputTables(*input);
+  bool correlated = false;
+  if (!CanFlatten(*expr.subquery, outer, false, correlated)) {
+    return false;
+  }
+  for (auto& child : expr.children) {
+    if (child->HasSubquery() || !ReferencesOnly(*child, outer)) {
+      return false;
+    }
+  }
+  auto& plan = expr.subquery;
+  plan->ResolveOperatorTypes();
+  auto bindings = plan->GetColumnBindings();
+  auto types    = plan->types;
+  if (bindings.size() != expr.children.size()) {
+    return false;
+  }
+
+  std::vector<std::unique_ptr<Expression>> predicates;
+  PullUp(plan, outer, predicates);
+  auto& join = MakeJoin(input, std::move(plan), type, std::move(predicates),
+                        outer);
+  std::vector<JoinCondition> conditions;
+  for (size_t i = 0; i < bindings.size(); i++) {
+    JoinCondition cond;
+    cond.left       = std::move(expr.children[i]);
+    cond.right      = std::make_unique<ColumnRefExpression>(types[i],
+                                                            bindings[i]);
+    cond.comparison = expr.comparison;
+    cond.null_aware = type == JoinType::kMark;
+    conditions.push_back(std::move(cond));
+  }
+  for (auto& cond : join.conditions) {
+    conditions.push_back(std::move(cond));
+  }
+  join.conditions = std::move(conditions);
+  return true;
+}
+
+std::unique_ptr<Expression> SubqueryRewriter::FlattenScalar(
+    SubqueryExpression& expr, std::unique_ptr<LogicalOperator>& input) {
+  auto outer      = GetOutputTables(*input);
+  bool correlated = false;
+  auto& plan      = expr.subquery;
+  if (!CanFlatten(*plan, outer, true, correlated) || !correlated) {
+    return nullptr;
+  }
+  // the subquery has to be a projection of an aggregate without groups, so
+  // it produces exactly one row for every value of the correlated columns
+  if (plan->GetType() != LogicalOperatorType::kProjection ||
+      plan->expressions.empty()) {
+    return nullptr;
+  }
+  bool filtered = false;
+  auto node     = plan->children[0].get();
+  while (node->GetType() == LogicalOperatorType::kFilter) {
+    filtered = true;
+    node     = node->children[0].get();
+  }
+  if (node->GetType() != LogicalOperatorType::kAggregateAndGroupBy) {
+    return nullptr;
+  }
+  auto& aggr = static_cast<LogicalAggregate&>(*node);
+  if (!aggr.groups.empty()) {
+    return nullptr;
+  }
+
+  // COUNT produces 0 rather than NULL for an empty input, but the LEFT join
+  // produces NULL for outer rows without a group: such a COUNT is wrapped in
+  // COALESCE(count, 0). COUNT used in any other way can not be flattened.
+  auto is_count_ref = [&](Expression& e) {
+    if (e.type != ExpressionType::kColumnRef) {
+      return false;
+    }
+    auto& binding = static_cast<ColumnRefExpression&>(e).binding;
+    return binding.table_index == aggr.aggregate_index &&
+           IsCount(*aggr.expressions[binding.column_index]);
+  };
+  auto& result  = *plan->expressions[0];
+  bool is_count = is_count_ref(result);
+  if (is_count && filtered) {
+    return nullptr;
+  }
+  if (!is_count) {
+    std::vector<ColumnRefExpression*> refs;
+    CollectReferences(result, refs);
+    for (auto ref : refs) {
+      if (is_count_ref(*ref)) {
+        return nullptr;
+      }
+    }
+  }
+
+  auto binding     = plan->GetColumnBindings()[0];
+  auto result_type = result.return_type;
+  std::vector<std::unique_ptr<Expression>> predicates;
+  PullUp(plan, outer, predicates);
+  MakeJoin(input, std::move(plan), JoinType::kLeft, std::move(predicates),
+           outer);
+
+  std::unique_ptr<Expression> ref =
+      std::make_unique<ColumnRefExpression>(result_type, binding);
+  if (is_count) {
+    ref = std::make_unique<OperatorExpression>(
+        ExpressionType::kOperatorCoalesce, result_type, std::move(ref),
+        std::make_unique<ConstantExpression>(Value::Numeric(result_type, 0)));
+  }
+  ref->alias = expr.alias;
+  return ref;
+}
+
+LogicalJoin& SubqueryRewriter::MakeJoin(
+    std::unique_ptr<LogicalOperator>& input,
+    std::unique_ptr<LogicalOperator> subquery, JoinType type,
+    std::vector<std::unique_ptr<Expression>> predicates,
+    const TableSet& outer) {
+  auto join = std::make_unique<LogicalJoin>(type);
+  for (auto& pred : predicates) {
+    bool left_is_outer = IsOuterSide(*pred->children[0], outer);
+    JoinCondition cond;
+    cond.comparison = left_is_outer
+                          ? pred->type
+                          : ComparisonExpression::FlipComparison(pred->type);
+    cond.left  = std::move(pred->children[left_is_outer ? 0 : 1]);
+    cond.right = std::move(pred->children[left_is_outer ? 1 : 0]);
+    // the outer columns are no longer referenced from inside a subquery
+    std::vector<ColumnRefExpression*> refs;
+    CollectReferences(*cond.left, refs);
+    for (auto ref : refs) {
+      if (ref->depth > 0) {
+        ref->depth--;
+      }
+    }
+    join->conditions.push_back(std::move(cond));
+  }
+  if (type == JoinType::kMark) {
+    join->mark_index = next_table_index_++;
+  }
+  join->AddChild(std::move(input));
+  join->AddChild(std::move(subquery));
+  input = std::move(join);
+  return static_cast<LogicalJoin&>(*input);
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,1004 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/art.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+enum class ARTNodeType : uint8_t {
+  kLeaf    = 0,
+  kNode4   = 1,
+  kNode16  = 2,
+  kNode48  = 3,
+  kNode256 = 4,
+};
+
+/**
+ * The header shared by leaves and inner nodes.
+ *
+ * Every field that a writer may modify while readers access the node is an
+ * atomic, readers load them relaxed and validate the version afterwards.
+ * The version is incremented by two for every modification, bit 1 is set
+ * while the node is locked and bit 0 once the node has been unlinked from
+ * the tree.
+ */
+struct ARTNode {
+  explicit ARTNode(ARTNodeType node_type) : type(node_type) {}
+
+  bool IsLeaf() const { return type == ARTNodeType::kLeaf; }
+
+  const ARTNodeType type;
+  std::atomic<uint64_t> version{0};
+  std::atomic<uint16_t> count{0};
+  /**
+   * The compressed prefix: the offset into prefix_data in the upper 32 bits
+   * and the length in the lower 32 bits, packed into one word so that both
+   * are read atomically. Splitting a node only removes bytes from the front
+   * of its prefix, so prefix_data itself is never modified.
+   */
+  std::atomic<uint64_t> prefix{0};
+  std::shared_ptr<const uint8_t[]> prefix_data;
+};
+
+namespace {
+
+constexpr uint64_t kObsoleteBit = 1;
+constexpr uint64_t kLockedBit   = 2;
+
+struct ARTLeaf : public ARTNode {
+  ARTLeaf(const uint8_t* data, size_t size, uint64_t leaf_value)
+      : ARTNode(ARTNodeType::kLeaf),
+        key(data, data + size),
+        value(leaf_value) {}
+
+  const std::vector<uint8_t> key;
+  const uint64_t value;
+};
+
+/**
+ * Node4 and Node16 keep their key bytes sorted, the child of keys[i] is
+ * children[i].
+ */
+template <ARTNodeType TYPE, size_t CAPACITY>
+struct ARTSortedNode : public ARTNode {
+  static constexpr size_t kCapacity = CAPACITY;
+
+  ARTSortedNode() : ARTNode(TYPE) {}
+
+  std::atomic<uint8_t> keys[CAPACITY];
+  std::atomic<ARTNode*> children[CAPACITY];
+};
+
+using ARTNode4  = ARTSortedNode<ARTNodeType::kNode4, 4>;
+using ARTNode16 = ARTSortedNode<ARTNodeType::kNode16, 16>;
+
+/**
+ * Node48 maps a key byte to one of its 48 child slots, child_index holds
+ * the slot plus one, 0 for no child.
+ */
+struct ARTNode48 : public ARTNode {
+  static constexpr size_t kCapacity = 48;
+
+  ARTNode48() : ARTNode(ARTNodeType::kNode48) {}
+
+  std::atomic<uint8_t> child_index[256];
+  std::atomic<ARTNode*> children[kCapacity];
+};
+
+struct ARTNode256 : public ARTNode {
+  ARTNode256() : ARTNode(ARTNodeType::kNode256) {}
+
+  std::atomic<ARTNode*> children[256];
+};
+
+struct ARTPrefix {
+  const uint8_t* data;
+  uint64_t offset;
+  uint64_t length;
+};
+
+ARTPrefix LoadPrefix(const ARTNode* node) {
+  auto packed = node->prefix.load(std::memory_order_relaxed);
+  auto offset = packed >> 32;
+  return {node->prefix_data.get() + offset, offset, packed & 0xFFFFFFFF};
+}
+
+void SetPrefix(ARTNode* node, uint64_t offset, uint64_t length) {
+  if (length > 0xFFFFFFFF) {
+    throw IndexException("Index key is too long");
+  }
+  node->prefix.store(offset << 32 | length, std::memory_order_relaxed);
+}
+
+/**
+ * Wait until the node is unlocked and return its version. Returns false if
+ * the node is obsolete.
+ */
+bool ReadLock(const ARTNode* node, uint64_t& version) {
+  version = node->version.load(std::memory_order_acquire);
+  while (version & kLockedBit) {
+    std::this_thread::yield();
+    version = node->version.load(std::memory_order_acquire);
+  }
+  return !(version & kObsoleteBit);
+}
+
+/**
+ * Returns true if the node has not been modified since version was read.
+ */
+bool Validate(const ARTNode* node, uint64_t version) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return node->version.load(std::memory_order_relaxed) == version;
+}
+
+bool UpgradeToWriteLock(ARTNode* node, uint64_t version) {
+  if (!node->version.compare_exchange_strong(version, version + kLockedBit,
+                                             std::memory_order_acquire)) {
+    return false;
+  }
+  // readers that see one of the following writes must also see the lock
+  std::atomic_thread_fence(std::memory_order_release);
+  return true;
+}
+
+void WriteUnlock(ARTNode* node) {
+  node->version.fetch_add(kLockedBit, std::memory_order_release);
+}
+
+void WriteUnlockObsolete(ARTNode* node) {
+  node->version.fetch_add(kLockedBit + kObsoleteBit,
+                          std::memory_order_release);
+}
+
+template <class NODE>
+ARTNode* FindSortedChild(const NODE* node, uint8_t byte) {
+  auto count =
+      std::min<size_t>(node->count.load(std::memory_order_relaxed),
+                       NODE::kCapacity);
+  for (size_t i = 0; i < count; i++) {
+    if (node->keys[i].load(std::memory_order_relaxed) == byte) {
+      return node->children[i].load(std::memory_order_acquire);
+    }
+  }
+  return nullptr;
+}
+
+ARTNode* FindChild(const ARTNode* node, uint8_t byte) {
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      return FindSortedChild(static_cast<const ARTNode4*>(node), byte);
+    case ARTNodeType::kNode16:
+      return FindSortedChild(static_cast<const ARTNode16*>(node), byte);
+    case ARTNodeType::kNode48: {
+      auto n48   = static_cast<const ARTNode48*>(node);
+      auto index = n48->child_index[byte].load(std::memory_order_relaxed);
+      if (index == 0 || index > ARTNode48::kCapacity) {
+        return nullptr;
+      }
+      return n48->children[index - 1].load(std::memory_order_acquire);
+    }
+    case ARTNodeType::kNode256:
+      return static_cast<const ARTNode256*>(node)->children[byte].load(
+          std::memory_order_acquire);
+    default:
+      return nullptr;
+  }
+}
+
+/**
+ * Find the first child at or after position (in key order). On success
+ * returns true, sets byte and child, and advances position past the child.
+ */
+bool NextChild(const ARTNode* node, size_t& position, uint8_t& byte,
+               ARTNode*& child) {
+  auto sorted_next = [&](const auto* sorted) {
+    using NODE = std::remove_cv_t<std::remove_pointer_t<decltype(sorted)>>;
+    auto count =
+        std::min<size_t>(sorted->count.load(std::memory_order_relaxed),
+                         NODE::kCapacity);
+    if (position >= count) {
+      return false;
+    }
+    byte  = sorted->keys[position].load(std::memory_order_relaxed);
+    child = sorted->children[position].load(std::memory_order_acquire);
+    position++;
+    return true;
+  };
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      return sorted_next(static_cast<const ARTNode4*>(node));
+    case ARTNodeType::kNode16:
+      return sorted_next(static_cast<const ARTNode16*>(node));
+    case ARTNodeType::kNode48: {
+      auto n48 = static_cast<const ARTNode48*>(node);
+      for (; position < 256; position++) {
+        auto index =
+            n48->child_index[position].load(std::memory_order_relaxed);
+        if (index == 0 || index > ARTNode48::kCapacity) {
+          continue;
+        }
+        child = n48->children[index - 1].load(std::memory_order_acquire);
+        if (child) {
+          byte = static_cast<uint8_t>(position++);
+          return true;
+        }
+      }
+      return false;
+    }
+    case ARTNodeType::kNode256: {
+      auto n256 = static_cast<const ARTNode256*>(node);
+      for (; position < 256; position++) {
+        child = n256->children[position].load(std::memory_order_acquire);
+        if (child) {
+          byte = static_cast<uint8_t>(position++);
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return false;
+  }
+}
+
+bool IsFull(const ARTNode* node) {
+  auto count = node->count.load(std::memory_order_relaxed);
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      return count == ARTNode4::kCapacity;
+    case ARTNodeType::kNode16:
+      return count == ARTNode16::kCapacity;
+    case ARTNodeType::kNode48:
+      return count == ARTNode48::kCapacity;
+    default:
+      return false;
+  }
+}
+
+template <class NODE>
+void InsertSortedChild(NODE* node, uint8_t byte, ARTNode* child) {
+  size_t count = node->count.load(std::memory_order_relaxed);
+  size_t pos   = 0;
+  while (pos < count &&
+         node->keys[pos].load(std::memory_order_relaxed) < byte) {
+    pos++;
+  }
+  for (auto i = count; i > pos; i--) {
+    node->keys[i].store(node->keys[i - 1].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    node->children[i].store(
+        node->children[i - 1].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  }
+  node->keys[pos].store(byte, std::memory_order_relaxed);
+  node->children[pos].store(child, std::memory_order_release);
+}
+
+/**
+ * Add a child to a node that is locked (or not yet published) and not full.
+ */
+void InsertChild(ARTNode* node, uint8_t byte, ARTNode* child) {
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      InsertSortedChild(static_cast<ARTNode4*>(node), byte, child);
+      break;
+    case ARTNodeType::kNode16:
+      InsertSortedChild(static_cast<ARTNode16*>(node), byte, child);
+      break;
+    case ARTNodeType::kNode48: {
+      auto n48     = static_cast<ARTNode48*>(node);
+      uint8_t slot = 0;
+      while (n48->children[slot].load(std::memory_order_relaxed)) {
+        slot++;
+      }
+      n48->children[slot].store(child, std::memory_order_release);
+      n48->child_index[byte].store(static_cast<uint8_t>(slot + 1),
+                                   std::memory_order_relaxed);
+      break;
+    }
+    case ARTNodeType::kNode256:
+      static_cast<ARTNode256*>(node)->children[byte].store(
+          child, std::memory_order_release);
+      break;
+    default:
+      return;
+  }
+  node->count.store(
+      static_cast<uint16_t>(node->count.load(std::memory_order_relaxed) + 1),
+      std::memory_order_relaxed);
+}
+
+template <class NODE>
+std::atomic<ARTNode*>* FindSortedSlot(NODE* node, uint8_t byte) {
+  auto count = node->count.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < count; i++) {
+    if (node->keys[i].load(std::memory_order_relaxed) == byte) {
+      return &node->children[i];
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Returns the slot that holds the child of byte in a locked node.
+ */
+std::atomic<ARTNode*>* FindSlot(ARTNode* node, uint8_t byte) {
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      return FindSortedSlot(static_cast<ARTNode4*>(node), byte);
+    case ARTNodeType::kNode16:
+      return FindSortedSlot(static_cast<ARTNode16*>(node), byte);
+    case ARTNodeType::kNode48: {
+      auto n48   = static_cast<ARTNode48*>(node);
+      auto index = n48->child_index[byte].load(std::memory_order_relaxed);
+      return index == 0 ? nullptr : &n48->children[index - 1];
+    }
+    case ARTNodeType::kNode256:
+      return &static_cast<ARTNode256*>(node)->children[byte];
+    default:
+      return nullptr;
+  }
+}
+
+void ReplaceChild(ARTNode* node, uint8_t byte, ARTNode* child) {
+  FindSlot(node, byte)->store(child, std::memory_order_release);
+}
+
+template <class NODE>
+void RemoveSortedChild(NODE* node, uint8_t byte) {
+  size_t count = node->count.load(std::memory_order_relaxed);
+  size_t pos   = 0;
+  while (node->keys[pos].load(std::memory_order_relaxed) != byte) {
+    pos++;
+  }
+  for (auto i = pos + 1; i < count; i++) {
+    node->keys[i - 1].store(node->keys[i].load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+    node->children[i - 1].store(
+        node->children[i].load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  }
+}
+
+void RemoveChild(ARTNode* node, uint8_t byte) {
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      RemoveSortedChild(static_cast<ARTNode4*>(node), byte);
+      break;
+    case ARTNodeType::kNode16:
+      RemoveSortedChild(static_cast<ARTNode16*>(node), byte);
+      break;
+    case ARTNodeType::kNode48: {
+      auto n48   = static_cast<ARTNode48*>(node);
+      auto index = n48->child_index[byte].load(std::memory_order_relaxed);
+      n48->child_index[byte].store(0, std::memory_order_relaxed);
+      n48->children[index - 1].store(nullptr, std::memory_order_relaxed);
+      break;
+    }
+    case ARTNodeType::kNode256:
+      static_cast<ARTNode256*>(node)->children[byte].store(
+          nullptr, std::memory_order_relaxed);
+      break;
+    default:
+      return;
+  }
+  node->count.store(
+      static_cast<uint16_t>(node->count.load(std::memory_order_relaxed) - 1),
+      std::memory_order_relaxed);
+}
+
+ARTNode* NewNode4(const uint8_t* prefix, size_t length) {
+  auto node = new ARTNode4();
+  if (length > 0) {
+    std::shared_ptr<uint8_t[]> data(new uint8_t[length]);
+    std::memcpy(data.get(), prefix, length);
+    node->prefix_data = std::move(data);
+    SetPrefix(node, 0, length);
+  }
+  return node;
+}
+
+/**
+ * Copy the prefix and the children of node into result, except for the
+ * child of skip (if any).
+ */
+ARTNode* CopyNode(const ARTNode* node, ARTNode* result, const uint8_t* skip) {
+  result->prefix_data = node->prefix_data;
+  result->prefix.store(node->prefix.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+  size_t position = 0;
+  uint8_t byte;
+  ARTNode* child;
+  while (NextChild(node, position, byte, child)) {
+    if (!skip || byte != *skip) {
+      InsertChild(result, byte, child);
+    }
+  }
+  return result;
+}
+
+/**
+ * Returns a copy of a full node with room for more children.
+ */
+ARTNode* Grow(const ARTNode* node) {
+  switch (node->type) {
+    case ARTNodeType::kNode4:
+      return CopyNode(node, new ARTNode16(), nullptr);
+    case ARTNodeType::kNode16:
+      return CopyNode(node, new ARTNode48(), nullptr);
+    default:
+      return CopyNode(node, new ARTNode256(), nullptr);
+  }
+}
+
+/**
+ * Returns true if the node is to be replaced by a smaller one when one of
+ * its children is removed. The thresholds are below the capacity of the
+ * smaller type, so that a node does not shrink and grow back on alternating
+ * erases and inserts.
+ */
+bool IsSparse(const ARTNode* node) {
+  auto count = node->count.load(std::memory_order_relaxed);
+  switch (node->type) {
+    case ARTNodeType::kNode16:
+      return count <= 3;
+    case ARTNodeType::kNode48:
+      return count <= 13;
+    case ARTNodeType::kNode256:
+      return count <= 38;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Returns a smaller copy of a sparse node without the child of byte.
+ */
+ARTNode* Shrink(const ARTNode* node, uint8_t byte) {
+  switch (node->type) {
+    case ARTNodeType::kNode16:
+      return CopyNode(node, new ARTNode4(), &byte);
+    case ARTNodeType::kNode48:
+      return CopyNode(node, new ARTNode16(), &byte);
+    default:
+      return CopyNode(node, new ARTNode48(), &byte);
+  }
+}
+
+void DeleteNode(ARTNode* node) {
+  switch (node->type) {
+    case ARTNodeType::kLeaf:
+      delete static_cast<ARTLeaf*>(node);
+      break;
+    case ARTNodeType::kNode4:
+      delete static_cast<ARTNode4*>(node);
+      break;
+    case ARTNodeType::kNode16:
+      delete static_cast<ARTNode16*>(node);
+      break;
+    case ARTNodeType::kNode48:
+      delete static_cast<ARTNode48*>(node);
+      break;
+    case ARTNodeType::kNode256:
+      delete static_cast<ARTNode256*>(node);
+      break;
+  }
+}
+
+void DeleteTree(ARTNode* node) {
+  size_t position = 0;
+  uint8_t byte;
+  ARTNode* child;
+  while (NextChild(node, position, byte, child)) {
+    DeleteTree(child);
+  }
+  DeleteNode(node);
+}
+
+/**
+ * Compare the first bound.size bytes of the key with the bound.
+ */
+int CompareToBound(const std::vector<uint8_t>& key, const ART::Bound& bound) {
+  auto length = std::min(key.size(), bound.size);
+  auto result = length == 0 ? 0 : std::memcmp(key.data(), bound.key, length);
+  if (result == 0 && key.size() < bound.size) {
+    return -1;
+  }
+  return result;
+}
+
+/**
+ * Update the order of a key path relative to a bound after appending the
+ * byte at position: negative if the path is smaller than the bound, positive
+ * if it is larger and 0 if it is equal to the bound so far.
+ */
+int AdvanceOrder(int order, const ART::Bound* bound, size_t position,
+                 uint8_t byte) {
+  if (order != 0 || !bound || position >= bound->size) {
+    return order;
+  }
+  return byte < bound->key[position] ? -1 : byte > bound->key[position];
+}
+
+[[noreturn]] void ThrowPrefixKey() {
+  throw IndexException("Index key is a prefix of another key");
+}
+
+}  // namespace
+
+/**
+ * A node on the path from the root to a leaf, byte selects the next node.
+ */
+struct ARTPathEntry {
+  ARTNode* node;
+  uint64_t version;
+  uint8_t byte;
+};
+
+enum class ART::Result : uint8_t {
+  kOk      = 0,
+  // the key exists (insert) or does not exist (erase, lookup)
+  kFailed  = 1,
+  // a conflicting modification was detected, the operation has to restart
+  kRestart = 2,
+  // a scan passed its upper bound
+  kDone    = 3,
+};
+
+struct ART::ScanState {
+  const Bound* lower;
+  const Bound* upper;
+  const ScanCallback& callback;
+  // the last visited leaf, it stays allocated until the scan has finished
+  const ARTLeaf* last_leaf;
+};
+
+class ART::EpochGuard {
+ public:
+  explicit EpochGuard(const ART& tree) : tree_(tree) {
+    while (true) {
+      epoch_ = tree_.epoch_.load();
+      tree_.active_[epoch_ & 1].fetch_add(1);
+      // the reclamation may have checked the counter before the increment
+      // and moved on to the next epoch
+      if (tree_.epoch_.load() == epoch_) {
+        return;
+      }
+      tree_.active_[epoch_ & 1].fetch_sub(1);
+    }
+  }
+
+  ~EpochGuard() {
+    tree_.active_[epoch_ & 1].fetch_sub(1);
+    if (tree_.retired_count_.load(std::memory_order_relaxed) > 0) {
+      tree_.Reclaim();
+    }
+  }
+
+  EpochGuard(const EpochGuard&)            = delete;
+  EpochGuard& operator=(const EpochGuard&) = delete;
+
+ private:
+  const ART& tree_;
+  uint64_t epoch_;
+};
+
+ART::ART()
+    : root_(new ARTNode256()),
+      epoch_(0),
+      active_{0, 0},
+      retired_count_(0) {}
+
+ART::~ART() {
+  DeleteTree(root_);
+  for (auto& retired : retired_) {
+    for (auto node : retired) {
+      DeleteNode(node);
+    }
+  }
+}
+
+bool ART::Insert(const uint8_t* key, size_t size, uint64_t value) {
+  EpochGuard guard(*this);
+  while (true) {
+    auto result = TryInsert(key, size, value);
+    if (result != Result::kRestart) {
+      return result == Result::kOk;
+    }
+  }
+}
+
+bool ART::Erase(const uint8_t* key, size_t size) {
+  EpochGuard guard(*this);
+  while (true) {
+    auto result = TryErase(key, size);
+    if (result != Result::kRestart) {
+      return result == Result::kOk;
+    }
+  }
+}
+
+bool ART::Lookup(const uint8_t* key, size_t size, uint64_t& value) const {
+  EpochGuard guard(*this);
+  while (true) {
+    auto result = TryLookup(key, size, value);
+    if (result != Result::kRestart) {
+      return result == Result::kOk;
+    }
+  }
+}
+
+void ART::Scan(const Bound* lower, const Bound* upper,
+               const ScanCallback& callback) const {
+  EpochGuard guard(*this);
+  ScanState state{lower, upper, callback, nullptr};
+  Bound resume;
+  while (ScanNode(root_, 0, 0, 0, state) == Result::kRestart) {
+    // continue after the last key that was visited
+    if (state.last_leaf) {
+      auto& key   = state.last_leaf->key;
+      resume      = {key.data(), key.size(), false};
+      state.lower = &resume;
+    }
+  }
+}
+
+ART::Result ART::TryInsert(const uint8_t* key, size_t size, uint64_t value) {
+  ARTNode* parent         = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_byte     = 0;
+  ARTNode* node           = root_;
+  uint64_t version;
+  size_t level = 0;
+  if (!ReadLock(node, version)) {
+    return Result::kRestart;
+  }
+  while (true) {
+    auto prefix    = LoadPrefix(node);
+    size_t matched = 0;
+    while (matched < prefix.length && level + matched < size &&
+           prefix.data[matched] == key[level + matched]) {
+      matched++;
+    }
+    if (matched < prefix.length) {
+      if (level + matched == size) {
+        if (!Validate(node, version)) {
+          return Result::kRestart;
+        }
+        ThrowPrefixKey();
+      }
+      // the key leaves the prefix: a new node takes over the matched part of
+      // the prefix, the node keeps the part after the mismatching byte
+      if (!UpgradeToWriteLock(parent, parent_version)) {
+        return Result::kRestart;
+      }
+      if (!UpgradeToWriteLock(node, version)) {
+        WriteUnlock(parent);
+        return Result::kRestart;
+      }
+      auto split = NewNode4(prefix.data, matched);
+      InsertChild(split, prefix.data[matched], node);
+      InsertChild(split, key[level + matched], new ARTLeaf(key, size, value));
+      SetPrefix(node, prefix.offset + matched + 1,
+                prefix.length - matched - 1);
+      ReplaceChild(parent, parent_byte, split);
+      WriteUnlock(node);
+      WriteUnlock(parent);
+      return Result::kOk;
+    }
+    level += prefix.length;
+    if (level == size) {
+      if (!Validate(node, version)) {
+        return Result::kRestart;
+      }
+      ThrowPrefixKey();
+    }
+
+    auto byte  = key[level];
+    auto child = FindChild(node, byte);
+    if (!Validate(node, version)) {
+      return Result::kRestart;
+    }
+    if (!child) {
+      if (IsFull(node)) {
+        // replace the node by a larger copy
+        if (!UpgradeToWriteLock(parent, parent_version)) {
+          return Result::kRestart;
+        }
+        if (!UpgradeToWriteLock(node, version)) {
+          WriteUnlock(parent);
+          return Result::kRestart;
+        }
+        auto grown = Grow(node);
+        InsertChild(grown, byte, new ARTLeaf(key, size, value));
+        ReplaceChild(parent, parent_byte, grown);
+        WriteUnlockObsolete(node);
+        WriteUnlock(parent);
+        Retire(node);
+        return Result::kOk;
+      }
+      if (!UpgradeToWriteLock(node, version)) {
+        return Result::kRestart;
+      }
+      if (parent && !Validate(parent, parent_version)) {
+        WriteUnlock(node);
+        return Result::kRestart;
+      }
+      InsertChild(node, byte, new ARTLeaf(key, size, value));
+      WriteUnlock(node);
+      return Result::kOk;
+    }
+
+    if (child->IsLeaf()) {
+      // the leaves are immutable, no need to lock them
+      auto& leaf_key = static_cast<ARTLeaf*>(child)->key;
+      auto mismatch  = level + 1;
+      while (mismatch < size && mismatch < leaf_key.size() &&
+             leaf_key[mismatch] == key[mismatch]) {
+        mismatch++;
+      }
+      if (mismatch == size && mismatch == leaf_key.size()) {
+        return Result::kFailed;
+      }
+      if (mismatch == size || mismatch == leaf_key.size()) {
+        ThrowPrefixKey();
+      }
+      // replace the leaf by a node with both leaves as children
+      if (!UpgradeToWriteLock(node, version)) {
+        return Result::kRestart;
+      }
+      auto split = NewNode4(key + level + 1, mismatch - level - 1);
+      InsertChild(split, leaf_key[mismatch], child);
+      InsertChild(split, key[mismatch], new ARTLeaf(key, size, value));
+      ReplaceChild(node, byte, split);
+      WriteUnlock(node);
+      return Result::kOk;
+    }
+
+    if (parent && !Validate(parent, parent_version)) {
+      return Result::kRestart;
+    }
+    parent         = node;
+    parent_version = version;
+    parent_byte    = byte;
+    node           = child;
+    level++;
+    if (!ReadLock(node, version)) {
+      return Result::kRestart;
+    }
+  }
+}
+
+ART::Result ART::TryErase(const uint8_t* key, size_t size) {
+  std::vector<ARTPathEntry> path;
+  ARTNode* node = root_;
+  uint64_t version;
+  size_t level = 0;
+  if (!ReadLock(node, version)) {
+    return Result::kRestart;
+  }
+  while (true) {
+    auto prefix = LoadPrefix(node);
+    if (level + prefix.length >= size ||
+        (prefix.length > 0 &&
+         std::memcmp(prefix.data, key + level, prefix.length) != 0)) {
+      return Validate(node, version) ? Result::kFailed : Result::kRestart;
+    }
+    level += prefix.length;
+
+    auto byte  = key[level];
+    auto child = FindChild(node, byte);
+    if (!Validate(node, version)) {
+      return Result::kRestart;
+    }
+    if (!child) {
+      return Result::kFailed;
+    }
+    path.push_back({node, version, byte});
+    if (child->IsLeaf()) {
+      auto& leaf_key = static_cast<ARTLeaf*>(child)->key;
+      if (leaf_key.size() != size ||
+          std::memcmp(leaf_key.data(), key, size) != 0) {
+        return Result::kFailed;
+      }
+      return EraseLeaf(path, child);
+    }
+
+    node = child;
+    level++;
+    if (!ReadLock(node, version)) {
+      return Result::kRestart;
+    }
+  }
+}
+
+ART::Result ART::EraseLeaf(const std::vector<ARTPathEntry>& path,
+                           ARTNode* leaf) {
+  // the nodes below top only lead to the leaf and are removed along with it,
+  // the root is never removed
+  auto top = path.size() - 1;
+  while (top > 0 &&
+         path[top].node->count.load(std::memory_order_relaxed) <= 1) {
+    top--;
+  }
+  bool shrink = top > 0 && IsSparse(path[top].node);
+  // lock top down, the locks validate the counts read above
+  auto first = shrink ? top - 1 : top;
+  for (auto i = first; i < path.size(); i++) {
+    if (!UpgradeToWriteLock(path[i].node, path[i].version)) {
+      for (auto j = first; j < i; j++) {
+        WriteUnlock(path[j].node);
+      }
+      return Result::kRestart;
+    }
+  }
+
+  if (shrink) {
+    auto& parent = path[top - 1];
+    ReplaceChild(parent.node, parent.byte,
+                 Shrink(path[top].node, path[top].byte));
+    WriteUnlockObsolete(path[top].node);
+    WriteUnlock(parent.node);
+    Retire(path[top].node);
+  } else {
+    RemoveChild(path[top].node, path[top].byte);
+    WriteUnlock(path[top].node);
+  }
+  for (auto i = top + 1; i < path.size(); i++) {
+    WriteUnlockObsolete(path[i].node);
+    Retire(path[i].node);
+  }
+  Retire(leaf);
+  return Result::kOk;
+}
+
+ART::Result ART::TryLookup(const uint8_t* key, size_t size,
+                           uint64_t& value) const {
+  const ARTNode* node = root_;
+  uint64_t version;
+  size_t level = 0;
+  if (!ReadLock(node, version)) {
+    return Result::kRestart;
+  }
+  while (true) {
+    auto prefix = LoadPrefix(node);
+    if (level + prefix.length >= size ||
+        (prefix.length > 0 &&
+         std::memcmp(prefix.data, key + level, prefix.length) != 0)) {
+      return Validate(node, version) ? Result::kFailed : Result::kRestart;
+    }
+    level += prefix.length;
+
+    auto child = FindChild(node, key[level]);
+    if (!Validate(node, version)) {
+      return Result::kRestart;
+    }
+    if (!child) {
+      return Result::kFailed;
+    }
+    if (child->IsLeaf()) {
+      auto leaf = static_cast<const ARTLeaf*>(child);
+      if (leaf->key.size() != size ||
+          std::memcmp(leaf->key.data(), key, size) != 0) {
+        return Result::kFailed;
+      }
+      value = leaf->value;
+      return Result::kOk;
+    }
+
+    node = child;
+    level++;
+    if (!ReadLock(node, version)) {
+      return Result::kRestart;
+    }
+  }
+}
+
+ART::Result ART::ScanNode(const ARTNode* node, size_t level, int lower_order,
+                          int upper_order, ScanState& state) const {
+  if (node->IsLeaf()) {
+    auto leaf = static_cast<const ARTLeaf*>(node);
+    if (state.lower) {
+      auto cmp = CompareToBound(leaf->key, *state.lower);
+      if (cmp < 0 || (cmp == 0 && !state.lower->inclusive)) {
+        return Result::kOk;
+      }
+    }
+    if (state.upper) {
+      auto cmp = CompareToBound(leaf->key, *state.upper);
+      if (cmp > 0 || (cmp == 0 && !state.upper->inclusive)) {
+        return Result::kDone;
+      }
+    }
+    state.callback(leaf->value);
+    state.last_leaf = leaf;
+    return Result::kOk;
+  }
+
+  uint64_t version;
+  if (!ReadLock(node, version)) {
+    return Result::kRestart;
+  }
+  auto prefix = LoadPrefix(node);
+  for (size_t i = 0; i < prefix.length; i++) {
+    lower_order = AdvanceOrder(lower_order, state.lower, level + i,
+                               prefix.data[i]);
+    upper_order = AdvanceOrder(upper_order, state.upper, level + i,
+                               prefix.data[i]);
+  }
+  if (!Validate(node, version)) {
+    return Result::kRestart;
+  }
+  if (lower_order < 0) {
+    return Result::kOk;
+  }
+  if (upper_order > 0) {
+    return Result::kDone;
+  }
+  level += prefix.length;
+
+  size_t position = 0;
+  uint8_t byte;
+  ARTNode* child;
+  while (NextChild(node, position, byte, child)) {
+    if (!Validate(node, version)) {
+      return Result::kRestart;
+    }
+    auto child_lower = AdvanceOrder(lower_order, state.lower, level, byte);
+    auto child_upper = AdvanceOrder(upper_order, state.upper, level, byte);
+    if (child_lower < 0 || !child) {
+      continue;
+    }
+    if (child_upper > 0) {
+      return Result::kDone;
+    }
+    auto result = ScanNode(child, level + 1, child_lower, child_upper, state);
+    if (result != Result::kOk) {
+      return result;
+    }
+  }
+  return Validate(node, version) ? Result::kOk : Result::kRestart;
+}
+
+void ART::Reclaim() const {
+  std::unique_lock<std::mutex> guard(retired_lock_, std::try_to_lock);
+  if (!guard) {
+    return;
+  }
+  auto epoch = epoch_.load();
+  // every operation that may have reached a node retired in the previous
+  // epoch started in the previous epoch or earlier
+  auto& previous = retired_[(epoch + 1) & 1];
+  if (active_[(epoch + 1) & 1].load() != 0) {
+    return;
+  }
+  for (auto node : previous) {
+    DeleteNode(node);
+  }
+  retired_count_.fetch_sub(previous.size(), std::memory_order_relaxed);
+  previous.clear();
+  // operations that start from now on cannot reach the nodes retired so far
+  epoch_.store(epoch + 1);
+}
+
+void ART::Retire(ARTNode* node) {
+  std::lock_guard<std::mutex> guard(retired_lock_);
+  retired_[epoch_.load() & 1].push_back(node);
+  retired_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,316 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/column_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#include "common/exception.hpp"
+#include "common/types/hash.hpp"
+
+namespace zoomdb {
+
+template <class T>
+static inline bool LessThan(T left, T right) {
+  return left < right;
+}
+
+template <>
+inline bool LessThan(const char* left, const char* right) {
+  return std::strcmp(left, right) < 0;
+}
+
+ColumnStatistics::ColumnStatistics(TypeId type)
+    : type_(type), min_(type), max_(type), random_(HashInteger(0x5eed)) {
+  Reset();
+}
+
+void ColumnStatistics::Reset() {
+  count_      = 0;
+  null_count_ = 0;
+  min_        = Value(type_);
+  max_        = Value(type_);
+  distinct_.Clear();
+  sample_.clear();
+  sample_seen_   = 0;
+  next_sample_   = 0;
+  sample_weight_ = 1.0;
+}
+
+void ColumnStatistics::Update(const Vector& vector) {
+  if (vector.GetType() != type_) {
+    throw TypeMismatchException("in ColumnStatistics::Update", type_,
+                                vector.GetType());
+  }
+  switch (type_) {
+    case TypeId::kBoolean:
+    case TypeId::kTinyInt:
+      UpdateInternal<int8_t>(vector);
+      break;
+    case TypeId::kSmallInt:
+      UpdateInternal<int16_t>(vector);
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      UpdateInternal<int32_t>(vector);
+      break;
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      UpdateInternal<int64_t>(vector);
+      break;
+    case TypeId::kDecimal:
+      UpdateInternal<double>(vector);
+      break;
+    case TypeId::kVarChar:
+      UpdateInternal<const char*>(vector);
+      break;
+    default:
+      throw NotImplementationException("Unimplemented type %s for statistics",
+                                       TypeIdToString(type_).c_str());
+  }
+}
+
+template <class T>
+void ColumnStatistics::UpdateInternal(const Vector& vector) {
+  const auto kInvalidIndex = std::numeric_limits<size_t>::max();
+
+  auto data                = vector.GetData<T>();
+  auto& nullmask           = vector.GetNullMask();
+  size_t min_index         = kInvalidIndex;
+  size_t max_index         = kInvalidIndex;
+  for (size_t i = 0; i < vector.GetCount(); i++) {
+    if (nullmask[i]) {
+      null_count_++;
+      continue;
+    }
+    distinct_.Add(Hash<T>(data[i]));
+    if (min_index == kInvalidIndex || LessThan(data[i], data[min_index])) {
+      min_index = i;
+    }
+    if (max_index == kInvalidIndex || LessThan(data[max_index], data[i])) {
+      max_index = i;
+    }
+    AddToSample(vector, i);
+  }
+  count_ += vector.GetCount();
+  if (min_index != kInvalidIndex) {
+    UpdateMinMax(vector.GetValue(min_index), vector.GetValue(max_index));
+  }
+}
+
+void ColumnStatistics::Widen(const Vector& vector) {
+  if (vector.GetType() != type_) {
+    throw TypeMismatchException("in ColumnStatistics::Widen", type_,
+                                vector.GetType());
+  }
+  for (size_t i = 0; i < vector.GetCount(); i++) {
+    if (!vector.IsNull(i)) {
+      auto value = vector.GetValue(i);
+      UpdateMinMax(value, value);
+    }
+  }
+}
+
+void ColumnStatistics::Widen(const Value& min, const Value& max) {
+  UpdateMinMax(min, max);
+}
+
+void ColumnStatistics::UpdateMinMax(const Value& min, const Value& max) {
+  if (min.IsNull()) {
+    return;
+  }
+  if (min_.IsNull() || min < min_) {
+    min_ = min;
+  }
+  if (max_.IsNull() || max > max_) {
+    max_ = max;
+  }
+}
+
+static double RandomDouble(std::mt19937_64& random) {
+  // uniformly distributed in the open interval (0, 1)
+  return (static_cast<double>(random() >> 11) + 0.5) * 0x1.0p-53;
+}
+
+void ColumnStatistics::AddToSample(const Vector& vector, size_t index) {
+  sample_seen_++;
+  if (sample_.size() < kSampleSize) {
+    sample_.push_back(vector.GetValue(index));
+    if (sample_.size() == kSampleSize) {
+      ComputeNextSample();
+    }
+  } else if (sample_seen_ == next_sample_) {
+    sample_[random_() % kSampleSize] = vector.GetValue(index);
+    ComputeNextSample();
+  }
+}
+
+void ColumnStatistics::ComputeNextSample() {
+  // Algorithm L: skip over the values that would not enter the reservoir
+  // instead of drawing a random number for every value.
+  const auto k = static_cast<double>(kSampleSize);
+  sample_weight_ *= std::exp(std::log(RandomDouble(random_)) / k);
+  auto skip = std::floor(std::log(RandomDouble(random_)) /
+                         std::log1p(-sample_weight_));
+  if (!(skip < 1e18)) {
+    skip = 1e18;
+  }
+  next_sample_ = sample_seen_ + static_cast<uint64_t>(skip) + 1;
+}
+
+void ColumnStatistics::Merge(const ColumnStatistics& other) {
+  if (other.type_ != type_) {
+    throw TypeMismatchException("in ColumnStatistics::Merge", type_,
+                                other.type_);
+  }
+  count_ += other.count_;
+  null_count_ += other.null_count_;
+  UpdateMinMax(other.min_, other.max_);
+  distinct_.Merge(other.distinct_);
+
+  if (other.sample_seen_ == 0) {
+    return;
+  }
+  if (sample_seen_ + other.sample_seen_ <= kSampleSize) {
+    // both samples still hold every value they have seen
+    sample_.insert(sample_.end(), other.sample_.begin(), other.sample_.end());
+    sample_seen_ += other.sample_seen_;
+    if (sample_.size() == kSampleSize) {
+      ComputeNextSample();
+    }
+    return;
+  }
+
+  // Both samples are uniform samples of their inputs, so a uniform sample
+  // of the union takes from each in proportion to the values it has seen.
+  auto total      = static_cast<double>(sample_seen_ + other.sample_seen_);
+  auto from_this  = static_cast<size_t>(std::llround(
+      kSampleSize * static_cast<double>(sample_seen_) / total));
+  from_this       = std::min(from_this, sample_.size());
+  auto from_other = std::min(kSampleSize - from_this, other.sample_.size());
+
+  std::vector<Value> sample;
+  sample.reserve(from_this + from_other);
+  std::sample(sample_.begin(), sample_.end(), std::back_inserter(sample),
+              from_this, random_);
+  std::sample(other.sample_.begin(), other.sample_.end(),
+              std::back_inserter(sample), from_other, random_);
+  sample_ = std::move(sample);
+  sample_seen_ += other.sample_seen_;
+  // continue Algorithm L as if the merged values had been seen one by one
+  sample_weight_ = static_cast<double>(kSampleSize) / total;
+  ComputeNextSample();
+}
+
+double ColumnStatistics::GetNullFraction() const {
+  if (count_ == 0) {
+    return 0;
+  }
+  return static_cast<double>(null_count_) / static_cast<double>(count_);
+}
+
+uint64_t ColumnStatistics::GetDistinctCount() const {
+  return std::min(distinct_.Count(), count_ - null_count_);
+}
+
+Histogram ColumnStatistics::GetHistogram(size_t bucket_count) const {
+  Histogram histogram;
+  if (sample_.empty() || bucket_count == 0) {
+    return histogram;
+  }
+  auto sorted = sample_;
+  std::sort(sorted.begin(), sorted.end());
+
+  auto n       = sorted.size();
+  bucket_count = std::min(bucket_count, n);
+  histogram.bounds.reserve(bucket_count);
+  for (size_t i = 1; i <= bucket_count; i++) {
+    histogram.bounds.push_back(sorted[i * n / bucket_count - 1]);
+  }
+  histogram.bounds.back()   = max_;
+  histogram.rows_per_bucket = static_cast<double>(count_ - null_count_) /
+                              static_cast<double>(bucket_count);
+  return histogram;
+}
+
+double ColumnStatistics::EstimateFractionBelow(const Value& constant,
+                                               bool inclusive) const {
+  auto histogram = GetHistogram();
+  auto& bounds   = histogram.bounds;
+  if (bounds.empty() || constant < min_) {
+    return 0;
+  }
+  if (constant > max_) {
+    return 1;
+  }
+
+  auto it       = std::lower_bound(bounds.begin(), bounds.end(), constant);
+  auto index    = static_cast<size_t>(it - bounds.begin());
+  auto fraction = static_cast<double>(index);
+  if (index < bounds.size() && type_ != TypeId::kVarChar) {
+    // assume the values are uniformly distributed inside a bucket
+    auto lower = (index == 0 ? min_ : bounds[index - 1]).GetValue<double>();
+    auto upper = bounds[index].GetValue<double>();
+    if (upper > lower) {
+      auto offset = (constant.GetValue<double>() - lower) / (upper - lower);
+      fraction += std::clamp(offset, 0.0, 1.0);
+    }
+  }
+  fraction /= static_cast<double>(bounds.size());
+  if (inclusive) {
+    fraction += 1.0 / static_cast<double>(
+                          std::max<uint64_t>(GetDistinctCount(), 1));
+  }
+  return std::clamp(fraction, 0.0, 1.0);
+}
+
+double ColumnStatistics::EstimateSelectivity(ExpressionType comparison,
+                                             const Value& constant) const {
+  if (constant.IsNull() || count_ == null_count_) {
+    // comparisons with NULL are never true
+    return 0;
+  }
+  auto non_null = 1.0 - GetNullFraction();
+  auto equal    = non_null / static_cast<double>(std::max<uint64_t>(
+                              GetDistinctCount(), 1));
+  try {
+    switch (comparison) {
+      case ExpressionType::kCompareEqual:
+        return constant < min_ || constant > max_ ? 0 : equal;
+      case ExpressionType::kCompareNotEqual:
+        return constant < min_ || constant > max_ ? non_null
+                                                  : non_null - equal;
+      case ExpressionType::kCompareLessThan:
+        return non_null * EstimateFractionBelow(constant, false);
+      case ExpressionType::kCompareLessThanOrEqualTo:
+        return non_null * EstimateFractionBelow(constant, true);
+      case ExpressionType::kCompareGreaterThan:
+        return non_null * (1 - EstimateFractionBelow(constant, true));
+      case ExpressionType::kCompareGreaterThanOrEqualTo:
+        return non_null * (1 - EstimateFractionBelow(constant, false));
+      default:
+        break;
+    }
+  } catch (Exception&) {
+    // the constant cannot be compared with the column, fall through to the
+    // default estimate
+  }
+  return non_null;
+}
+
+std::string ColumnStatistics::ToString() const {
+  return "[" + TypeIdToString(type_) + ", count: " + std::to_string(count_) +
+         ", nulls: " + std::to_string(null_count_) +
+         ", distinct: " + std::to_string(GetDistinctCount()) +
+         ", min: " + min_.ToString() + ", max: " + max_.ToString() + "]";
+}
+
+}  // namespace zoomdb
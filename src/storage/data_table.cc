@@ -0,0 +1,560 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/data_table.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+using DeletionMask = std::bitset<kStandardVectorSize>;
+
+/**
+ * Fill selection with the positions of the first count rows of a chunk
+ * that are not deleted, returns their number.
+ */
+size_t SelectLiveRows(const DeletionMask& deleted, size_t count,
+                      sel_t* selection) {
+  size_t result = 0;
+  for (size_t row = 0; row < count; row++) {
+    if (!deleted[row]) {
+      selection[result++] = static_cast<sel_t>(row);
+    }
+  }
+  return result;
+}
+
+/**
+ * Copy the count rows of the chunk at the positions of the selection into
+ * result, which must have been initialized with the types of the chunk.
+ */
+void CopySelection(const DataChunk& chunk, const sel_t* selection,
+                   size_t count, DataChunk& result) {
+  for (size_t i = 0; i < chunk.ColumnCount(); i++) {
+    result.GetVector(i).AppendSelection(chunk.GetVector(i), selection, count);
+  }
+}
+
+}  // namespace
+
+DataTable::DataTable(std::vector<TypeId> types)
+    : types_(std::move(types)), row_count_(0), deleted_count_(0) {
+  statistics_.reserve(types_.size());
+  for (auto type : types_) {
+    statistics_.emplace_back(type);
+    dictionaries_.push_back(type == TypeId::kVarChar
+                                ? std::make_shared<StringDictionary>()
+                                : nullptr);
+  }
+}
+
+TypeId DataTable::GetColumnType(size_t column) const {
+  return column == kRowIdColumn ? TypeId::kBigInt : types_[column];
+}
+
+size_t DataTable::GetRowCount() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return row_count_ - deleted_count_;
+}
+
+size_t DataTable::GetChunkCount() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return chunks_.size();
+}
+
+std::shared_ptr<DataChunk> DataTable::GetChunk(size_t index) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return chunks_[index];
+}
+
+bool DataTable::GetLiveRows(size_t index, const DataChunk& chunk,
+                            sel_t* selection, size_t& count) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (index >= deleted_.size() || !deleted_[index]) {
+    return false;
+  }
+  // the chunk may be an older copy with fewer rows
+  count = SelectLiveRows(*deleted_[index], chunk.GetCount(), selection);
+  return true;
+}
+
+DataChunk& DataTable::GetMutableChunk(size_t index) {
+  auto& chunk = chunks_[index];
+  if (chunk.use_count() > 1) {
+    // the readers keep the version they hold
+    auto copy = std::make_shared<DataChunk>();
+    copy->Initialize(types_);
+    copy->Append(*chunk);
+    chunk = std::move(copy);
+  } else {
+    // a reader that let go of the chunk is done reading it
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *chunk;
+}
+
+void DataTable::Append(const DataChunk& chunk) {
+  if (chunk.GetTypes() != types_) {
+    throw CatalogException("Appended chunk does not match the table types");
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    try {
+      indexes_[i]->Append(chunk, row_count_);
+    } catch (...) {
+      for (size_t j = 0; j < i; j++) {
+        indexes_[j]->Delete(chunk, row_count_);
+      }
+      throw;
+    }
+  }
+
+  size_t offset = 0;
+  while (offset < chunk.GetCount()) {
+    if (chunks_.empty() || chunks_.back()->GetCount() == kStandardVectorSize) {
+      auto new_chunk = std::make_shared<DataChunk>();
+      new_chunk->Initialize(types_);
+      chunks_.push_back(std::move(new_chunk));
+    }
+    auto& last  = GetMutableChunk(chunks_.size() - 1);
+    auto count  = std::min(chunk.GetCount() - offset,
+                           kStandardVectorSize - last.GetCount());
+    for (size_t i = 0; i < types_.size(); i++) {
+      AppendColumn(i, chunk.GetVector(i), offset, count, last.GetVector(i));
+    }
+    offset += count;
+  }
+  row_count_ += chunk.GetCount();
+
+  // keep the statistics up to date, so the table never needs to be
+  // re-scanned to refresh them
+  for (size_t i = 0; i < types_.size(); i++) {
+    statistics_[i].Update(chunk.GetVector(i));
+  }
+}
+
+void DataTable::AppendColumn(size_t column, const Vector& source,
+                             size_t offset, size_t count, Vector& target) {
+  auto& dictionary = dictionaries_[column];
+  if (dictionary) {
+    Vector encoded(TypeId::kVarChar);
+    auto codes   = encoded.SetDictionary(dictionary);
+    auto strings = encoded.GetData<const char*>();
+    auto input   = source.GetData<const char*>() + offset;
+    size_t row   = 0;
+    for (; row < count; row++) {
+      if (source.IsNull(offset + row)) {
+        encoded.SetNull(row, true);
+        strings[row] = nullptr;
+        codes[row]   = 0;
+        continue;
+      }
+      auto code = dictionary->Add(input[row]);
+      if (code == StringDictionary::kInvalidCode) {
+        // too many distinct strings, the rest of the column is stored plain
+        dictionary.reset();
+        break;
+      }
+      strings[row] = dictionary->GetString(code);
+      codes[row]   = code;
+    }
+    encoded.SetCount(row);
+    target.Append(encoded);
+    offset += row;
+    count -= row;
+  }
+  if (count > 0) {
+    target.Append(source, offset, count);
+  }
+}
+
+void DataTable::Fetch(const uint64_t* row_ids, size_t count,
+                      const std::vector<size_t>& column_ids,
+                      DataChunk& result) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    auto& target = result.GetVector(i);
+    if (column_ids[i] != kRowIdColumn) {
+      FetchColumn(row_ids, count, column_ids[i], target);
+      continue;
+    }
+    std::memcpy(target.GetData(), row_ids, count * sizeof(uint64_t));
+    for (size_t row = 0; row < count; row++) {
+      target.SetNull(row, false);
+    }
+    target.SetCount(count);
+  }
+}
+
+void DataTable::FetchColumn(const uint64_t* row_ids, size_t count,
+                            size_t column, Vector& target) {
+  auto width = GetTypeIdSize(target.GetType());
+  auto data  = target.GetData();
+  for (size_t row = 0; row < count; row++) {
+    auto& source =
+        chunks_[row_ids[row] / kStandardVectorSize]->GetVector(column);
+    auto index = row_ids[row] % kStandardVectorSize;
+    target.SetNull(row, source.IsNull(index));
+    if (target.GetType() == TypeId::kVarChar) {
+      // the chunk may be replaced by a copy and freed once the lock is
+      // released, so the strings are copied
+      auto string = source.GetData<const char*>()[index];
+      target.GetData<const char*>()[row] =
+          source.IsNull(index)
+              ? nullptr
+              : target.AddString(string, std::strlen(string));
+      continue;
+    }
+    std::memcpy(data + row * width, source.GetData() + index * width, width);
+  }
+  target.SetCount(count);
+}
+
+bool DataTable::IsDeleted(uint64_t row_id) const {
+  auto chunk = row_id / kStandardVectorSize;
+  return chunk < deleted_.size() && deleted_[chunk] &&
+         (*deleted_[chunk])[row_id % kStandardVectorSize];
+}
+
+void DataTable::CheckRows(const uint64_t* row_ids, size_t count,
+                          bool allow_deleted) const {
+  for (size_t i = 0; i < count; i++) {
+    if (row_ids[i] >= row_count_) {
+      throw CatalogException("Row %llu does not exist",
+                             static_cast<unsigned long long>(row_ids[i]));
+    }
+    if (!allow_deleted && IsDeleted(row_ids[i])) {
+      throw CatalogException("Row %llu is deleted",
+                             static_cast<unsigned long long>(row_ids[i]));
+    }
+  }
+}
+
+size_t DataTable::Delete(const uint64_t* row_ids, size_t count) {
+  std::lock_guard<std::mutex> guard(lock_);
+  CheckRows(row_ids, count, true);
+  if (deleted_.size() < chunks_.size()) {
+    deleted_.resize(chunks_.size());
+  }
+  std::vector<uint64_t> deleted;
+  deleted.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto& mask = deleted_[row_ids[i] / kStandardVectorSize];
+    if (!mask) {
+      mask = std::make_unique<DeletionMask>();
+    }
+    auto row = row_ids[i] % kStandardVectorSize;
+    if (!(*mask)[row]) {
+      mask->set(row);
+      deleted.push_back(row_ids[i]);
+    }
+  }
+  deleted_count_ += deleted.size();
+
+  // the deleted rows keep their values, which give their index keys
+  if (!indexes_.empty() && !deleted.empty()) {
+    DataChunk rows;
+    rows.Initialize(types_);
+    for (size_t offset = 0; offset < deleted.size();
+         offset += kStandardVectorSize) {
+      auto batch = std::min(deleted.size() - offset, kStandardVectorSize);
+      rows.Reset();
+      for (size_t column = 0; column < types_.size(); column++) {
+        FetchColumn(deleted.data() + offset, batch, column,
+                    rows.GetVector(column));
+      }
+      for (auto& index : indexes_) {
+        index->Delete(rows, deleted.data() + offset);
+      }
+    }
+  }
+  return deleted.size();
+}
+
+void DataTable::Update(const uint64_t* row_ids,
+                       const std::vector<size_t>& column_ids,
+                       const DataChunk& values) {
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    if (column_ids[i] >= types_.size() ||
+        values.GetVector(i).GetType() != types_[column_ids[i]]) {
+      throw CatalogException("Updated values do not match the table types");
+    }
+  }
+  auto count = values.GetCount();
+  std::lock_guard<std::mutex> guard(lock_);
+  CheckRows(row_ids, count, false);
+
+  // the indexes over an updated column swap the old keys of the rows for
+  // the new ones
+  std::vector<Index*> indexes;
+  for (auto& index : indexes_) {
+    for (auto column : index->GetColumnIds()) {
+      if (std::find(column_ids.begin(), column_ids.end(), column) !=
+          column_ids.end()) {
+        indexes.push_back(index.get());
+        break;
+      }
+    }
+  }
+  if (!indexes.empty()) {
+    DataChunk old_rows;
+    DataChunk new_rows;
+    old_rows.Initialize(types_);
+    new_rows.Initialize(types_);
+    for (size_t column = 0; column < types_.size(); column++) {
+      FetchColumn(row_ids, count, column, old_rows.GetVector(column));
+      auto updated = std::find(column_ids.begin(), column_ids.end(), column);
+      new_rows.GetVector(column).Append(
+          updated == column_ids.end()
+              ? old_rows.GetVector(column)
+              : values.GetVector(static_cast<size_t>(updated -
+                                                     column_ids.begin())));
+    }
+    for (size_t i = 0; i < indexes.size(); i++) {
+      indexes[i]->Delete(old_rows, row_ids);
+      try {
+        indexes[i]->Append(new_rows, row_ids);
+      } catch (...) {
+        indexes[i]->Append(old_rows, row_ids);
+        for (size_t j = 0; j < i; j++) {
+          indexes[j]->Delete(new_rows, row_ids);
+          indexes[j]->Append(old_rows, row_ids);
+        }
+        throw;
+      }
+    }
+  }
+
+  // copy the held chunks once, before any of their entries is overwritten
+  for (size_t row = 0; row < count; row++) {
+    auto index = row_ids[row] / kStandardVectorSize;
+    if (row == 0 || index != row_ids[row - 1] / kStandardVectorSize) {
+      GetMutableChunk(index);
+    }
+  }
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    auto& source = values.GetVector(i);
+    for (size_t row = 0; row < count; row++) {
+      auto& target = chunks_[row_ids[row] / kStandardVectorSize]->GetVector(
+          column_ids[i]);
+      UpdateEntry(column_ids[i], source, row, target,
+                  row_ids[row] % kStandardVectorSize);
+    }
+    statistics_[column_ids[i]].Widen(source);
+    if (!analyze_updates_.empty()) {
+      analyze_updates_[column_ids[i]].Widen(source);
+    }
+  }
+}
+
+void DataTable::UpdateEntry(size_t column, const Vector& source, size_t index,
+                            Vector& target, size_t row) {
+  target.SetNull(row, source.IsNull(index));
+  if (types_[column] != TypeId::kVarChar) {
+    auto width = GetTypeIdSize(types_[column]);
+    std::memcpy(target.GetData() + row * width,
+                source.GetData() + index * width, width);
+    return;
+  }
+  if (source.IsNull(index)) {
+    return;
+  }
+  auto str         = source.GetData<const char*>()[index];
+  auto& dictionary = dictionaries_[column];
+  if (dictionary && target.GetDictionary() == dictionary.get()) {
+    auto code = dictionary->Add(str);
+    if (code != StringDictionary::kInvalidCode) {
+      target.GetData<const char*>()[row]  = dictionary->GetString(code);
+      target.SetDictionary(dictionary)[row] = code;
+      return;
+    }
+  }
+  if (target.GetDictionary()) {
+    // the string is not in the dictionary, the codes of the entries are
+    // dropped
+    target.SetValue(row, Value(str));
+    return;
+  }
+  target.GetData<const char*>()[row] = target.AddString(str, std::strlen(str));
+}
+
+Index& DataTable::CreateIndex(std::string name,
+                              std::vector<size_t> column_ids, bool unique) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto& index : indexes_) {
+    if (index->GetName() == name) {
+      throw CatalogException("Index %s already exists", name.c_str());
+    }
+  }
+  std::vector<TypeId> key_types;
+  for (auto column : column_ids) {
+    if (column >= types_.size()) {
+      throw CatalogException("Index column %zu does not exist", column);
+    }
+    key_types.push_back(types_[column]);
+  }
+  auto index = std::make_unique<Index>(std::move(name), std::move(column_ids),
+                                       std::move(key_types), unique);
+  DataChunk live;
+  live.Initialize(types_);
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    auto row_start = i * kStandardVectorSize;
+    if (i >= deleted_.size() || !deleted_[i]) {
+      index->Append(*chunks_[i], row_start);
+      continue;
+    }
+    // leave out the deleted rows
+    sel_t selection[kStandardVectorSize];
+    uint64_t row_ids[kStandardVectorSize];
+    auto count =
+        SelectLiveRows(*deleted_[i], chunks_[i]->GetCount(), selection);
+    for (size_t row = 0; row < count; row++) {
+      row_ids[row] = row_start + selection[row];
+    }
+    live.Reset();
+    CopySelection(*chunks_[i], selection, count, live);
+    index->Append(live, row_ids);
+  }
+  indexes_.push_back(std::move(index));
+  return *indexes_.back();
+}
+
+std::unique_ptr<Index> DataTable::DropIndex(const std::string& name) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto it = indexes_.begin(); it != indexes_.end(); ++it) {
+    if ((*it)->GetName() == name) {
+      auto index = std::move(*it);
+      indexes_.erase(it);
+      return index;
+    }
+  }
+  throw CatalogException("Index %s does not exist", name.c_str());
+}
+
+std::vector<Index*> DataTable::GetIndexes() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  std::vector<Index*> result;
+  for (auto& index : indexes_) {
+    result.push_back(index.get());
+  }
+  return result;
+}
+
+void DataTable::Analyze(size_t thread_count) {
+  std::lock_guard<std::mutex> analyze_guard(analyze_lock_);
+  // holding the full chunks and copies of their deletion bitmaps, they can
+  // be scanned without the lock
+  std::vector<std::shared_ptr<const DataChunk>> chunks;
+  std::vector<std::unique_ptr<DeletionMask>> deleted;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (size_t i = 0; i < chunks_.size(); i++) {
+      if (chunks_[i]->GetCount() < kStandardVectorSize) {
+        break;
+      }
+      chunks.push_back(chunks_[i]);
+      deleted.push_back(i < deleted_.size() && deleted_[i]
+                            ? std::make_unique<DeletionMask>(*deleted_[i])
+                            : nullptr);
+    }
+    analyze_updates_.clear();
+    for (auto type : types_) {
+      analyze_updates_.emplace_back(type);
+    }
+  }
+  if (thread_count == 0) {
+    thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  thread_count = std::max<size_t>(std::min(thread_count, chunks.size()), 1);
+
+  // every thread computes the statistics of a contiguous range of chunks,
+  // the partial statistics are merged afterwards
+  std::vector<std::vector<ColumnStatistics>> partial(thread_count);
+  auto analyze_range = [&](size_t thread_index) {
+    auto& statistics = partial[thread_index];
+    for (auto type : types_) {
+      statistics.emplace_back(type);
+    }
+    auto begin = chunks.size() * thread_index / thread_count;
+    auto end   = chunks.size() * (thread_index + 1) / thread_count;
+    DataChunk live;
+    for (auto i = begin; i < end; i++) {
+      auto chunk = chunks[i].get();
+      if (deleted[i]) {
+        // leave out the deleted rows
+        sel_t selection[kStandardVectorSize];
+        auto count = SelectLiveRows(*deleted[i], chunk->GetCount(), selection);
+        live.Initialize(types_);
+        CopySelection(*chunk, selection, count, live);
+        chunk = &live;
+      }
+      for (size_t column = 0; column < types_.size(); column++) {
+        statistics[column].Update(chunk->GetVector(column));
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; i++) {
+    threads.emplace_back(analyze_range, i);
+  }
+  analyze_range(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 1; i < thread_count; i++) {
+    for (size_t column = 0; column < types_.size(); column++) {
+      partial[0][column].Merge(partial[i][column]);
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  DataChunk live;
+  live.Initialize(types_);
+  for (auto i = chunks.size(); i < chunks_.size(); i++) {
+    const DataChunk* chunk = chunks_[i].get();
+    if (i < deleted_.size() && deleted_[i]) {
+      sel_t selection[kStandardVectorSize];
+      auto count =
+          SelectLiveRows(*deleted_[i], chunk->GetCount(), selection);
+      live.Reset();
+      CopySelection(*chunk, selection, count, live);
+      chunk = &live;
+    }
+    for (size_t column = 0; column < types_.size(); column++) {
+      partial[0][column].Update(chunk->GetVector(column));
+    }
+  }
+  // the scanned chunks may have been updated in the meantime
+  for (size_t column = 0; column < types_.size(); column++) {
+    partial[0][column].Widen(analyze_updates_[column].GetMinimum(),
+                             analyze_updates_[column].GetMaximum());
+  }
+  analyze_updates_.clear();
+  statistics_ = std::move(partial[0]);
+}
+
+ColumnStatistics DataTable::GetStatistics(size_t column) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return statistics_[column];
+}
+
+double DataTable::EstimateSelectivity(size_t column, ExpressionType comparison,
+                                      const Value& constant) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return statistics_[column].EstimateSelectivity(comparison, constant);
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,247 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/index.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+template <class T>
+void EncodeUnsigned(T value, std::vector<uint8_t>& key) {
+  for (size_t i = sizeof(T); i > 0; i--) {
+    key.push_back(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+  }
+}
+
+template <class T>
+void EncodeSigned(T value, std::vector<uint8_t>& key) {
+  using U = std::make_unsigned_t<T>;
+  // flipping the sign bit moves the negative numbers before the positive
+  EncodeUnsigned(static_cast<U>(static_cast<U>(value) ^
+                                (U(1) << (sizeof(T) * 8 - 1))),
+                 key);
+}
+
+void EncodeDouble(double value, std::vector<uint8_t>& key) {
+  if (value == 0) {
+    // -0.0 equals 0.0
+    value = 0;
+  }
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  constexpr uint64_t kSignBit = uint64_t(1) << 63;
+  EncodeUnsigned((bits & kSignBit) ? ~bits : bits ^ kSignBit, key);
+}
+
+bool IsIndexable(TypeId type) {
+  switch (type) {
+    case TypeId::kBoolean:
+    case TypeId::kTinyInt:
+    case TypeId::kSmallInt:
+    case TypeId::kInteger:
+    case TypeId::kBigInt:
+    case TypeId::kDecimal:
+    case TypeId::kDate:
+    case TypeId::kTimestamp:
+    case TypeId::kVarChar:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Append the encoding of a (not NULL) constant to key, the encoding is the
+ * same as that of the value stored in a vector.
+ */
+void EncodeConstant(const Value& value, std::vector<uint8_t>& key) {
+  switch (value.GetType()) {
+    case TypeId::kBoolean:
+    case TypeId::kTinyInt:
+      EncodeSigned(static_cast<int8_t>(value.GetNumericValue()), key);
+      break;
+    case TypeId::kSmallInt:
+      EncodeSigned(static_cast<int16_t>(value.GetNumericValue()), key);
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      EncodeSigned(static_cast<int32_t>(value.GetNumericValue()), key);
+      break;
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      EncodeSigned(value.GetNumericValue(), key);
+      break;
+    case TypeId::kDecimal:
+      EncodeDouble(value.GetValue<double>(), key);
+      break;
+    case TypeId::kVarChar: {
+      auto& str = value.GetString();
+      key.insert(key.end(), str.begin(), str.end());
+      key.push_back(0);
+      break;
+    }
+    default:
+      throw IndexException("Cannot index values of type %s",
+                           TypeIdToString(value.GetType()).c_str());
+  }
+}
+
+}  // namespace
+
+void Index::EncodeValue(const Vector& vector, size_t index,
+                        std::vector<uint8_t>& key) {
+  switch (vector.GetType()) {
+    case TypeId::kBoolean:
+    case TypeId::kTinyInt:
+      EncodeSigned(vector.GetData<int8_t>()[index], key);
+      break;
+    case TypeId::kSmallInt:
+      EncodeSigned(vector.GetData<int16_t>()[index], key);
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      EncodeSigned(vector.GetData<int32_t>()[index], key);
+      break;
+    case TypeId::kBigInt:
+    case TypeId::kTimestamp:
+      EncodeSigned(vector.GetData<int64_t>()[index], key);
+      break;
+    case TypeId::kDecimal:
+      EncodeDouble(vector.GetData<double>()[index], key);
+      break;
+    case TypeId::kVarChar: {
+      auto str = vector.GetData<const char*>()[index];
+      key.insert(key.end(), str, str + std::strlen(str));
+      key.push_back(0);
+      break;
+    }
+    default:
+      throw IndexException("Cannot index values of type %s",
+                           TypeIdToString(vector.GetType()).c_str());
+  }
+}
+
+Index::Index(std::string index_name, std::vector<size_t> columns,
+             std::vector<TypeId> column_types, bool is_unique)
+    : name_(std::move(index_name)),
+      column_ids_(std::move(columns)),
+      types_(std::move(column_types)),
+      unique_(is_unique) {
+  if (column_ids_.empty() || column_ids_.size() != types_.size()) {
+    throw IndexException("Index %s has no columns", name_.c_str());
+  }
+  for (auto type : types_) {
+    if (!IsIndexable(type)) {
+      throw IndexException("Cannot index a column of type %s",
+                           TypeIdToString(type).c_str());
+    }
+  }
+}
+
+bool Index::EncodeRow(const DataChunk& chunk, size_t row, uint64_t row_id,
+                      std::vector<uint8_t>& key) const {
+  key.clear();
+  for (auto column : column_ids_) {
+    auto& vector = chunk.GetVector(column);
+    if (vector.IsNull(row)) {
+      return false;
+    }
+    EncodeValue(vector, row, key);
+  }
+  if (!unique_) {
+    EncodeUnsigned(row_id, key);
+  }
+  return true;
+}
+
+void Index::Append(const DataChunk& chunk, uint64_t row_start) {
+  std::vector<uint64_t> row_ids(chunk.GetCount());
+  for (size_t row = 0; row < row_ids.size(); row++) {
+    row_ids[row] = row_start + row;
+  }
+  Append(chunk, row_ids.data());
+}
+
+void Index::Append(const DataChunk& chunk, const uint64_t* row_ids) {
+  std::vector<uint8_t> key;
+  for (size_t row = 0; row < chunk.GetCount(); row++) {
+    if (!EncodeRow(chunk, row, row_ids[row], key) ||
+        tree_.Insert(key.data(), key.size(), row_ids[row])) {
+      continue;
+    }
+    std::string values;
+    for (auto column : column_ids_) {
+      values += (values.empty() ? "" : ", ") +
+                chunk.GetValue(column, row).ToString();
+    }
+    // remove the rows of the chunk that were inserted before the duplicate
+    for (size_t i = 0; i < row; i++) {
+      if (EncodeRow(chunk, i, row_ids[i], key)) {
+        tree_.Erase(key.data(), key.size());
+      }
+    }
+    throw ConstraintException("Duplicate key (%s) violates unique index %s",
+                              values.c_str(), name_.c_str());
+  }
+}
+
+void Index::Delete(const DataChunk& chunk, uint64_t row_start) {
+  std::vector<uint64_t> row_ids(chunk.GetCount());
+  for (size_t row = 0; row < row_ids.size(); row++) {
+    row_ids[row] = row_start + row;
+  }
+  Delete(chunk, row_ids.data());
+}
+
+void Index::Delete(const DataChunk& chunk, const uint64_t* row_ids) {
+  std::vector<uint8_t> key;
+  for (size_t row = 0; row < chunk.GetCount(); row++) {
+    if (EncodeRow(chunk, row, row_ids[row], key)) {
+      tree_.Erase(key.data(), key.size());
+    }
+  }
+}
+
+void Index::Scan(const Value& lower, bool lower_inclusive, const Value& upper,
+                 bool upper_inclusive, std::vector<uint64_t>& result) const {
+  std::vector<uint8_t> lower_key;
+  std::vector<uint8_t> upper_key;
+  if (!lower.IsNull()) {
+    EncodeConstant(lower.GetType() == types_[0] ? lower
+                                                : lower.CastAs(types_[0]),
+                   lower_key);
+  }
+  if (!upper.IsNull()) {
+    EncodeConstant(upper.GetType() == types_[0] ? upper
+                                                : upper.CastAs(types_[0]),
+                   upper_key);
+  }
+
+  // point lookup in a unique index over a single column
+  if (unique_ && column_ids_.size() == 1 && !lower.IsNull() &&
+      lower_inclusive && upper_inclusive && lower_key == upper_key) {
+    uint64_t row_id;
+    if (tree_.Lookup(lower_key.data(), lower_key.size(), row_id)) {
+      result.push_back(row_id);
+    }
+    return;
+  }
+
+  ART::Bound lower_bound{lower_key.data(), lower_key.size(), lower_inclusive};
+  ART::Bound upper_bound{upper_key.data(), upper_key.size(), upper_inclusive};
+  tree_.Scan(lower.IsNull() ? nullptr : &lower_bound,
+             upper.IsNull() ? nullptr : &upper_bound,
+             [&](uint64_t row_id) { result.push_back(row_id); });
+}
+
+}  // namespace zoomdb
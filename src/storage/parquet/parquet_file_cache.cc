@@ -0,0 +1,26 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/parquet/parquet_file_cache.hpp"
+
+namespace zoomdb {
+
+std::shared_ptr<const ParquetReader> ParquetFileCache::GetReader(
+    const std::string& path) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto entry = readers_.find(path);
+  if (entry != readers_.end()) {
+    return entry->second;
+  }
+  // a file that cannot be opened is not cached, the next query tries again
+  std::shared_ptr<const ParquetReader> reader =
+      std::make_shared<ParquetReader>(path);
+  readers_.emplace(path, reader);
+  return reader;
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,363 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/parquet/parquet_metadata.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+template <class T>
+T ReadEnum(ThriftReader& reader) {
+  return static_cast<T>(reader.I32());
+}
+
+template <class T>
+void ReadStructList(ThriftReader& reader, std::vector<T>& result) {
+  ThriftType element_type;
+  auto size = reader.List(element_type);
+  result.resize(size);
+  for (auto& element : result) {
+    element.Read(reader);
+  }
+}
+
+}  // namespace
+
+void ParquetStatistics::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  writer.FieldI64(3, null_count);
+  if (has_min_max) {
+    writer.FieldBinary(5, max_value);
+    writer.FieldBinary(6, min_value);
+  }
+  writer.StructEnd();
+}
+
+void ParquetStatistics::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType type;
+  bool has_min = false;
+  bool has_max = false;
+  while (reader.NextField(id, type)) {
+    switch (id) {
+      case 3:
+        null_count = reader.I64();
+        break;
+      case 5:
+        max_value = reader.Binary();
+        has_max   = true;
+        break;
+      case 6:
+        min_value = reader.Binary();
+        has_min   = true;
+        break;
+      default:
+        // the deprecated min and max (1 and 2) use an unspecified order for
+        // strings, they are ignored
+        reader.Skip(type);
+    }
+  }
+  has_min_max = has_min && has_max;
+  reader.StructEnd();
+}
+
+void ParquetSchemaElement::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  if (has_type) {
+    writer.FieldI32(1, static_cast<int32_t>(type));
+    writer.FieldI32(3, static_cast<int32_t>(repetition));
+  }
+  writer.FieldBinary(4, name);
+  if (num_children > 0) {
+    writer.FieldI32(5, num_children);
+  }
+  if (converted_type != ParquetConvertedType::kNone) {
+    writer.FieldI32(6, static_cast<int32_t>(converted_type));
+  }
+  writer.StructEnd();
+}
+
+void ParquetSchemaElement::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType field_type;
+  while (reader.NextField(id, field_type)) {
+    switch (id) {
+      case 1:
+        has_type = true;
+        type     = ReadEnum<ParquetType>(reader);
+        break;
+      case 3:
+        repetition = ReadEnum<ParquetRepetition>(reader);
+        break;
+      case 4:
+        name = reader.Binary();
+        break;
+      case 5:
+        num_children = reader.I32();
+        break;
+      case 6:
+        converted_type = ReadEnum<ParquetConvertedType>(reader);
+        break;
+      default:
+        reader.Skip(field_type);
+    }
+  }
+  reader.StructEnd();
+}
+
+void ParquetColumnMetaData::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  writer.FieldI32(1, static_cast<int32_t>(type));
+  writer.FieldList(2, ThriftType::kI32, encodings.size());
+  for (auto encoding : encodings) {
+    writer.I32(static_cast<int32_t>(encoding));
+  }
+  writer.FieldList(3, ThriftType::kBinary, path_in_schema.size());
+  for (auto& path : path_in_schema) {
+    writer.Binary(path);
+  }
+  writer.FieldI32(4, static_cast<int32_t>(codec));
+  writer.FieldI64(5, num_values);
+  writer.FieldI64(6, total_uncompressed_size);
+  writer.FieldI64(7, total_compressed_size);
+  writer.FieldI64(9, data_page_offset);
+  if (has_dictionary_page) {
+    writer.FieldI64(11, dictionary_page_offset);
+  }
+  if (has_statistics) {
+    writer.FieldStruct(12);
+    statistics.Write(writer);
+  }
+  writer.StructEnd();
+}
+
+void ParquetColumnMetaData::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType field_type;
+  while (reader.NextField(id, field_type)) {
+    switch (id) {
+      case 1:
+        type = ReadEnum<ParquetType>(reader);
+        break;
+      case 2: {
+        ThriftType element_type;
+        auto size = reader.List(element_type);
+        for (size_t i = 0; i < size; i++) {
+          encodings.push_back(ReadEnum<ParquetEncoding>(reader));
+        }
+        break;
+      }
+      case 3: {
+        ThriftType element_type;
+        auto size = reader.List(element_type);
+        for (size_t i = 0; i < size; i++) {
+          path_in_schema.push_back(reader.Binary());
+        }
+        break;
+      }
+      case 4:
+        codec = ReadEnum<ParquetCompression>(reader);
+        break;
+      case 5:
+        num_values = reader.I64();
+        break;
+      case 6:
+        total_uncompressed_size = reader.I64();
+        break;
+      case 7:
+        total_compressed_size = reader.I64();
+        break;
+      case 9:
+        data_page_offset = reader.I64();
+        break;
+      case 11:
+        has_dictionary_page    = true;
+        dictionary_page_offset = reader.I64();
+        break;
+      case 12:
+        has_statistics = true;
+        statistics.Read(reader);
+        break;
+      default:
+        reader.Skip(field_type);
+    }
+  }
+  reader.StructEnd();
+}
+
+void ParquetColumnChunk::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  writer.FieldI64(2, file_offset);
+  writer.FieldStruct(3);
+  meta_data.Write(writer);
+  writer.StructEnd();
+}
+
+void ParquetColumnChunk::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType field_type;
+  while (reader.NextField(id, field_type)) {
+    switch (id) {
+      case 2:
+        file_offset = reader.I64();
+        break;
+      case 3:
+        meta_data.Read(reader);
+        break;
+      default:
+        reader.Skip(field_type);
+    }
+  }
+  reader.StructEnd();
+}
+
+void ParquetRowGroup::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  writer.FieldList(1, ThriftType::kStruct, columns.size());
+  for (auto& column : columns) {
+    column.Write(writer);
+  }
+  writer.FieldI64(2, total_byte_size);
+  writer.FieldI64(3, num_rows);
+  writer.StructEnd();
+}
+
+void ParquetRowGroup::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType field_type;
+  while (reader.NextField(id, field_type)) {
+    switch (id) {
+      case 1:
+        ReadStructList(reader, columns);
+        break;
+      case 2:
+        total_byte_size = reader.I64();
+        break;
+      case 3:
+        num_rows = reader.I64();
+        break;
+      default:
+        reader.Skip(field_type);
+    }
+  }
+  reader.StructEnd();
+}
+
+void ParquetFileMetaData::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  writer.FieldI32(1, version);
+  writer.FieldList(2, ThriftType::kStruct, schema.size());
+  for (auto& element : schema) {
+    element.Write(writer);
+  }
+  writer.FieldI64(3, num_rows);
+  writer.FieldList(4, ThriftType::kStruct, row_groups.size());
+  for (auto& row_group : row_groups) {
+    row_group.Write(writer);
+  }
+  if (!created_by.empty()) {
+    writer.FieldBinary(6, created_by);
+  }
+  writer.StructEnd();
+}
+
+void ParquetFileMetaData::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType field_type;
+  while (reader.NextField(id, field_type)) {
+    switch (id) {
+      case 1:
+        version = reader.I32();
+        break;
+      case 2:
+        ReadStructList(reader, schema);
+        break;
+      case 3:
+        num_rows = reader.I64();
+        break;
+      case 4:
+        ReadStructList(reader, row_groups);
+        break;
+      case 6:
+        created_by = reader.Binary();
+        break;
+      default:
+        reader.Skip(field_type);
+    }
+  }
+  reader.StructEnd();
+}
+
+void ParquetPageHeader::Write(ThriftWriter& writer) const {
+  writer.StructBegin();
+  writer.FieldI32(1, static_cast<int32_t>(type));
+  writer.FieldI32(2, uncompressed_page_size);
+  writer.FieldI32(3, compressed_page_size);
+  // the definition and repetition levels of data pages are RLE encoded
+  if (type == ParquetPageType::kDictionaryPage) {
+    writer.FieldStruct(7);
+    writer.StructBegin();
+    writer.FieldI32(1, num_values);
+    writer.FieldI32(2, static_cast<int32_t>(encoding));
+    writer.StructEnd();
+  } else {
+    writer.FieldStruct(5);
+    writer.StructBegin();
+    writer.FieldI32(1, num_values);
+    writer.FieldI32(2, static_cast<int32_t>(encoding));
+    writer.FieldI32(3, static_cast<int32_t>(ParquetEncoding::kRle));
+    writer.FieldI32(4, static_cast<int32_t>(ParquetEncoding::kRle));
+    writer.StructEnd();
+  }
+  writer.StructEnd();
+}
+
+void ParquetPageHeader::Read(ThriftReader& reader) {
+  reader.StructBegin();
+  int16_t id;
+  ThriftType field_type;
+  while (reader.NextField(id, field_type)) {
+    switch (id) {
+      case 1:
+        type = ReadEnum<ParquetPageType>(reader);
+        break;
+      case 2:
+        uncompressed_page_size = reader.I32();
+        break;
+      case 3:
+        compressed_page_size = reader.I32();
+        break;
+      case 5:
+      case 7:
+        // the data and dictionary page headers start with the same fields
+        reader.StructBegin();
+        while (reader.NextField(id, field_type)) {
+          if (id == 1) {
+            num_values = reader.I32();
+          } else if (id == 2) {
+            encoding = ReadEnum<ParquetEncoding>(reader);
+          } else {
+            reader.Skip(field_type);
+          }
+        }
+        reader.StructEnd();
+        break;
+      default:
+        reader.Skip(field_type);
+    }
+  }
+  reader.StructEnd();
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,479 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/parquet/parquet_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "common/exception.hpp"
+#include "storage/parquet/rle_bp_encoding.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+constexpr char kParquetMagic[] = "PAR1";
+
+TypeId GetColumnType(const ParquetSchemaElement& element) {
+  switch (element.type) {
+    case ParquetType::kBoolean:
+      return TypeId::kBoolean;
+    case ParquetType::kInt32:
+      switch (element.converted_type) {
+        case ParquetConvertedType::kInt8:
+          return TypeId::kTinyInt;
+        case ParquetConvertedType::kInt16:
+          return TypeId::kSmallInt;
+        case ParquetConvertedType::kDate:
+          return TypeId::kDate;
+        default:
+          return TypeId::kInteger;
+      }
+    case ParquetType::kInt64:
+      switch (element.converted_type) {
+        case ParquetConvertedType::kTimestampMillis:
+        case ParquetConvertedType::kTimestampMicros:
+          return TypeId::kTimestamp;
+        default:
+          return TypeId::kBigInt;
+      }
+    case ParquetType::kFloat:
+    case ParquetType::kDouble:
+      return TypeId::kDecimal;
+    case ParquetType::kByteArray:
+      return TypeId::kVarChar;
+    default:
+      throw NotImplementationException(
+          "Unsupported Parquet type %d of column \"%s\"",
+          static_cast<int>(element.type), element.name.c_str());
+  }
+}
+
+/**
+ * Returns the factor that converts a timestamp column to microseconds.
+ */
+int64_t TimestampScale(const ParquetSchemaElement& element) {
+  return element.converted_type == ParquetConvertedType::kTimestampMillis
+             ? 1000
+             : 1;
+}
+
+/**
+ * Reads PLAIN encoded values.
+ */
+class PlainDecoder {
+ public:
+  PlainDecoder(const char* data, const char* end)
+      : data_(data), end_(end), bit_(0) {}
+
+  template <class T>
+  T Read() {
+    if constexpr (std::is_same_v<T, bool>) {
+      // booleans are bit-packed, starting with the least significant bit
+      Require(1);
+      bool result = (*data_ >> bit_) & 1;
+      if (++bit_ == 8) {
+        bit_ = 0;
+        data_++;
+      }
+      return result;
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+      auto length = Read<uint32_t>();
+      Require(length);
+      std::string_view result(data_, length);
+      data_ += length;
+      return result;
+    } else {
+      Require(sizeof(T));
+      T result;
+      std::memcpy(&result, data_, sizeof(T));
+      data_ += sizeof(T);
+      return result;
+    }
+  }
+
+ private:
+  void Require(size_t size) const {
+    if (size > static_cast<size_t>(end_ - data_)) {
+      throw IOException("PLAIN encoded values exceed the Parquet page");
+    }
+  }
+
+  const char* data_;
+  const char* end_;
+  uint32_t bit_;
+};
+
+/**
+ * Decodes the pages of a column chunk that holds num_rows values of the
+ * physical type T. store(row, value) is called for every non-NULL value,
+ * set_null(row) for every NULL.
+ */
+template <class T, class STORE, class SET_NULL>
+void DecodeColumnChunk(const char* data, const char* end, size_t num_rows,
+                       bool optional, STORE store, SET_NULL set_null) {
+  std::vector<T> dictionary;
+  std::vector<uint32_t> levels;
+  std::vector<uint32_t> indexes;
+  size_t row = 0;
+  while (row < num_rows) {
+    if (data >= end) {
+      throw IOException("Parquet column chunk ends before its last value");
+    }
+    ParquetPageHeader header;
+    ThriftReader reader(data, static_cast<size_t>(end - data));
+    header.Read(reader);
+    auto page = data + reader.GetPosition();
+    if (header.compressed_page_size < 0 ||
+        static_cast<size_t>(header.compressed_page_size) >
+            static_cast<size_t>(end - page)) {
+      throw IOException("Parquet page exceeds the file");
+    }
+    auto page_end = page + header.compressed_page_size;
+    data          = page_end;
+
+    if (header.type == ParquetPageType::kDictionaryPage) {
+      PlainDecoder decoder(page, page_end);
+      dictionary.clear();
+      for (int32_t i = 0; i < header.num_values; i++) {
+        dictionary.push_back(decoder.Read<T>());
+      }
+      continue;
+    }
+    if (header.type == ParquetPageType::kIndexPage) {
+      continue;
+    }
+    if (header.type != ParquetPageType::kDataPage) {
+      throw NotImplementationException("Parquet page type %d is not supported",
+                                       static_cast<int>(header.type));
+    }
+    auto count = static_cast<size_t>(std::max(header.num_values, 0));
+    if (count > num_rows - row) {
+      throw IOException("Parquet column chunk holds more values than rows");
+    }
+
+    // the definition levels of optional columns, prefixed with their length
+    levels.assign(count, 1);
+    if (optional) {
+      uint32_t length;
+      if (page_end - page < 4) {
+        throw IOException("Definition levels exceed the Parquet page");
+      }
+      std::memcpy(&length, page, sizeof(length));
+      page += 4;
+      if (length > static_cast<size_t>(page_end - page)) {
+        throw IOException("Definition levels exceed the Parquet page");
+      }
+      RleBpDecoder(page, length, 1).Decode(levels.data(), count);
+      page += length;
+    }
+
+    switch (header.encoding) {
+      case ParquetEncoding::kPlain: {
+        PlainDecoder decoder(page, page_end);
+        for (size_t i = 0; i < count; i++) {
+          if (levels[i]) {
+            store(row + i, decoder.Read<T>());
+          } else {
+            set_null(row + i);
+          }
+        }
+        break;
+      }
+      case ParquetEncoding::kPlainDictionary:
+      case ParquetEncoding::kRleDictionary: {
+        if (page == page_end) {
+          throw IOException("Dictionary indexes exceed the Parquet page");
+        }
+        auto bit_width = static_cast<uint8_t>(*page++);
+        indexes.resize(static_cast<size_t>(
+            std::count(levels.begin(), levels.end(), 1u)));
+        RleBpDecoder(page, static_cast<size_t>(page_end - page), bit_width)
+            .Decode(indexes.data(), indexes.size());
+        size_t next = 0;
+        for (size_t i = 0; i < count; i++) {
+          if (!levels[i]) {
+            set_null(row + i);
+            continue;
+          }
+          auto index = indexes[next++];
+          if (index >= dictionary.size()) {
+            throw IOException("Dictionary index out of range in Parquet page");
+          }
+          store(row + i, dictionary[index]);
+        }
+        break;
+      }
+      default:
+        throw NotImplementationException(
+            "Parquet encoding %d is not supported",
+            static_cast<int>(header.encoding));
+    }
+    row += count;
+  }
+}
+
+/**
+ * Decode a column chunk of physical type PHYS into the column of the chunks,
+ * whose vectors hold values of type T. Numeric values are multiplied by
+ * scale.
+ */
+template <class PHYS, class T>
+void DecodeColumn(const char* data, const char* end, bool optional,
+                  std::vector<std::unique_ptr<DataChunk>>& chunks,
+                  size_t column, int64_t scale = 1) {
+  size_t rows = 0;
+  for (auto& chunk : chunks) {
+    rows += chunk->GetCount();
+  }
+  auto vector = [&](size_t row) -> Vector& {
+    return chunks[row / kStandardVectorSize]->GetVector(column);
+  };
+  auto store = [&](size_t row, PHYS value) {
+    Vector& target = vector(row);
+    auto index     = row % kStandardVectorSize;
+    if constexpr (std::is_same_v<PHYS, std::string_view>) {
+      target.GetData<T>()[index] =
+          target.AddString(value.data(), value.size());
+    } else if constexpr (std::is_integral_v<PHYS>) {
+      target.GetData<T>()[index] = static_cast<T>(value * scale);
+    } else {
+      target.GetData<T>()[index] = static_cast<T>(value);
+    }
+  };
+  auto set_null = [&](size_t row) {
+    Vector& target = vector(row);
+    auto index     = row % kStandardVectorSize;
+    target.SetNull(index, true);
+    if constexpr (std::is_same_v<PHYS, std::string_view>) {
+      target.GetData<T>()[index] = nullptr;
+    }
+  };
+  DecodeColumnChunk<PHYS>(data, end, rows, optional, store, set_null);
+}
+
+}  // namespace
+
+ParquetReader::ParquetReader(const std::string& path) : file_(path) {
+  auto data = file_.GetData();
+  auto size = file_.GetSize();
+  if (size < 12 || std::memcmp(data, kParquetMagic, 4) != 0 ||
+      std::memcmp(data + size - 4, kParquetMagic, 4) != 0) {
+    throw IOException("\"%s\" is not a Parquet file", path.c_str());
+  }
+  uint32_t footer_size;
+  std::memcpy(&footer_size, data + size - 8, sizeof(footer_size));
+  if (footer_size > size - 12) {
+    throw IOException("Corrupt metadata in Parquet file \"%s\"", path.c_str());
+  }
+  ThriftReader reader(data + size - 8 - footer_size, footer_size);
+  metadata_.Read(reader);
+
+  auto& schema = metadata_.schema;
+  if (schema.empty() ||
+      static_cast<size_t>(schema[0].num_children) != schema.size() - 1) {
+    throw NotImplementationException(
+        "Nested Parquet schemas are not supported");
+  }
+  for (size_t i = 1; i < schema.size(); i++) {
+    if (!schema[i].has_type || schema[i].num_children > 0 ||
+        schema[i].repetition == ParquetRepetition::kRepeated) {
+      throw NotImplementationException(
+          "Nested Parquet schemas are not supported");
+    }
+    types_.push_back(GetColumnType(schema[i]));
+    names_.push_back(schema[i].name);
+  }
+  for (auto& row_group : metadata_.row_groups) {
+    if (row_group.columns.size() != types_.size()) {
+      throw IOException("Corrupt metadata in Parquet file \"%s\"",
+                        path.c_str());
+    }
+  }
+}
+
+bool ParquetReader::RowGroupMayMatch(size_t row_group, size_t column,
+                                     ExpressionType comparison,
+                                     const Value& constant) const {
+  if (constant.IsNull()) {
+    // a comparison with NULL is never true
+    return false;
+  }
+  auto& meta_data = metadata_.row_groups[row_group].columns[column].meta_data;
+  if (!meta_data.has_statistics) {
+    return true;
+  }
+  auto& statistics = meta_data.statistics;
+  if (statistics.null_count == meta_data.num_values) {
+    return false;
+  }
+  if (!statistics.has_min_max) {
+    return true;
+  }
+
+  auto& element = metadata_.schema[column + 1];
+  auto type     = types_[column];
+  auto decode   = [&](const std::string& bytes) {
+    PlainDecoder decoder(bytes.data(), bytes.data() + bytes.size());
+    switch (element.type) {
+      case ParquetType::kBoolean:
+        return Value::Boolean(decoder.Read<bool>());
+      case ParquetType::kInt32: {
+        auto value = decoder.Read<int32_t>();
+        return type == TypeId::kDate ? Value::Date(value)
+                                     : Value::Numeric(type, value);
+      }
+      case ParquetType::kInt64: {
+        auto value = decoder.Read<int64_t>();
+        return type == TypeId::kTimestamp
+                   ? Value::Timestamp(value * TimestampScale(element))
+                   : Value::BigInt(value);
+      }
+      case ParquetType::kFloat:
+        return Value::Decimal(decoder.Read<float>());
+      case ParquetType::kDouble:
+        return Value::Decimal(decoder.Read<double>());
+      default:
+        return Value::VarChar(bytes);
+    }
+  };
+  try {
+    auto min = decode(statistics.min_value);
+    auto max = decode(statistics.max_value);
+    switch (comparison) {
+      case ExpressionType::kCompareEqual:
+        return min <= constant && constant <= max;
+      case ExpressionType::kCompareLessThan:
+        return min < constant;
+      case ExpressionType::kCompareLessThanOrEqualTo:
+        return min <= constant;
+      case ExpressionType::kCompareGreaterThan:
+        return max > constant;
+      case ExpressionType::kCompareGreaterThanOrEqualTo:
+        return max >= constant;
+      default:
+        return true;
+    }
+  } catch (Exception&) {
+    // statistics that cannot be decoded or compared do not prune
+    return true;
+  }
+}
+
+void ParquetReader::ReadRowGroup(
+    size_t row_group, const std::vector<size_t>& column_ids,
+    std::vector<std::unique_ptr<DataChunk>>& chunks) const {
+  std::vector<TypeId> types;
+  for (auto column : column_ids) {
+    types.push_back(types_[column]);
+  }
+  auto& group = metadata_.row_groups[row_group];
+  auto rows   = static_cast<size_t>(std::max<int64_t>(group.num_rows, 0));
+  chunks.clear();
+  for (size_t offset = 0; offset < rows; offset += kStandardVectorSize) {
+    auto chunk = std::make_unique<DataChunk>();
+    chunk->Initialize(types);
+    for (size_t i = 0; i < types.size(); i++) {
+      chunk->GetVector(i).SetCount(
+          std::min(kStandardVectorSize, rows - offset));
+    }
+    chunks.push_back(std::move(chunk));
+  }
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    ReadColumn(group.columns[column_ids[i]], column_ids[i], i, chunks);
+  }
+}
+
+void ParquetReader::Prefetch(size_t row_group,
+                             const std::vector<size_t>& column_ids) const {
+  auto& group = metadata_.row_groups[row_group];
+  for (auto column : column_ids) {
+    auto& meta_data = group.columns[column].meta_data;
+    auto start      = meta_data.data_page_offset;
+    if (meta_data.has_dictionary_page &&
+        meta_data.dictionary_page_offset > 0) {
+      start = std::min(start, meta_data.dictionary_page_offset);
+    }
+    if (start < 0 || meta_data.total_compressed_size <= 0) {
+      // corrupt offsets are reported when the column is read
+      continue;
+    }
+    file_.Prefetch(static_cast<size_t>(start),
+                   static_cast<size_t>(meta_data.total_compressed_size));
+  }
+}
+
+void ParquetReader::ReadColumn(
+    const ParquetColumnChunk& column_chunk, size_t column, size_t column_index,
+    std::vector<std::unique_ptr<DataChunk>>& chunks) const {
+  auto& meta_data = column_chunk.meta_data;
+  if (meta_data.codec != ParquetCompression::kUncompressed) {
+    throw NotImplementationException(
+        "Compressed Parquet files are not supported");
+  }
+  auto start = meta_data.data_page_offset;
+  if (meta_data.has_dictionary_page && meta_data.dictionary_page_offset > 0) {
+    start = std::min(start, meta_data.dictionary_page_offset);
+  }
+  auto file_size = static_cast<int64_t>(file_.GetSize());
+  if (start < 4 || start >= file_size) {
+    throw IOException("Corrupt column offset in Parquet file \"%s\"",
+                      file_.GetPath().c_str());
+  }
+  auto data = file_.GetData() + start;
+  auto end  = file_.GetData() + file_.GetSize();
+
+  auto& element = metadata_.schema[column + 1];
+  bool optional = element.repetition == ParquetRepetition::kOptional;
+  switch (types_[column]) {
+    case TypeId::kBoolean:
+      DecodeColumn<bool, int8_t>(data, end, optional, chunks, column_index);
+      break;
+    case TypeId::kTinyInt:
+      DecodeColumn<int32_t, int8_t>(data, end, optional, chunks,
+                                    column_index);
+      break;
+    case TypeId::kSmallInt:
+      DecodeColumn<int32_t, int16_t>(data, end, optional, chunks,
+                                     column_index);
+      break;
+    case TypeId::kInteger:
+    case TypeId::kDate:
+      DecodeColumn<int32_t, int32_t>(data, end, optional, chunks,
+                                     column_index);
+      break;
+    case TypeId::kBigInt:
+      DecodeColumn<int64_t, int64_t>(data, end, optional, chunks,
+                                     column_index);
+      break;
+    case TypeId::kTimestamp:
+      DecodeColumn<int64_t, int64_t>(data, end, optional, chunks,
+                                     column_index, TimestampScale(element));
+      break;
+    case TypeId::kDecimal:
+      if (element.type == ParquetType::kFloat) {
+        DecodeColumn<float, double>(data, end, optional, chunks,
+                                    column_index);
+      } else {
+        DecodeColumn<double, double>(data, end, optional, chunks,
+                                     column_index);
+      }
+      break;
+    case TypeId::kVarChar:
+      DecodeColumn<std::string_view, const char*>(data, end, optional, chunks,
+                                                  column_index);
+      break;
+    default:
+      throw NotImplementationException("Unimplemented type %s for Parquet",
+                                       TypeIdToString(types_[column]).c_str());
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,452 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/parquet/parquet_writer.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "common/exception.hpp"
+#include "common/parallel.hpp"
+#include "common/types/chunk_collection.hpp"
+#include "storage/parquet/rle_bp_encoding.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+constexpr size_t kRowGroupChunks =
+    ParquetWriter::kRowGroupSize / kStandardVectorSize;
+constexpr char kParquetMagic[] = "PAR1";
+
+// values are stored little endian, as on all supported platforms
+template <class T>
+void AppendRaw(std::string& buffer, T value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+void PlainEncode(std::string& buffer, const T& value) {
+  AppendRaw(buffer, value);
+}
+
+void PlainEncode(std::string& buffer, const std::string_view& value) {
+  AppendRaw(buffer, static_cast<uint32_t>(value.size()));
+  buffer.append(value);
+}
+
+/**
+ * Encode the minimum or maximum of the statistics: PLAIN, but without the
+ * length prefix for strings.
+ */
+template <class T>
+std::string EncodeStatistic(const T& value) {
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    return std::string(value);
+  } else {
+    std::string result;
+    PlainEncode(result, value);
+    return result;
+  }
+}
+
+/**
+ * Returns the number of bits required to store max_value, at least one.
+ */
+uint8_t BitWidth(size_t max_value) {
+  uint8_t width = 1;
+  while (width < 32 && (max_value >> width) != 0) {
+    width++;
+  }
+  return width;
+}
+
+void GetParquetType(TypeId type, ParquetType& parquet_type,
+                    ParquetConvertedType& converted_type) {
+  converted_type = ParquetConvertedType::kNone;
+  switch (type) {
+    case TypeId::kBoolean:
+      parquet_type = ParquetType::kBoolean;
+      break;
+    case TypeId::kTinyInt:
+      parquet_type   = ParquetType::kInt32;
+      converted_type = ParquetConvertedType::kInt8;
+      break;
+    case TypeId::kSmallInt:
+      parquet_type   = ParquetType::kInt32;
+      converted_type = ParquetConvertedType::kInt16;
+      break;
+    case TypeId::kInteger:
+      parquet_type = ParquetType::kInt32;
+      break;
+    case TypeId::kBigInt:
+      parquet_type = ParquetType::kInt64;
+      break;
+    case TypeId::kDecimal:
+      parquet_type = ParquetType::kDouble;
+      break;
+    case TypeId::kDate:
+      parquet_type   = ParquetType::kInt32;
+      converted_type = ParquetConvertedType::kDate;
+      break;
+    case TypeId::kTimestamp:
+      parquet_type   = ParquetType::kInt64;
+      converted_type = ParquetConvertedType::kTimestampMicros;
+      break;
+    case TypeId::kVarChar:
+      parquet_type   = ParquetType::kByteArray;
+      converted_type = ParquetConvertedType::kUTF8;
+      break;
+    default:
+      throw NotImplementationException("Unimplemented type %s for Parquet",
+                                       TypeIdToString(type).c_str());
+  }
+}
+
+void WritePage(std::string& buffer, ParquetPageType type, size_t num_values,
+               ParquetEncoding encoding, const std::string& page) {
+  ParquetPageHeader header;
+  header.type                   = type;
+  header.uncompressed_page_size = static_cast<int32_t>(page.size());
+  header.compressed_page_size   = static_cast<int32_t>(page.size());
+  header.num_values             = static_cast<int32_t>(num_values);
+  header.encoding               = encoding;
+  ThriftWriter writer(buffer);
+  header.Write(writer);
+  buffer += page;
+}
+
+/**
+ * Encodes one column of a row group, SRC is the type of the vector and DST
+ * the physical type in the file.
+ */
+template <class SRC, class DST>
+class ColumnChunkWriter {
+ public:
+  ColumnChunkWriter(ParquetColumnMetaData& meta_data, std::string& buffer)
+      : meta_data_(meta_data), buffer_(buffer) {}
+
+  void Append(const Vector& vector) {
+    auto data = vector.GetData<SRC>();
+    for (size_t i = 0; i < vector.GetCount(); i++) {
+      levels_.push_back(!vector.IsNull(i));
+      if (!vector.IsNull(i)) {
+        values_.push_back(static_cast<DST>(data[i]));
+      }
+    }
+  }
+
+  void Finish() {
+    auto start = buffer_.size();
+    WriteStatistics();
+
+    // the definition levels, prefixed with their length
+    std::string levels;
+    RleBpEncoder::Encode(levels_.data(), levels_.size(), 1, levels);
+    std::string page;
+    AppendRaw(page, static_cast<uint32_t>(levels.size()));
+    page += levels;
+
+    ParquetEncoding encoding;
+    std::vector<uint32_t> indexes;
+    std::vector<DST> dictionary;
+    if (BuildDictionary(indexes, dictionary)) {
+      std::string dictionary_page;
+      for (auto& value : dictionary) {
+        PlainEncode(dictionary_page, value);
+      }
+      meta_data_.has_dictionary_page    = true;
+      meta_data_.dictionary_page_offset = static_cast<int64_t>(start);
+      WritePage(buffer_, ParquetPageType::kDictionaryPage, dictionary.size(),
+                ParquetEncoding::kPlainDictionary, dictionary_page);
+
+      auto bit_width = BitWidth(dictionary.size() - 1);
+      page += static_cast<char>(bit_width);
+      RleBpEncoder::Encode(indexes.data(), indexes.size(), bit_width, page);
+      encoding = ParquetEncoding::kPlainDictionary;
+    } else {
+      for (auto& value : values_) {
+        PlainEncode(page, value);
+      }
+      encoding = ParquetEncoding::kPlain;
+    }
+    meta_data_.data_page_offset = static_cast<int64_t>(buffer_.size());
+    WritePage(buffer_, ParquetPageType::kDataPage, levels_.size(), encoding,
+              page);
+
+    meta_data_.encodings  = {encoding, ParquetEncoding::kRle};
+    meta_data_.num_values = static_cast<int64_t>(levels_.size());
+    meta_data_.total_uncompressed_size =
+        static_cast<int64_t>(buffer_.size() - start);
+    meta_data_.total_compressed_size = meta_data_.total_uncompressed_size;
+  }
+
+ private:
+  void WriteStatistics() {
+    auto& statistics          = meta_data_.statistics;
+    meta_data_.has_statistics = true;
+    statistics.null_count =
+        static_cast<int64_t>(levels_.size() - values_.size());
+    if (!values_.empty()) {
+      auto [min, max] = std::minmax_element(values_.begin(), values_.end());
+      statistics.has_min_max = true;
+      statistics.min_value   = EncodeStatistic(*min);
+      statistics.max_value   = EncodeStatistic(*max);
+    }
+  }
+
+  /**
+   * Build the dictionary of the values, returns false if the values are
+   * too diverse for a dictionary.
+   */
+  bool BuildDictionary(std::vector<uint32_t>& indexes,
+                       std::vector<DST>& dictionary) {
+    if (values_.empty()) {
+      return false;
+    }
+    std::unordered_map<DST, uint32_t> map;
+    indexes.reserve(values_.size());
+    for (auto& value : values_) {
+      auto entry = map.emplace(value, static_cast<uint32_t>(map.size()));
+      if (map.size() > ParquetWriter::kMaxDictionarySize) {
+        return false;
+      }
+      indexes.push_back(entry.first->second);
+    }
+    dictionary.resize(map.size());
+    for (auto& entry : map) {
+      dictionary[entry.second] = entry.first;
+    }
+    return true;
+  }
+
+  ParquetColumnMetaData& meta_data_;
+  std::string& buffer_;
+  std::vector<uint32_t> levels_;
+  std::vector<DST> values_;
+};
+
+/**
+ * Booleans are PLAIN encoded as a bitmap, a dictionary does not pay off.
+ */
+void EncodeBooleanColumn(const ChunkCollection& collection, size_t begin,
+                         size_t end, size_t column,
+                         ParquetColumnMetaData& meta_data,
+                         std::string& buffer) {
+  std::vector<uint32_t> levels;
+  std::string values;
+  size_t count = 0;
+  int8_t min   = 1;
+  int8_t max   = 0;
+  for (auto i = begin; i < end; i++) {
+    auto& vector = collection.GetChunk(i).GetVector(column);
+    auto data    = vector.GetData<int8_t>();
+    for (size_t row = 0; row < vector.GetCount(); row++) {
+      levels.push_back(!vector.IsNull(row));
+      if (vector.IsNull(row)) {
+        continue;
+      }
+      int8_t value = data[row] != 0;
+      if (count % 8 == 0) {
+        values += '\0';
+      }
+      values.back() = static_cast<char>(values.back() | value << (count % 8));
+      min           = std::min(min, value);
+      max           = std::max(max, value);
+      count++;
+    }
+  }
+
+  auto start               = buffer.size();
+  meta_data.has_statistics = true;
+  meta_data.statistics.null_count =
+      static_cast<int64_t>(levels.size() - count);
+  if (count > 0) {
+    meta_data.statistics.has_min_max = true;
+    meta_data.statistics.min_value   = EncodeStatistic(min);
+    meta_data.statistics.max_value   = EncodeStatistic(max);
+  }
+
+  std::string encoded_levels;
+  RleBpEncoder::Encode(levels.data(), levels.size(), 1, encoded_levels);
+  std::string page;
+  AppendRaw(page, static_cast<uint32_t>(encoded_levels.size()));
+  page += encoded_levels;
+  page += values;
+  meta_data.data_page_offset = static_cast<int64_t>(start);
+  WritePage(buffer, ParquetPageType::kDataPage, levels.size(),
+            ParquetEncoding::kPlain, page);
+
+  meta_data.encodings  = {ParquetEncoding::kPlain, ParquetEncoding::kRle};
+  meta_data.num_values = static_cast<int64_t>(levels.size());
+  meta_data.total_uncompressed_size =
+      static_cast<int64_t>(buffer.size() - start);
+  meta_data.total_compressed_size = meta_data.total_uncompressed_size;
+}
+
+template <class SRC, class DST>
+void EncodeColumn(const ChunkCollection& collection, size_t begin,
+                  size_t end, size_t column, ParquetColumnMetaData& meta_data,
+                  std::string& buffer) {
+  ColumnChunkWriter<SRC, DST> writer(meta_data, buffer);
+  for (auto i = begin; i < end; i++) {
+    writer.Append(collection.GetChunk(i).GetVector(column));
+  }
+  writer.Finish();
+}
+
+/**
+ * Encode the chunks [begin, end) of the collection as a row group. The
+ * offsets in the metadata are relative to the start of the buffer.
+ */
+void EncodeRowGroup(const ChunkCollection& collection, size_t begin,
+                    size_t end, const std::vector<ParquetSchemaElement>& schema,
+                    ParquetRowGroup& row_group, std::string& buffer) {
+  auto types = collection.GetTypes();
+  for (auto i = begin; i < end; i++) {
+    row_group.num_rows +=
+        static_cast<int64_t>(collection.GetChunk(i).GetCount());
+  }
+  row_group.columns.resize(types.size());
+  for (size_t column = 0; column < types.size(); column++) {
+    auto& meta_data = row_group.columns[column].meta_data;
+    meta_data.type  = schema[column + 1].type;
+    meta_data.path_in_schema.push_back(schema[column + 1].name);
+    switch (types[column]) {
+      case TypeId::kBoolean:
+        EncodeBooleanColumn(collection, begin, end, column, meta_data, buffer);
+        break;
+      case TypeId::kTinyInt:
+        EncodeColumn<int8_t, int32_t>(collection, begin, end, column,
+                                      meta_data, buffer);
+        break;
+      case TypeId::kSmallInt:
+        EncodeColumn<int16_t, int32_t>(collection, begin, end, column,
+                                       meta_data, buffer);
+        break;
+      case TypeId::kInteger:
+      case TypeId::kDate:
+        EncodeColumn<int32_t, int32_t>(collection, begin, end, column,
+                                       meta_data, buffer);
+        break;
+      case TypeId::kBigInt:
+      case TypeId::kTimestamp:
+        EncodeColumn<int64_t, int64_t>(collection, begin, end, column,
+                                       meta_data, buffer);
+        break;
+      case TypeId::kDecimal:
+        EncodeColumn<double, double>(collection, begin, end, column,
+                                     meta_data, buffer);
+        break;
+      case TypeId::kVarChar:
+        EncodeColumn<const char*, std::string_view>(collection, begin, end,
+                                                    column, meta_data, buffer);
+        break;
+      default:
+        throw NotImplementationException(
+            "Unimplemented type %s for Parquet",
+            TypeIdToString(types[column]).c_str());
+    }
+    row_group.columns[column].file_offset =
+        meta_data.has_dictionary_page ? meta_data.dictionary_page_offset
+                                      : meta_data.data_page_offset;
+    row_group.total_byte_size += meta_data.total_uncompressed_size;
+  }
+}
+
+}  // namespace
+
+ParquetWriter::ParquetWriter(const std::string& path,
+                             std::vector<TypeId> types,
+                             std::vector<std::string> names)
+    : path_(path),
+      types_(std::move(types)),
+      file_(path, std::ios::binary | std::ios::trunc),
+      offset_(0) {
+  if (!file_) {
+    throw IOException("Could not open file \"%s\" for writing", path.c_str());
+  }
+  auto& root = metadata_.schema.emplace_back();
+  root.name         = "schema";
+  root.num_children = static_cast<int32_t>(types_.size());
+  for (size_t i = 0; i < types_.size(); i++) {
+    auto& element    = metadata_.schema.emplace_back();
+    element.has_type = true;
+    element.name     = names[i];
+    GetParquetType(types_[i], element.type, element.converted_type);
+  }
+  metadata_.created_by = "zoomdb";
+
+  file_.write(kParquetMagic, 4);
+  offset_ = 4;
+}
+
+void ParquetWriter::Write(const ChunkCollection& collection,
+                          size_t thread_count) {
+  if (collection.GetCount() == 0) {
+    return;
+  }
+  if (collection.GetTypes() != types_) {
+    throw TypeMismatchException("Writing rows of different types to Parquet",
+                                types_[0], collection.GetTypes()[0]);
+  }
+  auto group_count =
+      (collection.ChunkCount() + kRowGroupChunks - 1) / kRowGroupChunks;
+  std::vector<ParquetRowGroup> row_groups(group_count);
+  std::vector<std::string> buffers(group_count);
+  std::vector<std::exception_ptr> errors(group_count);
+  ParallelFor(group_count, thread_count, [&](size_t i) {
+    auto begin = i * kRowGroupChunks;
+    auto end   = std::min(begin + kRowGroupChunks, collection.ChunkCount());
+    try {
+      EncodeRowGroup(collection, begin, end, metadata_.schema, row_groups[i],
+                     buffers[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  });
+
+  for (size_t i = 0; i < group_count; i++) {
+    if (errors[i]) {
+      std::rethrow_exception(errors[i]);
+    }
+    // the row group is placed at the current end of the file
+    for (auto& column : row_groups[i].columns) {
+      column.file_offset += offset_;
+      column.meta_data.data_page_offset += offset_;
+      if (column.meta_data.has_dictionary_page) {
+        column.meta_data.dictionary_page_offset += offset_;
+      }
+    }
+    file_.write(buffers[i].data(),
+                static_cast<std::streamsize>(buffers[i].size()));
+    offset_ += static_cast<int64_t>(buffers[i].size());
+    metadata_.num_rows += row_groups[i].num_rows;
+    metadata_.row_groups.push_back(std::move(row_groups[i]));
+  }
+  if (!file_) {
+    throw IOException("Could not write to file \"%s\"", path_.c_str());
+  }
+}
+
+void ParquetWriter::Finalize() {
+  std::string footer;
+  ThriftWriter writer(footer);
+  metadata_.Write(writer);
+  AppendRaw(footer, static_cast<uint32_t>(footer.size()));
+  footer.append(kParquetMagic, 4);
+  file_.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+  file_.close();
+  if (!file_) {
+    throw IOException("Could not write to file \"%s\"", path_.c_str());
+  }
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,154 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/parquet/rle_bp_encoding.hpp"
+
+#include <algorithm>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+void WriteVarint(uint64_t value, std::string& buffer) {
+  while (value >= 0x80) {
+    buffer += static_cast<char>(value | 0x80);
+    value >>= 7;
+  }
+  buffer += static_cast<char>(value);
+}
+
+size_t RunLength(const uint32_t* values, size_t start, size_t count) {
+  auto end = start + 1;
+  while (end < count && values[end] == values[start]) {
+    end++;
+  }
+  return end - start;
+}
+
+}  // namespace
+
+void RleBpEncoder::Encode(const uint32_t* values, size_t count,
+                          uint8_t bit_width, std::string& buffer) {
+  auto value_bytes = (bit_width + 7u) / 8;
+  size_t i         = 0;
+  while (i < count) {
+    auto run = RunLength(values, i, count);
+    if (run >= 8) {
+      WriteVarint(run << 1, buffer);
+      for (size_t byte = 0; byte < value_bytes; byte++) {
+        buffer += static_cast<char>(values[i] >> (8 * byte));
+      }
+      i += run;
+      continue;
+    }
+    // bit-pack groups of 8 values until a run starts, the last group is
+    // padded with zeros
+    auto start    = i;
+    size_t groups = 0;
+    while (i < count && (groups == 0 || RunLength(values, i, count) < 8)) {
+      i += 8;
+      groups++;
+    }
+    WriteVarint(groups << 1 | 1, buffer);
+    uint64_t bits = 0;
+    uint32_t used = 0;
+    for (auto j = start; j < start + groups * 8; j++) {
+      bits |= static_cast<uint64_t>(j < count ? values[j] : 0) << used;
+      used += bit_width;
+      while (used >= 8) {
+        buffer += static_cast<char>(bits);
+        bits >>= 8;
+        used -= 8;
+      }
+    }
+  }
+}
+
+RleBpDecoder::RleBpDecoder(const char* data, size_t size, uint8_t bit_width)
+    : data_(reinterpret_cast<const uint8_t*>(data)),
+      end_(reinterpret_cast<const uint8_t*>(data) + size),
+      bit_width_(bit_width),
+      rle_remaining_(0),
+      rle_value_(0),
+      packed_remaining_(0),
+      packed_bit_(0) {
+  if (bit_width > 32) {
+    throw IOException("Invalid bit width %d in Parquet page",
+                      static_cast<int>(bit_width));
+  }
+}
+
+void RleBpDecoder::Decode(uint32_t* values, size_t count) {
+  size_t i = 0;
+  while (i < count) {
+    if (rle_remaining_ > 0) {
+      auto n = std::min(rle_remaining_, count - i);
+      std::fill(values + i, values + i + n, rle_value_);
+      rle_remaining_ -= n;
+      i += n;
+    } else if (packed_remaining_ > 0) {
+      values[i++] = NextPacked();
+      packed_remaining_--;
+    } else {
+      NextRun();
+    }
+  }
+}
+
+void RleBpDecoder::NextRun() {
+  // skip the remainder of the previous bit-packed run
+  data_ += (packed_bit_ + 7) / 8;
+  packed_bit_ = 0;
+
+  uint64_t header = 0;
+  for (uint32_t shift = 0;; shift += 7) {
+    if (data_ == end_ || shift >= 64) {
+      throw IOException("Corrupt RLE run in Parquet page");
+    }
+    auto byte = *data_++;
+    header |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+  if (header & 1) {
+    auto groups = header >> 1;
+    if (groups * bit_width_ > static_cast<size_t>(end_ - data_)) {
+      throw IOException("Bit-packed run exceeds the Parquet page");
+    }
+    packed_remaining_ = groups * 8;
+  } else {
+    auto value_bytes = (bit_width_ + 7u) / 8;
+    if (value_bytes > static_cast<size_t>(end_ - data_)) {
+      throw IOException("RLE run exceeds the Parquet page");
+    }
+    rle_remaining_ = header >> 1;
+    rle_value_     = 0;
+    for (uint32_t byte = 0; byte < value_bytes; byte++) {
+      rle_value_ |= static_cast<uint32_t>(*data_++) << (8 * byte);
+    }
+    if (rle_remaining_ == 0) {
+      throw IOException("Empty RLE run in Parquet page");
+    }
+  }
+}
+
+uint32_t RleBpDecoder::NextPacked() {
+  auto byte     = packed_bit_ / 8;
+  auto shift    = packed_bit_ % 8;
+  uint64_t bits = 0;
+  for (size_t i = 0; i * 8 < shift + bit_width_; i++) {
+    bits |= static_cast<uint64_t>(data_[byte + i]) << (8 * i);
+  }
+  packed_bit_ += bit_width_;
+  return static_cast<uint32_t>((bits >> shift) &
+                               ((uint64_t{1} << bit_width_) - 1));
+}
+
+}  // namespace zoomdb
@@ -0,0 +1,233 @@
+/**
+ * ZoomDB is a SQL database management system.
+ * Copyright (c) 2024, Niz <mn@furzoom.com>, Furzoom.com
+ * https://furzoom.com
+ * https://github.com/deiio/zoomdb
+ */
+
+#include "storage/parquet/thrift_compact.hpp"
+
+#include <cstring>
+
+#include "common/exception.hpp"
+
+namespace zoomdb {
+
+namespace {
+
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+}  // namespace
+
+ThriftWriter::ThriftWriter(std::string& buffer) : buffer_(buffer) {}
+
+void ThriftWriter::StructBegin() { last_field_ids_.push_back(0); }
+
+void ThriftWriter::StructEnd() {
+  buffer_ += static_cast<char>(ThriftType::kStop);
+  last_field_ids_.pop_back();
+}
+
+void ThriftWriter::FieldBool(int16_t id, bool value) {
+  FieldHeader(id, value ? ThriftType::kBoolTrue : ThriftType::kBoolFalse);
+}
+
+void ThriftWriter::FieldI32(int16_t id, int32_t value) {
+  FieldHeader(id, ThriftType::kI32);
+  I32(value);
+}
+
+void ThriftWriter::FieldI64(int16_t id, int64_t value) {
+  FieldHeader(id, ThriftType::kI64);
+  Varint(ZigZag(value));
+}
+
+void ThriftWriter::FieldBinary(int16_t id, const std::string& value) {
+  FieldHeader(id, ThriftType::kBinary);
+  Binary(value);
+}
+
+void ThriftWriter::FieldStruct(int16_t id) {
+  FieldHeader(id, ThriftType::kStruct);
+}
+
+void ThriftWriter::FieldList(int16_t id, ThriftType element_type,
+                             size_t size) {
+  FieldHeader(id, ThriftType::kList);
+  auto type = static_cast<uint8_t>(element_type);
+  if (size < 15) {
+    buffer_ += static_cast<char>(size << 4 | type);
+  } else {
+    buffer_ += static_cast<char>(0xF0 | type);
+    Varint(size);
+  }
+}
+
+void ThriftWriter::I32(int32_t value) { Varint(ZigZag(value)); }
+
+void ThriftWriter::Binary(const std::string& value) {
+  Varint(value.size());
+  buffer_ += value;
+}
+
+void ThriftWriter::FieldHeader(int16_t id, ThriftType type) {
+  auto& last = last_field_ids_.back();
+  auto delta = id - last;
+  if (delta > 0 && delta <= 15) {
+    buffer_ += static_cast<char>(delta << 4 | static_cast<uint8_t>(type));
+  } else {
+    buffer_ += static_cast<char>(type);
+    Varint(ZigZag(id));
+  }
+  last = id;
+}
+
+void ThriftWriter::Varint(uint64_t value) {
+  while (value >= 0x80) {
+    buffer_ += static_cast<char>(value | 0x80);
+    value >>= 7;
+  }
+  buffer_ += static_cast<char>(value);
+}
+
+ThriftReader::ThriftReader(const char* data, size_t size)
+    : data_(reinterpret_cast<const uint8_t*>(data)),
+      size_(size),
+      position_(0) {}
+
+void ThriftReader::StructBegin() { last_field_ids_.push_back(0); }
+
+void ThriftReader::StructEnd() { last_field_ids_.pop_back(); }
+
+bool ThriftReader::NextField(int16_t& id, ThriftType& type) {
+  auto header = Byte();
+  if (header == 0) {
+    return false;
+  }
+  type       = static_cast<ThriftType>(header & 0x0F);
+  auto delta = header >> 4;
+  auto& last = last_field_ids_.back();
+  if (delta != 0) {
+    id = static_cast<int16_t>(last + delta);
+  } else {
+    id = static_cast<int16_t>(UnZigZag(Varint()));
+  }
+  last = id;
+  return true;
+}
+
+int32_t ThriftReader::I32() { return static_cast<int32_t>(I64()); }
+
+int64_t ThriftReader::I64() { return UnZigZag(Varint()); }
+
+std::string ThriftReader::Binary() {
+  auto length = Varint();
+  if (length > size_ - position_) {
+    throw IOException("Corrupt Thrift data: string exceeds the buffer");
+  }
+  std::string result(reinterpret_cast<const char*>(data_ + position_),
+                     length);
+  position_ += length;
+  return result;
+}
+
+size_t ThriftReader::List(ThriftType& element_type) {
+  auto header  = Byte();
+  element_type = static_cast<ThriftType>(header & 0x0F);
+  size_t size  = header >> 4;
+  if (size == 15) {
+    size = Varint();
+  }
+  return size;
+}
+
+void ThriftReader::Skip(ThriftType type) {
+  switch (type) {
+    case ThriftType::kBoolTrue:
+    case ThriftType::kBoolFalse:
+      break;
+    case ThriftType::kByte:
+      Byte();
+      break;
+    case ThriftType::kI16:
+    case ThriftType::kI32:
+    case ThriftType::kI64:
+      Varint();
+      break;
+    case ThriftType::kDouble:
+      if (size_ - position_ < sizeof(double)) {
+        throw IOException("Corrupt Thrift data: double exceeds the buffer");
+      }
+      position_ += sizeof(double);
+      break;
+    case ThriftType::kBinary:
+      Binary();
+      break;
+    case ThriftType::kList:
+    case ThriftType::kSet: {
+      ThriftType element_type;
+      auto size = List(element_type);
+      for (size_t i = 0; i < size; i++) {
+        // booleans inside collections take a byte each
+        Skip(element_type == ThriftType::kBoolTrue ? ThriftType::kByte
+                                                   : element_type);
+      }
+      break;
+    }
+    case ThriftType::kMap: {
+      auto size = Varint();
+      if (size == 0) {
+        break;
+      }
+      auto types      = Byte();
+      auto key_type   = static_cast<ThriftType>(types >> 4);
+      auto value_type = static_cast<ThriftType>(types & 0x0F);
+      for (size_t i = 0; i < size; i++) {
+        Skip(key_type);
+        Skip(value_type);
+      }
+      break;
+    }
+    case ThriftType::kStruct: {
+      StructBegin();
+      int16_t id;
+      ThriftType field_type;
+      while (NextField(id, field_type)) {
+        Skip(field_type);
+      }
+      StructEnd();
+      break;
+    }
+    default:
+      throw IOException("Corrupt Thrift data: unknown type %d",
+                        static_cast<int>(type));
+  }
+}
+
+uint8_t ThriftReader::Byte() {
+  if (position_ >= size_) {
+    throw IOException("Corrupt Thrift data: read past the end of the buffer");
+  }
+  return data_[position_++];
+}
+
+uint64_t ThriftReader::Varint() {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    auto byte = Byte();
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return result;
+    }
+  }
+  throw IOException("Corrupt Thrift data: varint is too long");
+}
+
+}  // namespace zoomdb
@@ -7,9 +7,780 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "zoomdb.h"
+#include "zoomdb.hpp"
 #include "common/exception.hpp"
 #include "common/internal-types.hpp"
+#include "common/lz4.hpp"
+#include "common/types/data_chunk.hpp"
+#include "main/appender.hpp"
+#include "main/pg_protocol.hpp"
+#include "main/wire_protocol.hpp"
+
+namespace {
+
+constexpr int kStressThreads = 64;
+constexpr int kStressRows    = 50;
+
+/**
+ * Run a query, counting a failure.
+ */
+void StressQuery(zoomdb_connection connection, const char* query,
+                 std::atomic<int>& failures) {
+  zoomdb_result result;
+  if (zoomdb_query(connection, query, &result) != kZoomDBSuccess) {
+    fprintf(stderr, "Stress query failed: %s\n", query);
+    failures++;
+  }
+}
+
+/**
+ * Every thread inserts, reads, updates and deletes rows of its own in a
+ * shared table through a connection of its own, while some threads create
+ * and drop tables. The final contents of the shared table are checked
+ * against the outcome of running the threads one after the other.
+ */
+bool StressTest(zoomdb_database database) {
+  zoomdb_connection connection;
+  if (zoomdb_connect(database, &connection) != kZoomDBSuccess) {
+    return false;
+  }
+  std::atomic<int> failures(0);
+  StressQuery(connection, "CREATE TABLE stress (t INTEGER, k INTEGER, "
+              "v INTEGER);", failures);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kStressThreads; t++) {
+    threads.emplace_back([database, t, &failures]() {
+      zoomdb_connection thread_connection;
+      if (zoomdb_connect(database, &thread_connection) != kZoomDBSuccess) {
+        failures++;
+        return;
+      }
+      char query[256];
+      for (int k = 0; k < kStressRows; k++) {
+        snprintf(query, sizeof(query),
+                 "INSERT INTO stress VALUES (%d, %d, %d);", t, k, k);
+        StressQuery(thread_connection, query, failures);
+        snprintf(query, sizeof(query),
+                 "SELECT count(*), sum(v) FROM stress WHERE t = %d;", t);
+        StressQuery(thread_connection, query, failures);
+        if (k % 10 == 9) {
+          snprintf(query, sizeof(query),
+                   "UPDATE stress SET v = v + 1 WHERE t = %d;", t);
+          StressQuery(thread_connection, query, failures);
+          snprintf(query, sizeof(query),
+                   "DELETE FROM stress WHERE t = %d AND k = %d;", t, k - 5);
+          StressQuery(thread_connection, query, failures);
+        }
+        if (t % 16 == 0 && k % 10 == 0) {
+          snprintf(query, sizeof(query),
+                   "CREATE TABLE stress_%d_%d (a INTEGER);", t, k);
+          StressQuery(thread_connection, query, failures);
+          snprintf(query, sizeof(query), "DROP TABLE stress_%d_%d;", t, k);
+          StressQuery(thread_connection, query, failures);
+        }
+      }
+      zoomdb_disconnect(thread_connection);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // the rows of one thread, as they end up
+  int64_t expected_count = 0;
+  int64_t expected_sum   = 0;
+  std::vector<int> values;
+  for (int k = 0; k < kStressRows; k++) {
+    values.push_back(k);
+    if (k % 10 == 9) {
+      for (auto& value : values) {
+        value += value >= 0 ? 1 : 0;
+      }
+      values[static_cast<size_t>(k - 5)] = -1;
+    }
+  }
+  for (auto value : values) {
+    if (value >= 0) {
+      expected_count += kStressThreads;
+      expected_sum += static_cast<int64_t>(value) * kStressThreads;
+    }
+  }
+
+  ArrowSchema schema;
+  ArrowArray array;
+  bool success = failures == 0 &&
+                 zoomdb_query_arrow(connection,
+                                    "SELECT count(*), sum(v) FROM stress;",
+                                    &schema, &array) == kZoomDBSuccess;
+  if (success) {
+    auto count = static_cast<const int64_t*>(array.children[0]->buffers[1]);
+    auto sum   = static_cast<const int64_t*>(array.children[1]->buffers[1]);
+    success    = count[0] == expected_count && sum[0] == expected_sum;
+    if (!success) {
+      fprintf(stderr, "Stress test found %lld rows summing to %lld\n",
+              static_cast<long long>(count[0]),
+              static_cast<long long>(sum[0]));
+    }
+    array.release(&array);
+    schema.release(&schema);
+  }
+  zoomdb_disconnect(connection);
+  return success;
+}
+
+/**
+ * Run a statement that has to succeed.
+ */
+bool Run(zoomdb::Connection& connection, const std::string& query) {
+  auto result = connection.Query(query.c_str());
+  if (!result.success) {
+    fprintf(stderr, "Query %s failed: %s\n", query.c_str(),
+            result.error.c_str());
+  }
+  return result.success;
+}
+
+/**
+ * Returns the result printed by Result::ToString() with its rows sorted,
+ * since the rows of a query come in no particular order.
+ */
+std::string SortRows(const std::string& result) {
+  std::vector<std::string> lines;
+  size_t start = 0;
+  while (start < result.size()) {
+    auto end = std::min(result.find('\n', start), result.size() - 1);
+    lines.push_back(result.substr(start, end - start + 1));
+    start = end + 1;
+  }
+  if (!lines.empty()) {
+    std::sort(lines.begin() + 1, lines.end());
+  }
+  std::string sorted;
+  for (auto& line : lines) {
+    sorted += line;
+  }
+  return sorted;
+}
+
+/**
+ * Run a query and compare its result, as printed by Result::ToString(),
+ * with expected, ignoring the order of the rows.
+ */
+bool Check(zoomdb::Connection& connection, const std::string& query,
+           const std::string& expected) {
+  auto result = connection.Query(query.c_str());
+  auto actual = SortRows(result.ToString());
+  if (!result.success || actual != SortRows(expected)) {
+    fprintf(stderr, "Query %s returned\n%s\ninstead of\n%s\n", query.c_str(),
+            actual.c_str(), expected.c_str());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Run a query that has to fail with an error containing message.
+ */
+bool CheckError(zoomdb::Connection& connection, const std::string& query,
+                const std::string& message) {
+  auto result = connection.Query(query.c_str());
+  if (result.success || result.error.find(message) == std::string::npos) {
+    fprintf(stderr, "Query %s did not fail with \"%s\": %s\n", query.c_str(),
+            message.c_str(), result.error.c_str());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Run an EXPLAIN that has to print the operator.
+ */
+bool CheckPlan(zoomdb::Connection& connection, const std::string& query,
+               const std::string& op) {
+  auto result = connection.Query(query.c_str());
+  auto plan   = result.ToString();
+  if (!result.success || plan.find(op) == std::string::npos) {
+    fprintf(stderr, "Query %s has no %s:\n%s\n", query.c_str(), op.c_str(),
+            plan.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool BinderTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  return Run(connection, "CREATE TABLE bind_a (id INTEGER, v INTEGER);") &&
+         Run(connection, "CREATE TABLE bind_b (id INTEGER, w INTEGER);") &&
+         CheckError(connection, "SELECT nope FROM bind_a;",
+                    "Column \"nope\" does not exist") &&
+         CheckError(connection, "SELECT * FROM bind_missing;",
+                    "Table bind_missing does not exist") &&
+         CheckError(connection, "SELECT id FROM bind_a, bind_b;",
+                    "is ambiguous") &&
+         CheckError(connection, "SELECT bind_b.id FROM bind_a;",
+                    "Column \"bind_b.id\" does not exist") &&
+         CheckError(connection, "SELECT v FROM bind_a WHERE sum(v) > 1;",
+                    "not allowed") &&
+         CheckError(connection, "INSERT INTO bind_a VALUES (1, 2, 3);",
+                    "more expressions than target columns") &&
+         Check(connection, "SELECT bind_a.id, w FROM bind_a, bind_b;",
+               "id\tw\n");
+}
+
+/**
+ * The subqueries are flattened into joins, which have to keep their
+ * semantics: NULLs in NOT IN, counts of empty groups and duplicates on the
+ * subquery side.
+ */
+bool SubqueryTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  return Run(connection, "CREATE TABLE sub_a (id INTEGER, v INTEGER);") &&
+         Run(connection, "CREATE TABLE sub_b (id INTEGER);") &&
+         Run(connection,
+             "INSERT INTO sub_a VALUES (1, 10), (2, 20), (3, 30);") &&
+         Run(connection, "INSERT INTO sub_b VALUES (1), (3), (3);") &&
+         Check(connection,
+               "SELECT id FROM sub_a WHERE id IN (SELECT id FROM sub_b);",
+               "id\n1\n3\n") &&
+         Check(connection,
+               "SELECT id FROM sub_a WHERE NOT EXISTS "
+               "(SELECT * FROM sub_b WHERE sub_b.id = sub_a.id);",
+               "id\n2\n") &&
+         Check(connection,
+               "SELECT id, (SELECT count(*) FROM sub_b "
+               "WHERE sub_b.id = sub_a.id) AS n FROM sub_a;",
+               "id\tn\n1\t1\n2\t0\n3\t2\n") &&
+         Check(connection,
+               "SELECT id FROM sub_a WHERE v > (SELECT avg(v) FROM sub_a);",
+               "id\n3\n") &&
+         // not flattened, the subqueries run once per row
+         Check(connection,
+               "SELECT id, (SELECT count(*) FROM sub_b "
+               "WHERE sub_b.id < sub_a.id) AS n FROM sub_a;",
+               "id\tn\n1\t0\n2\t1\n3\t1\n") &&
+         Check(connection,
+               "SELECT id, (SELECT sub_b.id + v FROM sub_b "
+               "WHERE sub_b.id = sub_a.id) AS n FROM sub_a WHERE id < 3;",
+               "id\tn\n1\t11\n2\tNULL\n") &&
+         Run(connection, "INSERT INTO sub_b VALUES (NULL);") &&
+         Check(connection,
+               "SELECT id FROM sub_a WHERE id NOT IN (SELECT id FROM sub_b);",
+               "id\n");
+}
+
+/**
+ * Read a CSV file with quoted and empty fields into a table.
+ */
+bool CsvTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  auto file = fopen("zoomdb_test.csv", "w");
+  if (!file) {
+    fprintf(stderr, "Cannot write zoomdb_test.csv\n");
+    return false;
+  }
+  fputs("a,s,d\n1,x,1.5\n2,,-2.25\n3,\"a,b\",0\n", file);
+  fclose(file);
+  bool success =
+      Run(connection,
+          "CREATE TABLE copy_csv (a INTEGER, s VARCHAR, "
+          "d DOUBLE PRECISION);") &&
+      Run(connection,
+          "COPY copy_csv FROM 'zoomdb_test.csv' (FORMAT CSV, HEADER);") &&
+      Check(connection, "SELECT * FROM copy_csv;",
+            "a\ts\td\n1\tx\t1.5\n2\tNULL\t-2.25\n3\ta,b\t0\n");
+  remove("zoomdb_test.csv");
+  return success;
+}
+
+/**
+ * Write a table to a Parquet file and read it back, with COPY FROM and
+ * with read_parquet.
+ */
+bool ParquetTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  bool success =
+      Run(connection,
+          "CREATE TABLE copy_src (a INTEGER, s VARCHAR, "
+          "d DOUBLE PRECISION);") &&
+      Run(connection,
+          "INSERT INTO copy_src VALUES (1, 'x', 1.5), (2, NULL, -2.25), "
+          "(3, 'a,b', 0);") &&
+      Run(connection,
+          "CREATE TABLE copy_parquet (a INTEGER, s VARCHAR, "
+          "d DOUBLE PRECISION);") &&
+      Run(connection, "COPY copy_src TO 'zoomdb_test.parquet';") &&
+      Run(connection, "COPY copy_parquet FROM 'zoomdb_test.parquet';") &&
+      Check(connection, "SELECT * FROM copy_parquet;",
+            "a\ts\td\n1\tx\t1.5\n2\tNULL\t-2.25\n3\ta,b\t0\n") &&
+      Check(connection,
+            "SELECT a, s FROM read_parquet('zoomdb_test.parquet') "
+            "WHERE d < 1;",
+            "a\ts\n2\tNULL\n3\ta,b\n");
+  remove("zoomdb_test.parquet");
+  return success;
+}
+
+/**
+ * The results of index scans have to follow the inserts, updates and
+ * deletes of the table.
+ */
+bool IndexScanTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  std::string insert = "INSERT INTO idx VALUES ";
+  for (int k = 0; k < 100; k++) {
+    auto key = std::to_string(k);
+    insert += (k == 0 ? "(" : ", (") + key + ", 'v" + key + "')";
+  }
+  insert += ";";
+  return Run(connection, "CREATE TABLE idx (k INTEGER, v VARCHAR);") &&
+         Run(connection, insert) &&
+         Run(connection, "CREATE UNIQUE INDEX idx_k ON idx (k);") &&
+         CheckPlan(connection, "EXPLAIN SELECT v FROM idx WHERE k = 42;",
+                   "INDEX_SCAN") &&
+         Check(connection, "SELECT v FROM idx WHERE k = 42;", "v\nv42\n") &&
+         Check(connection,
+               "SELECT count(*) AS n, sum(k) AS s FROM idx "
+               "WHERE k >= 10 AND k < 20;",
+               "n\ts\n10\t145\n") &&
+         CheckError(connection, "INSERT INTO idx VALUES (42, 'twice');",
+                    "Duplicate key") &&
+         Run(connection, "DELETE FROM idx WHERE k = 42;") &&
+         Check(connection, "SELECT v FROM idx WHERE k = 42;", "v\n") &&
+         Run(connection, "UPDATE idx SET k = 1000 WHERE k = 43;") &&
+         Check(connection, "SELECT v FROM idx WHERE k = 43;", "v\n") &&
+         Check(connection, "SELECT v FROM idx WHERE k = 1000;",
+               "v\nv43\n") &&
+         Run(connection, "INSERT INTO idx VALUES (42, 'again');") &&
+         Check(connection, "SELECT v FROM idx WHERE k = 42;",
+               "v\nagain\n") &&
+         Run(connection, "DROP INDEX idx_k;") &&
+         Check(connection, "SELECT v FROM idx WHERE k = 1000;",
+               "v\nv43\n");
+}
+
+/**
+ * Updates and deletes are visible to the statements that follow them, on
+ * every connection.
+ */
+bool ModificationTest(zoomdb::Database& database) {
+  zoomdb::Connection writer(database);
+  zoomdb::Connection reader(database);
+  return Run(writer, "CREATE TABLE modified (a INTEGER, b INTEGER);") &&
+         Run(writer, "INSERT INTO modified VALUES (1, 1), (2, 2), (3, 3);") &&
+         Run(writer, "UPDATE modified SET b = b * 10 WHERE a >= 2;") &&
+         Check(reader, "SELECT a, b FROM modified;",
+               "a\tb\n1\t1\n2\t20\n3\t30\n") &&
+         Run(writer, "DELETE FROM modified WHERE a = 2;") &&
+         Check(reader, "SELECT a, b FROM modified;",
+               "a\tb\n1\t1\n3\t30\n") &&
+         Check(reader, "SELECT count(*) AS n FROM modified WHERE b > 5;",
+               "n\n1\n") &&
+         Run(writer, "DELETE FROM modified;") &&
+         Check(reader, "SELECT count(*) AS n FROM modified;", "n\n0\n") &&
+         Run(writer, "INSERT INTO modified VALUES (4, 4);") &&
+         Check(reader, "SELECT a, b FROM modified;", "a\tb\n4\t4\n");
+}
+
+bool WindowTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  return Run(connection, "CREATE TABLE win (g INTEGER, x INTEGER);") &&
+         Run(connection,
+             "INSERT INTO win VALUES (1, 1), (1, 2), (1, 3), (2, 10), "
+             "(2, 20);") &&
+         Check(connection,
+               "SELECT g, x, sum(x) OVER (PARTITION BY g ORDER BY x ROWS "
+               "BETWEEN 1 PRECEDING AND CURRENT ROW) AS s FROM win;",
+               "g\tx\ts\n1\t1\t1\n1\t2\t3\n1\t3\t5\n2\t10\t10\n2\t20\t30\n") &&
+         Check(connection,
+               "SELECT x, sum(x) OVER (ORDER BY x ROWS BETWEEN CURRENT ROW "
+               "AND UNBOUNDED FOLLOWING) AS s FROM win;",
+               "x\ts\n1\t36\n2\t35\n3\t33\n10\t30\n20\t20\n") &&
+         Check(connection,
+               "SELECT g, x, count(*) OVER (PARTITION BY g ORDER BY x DESC "
+               "ROWS BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW) AS r "
+               "FROM win;",
+               "g\tx\tr\n1\t1\t3\n1\t2\t2\n1\t3\t1\n2\t10\t2\n2\t20\t1\n");
+}
+
+bool DistinctTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  return Run(connection,
+             "CREATE TABLE dist (g INTEGER, d DOUBLE PRECISION);") &&
+         Run(connection,
+             "INSERT INTO dist VALUES (1, -0.0), (1, 0.0), (2, 1.5), "
+             "(2, 1.5), (NULL, NULL), (NULL, NULL);") &&
+         // -0.0 and 0.0 are equal, the first row is returned unchanged
+         Check(connection, "SELECT DISTINCT d FROM dist;",
+               "d\n-0\n1.5\nNULL\n") &&
+         Check(connection, "SELECT DISTINCT g, d FROM dist;",
+               "g\td\n1\t-0\n2\t1.5\nNULL\tNULL\n") &&
+         Check(connection, "SELECT count(DISTINCT g) AS n FROM dist;",
+               "n\n2\n");
+}
+
+/**
+ * The statements of a query run in order up to the first failing one.
+ */
+bool MultiStatementTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  size_t executed;
+  auto result = connection.Query(
+      "CREATE TABLE multi (a INTEGER); INSERT INTO multi VALUES (1); "
+      "INSERT INTO multi VALUES (2); SELECT sum(a) AS s FROM multi;",
+      &executed);
+  if (executed != 4 || result.ToString() != "s\n3\n") {
+    fprintf(stderr, "Multi statement query returned %s\n",
+            result.ToString().c_str());
+    return false;
+  }
+  result = connection.Query(
+      "INSERT INTO multi VALUES (10); SELECT * FROM multi_missing; "
+      "INSERT INTO multi VALUES (100);",
+      &executed);
+  if (result.success || executed != 1) {
+    fprintf(stderr, "Multi statement query did not stop at the error\n");
+    return false;
+  }
+  std::string results;
+  result = connection.Query(
+      "SELECT count(*) AS n FROM multi; SELECT sum(a) AS s FROM multi;",
+      [&](zoomdb::Result& statement) { results += statement.ToString(); });
+  if (!result.success || results != "n\n3\ns\n13\n") {
+    fprintf(stderr, "Multi statement query returned %s\n", results.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool AnalyzeTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  return Run(connection, "CREATE TABLE stats (a INTEGER, s VARCHAR);") &&
+         Run(connection,
+             "INSERT INTO stats VALUES (1, 'x'), (2, 'y'), (2, NULL);") &&
+         Run(connection, "ANALYZE stats;") && Run(connection, "ANALYZE;") &&
+         CheckError(connection, "ANALYZE stats_missing;", "does not exist") &&
+         CheckError(connection, "VACUUM stats;", "not supported") &&
+         Check(connection, "SELECT count(*) AS n FROM stats WHERE a = 2;",
+               "n\n2\n");
+}
+
+/**
+ * A row is only appended once it is complete: flushing in its middle
+ * fails, a value that does not convert can be given again, and an
+ * unfinished row is dropped with the Appender.
+ */
+bool AppenderTest(zoomdb::Database& database) {
+  zoomdb::Connection connection(database);
+  if (!Run(connection, "CREATE TABLE appended (a INTEGER, s VARCHAR);")) {
+    return false;
+  }
+  size_t failures = 0;
+  {
+    zoomdb::Appender appender(connection, "appended");
+    appender.Append(int32_t(1));
+    appender.Append("x");
+    appender.EndRow();
+    try {
+      appender.Append("not a number");
+    } catch (zoomdb::Exception&) {
+      failures++;
+    }
+    appender.Append(int32_t(2));
+    try {
+      appender.Flush();
+    } catch (zoomdb::Exception&) {
+      failures++;
+    }
+    appender.AppendNull();
+    appender.EndRow();
+    appender.Flush();
+    appender.Append(int32_t(3));
+  }
+  if (failures != 2) {
+    fprintf(stderr, "Appender took a value it cannot store\n");
+    return false;
+  }
+  return Check(connection, "SELECT a, s FROM appended;",
+               "a\ts\n1\tx\n2\tNULL\n");
+}
+
+/**
+ * Append a big endian integer of size bytes to message.
+ */
+void PutBigEndian(uint32_t value, size_t size, std::string& message) {
+  for (size_t i = size; i > 0; i--) {
+    message += static_cast<char>(value >> (8 * (i - 1)));
+  }
+}
+
+uint32_t GetBigEndian(const uint8_t* data, size_t size) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value = value << 8 | data[i];
+  }
+  return value;
+}
+
+/**
+ * Append a PostgreSQL frontend message to input, type 0 for the startup
+ * message.
+ */
+void PgMessage(char type, const std::string& payload,
+               std::vector<uint8_t>& input) {
+  std::string message;
+  if (type) {
+    message += type;
+  }
+  PutBigEndian(static_cast<uint32_t>(payload.size() + 4), 4, message);
+  message += payload;
+  input.insert(input.end(), message.begin(), message.end());
+}
+
+/**
+ * Summarize the backend messages in output: the type of every message,
+ * with the tag of a CommandComplete and the values of a DataRow.
+ */
+std::string PgMessages(const std::vector<uint8_t>& output) {
+  std::string result;
+  size_t position = 0;
+  while (position + 5 <= output.size()) {
+    auto type    = static_cast<char>(output[position]);
+    auto payload = output.data() + position + 5;
+    position += 1 + GetBigEndian(output.data() + position + 1, 4);
+    result += result.empty() ? "" : " ";
+    result += type;
+    if (type == 'C') {
+      result += "(" + std::string(reinterpret_cast<const char*>(payload)) +
+                ")";
+    } else if (type == 'D') {
+      auto columns  = GetBigEndian(payload, 2);
+      size_t offset = 2;
+      for (uint32_t i = 0; i < columns; i++) {
+        auto size = GetBigEndian(payload + offset, 4);
+        offset += 4;
+        result += i == 0 ? "(" : ",";
+        if (size == 0xFFFFFFFF) {
+          result += "NULL";
+          continue;
+        }
+        result.append(reinterpret_cast<const char*>(payload + offset), size);
+        offset += size;
+      }
+      result += ")";
+    }
+  }
+  return result;
+}
+
+/**
+ * Send the messages in input to the session and compare the summary of its
+ * answer with expected.
+ */
+bool CheckPgSession(zoomdb::PgSession& session, std::vector<uint8_t>& input,
+                    const std::string& expected) {
+  std::vector<uint8_t> output;
+  if (!session.Process(input, output)) {
+    fprintf(stderr, "PostgreSQL session closed\n");
+    return false;
+  }
+  auto actual = PgMessages(output);
+  if (actual != expected) {
+    fprintf(stderr, "PostgreSQL session answered\n%s\ninstead of\n%s\n",
+            actual.c_str(), expected.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool PgProtocolTest(zoomdb::Database& database) {
+  zoomdb::PgSession session(database);
+  std::vector<uint8_t> input;
+  std::string startup;
+  PutBigEndian(196608, 4, startup);  // protocol 3.0
+  startup += std::string("user\0test\0\0", 11);
+  PgMessage(0, startup, input);
+  std::vector<uint8_t> output;
+  if (!session.Process(input, output) || output.empty() ||
+      output[output.size() - 6] != 'Z') {
+    fprintf(stderr, "PostgreSQL startup failed\n");
+    return false;
+  }
+
+  // every statement of a simple query is answered up to the first error
+  PgMessage('Q',
+            std::string("CREATE TABLE pg (a INTEGER, s VARCHAR); "
+                        "INSERT INTO pg VALUES (1, 'x'), (2, NULL); "
+                        "SELECT a, s FROM pg; "
+                        "SELECT nope FROM pg; SELECT 1;") +
+                '\0',
+            input);
+  if (!CheckPgSession(session, input,
+                      "C(CREATE) C(INSERT 0 2) T D(1,x) D(2,NULL) "
+                      "C(SELECT 2) E Z")) {
+    return false;
+  }
+
+  // the extended protocol with a parameter
+  std::string parse("\0SELECT s FROM pg WHERE a = $1\0", 31);
+  PutBigEndian(1, 2, parse);
+  PutBigEndian(23, 4, parse);  // int4
+  PgMessage('P', parse, input);
+  std::string bind("\0\0", 2);
+  PutBigEndian(0, 2, bind);
+  PutBigEndian(1, 2, bind);
+  PutBigEndian(1, 4, bind);
+  bind += "1";
+  PutBigEndian(0, 2, bind);
+  PgMessage('B', bind, input);
+  PgMessage('D', std::string("P\0", 2), input);
+  PgMessage('E', std::string("\0\0\0\0\0", 5), input);
+  PgMessage('S', "", input);
+  if (!CheckPgSession(session, input, "1 2 T D(x) C(SELECT 1) Z")) {
+    return false;
+  }
+
+  // describing a portal does not run its statement, only Execute does
+  std::string unnamed_portal("\0\0\0\0\0\0\0\0", 8);
+  PgMessage('P', std::string("\0INSERT INTO pg VALUES (3, 'y')\0\0\0", 34),
+            input);
+  PgMessage('B', unnamed_portal, input);
+  PgMessage('D', std::string("P\0", 2), input);
+  PgMessage('C', std::string("P\0", 2), input);
+  PgMessage('B', unnamed_portal, input);
+  PgMessage('E', std::string("\0\0\0\0\0", 5), input);
+  PgMessage('S', "", input);
+  PgMessage('Q', std::string("SELECT count(*) AS n FROM pg;") + '\0', input);
+  return CheckPgSession(session, input,
+                        "1 2 n 3 2 C(INSERT 0 1) Z T D(3) C(SELECT 1) Z");
+}
+
+/**
+ * Run a query through the binary protocol of the server and print its
+ * result like Result::ToString().
+ */
+std::string WireQuery(zoomdb::WireSession& session, const std::string& query,
+                      uint8_t flags) {
+  std::vector<uint8_t> input{
+      static_cast<uint8_t>(zoomdb::WireMessage::kQuery)};
+  auto size = static_cast<uint32_t>(query.size() + 1);
+  for (size_t i = 0; i < 4; i++) {
+    input.push_back(static_cast<uint8_t>(size >> (8 * i)));
+  }
+  input.push_back(flags);
+  input.insert(input.end(), query.begin(), query.end());
+  std::vector<uint8_t> output;
+  session.Process(input, output);
+
+  std::string result;
+  std::vector<zoomdb::TypeId> types;
+  size_t position = 0;
+  while (position + 5 <= output.size()) {
+    auto type    = static_cast<zoomdb::WireMessage>(output[position]);
+    auto payload = output.data() + position + 5;
+    uint32_t payload_size;
+    memcpy(&payload_size, output.data() + position + 1, 4);
+    position += 5 + payload_size;
+    switch (type) {
+      case zoomdb::WireMessage::kError:
+        return "error: " + std::string(reinterpret_cast<const char*>(payload),
+                                       payload_size);
+      case zoomdb::WireMessage::kHeader: {
+        uint32_t columns;
+        memcpy(&columns, payload, 4);
+        size_t offset = 4;
+        for (uint32_t i = 0; i < columns; i++) {
+          types.push_back(static_cast<zoomdb::TypeId>(payload[offset]));
+          uint16_t name_size;
+          memcpy(&name_size, payload + offset + 1, 2);
+          result += i == 0 ? "" : "\t";
+          result.append(reinterpret_cast<const char*>(payload + offset + 3),
+                        name_size);
+          offset += 3 + name_size;
+        }
+        result += "\n";
+        break;
+      }
+      case zoomdb::WireMessage::kChunk: {
+        auto compression = static_cast<zoomdb::WireCompression>(payload[0]);
+        uint32_t chunk_size;
+        memcpy(&chunk_size, payload + 1, 4);
+        std::vector<uint8_t> serialized(payload + 5,
+                                        payload + payload_size);
+        if (compression == zoomdb::WireCompression::kLZ4) {
+          serialized.resize(chunk_size);
+          zoomdb::LZ4Decompress(payload + 5, payload_size - 5,
+                                serialized.data(), chunk_size);
+          result += "(compressed)\n";
+        }
+        zoomdb::DataChunk chunk;
+        chunk.Initialize(types);
+        zoomdb::DeserializeChunk(serialized.data(), serialized.size(), chunk);
+        for (size_t row = 0; row < chunk.GetCount(); row++) {
+          for (size_t column = 0; column < types.size(); column++) {
+            result += column == 0 ? "" : "\t";
+            result += chunk.GetValue(column, row).ToString();
+          }
+          result += "\n";
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return result;
+}
+
+bool WireProtocolTest(zoomdb::Database& database) {
+  zoomdb::WireSession session(database);
+  zoomdb::Connection connection(database);
+  if (!Run(connection, "CREATE TABLE wire (a INTEGER, s VARCHAR);") ||
+      !Run(connection,
+           "INSERT INTO wire VALUES (1, 'x'), (2, NULL), (3, 'zzz');")) {
+    return false;
+  }
+  // enough equal rows for a chunk that is worth compressing
+  std::string repeated = "INSERT INTO wire VALUES ";
+  std::string repeated_rows = "s\n(compressed)\n";
+  for (int i = 0; i < 200; i++) {
+    repeated += i == 0 ? "(4, 'repeated')" : ", (4, 'repeated')";
+    repeated_rows += "repeated\n";
+  }
+  struct {
+    const char* query;
+    uint8_t flags;
+    const char* expected;
+  } cases[] = {
+      {"SELECT a, s FROM wire;", 0,
+       "a\ts\n1\tx\n2\tNULL\n3\tzzz\n"},
+      {"SELECT nope FROM wire;", 0,
+       "error: Binder: Column \"nope\" does not exist"},
+      {repeated.c_str(), 0, "Count\n200\n"},
+      {"SELECT s FROM wire WHERE a = 4;", zoomdb::kWireCompressLZ4,
+       repeated_rows.c_str()},
+  };
+  for (auto& test : cases) {
+    auto actual = WireQuery(session, test.query, test.flags);
+    if (actual != test.expected) {
+      fprintf(stderr, "Wire query %s returned\n%s\ninstead of\n%s\n",
+              test.query, actual.c_str(), test.expected);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
 
 int main() {
   zoomdb_database database;
@@ -65,6 +836,37 @@ int main() {
     return 1;
   }
 */
+  if (!StressTest(database)) {
+    fprintf(stderr, "Concurrent queries failed\n");
+    return 1;
+  }
+
+  struct {
+    const char* name;
+    bool (*run)(zoomdb::Database& database);
+  } tests[] = {
+      {"Binder", BinderTest},
+      {"Subquery", SubqueryTest},
+      {"CSV", CsvTest},
+      {"Parquet", ParquetTest},
+      {"Index scan", IndexScanTest},
+      {"Modification", ModificationTest},
+      {"Window", WindowTest},
+      {"DISTINCT", DistinctTest},
+      {"Multi statement", MultiStatementTest},
+      {"ANALYZE", AnalyzeTest},
+      {"Appender", AppenderTest},
+      {"PostgreSQL protocol", PgProtocolTest},
+      {"Wire protocol", WireProtocolTest},
+  };
+  zoomdb::Database behaviour_database(nullptr);
+  for (auto& test : tests) {
+    if (!test.run(behaviour_database)) {
+      fprintf(stderr, "%s test failed\n", test.name);
+      return 1;
+    }
+  }
+
   if (zoomdb_disconnect(connection) != kZoomDBSuccess) {
     fprintf(stderr, "Database disconnect failed\n");
     return 1;